@@ -0,0 +1,23 @@
+include_guard(GLOBAL)
+
+include(FetchContent)
+
+if(POLICY CMP0135)
+  cmake_policy(SET CMP0135 NEW)
+endif()
+
+option(USE_SYSTEM_BENCHMARK "Use a preinstalled Google Benchmark package" OFF)
+
+if(USE_SYSTEM_BENCHMARK)
+  find_package(benchmark CONFIG REQUIRED)
+elseif(NOT TARGET benchmark::benchmark)
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+  FetchContent_Declare(
+    googlebenchmark
+    URL https://github.com/google/benchmark/archive/refs/tags/v1.9.1.tar.gz
+  )
+  FetchContent_MakeAvailable(googlebenchmark)
+endif()
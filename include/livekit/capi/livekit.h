@@ -8,8 +8,9 @@
  *
  * Object pointers are opaque handles owned by the caller. Destroy tracks before their sources.
  * A published track must remain alive until its room is disconnected. Callback data, strings,
- * and frame buffers are borrowed and remain valid only for the duration of that callback. A room
- * must not be destroyed from one of its own callbacks.
+ * and frame buffers are borrowed and remain valid only for the duration of that callback, unless a
+ * video frame buffer is explicitly retained. A room must not be destroyed from one of its own
+ * callbacks.
  *
  * String getters return the required size including the trailing NUL. Pass NULL and zero to query
  * the size. All functions catch C++ exceptions; details for a failure on the current thread are
@@ -46,6 +47,11 @@ typedef struct lk_remote_track_publication_snapshot lk_remote_track_publication_
 typedef struct lk_remote_track_snapshot lk_remote_track_snapshot_t;
 typedef struct lk_media_device_list lk_media_device_list_t;
 typedef struct lk_screen_source_list lk_screen_source_list_t;
+typedef struct lk_video_frame_buffer lk_video_frame_buffer_t;
+typedef struct lk_audio_mixer lk_audio_mixer_t;
+typedef struct lk_audio_stream lk_audio_stream_t;
+typedef struct lk_video_stream lk_video_stream_t;
+typedef struct lk_peer_factory lk_peer_factory_t;
 
 typedef enum lk_status {
 	LK_STATUS_OK = 0,
@@ -135,6 +141,35 @@ typedef enum lk_video_codec {
 	LK_VIDEO_CODEC_AV1 = 3
 } lk_video_codec_t;
 
+typedef enum lk_video_frame_delivery {
+	LK_VIDEO_FRAME_DELIVERY_PACKED = 0,
+	LK_VIDEO_FRAME_DELIVERY_BUFFER = 1
+} lk_video_frame_delivery_t;
+
+typedef enum lk_audio_playout {
+	LK_AUDIO_PLAYOUT_DEVICE = 0,
+	LK_AUDIO_PLAYOUT_HEADLESS = 1
+} lk_audio_playout_t;
+
+typedef enum lk_data_stream_compression_strategy {
+	LK_DATA_STREAM_COMPRESSION_STRATEGY_DEFAULT = 0,
+	LK_DATA_STREAM_COMPRESSION_STRATEGY_FILTERED = 1,
+	LK_DATA_STREAM_COMPRESSION_STRATEGY_HUFFMAN_ONLY = 2,
+	LK_DATA_STREAM_COMPRESSION_STRATEGY_RLE = 3
+} lk_data_stream_compression_strategy_t;
+
+typedef enum lk_frame_stream_overflow {
+	LK_FRAME_STREAM_OVERFLOW_DROP_OLDEST = 0,
+	LK_FRAME_STREAM_OVERFLOW_KEEP_LATEST = 1,
+	LK_FRAME_STREAM_OVERFLOW_BLOCK = 2
+} lk_frame_stream_overflow_t;
+
+typedef enum lk_event_overflow {
+	LK_EVENT_OVERFLOW_GROW = 0,
+	LK_EVENT_OVERFLOW_COALESCE = 1,
+	LK_EVENT_OVERFLOW_DROP_LOSSY = 2
+} lk_event_overflow_t;
+
 typedef enum lk_connection_quality {
 	LK_CONNECTION_QUALITY_UNKNOWN = 0,
 	LK_CONNECTION_QUALITY_POOR = 1,
@@ -291,6 +326,17 @@ typedef struct lk_subscribed_quality_update {
 	size_t codec_count;
 } lk_subscribed_quality_update_t;
 
+/* Encoder-side state of one simulcast layer while dynacast is enabled. paused_ms and
+ * encode_seconds_saved include the current pause. */
+typedef struct lk_dynacast_layer {
+	lk_video_quality_t quality;
+	int active;
+	int pause_pending;
+	uint32_t pauses;
+	uint64_t paused_ms;
+	double encode_seconds_saved;
+} lk_dynacast_layer_t;
+
 typedef struct lk_audio_frame {
 	const int16_t* data;
 	size_t sample_count;
@@ -299,14 +345,32 @@ typedef struct lk_audio_frame {
 	uint32_t samples_per_channel;
 } lk_audio_frame_t;
 
+/*
+ * In packed delivery, data holds a tightly packed I420 frame and buffer is NULL. In buffer
+ * delivery, data is NULL and buffer wraps the decoder's planes; retain it to keep the frame past
+ * the callback.
+ */
 typedef struct lk_video_frame {
 	const uint8_t* data;
 	size_t data_size;
 	uint32_t width;
 	uint32_t height;
 	int64_t timestamp_us;
+	lk_video_frame_buffer_t* buffer;
 } lk_video_frame_t;
 
+typedef struct lk_video_frame_planes {
+	size_t struct_size;
+	uint32_t width;
+	uint32_t height;
+	const uint8_t* data_y;
+	const uint8_t* data_u;
+	const uint8_t* data_v;
+	int32_t stride_y;
+	int32_t stride_u;
+	int32_t stride_v;
+} lk_video_frame_planes_t;
+
 typedef struct lk_data_received {
 	const uint8_t* data;
 	size_t data_size;
@@ -523,6 +587,9 @@ typedef void (*lk_video_frame_callback)(void* user_data, lk_room_t* room,
                                         const lk_track_publication_info_t* track,
                                         const lk_participant_info_t* participant,
                                         const lk_video_frame_t* frame);
+/* Runs on the thread calling lk_audio_mixer_pull(). frame->data is valid only during the call. */
+typedef void (*lk_audio_mixer_tap_callback)(void* user_data, const char* participant_sid,
+                                            const char* track_sid, const lk_audio_frame_t* frame);
 typedef void (*lk_data_received_callback)(void* user_data, lk_room_t* room,
                                           const lk_data_received_t* event);
 typedef void (*lk_sip_dtmf_callback)(void* user_data, lk_room_t* room, const lk_sip_dtmf_t* event);
@@ -641,8 +708,58 @@ typedef struct lk_microphone_processing_stats {
 	uint64_t render_processing_errors;
 	uint64_t frames_dropped;
 	int echo_cancellation_enabled;
+	int echo_reference_attached;
 } lk_microphone_processing_stats_t;
 
+typedef struct lk_audio_source_queue_stats {
+	size_t struct_size;
+	uint64_t underrun_frames;
+	uint64_t overrun_frames;
+	uint32_t queued_samples;
+	uint32_t capacity_samples;
+} lk_audio_source_queue_stats_t;
+
+typedef struct lk_audio_mixer_options {
+	size_t struct_size;
+	uint32_t sample_rate;
+	uint32_t num_channels;
+	uint32_t max_buffered_ms;
+	int include_all_tracks;
+} lk_audio_mixer_options_t;
+
+typedef struct lk_audio_mixer_stats {
+	size_t struct_size;
+	uint32_t track_count;
+	uint64_t mixed_frames;
+	uint64_t underrun_frames;
+	uint64_t overrun_frames;
+} lk_audio_mixer_stats_t;
+
+typedef struct lk_audio_stream_options {
+	size_t struct_size;
+	uint32_t sample_rate;
+	uint32_t num_channels;
+	uint32_t capacity_frames;
+	lk_frame_stream_overflow_t overflow;
+	uint32_t block_timeout_ms;
+} lk_audio_stream_options_t;
+
+typedef struct lk_video_stream_options {
+	size_t struct_size;
+	uint32_t capacity_frames;
+	lk_frame_stream_overflow_t overflow;
+	uint32_t block_timeout_ms;
+} lk_video_stream_options_t;
+
+typedef struct lk_frame_stream_stats {
+	size_t struct_size;
+	uint32_t queued_frames;
+	uint32_t capacity_frames;
+	uint64_t pushed_frames;
+	uint64_t read_frames;
+	uint64_t dropped_frames;
+} lk_frame_stream_stats_t;
+
 typedef struct lk_video_source_options {
 	size_t struct_size;
 	int is_screencast;
@@ -676,11 +793,97 @@ typedef struct lk_track_publish_options {
 typedef struct lk_data_publish_options {
 	size_t struct_size;
 	int reliable;
+	/* "lk.data_batch" is reserved for coalesced payloads. */
 	const char* topic;
 	const char* const* destination_identities;
 	size_t destination_identity_count;
+	/* Lossy only: coalesce with other payloads for the same topic and destinations. Receivers on
+	 * other SDKs get the batch as one packet on the "lk.data_batch" topic. */
+	int coalesce;
 } lk_data_publish_options_t;
 
+typedef struct lk_data_batching_options {
+	size_t struct_size;
+	uint32_t window_ms;
+	uint32_t max_batch_bytes;
+} lk_data_batching_options_t;
+
+typedef struct lk_data_batching_stats {
+	size_t struct_size;
+	uint64_t messages;
+	uint64_t packets;
+	uint64_t failed_packets;
+	uint32_t max_messages_per_packet;
+	uint64_t total_added_latency_us;
+	uint64_t max_added_latency_us;
+} lk_data_batching_stats_t;
+
+#define LK_DATA_STREAM_ID_BUFFER_SIZE 64
+
+/* Reassembly state of one unfinished incoming data stream; stream_id is truncated to fit.
+ * memory_bytes and spilled_bytes stay 0 for streams read through a registered handler. */
+typedef struct lk_incoming_data_stream {
+	char stream_id[LK_DATA_STREAM_ID_BUFFER_SIZE];
+	int compressed;
+	int has_handler;
+	uint64_t received_bytes;
+	uint64_t compressed_bytes;
+	uint64_t queued_bytes;
+	uint64_t memory_bytes;
+	uint64_t spilled_bytes;
+} lk_incoming_data_stream_t;
+
+typedef struct lk_data_stream_compression_options {
+	size_t struct_size;
+	/* zlib level: -1 for zlib's default, 0 (store) to 9 (smallest). */
+	int32_t level;
+	lk_data_stream_compression_strategy_t strategy;
+	/* Parallel deflate workers for whole-payload and file streams; 0 uses one per core, up to 8. */
+	uint32_t threads;
+} lk_data_stream_compression_options_t;
+
+typedef struct lk_event_queue_options {
+	uint32_t capacity;
+	lk_event_overflow_t overflow;
+} lk_event_queue_options_t;
+
+/* Queues are listed in delivery priority; see lk_room_set_event_dispatch(). */
+typedef struct lk_event_dispatch_options {
+	size_t struct_size;
+	int enabled;
+	lk_event_queue_options_t connection;
+	lk_event_queue_options_t media;
+	lk_event_queue_options_t data;
+	lk_event_queue_options_t speakers;
+} lk_event_dispatch_options_t;
+
+typedef struct lk_event_queue_stats {
+	uint32_t depth;
+	uint32_t max_depth;
+	uint64_t dispatched;
+	uint64_t coalesced;
+	uint64_t dropped;
+	uint64_t total_wait_us;
+	uint64_t max_wait_us;
+	uint64_t max_callback_us;
+} lk_event_queue_stats_t;
+
+typedef struct lk_event_dispatch_stats {
+	size_t struct_size;
+	lk_event_queue_stats_t connection;
+	lk_event_queue_stats_t media;
+	lk_event_queue_stats_t data;
+	lk_event_queue_stats_t speakers;
+} lk_event_dispatch_stats_t;
+
+typedef struct lk_peer_factory_stats {
+	size_t struct_size;
+	/* Rooms that have connected through the factory and still hold it. */
+	uint32_t rooms;
+	/* Network, worker and signaling threads plus the audio device thread once initialised. */
+	uint32_t threads;
+} lk_peer_factory_stats_t;
+
 typedef struct lk_file_send_options {
 	size_t struct_size;
 	const char* topic;
@@ -691,6 +894,11 @@ typedef struct lk_file_send_options {
 	const lk_attribute_t* attributes;
 	size_t attribute_count;
 	int compress;
+	/* bytes_sent counts file bytes, before compression. */
+	lk_data_stream_progress_callback on_progress;
+	void* progress_user_data;
+	lk_data_stream_completion_callback on_complete;
+	void* completion_user_data;
 } lk_file_send_options_t;
 
 typedef struct lk_text_send_options {
@@ -827,11 +1035,24 @@ LKC_API void lk_audio_source_options_init(lk_audio_source_options_t* options);
 LKC_API void lk_microphone_capture_options_init(lk_microphone_capture_options_t* options);
 LKC_API void lk_system_audio_capture_options_init(lk_system_audio_capture_options_t* options);
 LKC_API void lk_microphone_processing_stats_init(lk_microphone_processing_stats_t* stats);
+LKC_API void lk_audio_source_queue_stats_init(lk_audio_source_queue_stats_t* stats);
+LKC_API void lk_audio_mixer_options_init(lk_audio_mixer_options_t* options);
+LKC_API void lk_audio_mixer_stats_init(lk_audio_mixer_stats_t* stats);
+LKC_API void lk_audio_stream_options_init(lk_audio_stream_options_t* options);
+LKC_API void lk_video_stream_options_init(lk_video_stream_options_t* options);
+LKC_API void lk_frame_stream_stats_init(lk_frame_stream_stats_t* stats);
 LKC_API void lk_video_source_options_init(lk_video_source_options_t* options);
 LKC_API void lk_camera_capture_options_init(lk_camera_capture_options_t* options);
 LKC_API void lk_screen_capture_options_init(lk_screen_capture_options_t* options);
 LKC_API void lk_track_publish_options_init(lk_track_publish_options_t* options);
 LKC_API void lk_data_publish_options_init(lk_data_publish_options_t* options);
+LKC_API void lk_data_batching_options_init(lk_data_batching_options_t* options);
+LKC_API void lk_data_batching_stats_init(lk_data_batching_stats_t* stats);
+LKC_API void
+lk_data_stream_compression_options_init(lk_data_stream_compression_options_t* options);
+LKC_API void lk_event_dispatch_options_init(lk_event_dispatch_options_t* options);
+LKC_API void lk_event_dispatch_stats_init(lk_event_dispatch_stats_t* stats);
+LKC_API void lk_peer_factory_stats_init(lk_peer_factory_stats_t* stats);
 LKC_API void lk_file_send_options_init(lk_file_send_options_t* options);
 LKC_API void lk_text_send_options_init(lk_text_send_options_t* options);
 LKC_API void lk_byte_send_options_init(lk_byte_send_options_t* options);
@@ -844,10 +1065,54 @@ LKC_API void lk_remote_participant_snapshot_info_init(lk_remote_participant_snap
 LKC_API void
 lk_remote_track_publication_snapshot_info_init(lk_remote_track_publication_snapshot_info_t* info);
 LKC_API void lk_remote_track_snapshot_info_init(lk_remote_track_snapshot_info_t* info);
+LKC_API void lk_video_frame_planes_init(lk_video_frame_planes_t* planes);
+
+/*
+ * Peer factories own the threads, audio device and codec factories behind peer connections. Rooms
+ * create their own unless one is set with lk_room_set_peer_factory(). Rooms sharing a factory also
+ * share its audio playout, so on a room given a factory the output device, volume and mute setters
+ * fail with LK_STATUS_INVALID_STATE. Destroying a handle releases only the caller's reference;
+ * rooms keep the factory alive while they use it.
+ */
+LKC_API lk_status_t lk_peer_factory_create(lk_peer_factory_t** factory);
+/*
+ * Creates a factory with the given playout. A headless factory opens no audio device and mixes
+ * remote audio only while its rooms have remote audio tracks.
+ */
+LKC_API lk_status_t lk_peer_factory_create_with_playout(lk_audio_playout_t playout,
+                                                        lk_peer_factory_t** factory);
+/* Returns a handle to the process-wide factory, created on first use. */
+LKC_API lk_status_t lk_peer_factory_process(lk_peer_factory_t** factory);
+LKC_API void lk_peer_factory_destroy(lk_peer_factory_t* factory);
+LKC_API lk_status_t lk_peer_factory_stats(const lk_peer_factory_t* factory,
+                                          lk_peer_factory_stats_t* stats);
 
 LKC_API lk_status_t lk_room_create(lk_room_t** room);
 LKC_API void lk_room_destroy(lk_room_t* room);
 LKC_API lk_status_t lk_room_set_callbacks(lk_room_t* room, const lk_room_callbacks_t* callbacks);
+/* Selects how on_video_frame receives remote video. Takes effect on the next connect. */
+LKC_API lk_status_t lk_room_set_video_frame_delivery(lk_room_t* room,
+                                                     lk_video_frame_delivery_t delivery);
+/*
+ * Runs the room on factory instead of its own. Read by the room's first connect only; NULL restores
+ * a room-owned factory.
+ */
+LKC_API lk_status_t lk_room_set_peer_factory(lk_room_t* room, const lk_peer_factory_t* factory);
+/* Playout of the factory the room creates for itself. Ignored while a peer factory is set. */
+LKC_API lk_status_t lk_room_set_audio_playout(lk_room_t* room, lk_audio_playout_t playout);
+/* Enables adaptive stream from the next connect; see lk_room_set_remote_video_render_state(). */
+LKC_API lk_status_t lk_room_set_adaptive_stream(lk_room_t* room, int enabled);
+/*
+ * Room callbacks other than audio and video frames run on a room-owned thread, fed by one queue
+ * per category: connection, media, data and speakers, delivered in that priority. Only lossy data
+ * packets and speaker and quality updates are ever dropped from a full queue. Takes effect on the
+ * next connect; a NULL options pointer restores the defaults, and enabled = 0 runs callbacks on
+ * the network and signaling threads that raise them.
+ */
+LKC_API lk_status_t lk_room_set_event_dispatch(lk_room_t* room,
+                                               const lk_event_dispatch_options_t* options);
+LKC_API lk_status_t lk_room_event_dispatch_stats(const lk_room_t* room,
+                                                 lk_event_dispatch_stats_t* stats);
 LKC_API lk_status_t lk_room_connect(lk_room_t* room, const char* url, const char* token);
 LKC_API lk_status_t lk_room_disconnect(lk_room_t* room);
 LKC_API lk_room_state_t lk_room_state(const lk_room_t* room);
@@ -866,6 +1131,62 @@ LKC_API int lk_room_speaker_is_muted(const lk_room_t* room);
 LKC_API lk_status_t lk_room_audio_playback_stats(const lk_room_t* room,
                                                  lk_audio_playback_stats_t* stats);
 
+/*
+ * Mixes remote audio tracks into one 10 ms stream pulled by the caller. A NULL options pointer uses
+ * 48 kHz mono and mixes every subscribed audio track. The mixer may outlive the room; it then stops
+ * receiving new tracks. lk_audio_mixer_pull() fills frame with data owned by the mixer that stays
+ * valid until the next pull. has_audio may be NULL.
+ */
+LKC_API lk_status_t lk_room_create_audio_mixer(lk_room_t* room,
+                                               const lk_audio_mixer_options_t* options,
+                                               lk_audio_mixer_t** mixer);
+LKC_API void lk_audio_mixer_destroy(lk_audio_mixer_t* mixer);
+LKC_API lk_status_t lk_audio_mixer_add_track(lk_audio_mixer_t* mixer, const char* track_sid);
+LKC_API lk_status_t lk_audio_mixer_remove_track(lk_audio_mixer_t* mixer, const char* track_sid);
+LKC_API lk_status_t lk_audio_mixer_set_participant_gain(lk_audio_mixer_t* mixer,
+                                                        const char* participant_sid, float gain);
+/* A NULL callback removes the tap. */
+LKC_API lk_status_t lk_audio_mixer_set_track_tap(lk_audio_mixer_t* mixer, const char* track_sid,
+                                                 lk_audio_mixer_tap_callback callback,
+                                                 void* user_data);
+LKC_API lk_status_t lk_audio_mixer_pull(lk_audio_mixer_t* mixer, lk_audio_frame_t* frame,
+                                        int* has_audio);
+LKC_API lk_status_t lk_audio_mixer_stats(const lk_audio_mixer_t* mixer,
+                                         lk_audio_mixer_stats_t* stats);
+
+/*
+ * Pull-mode queues for one subscribed remote track; NULL options use the defaults. Read waits up to
+ * timeout_ms (negative waits forever) and returns LK_STATUS_OPERATION_FAILED on timeout and
+ * LK_STATUS_INVALID_STATE once the stream is closed and drained. Audio data stays valid until the
+ * next read. A video frame's buffer is owned by the caller and must be released with
+ * lk_video_frame_buffer_release(). The descriptor polls readable while frames are queued and after
+ * the stream closes; it is -1 on Windows, where the event handle is signaled under the same
+ * conditions instead. Streams close when the track is unsubscribed.
+ */
+LKC_API lk_status_t lk_room_create_audio_stream(lk_room_t* room, const char* track_sid,
+                                                const lk_audio_stream_options_t* options,
+                                                lk_audio_stream_t** stream);
+LKC_API void lk_audio_stream_destroy(lk_audio_stream_t* stream);
+LKC_API lk_status_t lk_audio_stream_read(lk_audio_stream_t* stream, int64_t timeout_ms,
+                                         lk_audio_frame_t* frame);
+LKC_API int lk_audio_stream_fd(const lk_audio_stream_t* stream);
+/* A manual-reset HANDLE on Windows, owned by the stream; NULL on other platforms. */
+LKC_API void* lk_audio_stream_event_handle(const lk_audio_stream_t* stream);
+LKC_API lk_status_t lk_audio_stream_close(lk_audio_stream_t* stream);
+LKC_API lk_status_t lk_audio_stream_stats(const lk_audio_stream_t* stream,
+                                          lk_frame_stream_stats_t* stats);
+LKC_API lk_status_t lk_room_create_video_stream(lk_room_t* room, const char* track_sid,
+                                                const lk_video_stream_options_t* options,
+                                                lk_video_stream_t** stream);
+LKC_API void lk_video_stream_destroy(lk_video_stream_t* stream);
+LKC_API lk_status_t lk_video_stream_read(lk_video_stream_t* stream, int64_t timeout_ms,
+                                         lk_video_frame_t* frame);
+LKC_API int lk_video_stream_fd(const lk_video_stream_t* stream);
+LKC_API void* lk_video_stream_event_handle(const lk_video_stream_t* stream);
+LKC_API lk_status_t lk_video_stream_close(lk_video_stream_t* stream);
+LKC_API lk_status_t lk_video_stream_stats(const lk_video_stream_t* stream,
+                                          lk_frame_stream_stats_t* stats);
+
 /*
  * The list owns every participant, publication, and subscribed-track handle returned from it.
  * Child handles and permission source arrays remain valid until the list is destroyed. They are
@@ -944,6 +1265,8 @@ LKC_API lk_status_t lk_audio_source_create_system_audio(
 LKC_API lk_status_t lk_audio_source_destroy(lk_audio_source_t* source);
 LKC_API lk_status_t lk_audio_source_capture_frame(lk_audio_source_t* source, const int16_t* data,
                                                   uint32_t samples_per_channel);
+LKC_API lk_status_t lk_audio_source_queue_stats(const lk_audio_source_t* source,
+                                                lk_audio_source_queue_stats_t* stats);
 LKC_API lk_status_t lk_audio_source_microphone_start(lk_audio_source_t* source);
 LKC_API lk_status_t lk_audio_source_microphone_stop(lk_audio_source_t* source);
 LKC_API int lk_audio_source_microphone_is_capturing(const lk_audio_source_t* source);
@@ -993,6 +1316,17 @@ LKC_API size_t lk_video_source_screen_source_id(const lk_video_source_t* source,
 LKC_API lk_status_t lk_video_source_screen_switch_source(lk_video_source_t* source,
                                                          const char* source_id);
 
+/*
+ * Video frame buffers are reference counted. The buffer passed to on_video_frame is borrowed;
+ * each lk_video_frame_buffer_retain() must be balanced by lk_video_frame_buffer_release(), which
+ * may be called from any thread. Plane pointers remain valid while a reference is held.
+ */
+LKC_API lk_video_frame_buffer_t* lk_video_frame_buffer_retain(lk_video_frame_buffer_t* buffer);
+LKC_API void lk_video_frame_buffer_release(lk_video_frame_buffer_t* buffer);
+LKC_API lk_status_t lk_video_frame_buffer_planes(const lk_video_frame_buffer_t* buffer,
+                                                 lk_video_frame_planes_t* planes);
+LKC_API int64_t lk_video_frame_buffer_timestamp_us(const lk_video_frame_buffer_t* buffer);
+
 LKC_API lk_status_t lk_room_create_audio_track(lk_room_t* room, const char* label,
                                                lk_audio_source_t* source, lk_local_track_t** track);
 LKC_API lk_status_t lk_room_create_video_track(lk_room_t* room, const char* label,
@@ -1009,6 +1343,9 @@ LKC_API lk_status_t lk_room_republish_all_tracks(lk_room_t* room);
 LKC_API lk_status_t lk_local_track_set_muted(lk_local_track_t* track, int muted);
 LKC_API size_t lk_local_track_rtc_stats(const lk_local_track_t* track, char* buffer,
                                         size_t buffer_size);
+/* Copies up to layer_capacity layer states and returns how many layers the track has. */
+LKC_API size_t lk_local_track_dynacast_layers(const lk_local_track_t* track,
+                                              lk_dynacast_layer_t* layers, size_t layer_capacity);
 LKC_API lk_status_t lk_local_track_destroy(lk_local_track_t* track);
 
 LKC_API lk_status_t lk_room_set_remote_track_subscribed(lk_room_t* room,
@@ -1017,12 +1354,39 @@ LKC_API lk_status_t lk_room_set_remote_track_subscribed(lk_room_t* room,
 LKC_API lk_status_t lk_room_update_remote_track_settings(
     lk_room_t* room, const char* participant_sid, const char* track_sid,
     const lk_remote_track_settings_t* settings);
+/*
+ * With adaptive stream enabled, declares the size in pixels at which a subscribed remote video
+ * track is shown, or 0x0 when unknown. Hidden tracks are paused; visible ones receive the simulcast
+ * layer nearest that size. Changes are coalesced for 100 ms.
+ */
+LKC_API lk_status_t lk_room_set_remote_video_render_state(lk_room_t* room, const char* track_sid,
+                                                          uint32_t width, uint32_t height,
+                                                          int visible);
 LKC_API lk_status_t lk_room_set_track_subscription_permissions(
     lk_room_t* room, int all_participants_allowed,
     const lk_participant_track_permission_t* permissions, size_t permission_count);
 
 LKC_API lk_status_t lk_room_publish_data(lk_room_t* room, const uint8_t* data, size_t data_size,
                                          const lk_data_publish_options_t* options);
+/*
+ * Configures how lossy payloads published with coalesce set are batched. Takes effect on the next
+ * connect; a NULL options pointer restores the defaults (5 ms window, 1000-byte batches).
+ */
+LKC_API lk_status_t lk_room_set_data_batching(lk_room_t* room,
+                                              const lk_data_batching_options_t* options);
+LKC_API lk_status_t lk_room_data_batching_stats(const lk_room_t* room,
+                                                lk_data_batching_stats_t* stats);
+/* Copies up to stream_capacity stream states and returns how many streams are in progress. */
+LKC_API size_t lk_room_incoming_data_streams(const lk_room_t* room,
+                                             lk_incoming_data_stream_t* streams,
+                                             size_t stream_capacity);
+/*
+ * Configures how data streams sent with compress set are deflated. Takes effect on the next
+ * connect; a NULL options pointer restores the defaults.
+ */
+LKC_API lk_status_t
+lk_room_set_data_stream_compression(lk_room_t* room,
+                                    const lk_data_stream_compression_options_t* options);
 LKC_API lk_status_t lk_room_publish_dtmf(lk_room_t* room, uint32_t code, const char* digit);
 LKC_API lk_status_t lk_room_send_chat_message(lk_room_t* room, const char* message,
                                               char* message_id, size_t message_id_size,
@@ -1035,6 +1399,10 @@ LKC_API lk_status_t lk_room_send_bytes(lk_room_t* room, const uint8_t* data, siz
                                        const lk_byte_send_options_t* options);
 LKC_API lk_status_t lk_room_send_file(lk_room_t* room, const char* path,
                                       const lk_file_send_options_t* options);
+/* Returns once the stream header is sent; the room's file worker streams files one at a time in
+ * call order and also runs the progress and completion callbacks. */
+LKC_API lk_status_t lk_room_send_file_async(lk_room_t* room, const char* path,
+                                            const lk_file_send_options_t* options);
 LKC_API lk_status_t lk_room_stream_text(lk_room_t* room, const lk_stream_text_options_t* options,
                                         lk_text_stream_writer_t** writer);
 LKC_API lk_status_t lk_text_stream_writer_write(lk_text_stream_writer_t* writer, const char* text,
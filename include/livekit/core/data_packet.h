@@ -17,8 +17,34 @@ namespace core {
 
 struct DataPublishOptions {
 	bool reliable = true;
+	// "lk.data_batch" is reserved for coalesced packets; PublishData() rejects it unless the
+	// payload is coalesced.
 	std::string topic;
 	std::vector<std::string> destination_identities;
+	// Lossy payloads only: queue the payload with others for the same topic and destinations and
+	// send them together as one data packet (see DataBatchingOptions). Receivers running this SDK
+	// deliver each payload separately on its topic; other SDKs see one packet on the reserved
+	// "lk.data_batch" topic instead, so enable it only when every receiver runs this SDK.
+	bool coalesce = false;
+};
+
+// Configures coalesced publishing. A batch is sent once its oldest payload has waited window_ms,
+// or as soon as the next payload would take it past max_batch_bytes. Keep the budget below the
+// data channel MTU so each batch fits in a single SCTP packet.
+struct DataBatchingOptions {
+	uint32_t window_ms = 5;
+	uint32_t max_batch_bytes = 1000;
+};
+
+struct DataBatchingStats {
+	uint64_t messages = 0;
+	uint64_t packets = 0;
+	uint64_t failed_packets = 0;
+	uint32_t max_messages_per_packet = 0;
+	// Time payloads spent queued before their batch was sent, summed over messages and the worst
+	// single payload.
+	uint64_t total_added_latency_us = 0;
+	uint64_t max_added_latency_us = 0;
 };
 
 struct DataReceivedEvent {
@@ -101,6 +127,29 @@ struct MetricsReceivedEvent {
 	std::string participant_identity;
 };
 
+enum class DataStreamCompressionStrategy {
+	Default = 0,
+	Filtered = 1,
+	HuffmanOnly = 2,
+	Rle = 3,
+};
+
+// Tunes the raw-deflate compression of streams sent with compress set. level follows zlib: -1 is
+// zlib's default (6), 0 stores, 1 is fastest and 9 smallest. SendText, SendBytes and SendFile
+// payloads larger than one 128 KiB block are deflated on up to threads workers in parallel; 0 uses
+// one per core, at most 8. Incremental stream writers always compress on the writing thread.
+struct DataStreamCompressionOptions {
+	int32_t level = -1;
+	DataStreamCompressionStrategy strategy = DataStreamCompressionStrategy::Default;
+	uint32_t threads = 0;
+};
+
+using DataStreamProgressHandler =
+    std::function<void(uint64_t bytes_sent, std::optional<uint64_t> total_size)>;
+
+// Called once when a file stream ends; sent is false when the file was not sent in full.
+using FileSendCompletionHandler = std::function<void(const std::string& stream_id, bool sent)>;
+
 struct FileSendOptions {
 	std::string topic = "files";
 	std::string mime_type = "application/octet-stream";
@@ -108,6 +157,9 @@ struct FileSendOptions {
 	std::size_t chunk_size = 15'000;
 	std::map<std::string, std::string> attributes;
 	bool compress = false;
+	// bytes_sent counts file bytes, before compression.
+	DataStreamProgressHandler on_progress;
+	FileSendCompletionHandler on_complete;
 };
 
 struct TextSendOptions {
@@ -179,6 +231,23 @@ struct DataStreamInfo {
 	int64_t timestamp = 0;
 };
 
+// Reassembly state of one incoming stream. Streams read through a registered handler are passed
+// on chunk by chunk and hold no payload; the others are buffered until their trailer arrives.
+struct IncomingDataStreamStats {
+	std::string stream_id;
+	std::string topic;
+	std::string participant_identity;
+	bool compressed = false;
+	bool has_handler = false;
+	uint64_t received_bytes = 0;
+	uint64_t compressed_bytes = 0;
+	// Received bytes of compressed or buffered streams waiting for the stream thread.
+	uint64_t queued_bytes = 0;
+	// Heap held for the buffered payload, and the part of it moved to a temporary file.
+	uint64_t memory_bytes = 0;
+	uint64_t spilled_bytes = 0;
+};
+
 struct TextStreamInfo : DataStreamInfo {
 	std::string reply_to_stream_id;
 	std::vector<std::string> attached_stream_ids;
@@ -188,9 +257,6 @@ struct ByteStreamInfo : DataStreamInfo {
 	std::string name;
 };
 
-using DataStreamProgressHandler =
-    std::function<void(uint64_t bytes_sent, std::optional<uint64_t> total_size)>;
-
 struct StreamTextOptions {
 	std::string topic;
 	std::vector<std::string> destination_identities;
@@ -24,6 +24,7 @@
 #include "livekit/core/option/media_option.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -63,6 +64,41 @@ struct EncryptionStateEvent {
 
 using EncryptionStateCallback = std::function<void(const EncryptionStateEvent&)>;
 
+// Frame encryption and decryption for every room in the process runs on one pool with a worker
+// per hardware thread. Each cryptor's frames run in order on the same worker. In both histograms,
+// bucket 0 counts zeros and bucket i counts values in [2^(i-1), 2^i). The last bucket has no
+// upper bound.
+struct FrameCryptorPoolStats {
+	uint32_t workers = 0;
+	// Workers that have started a thread; each one starts on its first frame.
+	uint32_t threads = 0;
+	uint64_t frames = 0;
+	// The number of frames already queued on a worker when another frame arrived.
+	std::vector<uint64_t> queue_depth;
+	// Microseconds from the frame reaching its cryptor to the transformed frame being delivered.
+	std::vector<uint64_t> latency_us;
+	uint64_t max_latency_us = 0;
+};
+
+FrameCryptorPoolStats GetFrameCryptorPoolStats();
+
+// When a frame fails to decrypt, the cryptor tries the next ratchet_window_size ratchets of its
+// key. Those are derived ahead of time on a background thread whenever a key is set or ratcheted,
+// so a search never runs the key derivation itself. A search that reaches a step still being
+// derived drops the frame and counts as a miss; one that tries the whole window is neither.
+struct E2eeRatchetStats {
+	uint64_t searches = 0;
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	// Ratchet steps derived in the background.
+	uint64_t precomputed_steps = 0;
+	// Time spent searching the window on the frame path.
+	uint64_t total_latency_us = 0;
+	uint64_t max_latency_us = 0;
+};
+
+E2eeRatchetStats GetE2eeRatchetStats();
+
 class E2EEManagerNativeAccess;
 
 // Owns the room's frame cryptors and key provider. Returned FrameCryptorInfo values are
@@ -82,6 +82,13 @@ struct RemoteTrackSettings {
 	uint32_t priority = 0;
 };
 
+// How a subscriber currently shows a remote video track, in physical pixels. Zero dimensions mean
+// the size is not known yet.
+struct VideoRenderState {
+	TrackDimensions dimensions;
+	bool visible = true;
+};
+
 enum class VideoCodec {
 	VP8,
 	H264,
@@ -0,0 +1,74 @@
+/**
+ *
+ * Copyright (c) 2024 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_OPTION_PEER_FACTORY_H_
+#define _LKC_CORE_OPTION_PEER_FACTORY_H_
+
+#include <cstdint>
+#include <memory>
+
+namespace livekit {
+namespace core {
+
+// How a factory's audio device plays remote audio. Device mixes every subscribed track into the
+// selected playout device every 10 ms. Headless never opens a device and runs the mix only while
+// the factory has remote audio tracks, whose frames still reach OnAudioFrame, audio mixers and
+// audio streams; with none subscribed it costs nothing. Speaker volume, mute and device selection
+// are unavailable in headless mode.
+enum class AudioPlayout {
+	Device,
+	Headless,
+};
+
+struct PeerFactoryStats {
+	// Rooms that have connected through the factory and still hold it.
+	uint32_t rooms = 0;
+	// Threads the factory runs: the network, worker and signaling threads, plus the audio device
+	// thread once WebRTC has initialised it. Codec threads started per stream are not included.
+	uint32_t threads = 0;
+};
+
+// The threads, audio device module and codec factories behind a room's peer connections. A room
+// creates its own on first connect unless RoomOptions::peer_factory supplies one, so a process
+// that joins many rooms can run them all on one thread set and one copy of the codec state.
+//
+// Rooms sharing a factory also share its audio device: remote audio of every room is mixed into
+// one playout. So that no room changes another's output, a room given a factory refuses to set
+// the playout device, volume or mute. Use Room::CreateAudioMixer() for per-room remote audio.
+class PeerFactory {
+public:
+	virtual ~PeerFactory() = default;
+	virtual PeerFactoryStats GetStats() const = 0;
+
+protected:
+	PeerFactory() = default;
+};
+
+// Creates a factory the caller can pass to any number of rooms. It is released when the caller and
+// the last room using it let go.
+std::shared_ptr<PeerFactory> CreatePeerFactory(AudioPlayout playout = AudioPlayout::Device);
+
+// Returns the process-wide factory, creating it on first use. Every caller gets the same instance
+// while any caller or room still holds it. It plays through the audio device.
+std::shared_ptr<PeerFactory> ProcessPeerFactory();
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_OPTION_PEER_FACTORY_H_
@@ -21,9 +21,13 @@
 #define _LKC_CORE_OPTION_ROOM_OPTION_H_
 
 #include "e2ee_option.h"
+#include "peer_factory.h"
 #include "reconnect_policy.h"
 #include "rtc_engine_option.h"
 
+#include "livekit/core/data_packet.h"
+#include "livekit/core/track/video_frame.h"
+
 #include <optional>
 
 namespace livekit {
@@ -34,6 +38,70 @@ struct RoomSdkOptions {
 	std::string sdk_version = "0.0.1";
 };
 
+// Room events are queued per category. When several categories have events waiting, the one
+// listed first is delivered first; within a category events keep their order.
+enum class EventCategory {
+	// Connection state, participants joining, leaving and changing, room metadata and encryption.
+	Connection,
+	// Track publications, subscriptions, mutes and stream state.
+	Media,
+	// Data packets, chat, transcriptions, metrics and data streams.
+	Data,
+	// Active speakers and connection quality.
+	Speakers,
+};
+
+// Events are raised on the network and signaling threads, so a full queue never makes them wait.
+// Only lossy data packets and speaker and connection-quality updates can be dropped; every other
+// event is queued past the capacity instead. Drops are counted in EventQueueStats::dropped.
+enum class EventOverflowPolicy {
+	// The queue grows past its capacity and drops nothing.
+	Grow,
+	// A newer update replaces the queued one for the same subject (the speaker list, one
+	// participant's connection quality). Other events overflow as with DropLossy.
+	Coalesce,
+	// When the queue is full, the oldest lossy event is dropped to make room. Without one, a new
+	// lossy event is dropped, and any other event is queued past the capacity.
+	DropLossy,
+};
+
+struct EventQueueOptions {
+	uint32_t capacity = 256;
+	EventOverflowPolicy overflow = EventOverflowPolicy::Grow;
+};
+
+// Delivers RoomEventInterface callbacks on a room-owned thread, so a slow callback does not stall
+// the network and signaling threads. Audio and video frame callbacks are always delivered on the
+// thread that produced the frame.
+struct EventDispatchOptions {
+	// false calls the listener directly on the thread that raised the event.
+	bool enabled = true;
+	EventQueueOptions connection{256, EventOverflowPolicy::Grow};
+	EventQueueOptions media{1024, EventOverflowPolicy::Grow};
+	EventQueueOptions data{1024, EventOverflowPolicy::DropLossy};
+	EventQueueOptions speakers{64, EventOverflowPolicy::Coalesce};
+};
+
+struct EventQueueStats {
+	uint32_t depth = 0;
+	uint32_t max_depth = 0;
+	uint64_t dispatched = 0;
+	uint64_t coalesced = 0;
+	uint64_t dropped = 0;
+	// Time from an event being queued to its callback starting, summed over events and the worst
+	// single event, and the longest single callback.
+	uint64_t total_wait_us = 0;
+	uint64_t max_wait_us = 0;
+	uint64_t max_callback_us = 0;
+};
+
+struct EventDispatchStats {
+	EventQueueStats connection;
+	EventQueueStats media;
+	EventQueueStats data;
+	EventQueueStats speakers;
+};
+
 struct RoomOptions {
 	bool auto_subscribe = true;
 	bool adaptive_stream = false;
@@ -44,6 +112,19 @@ struct RoomOptions {
 	std::shared_ptr<ReconnectPolicy> reconnect_policy = CreateDefaultReconnectPolicy();
 	RoomSdkOptions sdk_options;
 	std::optional<E2eeOptions> e2ee;
+	VideoFrameDelivery video_frame_delivery = VideoFrameDelivery::Packed;
+	DataBatchingOptions data_batching;
+	DataStreamCompressionOptions data_stream_compression;
+	// Incoming streams without a handler are buffered until complete; past this many bytes the
+	// rest of a stream goes to a temporary file. 0 keeps every stream in memory.
+	uint64_t data_stream_spill_threshold = 16ULL * 1024 * 1024;
+	EventDispatchOptions event_dispatch;
+	// Shared by rooms that should not start their own threads and codec factories. Only the first
+	// connect of a room reads it; the room keeps that factory for its lifetime. Null creates one.
+	std::shared_ptr<PeerFactory> peer_factory;
+	// Playout of the factory the room creates for itself. Ignored when peer_factory is set; pass
+	// the mode to CreatePeerFactory() instead.
+	AudioPlayout audio_playout = AudioPlayout::Device;
 };
 
 RoomOptions default_room_options();
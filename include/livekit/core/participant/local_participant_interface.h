@@ -112,6 +112,12 @@ public:
 	virtual std::optional<ChatMessage> EditChatMessage(std::string, const ChatMessage&) {
 		return std::nullopt;
 	}
+	// Counters for payloads published with DataPublishOptions::coalesce.
+	virtual DataBatchingStats GetDataBatchingStats() const { return {}; }
+	// Sends the header and returns; the participant's file worker then streams the rest, one file
+	// at a time in call order. Progress and the outcome arrive through FileSendOptions::on_progress
+	// and on_complete on that thread.
+	virtual bool SendFileAsync(const std::string&, FileSendOptions = {}) { return false; }
 };
 
 } // namespace core
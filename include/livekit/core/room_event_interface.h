@@ -131,6 +131,10 @@ public:
 	virtual void OnSubscribedQualityUpdate(TrackPublicationInterface*, ParticipantInterface*,
 	                                       const SubscribedQualityUpdate&) {}
 	virtual void OnEncryptionStateChanged(const EncryptionStateEvent&) {}
+	// Delivered instead of OnVideoFrame() when RoomOptions::video_frame_delivery is Buffer. The
+	// buffer may be retained past the callback; it is released with the last shared_ptr copy.
+	virtual void OnVideoFrameBuffer(RemoteTrackInterface*, RemoteParticipantInterface*,
+	                                const VideoFrameBuffer&) {}
 };
 
 } // namespace core
@@ -29,6 +29,9 @@
 #include "protostruct/livekit_rtc_struct.h"
 #include "room_event_interface.h"
 #include "rpc.h"
+#include "track/audio_mixer_interface.h"
+#include "track/audio_stream_interface.h"
+#include "track/video_stream_interface.h"
 
 #include <memory>
 
@@ -81,7 +84,9 @@ public:
 	virtual bool RegisterByteStreamHandler(std::string, ByteStreamHandler) { return false; }
 	virtual bool UnregisterByteStreamHandler(const std::string&) { return false; }
 	// Audio output controls apply to the playback device owned by this room. They are available
-	// after Connect() has created the underlying peer transport factory.
+	// after Connect() has created the underlying peer transport factory. A room on a factory from
+	// RoomOptions::peer_factory shares that factory's device with the other rooms on it, so the
+	// setters refuse to change it and return false (see SharesAudioDevice()).
 	virtual bool SetAudioOutputDevice(std::string) { return false; }
 	virtual std::string AudioOutputDevice() const { return {}; }
 	virtual bool SetSpeakerVolume(float) { return false; }
@@ -89,9 +94,37 @@ public:
 	virtual bool SetSpeakerMuted(bool) { return false; }
 	virtual bool SpeakerMuted() const { return false; }
 	virtual AudioPlaybackStats GetAudioPlaybackStats() const { return {}; }
+	// Mixes remote audio tracks into one pulled 10 ms stream. The mixer stops receiving new tracks
+	// once the room is destroyed. Returns null when the options are invalid.
+	virtual std::shared_ptr<AudioMixerInterface> CreateAudioMixer(AudioMixerOptions = {}) {
+		return nullptr;
+	}
+	// Pull-mode queues for one subscribed remote track. Streams close when the track is
+	// unsubscribed or the room is destroyed. Returns null when the track is not a subscribed remote
+	// track of the matching kind or the options are invalid.
+	virtual std::shared_ptr<AudioStreamInterface> CreateAudioStream(const std::string&,
+	                                                                AudioStreamOptions = {}) {
+		return nullptr;
+	}
+	virtual std::shared_ptr<VideoStreamInterface> CreateVideoStream(const std::string&,
+	                                                                VideoStreamOptions = {}) {
+		return nullptr;
+	}
 	// The returned pointer is owned by the room and remains valid until the room is reconfigured or
 	// destroyed. A null pointer means E2EE is not configured.
 	virtual E2EEManager* GetE2EEManager() { return nullptr; }
+	// With RoomOptions::adaptive_stream, declares how a subscribed remote video track is shown.
+	// The room disables hidden tracks and requests the simulcast layer nearest the rendered size,
+	// coalescing changes for 100 ms. Tracks never declared keep the settings the application sets.
+	// Returns false when adaptive stream is off or the track is not a subscribed remote video.
+	virtual bool SetRemoteVideoRenderState(const std::string&, VideoRenderState) { return false; }
+	// Incoming data streams that have not finished yet, with what each holds in memory.
+	virtual std::vector<IncomingDataStreamStats> IncomingDataStreams() const { return {}; }
+	// Queue depths and delivery latency of room events (see RoomOptions::event_dispatch).
+	virtual EventDispatchStats GetEventDispatchStats() const { return {}; }
+	// True when the room runs on a factory from RoomOptions::peer_factory, whose audio device
+	// other rooms may share. Output device, volume and mute cannot be set on such a room.
+	virtual bool SharesAudioDevice() const { return false; }
 
 	// These controls return false when the room is disconnected or the participant/track SID does
 	// not belong to the room.
@@ -0,0 +1,85 @@
+/**
+ *
+ * Copyright (c) 2024 sunze
+ *
+ *Licensed under the Apache License, Version 2.0 (the "License");
+ *you may not use this file except in compliance with the License.
+ *You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing, software
+ *distributed under the License is distributed on an "AS IS" BASIS,
+ *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *See the License for the specific language governing permissions and
+ *limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_TRACK_AUDIO_MIXER_INTERFACE_H_
+#define _LKC_CORE_TRACK_AUDIO_MIXER_INTERFACE_H_
+
+#include "audio_frame.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace livekit {
+namespace core {
+
+struct AudioMixerOptions {
+	// Every mixed track is resampled and remixed to this layout. The sample rate must be a multiple
+	// of 100 so that a 10 ms frame holds a whole number of samples; 1 or 2 channels are supported.
+	uint32_t sample_rate = 48000;
+	uint32_t num_channels = 1;
+	// Audio buffered per track before newer frames are dropped. Bounds the added latency when
+	// Pull() falls behind.
+	uint32_t max_buffered_ms = 200;
+	// Mix every subscribed remote audio track, including tracks subscribed later. When false, only
+	// tracks passed to AddTrack() are mixed.
+	bool include_all_tracks = true;
+};
+
+struct AudioMixerStats {
+	uint32_t track_count = 0;
+	uint64_t mixed_frames = 0;
+	// Per-track 10 ms slots that Pull() had to fill with silence because the track had not
+	// delivered a full frame yet.
+	uint64_t underrun_frames = 0;
+	// Track frames dropped because the track's buffer already held max_buffered_ms of audio.
+	uint64_t overrun_frames = 0;
+};
+
+// Receives one track's 10 ms frame after resampling and gain, before it is mixed. Taps run on the
+// thread calling Pull() and must not call back into the mixer.
+using AudioMixerTap =
+    std::function<void(const std::string& participant_sid, const std::string& track_sid,
+                       const AudioFrame& frame)>;
+
+// Created by RoomInterface::CreateAudioMixer(). Tracks are resampled on their receive threads and
+// mixed on the thread calling Pull(); the mixer allocates only when tracks are added.
+class AudioMixerInterface {
+public:
+	virtual ~AudioMixerInterface() = default;
+
+	virtual AudioMixerOptions Options() const = 0;
+	// Returns false when the track is not a subscribed remote audio track or is already mixed.
+	virtual bool AddTrack(const std::string& track_sid) = 0;
+	virtual bool RemoveTrack(const std::string& track_sid) = 0;
+	// Applies to every current and future track of the participant. gain must be finite and >= 0.
+	virtual bool SetParticipantGain(const std::string& participant_sid, float gain) = 0;
+	// An empty tap removes the previous one. Returns false when the track is not mixed.
+	virtual bool SetTrackTap(const std::string& track_sid, AudioMixerTap tap) = 0;
+	// Fills frame with the next 10 ms of mixed audio. frame.data is reused, so passing the same
+	// frame on every call keeps the mixer from allocating. Returns false when no track contributed
+	// audio; frame then holds silence.
+	virtual bool Pull(AudioFrame& frame) = 0;
+	virtual AudioMixerStats Stats() const = 0;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_TRACK_AUDIO_MIXER_INTERFACE_H_
@@ -52,14 +52,33 @@ struct MicrophoneAudioProcessingStats {
 	uint64_t render_processing_errors = 0;
 	uint64_t frames_dropped = 0;
 	bool echo_cancellation_enabled = false;
+	// False while echo cancellation is enabled but the source is not bound to a playout device
+	// yet, so the canceller has no render reference and passes capture audio through.
+	bool echo_reference_attached = false;
 };
 
+// Health of the PCM queue behind a queued audio source. Sources without a queue report zeros.
+struct AudioSourceQueueStats {
+	// 10 ms delivery ticks that found less than a full frame queued.
+	uint64_t underrun_frames = 0;
+	// CaptureFrame() calls rejected because the queue was full.
+	uint64_t overrun_frames = 0;
+	uint32_t queued_samples = 0;
+	uint32_t capacity_samples = 0;
+};
+
+class AudioSourceInterface;
+AudioSourceQueueStats GetAudioSourceQueueStats(const AudioSourceInterface* source);
+
 class AudioSourceInterface {
 public:
 	virtual ~AudioSourceInterface() = default;
 
+	// May be called from several threads; queued sources never block on delivery.
 	virtual bool CaptureFrame(void* audio_data, uint32_t sample_rate, uint32_t num_channels,
 	                          uint32_t samples_per_channel) = 0;
+
+	AudioSourceQueueStats QueueStats() const { return GetAudioSourceQueueStats(this); }
 };
 
 class MicrophoneAudioSourceInterface;
@@ -20,4 +20,52 @@
 #ifndef _LKC_CORE_TRACK_AUDIO_STREAM_INTERFACE_H_
 #define _LKC_CORE_TRACK_AUDIO_STREAM_INTERFACE_H_
 
-#endif // _LKC_CORE_TRACK_AUDIO_STREAM_INTERFACE_H_
\ No newline at end of file
+#include "audio_frame.h"
+#include "frame_stream.h"
+
+#include <string>
+
+namespace livekit {
+namespace core {
+
+struct AudioStreamOptions {
+	// Frames are resampled and remixed to this layout on the receive thread. The sample rate must
+	// be a multiple of 100; 1 or 2 channels are supported.
+	uint32_t sample_rate = 48000;
+	uint32_t num_channels = 1;
+	// Queue length in 10 ms frames.
+	uint32_t capacity_frames = 50;
+	FrameStreamOverflow overflow = FrameStreamOverflow::DropOldest;
+	uint32_t block_timeout_ms = 10;
+};
+
+// Pull-mode access to one remote audio track, created by RoomInterface::CreateAudioStream(). The
+// receive thread only copies into a preallocated queue slot, so a slow reader costs dropped frames
+// rather than a stalled decoder. Read() expects one reader thread at a time.
+class AudioStreamInterface {
+public:
+	virtual ~AudioStreamInterface() = default;
+
+	virtual std::string TrackSid() const = 0;
+	// Waits up to timeout for the next frame. frame.data is swapped with the queue slot, so reusing
+	// the same frame avoids allocation. Returns false on timeout, or once the stream is closed and
+	// every queued frame has been read.
+	virtual bool Read(AudioFrame& frame,
+	                  std::chrono::milliseconds timeout = kFrameStreamWaitForever) = 0;
+	// A descriptor that polls readable while a frame is queued, for select/poll/epoll loops. -1 on
+	// Windows; use EventHandle() there.
+	virtual int EventFd() const = 0;
+	// Detaches from the track and wakes readers. Called by the room when the track is unsubscribed.
+	virtual void Close() = 0;
+	virtual bool IsClosed() const = 0;
+	virtual FrameStreamStats Stats() const = 0;
+	// On Windows, a manual-reset event HANDLE that is signaled while a frame is queued, for
+	// WaitForMultipleObjects loops. Like EventFd(), it stays signaled once the stream is closed.
+	// nullptr on other platforms. Owned by the stream: do not close or reset it.
+	virtual void* EventHandle() const { return nullptr; }
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_TRACK_AUDIO_STREAM_INTERFACE_H_
@@ -0,0 +1,53 @@
+/**
+ *
+ * Copyright (c) 2026 sunze
+ *
+ *Licensed under the Apache License, Version 2.0 (the "License");
+ *you may not use this file except in compliance with the License.
+ *You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing, software
+ *distributed under the License is distributed on an "AS IS" BASIS,
+ *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *See the License for the specific language governing permissions and
+ *limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_TRACK_FRAME_STREAM_H_
+#define _LKC_CORE_TRACK_FRAME_STREAM_H_
+
+#include <chrono>
+#include <cstdint>
+
+namespace livekit {
+namespace core {
+
+// What a pull-mode stream does with a new frame when its queue is full.
+enum class FrameStreamOverflow {
+	// Evict the oldest queued frame.
+	DropOldest,
+	// Discard everything queued and keep only the new frame, so the reader catches up at once.
+	KeepLatest,
+	// Make the receive thread wait up to block_timeout_ms for space, then drop the new frame.
+	Block,
+};
+
+struct FrameStreamStats {
+	uint32_t queued_frames = 0;
+	uint32_t capacity_frames = 0;
+	uint64_t pushed_frames = 0;
+	uint64_t read_frames = 0;
+	uint64_t dropped_frames = 0;
+};
+
+inline constexpr std::chrono::milliseconds kFrameStreamWaitForever =
+    std::chrono::milliseconds::max();
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_TRACK_FRAME_STREAM_H_
@@ -23,6 +23,7 @@
 #include "subscribed_quality.h"
 
 #include <optional>
+#include <vector>
 
 namespace livekit {
 namespace core {
@@ -33,6 +34,9 @@ public:
 	virtual std::optional<SubscribedQualityUpdate> LastSubscribedQualityUpdate() const {
 		return std::nullopt;
 	}
+	// Per-layer activation state; empty unless dynacast is enabled and the server has sent a
+	// subscribed quality update for this track.
+	virtual std::vector<DynacastLayerStats> DynacastLayers() const { return {}; }
 };
 
 } // namespace core
@@ -62,6 +62,8 @@ struct RTCTrackStats {
 	uint64_t pli_count = 0;
 	uint64_t nack_count = 0;
 	uint64_t qp_sum = 0;
+	// Cumulative encoder busy time of an outbound stream.
+	double total_encode_time_seconds = 0.0;
 	std::string codec_mime_type;
 	std::string codec_implementation;
 	std::string quality_limitation_reason;
@@ -22,6 +22,7 @@
 
 #include "livekit/core/option/media_option.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,19 @@ struct SubscribedQualityUpdate {
 	std::vector<SubscribedCodec> codecs;
 };
 
+// Encoder-side state of one simulcast layer while dynacast is enabled. A layer the server stops
+// requesting keeps encoding for a short hold before it is paused, so pause_pending layers are
+// still active. paused_ms and encode_seconds_saved include the current pause.
+struct DynacastLayerStats {
+	VideoQuality quality = VideoQuality::Low;
+	bool active = true;
+	bool pause_pending = false;
+	uint32_t pauses = 0;
+	uint64_t paused_ms = 0;
+	// Estimated from the layer's encoder time per second over its last active period.
+	double encode_seconds_saved = 0.0;
+};
+
 } // namespace core
 } // namespace livekit
 
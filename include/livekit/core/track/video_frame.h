@@ -4,6 +4,7 @@
 #define _LKC_CORE_TRACK_VIDEO_FRAME_H_
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace livekit {
@@ -25,6 +26,38 @@ struct VideoFrame {
 	VideoRotation rotation = VideoRotation::Rotation0;
 };
 
+// Selects how decoded remote video reaches RoomEventInterface listeners. Packed copies every frame
+// into a VideoFrame; Buffer shares the decoder's I420 planes through OnVideoFrameBuffer().
+enum class VideoFrameDelivery {
+	Packed,
+	Buffer,
+};
+
+// A read-only, stride-aware view of decoder-owned I420 planes. Rows may be padded, so each plane
+// must be addressed through its stride. The planes stay valid while any reference is held.
+class I420BufferInterface {
+public:
+	virtual ~I420BufferInterface() = default;
+
+	virtual uint32_t Width() const = 0;
+	virtual uint32_t Height() const = 0;
+	virtual const uint8_t* DataY() const = 0;
+	virtual const uint8_t* DataU() const = 0;
+	virtual const uint8_t* DataV() const = 0;
+	virtual int StrideY() const = 0;
+	virtual int StrideU() const = 0;
+	virtual int StrideV() const = 0;
+
+	uint32_t ChromaWidth() const { return (Width() + 1) / 2; }
+	uint32_t ChromaHeight() const { return (Height() + 1) / 2; }
+};
+
+struct VideoFrameBuffer {
+	std::shared_ptr<const I420BufferInterface> buffer;
+	int64_t timestamp_us = 0;
+	VideoRotation rotation = VideoRotation::Rotation0;
+};
+
 } // namespace core
 } // namespace livekit
 
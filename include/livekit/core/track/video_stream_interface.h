@@ -0,0 +1,59 @@
+/**
+ *
+ * Copyright (c) 2026 sunze
+ *
+ *Licensed under the Apache License, Version 2.0 (the "License");
+ *you may not use this file except in compliance with the License.
+ *You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing, software
+ *distributed under the License is distributed on an "AS IS" BASIS,
+ *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *See the License for the specific language governing permissions and
+ *limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_TRACK_VIDEO_STREAM_INTERFACE_H_
+#define _LKC_CORE_TRACK_VIDEO_STREAM_INTERFACE_H_
+
+#include "frame_stream.h"
+#include "video_frame.h"
+
+#include <string>
+
+namespace livekit {
+namespace core {
+
+struct VideoStreamOptions {
+	uint32_t capacity_frames = 2;
+	FrameStreamOverflow overflow = FrameStreamOverflow::KeepLatest;
+	uint32_t block_timeout_ms = 10;
+};
+
+// Pull-mode access to one remote video track, created by RoomInterface::CreateVideoStream(). Queued
+// frames share the decoder's I420 planes, so the queue holds references rather than copies. Keep
+// capacity_frames small: each queued frame keeps a decoder buffer alive.
+class VideoStreamInterface {
+public:
+	virtual ~VideoStreamInterface() = default;
+
+	virtual std::string TrackSid() const = 0;
+	// Same contract as AudioStreamInterface::Read().
+	virtual bool Read(VideoFrameBuffer& frame,
+	                  std::chrono::milliseconds timeout = kFrameStreamWaitForever) = 0;
+	virtual int EventFd() const = 0;
+	virtual void Close() = 0;
+	virtual bool IsClosed() const = 0;
+	virtual FrameStreamStats Stats() const = 0;
+	// Same contract as AudioStreamInterface::EventHandle().
+	virtual void* EventHandle() const { return nullptr; }
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_TRACK_VIDEO_STREAM_INTERFACE_H_
@@ -4,6 +4,7 @@
 #include "livekit/core/rpc.h"
 #include "livekit/core/track/audio_source_interface.h"
 #include "livekit/core/track/local_track_interface.h"
+#include "livekit/core/track/local_track_publication_interface.h"
 #include "livekit/core/track/remote_track_interface.h"
 #include "livekit/core/track/video_source_interface.h"
 
@@ -60,6 +61,21 @@ struct lk_room {
 	std::vector<std::shared_ptr<AsyncRpcTask>> async_rpc_tasks;
 	lk_room_callbacks_t callbacks{};
 	std::shared_ptr<RoomHandleState> state = std::make_shared<RoomHandleState>();
+	std::atomic<core::VideoFrameDelivery> video_frame_delivery{core::VideoFrameDelivery::Packed};
+	std::mutex data_batching_mutex;
+	core::DataBatchingOptions data_batching;
+	// Guarded by data_batching_mutex, like the other data options read at connect.
+	core::DataStreamCompressionOptions data_stream_compression;
+	std::mutex peer_factory_mutex;
+	std::shared_ptr<core::PeerFactory> peer_factory;
+	std::atomic<core::AudioPlayout> audio_playout{core::AudioPlayout::Device};
+	std::atomic<bool> adaptive_stream{false};
+	std::mutex event_dispatch_mutex;
+	core::EventDispatchOptions event_dispatch;
+};
+
+struct lk_peer_factory {
+	std::shared_ptr<core::PeerFactory> factory;
 };
 
 struct lk_audio_source {
@@ -69,6 +85,20 @@ struct lk_audio_source {
 	uint32_t num_channels = 0;
 };
 
+struct lk_audio_mixer {
+	std::shared_ptr<core::AudioMixerInterface> mixer;
+	core::AudioFrame frame;
+};
+
+struct lk_audio_stream {
+	std::shared_ptr<core::AudioStreamInterface> stream;
+	core::AudioFrame frame;
+};
+
+struct lk_video_stream {
+	std::shared_ptr<core::VideoStreamInterface> stream;
+};
+
 struct lk_video_source {
 	std::unique_ptr<core::VideoSourceInterface> source;
 	std::atomic_size_t track_references{0};
@@ -87,6 +117,12 @@ struct lk_rpc_result {
 	core::RpcResult result;
 };
 
+struct lk_video_frame_buffer {
+	explicit lk_video_frame_buffer(const core::VideoFrameBuffer& source) : frame(source) {}
+	core::VideoFrameBuffer frame;
+	std::atomic<uint32_t> references{1};
+};
+
 struct CDataStreamCompletionState {
 	std::mutex mutex;
 	lk_data_stream_completion_callback callback = nullptr;
@@ -279,6 +315,48 @@ void NotifyDataStreamCompletion(const std::shared_ptr<CDataStreamCompletionState
 #define LKC_HAS_FIELD(value, type, field)                                                          \
 	HasField((value)->struct_size, offsetof(type, field), sizeof((value)->field))
 
+std::optional<core::FrameStreamOverflow>
+ToCoreFrameStreamOverflow(lk_frame_stream_overflow_t value) {
+	switch (value) {
+	case LK_FRAME_STREAM_OVERFLOW_DROP_OLDEST:
+		return core::FrameStreamOverflow::DropOldest;
+	case LK_FRAME_STREAM_OVERFLOW_KEEP_LATEST:
+		return core::FrameStreamOverflow::KeepLatest;
+	case LK_FRAME_STREAM_OVERFLOW_BLOCK:
+		return core::FrameStreamOverflow::Block;
+	default:
+		return std::nullopt;
+	}
+}
+
+lk_frame_stream_overflow_t ToCFrameStreamOverflow(core::FrameStreamOverflow value) {
+	switch (value) {
+	case core::FrameStreamOverflow::KeepLatest:
+		return LK_FRAME_STREAM_OVERFLOW_KEEP_LATEST;
+	case core::FrameStreamOverflow::Block:
+		return LK_FRAME_STREAM_OVERFLOW_BLOCK;
+	case core::FrameStreamOverflow::DropOldest:
+	default:
+		return LK_FRAME_STREAM_OVERFLOW_DROP_OLDEST;
+	}
+}
+
+std::chrono::milliseconds ToFrameStreamTimeout(int64_t timeout_ms) {
+	return timeout_ms < 0 ? core::kFrameStreamWaitForever : std::chrono::milliseconds(timeout_ms);
+}
+
+lk_status_t CopyFrameStreamStats(const core::FrameStreamStats& values,
+                                 lk_frame_stream_stats_t* stats) {
+	lk_frame_stream_stats_t result;
+	lk_frame_stream_stats_init(&result);
+	result.queued_frames = values.queued_frames;
+	result.capacity_frames = values.capacity_frames;
+	result.pushed_frames = values.pushed_frames;
+	result.read_frames = values.read_frames;
+	result.dropped_frames = values.dropped_frames;
+	return CopyOutputStruct(result, stats, "initialized stream stats are required");
+}
+
 core::TrackSource ToCoreTrackSource(lk_track_source_t source) {
 	switch (source) {
 	case LK_TRACK_SOURCE_CAMERA:
@@ -313,6 +391,90 @@ bool ToCoreVideoCodec(lk_video_codec_t codec, core::VideoCodec& result) {
 	}
 }
 
+bool ToCoreEventQueueOptions(const lk_event_queue_options_t& options,
+                             core::EventQueueOptions& result) {
+	if (options.capacity == 0) {
+		return false;
+	}
+	result.capacity = options.capacity;
+	switch (options.overflow) {
+	case LK_EVENT_OVERFLOW_GROW:
+		result.overflow = core::EventOverflowPolicy::Grow;
+		return true;
+	case LK_EVENT_OVERFLOW_COALESCE:
+		result.overflow = core::EventOverflowPolicy::Coalesce;
+		return true;
+	case LK_EVENT_OVERFLOW_DROP_LOSSY:
+		result.overflow = core::EventOverflowPolicy::DropLossy;
+		return true;
+	default:
+		return false;
+	}
+}
+
+lk_event_queue_options_t ToCEventQueueOptions(const core::EventQueueOptions& options) {
+	lk_event_queue_options_t result{};
+	result.capacity = options.capacity;
+	switch (options.overflow) {
+	case core::EventOverflowPolicy::Grow:
+		result.overflow = LK_EVENT_OVERFLOW_GROW;
+		break;
+	case core::EventOverflowPolicy::Coalesce:
+		result.overflow = LK_EVENT_OVERFLOW_COALESCE;
+		break;
+	case core::EventOverflowPolicy::DropLossy:
+		result.overflow = LK_EVENT_OVERFLOW_DROP_LOSSY;
+		break;
+	}
+	return result;
+}
+
+lk_event_queue_stats_t ToCEventQueueStats(const core::EventQueueStats& stats) {
+	lk_event_queue_stats_t result{};
+	result.depth = stats.depth;
+	result.max_depth = stats.max_depth;
+	result.dispatched = stats.dispatched;
+	result.coalesced = stats.coalesced;
+	result.dropped = stats.dropped;
+	result.total_wait_us = stats.total_wait_us;
+	result.max_wait_us = stats.max_wait_us;
+	result.max_callback_us = stats.max_callback_us;
+	return result;
+}
+
+bool ToCoreCompressionStrategy(lk_data_stream_compression_strategy_t strategy,
+                               core::DataStreamCompressionStrategy& result) {
+	switch (strategy) {
+	case LK_DATA_STREAM_COMPRESSION_STRATEGY_DEFAULT:
+		result = core::DataStreamCompressionStrategy::Default;
+		return true;
+	case LK_DATA_STREAM_COMPRESSION_STRATEGY_FILTERED:
+		result = core::DataStreamCompressionStrategy::Filtered;
+		return true;
+	case LK_DATA_STREAM_COMPRESSION_STRATEGY_HUFFMAN_ONLY:
+		result = core::DataStreamCompressionStrategy::HuffmanOnly;
+		return true;
+	case LK_DATA_STREAM_COMPRESSION_STRATEGY_RLE:
+		result = core::DataStreamCompressionStrategy::Rle;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool ToCoreAudioPlayout(lk_audio_playout_t playout, core::AudioPlayout& result) {
+	switch (playout) {
+	case LK_AUDIO_PLAYOUT_DEVICE:
+		result = core::AudioPlayout::Device;
+		return true;
+	case LK_AUDIO_PLAYOUT_HEADLESS:
+		result = core::AudioPlayout::Headless;
+		return true;
+	default:
+		return false;
+	}
+}
+
 lk_status_t ToCoreTrackPublishOptions(const lk_track_publish_options_t* options,
                                       core::TrackPublishOptions& result) {
 	if (options == nullptr) {
@@ -912,6 +1074,31 @@ public:
 		});
 	}
 
+	void OnVideoFrameBuffer(core::RemoteTrackInterface* track,
+	                        core::RemoteParticipantInterface* participant,
+	                        const core::VideoFrameBuffer& frame) override {
+		if (!frame.buffer) {
+			return;
+		}
+		OwnedTrackInfo owned_track(track, participant);
+		OwnedParticipantInfo owned_participant(participant);
+		// The callback borrows this reference; applications retain it to hold the frame longer.
+		auto* buffer = new lk_video_frame_buffer_t(frame);
+		const lk_video_frame_t c_frame{nullptr,
+		                               0,
+		                               frame.buffer->Width(),
+		                               frame.buffer->Height(),
+		                               frame.timestamp_us,
+		                               buffer};
+		InvokeRoomCallback(owner_, [&](const lk_room_callbacks_t& callbacks) {
+			if (callbacks.on_video_frame != nullptr) {
+				callbacks.on_video_frame(callbacks.user_data, owner_, &owned_track.info,
+				                         &owned_participant.info, &c_frame);
+			}
+		});
+		lk_video_frame_buffer_release(buffer);
+	}
+
 	void OnDataReceived(const core::DataReceivedEvent& event) override {
 		const lk_data_received_t c_event{event.payload.data(), event.payload.size(),
 		                                 event.topic.c_str(), event.participant_identity.c_str(),
@@ -1224,6 +1411,78 @@ lk_status_t ToCorePerformRpcParams(const lk_rpc_perform_options_t* options,
 	return LK_STATUS_OK;
 }
 
+lk_status_t ToCoreFileSendOptions(const lk_file_send_options_t* options,
+                                  core::FileSendOptions& send_options) {
+	if (options == nullptr) {
+		return LK_STATUS_OK;
+	}
+	if (options->struct_size < sizeof(options->struct_size)) {
+		return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid file options struct size");
+	}
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, topic) && options->topic != nullptr) {
+		send_options.topic = options->topic;
+	}
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, mime_type) &&
+	    options->mime_type != nullptr) {
+		send_options.mime_type = options->mime_type;
+	}
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, destination_identity_count)) {
+		if (options->destination_identity_count != 0 &&
+		    options->destination_identities == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "destination identities are null");
+		}
+		send_options.destination_identities = DestinationIdentities(
+		    options->destination_identities, options->destination_identity_count);
+	}
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, chunk_size)) {
+		send_options.chunk_size = options->chunk_size;
+	}
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, attribute_count) &&
+	    !CopyAttributes(options->attributes, options->attribute_count, send_options.attributes)) {
+		return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid file attributes");
+	}
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, compress)) {
+		send_options.compress = options->compress != 0;
+	}
+	std::shared_ptr<CDataStreamCompletionState> completion;
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, on_complete) && options->on_complete) {
+		completion = std::make_shared<CDataStreamCompletionState>();
+		completion->callback = options->on_complete;
+		completion->user_data =
+		    LKC_HAS_FIELD(options, lk_file_send_options_t, completion_user_data)
+		        ? options->completion_user_data
+		        : nullptr;
+		send_options.on_complete = [completion](const std::string& stream_id, bool sent) {
+			{
+				std::lock_guard<std::mutex> guard(completion->mutex);
+				completion->stream_id = stream_id;
+			}
+			NotifyDataStreamCompletion(
+			    completion,
+			    sent ? LK_DATA_STREAM_COMPLETION_COMPLETED : LK_DATA_STREAM_COMPLETION_FAILED,
+			    sent ? std::string{} : "failed to send file");
+		};
+	}
+	lk_data_stream_progress_callback progress_callback = nullptr;
+	void* progress_user_data = nullptr;
+	if (LKC_HAS_FIELD(options, lk_file_send_options_t, on_progress) && options->on_progress) {
+		progress_callback = options->on_progress;
+		progress_user_data = LKC_HAS_FIELD(options, lk_file_send_options_t, progress_user_data)
+		                         ? options->progress_user_data
+		                         : nullptr;
+	}
+	if (progress_callback != nullptr || completion) {
+		send_options.on_progress = [progress_callback, progress_user_data,
+		                            completion](uint64_t sent, std::optional<uint64_t> total) {
+			UpdateDataStreamProgress(completion, sent, total);
+			if (progress_callback != nullptr) {
+				progress_callback(progress_user_data, sent, total.has_value(), total.value_or(0));
+			}
+		};
+	}
+	return LK_STATUS_OK;
+}
+
 } // namespace
 
 extern "C" {
@@ -1414,6 +1673,63 @@ void lk_microphone_processing_stats_init(lk_microphone_processing_stats_t* stats
 	}
 }
 
+void lk_audio_source_queue_stats_init(lk_audio_source_queue_stats_t* stats) {
+	if (stats != nullptr) {
+		*stats = {};
+		stats->struct_size = sizeof(*stats);
+	}
+}
+
+void lk_audio_mixer_options_init(lk_audio_mixer_options_t* options) {
+	if (options != nullptr) {
+		*options = {};
+		options->struct_size = sizeof(*options);
+		const core::AudioMixerOptions defaults;
+		options->sample_rate = defaults.sample_rate;
+		options->num_channels = defaults.num_channels;
+		options->max_buffered_ms = defaults.max_buffered_ms;
+		options->include_all_tracks = defaults.include_all_tracks ? 1 : 0;
+	}
+}
+
+void lk_audio_mixer_stats_init(lk_audio_mixer_stats_t* stats) {
+	if (stats != nullptr) {
+		*stats = {};
+		stats->struct_size = sizeof(*stats);
+	}
+}
+
+void lk_audio_stream_options_init(lk_audio_stream_options_t* options) {
+	if (options != nullptr) {
+		*options = {};
+		options->struct_size = sizeof(*options);
+		const core::AudioStreamOptions defaults;
+		options->sample_rate = defaults.sample_rate;
+		options->num_channels = defaults.num_channels;
+		options->capacity_frames = defaults.capacity_frames;
+		options->overflow = ToCFrameStreamOverflow(defaults.overflow);
+		options->block_timeout_ms = defaults.block_timeout_ms;
+	}
+}
+
+void lk_video_stream_options_init(lk_video_stream_options_t* options) {
+	if (options != nullptr) {
+		*options = {};
+		options->struct_size = sizeof(*options);
+		const core::VideoStreamOptions defaults;
+		options->capacity_frames = defaults.capacity_frames;
+		options->overflow = ToCFrameStreamOverflow(defaults.overflow);
+		options->block_timeout_ms = defaults.block_timeout_ms;
+	}
+}
+
+void lk_frame_stream_stats_init(lk_frame_stream_stats_t* stats) {
+	if (stats != nullptr) {
+		*stats = {};
+		stats->struct_size = sizeof(*stats);
+	}
+}
+
 void lk_video_source_options_init(lk_video_source_options_t* options) {
 	if (options != nullptr) {
 		*options = {};
@@ -1459,6 +1775,61 @@ void lk_data_publish_options_init(lk_data_publish_options_t* options) {
 	}
 }
 
+void lk_data_batching_options_init(lk_data_batching_options_t* options) {
+	if (options != nullptr) {
+		*options = {};
+		options->struct_size = sizeof(*options);
+		const core::DataBatchingOptions defaults;
+		options->window_ms = defaults.window_ms;
+		options->max_batch_bytes = defaults.max_batch_bytes;
+	}
+}
+
+void lk_data_batching_stats_init(lk_data_batching_stats_t* stats) {
+	if (stats != nullptr) {
+		*stats = {};
+		stats->struct_size = sizeof(*stats);
+	}
+}
+
+void lk_data_stream_compression_options_init(lk_data_stream_compression_options_t* options) {
+	if (options != nullptr) {
+		*options = {};
+		options->struct_size = sizeof(*options);
+		const core::DataStreamCompressionOptions defaults;
+		options->level = defaults.level;
+		options->strategy = LK_DATA_STREAM_COMPRESSION_STRATEGY_DEFAULT;
+		options->threads = defaults.threads;
+	}
+}
+
+void lk_event_dispatch_options_init(lk_event_dispatch_options_t* options) {
+	if (options != nullptr) {
+		*options = {};
+		options->struct_size = sizeof(*options);
+		const core::EventDispatchOptions defaults;
+		options->enabled = defaults.enabled ? 1 : 0;
+		options->connection = ToCEventQueueOptions(defaults.connection);
+		options->media = ToCEventQueueOptions(defaults.media);
+		options->data = ToCEventQueueOptions(defaults.data);
+		options->speakers = ToCEventQueueOptions(defaults.speakers);
+	}
+}
+
+void lk_event_dispatch_stats_init(lk_event_dispatch_stats_t* stats) {
+	if (stats != nullptr) {
+		*stats = {};
+		stats->struct_size = sizeof(*stats);
+	}
+}
+
+void lk_peer_factory_stats_init(lk_peer_factory_stats_t* stats) {
+	if (stats != nullptr) {
+		*stats = {};
+		stats->struct_size = sizeof(*stats);
+	}
+}
+
 void lk_file_send_options_init(lk_file_send_options_t* options) {
 	if (options != nullptr) {
 		*options = {};
@@ -1549,6 +1920,74 @@ void lk_remote_track_snapshot_info_init(lk_remote_track_snapshot_info_t* info) {
 	}
 }
 
+void lk_video_frame_planes_init(lk_video_frame_planes_t* planes) {
+	if (planes != nullptr) {
+		*planes = {};
+		planes->struct_size = sizeof(*planes);
+	}
+}
+
+lk_status_t lk_peer_factory_create(lk_peer_factory_t** factory) {
+	return lk_peer_factory_create_with_playout(LK_AUDIO_PLAYOUT_DEVICE, factory);
+}
+
+lk_status_t lk_peer_factory_create_with_playout(lk_audio_playout_t playout,
+                                                lk_peer_factory_t** factory) {
+	return Guard([&] {
+		if (factory == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "peer factory output is null");
+		}
+		*factory = nullptr;
+		core::AudioPlayout audio_playout = core::AudioPlayout::Device;
+		if (!ToCoreAudioPlayout(playout, audio_playout)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid audio playout");
+		}
+		auto result = std::make_unique<lk_peer_factory_t>();
+		result->factory = core::CreatePeerFactory(audio_playout);
+		if (!result->factory) {
+			return Failure(LK_STATUS_OPERATION_FAILED, "failed to create peer factory");
+		}
+		*factory = result.release();
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_peer_factory_process(lk_peer_factory_t** factory) {
+	return Guard([&] {
+		if (factory == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "peer factory output is null");
+		}
+		*factory = nullptr;
+		auto result = std::make_unique<lk_peer_factory_t>();
+		result->factory = core::ProcessPeerFactory();
+		if (!result->factory) {
+			return Failure(LK_STATUS_OPERATION_FAILED, "failed to create peer factory");
+		}
+		*factory = result.release();
+		return LK_STATUS_OK;
+	});
+}
+
+void lk_peer_factory_destroy(lk_peer_factory_t* factory) { delete factory; }
+
+lk_status_t lk_peer_factory_stats(const lk_peer_factory_t* factory,
+                                  lk_peer_factory_stats_t* stats) {
+	return Guard([&] {
+		if (factory == nullptr || stats == nullptr ||
+		    stats->struct_size < sizeof(stats->struct_size)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT,
+			               "peer factory and initialized stats are required");
+		}
+		const auto values = factory->factory->GetStats();
+		lk_peer_factory_stats_t result;
+		lk_peer_factory_stats_init(&result);
+		result.rooms = values.rooms;
+		result.threads = values.threads;
+		std::memcpy(stats, &result, std::min(stats->struct_size, sizeof(result)));
+		return LK_STATUS_OK;
+	});
+}
+
 lk_status_t lk_room_create(lk_room_t** room) {
 	return Guard([&] {
 		if (room == nullptr) {
@@ -1613,148 +2052,606 @@ lk_status_t lk_room_set_callbacks(lk_room_t* room, const lk_room_callbacks_t* ca
 			std::memcpy(&copy, callbacks, std::min(callbacks->struct_size, sizeof(copy)));
 			copy.struct_size = sizeof(copy);
 		}
-		std::lock_guard<std::mutex> guard(room->callbacks_mutex);
-		room->callbacks = copy;
+		std::lock_guard<std::mutex> guard(room->callbacks_mutex);
+		room->callbacks = copy;
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_set_video_frame_delivery(lk_room_t* room,
+                                             lk_video_frame_delivery_t delivery) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		switch (delivery) {
+		case LK_VIDEO_FRAME_DELIVERY_PACKED:
+			room->video_frame_delivery.store(core::VideoFrameDelivery::Packed);
+			return LK_STATUS_OK;
+		case LK_VIDEO_FRAME_DELIVERY_BUFFER:
+			room->video_frame_delivery.store(core::VideoFrameDelivery::Buffer);
+			return LK_STATUS_OK;
+		default:
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid video frame delivery");
+		}
+	});
+}
+
+lk_status_t lk_room_set_peer_factory(lk_room_t* room, const lk_peer_factory_t* factory) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		std::lock_guard<std::mutex> guard(room->peer_factory_mutex);
+		room->peer_factory = factory != nullptr ? factory->factory : nullptr;
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_set_audio_playout(lk_room_t* room, lk_audio_playout_t playout) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		core::AudioPlayout audio_playout = core::AudioPlayout::Device;
+		if (!ToCoreAudioPlayout(playout, audio_playout)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid audio playout");
+		}
+		room->audio_playout.store(audio_playout);
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_set_adaptive_stream(lk_room_t* room, int enabled) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		room->adaptive_stream.store(enabled != 0);
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_set_event_dispatch(lk_room_t* room,
+                                       const lk_event_dispatch_options_t* options) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		core::EventDispatchOptions dispatch;
+		if (options != nullptr) {
+			if (options->struct_size < sizeof(options->struct_size)) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid event dispatch struct size");
+			}
+			if (LKC_HAS_FIELD(options, lk_event_dispatch_options_t, enabled)) {
+				dispatch.enabled = options->enabled != 0;
+			}
+			if ((LKC_HAS_FIELD(options, lk_event_dispatch_options_t, connection) &&
+			     !ToCoreEventQueueOptions(options->connection, dispatch.connection)) ||
+			    (LKC_HAS_FIELD(options, lk_event_dispatch_options_t, media) &&
+			     !ToCoreEventQueueOptions(options->media, dispatch.media)) ||
+			    (LKC_HAS_FIELD(options, lk_event_dispatch_options_t, data) &&
+			     !ToCoreEventQueueOptions(options->data, dispatch.data)) ||
+			    (LKC_HAS_FIELD(options, lk_event_dispatch_options_t, speakers) &&
+			     !ToCoreEventQueueOptions(options->speakers, dispatch.speakers))) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT,
+				               "event queues need a positive capacity and a valid overflow");
+			}
+		}
+		std::lock_guard<std::mutex> guard(room->event_dispatch_mutex);
+		room->event_dispatch = dispatch;
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_event_dispatch_stats(const lk_room_t* room, lk_event_dispatch_stats_t* stats) {
+	return Guard([&] {
+		if (room == nullptr || room->room == nullptr || stats == nullptr ||
+		    stats->struct_size < sizeof(stats->struct_size)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and initialized stats are required");
+		}
+		const auto source = room->room->GetEventDispatchStats();
+		lk_event_dispatch_stats_t copy{};
+		copy.struct_size = sizeof(copy);
+		copy.connection = ToCEventQueueStats(source.connection);
+		copy.media = ToCEventQueueStats(source.media);
+		copy.data = ToCEventQueueStats(source.data);
+		copy.speakers = ToCEventQueueStats(source.speakers);
+		std::memcpy(stats, &copy, std::min(stats->struct_size, sizeof(copy)));
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_connect(lk_room_t* room, const char* url, const char* token) {
+	return Guard([&] {
+		if (room == nullptr || url == nullptr || token == nullptr || *url == '\0' ||
+		    *token == '\0') {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room, URL, and token are required");
+		}
+		auto options = core::default_room_connect_options();
+		options.video_frame_delivery = room->video_frame_delivery.load();
+		options.audio_playout = room->audio_playout.load();
+		options.adaptive_stream = room->adaptive_stream.load();
+		{
+			std::lock_guard<std::mutex> guard(room->data_batching_mutex);
+			options.data_batching = room->data_batching;
+			options.data_stream_compression = room->data_stream_compression;
+		}
+		{
+			std::lock_guard<std::mutex> guard(room->peer_factory_mutex);
+			options.peer_factory = room->peer_factory;
+		}
+		{
+			std::lock_guard<std::mutex> guard(room->event_dispatch_mutex);
+			options.event_dispatch = room->event_dispatch;
+		}
+		if (!room->room->Connect(url, token, std::move(options))) {
+			return Failure(LK_STATUS_OPERATION_FAILED, "failed to connect room");
+		}
+		room->state->connected.store(true);
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_disconnect(lk_room_t* room) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		if (!room->room->Disconnect()) {
+			return Failure(LK_STATUS_INVALID_STATE, "room is already disconnected");
+		}
+		room->state->connected.store(false);
+		return LK_STATUS_OK;
+	});
+}
+
+lk_room_state_t lk_room_state(const lk_room_t* room) {
+	if (room == nullptr || room->room == nullptr) {
+		return LK_ROOM_STATE_DISCONNECTED;
+	}
+	return ToCRoomState(room->room->State());
+}
+
+lk_disconnect_reason_t lk_room_disconnect_reason(const lk_room_t* room) {
+	if (room == nullptr || room->room == nullptr) {
+		return LK_DISCONNECT_REASON_UNKNOWN;
+	}
+	return ToCDisconnectReason(room->room->LastDisconnectReason());
+}
+
+int lk_room_is_connected(const lk_room_t* room) {
+	return room != nullptr && room->room != nullptr && room->room->IsConnected() ? 1 : 0;
+}
+
+size_t lk_room_sid(const lk_room_t* room, char* buffer, size_t buffer_size) {
+	return SizeGuard(
+	    [&] { return room != nullptr ? CopyString(room->room->Sid(), buffer, buffer_size) : 0; });
+}
+
+size_t lk_room_name(const lk_room_t* room, char* buffer, size_t buffer_size) {
+	return SizeGuard(
+	    [&] { return room != nullptr ? CopyString(room->room->Name(), buffer, buffer_size) : 0; });
+}
+
+size_t lk_room_metadata(const lk_room_t* room, char* buffer, size_t buffer_size) {
+	return SizeGuard([&] {
+		return room != nullptr ? CopyString(room->room->Metadata(), buffer, buffer_size) : 0;
+	});
+}
+
+int lk_room_is_recording(const lk_room_t* room) {
+	return room != nullptr && room->room->IsRecording() ? 1 : 0;
+}
+
+namespace {
+
+// A factory set with lk_room_set_peer_factory() reaches the room only at connect.
+bool SharesAudioDevice(lk_room_t& room) {
+	if (room.room->SharesAudioDevice()) {
+		return true;
+	}
+	std::lock_guard<std::mutex> guard(room.peer_factory_mutex);
+	return room.peer_factory != nullptr;
+}
+
+} // namespace
+
+lk_status_t lk_room_set_audio_output_device(lk_room_t* room, const char* device_id) {
+	return Guard([&] {
+		if (room == nullptr || room->room == nullptr || device_id == nullptr ||
+		    *device_id == '\0') {
+			return Failure(LK_STATUS_INVALID_ARGUMENT,
+			               "room and audio output device ID are required");
+		}
+		if (SharesAudioDevice(*room)) {
+			return Failure(LK_STATUS_INVALID_STATE, "the room shares its peer factory's audio device");
+		}
+		return room->room->SetAudioOutputDevice(device_id)
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED, "failed to select audio output device");
+	});
+}
+
+size_t lk_room_audio_output_device(const lk_room_t* room, char* buffer, size_t buffer_size) {
+	return SizeGuard([&] {
+		return room != nullptr && room->room != nullptr
+		           ? CopyString(room->room->AudioOutputDevice(), buffer, buffer_size)
+		           : 0;
+	});
+}
+
+lk_status_t lk_room_set_speaker_volume(lk_room_t* room, float volume) {
+	return Guard([&] {
+		if (room == nullptr || room->room == nullptr || !std::isfinite(volume) || volume < 0.0F ||
+		    volume > 1.0F) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT,
+			               "room and a volume between 0 and 1 are required");
+		}
+		if (SharesAudioDevice(*room)) {
+			return Failure(LK_STATUS_INVALID_STATE, "the room shares its peer factory's audio device");
+		}
+		return room->room->SetSpeakerVolume(volume)
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED, "failed to set speaker volume");
+	});
+}
+
+float lk_room_speaker_volume(const lk_room_t* room) {
+	return room != nullptr && room->room != nullptr ? room->room->SpeakerVolume() : 0.0F;
+}
+
+lk_status_t lk_room_set_speaker_muted(lk_room_t* room, int muted) {
+	return Guard([&] {
+		if (room == nullptr || room->room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is required");
+		}
+		if (SharesAudioDevice(*room)) {
+			return Failure(LK_STATUS_INVALID_STATE, "the room shares its peer factory's audio device");
+		}
+		return room->room->SetSpeakerMuted(muted != 0)
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED, "failed to set speaker mute state");
+	});
+}
+
+int lk_room_speaker_is_muted(const lk_room_t* room) {
+	return room != nullptr && room->room != nullptr && room->room->SpeakerMuted() ? 1 : 0;
+}
+
+lk_status_t lk_room_audio_playback_stats(const lk_room_t* room, lk_audio_playback_stats_t* stats) {
+	return Guard([&] {
+		if (room == nullptr || room->room == nullptr || stats == nullptr ||
+		    stats->struct_size < sizeof(stats->struct_size)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and initialized stats are required");
+		}
+		const auto source = room->room->GetAudioPlaybackStats();
+		lk_audio_playback_stats_t copy{};
+		copy.struct_size = sizeof(copy);
+		copy.queued_frames = source.queued_frames;
+		copy.played_frames = source.played_frames;
+		copy.dropped_frames = source.dropped_frames;
+		copy.underrun_frames = source.underrun_frames;
+		copy.buffered_duration_ms = source.buffered_duration_ms;
+		copy.device_latency_ms = source.device_latency_ms;
+		copy.estimated_delay_ms = source.estimated_delay_ms;
+		std::memcpy(stats, &copy, std::min(stats->struct_size, sizeof(copy)));
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_create_audio_mixer(lk_room_t* room, const lk_audio_mixer_options_t* options,
+                                       lk_audio_mixer_t** mixer) {
+	return Guard([&] {
+		if (room == nullptr || room->room == nullptr || mixer == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and mixer output are required");
+		}
+		*mixer = nullptr;
+		core::AudioMixerOptions values;
+		if (options != nullptr) {
+			if (options->struct_size < sizeof(options->struct_size)) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid mixer options struct size");
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_mixer_options_t, sample_rate)) {
+				values.sample_rate = options->sample_rate;
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_mixer_options_t, num_channels)) {
+				values.num_channels = options->num_channels;
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_mixer_options_t, max_buffered_ms)) {
+				values.max_buffered_ms = options->max_buffered_ms;
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_mixer_options_t, include_all_tracks)) {
+				values.include_all_tracks = options->include_all_tracks != 0;
+			}
+		}
+		auto created = room->room->CreateAudioMixer(values);
+		if (!created) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "unsupported audio mixer options");
+		}
+		auto result = std::make_unique<lk_audio_mixer_t>();
+		result->mixer = std::move(created);
+		*mixer = result.release();
+		return LK_STATUS_OK;
+	});
+}
+
+void lk_audio_mixer_destroy(lk_audio_mixer_t* mixer) { delete mixer; }
+
+lk_status_t lk_audio_mixer_add_track(lk_audio_mixer_t* mixer, const char* track_sid) {
+	return Guard([&] {
+		if (mixer == nullptr || track_sid == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "mixer and track SID are required");
+		}
+		return mixer->mixer->AddTrack(track_sid)
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED,
+		                     "track is not a subscribed remote audio track or is already mixed");
+	});
+}
+
+lk_status_t lk_audio_mixer_remove_track(lk_audio_mixer_t* mixer, const char* track_sid) {
+	return Guard([&] {
+		if (mixer == nullptr || track_sid == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "mixer and track SID are required");
+		}
+		return mixer->mixer->RemoveTrack(track_sid)
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED, "track is not mixed");
+	});
+}
+
+lk_status_t lk_audio_mixer_set_participant_gain(lk_audio_mixer_t* mixer,
+                                                const char* participant_sid, float gain) {
+	return Guard([&] {
+		if (mixer == nullptr || participant_sid == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "mixer and participant SID are required");
+		}
+		return mixer->mixer->SetParticipantGain(participant_sid, gain)
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_INVALID_ARGUMENT, "gain must be finite and non-negative");
+	});
+}
+
+lk_status_t lk_audio_mixer_set_track_tap(lk_audio_mixer_t* mixer, const char* track_sid,
+                                         lk_audio_mixer_tap_callback callback, void* user_data) {
+	return Guard([&] {
+		if (mixer == nullptr || track_sid == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "mixer and track SID are required");
+		}
+		core::AudioMixerTap tap;
+		if (callback != nullptr) {
+			tap = [callback, user_data](const std::string& participant_sid,
+			                            const std::string& sid, const core::AudioFrame& frame) {
+				const lk_audio_frame_t c_frame{frame.data.data(), frame.data.size(),
+				                               frame.sample_rate, frame.num_channels,
+				                               frame.samples_per_channel};
+				callback(user_data, participant_sid.c_str(), sid.c_str(), &c_frame);
+			};
+		}
+		return mixer->mixer->SetTrackTap(track_sid, std::move(tap))
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED, "track is not mixed");
+	});
+}
+
+lk_status_t lk_audio_mixer_pull(lk_audio_mixer_t* mixer, lk_audio_frame_t* frame,
+                                int* has_audio) {
+	return Guard([&] {
+		if (mixer == nullptr || frame == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "mixer and frame output are required");
+		}
+		const bool mixed = mixer->mixer->Pull(mixer->frame);
+		*frame = {mixer->frame.data.data(), mixer->frame.data.size(), mixer->frame.sample_rate,
+		          mixer->frame.num_channels, mixer->frame.samples_per_channel};
+		if (has_audio != nullptr) {
+			*has_audio = mixed ? 1 : 0;
+		}
 		return LK_STATUS_OK;
 	});
 }
 
-lk_status_t lk_room_connect(lk_room_t* room, const char* url, const char* token) {
+lk_status_t lk_audio_mixer_stats(const lk_audio_mixer_t* mixer, lk_audio_mixer_stats_t* stats) {
 	return Guard([&] {
-		if (room == nullptr || url == nullptr || token == nullptr || *url == '\0' ||
-		    *token == '\0') {
-			return Failure(LK_STATUS_INVALID_ARGUMENT, "room, URL, and token are required");
-		}
-		if (!room->room->Connect(url, token)) {
-			return Failure(LK_STATUS_OPERATION_FAILED, "failed to connect room");
-		}
-		room->state->connected.store(true);
+		if (mixer == nullptr || stats == nullptr ||
+		    stats->struct_size < sizeof(stats->struct_size)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "mixer and initialized stats are required");
+		}
+		const auto values = mixer->mixer->Stats();
+		lk_audio_mixer_stats_t result;
+		lk_audio_mixer_stats_init(&result);
+		result.track_count = values.track_count;
+		result.mixed_frames = values.mixed_frames;
+		result.underrun_frames = values.underrun_frames;
+		result.overrun_frames = values.overrun_frames;
+		std::memcpy(stats, &result, std::min(stats->struct_size, sizeof(result)));
 		return LK_STATUS_OK;
 	});
 }
 
-lk_status_t lk_room_disconnect(lk_room_t* room) {
+lk_status_t lk_room_create_audio_stream(lk_room_t* room, const char* track_sid,
+                                        const lk_audio_stream_options_t* options,
+                                        lk_audio_stream_t** stream) {
 	return Guard([&] {
-		if (room == nullptr) {
-			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		if (room == nullptr || room->room == nullptr || track_sid == nullptr || stream == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT,
+			               "room, track SID and stream output are required");
 		}
-		if (!room->room->Disconnect()) {
-			return Failure(LK_STATUS_INVALID_STATE, "room is already disconnected");
+		*stream = nullptr;
+		core::AudioStreamOptions values;
+		if (options != nullptr) {
+			if (options->struct_size < sizeof(options->struct_size)) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid stream options struct size");
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_stream_options_t, sample_rate)) {
+				values.sample_rate = options->sample_rate;
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_stream_options_t, num_channels)) {
+				values.num_channels = options->num_channels;
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_stream_options_t, capacity_frames)) {
+				values.capacity_frames = options->capacity_frames;
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_stream_options_t, overflow)) {
+				const auto overflow = ToCoreFrameStreamOverflow(options->overflow);
+				if (!overflow) {
+					return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid stream overflow policy");
+				}
+				values.overflow = *overflow;
+			}
+			if (LKC_HAS_FIELD(options, lk_audio_stream_options_t, block_timeout_ms)) {
+				values.block_timeout_ms = options->block_timeout_ms;
+			}
 		}
-		room->state->connected.store(false);
+		auto created = room->room->CreateAudioStream(track_sid, values);
+		if (!created) {
+			return Failure(LK_STATUS_OPERATION_FAILED,
+			               "track is not a subscribed remote audio track or options are invalid");
+		}
+		auto result = std::make_unique<lk_audio_stream_t>();
+		result->stream = std::move(created);
+		*stream = result.release();
 		return LK_STATUS_OK;
 	});
 }
 
-lk_room_state_t lk_room_state(const lk_room_t* room) {
-	if (room == nullptr || room->room == nullptr) {
-		return LK_ROOM_STATE_DISCONNECTED;
-	}
-	return ToCRoomState(room->room->State());
-}
-
-lk_disconnect_reason_t lk_room_disconnect_reason(const lk_room_t* room) {
-	if (room == nullptr || room->room == nullptr) {
-		return LK_DISCONNECT_REASON_UNKNOWN;
-	}
-	return ToCDisconnectReason(room->room->LastDisconnectReason());
-}
+void lk_audio_stream_destroy(lk_audio_stream_t* stream) { delete stream; }
 
-int lk_room_is_connected(const lk_room_t* room) {
-	return room != nullptr && room->room != nullptr && room->room->IsConnected() ? 1 : 0;
+lk_status_t lk_audio_stream_read(lk_audio_stream_t* stream, int64_t timeout_ms,
+                                 lk_audio_frame_t* frame) {
+	return Guard([&] {
+		if (stream == nullptr || frame == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "stream and frame output are required");
+		}
+		if (!stream->stream->Read(stream->frame, ToFrameStreamTimeout(timeout_ms))) {
+			return stream->stream->IsClosed()
+			           ? Failure(LK_STATUS_INVALID_STATE, "audio stream is closed")
+			           : Failure(LK_STATUS_OPERATION_FAILED, "timed out waiting for audio");
+		}
+		*frame = {stream->frame.data.data(), stream->frame.data.size(), stream->frame.sample_rate,
+		          stream->frame.num_channels, stream->frame.samples_per_channel};
+		return LK_STATUS_OK;
+	});
 }
 
-size_t lk_room_sid(const lk_room_t* room, char* buffer, size_t buffer_size) {
-	return SizeGuard(
-	    [&] { return room != nullptr ? CopyString(room->room->Sid(), buffer, buffer_size) : 0; });
+int lk_audio_stream_fd(const lk_audio_stream_t* stream) {
+	return stream != nullptr ? stream->stream->EventFd() : -1;
 }
 
-size_t lk_room_name(const lk_room_t* room, char* buffer, size_t buffer_size) {
-	return SizeGuard(
-	    [&] { return room != nullptr ? CopyString(room->room->Name(), buffer, buffer_size) : 0; });
+void* lk_audio_stream_event_handle(const lk_audio_stream_t* stream) {
+	return stream != nullptr ? stream->stream->EventHandle() : nullptr;
 }
 
-size_t lk_room_metadata(const lk_room_t* room, char* buffer, size_t buffer_size) {
-	return SizeGuard([&] {
-		return room != nullptr ? CopyString(room->room->Metadata(), buffer, buffer_size) : 0;
+lk_status_t lk_audio_stream_close(lk_audio_stream_t* stream) {
+	return Guard([&] {
+		if (stream == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "stream is null");
+		}
+		stream->stream->Close();
+		return LK_STATUS_OK;
 	});
 }
 
-int lk_room_is_recording(const lk_room_t* room) {
-	return room != nullptr && room->room->IsRecording() ? 1 : 0;
+lk_status_t lk_audio_stream_stats(const lk_audio_stream_t* stream,
+                                  lk_frame_stream_stats_t* stats) {
+	return Guard([&] {
+		if (stream == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "stream is null");
+		}
+		return CopyFrameStreamStats(stream->stream->Stats(), stats);
+	});
 }
 
-lk_status_t lk_room_set_audio_output_device(lk_room_t* room, const char* device_id) {
+lk_status_t lk_room_create_video_stream(lk_room_t* room, const char* track_sid,
+                                        const lk_video_stream_options_t* options,
+                                        lk_video_stream_t** stream) {
 	return Guard([&] {
-		if (room == nullptr || room->room == nullptr || device_id == nullptr ||
-		    *device_id == '\0') {
+		if (room == nullptr || room->room == nullptr || track_sid == nullptr || stream == nullptr) {
 			return Failure(LK_STATUS_INVALID_ARGUMENT,
-			               "room and audio output device ID are required");
+			               "room, track SID and stream output are required");
 		}
-		return room->room->SetAudioOutputDevice(device_id)
-		           ? LK_STATUS_OK
-		           : Failure(LK_STATUS_OPERATION_FAILED, "failed to select audio output device");
+		*stream = nullptr;
+		core::VideoStreamOptions values;
+		if (options != nullptr) {
+			if (options->struct_size < sizeof(options->struct_size)) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid stream options struct size");
+			}
+			if (LKC_HAS_FIELD(options, lk_video_stream_options_t, capacity_frames)) {
+				values.capacity_frames = options->capacity_frames;
+			}
+			if (LKC_HAS_FIELD(options, lk_video_stream_options_t, overflow)) {
+				const auto overflow = ToCoreFrameStreamOverflow(options->overflow);
+				if (!overflow) {
+					return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid stream overflow policy");
+				}
+				values.overflow = *overflow;
+			}
+			if (LKC_HAS_FIELD(options, lk_video_stream_options_t, block_timeout_ms)) {
+				values.block_timeout_ms = options->block_timeout_ms;
+			}
+		}
+		auto created = room->room->CreateVideoStream(track_sid, values);
+		if (!created) {
+			return Failure(LK_STATUS_OPERATION_FAILED,
+			               "track is not a subscribed remote video track or options are invalid");
+		}
+		auto result = std::make_unique<lk_video_stream_t>();
+		result->stream = std::move(created);
+		*stream = result.release();
+		return LK_STATUS_OK;
 	});
 }
 
-size_t lk_room_audio_output_device(const lk_room_t* room, char* buffer, size_t buffer_size) {
-	return SizeGuard([&] {
-		return room != nullptr && room->room != nullptr
-		           ? CopyString(room->room->AudioOutputDevice(), buffer, buffer_size)
-		           : 0;
-	});
-}
+void lk_video_stream_destroy(lk_video_stream_t* stream) { delete stream; }
 
-lk_status_t lk_room_set_speaker_volume(lk_room_t* room, float volume) {
+lk_status_t lk_video_stream_read(lk_video_stream_t* stream, int64_t timeout_ms,
+                                 lk_video_frame_t* frame) {
 	return Guard([&] {
-		if (room == nullptr || room->room == nullptr || !std::isfinite(volume) || volume < 0.0F ||
-		    volume > 1.0F) {
-			return Failure(LK_STATUS_INVALID_ARGUMENT,
-			               "room and a volume between 0 and 1 are required");
-		}
-		return room->room->SetSpeakerVolume(volume)
-		           ? LK_STATUS_OK
-		           : Failure(LK_STATUS_OPERATION_FAILED, "failed to set speaker volume");
+		if (stream == nullptr || frame == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "stream and frame output are required");
+		}
+		core::VideoFrameBuffer read;
+		if (!stream->stream->Read(read, ToFrameStreamTimeout(timeout_ms)) || !read.buffer) {
+			return stream->stream->IsClosed()
+			           ? Failure(LK_STATUS_INVALID_STATE, "video stream is closed")
+			           : Failure(LK_STATUS_OPERATION_FAILED, "timed out waiting for video");
+		}
+		auto buffer = std::make_unique<lk_video_frame_buffer_t>(read);
+		*frame = {nullptr,
+		          0,
+		          read.buffer->Width(),
+		          read.buffer->Height(),
+		          read.timestamp_us,
+		          buffer.release()};
+		return LK_STATUS_OK;
 	});
 }
 
-float lk_room_speaker_volume(const lk_room_t* room) {
-	return room != nullptr && room->room != nullptr ? room->room->SpeakerVolume() : 0.0F;
+int lk_video_stream_fd(const lk_video_stream_t* stream) {
+	return stream != nullptr ? stream->stream->EventFd() : -1;
 }
 
-lk_status_t lk_room_set_speaker_muted(lk_room_t* room, int muted) {
+void* lk_video_stream_event_handle(const lk_video_stream_t* stream) {
+	return stream != nullptr ? stream->stream->EventHandle() : nullptr;
+}
+
+lk_status_t lk_video_stream_close(lk_video_stream_t* stream) {
 	return Guard([&] {
-		if (room == nullptr || room->room == nullptr) {
-			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is required");
+		if (stream == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "stream is null");
 		}
-		return room->room->SetSpeakerMuted(muted != 0)
-		           ? LK_STATUS_OK
-		           : Failure(LK_STATUS_OPERATION_FAILED, "failed to set speaker mute state");
+		stream->stream->Close();
+		return LK_STATUS_OK;
 	});
 }
 
-int lk_room_speaker_is_muted(const lk_room_t* room) {
-	return room != nullptr && room->room != nullptr && room->room->SpeakerMuted() ? 1 : 0;
-}
-
-lk_status_t lk_room_audio_playback_stats(const lk_room_t* room, lk_audio_playback_stats_t* stats) {
+lk_status_t lk_video_stream_stats(const lk_video_stream_t* stream,
+                                  lk_frame_stream_stats_t* stats) {
 	return Guard([&] {
-		if (room == nullptr || room->room == nullptr || stats == nullptr ||
-		    stats->struct_size < sizeof(stats->struct_size)) {
-			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and initialized stats are required");
+		if (stream == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "stream is null");
 		}
-		const auto source = room->room->GetAudioPlaybackStats();
-		lk_audio_playback_stats_t copy{};
-		copy.struct_size = sizeof(copy);
-		copy.queued_frames = source.queued_frames;
-		copy.played_frames = source.played_frames;
-		copy.dropped_frames = source.dropped_frames;
-		copy.underrun_frames = source.underrun_frames;
-		copy.buffered_duration_ms = source.buffered_duration_ms;
-		copy.device_latency_ms = source.device_latency_ms;
-		copy.estimated_delay_ms = source.estimated_delay_ms;
-		std::memcpy(stats, &copy, std::min(stats->struct_size, sizeof(copy)));
-		return LK_STATUS_OK;
+		return CopyFrameStreamStats(stream->stream->Stats(), stats);
 	});
 }
 
@@ -2252,6 +3149,26 @@ lk_status_t lk_audio_source_capture_frame(lk_audio_source_t* source, const int16
 	});
 }
 
+lk_status_t lk_audio_source_queue_stats(const lk_audio_source_t* source,
+                                        lk_audio_source_queue_stats_t* stats) {
+	return Guard([&] {
+		if (source == nullptr || stats == nullptr ||
+		    stats->struct_size < sizeof(stats->struct_size)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT,
+			               "invalid audio source or queue stats output");
+		}
+		const auto values = source->source->QueueStats();
+		lk_audio_source_queue_stats_t result;
+		lk_audio_source_queue_stats_init(&result);
+		result.underrun_frames = values.underrun_frames;
+		result.overrun_frames = values.overrun_frames;
+		result.queued_samples = values.queued_samples;
+		result.capacity_samples = values.capacity_samples;
+		std::memcpy(stats, &result, std::min(stats->struct_size, sizeof(result)));
+		return LK_STATUS_OK;
+	});
+}
+
 lk_status_t lk_audio_source_microphone_start(lk_audio_source_t* source) {
 	return Guard([&] {
 		auto* microphone =
@@ -2460,6 +3377,7 @@ lk_status_t lk_audio_source_microphone_processing_stats(const lk_audio_source_t*
 		result.render_processing_errors = values.render_processing_errors;
 		result.frames_dropped = values.frames_dropped;
 		result.echo_cancellation_enabled = values.echo_cancellation_enabled ? 1 : 0;
+		result.echo_reference_attached = values.echo_reference_attached ? 1 : 0;
 		std::memcpy(stats, &result, std::min(stats->struct_size, sizeof(result)));
 		return LK_STATUS_OK;
 	});
@@ -2798,6 +3716,44 @@ lk_status_t lk_video_source_screen_switch_source(lk_video_source_t* source, cons
 	});
 }
 
+lk_video_frame_buffer_t* lk_video_frame_buffer_retain(lk_video_frame_buffer_t* buffer) {
+	if (buffer != nullptr) {
+		buffer->references.fetch_add(1, std::memory_order_relaxed);
+	}
+	return buffer;
+}
+
+void lk_video_frame_buffer_release(lk_video_frame_buffer_t* buffer) {
+	if (buffer != nullptr && buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		delete buffer;
+	}
+}
+
+lk_status_t lk_video_frame_buffer_planes(const lk_video_frame_buffer_t* buffer,
+                                         lk_video_frame_planes_t* planes) {
+	return Guard([&] {
+		if (buffer == nullptr || !buffer->frame.buffer) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "video frame buffer is null");
+		}
+		const auto& source = *buffer->frame.buffer;
+		lk_video_frame_planes_t value{};
+		value.struct_size = sizeof(value);
+		value.width = source.Width();
+		value.height = source.Height();
+		value.data_y = source.DataY();
+		value.data_u = source.DataU();
+		value.data_v = source.DataV();
+		value.stride_y = source.StrideY();
+		value.stride_u = source.StrideU();
+		value.stride_v = source.StrideV();
+		return CopyOutputStruct(value, planes, "invalid video frame planes output");
+	});
+}
+
+int64_t lk_video_frame_buffer_timestamp_us(const lk_video_frame_buffer_t* buffer) {
+	return buffer != nullptr ? buffer->frame.timestamp_us : 0;
+}
+
 lk_status_t lk_room_create_audio_track(lk_room_t* room, const char* label,
                                        lk_audio_source_t* source, lk_local_track_t** track) {
 	return Guard([&] {
@@ -2927,6 +3883,43 @@ size_t lk_local_track_rtc_stats(const lk_local_track_t* track, char* buffer, siz
 	});
 }
 
+size_t lk_local_track_dynacast_layers(const lk_local_track_t* track, lk_dynacast_layer_t* layers,
+                                      size_t layer_capacity) {
+	return SizeGuard([&]() -> size_t {
+		if (track == nullptr || track->track == nullptr || track->room_state == nullptr ||
+		    !track->room_state->alive.load()) {
+			return 0;
+		}
+		auto* participant = LocalParticipant(track->owner);
+		if (participant == nullptr) {
+			return 0;
+		}
+		for (auto* publication : participant->GetTrackPublications()) {
+			if (publication == nullptr || publication->Track() != track->track.get()) {
+				continue;
+			}
+			auto* local_publication =
+			    dynamic_cast<core::LocalTrackPublicationInterface*>(publication);
+			if (local_publication == nullptr) {
+				return 0;
+			}
+			const auto values = local_publication->DynacastLayers();
+			const auto count = layers != nullptr ? std::min(values.size(), layer_capacity) : 0;
+			for (std::size_t index = 0; index < count; ++index) {
+				const auto& value = values[index];
+				layers[index] = {ToCVideoQuality(value.quality),
+				                 value.active ? 1 : 0,
+				                 value.pause_pending ? 1 : 0,
+				                 value.pauses,
+				                 value.paused_ms,
+				                 value.encode_seconds_saved};
+			}
+			return values.size();
+		}
+		return 0;
+	});
+}
+
 lk_status_t lk_local_track_destroy(lk_local_track_t* track) {
 	if (track == nullptr) {
 		return LK_STATUS_OK;
@@ -3021,6 +4014,27 @@ lk_status_t lk_room_update_remote_track_settings(lk_room_t* room, const char* pa
 	});
 }
 
+lk_status_t lk_room_set_remote_video_render_state(lk_room_t* room, const char* track_sid,
+                                                  uint32_t width, uint32_t height, int visible) {
+	return Guard([&] {
+		if (room == nullptr || room->room == nullptr || track_sid == nullptr ||
+		    *track_sid == '\0') {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and track SID are required");
+		}
+		if ((width == 0) != (height == 0)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT,
+			               "video width and height must both be zero or non-zero");
+		}
+		core::VideoRenderState state;
+		state.dimensions = {width, height};
+		state.visible = visible != 0;
+		return room->room->SetRemoteVideoRenderState(track_sid, state)
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED,
+		                     "adaptive stream is off or the track is not a subscribed video track");
+	});
+}
+
 lk_status_t
 lk_room_set_track_subscription_permissions(lk_room_t* room, int all_participants_allowed,
                                            const lk_participant_track_permission_t* permissions,
@@ -3103,6 +4117,9 @@ lk_status_t lk_room_publish_data(lk_room_t* room, const uint8_t* data, size_t da
 				publish_options.destination_identities = DestinationIdentities(
 				    options->destination_identities, options->destination_identity_count);
 			}
+			if (LKC_HAS_FIELD(options, lk_data_publish_options_t, coalesce)) {
+				publish_options.coalesce = options->coalesce != 0;
+			}
 		}
 		std::vector<uint8_t> payload;
 		if (data_size != 0) {
@@ -3114,6 +4131,112 @@ lk_status_t lk_room_publish_data(lk_room_t* room, const uint8_t* data, size_t da
 	});
 }
 
+lk_status_t lk_room_set_data_batching(lk_room_t* room,
+                                      const lk_data_batching_options_t* options) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		core::DataBatchingOptions batching;
+		if (options != nullptr) {
+			if (options->struct_size < sizeof(options->struct_size)) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid data batching struct size");
+			}
+			if (LKC_HAS_FIELD(options, lk_data_batching_options_t, window_ms)) {
+				batching.window_ms = options->window_ms;
+			}
+			if (LKC_HAS_FIELD(options, lk_data_batching_options_t, max_batch_bytes)) {
+				batching.max_batch_bytes = options->max_batch_bytes;
+			}
+		}
+		if (batching.window_ms == 0 || batching.max_batch_bytes == 0) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "batching window and size must be positive");
+		}
+		std::lock_guard<std::mutex> guard(room->data_batching_mutex);
+		room->data_batching = batching;
+		return LK_STATUS_OK;
+	});
+}
+
+size_t lk_room_incoming_data_streams(const lk_room_t* room, lk_incoming_data_stream_t* streams,
+                                     size_t stream_capacity) {
+	return SizeGuard([&]() -> size_t {
+		if (room == nullptr || room->room == nullptr) {
+			return 0;
+		}
+		const auto values = room->room->IncomingDataStreams();
+		const auto count = streams != nullptr ? std::min(values.size(), stream_capacity) : 0;
+		for (std::size_t index = 0; index < count; ++index) {
+			const auto& value = values[index];
+			auto& stream = streams[index];
+			stream = {};
+			CopyString(value.stream_id, stream.stream_id, sizeof(stream.stream_id));
+			stream.compressed = value.compressed ? 1 : 0;
+			stream.has_handler = value.has_handler ? 1 : 0;
+			stream.received_bytes = value.received_bytes;
+			stream.compressed_bytes = value.compressed_bytes;
+			stream.queued_bytes = value.queued_bytes;
+			stream.memory_bytes = value.memory_bytes;
+			stream.spilled_bytes = value.spilled_bytes;
+		}
+		return values.size();
+	});
+}
+
+lk_status_t
+lk_room_set_data_stream_compression(lk_room_t* room,
+                                    const lk_data_stream_compression_options_t* options) {
+	return Guard([&] {
+		if (room == nullptr) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room is null");
+		}
+		core::DataStreamCompressionOptions compression;
+		if (options != nullptr) {
+			if (options->struct_size < sizeof(options->struct_size)) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT,
+				               "invalid data stream compression struct size");
+			}
+			if (LKC_HAS_FIELD(options, lk_data_stream_compression_options_t, level)) {
+				compression.level = options->level;
+			}
+			if (LKC_HAS_FIELD(options, lk_data_stream_compression_options_t, strategy) &&
+			    !ToCoreCompressionStrategy(options->strategy, compression.strategy)) {
+				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid compression strategy");
+			}
+			if (LKC_HAS_FIELD(options, lk_data_stream_compression_options_t, threads)) {
+				compression.threads = options->threads;
+			}
+		}
+		if (compression.level < -1 || compression.level > 9) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "compression level must be -1 to 9");
+		}
+		std::lock_guard<std::mutex> guard(room->data_batching_mutex);
+		room->data_stream_compression = compression;
+		return LK_STATUS_OK;
+	});
+}
+
+lk_status_t lk_room_data_batching_stats(const lk_room_t* room, lk_data_batching_stats_t* stats) {
+	return Guard([&] {
+		auto* participant = LocalParticipant(room);
+		if (participant == nullptr || stats == nullptr ||
+		    stats->struct_size < sizeof(stats->struct_size)) {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and initialized stats are required");
+		}
+		const auto values = participant->GetDataBatchingStats();
+		lk_data_batching_stats_t result;
+		lk_data_batching_stats_init(&result);
+		result.messages = values.messages;
+		result.packets = values.packets;
+		result.failed_packets = values.failed_packets;
+		result.max_messages_per_packet = values.max_messages_per_packet;
+		result.total_added_latency_us = values.total_added_latency_us;
+		result.max_added_latency_us = values.max_added_latency_us;
+		std::memcpy(stats, &result, std::min(stats->struct_size, sizeof(result)));
+		return LK_STATUS_OK;
+	});
+}
+
 lk_status_t lk_room_publish_dtmf(lk_room_t* room, uint32_t code, const char* digit) {
 	return Guard([&] {
 		auto* participant = LocalParticipant(room);
@@ -3283,37 +4406,9 @@ lk_status_t lk_room_send_file(lk_room_t* room, const char* path,
 			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and file path are required");
 		}
 		core::FileSendOptions send_options;
-		if (options != nullptr) {
-			if (options->struct_size < sizeof(options->struct_size)) {
-				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid file options struct size");
-			}
-			if (LKC_HAS_FIELD(options, lk_file_send_options_t, topic) &&
-			    options->topic != nullptr) {
-				send_options.topic = options->topic;
-			}
-			if (LKC_HAS_FIELD(options, lk_file_send_options_t, mime_type) &&
-			    options->mime_type != nullptr) {
-				send_options.mime_type = options->mime_type;
-			}
-			if (LKC_HAS_FIELD(options, lk_file_send_options_t, destination_identity_count)) {
-				if (options->destination_identity_count != 0 &&
-				    options->destination_identities == nullptr) {
-					return Failure(LK_STATUS_INVALID_ARGUMENT, "destination identities are null");
-				}
-				send_options.destination_identities = DestinationIdentities(
-				    options->destination_identities, options->destination_identity_count);
-			}
-			if (LKC_HAS_FIELD(options, lk_file_send_options_t, chunk_size)) {
-				send_options.chunk_size = options->chunk_size;
-			}
-			if (LKC_HAS_FIELD(options, lk_file_send_options_t, attribute_count) &&
-			    !CopyAttributes(options->attributes, options->attribute_count,
-			                    send_options.attributes)) {
-				return Failure(LK_STATUS_INVALID_ARGUMENT, "invalid file attributes");
-			}
-			if (LKC_HAS_FIELD(options, lk_file_send_options_t, compress)) {
-				send_options.compress = options->compress != 0;
-			}
+		if (const auto status = ToCoreFileSendOptions(options, send_options);
+		    status != LK_STATUS_OK) {
+			return status;
 		}
 		return participant->SendFile(path, std::move(send_options))
 		           ? LK_STATUS_OK
@@ -3321,6 +4416,24 @@ lk_status_t lk_room_send_file(lk_room_t* room, const char* path,
 	});
 }
 
+lk_status_t lk_room_send_file_async(lk_room_t* room, const char* path,
+                                    const lk_file_send_options_t* options) {
+	return Guard([&] {
+		auto* participant = LocalParticipant(room);
+		if (participant == nullptr || path == nullptr || *path == '\0') {
+			return Failure(LK_STATUS_INVALID_ARGUMENT, "room and file path are required");
+		}
+		core::FileSendOptions send_options;
+		if (const auto status = ToCoreFileSendOptions(options, send_options);
+		    status != LK_STATUS_OK) {
+			return status;
+		}
+		return participant->SendFileAsync(path, std::move(send_options))
+		           ? LK_STATUS_OK
+		           : Failure(LK_STATUS_OPERATION_FAILED, "failed to start file stream");
+	});
+}
+
 lk_status_t lk_room_stream_text(lk_room_t* room, const lk_stream_text_options_t* options,
                                 lk_text_stream_writer_t** writer) {
 	return Guard([&] {
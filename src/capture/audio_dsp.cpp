@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2026 sunze
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "audio_dsp.h"
+
+#include "audio_dsp_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(LKC_AUDIO_DSP_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace livekit::capture {
+
+namespace {
+
+constexpr float kInt16ToFloat = 1.0F / 32768.0F;
+constexpr float kFloatToInt16 = 32768.0F;
+
+void ScaleScalar(const std::int16_t* input, std::int16_t* output, std::size_t count,
+                 float gain) noexcept {
+	for (std::size_t index = 0; index < count; ++index) {
+		output[index] = SaturateAudioSample(static_cast<float>(input[index]) * gain);
+	}
+}
+
+void MixScalar(const std::int16_t* const* inputs, std::size_t input_count, std::int16_t* output,
+               std::size_t count) noexcept {
+	MixAudioRange(inputs, input_count, output, 0, count);
+}
+
+void ToFloatScalar(const std::int16_t* input, float* output, std::size_t count) noexcept {
+	for (std::size_t index = 0; index < count; ++index) {
+		output[index] = static_cast<float>(input[index]) * kInt16ToFloat;
+	}
+}
+
+void FromFloatScalar(const float* input, std::int16_t* output, std::size_t count) noexcept {
+	for (std::size_t index = 0; index < count; ++index) {
+		output[index] = SaturateAudioSample(input[index] * kFloatToInt16);
+	}
+}
+
+void InterleaveScalar(const std::int16_t* const* planes, std::size_t channels, std::size_t frames,
+                      std::int16_t* output) noexcept {
+	for (std::size_t frame = 0; frame < frames; ++frame) {
+		for (std::size_t channel = 0; channel < channels; ++channel) {
+			output[frame * channels + channel] = planes[channel][frame];
+		}
+	}
+}
+
+void DeinterleaveScalar(const std::int16_t* input, std::size_t channels, std::size_t frames,
+                        std::int16_t* const* planes) noexcept {
+	for (std::size_t frame = 0; frame < frames; ++frame) {
+		for (std::size_t channel = 0; channel < channels; ++channel) {
+			planes[channel][frame] = input[frame * channels + channel];
+		}
+	}
+}
+
+AudioLevel LevelScalar(const std::int16_t* input, std::size_t count) noexcept {
+	std::int32_t peak = 0;
+	std::uint64_t sum_of_squares = 0;
+	for (std::size_t index = 0; index < count; ++index) {
+		const std::int32_t sample = input[index];
+		peak = std::max(peak, sample < 0 ? -sample : sample);
+		sum_of_squares += static_cast<std::uint64_t>(sample * sample);
+	}
+	return MakeAudioLevel(peak, sum_of_squares, count);
+}
+
+constexpr AudioDspKernels kScalarAudioDspKernels{
+    AudioDspIsa::Scalar, ScaleScalar,        MixScalar,   ToFloatScalar, FromFloatScalar,
+    InterleaveScalar,    DeinterleaveScalar, LevelScalar,
+};
+
+#if defined(LKC_AUDIO_DSP_X86)
+bool CpuSupportsAvx2() noexcept {
+#if defined(_MSC_VER)
+	int info[4] = {};
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	constexpr int kOsxsaveAndAvx = (1 << 27) | (1 << 28);
+	// The OS must also save the YMM registers across context switches.
+	if ((info[2] & kOsxsaveAndAvx) != kOsxsaveAndAvx || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+const AudioDspKernels& SelectAudioDspKernels() noexcept {
+#if defined(LKC_AUDIO_DSP_X86)
+	return CpuSupportsAvx2() ? kAvx2AudioDspKernels : kSse2AudioDspKernels;
+#elif defined(LKC_AUDIO_DSP_NEON)
+	return kNeonAudioDspKernels;
+#else
+	return kScalarAudioDspKernels;
+#endif
+}
+
+} // namespace
+
+std::int16_t SaturateAudioSample(float value) noexcept {
+	// Ordered like the SIMD max/min instructions so NaN clamps to the lower bound on every ISA.
+	value = value > -32768.0F ? value : -32768.0F;
+	value = value < 32767.0F ? value : 32767.0F;
+	return static_cast<std::int16_t>(std::lrintf(value));
+}
+
+void MixAudioRange(const std::int16_t* const* inputs, std::size_t input_count,
+                   std::int16_t* output, std::size_t begin, std::size_t end) noexcept {
+	for (std::size_t index = begin; index < end; ++index) {
+		std::int32_t sum = 0;
+		for (std::size_t input = 0; input < input_count; ++input) {
+			sum += inputs[input][index];
+		}
+		output[index] = static_cast<std::int16_t>(
+		    std::clamp<std::int32_t>(sum, std::numeric_limits<std::int16_t>::min(),
+		                             std::numeric_limits<std::int16_t>::max()));
+	}
+}
+
+AudioLevel MakeAudioLevel(std::int32_t peak, std::uint64_t sum_of_squares,
+                          std::size_t count) noexcept {
+	if (count == 0) {
+		return {};
+	}
+	const double mean_square = static_cast<double>(sum_of_squares) / static_cast<double>(count);
+	return {static_cast<float>(peak) * kInt16ToFloat,
+	        static_cast<float>(std::sqrt(mean_square) / 32768.0)};
+}
+
+const AudioDspKernels& ScalarAudioDspKernels() noexcept { return kScalarAudioDspKernels; }
+
+const AudioDspKernels* AudioDspKernelsFor(AudioDspIsa isa) noexcept {
+	switch (isa) {
+	case AudioDspIsa::Scalar:
+		return &kScalarAudioDspKernels;
+#if defined(LKC_AUDIO_DSP_X86)
+	case AudioDspIsa::Sse2:
+		return &kSse2AudioDspKernels;
+	case AudioDspIsa::Avx2:
+		return CpuSupportsAvx2() ? &kAvx2AudioDspKernels : nullptr;
+#endif
+#if defined(LKC_AUDIO_DSP_NEON)
+	case AudioDspIsa::Neon:
+		return &kNeonAudioDspKernels;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+const AudioDspKernels& AudioDsp() noexcept {
+	static const AudioDspKernels& kernels = SelectAudioDspKernels();
+	return kernels;
+}
+
+bool ScaleAudio(std::span<const std::int16_t> input, std::span<std::int16_t> output,
+                float gain) noexcept {
+	if (input.size() != output.size()) {
+		return false;
+	}
+	AudioDsp().scale(input.data(), output.data(), input.size(), gain);
+	return true;
+}
+
+bool MixAudio(std::span<const std::int16_t* const> inputs,
+              std::span<std::int16_t> output) noexcept {
+	if (std::find(inputs.begin(), inputs.end(), nullptr) != inputs.end()) {
+		return false;
+	}
+	AudioDsp().mix(inputs.data(), inputs.size(), output.data(), output.size());
+	return true;
+}
+
+bool ConvertAudioToFloat(std::span<const std::int16_t> input, std::span<float> output) noexcept {
+	if (input.size() != output.size()) {
+		return false;
+	}
+	AudioDsp().to_float(input.data(), output.data(), input.size());
+	return true;
+}
+
+bool ConvertAudioFromFloat(std::span<const float> input, std::span<std::int16_t> output) noexcept {
+	if (input.size() != output.size()) {
+		return false;
+	}
+	AudioDsp().from_float(input.data(), output.data(), input.size());
+	return true;
+}
+
+bool InterleaveAudio(std::span<const std::int16_t* const> planes,
+                     std::span<std::int16_t> output) noexcept {
+	if (planes.empty() || output.size() % planes.size() != 0 ||
+	    std::find(planes.begin(), planes.end(), nullptr) != planes.end()) {
+		return false;
+	}
+	AudioDsp().interleave(planes.data(), planes.size(), output.size() / planes.size(),
+	                      output.data());
+	return true;
+}
+
+bool DeinterleaveAudio(std::span<const std::int16_t> input,
+                       std::span<std::int16_t* const> planes) noexcept {
+	if (planes.empty() || input.size() % planes.size() != 0 ||
+	    std::find(planes.begin(), planes.end(), nullptr) != planes.end()) {
+		return false;
+	}
+	AudioDsp().deinterleave(input.data(), planes.size(), input.size() / planes.size(),
+	                        planes.data());
+	return true;
+}
+
+AudioLevel MeasureAudioLevel(std::span<const std::int16_t> input) noexcept {
+	return AudioDsp().level(input.data(), input.size());
+}
+
+} // namespace livekit::capture
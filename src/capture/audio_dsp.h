@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2026 sunze
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace livekit::capture {
+
+enum class AudioDspIsa : std::uint8_t {
+	Scalar,
+	Sse2,
+	Avx2,
+	Neon,
+};
+
+struct AudioLevel {
+	// Largest absolute sample, normalized so that -32768 reads as 1.
+	float peak = 0.0F;
+	float rms = 0.0F;
+};
+
+// One implementation of every PCM kernel. All variants produce bit-identical results: float to
+// integer conversions round to nearest-even and saturate to the int16 range. Counts may be zero.
+struct AudioDspKernels {
+	AudioDspIsa isa = AudioDspIsa::Scalar;
+	// output[i] = saturate(input[i] * gain). input and output may be the same buffer.
+	void (*scale)(const std::int16_t* input, std::int16_t* output, std::size_t count,
+	              float gain) noexcept = nullptr;
+	// output[i] = saturate(sum of inputs[n][i]), accumulated at 32 bits so intermediate sums do not
+	// clip. output may alias one of the inputs.
+	void (*mix)(const std::int16_t* const* inputs, std::size_t input_count, std::int16_t* output,
+	            std::size_t count) noexcept = nullptr;
+	// Maps int16 to [-1, 1) by dividing by 32768, and back with saturation.
+	void (*to_float)(const std::int16_t* input, float* output,
+	                 std::size_t count) noexcept = nullptr;
+	void (*from_float)(const float* input, std::int16_t* output,
+	                   std::size_t count) noexcept = nullptr;
+	void (*interleave)(const std::int16_t* const* planes, std::size_t channels, std::size_t frames,
+	                   std::int16_t* output) noexcept = nullptr;
+	void (*deinterleave)(const std::int16_t* input, std::size_t channels, std::size_t frames,
+	                     std::int16_t* const* planes) noexcept = nullptr;
+	AudioLevel (*level)(const std::int16_t* input, std::size_t count) noexcept = nullptr;
+};
+
+// The portable reference implementation.
+const AudioDspKernels& ScalarAudioDspKernels() noexcept;
+// Kernels for isa, or null when they are not built for this architecture or the CPU lacks them.
+const AudioDspKernels* AudioDspKernelsFor(AudioDspIsa isa) noexcept;
+// The fastest kernels the running CPU supports, detected once on first use.
+const AudioDspKernels& AudioDsp() noexcept;
+
+// Checked span wrappers over AudioDsp(). They return false when buffer sizes do not match.
+bool ScaleAudio(std::span<const std::int16_t> input, std::span<std::int16_t> output,
+                float gain) noexcept;
+// Every input must hold output.size() samples.
+bool MixAudio(std::span<const std::int16_t* const> inputs, std::span<std::int16_t> output) noexcept;
+bool ConvertAudioToFloat(std::span<const std::int16_t> input, std::span<float> output) noexcept;
+bool ConvertAudioFromFloat(std::span<const float> input, std::span<std::int16_t> output) noexcept;
+// Every plane must hold output.size() / planes.size() frames.
+bool InterleaveAudio(std::span<const std::int16_t* const> planes,
+                     std::span<std::int16_t> output) noexcept;
+bool DeinterleaveAudio(std::span<const std::int16_t> input,
+                       std::span<std::int16_t* const> planes) noexcept;
+AudioLevel MeasureAudioLevel(std::span<const std::int16_t> input) noexcept;
+
+} // namespace livekit::capture
@@ -0,0 +1,35 @@
+/**
+ * Copyright (c) 2026 sunze
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "audio_dsp.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LKC_AUDIO_DSP_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define LKC_AUDIO_DSP_NEON 1
+#endif
+
+namespace livekit::capture {
+
+// Per-ISA tables. Each is defined only on the architecture that can run it; AVX2 additionally
+// needs a runtime CPU check before use.
+#if defined(LKC_AUDIO_DSP_X86)
+extern const AudioDspKernels kSse2AudioDspKernels;
+extern const AudioDspKernels kAvx2AudioDspKernels;
+#endif
+#if defined(LKC_AUDIO_DSP_NEON)
+extern const AudioDspKernels kNeonAudioDspKernels;
+#endif
+
+// Scalar pieces the vector kernels use for their tails, so every ISA rounds identically.
+std::int16_t SaturateAudioSample(float value) noexcept;
+void MixAudioRange(const std::int16_t* const* inputs, std::size_t input_count,
+                   std::int16_t* output, std::size_t begin, std::size_t end) noexcept;
+AudioLevel MakeAudioLevel(std::int32_t peak, std::uint64_t sum_of_squares,
+                          std::size_t count) noexcept;
+
+} // namespace livekit::capture
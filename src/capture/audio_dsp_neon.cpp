@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2026 sunze
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "audio_dsp_kernels.h"
+
+#if defined(LKC_AUDIO_DSP_NEON)
+
+#include <algorithm>
+#include <arm_neon.h>
+
+namespace livekit::capture {
+
+namespace {
+
+constexpr float kInt16ToFloat = 1.0F / 32768.0F;
+constexpr float kFloatToInt16 = 32768.0F;
+
+// maxnm/minnm return the numeric operand for NaN, matching the scalar and SSE clamp. vcvtnq rounds
+// to nearest-even like lrintf in the default rounding mode.
+inline int32x4_t RoundSaturated(float32x4_t values) {
+	values = vmaxnmq_f32(values, vdupq_n_f32(-32768.0F));
+	values = vminnmq_f32(values, vdupq_n_f32(32767.0F));
+	return vcvtnq_s32_f32(values);
+}
+
+inline int16x8_t Narrow(int32x4_t low, int32x4_t high) {
+	return vcombine_s16(vqmovn_s32(low), vqmovn_s32(high));
+}
+
+void ScaleNeon(const std::int16_t* input, std::int16_t* output, std::size_t count,
+               float gain) noexcept {
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const int16x8_t samples = vld1q_s16(input + index);
+		const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+		const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+		vst1q_s16(output + index, Narrow(RoundSaturated(vmulq_n_f32(low, gain)),
+		                                 RoundSaturated(vmulq_n_f32(high, gain))));
+	}
+	for (; index < count; ++index) {
+		output[index] = SaturateAudioSample(static_cast<float>(input[index]) * gain);
+	}
+}
+
+void MixNeon(const std::int16_t* const* inputs, std::size_t input_count, std::int16_t* output,
+             std::size_t count) noexcept {
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		int32x4_t low = vdupq_n_s32(0);
+		int32x4_t high = vdupq_n_s32(0);
+		for (std::size_t input = 0; input < input_count; ++input) {
+			const int16x8_t samples = vld1q_s16(inputs[input] + index);
+			low = vaddw_s16(low, vget_low_s16(samples));
+			high = vaddw_s16(high, vget_high_s16(samples));
+		}
+		vst1q_s16(output + index, Narrow(low, high));
+	}
+	MixAudioRange(inputs, input_count, output, index, count);
+}
+
+void ToFloatNeon(const std::int16_t* input, float* output, std::size_t count) noexcept {
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const int16x8_t samples = vld1q_s16(input + index);
+		vst1q_f32(output + index,
+		          vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), kInt16ToFloat));
+		vst1q_f32(output + index + 4,
+		          vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), kInt16ToFloat));
+	}
+	for (; index < count; ++index) {
+		output[index] = static_cast<float>(input[index]) * kInt16ToFloat;
+	}
+}
+
+void FromFloatNeon(const float* input, std::int16_t* output, std::size_t count) noexcept {
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const int32x4_t low = RoundSaturated(vmulq_n_f32(vld1q_f32(input + index), kFloatToInt16));
+		const int32x4_t high =
+		    RoundSaturated(vmulq_n_f32(vld1q_f32(input + index + 4), kFloatToInt16));
+		vst1q_s16(output + index, Narrow(low, high));
+	}
+	for (; index < count; ++index) {
+		output[index] = SaturateAudioSample(input[index] * kFloatToInt16);
+	}
+}
+
+void InterleaveNeon(const std::int16_t* const* planes, std::size_t channels, std::size_t frames,
+                    std::int16_t* output) noexcept {
+	if (channels != 2) {
+		ScalarAudioDspKernels().interleave(planes, channels, frames, output);
+		return;
+	}
+	std::size_t frame = 0;
+	for (; frame + 8 <= frames; frame += 8) {
+		const int16x8x2_t stereo{vld1q_s16(planes[0] + frame), vld1q_s16(planes[1] + frame)};
+		vst2q_s16(output + frame * 2, stereo);
+	}
+	for (; frame < frames; ++frame) {
+		output[frame * 2] = planes[0][frame];
+		output[frame * 2 + 1] = planes[1][frame];
+	}
+}
+
+void DeinterleaveNeon(const std::int16_t* input, std::size_t channels, std::size_t frames,
+                      std::int16_t* const* planes) noexcept {
+	if (channels != 2) {
+		ScalarAudioDspKernels().deinterleave(input, channels, frames, planes);
+		return;
+	}
+	std::size_t frame = 0;
+	for (; frame + 8 <= frames; frame += 8) {
+		const int16x8x2_t stereo = vld2q_s16(input + frame * 2);
+		vst1q_s16(planes[0] + frame, stereo.val[0]);
+		vst1q_s16(planes[1] + frame, stereo.val[1]);
+	}
+	for (; frame < frames; ++frame) {
+		planes[0][frame] = input[frame * 2];
+		planes[1][frame] = input[frame * 2 + 1];
+	}
+}
+
+AudioLevel LevelNeon(const std::int16_t* input, std::size_t count) noexcept {
+	int16x8_t maximum = vdupq_n_s16(0);
+	int16x8_t minimum = vdupq_n_s16(0);
+	uint64x2_t sum = vdupq_n_u64(0);
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const int16x8_t samples = vld1q_s16(input + index);
+		maximum = vmaxq_s16(maximum, samples);
+		minimum = vminq_s16(minimum, samples);
+		const int16x4_t low = vget_low_s16(samples);
+		const int16x4_t high = vget_high_s16(samples);
+		sum = vpadalq_u32(sum, vreinterpretq_u32_s32(vmull_s16(low, low)));
+		sum = vpadalq_u32(sum, vreinterpretq_u32_s32(vmull_s16(high, high)));
+	}
+	std::int32_t peak = std::max<std::int32_t>(vmaxvq_s16(maximum),
+	                                           -static_cast<std::int32_t>(vminvq_s16(minimum)));
+	std::uint64_t sum_of_squares = vaddvq_u64(sum);
+	for (; index < count; ++index) {
+		const std::int32_t sample = input[index];
+		peak = std::max(peak, sample < 0 ? -sample : sample);
+		sum_of_squares += static_cast<std::uint64_t>(sample * sample);
+	}
+	return MakeAudioLevel(peak, sum_of_squares, count);
+}
+
+} // namespace
+
+const AudioDspKernels kNeonAudioDspKernels{
+    AudioDspIsa::Neon, ScaleNeon,        MixNeon,   ToFloatNeon, FromFloatNeon,
+    InterleaveNeon,    DeinterleaveNeon, LevelNeon,
+};
+
+} // namespace livekit::capture
+
+#endif // LKC_AUDIO_DSP_NEON
@@ -0,0 +1,306 @@
+/**
+ * Copyright (c) 2026 sunze
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "audio_dsp_kernels.h"
+
+#if defined(LKC_AUDIO_DSP_X86)
+
+#include <algorithm>
+#include <immintrin.h>
+
+// SSE2 is part of the x86-64 baseline. AVX2 kernels are compiled per function so the rest of the
+// library keeps the baseline instruction set and only runs them after the CPU check.
+#if defined(__GNUC__) || defined(__clang__)
+#define LKC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LKC_TARGET_AVX2
+#endif
+
+namespace livekit::capture {
+
+namespace {
+
+constexpr float kInt16ToFloat = 1.0F / 32768.0F;
+constexpr float kFloatToInt16 = 32768.0F;
+
+// Sign-extends the low or high four int16 lanes to int32.
+inline __m128i WidenLow(__m128i samples) {
+	return _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+}
+
+inline __m128i WidenHigh(__m128i samples) {
+	return _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+}
+
+// Clamps before converting so that out-of-range values saturate instead of producing INT_MIN.
+inline __m128i RoundSaturated(__m128 values) {
+	values = _mm_max_ps(values, _mm_set1_ps(-32768.0F));
+	values = _mm_min_ps(values, _mm_set1_ps(32767.0F));
+	return _mm_cvtps_epi32(values);
+}
+
+inline __m128i Load(const std::int16_t* data) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+inline void Store(std::int16_t* data, __m128i values) {
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(data), values);
+}
+
+void ScaleSse2(const std::int16_t* input, std::int16_t* output, std::size_t count,
+               float gain) noexcept {
+	const __m128 factor = _mm_set1_ps(gain);
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const __m128i samples = Load(input + index);
+		const __m128i low = RoundSaturated(_mm_mul_ps(_mm_cvtepi32_ps(WidenLow(samples)), factor));
+		const __m128i high =
+		    RoundSaturated(_mm_mul_ps(_mm_cvtepi32_ps(WidenHigh(samples)), factor));
+		Store(output + index, _mm_packs_epi32(low, high));
+	}
+	for (; index < count; ++index) {
+		output[index] = SaturateAudioSample(static_cast<float>(input[index]) * gain);
+	}
+}
+
+void MixSse2(const std::int16_t* const* inputs, std::size_t input_count, std::int16_t* output,
+             std::size_t count) noexcept {
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		__m128i low = _mm_setzero_si128();
+		__m128i high = _mm_setzero_si128();
+		for (std::size_t input = 0; input < input_count; ++input) {
+			const __m128i samples = Load(inputs[input] + index);
+			low = _mm_add_epi32(low, WidenLow(samples));
+			high = _mm_add_epi32(high, WidenHigh(samples));
+		}
+		Store(output + index, _mm_packs_epi32(low, high));
+	}
+	MixAudioRange(inputs, input_count, output, index, count);
+}
+
+void ToFloatSse2(const std::int16_t* input, float* output, std::size_t count) noexcept {
+	const __m128 factor = _mm_set1_ps(kInt16ToFloat);
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const __m128i samples = Load(input + index);
+		_mm_storeu_ps(output + index, _mm_mul_ps(_mm_cvtepi32_ps(WidenLow(samples)), factor));
+		_mm_storeu_ps(output + index + 4, _mm_mul_ps(_mm_cvtepi32_ps(WidenHigh(samples)), factor));
+	}
+	for (; index < count; ++index) {
+		output[index] = static_cast<float>(input[index]) * kInt16ToFloat;
+	}
+}
+
+void FromFloatSse2(const float* input, std::int16_t* output, std::size_t count) noexcept {
+	const __m128 factor = _mm_set1_ps(kFloatToInt16);
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const __m128i low = RoundSaturated(_mm_mul_ps(_mm_loadu_ps(input + index), factor));
+		const __m128i high = RoundSaturated(_mm_mul_ps(_mm_loadu_ps(input + index + 4), factor));
+		Store(output + index, _mm_packs_epi32(low, high));
+	}
+	for (; index < count; ++index) {
+		output[index] = SaturateAudioSample(input[index] * kFloatToInt16);
+	}
+}
+
+// Only stereo, the common capture and playback layout, has a vector path.
+void InterleaveSse2(const std::int16_t* const* planes, std::size_t channels, std::size_t frames,
+                    std::int16_t* output) noexcept {
+	if (channels != 2) {
+		ScalarAudioDspKernels().interleave(planes, channels, frames, output);
+		return;
+	}
+	const std::int16_t* left = planes[0];
+	const std::int16_t* right = planes[1];
+	std::size_t frame = 0;
+	for (; frame + 8 <= frames; frame += 8) {
+		const __m128i l = Load(left + frame);
+		const __m128i r = Load(right + frame);
+		Store(output + frame * 2, _mm_unpacklo_epi16(l, r));
+		Store(output + frame * 2 + 8, _mm_unpackhi_epi16(l, r));
+	}
+	for (; frame < frames; ++frame) {
+		output[frame * 2] = left[frame];
+		output[frame * 2 + 1] = right[frame];
+	}
+}
+
+void DeinterleaveSse2(const std::int16_t* input, std::size_t channels, std::size_t frames,
+                      std::int16_t* const* planes) noexcept {
+	if (channels != 2) {
+		ScalarAudioDspKernels().deinterleave(input, channels, frames, planes);
+		return;
+	}
+	std::int16_t* left = planes[0];
+	std::int16_t* right = planes[1];
+	std::size_t frame = 0;
+	for (; frame + 8 <= frames; frame += 8) {
+		const __m128i first = Load(input + frame * 2);
+		const __m128i second = Load(input + frame * 2 + 8);
+		// Even lanes are left samples: move them to the high half and shift back with sign.
+		const __m128i l = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(first, 16), 16),
+		                                  _mm_srai_epi32(_mm_slli_epi32(second, 16), 16));
+		const __m128i r = _mm_packs_epi32(_mm_srai_epi32(first, 16), _mm_srai_epi32(second, 16));
+		Store(left + frame, l);
+		Store(right + frame, r);
+	}
+	for (; frame < frames; ++frame) {
+		left[frame] = input[frame * 2];
+		right[frame] = input[frame * 2 + 1];
+	}
+}
+
+AudioLevel LevelSse2(const std::int16_t* input, std::size_t count) noexcept {
+	const __m128i zero = _mm_setzero_si128();
+	__m128i maximum = zero;
+	__m128i minimum = zero;
+	__m128i sum = zero;
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const __m128i samples = Load(input + index);
+		maximum = _mm_max_epi16(maximum, samples);
+		minimum = _mm_min_epi16(minimum, samples);
+		// Pairs of squares reach 2^31, so treat them as unsigned when widening to 64 bits.
+		const __m128i squares = _mm_madd_epi16(samples, samples);
+		sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(squares, zero));
+		sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(squares, zero));
+	}
+	alignas(16) std::int16_t maxima[8];
+	alignas(16) std::int16_t minima[8];
+	alignas(16) std::uint64_t sums[2];
+	_mm_store_si128(reinterpret_cast<__m128i*>(maxima), maximum);
+	_mm_store_si128(reinterpret_cast<__m128i*>(minima), minimum);
+	_mm_store_si128(reinterpret_cast<__m128i*>(sums), sum);
+	std::int32_t peak = std::max<std::int32_t>(*std::max_element(maxima, maxima + 8),
+	                                           -static_cast<std::int32_t>(
+	                                               *std::min_element(minima, minima + 8)));
+	std::uint64_t sum_of_squares = sums[0] + sums[1];
+	for (; index < count; ++index) {
+		const std::int32_t sample = input[index];
+		peak = std::max(peak, sample < 0 ? -sample : sample);
+		sum_of_squares += static_cast<std::uint64_t>(sample * sample);
+	}
+	return MakeAudioLevel(peak, sum_of_squares, count);
+}
+
+LKC_TARGET_AVX2 inline __m256i Widen(const std::int16_t* data) {
+	return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+}
+
+LKC_TARGET_AVX2 inline __m256i RoundSaturated256(__m256 values) {
+	values = _mm256_max_ps(values, _mm256_set1_ps(-32768.0F));
+	values = _mm256_min_ps(values, _mm256_set1_ps(32767.0F));
+	return _mm256_cvtps_epi32(values);
+}
+
+// _mm256_packs_epi32 packs within 128-bit lanes; restore sample order across them.
+LKC_TARGET_AVX2 inline void StorePacked256(std::int16_t* data, __m256i low, __m256i high) {
+	const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(data), packed);
+}
+
+LKC_TARGET_AVX2 void ScaleAvx2(const std::int16_t* input, std::int16_t* output, std::size_t count,
+                               float gain) noexcept {
+	const __m256 factor = _mm256_set1_ps(gain);
+	std::size_t index = 0;
+	for (; index + 16 <= count; index += 16) {
+		const __m256i low =
+		    RoundSaturated256(_mm256_mul_ps(_mm256_cvtepi32_ps(Widen(input + index)), factor));
+		const __m256i high =
+		    RoundSaturated256(_mm256_mul_ps(_mm256_cvtepi32_ps(Widen(input + index + 8)), factor));
+		StorePacked256(output + index, low, high);
+	}
+	ScaleSse2(input + index, output + index, count - index, gain);
+}
+
+LKC_TARGET_AVX2 void MixAvx2(const std::int16_t* const* inputs, std::size_t input_count,
+                             std::int16_t* output, std::size_t count) noexcept {
+	std::size_t index = 0;
+	for (; index + 16 <= count; index += 16) {
+		__m256i low = _mm256_setzero_si256();
+		__m256i high = _mm256_setzero_si256();
+		for (std::size_t input = 0; input < input_count; ++input) {
+			low = _mm256_add_epi32(low, Widen(inputs[input] + index));
+			high = _mm256_add_epi32(high, Widen(inputs[input] + index + 8));
+		}
+		StorePacked256(output + index, low, high);
+	}
+	MixAudioRange(inputs, input_count, output, index, count);
+}
+
+LKC_TARGET_AVX2 void ToFloatAvx2(const std::int16_t* input, float* output,
+                                 std::size_t count) noexcept {
+	const __m256 factor = _mm256_set1_ps(kInt16ToFloat);
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		_mm256_storeu_ps(output + index,
+		                 _mm256_mul_ps(_mm256_cvtepi32_ps(Widen(input + index)), factor));
+	}
+	ToFloatSse2(input + index, output + index, count - index);
+}
+
+LKC_TARGET_AVX2 void FromFloatAvx2(const float* input, std::int16_t* output,
+                                   std::size_t count) noexcept {
+	const __m256 factor = _mm256_set1_ps(kFloatToInt16);
+	std::size_t index = 0;
+	for (; index + 16 <= count; index += 16) {
+		const __m256i low =
+		    RoundSaturated256(_mm256_mul_ps(_mm256_loadu_ps(input + index), factor));
+		const __m256i high =
+		    RoundSaturated256(_mm256_mul_ps(_mm256_loadu_ps(input + index + 8), factor));
+		StorePacked256(output + index, low, high);
+	}
+	FromFloatSse2(input + index, output + index, count - index);
+}
+
+LKC_TARGET_AVX2 AudioLevel LevelAvx2(const std::int16_t* input, std::size_t count) noexcept {
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i maximum = zero;
+	__m256i minimum = zero;
+	__m256i sum = zero;
+	std::size_t index = 0;
+	for (; index + 16 <= count; index += 16) {
+		const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + index));
+		maximum = _mm256_max_epi16(maximum, samples);
+		minimum = _mm256_min_epi16(minimum, samples);
+		const __m256i squares = _mm256_madd_epi16(samples, samples);
+		sum = _mm256_add_epi64(sum, _mm256_unpacklo_epi32(squares, zero));
+		sum = _mm256_add_epi64(sum, _mm256_unpackhi_epi32(squares, zero));
+	}
+	alignas(32) std::int16_t maxima[16];
+	alignas(32) std::int16_t minima[16];
+	alignas(32) std::uint64_t sums[4];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(maxima), maximum);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(minima), minimum);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(sums), sum);
+	std::int32_t peak = std::max<std::int32_t>(*std::max_element(maxima, maxima + 16),
+	                                           -static_cast<std::int32_t>(
+	                                               *std::min_element(minima, minima + 16)));
+	std::uint64_t sum_of_squares = sums[0] + sums[1] + sums[2] + sums[3];
+	for (; index < count; ++index) {
+		const std::int32_t sample = input[index];
+		peak = std::max(peak, sample < 0 ? -sample : sample);
+		sum_of_squares += static_cast<std::uint64_t>(sample * sample);
+	}
+	return MakeAudioLevel(peak, sum_of_squares, count);
+}
+
+} // namespace
+
+const AudioDspKernels kSse2AudioDspKernels{
+    AudioDspIsa::Sse2, ScaleSse2,        MixSse2,   ToFloatSse2, FromFloatSse2,
+    InterleaveSse2,    DeinterleaveSse2, LevelSse2,
+};
+
+const AudioDspKernels kAvx2AudioDspKernels{
+    AudioDspIsa::Avx2, ScaleAvx2,        MixAvx2,   ToFloatAvx2, FromFloatAvx2,
+    InterleaveSse2,    DeinterleaveSse2, LevelAvx2,
+};
+
+} // namespace livekit::capture
+
+#endif // LKC_AUDIO_DSP_X86
@@ -5,6 +5,8 @@
 
 #include "audio_gain.h"
 
+#include "audio_dsp.h"
+
 #include <algorithm>
 #include <cmath>
 
@@ -25,10 +27,11 @@ bool ApplyAudioGain(std::span<const std::int16_t> input, std::span<std::int16_t>
 		}
 		return true;
 	}
-	for (std::size_t index = 0; index < input.size(); ++index) {
-		output[index] = static_cast<std::int16_t>(std::lround(input[index] * gain));
+	if (gain == kMinAudioGain) {
+		std::fill(output.begin(), output.end(), std::int16_t{0});
+		return true;
 	}
-	return true;
+	return ScaleAudio(input, output, gain);
 }
 
 } // namespace livekit::capture
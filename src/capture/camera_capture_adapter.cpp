@@ -6,6 +6,10 @@
 #include "camera_capture_adapter.h"
 
 #include "frame_queue.h"
+#include "video_frame_converter.h"
+
+#include "api/video/video_frame.h"
+#include "common_video/include/video_frame_buffer_pool.h"
 
 #include "media_capture/camera_capture.h"
 #include "media_capture/camera_device.h"
@@ -14,18 +18,35 @@
 
 namespace livekit::capture {
 
+namespace {
+
+// Bounds the buffers in flight between capture and the encoder; a frame is dropped when all are in
+// use rather than growing the pool.
+constexpr int kMaxPooledBuffers = 8;
+
+} // namespace
+
 class CameraCaptureAdapter::Impl {
 public:
 	Impl(std::string device_id, std::uint32_t width, std::uint32_t height,
 	     std::uint32_t frames_per_second, CameraFrameCallback callback)
-	    : frame_queue_([callback = std::move(callback)](const OwnedBgraFrame& frame) {
-		      CapturedVideoFrame converted;
-		      if (ConvertBgraToI420(frame.data.data(), frame.width, frame.height,
-		                            frame.row_stride_bytes, frame.timestamp_us, converted)) {
-			      converted.rotation_degrees = frame.rotation_degrees;
-			      converted.mirrored = frame.mirrored;
-			      callback(converted);
+	    : frame_queue_([this, callback = std::move(callback)](const OwnedVideoFrame& frame) {
+		      // A rotation webrtc cannot represent would mislabel the frame; drop it instead.
+		      const auto rotation = ToVideoRotation(frame.rotation_degrees);
+		      if (!rotation) {
+			      return;
 		      }
+		      // The pool is only touched from the queue worker; encoders release buffers back to it
+		      // through their reference counts. NV12 reaches the encoder unconverted.
+		      auto buffer = ConvertToPooledBuffer(frame, buffer_pool_);
+		      if (!buffer) {
+			      return;
+		      }
+		      callback(webrtc::VideoFrame::Builder()
+		                   .set_video_frame_buffer(buffer)
+		                   .set_timestamp_us(frame.timestamp_us)
+		                   .set_rotation(*rotation)
+		                   .build());
 	      }) {
 		media_capture::CameraCaptureConfig config;
 		config.device_id = std::move(device_id);
@@ -33,6 +54,8 @@ public:
 		config.height = height;
 		config.frames_per_second = frames_per_second;
 		capture_ = media_capture::CreateCameraCapture(std::move(config), [this](const auto& frame) {
+			// The backend normalizes to BGRA today; native formats go through the format-aware
+			// Push() overload once it reports them.
 			frame_queue_.Push(frame.data, frame.width, frame.height, frame.row_stride_bytes,
 			                  frame.timestamp_us, frame.rotation_degrees, frame.mirrored);
 		});
@@ -58,6 +81,7 @@ public:
 		frame_queue_.Stop();
 	}
 
+	webrtc::VideoFrameBufferPool buffer_pool_{false, kMaxPooledBuffers};
 	LatestVideoFrameQueue frame_queue_;
 	std::unique_ptr<media_capture::CameraCapture> capture_;
 };
@@ -90,6 +114,10 @@ std::string CameraCaptureAdapter::LastError() const {
 	return impl_->capture_ ? impl_->capture_->LastError() : "camera capture is unavailable";
 }
 
+FrameQueueStats CameraCaptureAdapter::QueueStats() const noexcept {
+	return impl_->frame_queue_.Stats();
+}
+
 std::vector<CameraDeviceInfo> EnumerateCameraDevices() {
 	std::vector<CameraDeviceInfo> result;
 	for (auto& device : media_capture::EnumerateCameraDevices()) {
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "video_frame_converter.h"
+#include "frame_queue.h"
 
 #include <cstdint>
 #include <functional>
@@ -14,6 +14,10 @@
 #include <string_view>
 #include <vector>
 
+namespace webrtc {
+class VideoFrame;
+} // namespace webrtc
+
 namespace livekit::capture {
 
 struct CameraDeviceInfo {
@@ -21,7 +25,8 @@ struct CameraDeviceInfo {
 	std::string label;
 };
 
-using CameraFrameCallback = std::function<void(const CapturedVideoFrame& frame)>;
+// Frames are converted on the capture worker straight into pooled I420 buffers.
+using CameraFrameCallback = std::function<void(const webrtc::VideoFrame& frame)>;
 
 class CameraCaptureAdapter {
 public:
@@ -38,6 +43,7 @@ public:
 	std::string DeviceId() const;
 	bool SwitchDevice(std::string_view device_id);
 	std::string LastError() const;
+	FrameQueueStats QueueStats() const noexcept;
 
 private:
 	class Impl;
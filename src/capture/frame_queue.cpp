@@ -11,6 +11,53 @@
 
 namespace livekit::capture {
 
+std::optional<std::size_t> CaptureFrameSize(CapturePixelFormat format, std::uint32_t width,
+                                            std::uint32_t height, std::uint32_t row_stride_bytes,
+                                            std::size_t compressed_size) noexcept {
+	if (width == 0 || height == 0) {
+		return std::nullopt;
+	}
+	if (format == CapturePixelFormat::Mjpeg) {
+		return compressed_size == 0 ? std::nullopt : std::optional<std::size_t>(compressed_size);
+	}
+	const std::uint64_t stride = row_stride_bytes;
+	const std::uint64_t chroma_rows = (static_cast<std::uint64_t>(height) + 1U) / 2U;
+	std::uint64_t size = 0;
+	switch (format) {
+	case CapturePixelFormat::Bgra:
+		if (stride < static_cast<std::uint64_t>(width) * 4U) {
+			return std::nullopt;
+		}
+		size = stride * height;
+		break;
+	case CapturePixelFormat::Yuy2:
+		// Each 4-byte macropixel carries two luma samples.
+		if (stride < (static_cast<std::uint64_t>(width) + 1U) / 2U * 4U) {
+			return std::nullopt;
+		}
+		size = stride * height;
+		break;
+	case CapturePixelFormat::I420:
+		if (stride < width) {
+			return std::nullopt;
+		}
+		size = stride * height + (stride + 1U) / 2U * chroma_rows * 2U;
+		break;
+	case CapturePixelFormat::Nv12:
+		if (stride < width) {
+			return std::nullopt;
+		}
+		size = stride * height + stride * chroma_rows;
+		break;
+	default:
+		return std::nullopt;
+	}
+	if (size > std::numeric_limits<std::size_t>::max()) {
+		return std::nullopt;
+	}
+	return static_cast<std::size_t>(size);
+}
+
 LatestVideoFrameQueue::LatestVideoFrameQueue(FrameHandler handler) : handler_(std::move(handler)) {}
 
 LatestVideoFrameQueue::~LatestVideoFrameQueue() { Stop(); }
@@ -26,7 +73,10 @@ bool LatestVideoFrameQueue::Start() {
 	{
 		std::lock_guard<std::mutex> guard(mutex_);
 		stopping_ = false;
-		pending_frame_.reset();
+		if (pending_slot_.has_value()) {
+			ReleaseSlotLocked(*pending_slot_);
+			pending_slot_.reset();
+		}
 	}
 	running_.store(true);
 	try {
@@ -47,7 +97,10 @@ void LatestVideoFrameQueue::Stop() noexcept {
 	{
 		std::lock_guard<std::mutex> guard(mutex_);
 		stopping_ = true;
-		pending_frame_.reset();
+		if (pending_slot_.has_value()) {
+			ReleaseSlotLocked(*pending_slot_);
+			pending_slot_.reset();
+		}
 	}
 	condition_.notify_all();
 	if (worker_.joinable()) {
@@ -61,57 +114,131 @@ void LatestVideoFrameQueue::Stop() noexcept {
 
 bool LatestVideoFrameQueue::IsRunning() const noexcept { return running_.load(); }
 
+FrameQueueStats LatestVideoFrameQueue::Stats() const noexcept {
+	FrameQueueStats stats;
+	stats.pool_hits = pool_hits_.load(std::memory_order_relaxed);
+	stats.pool_misses = pool_misses_.load(std::memory_order_relaxed);
+	stats.dropped_frames = dropped_frames_.load(std::memory_order_relaxed);
+	stats.delivered_frames = delivered_frames_.load(std::memory_order_relaxed);
+	return stats;
+}
+
+std::optional<std::size_t> LatestVideoFrameQueue::AcquireSlotLocked() noexcept {
+	for (std::size_t slot = 0; slot < kPoolSize; ++slot) {
+		if ((free_slots_ & (1U << slot)) != 0) {
+			free_slots_ &= ~(1U << slot);
+			return slot;
+		}
+	}
+	// Only concurrent producers can exhaust the pool; reuse the stale pending frame instead.
+	if (pending_slot_.has_value()) {
+		const auto slot = *pending_slot_;
+		pending_slot_.reset();
+		dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+		return slot;
+	}
+	return std::nullopt;
+}
+
+void LatestVideoFrameQueue::ReleaseSlotLocked(std::size_t slot) noexcept {
+	free_slots_ |= 1U << slot;
+}
+
 bool LatestVideoFrameQueue::Push(const std::uint8_t* data, std::uint32_t width,
                                  std::uint32_t height, std::uint32_t row_stride_bytes,
                                  std::int64_t timestamp_us, std::uint16_t rotation_degrees,
                                  bool mirrored) noexcept {
-	try {
-		if (!running_.load() || data == nullptr || width == 0 || height == 0 ||
-		    width > std::numeric_limits<std::uint32_t>::max() / 4U ||
-		    row_stride_bytes < width * 4U ||
-		    height > std::numeric_limits<std::size_t>::max() / row_stride_bytes) {
+	const auto size = CaptureFrameSize(CapturePixelFormat::Bgra, width, height, row_stride_bytes);
+	if (!size.has_value()) {
+		return false;
+	}
+	return Push(CapturePixelFormat::Bgra, data, *size, width, height, row_stride_bytes,
+	            timestamp_us, rotation_degrees, mirrored);
+}
+
+bool LatestVideoFrameQueue::Push(CapturePixelFormat format, const std::uint8_t* data,
+                                 std::size_t available, std::uint32_t width, std::uint32_t height,
+                                 std::uint32_t row_stride_bytes, std::int64_t timestamp_us,
+                                 std::uint16_t rotation_degrees, bool mirrored) noexcept {
+	if (!running_.load() || data == nullptr) {
+		return false;
+	}
+	const auto required = CaptureFrameSize(format, width, height, row_stride_bytes, available);
+	if (!required.has_value() || available < *required) {
+		return false;
+	}
+	const std::size_t size = *required;
+	std::size_t slot = 0;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (stopping_) {
 			return false;
 		}
-		OwnedBgraFrame frame;
-		frame.data.resize(static_cast<std::size_t>(row_stride_bytes) * height);
-		std::memcpy(frame.data.data(), data, frame.data.size());
-		frame.width = width;
-		frame.height = height;
-		frame.row_stride_bytes = row_stride_bytes;
-		frame.timestamp_us = timestamp_us;
-		frame.rotation_degrees = rotation_degrees;
-		frame.mirrored = mirrored;
-		{
-			std::lock_guard<std::mutex> guard(mutex_);
-			if (!running_.load() || stopping_) {
-				return false;
-			}
-			pending_frame_ = std::move(frame);
+		const auto acquired = AcquireSlotLocked();
+		if (!acquired.has_value()) {
+			dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+			return false;
 		}
-		condition_.notify_one();
-		return true;
+		slot = *acquired;
+	}
+	// The acquired slot is owned exclusively by this call until it is published as pending.
+	auto& frame = pool_[slot];
+	try {
+		if (frame.data.capacity() < size) {
+			pool_misses_.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			pool_hits_.fetch_add(1, std::memory_order_relaxed);
+		}
+		frame.data.resize(size);
 	} catch (...) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		ReleaseSlotLocked(slot);
 		return false;
 	}
+	std::memcpy(frame.data.data(), data, size);
+	frame.format = format;
+	frame.width = width;
+	frame.height = height;
+	frame.row_stride_bytes = row_stride_bytes;
+	frame.timestamp_us = timestamp_us;
+	frame.rotation_degrees = rotation_degrees;
+	frame.mirrored = mirrored;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!running_.load() || stopping_) {
+			ReleaseSlotLocked(slot);
+			return false;
+		}
+		if (pending_slot_.has_value()) {
+			ReleaseSlotLocked(*pending_slot_);
+			dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+		}
+		pending_slot_ = slot;
+	}
+	condition_.notify_one();
+	return true;
 }
 
 void LatestVideoFrameQueue::Run() noexcept {
 	for (;;) {
-		OwnedBgraFrame frame;
+		std::size_t slot = 0;
 		{
 			std::unique_lock<std::mutex> lock(mutex_);
-			condition_.wait(lock, [this] { return stopping_ || pending_frame_.has_value(); });
+			condition_.wait(lock, [this] { return stopping_ || pending_slot_.has_value(); });
 			if (stopping_) {
 				return;
 			}
-			frame = std::move(*pending_frame_);
-			pending_frame_.reset();
+			slot = *pending_slot_;
+			pending_slot_.reset();
 		}
 		try {
-			handler_(frame);
+			handler_(pool_[slot]);
 		} catch (...) {
 			// Capture callbacks must not terminate the queue worker.
 		}
+		delivered_frames_.fetch_add(1, std::memory_order_relaxed);
+		std::lock_guard<std::mutex> guard(mutex_);
+		ReleaseSlotLocked(slot);
 	}
 }
 
@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -17,8 +19,26 @@
 
 namespace livekit::capture {
 
-struct OwnedBgraFrame {
+// Pixel layouts the queue can carry. Planar formats store their chroma directly below the luma
+// plane: I420 U and V rows use half of row_stride_bytes, NV12 interleaved UV rows use all of it.
+// MJPEG frames are compressed, so row_stride_bytes is ignored and data holds the whole bitstream.
+enum class CapturePixelFormat : std::uint8_t {
+	Bgra,
+	I420,
+	Nv12,
+	Yuy2,
+	Mjpeg,
+};
+
+// Returns the bytes a frame with this geometry occupies, or nullopt when the geometry is invalid.
+// compressed_size is the MJPEG payload length and must be non-zero for that format only.
+std::optional<std::size_t> CaptureFrameSize(CapturePixelFormat format, std::uint32_t width,
+                                            std::uint32_t height, std::uint32_t row_stride_bytes,
+                                            std::size_t compressed_size = 0) noexcept;
+
+struct OwnedVideoFrame {
 	std::vector<std::uint8_t> data;
+	CapturePixelFormat format = CapturePixelFormat::Bgra;
 	std::uint32_t width = 0;
 	std::uint32_t height = 0;
 	std::uint32_t row_stride_bytes = 0;
@@ -27,11 +47,24 @@ struct OwnedBgraFrame {
 	bool mirrored = false;
 };
 
-// Copies callback-owned BGRA frames and processes only the newest pending frame on a worker thread.
+struct FrameQueueStats {
+	// Pushes that reused an already large enough pool buffer.
+	std::uint64_t pool_hits = 0;
+	// Pushes that had to grow a pool buffer, i.e. the first frame and resolution increases.
+	std::uint64_t pool_misses = 0;
+	// Frames replaced by a newer frame, or rejected because no buffer was free.
+	std::uint64_t dropped_frames = 0;
+	std::uint64_t delivered_frames = 0;
+};
+
+// Copies callback-owned frames and processes only the newest pending frame on a worker thread.
+// Frames are copied into a fixed triple-buffer pool: one buffer being written, one pending, and one
+// being processed. Buffers keep their capacity, so steady-state capture does not allocate.
 // Stop() prevents further delivery and joins the worker before returning.
 class LatestVideoFrameQueue {
 public:
-	using FrameHandler = std::function<void(const OwnedBgraFrame& frame)>;
+	using FrameHandler = std::function<void(const OwnedVideoFrame& frame)>;
+	static constexpr std::size_t kPoolSize = 3;
 
 	explicit LatestVideoFrameQueue(FrameHandler handler);
 	~LatestVideoFrameQueue();
@@ -42,21 +75,38 @@ public:
 	bool Start();
 	void Stop() noexcept;
 	bool IsRunning() const noexcept;
+	// Queues a BGRA frame.
 	bool Push(const std::uint8_t* data, std::uint32_t width, std::uint32_t height,
 	          std::uint32_t row_stride_bytes, std::int64_t timestamp_us,
 	          std::uint16_t rotation_degrees = 0, bool mirrored = false) noexcept;
+	// Queues a frame in its native format so it reaches the converter without a BGRA round trip.
+	// available is the number of readable bytes at data and must cover CaptureFrameSize().
+	bool Push(CapturePixelFormat format, const std::uint8_t* data, std::size_t available,
+	          std::uint32_t width, std::uint32_t height, std::uint32_t row_stride_bytes,
+	          std::int64_t timestamp_us, std::uint16_t rotation_degrees = 0,
+	          bool mirrored = false) noexcept;
+	FrameQueueStats Stats() const noexcept;
 
 private:
 	void Run() noexcept;
+	std::optional<std::size_t> AcquireSlotLocked() noexcept;
+	void ReleaseSlotLocked(std::size_t slot) noexcept;
 
 	FrameHandler handler_;
 	mutable std::mutex lifecycle_mutex_;
 	mutable std::mutex mutex_;
 	std::condition_variable condition_;
-	std::optional<OwnedBgraFrame> pending_frame_;
+	std::array<OwnedVideoFrame, kPoolSize> pool_;
+	// Bit i is set while pool_[i] is neither being written, pending, nor being processed.
+	std::uint32_t free_slots_ = (1U << kPoolSize) - 1U;
+	std::optional<std::size_t> pending_slot_;
 	std::thread worker_;
 	std::atomic_bool running_{false};
 	bool stopping_ = false;
+	std::atomic<std::uint64_t> pool_hits_{0};
+	std::atomic<std::uint64_t> pool_misses_{0};
+	std::atomic<std::uint64_t> dropped_frames_{0};
+	std::atomic<std::uint64_t> delivered_frames_{0};
 };
 
 } // namespace livekit::capture
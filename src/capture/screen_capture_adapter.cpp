@@ -6,6 +6,10 @@
 #include "screen_capture_adapter.h"
 
 #include "frame_queue.h"
+#include "video_frame_converter.h"
+
+#include "api/video/video_frame.h"
+#include "common_video/include/video_frame_buffer_pool.h"
 
 #include "media_capture/screen_capture.h"
 #include "media_capture/screen_source.h"
@@ -13,18 +17,36 @@
 #include <utility>
 
 namespace livekit::capture {
+namespace {
+
+// Bounds the buffers in flight between capture and the encoder; a frame is dropped when all are in
+// use rather than growing the pool.
+constexpr int kMaxPooledI420Buffers = 8;
+
+} // namespace
+
 class ScreenCaptureAdapter::Impl {
 public:
 	Impl(std::string source_id, std::uint32_t frames_per_second, bool include_cursor,
 	     ScreenFrameCallback callback)
-	    : frame_queue_([callback = std::move(callback)](const OwnedBgraFrame& frame) {
-		      CapturedVideoFrame converted;
-		      if (ConvertBgraToI420(frame.data.data(), frame.width, frame.height,
-		                            frame.row_stride_bytes, frame.timestamp_us, converted)) {
-			      converted.rotation_degrees = frame.rotation_degrees;
-			      converted.mirrored = frame.mirrored;
-			      callback(converted);
+	    : frame_queue_([this, callback = std::move(callback)](const OwnedVideoFrame& frame) {
+		      // A rotation webrtc cannot represent would mislabel the frame; drop it instead.
+		      const auto rotation = ToVideoRotation(frame.rotation_degrees);
+		      if (!rotation) {
+			      return;
 		      }
+		      // The pool is only touched from the queue worker; encoders release buffers back to it
+		      // through their reference counts.
+		      auto buffer = ConvertBgraToPooledI420(frame.data.data(), frame.width, frame.height,
+		                                            frame.row_stride_bytes, buffer_pool_);
+		      if (!buffer) {
+			      return;
+		      }
+		      callback(webrtc::VideoFrame::Builder()
+		                   .set_video_frame_buffer(buffer)
+		                   .set_timestamp_us(frame.timestamp_us)
+		                   .set_rotation(*rotation)
+		                   .build());
 	      }) {
 		media_capture::ScreenCaptureConfig config;
 		config.source_id = std::move(source_id);
@@ -56,6 +78,7 @@ public:
 		frame_queue_.Stop();
 	}
 
+	webrtc::VideoFrameBufferPool buffer_pool_{false, kMaxPooledI420Buffers};
 	LatestVideoFrameQueue frame_queue_;
 	std::unique_ptr<media_capture::ScreenCapture> capture_;
 };
@@ -83,6 +106,10 @@ std::string ScreenCaptureAdapter::LastError() const {
 	return impl_->capture_ ? impl_->capture_->LastError() : "screen capture is unavailable";
 }
 
+FrameQueueStats ScreenCaptureAdapter::QueueStats() const noexcept {
+	return impl_->frame_queue_.Stats();
+}
+
 std::vector<ScreenSourceInfo> EnumerateScreenSources() {
 	std::vector<ScreenSourceInfo> result;
 	for (auto& source : media_capture::EnumerateScreenSources()) {
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "video_frame_converter.h"
+#include "frame_queue.h"
 
 #include <cstdint>
 #include <functional>
@@ -13,6 +13,10 @@
 #include <string>
 #include <vector>
 
+namespace webrtc {
+class VideoFrame;
+} // namespace webrtc
+
 namespace livekit::capture {
 
 enum class ScreenSourceKind {
@@ -30,7 +34,8 @@ struct ScreenSourceInfo {
 	std::uint32_t height = 0;
 };
 
-using ScreenFrameCallback = std::function<void(const CapturedVideoFrame& frame)>;
+// Frames are converted on the capture worker straight into pooled I420 buffers.
+using ScreenFrameCallback = std::function<void(const webrtc::VideoFrame& frame)>;
 
 class ScreenCaptureAdapter {
 public:
@@ -46,6 +51,7 @@ public:
 	bool IsRunning() const noexcept;
 	std::string SourceId() const;
 	std::string LastError() const;
+	FrameQueueStats QueueStats() const noexcept;
 
 private:
 	class Impl;
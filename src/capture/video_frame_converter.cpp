@@ -5,25 +5,49 @@
 
 #include "video_frame_converter.h"
 
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "common_video/include/video_frame_buffer_pool.h"
 #include "libyuv/convert.h"
+#include "libyuv/planar_functions.h"
 
 #include <limits>
 
 namespace livekit::capture {
 
+namespace {
+
+bool IsValidBgraFrame(const std::uint8_t* data, std::uint32_t source_width,
+                      std::uint32_t source_height, std::uint32_t row_stride_bytes) {
+	const std::uint32_t width = source_width & ~1U;
+	const std::uint32_t height = source_height & ~1U;
+	return data != nullptr && width != 0 && height != 0 &&
+	       source_width <= std::numeric_limits<std::uint32_t>::max() / 4U &&
+	       width <= static_cast<std::uint32_t>(std::numeric_limits<int>::max()) &&
+	       height <= static_cast<std::uint32_t>(std::numeric_limits<int>::max()) &&
+	       row_stride_bytes >= source_width * 4U &&
+	       row_stride_bytes <= static_cast<std::uint32_t>(std::numeric_limits<int>::max());
+}
+
+bool IsValidQueuedFrame(const OwnedVideoFrame& frame) {
+	constexpr auto kMaxInt = static_cast<std::uint32_t>(std::numeric_limits<int>::max());
+	const auto size = CaptureFrameSize(frame.format, frame.width, frame.height,
+	                                   frame.row_stride_bytes, frame.data.size());
+	return size.has_value() && frame.data.size() >= *size && frame.width <= kMaxInt &&
+	       frame.height <= kMaxInt && frame.row_stride_bytes <= kMaxInt &&
+	       (frame.format == CapturePixelFormat::Mjpeg || (frame.width > 1 && frame.height > 1));
+}
+
+} // namespace
+
 bool ConvertBgraToI420(const std::uint8_t* data, std::uint32_t source_width,
                        std::uint32_t source_height, std::uint32_t row_stride_bytes,
                        std::int64_t timestamp_us, CapturedVideoFrame& destination) {
-	const std::uint32_t width = source_width & ~1U;
-	const std::uint32_t height = source_height & ~1U;
-	if (data == nullptr || width == 0 || height == 0 ||
-	    source_width > std::numeric_limits<std::uint32_t>::max() / 4U ||
-	    width > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
-	    height > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
-	    row_stride_bytes < source_width * 4U ||
-	    row_stride_bytes > static_cast<std::uint32_t>(std::numeric_limits<int>::max())) {
+	if (!IsValidBgraFrame(data, source_width, source_height, row_stride_bytes)) {
 		return false;
 	}
+	const std::uint32_t width = source_width & ~1U;
+	const std::uint32_t height = source_height & ~1U;
 	const std::size_t y_size = static_cast<std::size_t>(width) * height;
 	const std::size_t chroma_size = y_size / 4;
 	destination.i420.resize(y_size + chroma_size * 2);
@@ -41,4 +65,124 @@ bool ConvertBgraToI420(const std::uint8_t* data, std::uint32_t source_width,
 	return true;
 }
 
+webrtc::scoped_refptr<webrtc::I420Buffer>
+ConvertBgraToPooledI420(const std::uint8_t* data, std::uint32_t source_width,
+                        std::uint32_t source_height, std::uint32_t row_stride_bytes,
+                        webrtc::VideoFrameBufferPool& pool) {
+	if (!IsValidBgraFrame(data, source_width, source_height, row_stride_bytes)) {
+		return nullptr;
+	}
+	const int width = static_cast<int>(source_width & ~1U);
+	const int height = static_cast<int>(source_height & ~1U);
+	auto buffer = pool.CreateI420Buffer(width, height);
+	if (!buffer) {
+		return nullptr;
+	}
+	if (libyuv::ARGBToI420(data, static_cast<int>(row_stride_bytes), buffer->MutableDataY(),
+	                       buffer->StrideY(), buffer->MutableDataU(), buffer->StrideU(),
+	                       buffer->MutableDataV(), buffer->StrideV(), width, height) != 0) {
+		return nullptr;
+	}
+	return buffer;
+}
+
+webrtc::scoped_refptr<webrtc::I420Buffer> ConvertToPooledI420(const OwnedVideoFrame& frame,
+                                                              webrtc::VideoFrameBufferPool& pool) {
+	if (!IsValidQueuedFrame(frame)) {
+		return nullptr;
+	}
+	if (frame.format == CapturePixelFormat::Bgra) {
+		return ConvertBgraToPooledI420(frame.data.data(), frame.width, frame.height,
+		                               frame.row_stride_bytes, pool);
+	}
+	const bool compressed = frame.format == CapturePixelFormat::Mjpeg;
+	const int width = static_cast<int>(compressed ? frame.width : frame.width & ~1U);
+	const int height = static_cast<int>(compressed ? frame.height : frame.height & ~1U);
+	auto buffer = pool.CreateI420Buffer(width, height);
+	if (!buffer) {
+		return nullptr;
+	}
+	const std::uint8_t* data = frame.data.data();
+	const int stride = static_cast<int>(frame.row_stride_bytes);
+	const std::size_t luma_size = static_cast<std::size_t>(stride) * frame.height;
+	int result = -1;
+	switch (frame.format) {
+	case CapturePixelFormat::I420: {
+		const int chroma_stride = (stride + 1) / 2;
+		const std::size_t chroma_rows = (frame.height + 1) / 2;
+		const std::uint8_t* u = data + luma_size;
+		const std::uint8_t* v = u + static_cast<std::size_t>(chroma_stride) * chroma_rows;
+		result = libyuv::I420Copy(data, stride, u, chroma_stride, v, chroma_stride,
+		                          buffer->MutableDataY(), buffer->StrideY(), buffer->MutableDataU(),
+		                          buffer->StrideU(), buffer->MutableDataV(), buffer->StrideV(),
+		                          width, height);
+		break;
+	}
+	case CapturePixelFormat::Nv12:
+		result = libyuv::NV12ToI420(data, stride, data + luma_size, stride, buffer->MutableDataY(),
+		                            buffer->StrideY(), buffer->MutableDataU(), buffer->StrideU(),
+		                            buffer->MutableDataV(), buffer->StrideV(), width, height);
+		break;
+	case CapturePixelFormat::Yuy2:
+		result = libyuv::YUY2ToI420(data, stride, buffer->MutableDataY(), buffer->StrideY(),
+		                            buffer->MutableDataU(), buffer->StrideU(),
+		                            buffer->MutableDataV(), buffer->StrideV(), width, height);
+		break;
+	case CapturePixelFormat::Mjpeg:
+		result = libyuv::MJPGToI420(data, frame.data.size(), buffer->MutableDataY(),
+		                            buffer->StrideY(), buffer->MutableDataU(), buffer->StrideU(),
+		                            buffer->MutableDataV(), buffer->StrideV(), width, height, width,
+		                            height);
+		break;
+	default:
+		break;
+	}
+	if (result != 0) {
+		return nullptr;
+	}
+	return buffer;
+}
+
+webrtc::scoped_refptr<webrtc::NV12Buffer> CopyToPooledNv12(const OwnedVideoFrame& frame,
+                                                           webrtc::VideoFrameBufferPool& pool) {
+	if (frame.format != CapturePixelFormat::Nv12 || !IsValidQueuedFrame(frame)) {
+		return nullptr;
+	}
+	const int width = static_cast<int>(frame.width & ~1U);
+	const int height = static_cast<int>(frame.height & ~1U);
+	auto buffer = pool.CreateNV12Buffer(width, height);
+	if (!buffer) {
+		return nullptr;
+	}
+	const std::uint8_t* data = frame.data.data();
+	const int stride = static_cast<int>(frame.row_stride_bytes);
+	libyuv::CopyPlane(data, stride, buffer->MutableDataY(), buffer->StrideY(), width, height);
+	libyuv::CopyPlane(data + static_cast<std::size_t>(stride) * frame.height, stride,
+	                  buffer->MutableDataUV(), buffer->StrideUV(), width, height / 2);
+	return buffer;
+}
+
+std::optional<webrtc::VideoRotation> ToVideoRotation(std::uint16_t rotation_degrees) {
+	switch (rotation_degrees) {
+	case 0:
+		return webrtc::kVideoRotation_0;
+	case 90:
+		return webrtc::kVideoRotation_90;
+	case 180:
+		return webrtc::kVideoRotation_180;
+	case 270:
+		return webrtc::kVideoRotation_270;
+	default:
+		return std::nullopt;
+	}
+}
+
+webrtc::scoped_refptr<webrtc::VideoFrameBuffer>
+ConvertToPooledBuffer(const OwnedVideoFrame& frame, webrtc::VideoFrameBufferPool& pool) {
+	if (frame.format == CapturePixelFormat::Nv12) {
+		return CopyToPooledNv12(frame, pool);
+	}
+	return ConvertToPooledI420(frame, pool);
+}
+
 } // namespace livekit::capture
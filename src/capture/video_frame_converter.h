@@ -5,9 +5,22 @@
 
 #pragma once
 
+#include "frame_queue.h"
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_rotation.h"
+
 #include <cstdint>
+#include <optional>
 #include <vector>
 
+namespace webrtc {
+class I420Buffer;
+class NV12Buffer;
+class VideoFrameBuffer;
+class VideoFrameBufferPool;
+} // namespace webrtc
+
 namespace livekit::capture {
 
 struct CapturedVideoFrame {
@@ -23,4 +36,27 @@ bool ConvertBgraToI420(const std::uint8_t* data, std::uint32_t width, std::uint3
                        std::uint32_t row_stride_bytes, std::int64_t timestamp_us,
                        CapturedVideoFrame& destination);
 
+// Converts straight into a buffer drawn from pool, avoiding the packed intermediate copy. Odd
+// dimensions are cropped to even ones. Returns null for invalid input or an exhausted pool.
+webrtc::scoped_refptr<webrtc::I420Buffer>
+ConvertBgraToPooledI420(const std::uint8_t* data, std::uint32_t width, std::uint32_t height,
+                        std::uint32_t row_stride_bytes, webrtc::VideoFrameBufferPool& pool);
+
+// Converts a queued frame of any capture format into a pooled I420 buffer with a single libyuv
+// pass. Raw formats are cropped to even dimensions; MJPEG decodes at its native size.
+webrtc::scoped_refptr<webrtc::I420Buffer> ConvertToPooledI420(const OwnedVideoFrame& frame,
+                                                              webrtc::VideoFrameBufferPool& pool);
+
+// Copies a queued NV12 frame into a pooled NV12Buffer without touching the pixel layout.
+webrtc::scoped_refptr<webrtc::NV12Buffer> CopyToPooledNv12(const OwnedVideoFrame& frame,
+                                                           webrtc::VideoFrameBufferPool& pool);
+
+// Maps a capture rotation in degrees to webrtc's; anything but 0, 90, 180 or 270 has no mapping.
+std::optional<webrtc::VideoRotation> ToVideoRotation(std::uint16_t rotation_degrees);
+
+// Picks the cheapest encoder-ready buffer for a queued frame: NV12 passes straight through, every
+// other format takes exactly one conversion to I420.
+webrtc::scoped_refptr<webrtc::VideoFrameBuffer>
+ConvertToPooledBuffer(const OwnedVideoFrame& frame, webrtc::VideoFrameBufferPool& pool);
+
 } // namespace livekit::capture
@@ -0,0 +1,114 @@
+#include "adaptive_stream.h"
+
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace core {
+namespace {
+
+bool SameRenderState(const VideoRenderState& left, const VideoRenderState& right) {
+	return left.visible == right.visible && left.dimensions.width == right.dimensions.width &&
+	       left.dimensions.height == right.dimensions.height;
+}
+
+} // namespace
+
+RemoteTrackSettings AdaptRemoteTrackSettings(RemoteTrackSettings settings,
+                                             const VideoRenderState& state) {
+	settings.enabled = state.visible;
+	if (!state.visible) {
+		return settings;
+	}
+	if (state.dimensions.width != 0 && state.dimensions.height != 0) {
+		settings.video_quality.reset();
+		settings.video_dimensions = state.dimensions;
+	} else {
+		settings.video_dimensions.reset();
+		settings.video_quality = VideoQuality::High;
+	}
+	return settings;
+}
+
+AdaptiveStream::AdaptiveStream(std::chrono::milliseconds interval, SendFunction send)
+    : send_(std::move(send)), debouncer_(Debouncer::Create(interval)) {}
+
+AdaptiveStream::~AdaptiveStream() {
+	// Stops further flushes being posted, then waits for one already running, which uses the
+	// members below.
+	debouncer_->cancel();
+	flush_worker_.Stop();
+}
+
+void AdaptiveStream::Update(const std::string& track_sid, const VideoRenderState& state) {
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		auto& track = tracks_[track_sid];
+		if (track.dirty && SameRenderState(track.state, state)) {
+			return;
+		}
+		track.state = state;
+		track.dirty = !track.sent.has_value() || !SameRenderState(*track.sent, state);
+		if (!track.dirty) {
+			return;
+		}
+		if (!deferred_ && !debouncer_->lock()) {
+			deferred_ = debouncer_->defer([this] { flush_worker_.Post([this] { Flush(); }); });
+		}
+		if (deferred_) {
+			return;
+		}
+	}
+	SendDirty();
+}
+
+void AdaptiveStream::Remove(const std::string& track_sid) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	tracks_.erase(track_sid);
+}
+
+std::optional<VideoRenderState> AdaptiveStream::State(const std::string& track_sid) const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto found = tracks_.find(track_sid);
+	if (found == tracks_.end()) {
+		return std::nullopt;
+	}
+	return found->second.state;
+}
+
+void AdaptiveStream::SendDirty() {
+	std::lock_guard<std::mutex> send_guard(send_mutex_);
+	std::vector<std::pair<std::string, VideoRenderState>> changes;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (auto& [track_sid, track] : tracks_) {
+			if (track.dirty) {
+				track.dirty = false;
+				changes.emplace_back(track_sid, track.state);
+			}
+		}
+	}
+	for (const auto& [track_sid, state] : changes) {
+		if (!send_(track_sid, state)) {
+			continue;
+		}
+		std::lock_guard<std::mutex> guard(mutex_);
+		auto found = tracks_.find(track_sid);
+		if (found != tracks_.end()) {
+			found->second.sent = state;
+		}
+	}
+}
+
+void AdaptiveStream::Flush() {
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		deferred_ = false;
+		// Starts the next interval, so changes arriving during this send wait for it to end.
+		debouncer_->lock();
+	}
+	SendDirty();
+}
+
+} // namespace core
+} // namespace livekit
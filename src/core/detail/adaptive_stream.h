@@ -0,0 +1,74 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_ADAPTIVE_STREAM_H_
+#define _LKC_CORE_DETAIL_ADAPTIVE_STREAM_H_
+
+#include "debouncer.h"
+#include "livekit/core/option/media_option.h"
+#include "stream_reassembly.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace livekit {
+namespace core {
+
+// Folds a declared render state into the settings a subscriber sends for a video track: hidden
+// tracks are disabled, visible ones ask for the rendered size, or the top layer when the size is
+// unknown. fps and priority are left as the application set them.
+RemoteTrackSettings AdaptRemoteTrackSettings(RemoteTrackSettings settings,
+                                             const VideoRenderState& state);
+
+// Tracks the latest render state of each remote video track and hands changes to send(). The
+// first change after a quiet interval is sent on the caller's thread; changes arriving within the
+// interval are coalesced and sent together when it ends, so a burst of resizes costs one update
+// per track. send() does signalling I/O, so the shared timer only posts that flush to the stream's
+// own task runner.
+class AdaptiveStream {
+public:
+	using SendFunction =
+	    std::function<bool(const std::string& track_sid, const VideoRenderState& state)>;
+
+	AdaptiveStream(std::chrono::milliseconds interval, SendFunction send);
+	// Changes not yet sent are dropped.
+	~AdaptiveStream();
+
+	AdaptiveStream(const AdaptiveStream&) = delete;
+	AdaptiveStream& operator=(const AdaptiveStream&) = delete;
+
+	void Update(const std::string& track_sid, const VideoRenderState& state);
+	// Forgets a track once it is unsubscribed.
+	void Remove(const std::string& track_sid);
+	std::optional<VideoRenderState> State(const std::string& track_sid) const;
+
+private:
+	struct Track {
+		VideoRenderState state;
+		std::optional<VideoRenderState> sent;
+		bool dirty = false;
+	};
+
+	void SendDirty();
+	// Sends the changes deferred during the interval, once it has ended. Runs on flush_worker_.
+	void Flush();
+
+	const SendFunction send_;
+	const std::unique_ptr<Debouncer> debouncer_;
+	detail::SerialTaskRunner flush_worker_;
+
+	// send_mutex_ is taken before mutex_ and held across send() so updates never overtake.
+	std::mutex send_mutex_;
+	mutable std::mutex mutex_;
+	std::map<std::string, Track> tracks_;
+	bool deferred_ = false;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_ADAPTIVE_STREAM_H_
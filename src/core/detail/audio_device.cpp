@@ -19,6 +19,8 @@
 
 #include "../../capture/audio_capture_adapter.h"
 
+#include "rtc_base/event.h"
+
 #include <algorithm>
 #include <cstring>
 #include <limits>
@@ -28,14 +30,18 @@ const int kSampleRate = 48000;
 const int kChannels = 2;
 const int kBytesPerSample = kChannels * sizeof(int16_t);
 const int kSamplesPer10Ms = kSampleRate / 100;
+// The echo reference ring holds 100 ms; a reader more than 30 ms behind skips to the newest frames.
+const std::size_t kEchoReferenceFrames = 10;
+const std::size_t kEchoReferenceMaxLagFrames = 3;
 } // namespace
 
 namespace livekit {
 namespace core {
 
-AudioDevice::AudioDevice(webrtc::TaskQueueFactory* task_queue_factory)
-    : task_queue_factory_(task_queue_factory), data_(kSamplesPer10Ms * kChannels),
-      playback_(std::make_unique<capture::AudioPlaybackAdapter>()) {}
+AudioDevice::AudioDevice(webrtc::TaskQueueFactory* task_queue_factory, AudioPlayout playout)
+    : data_(kSamplesPer10Ms * kChannels), task_queue_factory_(task_queue_factory),
+      headless_(playout == AudioPlayout::Headless),
+      playback_(headless_ ? nullptr : std::make_unique<capture::AudioPlaybackAdapter>()) {}
 
 AudioDevice::~AudioDevice() { Terminate(); }
 
@@ -50,67 +56,105 @@ int32_t AudioDevice::RegisterAudioCallback(webrtc::AudioTransport* transport) {
 	return 0;
 }
 
-void AudioDevice::DeliverRenderData(const std::int16_t* samples, std::uint32_t sample_rate,
-                                    std::uint32_t channels,
-                                    std::uint32_t frames_per_channel) noexcept {
-	if (samples == nullptr || sample_rate == 0 || channels == 0 || frames_per_channel == 0) {
-		return;
+void AudioDevice::AddRenderConsumer() {
+	if (render_consumers_.fetch_add(1) == 0 && headless_) {
+		PostUpdateRenderTask();
 	}
-	try {
-		webrtc::MutexLock lock(&render_data_mutex_);
-		render_data_.assign(samples, samples + frames_per_channel * channels);
-		render_sample_rate_ = sample_rate;
-		render_channels_ = channels;
-		++render_sequence_;
-	} catch (...) {
-		// Decoded audio callbacks cannot propagate allocation failures into libwebrtc.
+}
+
+void AudioDevice::RemoveRenderConsumer() {
+	if (render_consumers_.fetch_sub(1) == 1 && headless_) {
+		PostUpdateRenderTask();
 	}
 }
 
-bool AudioDevice::ReadRenderData(uint64_t& sequence, std::vector<std::int16_t>& samples,
-                                 std::uint32_t& sample_rate, std::uint32_t& channels) const {
-	webrtc::MutexLock lock(&render_data_mutex_);
-	if (sequence == render_sequence_ || render_data_.empty()) {
-		return false;
+AudioDevice::EchoReference::EchoReference() : ring_(kRenderFrameSamples * kEchoReferenceFrames) {}
+
+bool AudioDevice::EchoReference::Read(std::span<std::int16_t, kRenderFrameSamples> frame) noexcept {
+	const std::size_t queued_frames = ring_.Size() / kRenderFrameSamples;
+	if (queued_frames > kEchoReferenceMaxLagFrames) {
+		ring_.Discard((queued_frames - kEchoReferenceMaxLagFrames) * kRenderFrameSamples);
 	}
-	samples = render_data_;
-	sample_rate = render_sample_rate_;
-	channels = render_channels_;
-	sequence = render_sequence_;
-	return true;
+	return ring_.Read(frame.data(), frame.size());
 }
 
-int32_t AudioDevice::Init() {
+std::shared_ptr<AudioDevice::EchoReference> AudioDevice::AttachEchoReference() {
+	auto reference = std::make_shared<EchoReference>();
 	webrtc::MutexLock lock(&mutex_);
-	if (initialized_)
-		return 0;
+	echo_references_.push_back(reference);
+	return reference;
+}
 
-	audio_queue_ = task_queue_factory_->CreateTaskQueue("AudioDevice",
-	                                                    webrtc::TaskQueueFactory::Priority::NORMAL);
+void AudioDevice::DetachEchoReference(const std::shared_ptr<EchoReference>& reference) {
+	webrtc::MutexLock lock(&mutex_);
+	echo_references_.erase(
+	    std::remove(echo_references_.begin(), echo_references_.end(), reference),
+	    echo_references_.end());
+}
+
+void AudioDevice::PostUpdateRenderTask() {
+	// Not mutex_: a track released from inside a sink callback lands here during Render().
+	webrtc::MutexLock lock(&queue_mutex_);
+	if (audio_queue_) {
+		audio_queue_->PostTask([this] { UpdateRenderTask(); });
+	}
+}
 
-	audio_task_ = webrtc::RepeatingTaskHandle::Start(audio_queue_.get(), [this]() {
+void AudioDevice::UpdateRenderTask() {
+	{
 		webrtc::MutexLock lock(&mutex_);
-		if (!playing_ || audio_transport_ == nullptr) {
-			return webrtc::TimeDelta::Millis(10);
-		}
-		int64_t elapsed_time_ms = -1;
-		int64_t ntp_time_ms = -1;
-		size_t samples_out = 0;
-		audio_transport_->NeedMorePlayData(kSamplesPer10Ms, kBytesPerSample, kChannels, kSampleRate,
-		                                   data_.data(), samples_out, &elapsed_time_ms,
-		                                   &ntp_time_ms);
-		samples_out = std::min(samples_out, static_cast<std::size_t>(kSamplesPer10Ms));
-		if (samples_out > 0 && playback_) {
-			DeliverRenderData(data_.data(), kSampleRate, kChannels,
-			                  static_cast<std::uint32_t>(samples_out));
-			playback_->QueueFrame(data_.data(), kSampleRate, kChannels,
-			                      static_cast<std::uint32_t>(samples_out));
+		if (!initialized_) {
+			return;
 		}
+	}
+	const bool wanted = !headless_ || render_consumers_.load() > 0;
+	if (wanted && !audio_task_.Running()) {
+		audio_task_ = webrtc::RepeatingTaskHandle::Start(webrtc::TaskQueueBase::Current(),
+		                                                 [this] { return Render(); });
+	} else if (!wanted && audio_task_.Running()) {
+		audio_task_.Stop();
+	}
+}
 
+webrtc::TimeDelta AudioDevice::Render() {
+	webrtc::MutexLock lock(&mutex_);
+	if (!playing_ || audio_transport_ == nullptr) {
 		return webrtc::TimeDelta::Millis(10);
-	});
+	}
+	int64_t elapsed_time_ms = -1;
+	int64_t ntp_time_ms = -1;
+	size_t samples_out = 0;
+	audio_transport_->NeedMorePlayData(kSamplesPer10Ms, kBytesPerSample, kChannels, kSampleRate,
+	                                   data_.data(), samples_out, &elapsed_time_ms, &ntp_time_ms);
+	samples_out = std::min(samples_out, static_cast<std::size_t>(kSamplesPer10Ms));
+	if (samples_out == 0) {
+		return webrtc::TimeDelta::Millis(10);
+	}
+	if (!echo_references_.empty()) {
+		// Readers consume whole frames, so a short mix is padded with silence. A full ring means
+		// that reader stalled; its copy is dropped rather than blocking the render thread.
+		std::fill(data_.begin() + samples_out * kChannels, data_.end(), 0);
+		for (const auto& reference : echo_references_) {
+			reference->ring_.Write(data_.data(), kRenderFrameSamples);
+		}
+	}
+	if (playback_) {
+		playback_->QueueFrame(data_.data(), kSampleRate, kChannels,
+		                      static_cast<std::uint32_t>(samples_out));
+	}
+	return webrtc::TimeDelta::Millis(10);
+}
+
+int32_t AudioDevice::Init() {
+	webrtc::MutexLock lock(&mutex_);
+	if (initialized_)
+		return 0;
 
+	webrtc::MutexLock queue_lock(&queue_mutex_);
+	audio_queue_ = task_queue_factory_->CreateTaskQueue("AudioDevice",
+	                                                    webrtc::TaskQueueFactory::Priority::NORMAL);
 	initialized_ = true;
+	audio_queue_->PostTask([this] { UpdateRenderTask(); });
 	return 0;
 }
 
@@ -124,11 +168,23 @@ int32_t AudioDevice::Terminate() {
 		playing_ = false;
 		playout_initialized_ = false;
 	}
-	audio_task_.Stop();
+	std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter> audio_queue;
+	{
+		webrtc::MutexLock lock(&queue_mutex_);
+		audio_queue = std::move(audio_queue_);
+	}
+	if (audio_queue) {
+		// The render task is started and stopped only on its queue.
+		webrtc::Event stopped;
+		audio_queue->PostTask([this, &stopped] {
+			audio_task_.Stop();
+			stopped.Set();
+		});
+		stopped.Wait(webrtc::Event::kForever);
+	}
 	if (playback_) {
 		playback_->Stop();
 	}
-	audio_queue_ = nullptr;
 	return 0;
 }
 
@@ -138,6 +194,9 @@ bool AudioDevice::Initialized() const {
 }
 
 int16_t AudioDevice::PlayoutDevices() {
+	if (headless_) {
+		return 0;
+	}
 	const auto devices = capture::EnumerateAudioDevices();
 	return static_cast<int16_t>(
 	    std::count_if(devices.begin(), devices.end(), [](const auto& device) {
@@ -188,6 +247,9 @@ int32_t AudioDevice::SetPlayoutDevice(uint16_t index) {
 
 int32_t AudioDevice::SetPlayoutDevice(WindowsDeviceType device) {
 	(void)device;
+	if (headless_) {
+		return 0;
+	}
 	const auto devices = capture::EnumerateAudioDevices();
 	const auto selected = std::find_if(devices.begin(), devices.end(), [](const auto& item) {
 		return item.kind == capture::AudioDeviceKind::Output && item.is_default;
@@ -209,13 +271,13 @@ int32_t AudioDevice::PlayoutIsAvailable(bool* available) {
 	if (available == nullptr) {
 		return -1;
 	}
-	*available = PlayoutDevices() > 0;
+	*available = headless_ || PlayoutDevices() > 0;
 	return 0;
 }
 
 int32_t AudioDevice::InitPlayout() {
 	webrtc::MutexLock lock(&mutex_);
-	playout_initialized_ = playback_ != nullptr;
+	playout_initialized_ = headless_ || playback_ != nullptr;
 	return playout_initialized_ ? 0 : -1;
 }
 
@@ -232,7 +294,7 @@ bool AudioDevice::RecordingIsInitialized() const { return false; }
 
 int32_t AudioDevice::StartPlayout() {
 	webrtc::MutexLock lock(&mutex_);
-	if (!playback_ || (!playback_->IsRunning() && !playback_->Start())) {
+	if (!headless_ && (!playback_ || (!playback_->IsRunning() && !playback_->Start()))) {
 		return -1;
 	}
 	playout_initialized_ = true;
@@ -260,9 +322,9 @@ int32_t AudioDevice::StopRecording() { return 0; }
 
 bool AudioDevice::Recording() const { return false; }
 
-int32_t AudioDevice::InitSpeaker() { return playback_ ? 0 : -1; }
+int32_t AudioDevice::InitSpeaker() { return headless_ || playback_ ? 0 : -1; }
 
-bool AudioDevice::SpeakerIsInitialized() const { return playback_ != nullptr; }
+bool AudioDevice::SpeakerIsInitialized() const { return headless_ || playback_ != nullptr; }
 
 int32_t AudioDevice::InitMicrophone() { return 0; }
 
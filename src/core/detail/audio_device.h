@@ -20,8 +20,13 @@
 #ifndef _LKC_CORE_DETAIL_AUDIO_DEVICE_H_
 #define _LKC_CORE_DETAIL_AUDIO_DEVICE_H_
 
+#include "livekit/core/option/peer_factory.h"
+#include "spsc_ring_buffer.h"
+
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -41,15 +46,41 @@ namespace core {
 
 class AudioDevice : public webrtc::AudioDeviceModule {
 public:
-	AudioDevice(webrtc::TaskQueueFactory* task_queue_factory);
+	// Rendered audio is always 10 ms of 48 kHz stereo.
+	static constexpr std::uint32_t kRenderSampleRate = 48000;
+	static constexpr std::uint32_t kRenderChannels = 2;
+	static constexpr std::size_t kRenderFrameSamples = kRenderSampleRate / 100 * kRenderChannels;
+
+	AudioDevice(webrtc::TaskQueueFactory* task_queue_factory,
+	            AudioPlayout playout = AudioPlayout::Device);
 	~AudioDevice() override;
 
 	int32_t ActiveAudioLayer(AudioLayer* audioLayer) const override;
 	int32_t RegisterAudioCallback(webrtc::AudioTransport* transport) override;
-	void DeliverRenderData(const std::int16_t* samples, std::uint32_t sample_rate,
-	                       std::uint32_t channels, std::uint32_t frames_per_channel) noexcept;
-	bool ReadRenderData(uint64_t& sequence, std::vector<std::int16_t>& samples,
-	                    std::uint32_t& sample_rate, std::uint32_t& channels) const;
+
+	// Counted by each remote audio track. A headless device runs the render mix only while the
+	// count is non-zero.
+	void AddRenderConsumer();
+	void RemoveRenderConsumer();
+
+	// An echo canceller's view of what was rendered. Every attached reader gets its own ring, so
+	// several microphones on one device each see the whole render stream; while none is attached
+	// rendered frames are not copied anywhere.
+	class EchoReference {
+	public:
+		EchoReference();
+
+		// Reader thread only. Returns the oldest unread frame, skipping ahead when the reader
+		// falls behind.
+		bool Read(std::span<std::int16_t, kRenderFrameSamples> frame) noexcept;
+
+	private:
+		friend class AudioDevice;
+		SpscRingBuffer<std::int16_t> ring_;
+	};
+
+	std::shared_ptr<EchoReference> AttachEchoReference();
+	void DetachEchoReference(const std::shared_ptr<EchoReference>& reference);
 	bool SetPlayoutDeviceId(std::string_view device_id);
 	std::string PlayoutDeviceId() const;
 	capture::AudioPlaybackStats PlaybackStats() const;
@@ -134,17 +165,22 @@ public:
 #endif // WEBRTC_IOS
 
 private:
+	// Runs on audio_queue_. Starts or stops the 10 ms render task to match the consumer count.
+	void UpdateRenderTask();
+	void PostUpdateRenderTask();
+	webrtc::TimeDelta Render();
+
 	mutable webrtc::Mutex mutex_;
-	mutable webrtc::Mutex render_data_mutex_;
+	webrtc::Mutex queue_mutex_;
 	std::vector<int16_t> data_;
 	std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter> audio_queue_;
+	// Only touched on audio_queue_.
 	webrtc::RepeatingTaskHandle audio_task_;
 	webrtc::AudioTransport* audio_transport_ RTC_GUARDED_BY(mutex_) = nullptr;
-	std::vector<std::int16_t> render_data_ RTC_GUARDED_BY(render_data_mutex_);
-	std::uint32_t render_sample_rate_ RTC_GUARDED_BY(render_data_mutex_) = 0;
-	std::uint32_t render_channels_ RTC_GUARDED_BY(render_data_mutex_) = 0;
-	uint64_t render_sequence_ RTC_GUARDED_BY(render_data_mutex_) = 0;
 	webrtc::TaskQueueFactory* task_queue_factory_;
+	const bool headless_;
+	std::atomic<std::uint32_t> render_consumers_{0};
+	std::vector<std::shared_ptr<EchoReference>> echo_references_ RTC_GUARDED_BY(mutex_);
 	bool playing_{false};
 	bool initialized_{false};
 	bool playout_initialized_{false};
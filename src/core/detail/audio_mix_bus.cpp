@@ -0,0 +1,146 @@
+#include "audio_mix_bus.h"
+
+#include "../../capture/audio_dsp.h"
+
+#include <algorithm>
+
+namespace livekit {
+namespace core {
+
+AudioMixBus::Input::Input(std::string key, std::string group, uint32_t num_channels,
+                          std::size_t capacity)
+    : key_(std::move(key)), group_(std::move(group)), num_channels_(num_channels),
+      ring_(capacity) {}
+
+bool AudioMixBus::Input::Write(const int16_t* samples, std::size_t samples_per_channel) noexcept {
+	if (samples == nullptr || !ring_.Write(samples, samples_per_channel * num_channels_)) {
+		overrun_frames_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+AudioMixBus::AudioMixBus(uint32_t sample_rate, uint32_t num_channels, uint32_t max_buffered_ms)
+    : sample_rate_(sample_rate), num_channels_(num_channels),
+      frame_samples_(static_cast<std::size_t>(sample_rate / 100) * num_channels),
+      // Always room for two frames so a producer running slightly ahead of Pull() is not dropped.
+      capacity_samples_(std::max<std::size_t>(
+          frame_samples_ * 2,
+          static_cast<std::size_t>(sample_rate) * num_channels * max_buffered_ms / 1000)) {}
+
+bool AudioMixBus::IsValidLayout(uint32_t sample_rate, uint32_t num_channels) {
+	return sample_rate >= 8000 && sample_rate <= 192000 && sample_rate % 100 == 0 &&
+	       (num_channels == 1 || num_channels == 2);
+}
+
+std::shared_ptr<AudioMixBus::Input> AudioMixBus::AddInput(const std::string& key,
+                                                          const std::string& group) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	const bool exists = std::any_of(inputs_.begin(), inputs_.end(),
+	                                [&](const auto& input) { return input->key_ == key; });
+	if (exists) {
+		return nullptr;
+	}
+	std::shared_ptr<Input> input(new Input(key, group, num_channels_, capacity_samples_));
+	input->frame_.data.resize(frame_samples_);
+	input->frame_.sample_rate = sample_rate_;
+	input->frame_.num_channels = num_channels_;
+	input->frame_.samples_per_channel = SamplesPerFrame();
+	auto gain = group_gains_.find(group);
+	if (gain != group_gains_.end()) {
+		input->gain_ = gain->second;
+	}
+	inputs_.push_back(input);
+	mix_inputs_.reserve(inputs_.size());
+	return input;
+}
+
+bool AudioMixBus::RemoveInput(const std::string& key) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto it = std::find_if(inputs_.begin(), inputs_.end(),
+	                       [&](const auto& input) { return input->key_ == key; });
+	if (it == inputs_.end()) {
+		return false;
+	}
+	removed_overrun_frames_ += (*it)->overrun_frames_.load(std::memory_order_relaxed);
+	inputs_.erase(it);
+	return true;
+}
+
+bool AudioMixBus::HasInput(const std::string& key) const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	return std::any_of(inputs_.begin(), inputs_.end(),
+	                   [&](const auto& input) { return input->key_ == key; });
+}
+
+void AudioMixBus::SetGroupGain(const std::string& group, float gain) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	group_gains_[group] = gain;
+	for (auto& input : inputs_) {
+		if (input->group_ == group) {
+			input->gain_ = gain;
+		}
+	}
+}
+
+bool AudioMixBus::SetTap(const std::string& key, AudioMixerTap tap) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto it = std::find_if(inputs_.begin(), inputs_.end(),
+	                       [&](const auto& input) { return input->key_ == key; });
+	if (it == inputs_.end()) {
+		return false;
+	}
+	(*it)->tap_ = std::move(tap);
+	return true;
+}
+
+bool AudioMixBus::Pull(AudioFrame& frame) {
+	frame.data.resize(frame_samples_);
+	frame.sample_rate = sample_rate_;
+	frame.num_channels = num_channels_;
+	frame.samples_per_channel = SamplesPerFrame();
+
+	std::lock_guard<std::mutex> guard(mutex_);
+	mix_inputs_.clear();
+	const auto& dsp = capture::AudioDsp();
+	for (auto& input : inputs_) {
+		auto& samples = input->frame_.data;
+		if (!input->ring_.Read(samples.data(), frame_samples_)) {
+			// A partial frame stays queued; mixing it now would shift the track against the others.
+			++underrun_frames_;
+			continue;
+		}
+		if (input->gain_ != 1.0F) {
+			dsp.scale(samples.data(), samples.data(), frame_samples_, input->gain_);
+		}
+		if (input->tap_) {
+			input->tap_(input->group_, input->key_, input->frame_);
+		}
+		if (input->gain_ != 0.0F) {
+			mix_inputs_.push_back(samples.data());
+		}
+	}
+	++mixed_frames_;
+	if (mix_inputs_.empty()) {
+		std::fill(frame.data.begin(), frame.data.end(), int16_t{0});
+		return false;
+	}
+	dsp.mix(mix_inputs_.data(), mix_inputs_.size(), frame.data.data(), frame_samples_);
+	return true;
+}
+
+AudioMixerStats AudioMixBus::Stats() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	AudioMixerStats stats;
+	stats.track_count = static_cast<uint32_t>(inputs_.size());
+	stats.mixed_frames = mixed_frames_;
+	stats.underrun_frames = underrun_frames_;
+	stats.overrun_frames = removed_overrun_frames_;
+	for (const auto& input : inputs_) {
+		stats.overrun_frames += input->overrun_frames_.load(std::memory_order_relaxed);
+	}
+	return stats;
+}
+
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_AUDIO_MIX_BUS_H_
+#define _LKC_CORE_DETAIL_AUDIO_MIX_BUS_H_
+
+#include "livekit/core/track/audio_mixer_interface.h"
+#include "spsc_ring_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace livekit {
+namespace core {
+
+// Mixes any number of interleaved PCM inputs that already share the bus layout into 10 ms frames.
+// Each input is written by one producer thread through a lock-free ring; Pull() runs on a single
+// consumer thread. Adding and removing inputs allocates, writing and pulling do not.
+class AudioMixBus {
+public:
+	class Input {
+	public:
+		// Queues whole frames in the bus layout. Returns false, and counts an overrun, when the
+		// ring cannot take the frame.
+		bool Write(const int16_t* samples, std::size_t samples_per_channel) noexcept;
+
+	private:
+		friend class AudioMixBus;
+
+		Input(std::string key, std::string group, uint32_t num_channels, std::size_t capacity);
+
+		const std::string key_;
+		const std::string group_;
+		const std::size_t num_channels_;
+		SpscRingBuffer<int16_t> ring_;
+		std::atomic<uint64_t> overrun_frames_{0};
+		// Consumer state, guarded by the bus mutex.
+		float gain_ = 1.0F;
+		AudioMixerTap tap_;
+		AudioFrame frame_;
+	};
+
+	AudioMixBus(uint32_t sample_rate, uint32_t num_channels, uint32_t max_buffered_ms);
+
+	static bool IsValidLayout(uint32_t sample_rate, uint32_t num_channels);
+
+	uint32_t SampleRate() const { return sample_rate_; }
+	uint32_t NumChannels() const { return num_channels_; }
+	// Samples per channel in one 10 ms frame.
+	uint32_t SamplesPerFrame() const { return sample_rate_ / 100; }
+
+	// Returns null when key is already an input. group selects the gain set by SetGroupGain().
+	std::shared_ptr<Input> AddInput(const std::string& key, const std::string& group);
+	bool RemoveInput(const std::string& key);
+	bool HasInput(const std::string& key) const;
+	void SetGroupGain(const std::string& group, float gain);
+	bool SetTap(const std::string& key, AudioMixerTap tap);
+	bool Pull(AudioFrame& frame);
+	AudioMixerStats Stats() const;
+
+private:
+	const uint32_t sample_rate_;
+	const uint32_t num_channels_;
+	const std::size_t frame_samples_;
+	const std::size_t capacity_samples_;
+
+	mutable std::mutex mutex_;
+	std::vector<std::shared_ptr<Input>> inputs_;
+	std::unordered_map<std::string, float> group_gains_;
+	// Sized with inputs_ so Pull() never grows it.
+	std::vector<const int16_t*> mix_inputs_;
+	uint64_t mixed_frames_ = 0;
+	uint64_t underrun_frames_ = 0;
+	uint64_t removed_overrun_frames_ = 0;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_AUDIO_MIX_BUS_H_
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_worker_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace livekit {
+namespace core {
+namespace detail {
+namespace {
+
+template <std::size_t Buckets>
+void Record(std::array<uint64_t, Buckets>& histogram, uint64_t value) {
+	const auto bucket = std::min<std::size_t>(std::bit_width(value), Buckets - 1);
+	++histogram[bucket];
+}
+
+} // namespace
+
+CryptoWorkerPool::CryptoWorkerPool()
+    : CryptoWorkerPool(std::max(1u, std::thread::hardware_concurrency())) {}
+
+CryptoWorkerPool::CryptoWorkerPool(std::size_t workers) {
+	if (workers == 0) {
+		throw std::invalid_argument("CryptoWorkerPool needs at least one worker");
+	}
+	workers_.reserve(workers);
+	for (std::size_t index = 0; index < workers; ++index) {
+		workers_.push_back(std::make_unique<Worker>());
+	}
+}
+
+CryptoWorkerPool::~CryptoWorkerPool() {
+	for (auto& worker : workers_) {
+		{
+			std::lock_guard<std::mutex> guard(worker->mutex);
+			worker->stopping = true;
+		}
+		worker->wake.notify_one();
+	}
+	for (auto& worker : workers_) {
+		if (worker->thread.joinable()) {
+			worker->thread.join();
+		}
+	}
+}
+
+CryptoWorkerPool& CryptoWorkerPool::Shared() {
+	static CryptoWorkerPool* pool = new CryptoWorkerPool();
+	return *pool;
+}
+
+std::size_t CryptoWorkerPool::WorkerFor(uint64_t key) const {
+	// Keys are often pointers, whose low bits are always zero; mix before reducing.
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	return static_cast<std::size_t>(key % workers_.size());
+}
+
+void CryptoWorkerPool::Post(uint64_t key, Task task) {
+	if (!task) {
+		throw std::invalid_argument("CryptoWorkerPool task must not be empty");
+	}
+	auto& worker = *workers_[WorkerFor(key)];
+	{
+		std::lock_guard<std::mutex> guard(worker.mutex);
+		Record(worker.queue_depth, worker.queue.size());
+		worker.queue.push_back(Queued{std::move(task), Clock::now()});
+		if (!worker.thread.joinable()) {
+			worker.thread = std::thread([this, &worker] { Run(worker); });
+			return;
+		}
+	}
+	worker.wake.notify_one();
+}
+
+CryptoWorkerPool::Stats CryptoWorkerPool::GetStats() const {
+	Stats stats;
+	stats.workers = static_cast<uint32_t>(workers_.size());
+	for (const auto& worker : workers_) {
+		std::lock_guard<std::mutex> guard(worker->mutex);
+		if (worker->thread.joinable()) {
+			++stats.threads;
+		}
+		stats.completed += worker->completed;
+		for (std::size_t bucket = 0; bucket < kDepthBuckets; ++bucket) {
+			stats.queue_depth[bucket] += worker->queue_depth[bucket];
+		}
+		for (std::size_t bucket = 0; bucket < kLatencyBuckets; ++bucket) {
+			stats.latency_us[bucket] += worker->latency_us[bucket];
+		}
+		stats.max_latency_us = std::max(stats.max_latency_us, worker->max_latency_us);
+	}
+	return stats;
+}
+
+void CryptoWorkerPool::Run(Worker& worker) {
+	std::unique_lock<std::mutex> lock(worker.mutex);
+	while (true) {
+		worker.wake.wait(lock, [&] { return worker.stopping || !worker.queue.empty(); });
+		if (worker.queue.empty()) {
+			return;
+		}
+		auto queued = std::move(worker.queue.front());
+		worker.queue.pop_front();
+		lock.unlock();
+		queued.task();
+		// Destroy the task, and whatever it owns, outside the lock.
+		queued.task = Task();
+		const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+		    Clock::now() - queued.posted);
+		lock.lock();
+		const auto latency_us = static_cast<uint64_t>(latency.count());
+		++worker.completed;
+		Record(worker.latency_us, latency_us);
+		worker.max_latency_us = std::max(worker.max_latency_us, latency_us);
+	}
+}
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
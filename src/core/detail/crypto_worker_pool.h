@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_CRYPTO_WORKER_POOL_H_
+#define _LKC_CORE_DETAIL_CRYPTO_WORKER_POOL_H_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+// A fixed set of worker threads that frame cryptors hand their frames to, so the number of crypto
+// threads follows the CPU rather than the number of tracks. Tasks posted with the same key run on
+// the same worker in the order they were posted. Workers start on their first task.
+class CryptoWorkerPool {
+public:
+	// A move-only callable, so tasks can own the frame they transform.
+	class Task {
+	public:
+		Task() = default;
+		template <typename Function>
+		    requires(!std::is_same_v<std::decay_t<Function>, Task>)
+		Task(Function function) : impl_(std::make_unique<Impl<Function>>(std::move(function))) {}
+
+		explicit operator bool() const { return impl_ != nullptr; }
+		void operator()() { impl_->Run(); }
+
+	private:
+		struct Base {
+			virtual ~Base() = default;
+			virtual void Run() = 0;
+		};
+		template <typename Function> struct Impl final : Base {
+			explicit Impl(Function function) : function(std::move(function)) {}
+			void Run() override { function(); }
+			Function function;
+		};
+		std::unique_ptr<Base> impl_;
+	};
+
+	// Bucket 0 counts zeros and bucket i values in [2^(i-1), 2^i); the last bucket is open-ended.
+	static constexpr std::size_t kDepthBuckets = 12;
+	static constexpr std::size_t kLatencyBuckets = 21;
+
+	struct Stats {
+		uint32_t workers = 0;
+		uint32_t threads = 0;
+		uint64_t completed = 0;
+		// Tasks already waiting on the worker when a task was posted.
+		std::array<uint64_t, kDepthBuckets> queue_depth{};
+		// Microseconds from Post() until the task returned.
+		std::array<uint64_t, kLatencyBuckets> latency_us{};
+		uint64_t max_latency_us = 0;
+	};
+
+	// One worker per hardware thread.
+	CryptoWorkerPool();
+	explicit CryptoWorkerPool(std::size_t workers);
+	// Runs the tasks still queued, then joins the workers.
+	~CryptoWorkerPool();
+
+	CryptoWorkerPool(const CryptoWorkerPool&) = delete;
+	CryptoWorkerPool& operator=(const CryptoWorkerPool&) = delete;
+
+	// The process-wide pool shared by every frame cryptor. Never destroyed.
+	static CryptoWorkerPool& Shared();
+
+	void Post(uint64_t key, Task task);
+	std::size_t WorkerFor(uint64_t key) const;
+	Stats GetStats() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Queued {
+		Task task;
+		Clock::time_point posted;
+	};
+
+	struct Worker {
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::deque<Queued> queue;
+		std::thread thread;
+		bool stopping = false;
+		uint64_t completed = 0;
+		std::array<uint64_t, kDepthBuckets> queue_depth{};
+		std::array<uint64_t, kLatencyBuckets> latency_us{};
+		uint64_t max_latency_us = 0;
+	};
+
+	void Run(Worker& worker);
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_CRYPTO_WORKER_POOL_H_
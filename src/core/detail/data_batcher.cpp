@@ -0,0 +1,258 @@
+#include "data_batcher.h"
+
+#include <algorithm>
+
+namespace livekit {
+namespace core {
+namespace {
+
+std::size_t VarintSize(uint64_t value) {
+	std::size_t size = 1;
+	for (; value >= 0x80; value >>= 7) {
+		++size;
+	}
+	return size;
+}
+
+void AppendVarint(uint64_t value, std::string& output) {
+	for (; value >= 0x80; value >>= 7) {
+		output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+	}
+	output.push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(std::string_view& input, uint64_t& value) {
+	value = 0;
+	for (unsigned shift = 0; shift < 64 && !input.empty(); shift += 7) {
+		const auto byte = static_cast<uint8_t>(input.front());
+		input.remove_prefix(1);
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+uint64_t Microseconds(std::chrono::steady_clock::duration duration) {
+	const auto count = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	return count > 0 ? static_cast<uint64_t>(count) : 0;
+}
+
+} // namespace
+
+std::string EncodeDataBatchPacket(const DataBatch& batch) {
+	std::string payload(1, static_cast<char>(kDataBatchVersion));
+	payload.reserve(1 + VarintSize(batch.topic.size()) + batch.topic.size() +
+	                batch.payload.size());
+	AppendVarint(batch.topic.size(), payload);
+	payload += batch.topic;
+	payload += batch.payload;
+	return payload;
+}
+
+bool DecodeDataBatchPacket(std::string_view payload, std::string& topic,
+                           std::vector<std::string_view>& messages) {
+	messages.clear();
+	uint64_t topic_size = 0;
+	if (payload.empty() || static_cast<uint8_t>(payload.front()) != kDataBatchVersion) {
+		return false;
+	}
+	payload.remove_prefix(1);
+	if (!ReadVarint(payload, topic_size) || topic_size > payload.size()) {
+		return false;
+	}
+	const auto topic_view = payload.substr(0, static_cast<std::size_t>(topic_size));
+	payload.remove_prefix(static_cast<std::size_t>(topic_size));
+	if (!DecodeDataBatch(payload, messages)) {
+		return false;
+	}
+	topic.assign(topic_view.begin(), topic_view.end());
+	return true;
+}
+
+bool DecodeDataBatch(std::string_view payload, std::vector<std::string_view>& messages) {
+	messages.clear();
+	while (!payload.empty()) {
+		uint64_t size = 0;
+		if (!ReadVarint(payload, size) || size > payload.size()) {
+			messages.clear();
+			return false;
+		}
+		messages.push_back(payload.substr(0, static_cast<std::size_t>(size)));
+		payload.remove_prefix(static_cast<std::size_t>(size));
+	}
+	return true;
+}
+
+DataBatcher::DataBatcher(DataBatchingOptions options, SendFunction send)
+    : options_(options), send_(std::move(send)) {}
+
+DataBatcher::~DataBatcher() {
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		stopping_ = true;
+	}
+	wake_.notify_all();
+	if (worker_.joinable()) {
+		worker_.join();
+	}
+}
+
+bool DataBatcher::IsValidOptions(const DataBatchingOptions& options) {
+	return options.window_ms > 0 && options.max_batch_bytes > 0;
+}
+
+bool DataBatcher::Publish(const std::string& topic,
+                          std::vector<std::string> destination_identities, const uint8_t* data,
+                          std::size_t size) {
+	std::sort(destination_identities.begin(), destination_identities.end());
+	destination_identities.erase(
+	    std::unique(destination_identities.begin(), destination_identities.end()),
+	    destination_identities.end());
+	Key key{topic, std::move(destination_identities)};
+	const auto framed_size = VarintSize(size) + size;
+	const auto starts_batch = [&](Pending& pending, Clock::time_point now) {
+		pending.batch.topic = key.first;
+		pending.batch.destination_identities = key.second;
+		pending.first_queued = now;
+	};
+
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		const auto now = Clock::now();
+		auto found = pending_.find(key);
+		const auto queued_size = found == pending_.end() ? 0 : found->second.batch.payload.size();
+		if (queued_size + framed_size <= options_.max_batch_bytes) {
+			if (found == pending_.end()) {
+				found = pending_.try_emplace(key).first;
+				starts_batch(found->second, now);
+				StartWorkerLocked();
+			}
+			Append(found->second, data, size, now);
+			return true;
+		}
+	}
+
+	// The payload does not fit behind what is queued: send that first, then start a new batch, or
+	// send the payload on its own when it exceeds the budget by itself.
+	std::lock_guard<std::mutex> send_guard(send_mutex_);
+	std::vector<Pending> ready;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		const auto now = Clock::now();
+		auto found = pending_.find(key);
+		if (found != pending_.end()) {
+			ready.push_back(std::move(found->second));
+			pending_.erase(found);
+		}
+		Pending next;
+		starts_batch(next, now);
+		Append(next, data, size, now);
+		if (framed_size <= options_.max_batch_bytes) {
+			pending_.emplace(std::move(key), std::move(next));
+			StartWorkerLocked();
+		} else {
+			ready.push_back(std::move(next));
+		}
+	}
+	return Send(std::move(ready));
+}
+
+bool DataBatcher::Flush() {
+	std::lock_guard<std::mutex> send_guard(send_mutex_);
+	std::vector<Pending> ready;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (auto& [key, pending] : pending_) {
+			ready.push_back(std::move(pending));
+		}
+		pending_.clear();
+	}
+	return Send(std::move(ready));
+}
+
+DataBatchingStats DataBatcher::Stats() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	return stats_;
+}
+
+void DataBatcher::Append(Pending& pending, const uint8_t* data, std::size_t size,
+                         Clock::time_point now) {
+	AppendVarint(size, pending.batch.payload);
+	if (size != 0) {
+		pending.batch.payload.append(reinterpret_cast<const char*>(data), size);
+	}
+	++pending.batch.message_count;
+	pending.queued_offsets += now - pending.first_queued;
+}
+
+void DataBatcher::StartWorkerLocked() {
+	if (!worker_.joinable()) {
+		worker_ = std::thread([this] { Run(); });
+	}
+	wake_.notify_one();
+}
+
+bool DataBatcher::Send(std::vector<Pending> batches) {
+	bool sent_all = true;
+	for (const auto& pending : batches) {
+		const auto waited = Clock::now() - pending.first_queued;
+		const bool sent = send_(pending.batch);
+		sent_all = sent_all && sent;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!sent) {
+			++stats_.failed_packets;
+			continue;
+		}
+		const auto count = pending.batch.message_count;
+		++stats_.packets;
+		stats_.messages += count;
+		stats_.max_messages_per_packet = std::max(stats_.max_messages_per_packet, count);
+		stats_.total_added_latency_us += Microseconds(waited * count - pending.queued_offsets);
+		stats_.max_added_latency_us = std::max(stats_.max_added_latency_us, Microseconds(waited));
+	}
+	return sent_all;
+}
+
+void DataBatcher::Run() {
+	const auto window = std::chrono::milliseconds(options_.window_ms);
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (!stopping_) {
+		if (pending_.empty()) {
+			wake_.wait(lock);
+			continue;
+		}
+		auto deadline = Clock::time_point::max();
+		for (const auto& [key, pending] : pending_) {
+			deadline = std::min(deadline, pending.first_queued + window);
+		}
+		if (Clock::now() < deadline) {
+			wake_.wait_until(lock, deadline);
+			continue;
+		}
+		lock.unlock();
+		{
+			std::lock_guard<std::mutex> send_guard(send_mutex_);
+			std::vector<Pending> ready;
+			{
+				std::lock_guard<std::mutex> guard(mutex_);
+				const auto now = Clock::now();
+				for (auto it = pending_.begin(); it != pending_.end();) {
+					if (it->second.first_queued + window <= now) {
+						ready.push_back(std::move(it->second));
+						it = pending_.erase(it);
+					} else {
+						++it;
+					}
+				}
+			}
+			Send(std::move(ready));
+		}
+		lock.lock();
+	}
+}
+
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,104 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_DATA_BATCHER_H_
+#define _LKC_CORE_DETAIL_DATA_BATCHER_H_
+
+#include "livekit/core/data_packet.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace core {
+
+// A coalesced batch travels as one UserPacket on this reserved topic, so it never shares a topic
+// with application data. Its payload is kDataBatchVersion, the varint length-prefixed application
+// topic, then the messages, each varint length-prefixed.
+inline constexpr std::string_view kDataBatchTopic = "lk.data_batch";
+inline constexpr uint8_t kDataBatchVersion = 1;
+
+struct DataBatch {
+	std::string topic;
+	std::vector<std::string> destination_identities;
+	std::string payload;
+	uint32_t message_count = 0;
+};
+
+// The UserPacket payload for batch.
+std::string EncodeDataBatchPacket(const DataBatch& batch);
+// Reads a UserPacket payload sent on kDataBatchTopic into its application topic and views over
+// its messages. Returns false, with no messages, for any other version or a malformed payload;
+// the packet is then not a batch from this SDK.
+bool DecodeDataBatchPacket(std::string_view payload, std::string& topic,
+                           std::vector<std::string_view>& messages);
+// Splits a batch's messages into views over them. Malformed input yields false and no messages.
+bool DecodeDataBatch(std::string_view payload, std::vector<std::string_view>& messages);
+
+// Coalesces small payloads per topic and destination set. Batches are sent through send() by a
+// flush thread once their window expires, or by Publish() when a payload no longer fits. Sends are
+// serialised, so batches for one topic and destination set leave in publish order.
+class DataBatcher {
+public:
+	using SendFunction = std::function<bool(const DataBatch& batch)>;
+
+	DataBatcher(DataBatchingOptions options, SendFunction send);
+	// Stops the flush thread. Payloads still queued are dropped; call Flush() first to send them.
+	~DataBatcher();
+
+	DataBatcher(const DataBatcher&) = delete;
+	DataBatcher& operator=(const DataBatcher&) = delete;
+
+	static bool IsValidOptions(const DataBatchingOptions& options);
+
+	// Queues data. Returns false only when a send made on the caller's thread failed.
+	bool Publish(const std::string& topic, std::vector<std::string> destination_identities,
+	             const uint8_t* data, std::size_t size);
+	// Sends every queued batch now.
+	bool Flush();
+	DataBatchingStats Stats() const;
+	const DataBatchingOptions& Options() const { return options_; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+	using Key = std::pair<std::string, std::vector<std::string>>;
+
+	struct Pending {
+		DataBatch batch;
+		Clock::time_point first_queued;
+		// Sum of each payload's queue time minus first_queued, for the latency counters.
+		Clock::duration queued_offsets{};
+	};
+
+	void Append(Pending& pending, const uint8_t* data, std::size_t size, Clock::time_point now);
+	// Starts the flush thread on first use and wakes it for a new batch.
+	void StartWorkerLocked();
+	bool Send(std::vector<Pending> batches);
+	void Run();
+
+	const DataBatchingOptions options_;
+	const SendFunction send_;
+
+	// send_mutex_ is taken before mutex_ and held across send() so batches never overtake.
+	std::mutex send_mutex_;
+	mutable std::mutex mutex_;
+	std::condition_variable wake_;
+	std::map<Key, Pending> pending_;
+	bool stopping_ = false;
+	std::thread worker_;
+	DataBatchingStats stats_;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_DATA_BATCHER_H_
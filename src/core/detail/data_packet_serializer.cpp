@@ -0,0 +1,117 @@
+#include "data_packet_serializer.h"
+
+#include <limits>
+
+namespace livekit {
+namespace core {
+namespace {
+
+template <typename Message> Message* Lend(const Message& message) {
+	// The lent message is only read by serialisation and is taken back before returning.
+	return const_cast<Message*>(&message);
+}
+
+bool LendPayload(const livekit::DataPacket& packet, livekit::EncryptedPacketPayload& payload) {
+	if (packet.has_user()) {
+		payload.unsafe_arena_set_allocated_user(Lend(packet.user()));
+	} else if (packet.has_chat_message()) {
+		payload.unsafe_arena_set_allocated_chat_message(Lend(packet.chat_message()));
+	} else if (packet.has_rpc_request()) {
+		payload.unsafe_arena_set_allocated_rpc_request(Lend(packet.rpc_request()));
+	} else if (packet.has_rpc_ack()) {
+		payload.unsafe_arena_set_allocated_rpc_ack(Lend(packet.rpc_ack()));
+	} else if (packet.has_rpc_response()) {
+		payload.unsafe_arena_set_allocated_rpc_response(Lend(packet.rpc_response()));
+	} else if (packet.has_stream_header()) {
+		payload.unsafe_arena_set_allocated_stream_header(Lend(packet.stream_header()));
+	} else if (packet.has_stream_chunk()) {
+		payload.unsafe_arena_set_allocated_stream_chunk(Lend(packet.stream_chunk()));
+	} else if (packet.has_stream_trailer()) {
+		payload.unsafe_arena_set_allocated_stream_trailer(Lend(packet.stream_trailer()));
+	} else {
+		return false;
+	}
+	return true;
+}
+
+void ReturnPayload(livekit::EncryptedPacketPayload& payload) {
+	if (payload.has_user()) {
+		payload.unsafe_arena_release_user();
+	} else if (payload.has_chat_message()) {
+		payload.unsafe_arena_release_chat_message();
+	} else if (payload.has_rpc_request()) {
+		payload.unsafe_arena_release_rpc_request();
+	} else if (payload.has_rpc_ack()) {
+		payload.unsafe_arena_release_rpc_ack();
+	} else if (payload.has_rpc_response()) {
+		payload.unsafe_arena_release_rpc_response();
+	} else if (payload.has_stream_header()) {
+		payload.unsafe_arena_release_stream_header();
+	} else if (payload.has_stream_chunk()) {
+		payload.unsafe_arena_release_stream_chunk();
+	} else if (payload.has_stream_trailer()) {
+		payload.unsafe_arena_release_stream_trailer();
+	}
+}
+
+std::size_t SerializedSize(const google::protobuf::MessageLite& message) {
+	const auto size = message.ByteSizeLong();
+	return size <= static_cast<std::size_t>(std::numeric_limits<int>::max())
+	           ? size
+	           : std::numeric_limits<std::size_t>::max();
+}
+
+} // namespace
+
+EnvelopeArena::EnvelopeArena() : arena_(Options(block_, sizeof(block_))) {}
+
+google::protobuf::ArenaOptions EnvelopeArena::Options(char* block, std::size_t size) {
+	google::protobuf::ArenaOptions options;
+	options.initial_block = block;
+	options.initial_block_size = size;
+	return options;
+}
+
+bool SerializeToBuffer(const google::protobuf::MessageLite& message,
+                       webrtc::CopyOnWriteBuffer& buffer) {
+	const auto size = SerializedSize(message);
+	if (size == std::numeric_limits<std::size_t>::max()) {
+		return false;
+	}
+	buffer.Clear();
+	buffer.SetSize(size);
+	message.SerializeWithCachedSizesToArray(buffer.MutableData());
+	return true;
+}
+
+bool SerializeEncryptablePayload(const livekit::DataPacket& packet,
+                                 std::vector<std::uint8_t>& plaintext) {
+	EnvelopeArena arena;
+	auto* payload = google::protobuf::Arena::Create<livekit::EncryptedPacketPayload>(&arena.Get());
+	if (!LendPayload(packet, *payload)) {
+		return false;
+	}
+	const auto size = SerializedSize(*payload);
+	const bool serialized = size != std::numeric_limits<std::size_t>::max();
+	if (serialized) {
+		plaintext.resize(size);
+		payload->SerializeWithCachedSizesToArray(plaintext.data());
+	}
+	ReturnPayload(*payload);
+	return serialized;
+}
+
+livekit::DataPacket* CreateEncryptedEnvelope(const livekit::DataPacket& packet,
+                                             google::protobuf::Arena& arena) {
+	auto* envelope = google::protobuf::Arena::Create<livekit::DataPacket>(&arena);
+	envelope->set_kind(packet.kind());
+	envelope->set_participant_identity(packet.participant_identity());
+	envelope->set_participant_sid(packet.participant_sid());
+	envelope->mutable_destination_identities()->CopyFrom(packet.destination_identities());
+	envelope->set_sequence(packet.sequence());
+	envelope->mutable_encrypted_packet();
+	return envelope;
+}
+
+} // namespace core
+} // namespace livekit
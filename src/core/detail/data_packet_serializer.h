@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_DATA_PACKET_SERIALIZER_H_
+#define _LKC_CORE_DETAIL_DATA_PACKET_SERIALIZER_H_
+
+#include "livekit_models.pb.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+#include <google/protobuf/arena.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace livekit {
+namespace core {
+
+// A protobuf arena whose first block lives on the stack, so the wrapper messages and routing
+// strings built for one packet normally never reach the heap.
+class EnvelopeArena {
+public:
+	EnvelopeArena();
+	EnvelopeArena(const EnvelopeArena&) = delete;
+	EnvelopeArena& operator=(const EnvelopeArena&) = delete;
+
+	google::protobuf::Arena& Get() { return arena_; }
+
+private:
+	static google::protobuf::ArenaOptions Options(char* block, std::size_t size);
+
+	alignas(std::max_align_t) char block_[1024];
+	google::protobuf::Arena arena_;
+};
+
+// Serialises message straight into buffer. Callers keep one buffer per data channel: once the
+// transport has released the previous packet its storage is reused, otherwise Clear() detaches
+// without copying and a fresh block is allocated.
+bool SerializeToBuffer(const google::protobuf::MessageLite& message,
+                       webrtc::CopyOnWriteBuffer& buffer);
+
+// Writes the E2EE-protected part of packet as an EncryptedPacketPayload. The payload message is
+// lent to an arena-allocated wrapper for the duration of the call instead of being copied. Returns
+// false for packet kinds that are always sent in the clear.
+bool SerializeEncryptablePayload(const livekit::DataPacket& packet,
+                                 std::vector<std::uint8_t>& plaintext);
+
+// Creates an arena-owned packet with packet's routing fields and an empty encrypted_packet.
+livekit::DataPacket* CreateEncryptedEnvelope(const livekit::DataPacket& packet,
+                                             google::protobuf::Arena& arena);
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_DATA_PACKET_SERIALIZER_H_
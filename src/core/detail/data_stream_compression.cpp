@@ -20,7 +20,11 @@
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 namespace livekit {
 namespace core {
@@ -28,58 +32,317 @@ namespace detail {
 namespace {
 
 constexpr std::size_t kCompressionBufferSize = 16 * 1024;
+constexpr std::size_t kDeflateWindowSize = std::size_t{1} << MAX_WBITS;
+constexpr uint32_t kMaximumDeflateWorkers = 8;
+// A sync flush appends an empty stored block, which deflateBound does not count.
+constexpr std::size_t kSyncFlushMargin = 16;
 
-} // namespace
+int ZlibStrategy(DataStreamCompressionStrategy strategy) {
+	switch (strategy) {
+	case DataStreamCompressionStrategy::Filtered:
+		return Z_FILTERED;
+	case DataStreamCompressionStrategy::HuffmanOnly:
+		return Z_HUFFMAN_ONLY;
+	case DataStreamCompressionStrategy::Rle:
+		return Z_RLE;
+	case DataStreamCompressionStrategy::Default:
+		break;
+	}
+	return Z_DEFAULT_STRATEGY;
+}
 
-class DeflateRawStream::Impl {
+class Deflater {
 public:
-	Impl() {
+	explicit Deflater(const DataStreamCompressionOptions& options) {
 		stream_.zalloc = Z_NULL;
 		stream_.zfree = Z_NULL;
 		stream_.opaque = Z_NULL;
-		valid_ = deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
-		                      Z_DEFAULT_STRATEGY) == Z_OK;
+		valid_ = deflateInit2(&stream_, options.level, Z_DEFLATED, -MAX_WBITS, 8,
+		                      ZlibStrategy(options.strategy)) == Z_OK;
 	}
 
-	~Impl() {
+	~Deflater() {
 		if (valid_) {
 			deflateEnd(&stream_);
 		}
 	}
 
-	bool Write(const uint8_t* data, std::size_t size, int flush, std::vector<uint8_t>& output) {
-		if (!valid_ || finished_ || (data == nullptr && size != 0) ||
+	Deflater(const Deflater&) = delete;
+	Deflater& operator=(const Deflater&) = delete;
+
+	bool IsValid() const noexcept { return valid_; }
+
+	// Starts an independent block whose back-references may reach into dictionary.
+	bool Reset(const uint8_t* dictionary, std::size_t size) {
+		return deflateReset(&stream_) == Z_OK &&
+		       (size == 0 ||
+		        deflateSetDictionary(&stream_, dictionary, static_cast<uInt>(size)) == Z_OK);
+	}
+
+	// Deflates straight into the tail of output, growing it as needed. Returns the zlib result of
+	// the last call, or Z_STREAM_ERROR on failure.
+	int Write(const uint8_t* data, std::size_t size, int flush, std::vector<uint8_t>& output) {
+		if (!valid_ || (data == nullptr && size != 0) ||
 		    size > std::numeric_limits<uInt>::max()) {
-			return false;
+			return Z_STREAM_ERROR;
 		}
 		stream_.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(data));
 		stream_.avail_in = static_cast<uInt>(size);
-		std::array<uint8_t, kCompressionBufferSize> buffer{};
+		const auto start = output.size();
+		std::size_t written = 0;
+		output.resize(start + deflateBound(&stream_, static_cast<uLong>(size)) + kSyncFlushMargin);
 		int result = Z_OK;
 		do {
-			stream_.next_out = buffer.data();
-			stream_.avail_out = static_cast<uInt>(buffer.size());
+			if (start + written == output.size()) {
+				output.resize(output.size() + std::max(kCompressionBufferSize, written / 2));
+			}
+			const auto capacity = static_cast<uInt>(std::min<std::size_t>(
+			    output.size() - start - written, std::numeric_limits<uInt>::max()));
+			stream_.next_out = output.data() + start + written;
+			stream_.avail_out = capacity;
 			result = deflate(&stream_, flush);
+			written += capacity - stream_.avail_out;
+			if (result == Z_BUF_ERROR) {
+				// Nothing was left to flush.
+				result = Z_OK;
+				break;
+			}
 			if (result != Z_OK && result != Z_STREAM_END) {
-				return false;
+				output.resize(start);
+				return Z_STREAM_ERROR;
 			}
-			output.insert(output.end(), buffer.begin(), buffer.end() - stream_.avail_out);
 		} while (stream_.avail_in != 0 || stream_.avail_out == 0 ||
 		         (flush == Z_FINISH && result != Z_STREAM_END));
+		output.resize(start + written);
+		return result;
+	}
+
+private:
+	bool valid_ = false;
+	z_stream stream_{};
+};
+
+// Returns size input bytes from offset: a view into the input when it is in memory, otherwise
+// buffer filled by a read. nullptr when they cannot be read.
+using BlockSource = std::function<const uint8_t*(std::size_t offset, std::size_t size,
+                                                 std::vector<uint8_t>& buffer)>;
+
+uint32_t DeflateWorkerCount(const DataStreamCompressionOptions& options, std::size_t blocks) {
+	uint32_t workers = options.threads;
+	if (workers == 0) {
+		workers = std::min(std::max(std::thread::hardware_concurrency(), 1U),
+		                   kMaximumDeflateWorkers);
+	}
+	return static_cast<uint32_t>(std::min<std::size_t>(workers, blocks));
+}
+
+bool DeflateRawSerial(const BlockSource& source, std::size_t size,
+                      const DataStreamCompressionOptions& options,
+                      const DeflateBlockFunction& on_block) {
+	Deflater deflater(options);
+	if (!deflater.IsValid()) {
+		return false;
+	}
+	std::vector<uint8_t> input;
+	std::vector<uint8_t> output;
+	std::size_t offset = 0;
+	do {
+		const auto count = std::min(kParallelDeflateBlockSize, size - offset);
+		const bool last = offset + count == size;
+		const uint8_t* block = count == 0 ? nullptr : source(offset, count, input);
+		if (block == nullptr && count != 0) {
+			return false;
+		}
+		output.clear();
+		if (deflater.Write(block, count, last ? Z_FINISH : Z_NO_FLUSH, output) == Z_STREAM_ERROR) {
+			return false;
+		}
+		offset += count;
+		if (!on_block(output.data(), output.size(), offset)) {
+			return false;
+		}
+	} while (offset < size);
+	return true;
+}
+
+// Workers claim blocks in order and leave their output in a ring of window slots; the calling
+// thread hands slots out in order and frees them. A worker waits while its next block would land
+// in a slot that has not been handed out yet, which bounds memory to window blocks, plus one input
+// block per worker when the input is read rather than in memory.
+class ParallelDeflater {
+public:
+	ParallelDeflater(BlockSource source, std::size_t size,
+	                 const DataStreamCompressionOptions& options, uint32_t workers)
+	    : source_(std::move(source)), size_(size), options_(options),
+	      block_count_((size + kParallelDeflateBlockSize - 1) / kParallelDeflateBlockSize),
+	      slots_(std::size_t{workers} * 2) {
+		workers_.reserve(workers);
+		for (uint32_t index = 0; index < workers; ++index) {
+			workers_.emplace_back([this] { Run(); });
+		}
+	}
+
+	~ParallelDeflater() {
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+			stopped_ = true;
+		}
+		space_.notify_all();
+		for (auto& worker : workers_) {
+			worker.join();
+		}
+	}
+
+	bool Emit(const DeflateBlockFunction& on_block) {
+		for (std::size_t index = 0; index < block_count_; ++index) {
+			auto& slot = slots_[index % slots_.size()];
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				ready_.wait(lock, [&] { return slot.done; });
+				if (!slot.succeeded) {
+					return false;
+				}
+			}
+			// The slot is ours until emitted_ moves past it.
+			const auto input_end = std::min(size_, (index + 1) * kParallelDeflateBlockSize);
+			if (!on_block(slot.output.data(), slot.output.size(), input_end)) {
+				return false;
+			}
+			{
+				std::lock_guard<std::mutex> guard(mutex_);
+				slot.done = false;
+				++emitted_;
+			}
+			space_.notify_all();
+		}
+		return true;
+	}
+
+private:
+	struct Slot {
+		std::vector<uint8_t> output;
+		bool done = false;
+		bool succeeded = false;
+	};
+
+	void Run() {
+		Deflater deflater(options_);
+		std::vector<uint8_t> input;
+		std::vector<uint8_t> output;
+		for (;;) {
+			std::size_t index = 0;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				space_.wait(lock, [this] {
+					return stopped_ || next_block_ == block_count_ ||
+					       next_block_ < emitted_ + slots_.size();
+				});
+				if (stopped_ || next_block_ == block_count_) {
+					return;
+				}
+				index = next_block_++;
+				output = std::move(slots_[index % slots_.size()].output);
+			}
+			output.clear();
+			const auto offset = index * kParallelDeflateBlockSize;
+			const auto count = std::min(kParallelDeflateBlockSize, size_ - offset);
+			const auto dictionary = std::min(offset, kDeflateWindowSize);
+			const bool last = index + 1 == block_count_;
+			// The block and the window before it, which primes the dictionary.
+			const uint8_t* block = source_(offset - dictionary, dictionary + count, input);
+			const bool succeeded =
+			    block != nullptr && deflater.IsValid() && deflater.Reset(block, dictionary) &&
+			    deflater.Write(block + dictionary, count, last ? Z_FINISH : Z_SYNC_FLUSH, output) ==
+			        (last ? Z_STREAM_END : Z_OK);
+			{
+				std::lock_guard<std::mutex> guard(mutex_);
+				auto& slot = slots_[index % slots_.size()];
+				slot.output = std::move(output);
+				slot.succeeded = succeeded;
+				slot.done = true;
+			}
+			ready_.notify_one();
+		}
+	}
+
+	const BlockSource source_;
+	const std::size_t size_;
+	const DataStreamCompressionOptions options_;
+	const std::size_t block_count_;
+	std::mutex mutex_;
+	std::condition_variable ready_;
+	std::condition_variable space_;
+	std::vector<Slot> slots_;
+	std::size_t next_block_ = 0;
+	std::size_t emitted_ = 0;
+	bool stopped_ = false;
+	std::vector<std::thread> workers_;
+};
+
+bool DeflateRawBlocks(BlockSource source, std::size_t size,
+                      const DataStreamCompressionOptions& options,
+                      const DeflateBlockFunction& on_block) {
+	const auto blocks = std::max<std::size_t>(
+	    1, (size + kParallelDeflateBlockSize - 1) / kParallelDeflateBlockSize);
+	const auto workers = DeflateWorkerCount(options, blocks);
+	if (workers <= 1) {
+		return DeflateRawSerial(source, size, options, on_block);
+	}
+	ParallelDeflater deflater(std::move(source), size, options, workers);
+	return deflater.Emit(on_block);
+}
+
+} // namespace
+
+bool DeflateRawParallel(const uint8_t* data, std::size_t size,
+                        const DataStreamCompressionOptions& options,
+                        const DeflateBlockFunction& on_block) {
+	if ((data == nullptr && size != 0) || !on_block) {
+		return false;
+	}
+	return DeflateRawBlocks(
+	    [data](std::size_t offset, std::size_t, std::vector<uint8_t>&) { return data + offset; },
+	    size, options, on_block);
+}
+
+bool DeflateRawParallel(const DeflateReadFunction& read, uint64_t size,
+                        const DataStreamCompressionOptions& options,
+                        const DeflateBlockFunction& on_block) {
+	if (!read || !on_block || size > std::numeric_limits<std::size_t>::max()) {
+		return false;
+	}
+	return DeflateRawBlocks(
+	    [&read](std::size_t offset, std::size_t count,
+	            std::vector<uint8_t>& buffer) -> const uint8_t* {
+		    buffer.resize(count);
+		    return read(offset, buffer.data(), count) ? buffer.data() : nullptr;
+	    },
+	    static_cast<std::size_t>(size), options, on_block);
+}
+
+class DeflateRawStream::Impl {
+public:
+	explicit Impl(const DataStreamCompressionOptions& options) : deflater_(options) {}
+
+	bool Write(const uint8_t* data, std::size_t size, int flush, std::vector<uint8_t>& output) {
+		if (finished_) {
+			return false;
+		}
+		const auto result = deflater_.Write(data, size, flush, output);
 		if (result == Z_STREAM_END) {
 			finished_ = true;
 		}
-		return flush != Z_FINISH || finished_;
+		return result != Z_STREAM_ERROR && (flush != Z_FINISH || finished_);
 	}
 
-	bool valid_ = false;
+	Deflater deflater_;
 	bool finished_ = false;
-	z_stream stream_{};
 };
 
-DeflateRawStream::DeflateRawStream() : impl_(std::make_unique<Impl>()) {}
+DeflateRawStream::DeflateRawStream(const DataStreamCompressionOptions& options)
+    : impl_(std::make_unique<Impl>(options)) {}
 DeflateRawStream::~DeflateRawStream() = default;
-bool DeflateRawStream::IsValid() const noexcept { return impl_ && impl_->valid_; }
+bool DeflateRawStream::IsValid() const noexcept { return impl_ && impl_->deflater_.IsValid(); }
 
 bool DeflateRawStream::Write(const uint8_t* data, std::size_t size, std::vector<uint8_t>& output) {
 	return impl_ && impl_->Write(data, size, Z_SYNC_FLUSH, output);
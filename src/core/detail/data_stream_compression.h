@@ -19,8 +19,11 @@
 #ifndef _LKC_CORE_DETAIL_DATA_STREAM_COMPRESSION_H_
 #define _LKC_CORE_DETAIL_DATA_STREAM_COMPRESSION_H_
 
+#include "livekit/core/data_packet.h"
+
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -28,9 +31,13 @@ namespace livekit {
 namespace core {
 namespace detail {
 
+// Input bytes per independently compressed block of DeflateRawParallel.
+constexpr std::size_t kParallelDeflateBlockSize = 128 * 1024;
+
+// Each Write ends in a sync flush, so everything written so far can be inflated by the receiver.
 class DeflateRawStream {
 public:
-	DeflateRawStream();
+	explicit DeflateRawStream(const DataStreamCompressionOptions& options = {});
 	~DeflateRawStream();
 	DeflateRawStream(const DeflateRawStream&) = delete;
 	DeflateRawStream& operator=(const DeflateRawStream&) = delete;
@@ -44,6 +51,32 @@ private:
 	std::unique_ptr<Impl> impl_;
 };
 
+// Receives compressed output in input order; input_end is the input offset the block ends at.
+// Returning false stops compression.
+using DeflateBlockFunction =
+    std::function<bool(const uint8_t* data, std::size_t size, uint64_t input_end)>;
+
+// Compresses data into a single raw-deflate stream, pigz-style: blocks of kParallelDeflateBlockSize
+// are deflated on a set of workers, each primed with the 32 KiB of input before it and ended on a
+// byte boundary with a sync flush, so their concatenation inflates as one stream. A block goes to
+// on_block on the calling thread as soon as it and every block before it are done, and at most two
+// blocks per worker are held at once. Input of a single block, or a single worker, is compressed
+// on the calling thread.
+bool DeflateRawParallel(const uint8_t* data, std::size_t size,
+                        const DataStreamCompressionOptions& options,
+                        const DeflateBlockFunction& on_block);
+
+// Fills buffer with size input bytes from offset; returns false when they cannot be read.
+using DeflateReadFunction =
+    std::function<bool(uint64_t offset, uint8_t* buffer, std::size_t size)>;
+
+// DeflateRawParallel for input that is not in memory. Each worker reads its block, together with
+// the 32 KiB before it for the dictionary, through read, so read is called from several threads
+// at once; memory is bounded by the blocks in flight, not by size. Fails when a read fails.
+bool DeflateRawParallel(const DeflateReadFunction& read, uint64_t size,
+                        const DataStreamCompressionOptions& options,
+                        const DeflateBlockFunction& on_block);
+
 class InflateRawStream {
 public:
 	explicit InflateRawStream(uint64_t maximum_output_size);
@@ -17,7 +17,9 @@
 
 #include "debouncer.h"
 
+#include <algorithm>
 #include <stdexcept>
+#include <utility>
 
 namespace livekit {
 namespace core {
@@ -39,6 +41,52 @@ bool Debouncer::lock() {
 	return true;
 }
 
+bool Debouncer::defer(std::function<void()> function) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (cancelled_ || deferred_ != 0) {
+		return false;
+	}
+	auto delay = std::chrono::milliseconds::zero();
+	if (last_time_) {
+		const auto remaining = *last_time_ + interval_ - std::chrono::steady_clock::now();
+		delay = std::max(delay, std::chrono::ceil<std::chrono::milliseconds>(remaining));
+	}
+	auto deferred = [this, function = std::move(function)] {
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+			if (cancelled_) {
+				return;
+			}
+			// Cleared before the call, so the call itself or another thread can defer the next one.
+			deferred_ = 0;
+			running_ = true;
+			running_thread_ = std::this_thread::get_id();
+		}
+		function();
+		std::lock_guard<std::mutex> guard(mutex_);
+		running_ = false;
+		idle_.notify_all();
+	};
+	deferred_ = detail::TimerWheel::Shared().Schedule(delay, std::move(deferred));
+	return true;
+}
+
+void Debouncer::cancel() {
+	detail::TimerWheel::TimerId deferred = 0;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		cancelled_ = true;
+		deferred = std::exchange(deferred_, 0);
+	}
+	detail::TimerWheel::Shared().Cancel(deferred);
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (running_thread_ != std::this_thread::get_id()) {
+		idle_.wait(lock, [this] { return !running_; });
+	}
+}
+
+Debouncer::~Debouncer() { cancel(); }
+
 std::unique_ptr<Debouncer> Debouncer::Create(std::chrono::milliseconds interval) {
 	return std::unique_ptr<Debouncer>(new Debouncer(interval));
 }
@@ -20,10 +20,15 @@
 #ifndef _LKC_CORE_CONVERTED_DEBOUNCER_H_
 #define _LKC_CORE_CONVERTED_DEBOUNCER_H_
 
+#include "timer_wheel.h"
+
 #include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 
 namespace livekit {
 namespace core {
@@ -33,7 +38,14 @@ public:
 	static std::unique_ptr<Debouncer> Create(std::chrono::milliseconds interval);
 
 	bool lock();
+	// Runs function on the shared timer thread once the current interval ends, right away when
+	// none is running. Returns false while an earlier deferred call has not started yet.
+	bool defer(std::function<void()> function);
+	// Drops a deferred call that has not started and waits for one that has, unless called from
+	// it. Later defer() calls are refused. Also done by the destructor.
+	void cancel();
 
+	~Debouncer();
 	Debouncer(const Debouncer&) = delete;
 	Debouncer& operator=(const Debouncer&) = delete;
 	Debouncer(Debouncer&&) = delete;
@@ -45,6 +57,11 @@ private:
 	std::chrono::milliseconds interval_;
 	std::mutex mutex_;
 	std::optional<std::chrono::steady_clock::time_point> last_time_;
+	detail::TimerWheel::TimerId deferred_ = 0;
+	bool cancelled_ = false;
+	bool running_ = false;
+	std::thread::id running_thread_;
+	std::condition_variable idle_;
 };
 
 } // namespace core
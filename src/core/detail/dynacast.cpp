@@ -0,0 +1,288 @@
+#include "dynacast.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace livekit {
+namespace core {
+namespace {
+
+double Seconds(std::chrono::steady_clock::duration duration) {
+	return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+DynacastController::DynacastController(std::chrono::milliseconds pause_delay, ApplyFunction apply,
+                                       SampleFunction sample)
+    : pause_delay_(pause_delay), apply_(std::move(apply)), sample_(std::move(sample)) {}
+
+DynacastController::~DynacastController() {
+	detail::TimerWheel::TimerId pause_timer = 0;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		stopping_ = true;
+		pause_timer = pause_timer_;
+	}
+	detail::TimerWheel::Shared().Cancel(pause_timer);
+	pause_worker_.Stop();
+}
+
+void DynacastController::Update(const std::string& track_sid, const LayerMap& requested) {
+	// Preview the update to learn whether a sample is needed: the first update of a track sets
+	// its baseline, and every transition measures from one.
+	EncodeTimes encode;
+	if (sample_) {
+		bool needs_sample = false;
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+			const auto now = Clock::now();
+			auto found = tracks_.find(track_sid);
+			Track preview = found != tracks_.end() ? found->second : Track{};
+			Request(preview, requested, now, {});
+			LayerMap target;
+			needs_sample = found == tracks_.end() || Target(preview, now, target);
+		}
+		if (needs_sample) {
+			encode = sample_(track_sid);
+		}
+	}
+	std::lock_guard<std::mutex> apply_guard(apply_mutex_);
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		Request(tracks_[track_sid], requested, Clock::now(), encode);
+		if (pause_delay_.count() > 0) {
+			SchedulePausesLocked();
+		}
+	}
+	ApplyTrack(track_sid, encode);
+}
+
+void DynacastController::Reset() {
+	std::vector<std::string> track_sids;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (auto& [track_sid, track] : tracks_) {
+			for (auto& [quality, layer] : track.layers) {
+				layer.requested = true;
+				layer.pause_at.reset();
+			}
+			track_sids.push_back(track_sid);
+		}
+	}
+	const auto samples = SampleChanging(track_sids);
+	std::lock_guard<std::mutex> apply_guard(apply_mutex_);
+	for (const auto& track_sid : track_sids) {
+		const auto sample = samples.find(track_sid);
+		ApplyTrack(track_sid, sample != samples.end() ? sample->second : EncodeTimes{});
+	}
+}
+
+void DynacastController::Remove(const std::string& track_sid) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	tracks_.erase(track_sid);
+}
+
+void DynacastController::Clear() {
+	std::lock_guard<std::mutex> guard(mutex_);
+	tracks_.clear();
+}
+
+std::vector<DynacastLayerStats> DynacastController::Layers(const std::string& track_sid) const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto found = tracks_.find(track_sid);
+	if (found == tracks_.end()) {
+		return {};
+	}
+	const auto now = Clock::now();
+	std::vector<DynacastLayerStats> result;
+	result.reserve(found->second.layers.size());
+	for (const auto& [quality, layer] : found->second.layers) {
+		auto paused = layer.paused_total;
+		double saved = layer.encode_seconds_saved;
+		if (!layer.active) {
+			const auto current = now - layer.paused_since;
+			paused += current;
+			saved += layer.encode_rate.value_or(0.0) * Seconds(current);
+		}
+		DynacastLayerStats stats;
+		stats.quality = quality;
+		stats.active = layer.active;
+		stats.pause_pending = layer.pause_at.has_value();
+		stats.pauses = layer.pauses;
+		stats.paused_ms = static_cast<uint64_t>(
+		    std::chrono::duration_cast<std::chrono::milliseconds>(paused).count());
+		stats.encode_seconds_saved = saved;
+		result.push_back(stats);
+	}
+	return result;
+}
+
+void DynacastController::Request(Track& track, const LayerMap& requested, Clock::time_point now,
+                                 const EncodeTimes& encode) const {
+	for (const auto& [quality, enabled] : requested) {
+		auto [found, inserted] = track.layers.try_emplace(quality);
+		auto& layer = found->second;
+		if (inserted) {
+			layer.active_since = now;
+			if (auto seconds = encode.find(quality); seconds != encode.end()) {
+				layer.encode_seconds_at_activation = seconds->second;
+			}
+		}
+		layer.requested = enabled;
+		if (enabled) {
+			layer.pause_at.reset();
+		} else if (layer.active && !layer.pause_at) {
+			layer.pause_at = now + pause_delay_;
+		}
+	}
+}
+
+bool DynacastController::Target(const Track& track, Clock::time_point now, LayerMap& target) {
+	bool changed = false;
+	for (const auto& [quality, layer] : track.layers) {
+		const bool held = layer.active && layer.pause_at && now < *layer.pause_at;
+		const bool active = layer.requested || held;
+		target[quality] = active;
+		changed = changed || active != layer.active;
+	}
+	return changed;
+}
+
+std::map<std::string, DynacastController::EncodeTimes>
+DynacastController::SampleChanging(const std::vector<std::string>& track_sids) {
+	std::map<std::string, EncodeTimes> samples;
+	if (!sample_) {
+		return samples;
+	}
+	std::vector<std::string> changing;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		const auto now = Clock::now();
+		for (const auto& track_sid : track_sids) {
+			auto found = tracks_.find(track_sid);
+			LayerMap target;
+			if (found != tracks_.end() && Target(found->second, now, target)) {
+				changing.push_back(track_sid);
+			}
+		}
+	}
+	for (const auto& track_sid : changing) {
+		samples.emplace(track_sid, sample_(track_sid));
+	}
+	return samples;
+}
+
+void DynacastController::ApplyTrack(const std::string& track_sid, const EncodeTimes& encode) {
+	LayerMap target;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		auto found = tracks_.find(track_sid);
+		if (found == tracks_.end() || !Target(found->second, Clock::now(), target)) {
+			return;
+		}
+	}
+	const bool applied = apply_(track_sid, target);
+
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto found = tracks_.find(track_sid);
+	if (found == tracks_.end()) {
+		return;
+	}
+	const auto now = Clock::now();
+	for (auto& [quality, layer] : found->second.layers) {
+		auto wanted = target.find(quality);
+		if (wanted == target.end() || wanted->second == layer.active) {
+			continue;
+		}
+		if (!applied) {
+			// A rejected activation is retried by the next update; a rejected pause after a
+			// further hold, or by the next update when there is no hold.
+			if (!wanted->second) {
+				layer.pause_at = pause_delay_.count() > 0
+				                     ? std::optional<Clock::time_point>(now + pause_delay_)
+				                     : std::nullopt;
+			}
+			continue;
+		}
+		const auto seconds = encode.find(quality);
+		if (wanted->second) {
+			const auto paused = now - layer.paused_since;
+			layer.paused_total += paused;
+			layer.encode_seconds_saved += layer.encode_rate.value_or(0.0) * Seconds(paused);
+			layer.active = true;
+			layer.active_since = now;
+			layer.encode_seconds_at_activation =
+			    seconds != encode.end() ? std::optional<double>(seconds->second) : std::nullopt;
+		} else {
+			const double active_seconds = Seconds(now - layer.active_since);
+			if (seconds != encode.end() && layer.encode_seconds_at_activation &&
+			    active_seconds > 0.0) {
+				layer.encode_rate =
+				    std::max(0.0, seconds->second - *layer.encode_seconds_at_activation) /
+				    active_seconds;
+			}
+			layer.active = false;
+			layer.pause_at.reset();
+			layer.paused_since = now;
+			++layer.pauses;
+		}
+	}
+}
+
+std::optional<DynacastController::Clock::time_point> DynacastController::NextPauseLocked() const {
+	std::optional<Clock::time_point> next;
+	for (const auto& [track_sid, track] : tracks_) {
+		for (const auto& [quality, layer] : track.layers) {
+			if (layer.pause_at && (!next || *layer.pause_at < *next)) {
+				next = layer.pause_at;
+			}
+		}
+	}
+	return next;
+}
+
+void DynacastController::SchedulePausesLocked() {
+	const auto next = NextPauseLocked();
+	if (stopping_ || pause_timer_ != 0 || !next) {
+		return;
+	}
+	const auto delay = std::max(std::chrono::ceil<std::chrono::milliseconds>(*next - Clock::now()),
+	                            std::chrono::milliseconds::zero());
+	// The wheel thread runs every room's timers; leave the blocking work to pause_worker_.
+	pause_timer_ = detail::TimerWheel::Shared().Schedule(
+	    delay, [this] { pause_worker_.Post([this] { ApplyDuePauses(); }); });
+}
+
+void DynacastController::ApplyDuePauses() {
+	std::vector<std::string> due;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (stopping_) {
+			return;
+		}
+		const auto now = Clock::now();
+		for (const auto& [track_sid, track] : tracks_) {
+			for (const auto& [quality, layer] : track.layers) {
+				if (layer.pause_at && *layer.pause_at <= now) {
+					due.push_back(track_sid);
+					break;
+				}
+			}
+		}
+	}
+	{
+		const auto samples = SampleChanging(due);
+		std::lock_guard<std::mutex> apply_guard(apply_mutex_);
+		for (const auto& track_sid : due) {
+			const auto sample = samples.find(track_sid);
+			ApplyTrack(track_sid, sample != samples.end() ? sample->second : EncodeTimes{});
+		}
+	}
+	std::lock_guard<std::mutex> guard(mutex_);
+	pause_timer_ = 0;
+	SchedulePausesLocked();
+}
+
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_DYNACAST_H_
+#define _LKC_CORE_DETAIL_DYNACAST_H_
+
+#include "livekit/core/option/media_option.h"
+#include "livekit/core/track/subscribed_quality.h"
+#include "stream_reassembly.h"
+#include "timer_wheel.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace core {
+
+// Turns the layers subscribers request for each published video track into encoder activation.
+// Layers that become requested are activated at once; layers that stop being requested are held
+// for pause_delay and only then paused, so a subscriber flipping between qualities does not make
+// the encoder restart a layer. Every change to a track's layers leaves in one apply() call. A
+// timer on the shared TimerWheel marks when pauses fall due; sample() and apply() may block, so
+// the timer only posts the pauses to the controller's own task runner, which applies them.
+class DynacastController {
+public:
+	using LayerMap = std::map<VideoQuality, bool>;
+	// Sets the activation of every listed layer of the track at once. Returns false when the
+	// sender rejected the change or is gone; the previous activation is then kept.
+	using ApplyFunction = std::function<bool(const std::string& track_sid, const LayerMap& active)>;
+	using EncodeTimes = std::map<VideoQuality, double>;
+	// Returns the encoder's cumulative busy time in seconds per layer, or an empty map when stats
+	// are unavailable. Only called around layer transitions, and never with a lock held, since
+	// collecting stats may block.
+	using SampleFunction = std::function<EncodeTimes(const std::string& track_sid)>;
+
+	DynacastController(std::chrono::milliseconds pause_delay, ApplyFunction apply,
+	                   SampleFunction sample);
+	// Cancels the pause timer and stops the task runner, waiting for pauses being applied. Pauses
+	// still pending are dropped and their layers stay active.
+	~DynacastController();
+
+	DynacastController(const DynacastController&) = delete;
+	DynacastController& operator=(const DynacastController&) = delete;
+
+	// Layers missing from requested keep their previous request.
+	void Update(const std::string& track_sid, const LayerMap& requested);
+	// Requests and activates every known layer. Used when the subscriber view may be stale.
+	void Reset();
+	// Forgets a track once it is unpublished, without touching its sender.
+	void Remove(const std::string& track_sid);
+	// Forgets every track, for when all senders are being replaced.
+	void Clear();
+	std::vector<DynacastLayerStats> Layers(const std::string& track_sid) const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Layer {
+		bool requested = true;
+		bool active = true;
+		std::optional<Clock::time_point> pause_at;
+		Clock::time_point active_since;
+		std::optional<double> encode_seconds_at_activation;
+		std::optional<double> encode_rate;
+		Clock::time_point paused_since;
+		Clock::duration paused_total{};
+		uint32_t pauses = 0;
+		double encode_seconds_saved = 0.0;
+	};
+
+	struct Track {
+		std::map<VideoQuality, Layer> layers;
+	};
+
+	// Records a subscriber request on track. Layers seen for the first time take their encoder
+	// time baseline from encode.
+	void Request(Track& track, const LayerMap& requested, Clock::time_point now,
+	             const EncodeTimes& encode) const;
+	// Fills target with the activation the track's layers should have at now and returns whether
+	// it differs from what the sender has.
+	static bool Target(const Track& track, Clock::time_point now, LayerMap& target);
+	// Samples the tracks whose activation is due to change. Takes neither lock across sample().
+	std::map<std::string, EncodeTimes> SampleChanging(const std::vector<std::string>& track_sids);
+	// Applies the activation the track's layers should have now, if it differs from what the
+	// sender has. encode is the caller's sample from before apply_mutex_ was taken. Requires
+	// apply_mutex_.
+	void ApplyTrack(const std::string& track_sid, const EncodeTimes& encode);
+	std::optional<Clock::time_point> NextPauseLocked() const;
+	// Schedules the pause timer for the earliest pending pause unless it is already scheduled.
+	// Pauses are only ever set pause_delay_ from now, so a scheduled timer is never late for them.
+	void SchedulePausesLocked();
+	// Runs on pause_worker_ once the pause timer fires: applies the pauses that are due, then
+	// schedules the next one.
+	void ApplyDuePauses();
+
+	const std::chrono::milliseconds pause_delay_;
+	const ApplyFunction apply_;
+	const SampleFunction sample_;
+
+	// apply_mutex_ is taken before mutex_ and held across apply() so activations never overtake.
+	std::mutex apply_mutex_;
+	mutable std::mutex mutex_;
+	std::map<std::string, Track> tracks_;
+	bool stopping_ = false;
+	// Held until ApplyDuePauses() finishes, so the timer is never scheduled twice.
+	detail::TimerWheel::TimerId pause_timer_ = 0;
+	detail::SerialTaskRunner pause_worker_;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_DYNACAST_H_
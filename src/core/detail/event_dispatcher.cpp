@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_dispatcher.h"
+
+#include <algorithm>
+#include <future>
+#include <utility>
+
+namespace livekit {
+namespace core {
+namespace detail {
+namespace {
+
+uint64_t ElapsedMicroseconds(std::chrono::steady_clock::time_point from,
+                             std::chrono::steady_clock::time_point to) {
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+	return static_cast<uint64_t>(std::max<int64_t>(0, elapsed));
+}
+
+} // namespace
+
+EventDispatcher::EventDispatcher(const EventDispatchOptions& options) {
+	ApplyOptions(*state_, options);
+}
+
+EventDispatcher::~EventDispatcher() { Stop(); }
+
+void EventDispatcher::Configure(const EventDispatchOptions& options) {
+	std::lock_guard<std::mutex> guard(state_->mutex);
+	ApplyOptions(*state_, options);
+}
+
+bool EventDispatcher::Post(EventCategory category, std::function<void()> callback,
+                           std::string coalesce_key, bool lossy) {
+	const auto index = static_cast<std::size_t>(category);
+	if (!callback || index >= kEventCategoryCount) {
+		return false;
+	}
+	auto& state = *state_;
+	std::unique_lock<std::mutex> lock(state.mutex);
+	if (state.stopping) {
+		return false;
+	}
+	if (!state.enabled) {
+		lock.unlock();
+		callback();
+		return true;
+	}
+	auto& queue = state.queues[index];
+	if (queue.options.overflow == EventOverflowPolicy::Coalesce && !coalesce_key.empty()) {
+		const auto queued =
+		    std::find_if(queue.events.begin(), queue.events.end(),
+		                 [&](const Event& event) { return event.coalesce_key == coalesce_key; });
+		if (queued != queue.events.end()) {
+			// Keep the queued event's place and age; only its content is stale.
+			std::swap(queued->callback, callback);
+			++queue.stats.coalesced;
+			lock.unlock();
+			return true;
+		}
+	}
+	// Producers are the network and signaling threads, so they never wait. Only lossy events are
+	// shed; any other event is queued past the capacity.
+	if (queue.options.overflow != EventOverflowPolicy::Grow &&
+	    queue.events.size() >= std::max<uint32_t>(queue.options.capacity, 1)) {
+		const auto oldest_lossy = std::find_if(queue.events.begin(), queue.events.end(),
+		                                       [](const Event& event) { return event.lossy; });
+		if (oldest_lossy != queue.events.end()) {
+			queue.events.erase(oldest_lossy);
+			++queue.stats.dropped;
+		} else if (lossy) {
+			++queue.stats.dropped;
+			return false;
+		}
+	}
+	queue.events.push_back({std::move(callback), std::move(coalesce_key), lossy, Clock::now()});
+	queue.stats.max_depth =
+	    std::max(queue.stats.max_depth, static_cast<uint32_t>(queue.events.size()));
+	if (!worker_.joinable()) {
+		worker_ = std::thread([state = state_] { Run(state); });
+	}
+	lock.unlock();
+	state.wake.notify_one();
+	return true;
+}
+
+void EventDispatcher::WaitForRunningCallbacks() {
+	std::unique_lock<std::mutex> lock(state_->mutex);
+	if (worker_.get_id() == std::this_thread::get_id()) {
+		return;
+	}
+	const auto started = state_->started;
+	state_->progress.wait(lock, [&] { return state_->finished >= started; });
+}
+
+void EventDispatcher::Flush() {
+	auto delivered = std::make_shared<std::promise<void>>();
+	auto done = delivered->get_future();
+	{
+		std::lock_guard<std::mutex> guard(state_->mutex);
+		if (state_->stopping || !worker_.joinable() ||
+		    worker_.get_id() == std::this_thread::get_id()) {
+			return;
+		}
+		// The speakers queue is delivered last, so the marker runs after every event queued before
+		// it. It bypasses the capacity so that it never displaces an event.
+		state_->queues[static_cast<std::size_t>(EventCategory::Speakers)].events.push_back(
+		    {[delivered] { delivered->set_value(); }, {}, false, Clock::now()});
+	}
+	state_->wake.notify_one();
+	done.wait();
+}
+
+void EventDispatcher::Stop() {
+	std::thread worker;
+	std::array<Queue, kEventCategoryCount> dropped;
+	bool from_callback = false;
+	{
+		std::lock_guard<std::mutex> guard(state_->mutex);
+		state_->stopping = true;
+		from_callback = worker_.get_id() == std::this_thread::get_id();
+		if (from_callback) {
+			state_->stopped = true;
+			for (std::size_t index = 0; index < kEventCategoryCount; ++index) {
+				dropped[index].events.swap(state_->queues[index].events);
+			}
+		}
+		worker.swap(worker_);
+	}
+	state_->wake.notify_all();
+	state_->progress.notify_all();
+	if (!worker.joinable()) {
+		return;
+	}
+	if (from_callback) {
+		worker.detach();
+	} else {
+		worker.join();
+	}
+}
+
+EventDispatchStats EventDispatcher::Stats() const {
+	std::lock_guard<std::mutex> guard(state_->mutex);
+	const auto stats = [this](EventCategory category) {
+		const auto& queue = state_->queues[static_cast<std::size_t>(category)];
+		auto result = queue.stats;
+		result.depth = static_cast<uint32_t>(queue.events.size());
+		return result;
+	};
+	return {stats(EventCategory::Connection), stats(EventCategory::Media),
+	        stats(EventCategory::Data), stats(EventCategory::Speakers)};
+}
+
+void EventDispatcher::Run(const std::shared_ptr<State>& state) {
+	std::unique_lock<std::mutex> lock(state->mutex);
+	for (;;) {
+		Queue* queue = nullptr;
+		state->wake.wait(lock, [&] {
+			for (auto& candidate : state->queues) {
+				if (!candidate.events.empty()) {
+					queue = &candidate;
+					break;
+				}
+			}
+			return queue != nullptr || state->stopping;
+		});
+		if (state->stopped || queue == nullptr) {
+			return;
+		}
+		auto event = std::move(queue->events.front());
+		queue->events.pop_front();
+		const auto started = Clock::now();
+		const auto wait_us = ElapsedMicroseconds(event.posted, started);
+		queue->stats.total_wait_us += wait_us;
+		queue->stats.max_wait_us = std::max(queue->stats.max_wait_us, wait_us);
+		++queue->stats.dispatched;
+		++state->started;
+		lock.unlock();
+		state->progress.notify_all();
+		event.callback();
+		// Release what the callback captured before taking the next event.
+		event.callback = nullptr;
+		const auto callback_us = ElapsedMicroseconds(started, Clock::now());
+		lock.lock();
+		queue->stats.max_callback_us = std::max(queue->stats.max_callback_us, callback_us);
+		++state->finished;
+		state->progress.notify_all();
+	}
+}
+
+void EventDispatcher::ApplyOptions(State& state, const EventDispatchOptions& options) {
+	state.enabled = options.enabled;
+	state.queues[static_cast<std::size_t>(EventCategory::Connection)].options = options.connection;
+	state.queues[static_cast<std::size_t>(EventCategory::Media)].options = options.media;
+	state.queues[static_cast<std::size_t>(EventCategory::Data)].options = options.data;
+	state.queues[static_cast<std::size_t>(EventCategory::Speakers)].options = options.speakers;
+}
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_EVENT_DISPATCHER_H_
+#define _LKC_CORE_DETAIL_EVENT_DISPATCHER_H_
+
+#include "livekit/core/option/room_option.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+constexpr std::size_t kEventCategoryCount = 4;
+
+// Delivers events on one thread, started with the first event, from a queue per EventCategory.
+// Each time the thread is free it takes the oldest event of the highest-priority category that has
+// one. Post() never waits: a full queue sheds a lossy event by its overflow policy, and queues any
+// other event past its capacity.
+class EventDispatcher {
+public:
+	explicit EventDispatcher(const EventDispatchOptions& options = {});
+	~EventDispatcher();
+	EventDispatcher(const EventDispatcher&) = delete;
+	EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+	// Applies to events posted afterwards; events already queued keep their place.
+	void Configure(const EventDispatchOptions& options);
+	// Queues callback, or runs it right away when dispatch is disabled. coalesce_key names the
+	// subject of an update that a later one may replace; lossy marks an event a full queue may
+	// drop, and no other event is ever dropped. Returns false when the event was dropped or the
+	// dispatcher is stopped.
+	bool Post(EventCategory category, std::function<void()> callback,
+	          std::string coalesce_key = {}, bool lossy = false);
+	// Waits until callbacks started before the call have returned. Returns at once on the
+	// dispatch thread.
+	void WaitForRunningCallbacks();
+	// Waits until the events queued before the call have been delivered. Returns at once on the
+	// dispatch thread.
+	void Flush();
+	// Delivers the events already queued, then stops the thread; later posts are rejected. When
+	// called from a callback, queued events are dropped and the thread finishes on its own.
+	void Stop();
+	EventDispatchStats Stats() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Event {
+		std::function<void()> callback;
+		std::string coalesce_key;
+		bool lossy = false;
+		Clock::time_point posted;
+	};
+	struct Queue {
+		EventQueueOptions options;
+		std::deque<Event> events;
+		EventQueueStats stats;
+	};
+	// Shared with the thread, which may outlive the dispatcher when Stop() is called from a
+	// callback.
+	struct State {
+		mutable std::mutex mutex;
+		std::condition_variable wake;
+		// Signalled when a callback starts or returns.
+		std::condition_variable progress;
+		std::array<Queue, kEventCategoryCount> queues;
+		bool enabled = true;
+		bool stopping = false;
+		bool stopped = false;
+		uint64_t started = 0;
+		uint64_t finished = 0;
+	};
+
+	static void Run(const std::shared_ptr<State>& state);
+	static void ApplyOptions(State& state, const EventDispatchOptions& options);
+
+	std::shared_ptr<State> state_ = std::make_shared<State>();
+	// Guarded by state_->mutex, so Stop() cannot miss a thread started by a concurrent Post().
+	std::thread worker_;
+};
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_EVENT_DISPATCHER_H_
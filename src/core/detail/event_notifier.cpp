@@ -0,0 +1,92 @@
+#include "event_notifier.h"
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+
+namespace livekit {
+namespace core {
+
+EventNotifier::EventNotifier() {
+#if defined(__linux__)
+	read_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	write_fd_ = read_fd_;
+#elif defined(_WIN32)
+	event_ = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+#else
+	int fds[2] = {-1, -1};
+	if (::pipe(fds) == 0) {
+		for (int fd : fds) {
+			::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+			::fcntl(fd, F_SETFD, FD_CLOEXEC);
+		}
+		read_fd_ = fds[0];
+		write_fd_ = fds[1];
+	}
+#endif
+}
+
+EventNotifier::~EventNotifier() {
+#if defined(_WIN32)
+	if (event_ != nullptr) {
+		CloseHandle(static_cast<HANDLE>(event_));
+	}
+#else
+	if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+		::close(write_fd_);
+	}
+	if (read_fd_ >= 0) {
+		::close(read_fd_);
+	}
+#endif
+}
+
+void EventNotifier::Set() {
+#if defined(__linux__)
+	if (write_fd_ >= 0) {
+		const uint64_t value = 1;
+		[[maybe_unused]] const auto written = ::write(write_fd_, &value, sizeof(value));
+	}
+#elif defined(_WIN32)
+	if (event_ != nullptr) {
+		SetEvent(static_cast<HANDLE>(event_));
+	}
+#else
+	if (write_fd_ >= 0) {
+		const char token = 1;
+		[[maybe_unused]] const auto written = ::write(write_fd_, &token, sizeof(token));
+	}
+#endif
+}
+
+void EventNotifier::Reset() {
+#if defined(__linux__)
+	if (read_fd_ >= 0) {
+		uint64_t value = 0;
+		[[maybe_unused]] const auto read = ::read(read_fd_, &value, sizeof(value));
+	}
+#elif defined(_WIN32)
+	if (event_ != nullptr) {
+		ResetEvent(static_cast<HANDLE>(event_));
+	}
+#else
+	if (read_fd_ >= 0) {
+		char token = 0;
+		[[maybe_unused]] const auto read = ::read(read_fd_, &token, sizeof(token));
+	}
+#endif
+}
+
+} // namespace core
+} // namespace livekit
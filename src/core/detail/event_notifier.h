@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_EVENT_NOTIFIER_H_
+#define _LKC_CORE_DETAIL_EVENT_NOTIFIER_H_
+
+namespace livekit {
+namespace core {
+
+// A level-triggered, pollable readiness flag: an eventfd on Linux, a non-blocking pipe on other
+// POSIX systems and a manual-reset event on Windows. Set() and Reset() must be serialized by the
+// caller and only called on transitions, which keeps at most one pending token in the descriptor.
+class EventNotifier {
+public:
+	EventNotifier();
+	~EventNotifier();
+
+	EventNotifier(const EventNotifier&) = delete;
+	EventNotifier& operator=(const EventNotifier&) = delete;
+
+	// -1 on Windows, or when the descriptor could not be created.
+	int Fd() const { return read_fd_; }
+	// The event HANDLE on Windows; nullptr elsewhere, or when the event could not be created.
+	void* Handle() const { return event_; }
+	void Set();
+	void Reset();
+
+private:
+	int read_fd_ = -1;
+	int write_fd_ = -1;
+	void* event_ = nullptr;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_EVENT_NOTIFIER_H_
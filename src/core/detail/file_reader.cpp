@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_reader.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _WIN32
+#include <filesystem>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+#ifdef _WIN32
+
+std::unique_ptr<FileReader> FileReader::Open(const std::string& path) {
+	const HANDLE file =
+	    CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ,
+	                nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart < 0) {
+		CloseHandle(file);
+		return nullptr;
+	}
+	std::unique_ptr<FileReader> result(new FileReader());
+	result->file_ = file;
+	result->size_ = static_cast<uint64_t>(size.QuadPart);
+	return result;
+}
+
+FileReader::~FileReader() { CloseHandle(static_cast<HANDLE>(file_)); }
+
+bool FileReader::ReadAt(uint64_t offset, uint8_t* buffer, std::size_t size) const {
+	while (size != 0) {
+		OVERLAPPED position{};
+		position.Offset = static_cast<DWORD>(offset);
+		position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+		const auto request = static_cast<DWORD>(
+		    std::min<std::size_t>(size, std::numeric_limits<DWORD>::max()));
+		DWORD read = 0;
+		if (!ReadFile(static_cast<HANDLE>(file_), buffer, request, &read, &position) || read == 0) {
+			return false;
+		}
+		offset += read;
+		buffer += read;
+		size -= read;
+	}
+	return true;
+}
+
+#else
+
+std::unique_ptr<FileReader> FileReader::Open(const std::string& path) {
+	const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file < 0) {
+		return nullptr;
+	}
+	struct stat status{};
+	if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size < 0) {
+		close(file);
+		return nullptr;
+	}
+#ifdef POSIX_FADV_SEQUENTIAL
+	// Readahead then stays ahead of a front-to-back reader.
+	posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+	std::unique_ptr<FileReader> result(new FileReader());
+	result->file_ = file;
+	result->size_ = static_cast<uint64_t>(status.st_size);
+	return result;
+}
+
+FileReader::~FileReader() { close(file_); }
+
+bool FileReader::ReadAt(uint64_t offset, uint8_t* buffer, std::size_t size) const {
+	while (size != 0) {
+		if (offset > static_cast<uint64_t>(std::numeric_limits<off_t>::max())) {
+			return false;
+		}
+		const auto request = std::min<std::size_t>(size, std::numeric_limits<ssize_t>::max());
+		const ssize_t read = pread(file_, buffer, request, static_cast<off_t>(offset));
+		if (read < 0 && errno == EINTR) {
+			continue;
+		}
+		if (read <= 0) {
+			return false;
+		}
+		offset += static_cast<uint64_t>(read);
+		buffer += read;
+		size -= static_cast<std::size_t>(read);
+	}
+	return true;
+}
+
+#endif
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_FILE_READER_H_
+#define _LKC_CORE_DETAIL_FILE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+// A read-only file read at explicit offsets, so one sender can walk it block by block without a
+// shared file position. Reads copy into the caller's buffer rather than mapping the file: a file
+// truncated while it is being sent then fails a read instead of faulting the process.
+class FileReader {
+public:
+	// Returns nullptr when the file cannot be opened or is not a regular file.
+	static std::unique_ptr<FileReader> Open(const std::string& path);
+	~FileReader();
+	FileReader(const FileReader&) = delete;
+	FileReader& operator=(const FileReader&) = delete;
+
+	// The size when the file was opened.
+	uint64_t Size() const noexcept { return size_; }
+	// Fills buffer with size bytes from offset. Returns false on an I/O error or when the file
+	// ends before offset + size, as it does once the file has been truncated.
+	bool ReadAt(uint64_t offset, uint8_t* buffer, std::size_t size) const;
+
+private:
+	FileReader() = default;
+
+	uint64_t size_ = 0;
+#ifdef _WIN32
+	void* file_ = nullptr;
+#else
+	int file_ = -1;
+#endif
+};
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_FILE_READER_H_
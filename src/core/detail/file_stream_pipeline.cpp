@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_stream_pipeline.h"
+
+#include "data_stream_compression.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace livekit {
+namespace core {
+namespace detail {
+namespace {
+
+// Sends full chunks across block boundaries; a block's tail waits in carry for the next block.
+class ChunkAssembler {
+public:
+	ChunkAssembler(std::size_t chunk_size, const FileStreamChunkFunction& send_chunk)
+	    : chunk_size_(chunk_size), send_chunk_(send_chunk) {
+		carry_.reserve(chunk_size);
+	}
+
+	bool Add(const uint8_t* data, std::size_t size) {
+		if (!carry_.empty()) {
+			const auto count = std::min(chunk_size_ - carry_.size(), size);
+			carry_.insert(carry_.end(), data, data + count);
+			data += count;
+			size -= count;
+			if (carry_.size() < chunk_size_) {
+				return true;
+			}
+			if (!send_chunk_(carry_.data(), carry_.size())) {
+				return false;
+			}
+			carry_.clear();
+		}
+		for (; size >= chunk_size_; data += chunk_size_, size -= chunk_size_) {
+			if (!send_chunk_(data, chunk_size_)) {
+				return false;
+			}
+		}
+		carry_.insert(carry_.end(), data, data + size);
+		return true;
+	}
+
+	bool Flush() { return carry_.empty() || send_chunk_(carry_.data(), carry_.size()); }
+
+private:
+	const std::size_t chunk_size_;
+	const FileStreamChunkFunction& send_chunk_;
+	std::vector<uint8_t> carry_;
+};
+
+// Cuts each compressed block into chunks as it arrives and reports the input it covers.
+DeflateBlockFunction SendDeflatedBlocks(ChunkAssembler& assembler, uint64_t size,
+                                        const FileStreamProgressFunction& progress) {
+	return [&assembler, size, &progress](const uint8_t* block, std::size_t block_size,
+	                                     uint64_t input_end) {
+		if (!assembler.Add(block, block_size) || (input_end == size && !assembler.Flush())) {
+			return false;
+		}
+		if (progress) {
+			progress(input_end);
+		}
+		return true;
+	};
+}
+
+} // namespace
+
+bool StreamFileChunks(const uint8_t* data, std::size_t size, std::size_t chunk_size, bool compress,
+                      const DataStreamCompressionOptions& compression,
+                      const FileStreamChunkFunction& send_chunk,
+                      const FileStreamProgressFunction& progress) {
+	if (chunk_size == 0 || !send_chunk || (data == nullptr && size != 0)) {
+		return false;
+	}
+	if (!compress) {
+		for (std::size_t offset = 0; offset < size;) {
+			const auto block_end = std::min(size, offset + kFileStreamBlockSize);
+			for (; offset < block_end; offset += chunk_size) {
+				if (!send_chunk(data + offset, std::min(chunk_size, size - offset))) {
+					return false;
+				}
+			}
+			offset = std::min(offset, size);
+			if (progress) {
+				progress(offset);
+			}
+		}
+		return true;
+	}
+
+	ChunkAssembler assembler(chunk_size, send_chunk);
+	return DeflateRawParallel(data, size, compression,
+	                          SendDeflatedBlocks(assembler, size, progress));
+}
+
+bool StreamFileChunks(const FileStreamReadFunction& read, uint64_t size, std::size_t chunk_size,
+                      bool compress, const DataStreamCompressionOptions& compression,
+                      const FileStreamChunkFunction& send_chunk,
+                      const FileStreamProgressFunction& progress) {
+	if (chunk_size == 0 || !send_chunk || !read ||
+	    size > std::numeric_limits<std::size_t>::max()) {
+		return false;
+	}
+	if (compress) {
+		ChunkAssembler assembler(chunk_size, send_chunk);
+		return DeflateRawParallel(read, size, compression,
+		                          SendDeflatedBlocks(assembler, size, progress));
+	}
+	const auto block_size = std::max(chunk_size, kFileStreamBlockSize / chunk_size * chunk_size);
+	std::vector<uint8_t> block(static_cast<std::size_t>(std::min<uint64_t>(block_size, size)));
+	for (uint64_t offset = 0; offset < size;) {
+		const auto count = static_cast<std::size_t>(std::min<uint64_t>(block_size, size - offset));
+		if (!read(offset, block.data(), count)) {
+			return false;
+		}
+		for (std::size_t position = 0; position < count; position += chunk_size) {
+			if (!send_chunk(block.data() + position, std::min(chunk_size, count - position))) {
+				return false;
+			}
+		}
+		offset += count;
+		if (progress) {
+			progress(offset);
+		}
+	}
+	return true;
+}
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
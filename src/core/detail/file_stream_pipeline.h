@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_FILE_STREAM_PIPELINE_H_
+#define _LKC_CORE_DETAIL_FILE_STREAM_PIPELINE_H_
+
+#include "livekit/core/data_packet.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+// Uncompressed input bytes sent between progress reports.
+constexpr std::size_t kFileStreamBlockSize = 256 * 1024;
+
+using FileStreamChunkFunction = std::function<bool(const uint8_t* data, std::size_t size)>;
+using FileStreamProgressFunction = std::function<void(uint64_t bytes_consumed)>;
+// Fills buffer with size input bytes from offset; returns false when they cannot be read.
+using FileStreamReadFunction =
+    std::function<bool(uint64_t offset, uint8_t* buffer, std::size_t size)>;
+
+// Cuts data into data stream chunk payloads of at most chunk_size bytes and hands them to
+// send_chunk in order on the calling thread. Uncompressed chunks point straight into data. With
+// compress, data goes through DeflateRawParallel and each compressed block is sent as soon as it
+// is ready, so compression and sending overlap instead of alternating. progress receives the input
+// bytes covered by the chunks sent so far, once per block. Stops at the first chunk send_chunk
+// rejects. SendText and SendBytes use it for their payloads.
+bool StreamFileChunks(const uint8_t* data, std::size_t size, std::size_t chunk_size, bool compress,
+                      const DataStreamCompressionOptions& compression,
+                      const FileStreamChunkFunction& send_chunk,
+                      const FileStreamProgressFunction& progress);
+
+// StreamFileChunks for input that is not in memory, as SendFile's. Uncompressed input is read a
+// block at a time into one reused buffer, each block a whole number of chunks; compressed input is
+// read block by block by the DeflateRawParallel workers, which may call read concurrently. Memory
+// stays bounded by the blocks in flight. Fails, without sending anything further, at the first
+// read that fails.
+bool StreamFileChunks(const FileStreamReadFunction& read, uint64_t size, std::size_t chunk_size,
+                      bool compress, const DataStreamCompressionOptions& compression,
+                      const FileStreamChunkFunction& send_chunk,
+                      const FileStreamProgressFunction& progress);
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_FILE_STREAM_PIPELINE_H_
@@ -0,0 +1,171 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_FRAME_STREAM_QUEUE_H_
+#define _LKC_CORE_DETAIL_FRAME_STREAM_QUEUE_H_
+
+#include "event_notifier.h"
+#include "livekit/core/track/frame_stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace core {
+
+// Default slot recycler: keeps whatever storage the reader swapped back for the next frame.
+struct KeepFrameSlot {
+	template <typename T> void operator()(T&) const noexcept {}
+};
+
+// A bounded queue of preallocated frame slots between a receive thread and a reader. Producers fill
+// a slot in place and readers swap it out, so steady-state traffic reuses the same storage. Only
+// FrameStreamOverflow::Block ever makes the producer wait, and never longer than block_timeout.
+// Recycle runs on slots after they are read or dropped; reference-holding frames use it to release
+// what they point at.
+template <typename T, typename Recycle = KeepFrameSlot> class FrameStreamQueue {
+public:
+	FrameStreamQueue(std::size_t capacity, FrameStreamOverflow overflow,
+	                 std::chrono::milliseconds block_timeout)
+	    : slots_(std::max<std::size_t>(capacity, 1)), overflow_(overflow),
+	      block_timeout_(block_timeout) {}
+
+	FrameStreamQueue(const FrameStreamQueue&) = delete;
+	FrameStreamQueue& operator=(const FrameStreamQueue&) = delete;
+
+	// Lets the owner reserve per-slot storage before the first frame arrives.
+	template <typename Prepare> void PrepareSlots(Prepare&& prepare) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (auto& slot : slots_) {
+			prepare(slot);
+		}
+	}
+
+	// fill(T&) writes the frame into a free slot. Returns false when the frame was dropped.
+	template <typename Fill> bool Push(Fill&& fill) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (closed_) {
+			return false;
+		}
+		++pushed_frames_;
+		if (count_ == slots_.size()) {
+			switch (overflow_) {
+			case FrameStreamOverflow::DropOldest:
+				head_ = (head_ + 1) % slots_.size();
+				--count_;
+				++dropped_frames_;
+				break;
+			case FrameStreamOverflow::KeepLatest:
+				for (; count_ != 0; --count_) {
+					Recycle{}(slots_[head_]);
+					head_ = (head_ + 1) % slots_.size();
+					++dropped_frames_;
+				}
+				break;
+			case FrameStreamOverflow::Block:
+				not_full_.wait_for(lock, block_timeout_,
+				                   [this] { return closed_ || count_ < slots_.size(); });
+				if (closed_ || count_ == slots_.size()) {
+					++dropped_frames_;
+					return false;
+				}
+				break;
+			}
+		}
+		fill(slots_[(head_ + count_) % slots_.size()]);
+		if (count_++ == 0) {
+			notifier_.Set();
+		}
+		lock.unlock();
+		not_empty_.notify_one();
+		return true;
+	}
+
+	// Swaps the oldest frame into frame. Returns false on timeout, or when closed and drained.
+	bool Read(T& frame, std::chrono::milliseconds timeout) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		const auto ready = [this] { return closed_ || count_ != 0; };
+		if (timeout == kFrameStreamWaitForever) {
+			not_empty_.wait(lock, ready);
+		} else if (!not_empty_.wait_for(lock, std::max(timeout, std::chrono::milliseconds(0)),
+		                                ready)) {
+			return false;
+		}
+		if (count_ == 0) {
+			return false;
+		}
+		using std::swap;
+		swap(frame, slots_[head_]);
+		Recycle{}(slots_[head_]);
+		head_ = (head_ + 1) % slots_.size();
+		if (--count_ == 0 && !closed_) {
+			notifier_.Reset();
+		}
+		++read_frames_;
+		lock.unlock();
+		not_full_.notify_one();
+		return true;
+	}
+
+	// Rejects new frames and wakes every waiter. Queued frames remain readable. The descriptor is
+	// left readable so pollers observe the close.
+	void Close() {
+		{
+			std::lock_guard<std::mutex> guard(mutex_);
+			if (closed_) {
+				return;
+			}
+			closed_ = true;
+			if (count_ == 0) {
+				notifier_.Set();
+			}
+		}
+		not_empty_.notify_all();
+		not_full_.notify_all();
+	}
+
+	bool IsClosed() const {
+		std::lock_guard<std::mutex> guard(mutex_);
+		return closed_;
+	}
+
+	int Fd() const { return notifier_.Fd(); }
+	void* Handle() const { return notifier_.Handle(); }
+
+	FrameStreamStats Stats() const {
+		std::lock_guard<std::mutex> guard(mutex_);
+		FrameStreamStats stats;
+		stats.queued_frames = static_cast<uint32_t>(count_);
+		stats.capacity_frames = static_cast<uint32_t>(slots_.size());
+		stats.pushed_frames = pushed_frames_;
+		stats.read_frames = read_frames_;
+		stats.dropped_frames = dropped_frames_;
+		return stats;
+	}
+
+private:
+	std::vector<T> slots_;
+	const FrameStreamOverflow overflow_;
+	const std::chrono::milliseconds block_timeout_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable not_empty_;
+	std::condition_variable not_full_;
+	EventNotifier notifier_;
+	std::size_t head_ = 0;
+	std::size_t count_ = 0;
+	bool closed_ = false;
+	uint64_t pushed_frames_ = 0;
+	uint64_t read_frames_ = 0;
+	uint64_t dropped_frames_ = 0;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_FRAME_STREAM_QUEUE_H_
@@ -0,0 +1,316 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "key_schedule.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace livekit {
+namespace core {
+namespace detail {
+namespace {
+
+// Key material must not linger in freed memory; the volatile stores are not optimised away.
+void Wipe(std::vector<uint8_t>& bytes) noexcept {
+	volatile uint8_t* data = bytes.data();
+	for (std::size_t index = 0; index < bytes.size(); ++index) {
+		data[index] = 0;
+	}
+}
+
+void Wipe(std::string& bytes) noexcept {
+	volatile char* data = bytes.data();
+	for (std::size_t index = 0; index < bytes.size(); ++index) {
+		data[index] = 0;
+	}
+}
+
+void Append(std::string& id, uint64_t value) {
+	for (int shift = 0; shift < 64; shift += 8) {
+		id.push_back(static_cast<char>(value >> shift));
+	}
+}
+
+void Append(std::string& id, const std::vector<uint8_t>& bytes) {
+	Append(id, static_cast<uint64_t>(bytes.size()));
+	id.append(bytes.begin(), bytes.end());
+}
+
+} // namespace
+
+KeySchedule::KeySchedule(std::size_t capacity) : capacity_(capacity) {
+	if (capacity == 0) {
+		throw std::invalid_argument("KeySchedule capacity must be positive");
+	}
+}
+
+KeySchedule::~KeySchedule() {
+	std::deque<Job> dropped;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		stopping_ = true;
+		dropped.swap(jobs_);
+	}
+	wake_.notify_one();
+	if (worker_.joinable()) {
+		worker_.join();
+	}
+	for (auto& entry : entries_) {
+		Wipe(entry.id);
+		Wipe(entry.value.material);
+		Wipe(entry.value.key);
+	}
+	for (auto& job : dropped) {
+		Wipe(job.material);
+	}
+}
+
+KeySchedule& KeySchedule::Shared() {
+	static KeySchedule* schedule = new KeySchedule();
+	return *schedule;
+}
+
+std::string KeySchedule::DerivedId(uint64_t owner, const Bytes& input, const Bytes& salt,
+                                   unsigned int bits) {
+	std::string id(1, 'd');
+	Append(id, owner);
+	Append(id, bits);
+	Append(id, salt);
+	Append(id, input);
+	return id;
+}
+
+std::string KeySchedule::RatchetId(uint64_t owner, const Bytes& material) {
+	std::string id(1, 'r');
+	Append(id, owner);
+	Append(id, material);
+	return id;
+}
+
+std::optional<KeySchedule::Bytes> KeySchedule::FindDerived(uint64_t owner, const Bytes& input,
+                                                           const Bytes& salt, unsigned int bits) {
+	auto id = DerivedId(owner, input, salt, bits);
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto found = Find(id);
+	Wipe(id);
+	if (!found) {
+		return std::nullopt;
+	}
+	return std::move(found->key);
+}
+
+void KeySchedule::StoreDerived(uint64_t owner, const Bytes& input, const Bytes& salt,
+                               unsigned int bits, const Bytes& output) {
+	auto id = DerivedId(owner, input, salt, bits);
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (Cancelled(owner)) {
+		Wipe(id);
+		return;
+	}
+	Store(std::move(id), owner, Ratchet{{}, output});
+}
+
+void KeySchedule::Precompute(uint64_t owner, Bytes material, std::size_t window, Step step) {
+	if (window == 0 || material.empty()) {
+		return;
+	}
+	if (!step) {
+		throw std::invalid_argument("KeySchedule step must not be empty");
+	}
+	auto id = RatchetId(owner, material);
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (stopping_ || !queued_.insert(id).second) {
+			Wipe(id);
+			Wipe(material);
+			return;
+		}
+		jobs_.push_back(Job{owner, std::move(material), window, std::move(step), std::move(id)});
+		if (!worker_.joinable()) {
+			worker_ = std::thread([this] { Run(); });
+			return;
+		}
+	}
+	wake_.notify_one();
+}
+
+std::optional<KeySchedule::Ratchet> KeySchedule::FindRatchet(uint64_t owner,
+                                                             const Bytes& material) {
+	auto id = RatchetId(owner, material);
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto found = Find(id);
+	Wipe(id);
+	return found;
+}
+
+void KeySchedule::RecordRatchet(RatchetOutcome outcome, std::chrono::microseconds elapsed) {
+	const auto elapsed_us = static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count()));
+	std::lock_guard<std::mutex> guard(mutex_);
+	++stats_.searches;
+	switch (outcome) {
+	case RatchetOutcome::Hit:
+		++stats_.hits;
+		break;
+	case RatchetOutcome::Miss:
+		++stats_.misses;
+		break;
+	case RatchetOutcome::Exhausted:
+		break;
+	}
+	stats_.total_latency_us += elapsed_us;
+	stats_.max_latency_us = std::max(stats_.max_latency_us, elapsed_us);
+}
+
+void KeySchedule::Forget(uint64_t owner) {
+	std::deque<Job> dropped;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (auto entry = entries_.begin(); entry != entries_.end();) {
+			const auto next = std::next(entry);
+			if (entry->owner == owner) {
+				Evict(entry);
+			}
+			entry = next;
+		}
+		for (auto job = jobs_.begin(); job != jobs_.end();) {
+			if (job->owner == owner) {
+				queued_.erase(job->id);
+				dropped.push_back(std::move(*job));
+				job = jobs_.erase(job);
+			} else {
+				++job;
+			}
+		}
+		if (running_ && running_owner_ == owner) {
+			running_forgotten_ = true;
+		}
+	}
+	// The steps may own the last references to their key handlers; release them unlocked.
+	for (auto& job : dropped) {
+		Wipe(job.material);
+	}
+	idle_.notify_all();
+}
+
+void KeySchedule::WaitForIdle() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	idle_.wait(lock, [this] { return jobs_.empty() && !running_; });
+}
+
+KeySchedule::Stats KeySchedule::GetStats() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto stats = stats_;
+	stats.entries = entries_.size();
+	return stats;
+}
+
+std::optional<KeySchedule::Ratchet> KeySchedule::Find(const std::string& id) {
+	const auto found = index_.find(id);
+	if (found == index_.end()) {
+		return std::nullopt;
+	}
+	entries_.splice(entries_.begin(), entries_, found->second);
+	return found->second->value;
+}
+
+void KeySchedule::Store(std::string id, uint64_t owner, Ratchet value) {
+	if (const auto found = index_.find(id); found != index_.end()) {
+		entries_.splice(entries_.begin(), entries_, found->second);
+		Wipe(id);
+		Wipe(value.material);
+		Wipe(value.key);
+		return;
+	}
+	entries_.push_front(Entry{std::move(id), owner, std::move(value)});
+	index_.emplace(entries_.front().id, entries_.begin());
+	while (entries_.size() > capacity_) {
+		Evict(std::prev(entries_.end()));
+	}
+}
+
+void KeySchedule::Evict(std::list<Entry>::iterator entry) {
+	index_.erase(entry->id);
+	Wipe(entry->id);
+	Wipe(entry->value.material);
+	Wipe(entry->value.key);
+	entries_.erase(entry);
+}
+
+bool KeySchedule::Cancelled(uint64_t owner) const {
+	// Derivations a cancelled job is still finishing must not refill what Forget wiped.
+	return running_ && running_forgotten_ && running_owner_ == owner &&
+	       std::this_thread::get_id() == worker_.get_id();
+}
+
+void KeySchedule::Run() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+		if (stopping_) {
+			return;
+		}
+		auto job = std::move(jobs_.front());
+		jobs_.pop_front();
+		running_ = true;
+		running_owner_ = job.owner;
+		running_forgotten_ = false;
+
+		auto material = job.material;
+		for (std::size_t index = 0; index < job.window && !stopping_ && !running_forgotten_;
+		     ++index) {
+			auto id = RatchetId(job.owner, material);
+			if (auto known = Find(id)) {
+				Wipe(id);
+				Wipe(known->key);
+				Wipe(material);
+				material = std::move(known->material);
+				continue;
+			}
+			lock.unlock();
+			auto next = job.step(material);
+			lock.lock();
+			if (!next || next->material.empty() || running_forgotten_) {
+				if (next) {
+					Wipe(next->material);
+					Wipe(next->key);
+				}
+				Wipe(id);
+				break;
+			}
+			auto following = next->material;
+			Store(std::move(id), job.owner, std::move(*next));
+			++stats_.precomputed_steps;
+			Wipe(material);
+			material = std::move(following);
+		}
+		Wipe(material);
+		Wipe(job.material);
+		queued_.erase(job.id);
+		Wipe(job.id);
+		running_ = false;
+		lock.unlock();
+		// Drop the step, and the handlers it holds, outside the lock.
+		job = Job();
+		idle_.notify_all();
+		lock.lock();
+	}
+}
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
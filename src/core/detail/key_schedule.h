@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_KEY_SCHEDULE_H_
+#define _LKC_CORE_DETAIL_KEY_SCHEDULE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+// E2EE key derivations computed ahead of need. Whenever a key is set or ratcheted, the next few
+// ratchets of its material are derived on a background thread, so a frame that fails to decrypt
+// can try them without running PBKDF2 on the frame path. Derived keys are also remembered, so
+// installing a precomputed key costs a lookup.
+//
+// Entries are scoped by an owner, the key provider, and wiped when evicted or forgotten.
+class KeySchedule {
+public:
+	using Bytes = std::vector<uint8_t>;
+
+	// One ratchet step: the next key material and the encryption key derived from it.
+	struct Ratchet {
+		Bytes material;
+		Bytes key;
+	};
+	// Computes the ratchet step after material, or nothing when derivation fails. Runs on the
+	// schedule thread.
+	using Step = std::function<std::optional<Ratchet>(const Bytes& material)>;
+
+	enum class RatchetOutcome {
+		// A precomputed step decrypted the frame.
+		Hit,
+		// The search reached a step that was not computed yet; the frame was dropped.
+		Miss,
+		// Every step of the window was tried and none decrypted the frame.
+		Exhausted,
+	};
+
+	struct Stats {
+		uint64_t searches = 0;
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t precomputed_steps = 0;
+		// Time decrypt spent searching the window, summed and for the slowest search.
+		uint64_t total_latency_us = 0;
+		uint64_t max_latency_us = 0;
+		std::size_t entries = 0;
+	};
+
+	explicit KeySchedule(std::size_t capacity = 4096);
+	~KeySchedule();
+
+	KeySchedule(const KeySchedule&) = delete;
+	KeySchedule& operator=(const KeySchedule&) = delete;
+
+	// The process-wide schedule. Never destroyed.
+	static KeySchedule& Shared();
+
+	std::optional<Bytes> FindDerived(uint64_t owner, const Bytes& input, const Bytes& salt,
+	                                 unsigned int bits);
+	void StoreDerived(uint64_t owner, const Bytes& input, const Bytes& salt, unsigned int bits,
+	                  const Bytes& output);
+
+	// Queues the first window ratchets of material. Steps already known are not derived again.
+	void Precompute(uint64_t owner, Bytes material, std::size_t window, Step step);
+	std::optional<Ratchet> FindRatchet(uint64_t owner, const Bytes& material);
+
+	void RecordRatchet(RatchetOutcome outcome, std::chrono::microseconds elapsed);
+
+	// Wipes everything held for owner and drops its queued work.
+	void Forget(uint64_t owner);
+	// Blocks until no work is queued or running.
+	void WaitForIdle();
+	Stats GetStats() const;
+
+private:
+	struct Entry {
+		std::string id;
+		uint64_t owner = 0;
+		Ratchet value;
+	};
+	struct Job {
+		uint64_t owner = 0;
+		Bytes material;
+		std::size_t window = 0;
+		Step step;
+		std::string id;
+	};
+
+	static std::string DerivedId(uint64_t owner, const Bytes& input, const Bytes& salt,
+	                             unsigned int bits);
+	static std::string RatchetId(uint64_t owner, const Bytes& material);
+
+	// All private helpers expect mutex_ to be held.
+	std::optional<Ratchet> Find(const std::string& id);
+	void Store(std::string id, uint64_t owner, Ratchet value);
+	void Evict(std::list<Entry>::iterator entry);
+	bool Cancelled(uint64_t owner) const;
+	void Run();
+
+	const std::size_t capacity_;
+	mutable std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable idle_;
+	// Most recently used first. The index views the ids its entries own, so the key bytes inside
+	// an id exist once and are wiped with the entry.
+	std::list<Entry> entries_;
+	std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+	std::deque<Job> jobs_;
+	std::unordered_set<std::string> queued_;
+	// The job the worker is running, if any, and whether its owner was forgotten meanwhile.
+	bool running_ = false;
+	uint64_t running_owner_ = 0;
+	bool running_forgotten_ = false;
+	bool stopping_ = false;
+	std::thread worker_;
+	Stats stats_;
+};
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_KEY_SCHEDULE_H_
@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_PARTICIPANT_REGISTRY_H_
+#define _LKC_CORE_DETAIL_PARTICIPANT_REGISTRY_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+// The remote participants of a room, with hash indexes by sid, identity, name and published track
+// sid, so event handlers find their participant without scanning the room. The owner re-indexes a
+// participant with Upsert() whenever its info changes. Not thread-safe.
+template <typename Participant> class ParticipantRegistry {
+public:
+	using Pointer = std::shared_ptr<Participant>;
+	using Map = std::map<std::string, Pointer>;
+
+	struct Keys {
+		std::string identity;
+		std::string name;
+		std::vector<std::string> track_sids;
+	};
+
+	// Adds the participant, or replaces the keys it was indexed under.
+	void Upsert(const std::string& sid, Pointer participant, Keys keys) {
+		auto found = entries_.find(sid);
+		if (found != entries_.end()) {
+			Unindex(sid, found->second.keys);
+			found->second.participant = participant;
+			found->second.keys = std::move(keys);
+		} else {
+			found = entries_.emplace(sid, Entry{participant, std::move(keys)}).first;
+		}
+		ordered_[sid] = participant;
+		const auto& indexed = found->second.keys;
+		by_identity_[indexed.identity].insert(sid);
+		by_name_[indexed.name].insert(sid);
+		for (const auto& track_sid : indexed.track_sids) {
+			by_track_[track_sid] = participant;
+		}
+	}
+
+	bool Erase(const std::string& sid) {
+		auto found = entries_.find(sid);
+		if (found == entries_.end()) {
+			return false;
+		}
+		Unindex(sid, found->second.keys);
+		entries_.erase(found);
+		ordered_.erase(sid);
+		return true;
+	}
+
+	void Clear() {
+		entries_.clear();
+		ordered_.clear();
+		by_identity_.clear();
+		by_name_.clear();
+		by_track_.clear();
+	}
+
+	Pointer FindBySid(const std::string& sid) const {
+		auto found = entries_.find(sid);
+		return found != entries_.end() ? found->second.participant : nullptr;
+	}
+
+	// Several participants can share an identity while a rejoined one replaces its old session,
+	// and many can share a name; the one with the lowest sid is returned.
+	Pointer FindByIdentity(const std::string& identity) const {
+		return FindFirst(by_identity_, identity);
+	}
+
+	Pointer FindByName(const std::string& name) const { return FindFirst(by_name_, name); }
+
+	Pointer FindByTrackSid(const std::string& track_sid) const {
+		auto found = by_track_.find(track_sid);
+		return found != by_track_.end() ? found->second : nullptr;
+	}
+
+	// Ordered by sid.
+	typename Map::const_iterator begin() const { return ordered_.begin(); }
+	typename Map::const_iterator end() const { return ordered_.end(); }
+	std::size_t size() const { return ordered_.size(); }
+	bool empty() const { return ordered_.empty(); }
+
+private:
+	struct Entry {
+		Pointer participant;
+		Keys keys;
+	};
+	using Index = std::unordered_map<std::string, std::set<std::string>>;
+
+	void Unindex(const std::string& sid, const Keys& keys) {
+		RemoveFrom(by_identity_, keys.identity, sid);
+		RemoveFrom(by_name_, keys.name, sid);
+		const auto participant = entries_.find(sid)->second.participant;
+		for (const auto& track_sid : keys.track_sids) {
+			auto found = by_track_.find(track_sid);
+			// A track sid moved to another participant keeps its new owner.
+			if (found != by_track_.end() && found->second == participant) {
+				by_track_.erase(found);
+			}
+		}
+	}
+
+	static void RemoveFrom(Index& index, const std::string& key, const std::string& sid) {
+		auto found = index.find(key);
+		if (found == index.end()) {
+			return;
+		}
+		found->second.erase(sid);
+		if (found->second.empty()) {
+			index.erase(found);
+		}
+	}
+
+	Pointer FindFirst(const Index& index, const std::string& key) const {
+		auto found = index.find(key);
+		if (found == index.end() || found->second.empty()) {
+			return nullptr;
+		}
+		return FindBySid(*found->second.begin());
+	}
+
+	std::unordered_map<std::string, Entry> entries_;
+	Map ordered_;
+	Index by_identity_;
+	Index by_name_;
+	std::unordered_map<std::string, Pointer> by_track_;
+};
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_PARTICIPANT_REGISTRY_H_
@@ -37,11 +37,12 @@
 #include "rtc_base/thread.h"
 
 #include <iostream>
+#include <mutex>
 
 namespace livekit {
 namespace core {
 
-PeerTransportFactory::PeerTransportFactory() {
+PeerTransportFactory::PeerTransportFactory(AudioPlayout playout) {
 	network_thread_ = webrtc::Thread::CreateWithSocketServer();
 	network_thread_->SetName("network_thread", &network_thread_);
 	network_thread_->Start();
@@ -53,8 +54,9 @@ PeerTransportFactory::PeerTransportFactory() {
 	signaling_thread_->Start();
 
 	task_queue_factory_ = webrtc::CreateDefaultTaskQueueFactory();
-	audio_device_ = worker_thread_->BlockingCall(
-	    [&] { return webrtc::make_ref_counted<AudioDevice>(task_queue_factory_.get()); });
+	audio_device_ = worker_thread_->BlockingCall([&] {
+		return webrtc::make_ref_counted<AudioDevice>(task_queue_factory_.get(), playout);
+	});
 	if (audio_device_ == nullptr) {
 		return;
 	}
@@ -81,14 +83,45 @@ PeerTransportFactory::~PeerTransportFactory() {
 	network_thread_->Stop();
 }
 
+PeerFactoryStats PeerTransportFactory::GetStats() const {
+	PeerFactoryStats stats;
+	stats.rooms = rooms_.load(std::memory_order_relaxed);
+	const webrtc::Thread* threads[] = {network_thread_.get(), worker_thread_.get(),
+	                                   signaling_thread_.get()};
+	for (const auto* thread : threads) {
+		stats.threads += thread != nullptr ? 1 : 0;
+	}
+	if (audio_device_ != nullptr && audio_device_->Initialized()) {
+		++stats.threads;
+	}
+	return stats;
+}
+
 webrtc::Thread* PeerTransportFactory::network_thread() const { return network_thread_.get(); }
 
 webrtc::Thread* PeerTransportFactory::worker_thread() const { return worker_thread_.get(); }
 
 webrtc::Thread* PeerTransportFactory::signaling_thread() const { return signaling_thread_.get(); }
 
-std::shared_ptr<PeerTransportFactory> PeerTransportFactory::Create() {
-	return std::make_shared<PeerTransportFactory>();
+std::shared_ptr<PeerTransportFactory> PeerTransportFactory::Create(AudioPlayout playout) {
+	return std::make_shared<PeerTransportFactory>(playout);
+}
+
+std::shared_ptr<PeerFactory> CreatePeerFactory(AudioPlayout playout) {
+	return PeerTransportFactory::Create(playout);
+}
+
+std::shared_ptr<PeerFactory> ProcessPeerFactory() {
+	// Held weakly so the threads stop once the last room and caller release the factory.
+	static std::mutex mutex;
+	static std::weak_ptr<PeerTransportFactory> process_factory;
+	std::lock_guard<std::mutex> guard(mutex);
+	auto factory = process_factory.lock();
+	if (!factory) {
+		factory = PeerTransportFactory::Create();
+		process_factory = factory;
+	}
+	return factory;
 }
 
 } // namespace core
@@ -21,6 +21,7 @@
 #define _LKC_CORE_DETAIL_PEER_TRANSPORT_FACTORY_H_
 
 #include "audio_device.h"
+#include "livekit/core/option/peer_factory.h"
 
 #include "api/peer_connection_interface.h"
 #include "api/scoped_refptr.h"
@@ -33,15 +34,24 @@
 #include "rtc_base/win32_socket_init.h"
 #endif
 
+#include <atomic>
+#include <memory>
+
 namespace livekit {
 namespace core {
 
-class PeerTransportFactory {
+class PeerTransportFactory : public PeerFactory {
 public:
-	static std::shared_ptr<PeerTransportFactory> Create();
+	static std::shared_ptr<PeerTransportFactory>
+	Create(AudioPlayout playout = AudioPlayout::Device);
+
+	explicit PeerTransportFactory(AudioPlayout playout = AudioPlayout::Device);
+	~PeerTransportFactory() override;
 
-	explicit PeerTransportFactory();
-	~PeerTransportFactory();
+	PeerFactoryStats GetStats() const override;
+	// Counted by each RtcEngine for as long as it holds the factory.
+	void AttachRoom() { rooms_.fetch_add(1, std::memory_order_relaxed); }
+	void DetachRoom() { rooms_.fetch_sub(1, std::memory_order_relaxed); }
 
 	webrtc::PeerConnectionFactoryInterface* GetPeerConnectFactory() { return peer_factory_.get(); }
 	webrtc::scoped_refptr<AudioDevice> GetAudioDevice() const { return audio_device_; }
@@ -57,6 +67,7 @@ private:
 	std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory_;
 	webrtc::scoped_refptr<AudioDevice> audio_device_;
 	webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> peer_factory_;
+	std::atomic<uint32_t> rooms_{0};
 };
 
 } // namespace core
@@ -17,6 +17,7 @@
 
 #include "rtc_engine.h"
 #include "../e2ee/e2ee_manager_internal.h"
+#include "data_packet_serializer.h"
 #include "internals.h"
 #include "rtc_session.h"
 #include "signal_client.h"
@@ -114,30 +115,6 @@ namespace core {
 
 namespace {
 
-bool MakeEncryptablePayload(const livekit::DataPacket& packet,
-                            livekit::EncryptedPacketPayload& payload) {
-	if (packet.has_user()) {
-		payload.mutable_user()->CopyFrom(packet.user());
-	} else if (packet.has_chat_message()) {
-		payload.mutable_chat_message()->CopyFrom(packet.chat_message());
-	} else if (packet.has_rpc_request()) {
-		payload.mutable_rpc_request()->CopyFrom(packet.rpc_request());
-	} else if (packet.has_rpc_ack()) {
-		payload.mutable_rpc_ack()->CopyFrom(packet.rpc_ack());
-	} else if (packet.has_rpc_response()) {
-		payload.mutable_rpc_response()->CopyFrom(packet.rpc_response());
-	} else if (packet.has_stream_header()) {
-		payload.mutable_stream_header()->CopyFrom(packet.stream_header());
-	} else if (packet.has_stream_chunk()) {
-		payload.mutable_stream_chunk()->CopyFrom(packet.stream_chunk());
-	} else if (packet.has_stream_trailer()) {
-		payload.mutable_stream_trailer()->CopyFrom(packet.stream_trailer());
-	} else {
-		return false;
-	}
-	return true;
-}
-
 bool RestoreEncryptedPayload(const livekit::EncryptedPacketPayload& payload,
                              livekit::DataPacket& packet) {
 	if (payload.has_user()) {
@@ -206,6 +183,10 @@ RtcEngine::~RtcEngine() {
 	room_listener_.store(nullptr);
 	Disconnect();
 	StopRpcWorkers();
+	std::lock_guard<std::mutex> guard(peer_factory_lock_);
+	if (peer_factory_) {
+		peer_factory_->DetachRoom();
+	}
 }
 
 livekit::JoinResponse RtcEngine::Connect(std::string url, std::string token,
@@ -277,7 +258,12 @@ livekit::JoinResponse RtcEngine::ConnectTransport(const std::string& url, const
 	{
 		std::lock_guard<std::mutex> factory_guard(peer_factory_lock_);
 		if (!peer_factory_) {
-			peer_factory_ = PeerTransportFactory::Create();
+			peer_factory_ = std::dynamic_pointer_cast<PeerTransportFactory>(options.peer_factory);
+			peer_factory_shared_ = peer_factory_ != nullptr;
+			if (!peer_factory_) {
+				peer_factory_ = PeerTransportFactory::Create(options.audio_playout);
+			}
+			peer_factory_->AttachRoom();
 		}
 		peer_factory = peer_factory_;
 	}
@@ -514,18 +500,15 @@ void RtcEngine::StartRecovery(livekit::DisconnectReason reason, bool force_full_
 		listener->ReconnectingEvent(force_full_reconnect);
 	}
 
-	std::thread completed_thread;
-	{
-		std::lock_guard<std::mutex> guard(recovery_thread_mutex_);
-		if (recovery_thread_.joinable()) {
-			completed_thread = std::move(recovery_thread_);
-		}
-	}
-	if (completed_thread.joinable()) {
-		completed_thread.join();
-	}
+	// The previous recovery has cleared recovery_in_progress_ but may still be returning. The new
+	// thread joins it, so this call never blocks the signal thread that reported the close.
 	std::lock_guard<std::mutex> guard(recovery_thread_mutex_);
-	recovery_thread_ = std::thread([this]() { RunRecovery(); });
+	recovery_thread_ = std::thread([this, completed_thread = std::move(recovery_thread_)]() mutable {
+		if (completed_thread.joinable()) {
+			completed_thread.join();
+		}
+		RunRecovery();
+	});
 }
 
 void RtcEngine::RunRecovery() {
@@ -695,6 +678,11 @@ webrtc::scoped_refptr<AudioDevice> RtcEngine::GetAudioDevice() {
 	                                : webrtc::scoped_refptr<AudioDevice>{};
 }
 
+std::optional<bool> RtcEngine::SharesPeerFactory() const {
+	std::lock_guard<std::mutex> guard(peer_factory_lock_);
+	return peer_factory_ != nullptr ? std::optional<bool>(peer_factory_shared_) : std::nullopt;
+}
+
 std::optional<livekit::TrackInfo> RtcEngine::AddTrack(const livekit::AddTrackRequest& req) {
 	if (req.cid().empty()) {
 		throw std::runtime_error("cid is empty");
@@ -799,45 +787,47 @@ bool RtcEngine::SendDataPacket(const livekit::DataPacket& packet, bool reliable)
 		return false;
 	}
 
-	livekit::DataPacket outbound(packet);
+	// Unencrypted packets are serialised as they are. With E2EE only the payload is serialised for
+	// the cryptor, and the ciphertext goes out in an arena-built envelope.
+	const google::protobuf::MessageLite* outbound = &packet;
+	EnvelopeArena arena;
 	{
 		std::lock_guard<std::mutex> guard(e2ee_mutex_);
 		if (e2ee_manager_ != nullptr && e2ee_manager_->Enabled()) {
-			livekit::EncryptedPacketPayload payload;
-			if (MakeEncryptablePayload(packet, payload)) {
-				std::string serialized_payload;
-				if (!payload.SerializeToString(&serialized_payload)) {
-					return false;
-				}
-				const std::vector<std::uint8_t> plaintext(serialized_payload.begin(),
-				                                          serialized_payload.end());
-				auto encrypted = E2EEManagerNativeAccess::EncryptData(
-				    *e2ee_manager_, e2ee_local_identity_, plaintext);
-				if (!encrypted) {
+			if (SerializeEncryptablePayload(packet, e2ee_plaintext_)) {
+				auto* envelope = CreateEncryptedEnvelope(packet, arena.Get());
+				auto* encrypted_packet = envelope->mutable_encrypted_packet();
+				// Sealed straight into the envelope's field.
+				auto* ciphertext = encrypted_packet->mutable_encrypted_value();
+				ciphertext->resize(e2ee_plaintext_.size() + DataPacketCryptoSession::kTagSize);
+				DataPacketCryptoSession::Packet encrypted;
+				encrypted.input = e2ee_plaintext_;
+				encrypted.output = {reinterpret_cast<std::uint8_t*>(ciphertext->data()),
+				                    ciphertext->size()};
+				if (E2EEManagerNativeAccess::EncryptData(*e2ee_manager_, e2ee_local_identity_,
+				                                         {&encrypted, 1}) != 1) {
 					return false;
 				}
-				auto* encrypted_packet = outbound.mutable_encrypted_packet();
+				ciphertext->resize(encrypted.size);
 				encrypted_packet->set_encryption_type(livekit::Encryption_Type_GCM);
-				encrypted_packet->set_iv(encrypted->iv.data(), encrypted->iv.size());
-				encrypted_packet->set_key_index(static_cast<std::uint32_t>(encrypted->key_index));
-				encrypted_packet->set_encrypted_value(encrypted->payload.data(),
-				                                      encrypted->payload.size());
+				encrypted_packet->set_iv(encrypted.iv.data(), encrypted.iv.size());
+				encrypted_packet->set_key_index(static_cast<std::uint32_t>(encrypted.key_index));
+				outbound = envelope;
 			}
 		}
 	}
 
-	std::string serialized;
-	if (!outbound.SerializeToString(&serialized)) {
-		return false;
-	}
 	std::lock_guard<std::mutex> send_guard(reliable ? reliable_data_channel_send_mutex_
 	                                                : lossy_data_channel_send_mutex_);
 	UpdateDataChannelBufferStatus(channel, reliable);
 	if (!WaitForDataChannelBuffer(channel, reliable)) {
 		return false;
 	}
-	const bool sent = channel->Send(
-	    webrtc::DataBuffer(webrtc::CopyOnWriteBuffer(serialized.data(), serialized.size()), true));
+	auto& buffer = reliable ? reliable_send_buffer_ : lossy_send_buffer_;
+	if (!SerializeToBuffer(*outbound, buffer)) {
+		return false;
+	}
+	const bool sent = channel->Send(webrtc::DataBuffer(buffer, true));
 	UpdateDataChannelBufferStatus(channel, reliable);
 	return sent;
 }
@@ -1719,19 +1709,28 @@ void RtcEngine::OnDataChannelMessage(const webrtc::DataBuffer& buffer) {
 		     encryption_type != livekit::Encryption_Type_GCM)) {
 			return;
 		}
+		// Opened from the parsed packet's fields into a reused buffer, without copying them out.
 		const auto& encrypted_packet = packet.encrypted_packet();
-		E2EEManagerNativeAccess::EncryptedData encrypted{
-		    {encrypted_packet.encrypted_value().begin(), encrypted_packet.encrypted_value().end()},
-		    {encrypted_packet.iv().begin(), encrypted_packet.iv().end()},
-		    encrypted_packet.key_index()};
-		auto decrypted = E2EEManagerNativeAccess::DecryptData(
-		    *e2ee_manager_, packet.participant_identity(), encrypted);
-		if (!decrypted ||
-		    decrypted->size() > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+		const auto& ciphertext = encrypted_packet.encrypted_value();
+		const auto& iv = encrypted_packet.iv();
+		if (iv.size() != DataPacketCryptoSession::kIvSize ||
+		    ciphertext.size() < DataPacketCryptoSession::kTagSize) {
+			return;
+		}
+		e2ee_plaintext_.resize(ciphertext.size() - DataPacketCryptoSession::kTagSize);
+		DataPacketCryptoSession::Packet encrypted;
+		encrypted.input = {reinterpret_cast<const std::uint8_t*>(ciphertext.data()),
+		                   ciphertext.size()};
+		encrypted.output = e2ee_plaintext_;
+		std::copy(iv.begin(), iv.end(), encrypted.iv.begin());
+		encrypted.key_index = encrypted_packet.key_index();
+		if (E2EEManagerNativeAccess::DecryptData(*e2ee_manager_, packet.participant_identity(),
+		                                         {&encrypted, 1}) != 1 ||
+		    encrypted.size > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
 			return;
 		}
 		livekit::EncryptedPacketPayload payload;
-		if (!payload.ParseFromArray(decrypted->data(), static_cast<int>(decrypted->size())) ||
+		if (!payload.ParseFromArray(e2ee_plaintext_.data(), static_cast<int>(encrypted.size)) ||
 		    !RestoreEncryptedPayload(payload, packet)) {
 			return;
 		}
@@ -1741,7 +1740,7 @@ void RtcEngine::OnDataChannelMessage(const webrtc::DataBuffer& buffer) {
 		return;
 	}
 	if (auto* listener = room_listener_.load()) {
-		listener->DataPacketEvent(packet);
+		listener->DataPacketEvent(std::move(packet));
 	}
 }
 
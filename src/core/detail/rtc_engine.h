@@ -29,8 +29,11 @@
 #include "rtc_session.h"
 #include "signal_client.h"
 
+#include "rtc_base/copy_on_write_buffer.h"
+
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <map>
@@ -40,6 +43,7 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace livekit {
 namespace core {
@@ -61,7 +65,7 @@ public:
 		                             webrtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver,
 		                             std::function<std::string()> stats_provider) = 0;
 		virtual void MediaTrackRemovedEvent(const std::string& track_sid) = 0;
-		virtual void DataPacketEvent(const livekit::DataPacket& packet) = 0;
+		virtual void DataPacketEvent(livekit::DataPacket packet) = 0;
 		virtual void RemoteMuteChangedEvent(const std::string& sid, bool muted) = 0;
 		virtual void LocalTrackUnpublishedEvent(const std::string& sid) = 0;
 		virtual void SpeakersChangedEvent(const std::vector<livekit::SpeakerInfo>& updates) = 0;
@@ -94,6 +98,9 @@ public:
 
 	std::shared_ptr<PeerTransportFactory> GetSessionPeerTransportFactory();
 	webrtc::scoped_refptr<AudioDevice> GetAudioDevice();
+	// Whether the factory came from RoomOptions::peer_factory and so may serve other rooms too.
+	// nullopt until the first connect picks the factory.
+	std::optional<bool> SharesPeerFactory() const;
 
 	std::optional<livekit::TrackInfo> AddTrack(const livekit::AddTrackRequest& req);
 
@@ -260,6 +267,8 @@ private:
 	std::mutex e2ee_mutex_;
 	E2EEManager* e2ee_manager_ = nullptr;
 	std::string e2ee_local_identity_;
+	// Plaintext of the data packet being encrypted or decrypted, reused under e2ee_mutex_.
+	std::vector<std::uint8_t> e2ee_plaintext_;
 	mutable std::mutex session_lock_;
 	mutable std::mutex signal_client_lock_;
 	std::shared_ptr<SignalClient> signal_client_;
@@ -268,12 +277,16 @@ private:
 	// connections so those tracks can be republished safely after a full reconnect.
 	mutable std::mutex peer_factory_lock_;
 	std::shared_ptr<PeerTransportFactory> peer_factory_;
+	bool peer_factory_shared_ = false;
 	bool is_subscriber_primary_;
 	webrtc::scoped_refptr<webrtc::DataChannelInterface> lossyDC_ = nullptr;
 	webrtc::scoped_refptr<webrtc::DataChannelInterface> reliableDC_ = nullptr;
 	std::mutex data_channels_lock_;
 	std::mutex reliable_data_channel_send_mutex_;
 	std::mutex lossy_data_channel_send_mutex_;
+	// Reused send buffers, one per channel, guarded by the matching send mutex.
+	webrtc::CopyOnWriteBuffer reliable_send_buffer_;
+	webrtc::CopyOnWriteBuffer lossy_send_buffer_;
 	std::vector<webrtc::scoped_refptr<webrtc::DataChannelInterface>> data_channels_;
 	std::vector<std::unique_ptr<DataChannelObserverProxy>> data_channel_observers_;
 	DataChannelBackpressure data_channel_backpressure_;
@@ -16,6 +16,7 @@
  */
 
 #include "signal_client.h"
+#include "global_task_queue.h"
 #include "livekit_models.pb.h"
 #include "livekit_rtc.pb.h"
 #include "signal_url.h"
@@ -28,6 +29,7 @@
 #include <limits>
 #include <string>
 #include <string_view>
+#include <thread>
 
 namespace {
 
@@ -92,12 +94,22 @@ SignalClient::SignalClient(std::string url, std::string token, SignalOptions opt
 	std::string request = detail::BuildSignalUrl(url_, token_, option_);
 	WebsocketConnectionOptions ws_option;
 	wsc_ = std::make_unique<WebsocketClient>(ws_option, request);
+	timer_target_->client = this;
 
 	return;
 }
 
 SignalClient::~SignalClient() {
 	std::cout << "SignalClient::~SignalClient()" << std::endl;
+	{
+		// Later tasks skip the client; one already running is waited for, unless it is this call.
+		std::unique_lock<std::mutex> lock(timer_target_->mutex);
+		timer_target_->client = nullptr;
+		if (timer_target_->running != std::this_thread::get_id()) {
+			timer_target_->idle.wait(
+			    lock, [this] { return timer_target_->running == std::thread::id(); });
+		}
+	}
 	Close(false);
 }
 
@@ -658,6 +670,33 @@ void SignalClient::handleOnClose(std::string reason) {
 	return;
 }
 
+void SignalClient::postTimerTask(std::function<void(SignalClient&)> task) {
+	// One queue for every client, never destroyed, like the timer wheel. Closing a connection only
+	// posts recovery work, so one room's close does not hold up the others' pings.
+	static webrtc::TaskQueueBase* const queue =
+	    GetGlobalTaskQueueFactory()
+	        ->CreateTaskQueue("SignalClientTimers", webrtc::TaskQueueFactory::Priority::NORMAL)
+	        .release();
+	queue->PostTask([target = timer_target_, task = std::move(task)] {
+		SignalClient* client = nullptr;
+		{
+			std::lock_guard<std::mutex> guard(target->mutex);
+			client = target->client;
+			if (client == nullptr) {
+				return;
+			}
+			target->running = std::this_thread::get_id();
+		}
+		// Called without the lock, so a destructor only waits for its own client's task.
+		task(*client);
+		{
+			std::lock_guard<std::mutex> guard(target->mutex);
+			target->running = std::thread::id();
+		}
+		target->idle.notify_all();
+	});
+}
+
 void SignalClient::resolveJoinResponse(const livekit::JoinResponse& response) {
 	if (join_response_resolved_) {
 		return;
@@ -685,10 +724,16 @@ void SignalClient::resetPingTimeout() {
 	// std::cout << "reset ping timeout, count:" << ping_timeout_timer_count_.load() << std::endl;
 	ping_timeout_timer_count_.fetch_add(1);
 	ping_timeout_timer_ = std::make_shared<Timer>();
+	const auto generation = ping_timeout_generation_.load();
 	ping_timeout_timer_->SetTimeout(
-	    [this]() {
-		    std::cout << "handle ping timeout" << std::endl;
-		    this->handleOnClose("ping timeout");
+	    [this, generation]() {
+		    postTimerTask([generation](SignalClient& client) {
+			    if (client.ping_timeout_generation_.load() != generation) {
+				    return;
+			    }
+			    std::cout << "handle ping timeout" << std::endl;
+			    client.handleOnClose("ping timeout");
+		    });
 	    },
 	    this->ping_timeout_duration_ * 1000);
 
@@ -696,12 +741,18 @@ void SignalClient::resetPingTimeout() {
 }
 
 void SignalClient::clearPingTimeout() {
-	std::lock_guard<std::mutex> guard(ping_timeout_timer_lock_);
-	if (ping_timeout_timer_) {
+	std::shared_ptr<Timer> timer;
+	{
+		std::lock_guard<std::mutex> guard(ping_timeout_timer_lock_);
+		timer = std::move(ping_timeout_timer_);
+		ping_timeout_generation_.fetch_add(1);
+	}
+	// Stopped outside the lock: Stop() waits for a running callback, which may be clearing the
+	// timers itself.
+	if (timer) {
 		std::cout << "clear ping timeout" << std::endl;
 		ping_timeout_timer_count_.fetch_sub(1);
-		ping_timeout_timer_->Stop();
-		ping_timeout_timer_ = nullptr;
+		timer->Stop();
 	}
 	return;
 }
@@ -718,8 +769,10 @@ void SignalClient::startPingInterval() {
 	ping_interval_timer_ = std::make_shared<Timer>();
 	ping_interval_timer_->SetInterval(
 	    [this]() {
-		    std::cout << "ping interval" << std::endl;
-		    this->SendPing();
+		    postTimerTask([](SignalClient& client) {
+			    std::cout << "ping interval" << std::endl;
+			    client.SendPing();
+		    });
 	    },
 	    this->ping_interval_duration_ * 1000);
 
@@ -728,11 +781,14 @@ void SignalClient::startPingInterval() {
 
 void SignalClient::clearPingInterval() {
 	clearPingTimeout();
-	std::lock_guard<std::mutex> guard(ping_interval_timer_lock_);
-	if (ping_interval_timer_) {
+	std::shared_ptr<Timer> timer;
+	{
+		std::lock_guard<std::mutex> guard(ping_interval_timer_lock_);
+		timer = std::move(ping_interval_timer_);
+	}
+	if (timer) {
 		std::cout << "clear ping interval" << std::endl;
-		ping_interval_timer_->Stop();
-		ping_interval_timer_ = nullptr;
+		timer->Stop();
 	}
 	return;
 }
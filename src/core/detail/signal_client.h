@@ -29,10 +29,12 @@
 #include <api/create_peerconnection_factory.h>
 #include <api/jsep.h>
 
+#include <condition_variable>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 
 namespace livekit {
 namespace core {
@@ -158,6 +160,8 @@ private:
 	void startPingInterval();
 	void clearPingInterval();
 	void handleOnClose(std::string reason);
+	// Runs task on the ping queue shared by every client, unless this client is gone by then.
+	void postTimerTask(std::function<void(SignalClient&)> task);
 	void resolveJoinResponse(const livekit::JoinResponse& response);
 	void resolveResume(bool connected);
 	uint64_t getNextRequestId();
@@ -181,11 +185,24 @@ private:
 	mutable std::mutex ping_timeout_timer_lock_;
 	std::shared_ptr<Timer> ping_timeout_timer_ = nullptr;
 	std::atomic<int64_t> ping_timeout_timer_count_{0};
+	// Bumped by clearPingTimeout(), so a timeout already posted to the ping queue is ignored.
+	std::atomic<uint64_t> ping_timeout_generation_{0};
 	mutable std::mutex ping_interval_timer_lock_;
 	std::shared_ptr<Timer> ping_interval_timer_ = nullptr;
 	SignalClientObserver* observer_ = nullptr;
 	std::atomic<int64_t> rtt_;
 	std::atomic<uint64_t> request_id_{0};
+	// The ping timers fire on the shared timer wheel and only post to the ping queue, so closing
+	// one room's connection never delays another room's timers. Posted tasks reach the client
+	// through this; the destructor detaches it, waiting for a task that is running.
+	struct TimerTarget {
+		std::mutex mutex;
+		std::condition_variable idle;
+		SignalClient* client = nullptr;
+		// The queue thread while it runs a task for client, otherwise empty.
+		std::thread::id running;
+	};
+	std::shared_ptr<TimerTarget> timer_target_ = std::make_shared<TimerTarget>();
 };
 
 } // namespace core
@@ -0,0 +1,107 @@
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_SPSC_RING_BUFFER_H_
+#define _LKC_CORE_DETAIL_SPSC_RING_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace livekit {
+namespace core {
+
+// Fixed-capacity queue for exactly one producer thread and one consumer thread. Write() is
+// wait-free and all-or-nothing, so a frame is never split by an overrun; Read() and Discard() are
+// O(count) regardless of how much is queued. Neither side locks or allocates after construction.
+template <typename T> class SpscRingBuffer {
+	static_assert(std::is_trivially_copyable_v<T>, "SpscRingBuffer copies elements with memcpy");
+
+public:
+	explicit SpscRingBuffer(std::size_t capacity) : buffer_(capacity) {}
+
+	SpscRingBuffer(const SpscRingBuffer&) = delete;
+	SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+	std::size_t Capacity() const noexcept { return buffer_.size(); }
+
+	// Exact on the producer and consumer threads; a snapshot anywhere else.
+	std::size_t Size() const noexcept {
+		const auto read = read_index_.load(std::memory_order_acquire);
+		const auto write = write_index_.load(std::memory_order_acquire);
+		return static_cast<std::size_t>(write - read);
+	}
+
+	// Producer only.
+	bool Write(const T* data, std::size_t count) noexcept {
+		const auto write = write_index_.load(std::memory_order_relaxed);
+		const auto read = read_index_.load(std::memory_order_acquire);
+		if (count > Capacity() - static_cast<std::size_t>(write - read)) {
+			return false;
+		}
+		if (count == 0) {
+			return true;
+		}
+		const std::size_t offset = static_cast<std::size_t>(write % Capacity());
+		const std::size_t first = std::min(count, Capacity() - offset);
+		std::memcpy(buffer_.data() + offset, data, first * sizeof(T));
+		std::memcpy(buffer_.data(), data + first, (count - first) * sizeof(T));
+		write_index_.store(write + count, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Copies exactly count elements, or nothing when fewer are queued.
+	bool Read(T* destination, std::size_t count) noexcept {
+		const auto read = read_index_.load(std::memory_order_relaxed);
+		const auto write = write_index_.load(std::memory_order_acquire);
+		if (static_cast<std::size_t>(write - read) < count) {
+			return false;
+		}
+		if (count == 0) {
+			return true;
+		}
+		const std::size_t offset = static_cast<std::size_t>(read % Capacity());
+		const std::size_t first = std::min(count, Capacity() - offset);
+		std::memcpy(destination, buffer_.data() + offset, first * sizeof(T));
+		std::memcpy(destination + first, buffer_.data(), (count - first) * sizeof(T));
+		read_index_.store(read + count, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Drops up to count queued elements and returns how many were dropped.
+	std::size_t Discard(std::size_t count) noexcept {
+		const auto read = read_index_.load(std::memory_order_relaxed);
+		const auto write = write_index_.load(std::memory_order_acquire);
+		const std::size_t dropped = std::min(count, static_cast<std::size_t>(write - read));
+		read_index_.store(read + dropped, std::memory_order_release);
+		return dropped;
+	}
+
+	// Producer only, or any thread serialised with the producer. Total elements ever written; a
+	// consumer can later drop everything written before this point with DiscardUntil().
+	uint64_t WritePosition() const noexcept { return write_index_.load(std::memory_order_acquire); }
+
+	// Consumer only. Drops the queued elements written before position, leaving later ones.
+	std::size_t DiscardUntil(uint64_t position) noexcept {
+		const auto read = read_index_.load(std::memory_order_relaxed);
+		if (position <= read) {
+			return 0;
+		}
+		return Discard(static_cast<std::size_t>(position - read));
+	}
+
+private:
+	std::vector<T> buffer_;
+	// Monotonic 64-bit positions never wrap in practice, so full and empty stay distinguishable
+	// without a spare slot. They live on separate cache lines to avoid producer/consumer sharing.
+	alignas(64) std::atomic<uint64_t> write_index_{0};
+	alignas(64) std::atomic<uint64_t> read_index_{0};
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_SPSC_RING_BUFFER_H_
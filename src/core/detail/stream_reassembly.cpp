@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stream_reassembly.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace livekit {
+namespace core {
+namespace detail {
+namespace {
+
+constexpr std::size_t kMinimumStreamPayloadSegmentSize = 4 * 1024;
+
+} // namespace
+
+StreamPayload::StreamPayload(uint64_t spill_threshold) : spill_threshold_(spill_threshold) {}
+
+StreamPayload::~StreamPayload() { Release(); }
+
+bool StreamPayload::Append(const uint8_t* data, std::size_t size) {
+	if ((data == nullptr && size != 0) || size > std::numeric_limits<uint64_t>::max() - size_) {
+		return false;
+	}
+	if (spill_file_ == nullptr && spill_threshold_ != 0 && size_ + size > spill_threshold_ &&
+	    !Spill()) {
+		return false;
+	}
+	if (spill_file_ != nullptr) {
+		if (size != 0 && std::fwrite(data, 1, size, spill_file_) != size) {
+			return false;
+		}
+		size_ += size;
+		spilled_bytes_ += size;
+		return true;
+	}
+	while (size != 0) {
+		if (segments_.empty() || segments_.back().size() == segments_.back().capacity()) {
+			const auto capacity = std::clamp<uint64_t>(size_, kMinimumStreamPayloadSegmentSize,
+			                                           kStreamPayloadSegmentSize);
+			segments_.emplace_back();
+			segments_.back().reserve(static_cast<std::size_t>(capacity));
+			memory_bytes_ += segments_.back().capacity();
+		}
+		auto& segment = segments_.back();
+		const auto count = std::min(size, segment.capacity() - segment.size());
+		segment.insert(segment.end(), data, data + count);
+		data += count;
+		size -= count;
+		size_ += count;
+	}
+	return true;
+}
+
+bool StreamPayload::TakeBytes(std::vector<uint8_t>& output) {
+	if (size_ > output.max_size()) {
+		return false;
+	}
+	output.resize(static_cast<std::size_t>(size_));
+	const bool copied = CopyTo(output.data());
+	Release();
+	return copied;
+}
+
+bool StreamPayload::TakeText(std::string& output) {
+	if (size_ > output.max_size()) {
+		return false;
+	}
+	output.resize(static_cast<std::size_t>(size_));
+	const bool copied = CopyTo(reinterpret_cast<uint8_t*>(output.data()));
+	Release();
+	return copied;
+}
+
+bool StreamPayload::Spill() {
+	spill_file_ = std::tmpfile();
+	if (spill_file_ == nullptr) {
+		return false;
+	}
+	for (const auto& segment : segments_) {
+		if (!segment.empty() &&
+		    std::fwrite(segment.data(), 1, segment.size(), spill_file_) != segment.size()) {
+			return false;
+		}
+		spilled_bytes_ += segment.size();
+	}
+	segments_.clear();
+	segments_.shrink_to_fit();
+	memory_bytes_ = 0;
+	return true;
+}
+
+bool StreamPayload::CopyTo(uint8_t* output) {
+	if (spill_file_ == nullptr) {
+		for (const auto& segment : segments_) {
+			if (!segment.empty()) {
+				std::memcpy(output, segment.data(), segment.size());
+				output += segment.size();
+			}
+		}
+		return true;
+	}
+	return std::fflush(spill_file_) == 0 && std::fseek(spill_file_, 0, SEEK_SET) == 0 &&
+	       std::fread(output, 1, static_cast<std::size_t>(size_), spill_file_) == size_;
+}
+
+void StreamPayload::Release() {
+	segments_.clear();
+	segments_.shrink_to_fit();
+	if (spill_file_ != nullptr) {
+		// tmpfile() removes the file once it is closed.
+		std::fclose(spill_file_);
+		spill_file_ = nullptr;
+	}
+	size_ = 0;
+	memory_bytes_ = 0;
+	spilled_bytes_ = 0;
+}
+
+SerialTaskRunner::~SerialTaskRunner() { Stop(); }
+
+bool SerialTaskRunner::Post(std::function<void()> task) {
+	if (!task) {
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> guard(state_->mutex);
+		if (state_->stopped) {
+			return false;
+		}
+		state_->tasks.push_back(std::move(task));
+	}
+	state_->wake.notify_one();
+	std::lock_guard<std::mutex> guard(worker_mutex_);
+	if (!worker_.joinable()) {
+		worker_ = std::thread([state = state_] { Run(state); });
+	}
+	return true;
+}
+
+void SerialTaskRunner::Stop() {
+	{
+		std::lock_guard<std::mutex> guard(state_->mutex);
+		state_->stopped = true;
+		state_->tasks.clear();
+	}
+	state_->wake.notify_one();
+	std::thread worker;
+	{
+		std::lock_guard<std::mutex> guard(worker_mutex_);
+		worker.swap(worker_);
+	}
+	if (!worker.joinable()) {
+		return;
+	}
+	if (worker.get_id() == std::this_thread::get_id()) {
+		worker.detach();
+	} else {
+		worker.join();
+	}
+}
+
+void SerialTaskRunner::Run(const std::shared_ptr<State>& state) {
+	std::unique_lock<std::mutex> lock(state->mutex);
+	for (;;) {
+		state->wake.wait(lock, [&] { return state->stopped || !state->tasks.empty(); });
+		if (state->stopped) {
+			return;
+		}
+		auto task = std::move(state->tasks.front());
+		state->tasks.pop_front();
+		lock.unlock();
+		task();
+		// Release what the task captured before waiting for the next one.
+		task = nullptr;
+		lock.lock();
+	}
+}
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_STREAM_REASSEMBLY_H_
+#define _LKC_CORE_DETAIL_STREAM_REASSEMBLY_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+// Largest in-memory segment of a StreamPayload. Segments start small and double up to this size,
+// so short streams do not pay for a large allocation.
+constexpr std::size_t kStreamPayloadSegmentSize = 256 * 1024;
+
+// Accumulates an incoming data stream until it completes. Appends go into segments, so growing
+// the payload never moves bytes already held. Once the payload passes spill_threshold bytes, the
+// segments are written to an anonymous temporary file and later appends go to the file; a
+// threshold of 0 keeps everything in memory.
+class StreamPayload {
+public:
+	explicit StreamPayload(uint64_t spill_threshold);
+	~StreamPayload();
+	StreamPayload(const StreamPayload&) = delete;
+	StreamPayload& operator=(const StreamPayload&) = delete;
+
+	// Returns false when the temporary file cannot be created or written.
+	bool Append(const uint8_t* data, std::size_t size);
+	uint64_t Size() const noexcept { return size_; }
+	// Bytes allocated for segments, including the unused tail of the last one.
+	uint64_t MemoryBytes() const noexcept { return memory_bytes_; }
+	uint64_t SpilledBytes() const noexcept { return spilled_bytes_; }
+
+	// Moves the whole payload into output, reading back whatever was spilled, and releases the
+	// segments and the file.
+	bool TakeBytes(std::vector<uint8_t>& output);
+	bool TakeText(std::string& output);
+
+private:
+	bool Spill();
+	bool CopyTo(uint8_t* output);
+	void Release();
+
+	const uint64_t spill_threshold_;
+	std::vector<std::vector<uint8_t>> segments_;
+	std::FILE* spill_file_ = nullptr;
+	uint64_t size_ = 0;
+	uint64_t memory_bytes_ = 0;
+	uint64_t spilled_bytes_ = 0;
+};
+
+// Runs posted tasks in order on one thread, started with the first task. Room inflates and spills
+// incoming stream chunks here so the data channel thread never waits on zlib or the disk.
+class SerialTaskRunner {
+public:
+	SerialTaskRunner() = default;
+	~SerialTaskRunner();
+	SerialTaskRunner(const SerialTaskRunner&) = delete;
+	SerialTaskRunner& operator=(const SerialTaskRunner&) = delete;
+
+	// Returns false once the runner is stopped.
+	bool Post(std::function<void()> task);
+	// Drops queued tasks and waits for the running one. When called from a task, the thread is
+	// left to finish on its own instead.
+	void Stop();
+
+private:
+	// Shared with the thread, which may outlive the runner when Stop() is called from a task.
+	struct State {
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::deque<std::function<void()>> tasks;
+		bool stopped = false;
+	};
+
+	static void Run(const std::shared_ptr<State>& state);
+
+	std::shared_ptr<State> state_ = std::make_shared<State>();
+	std::mutex worker_mutex_;
+	std::thread worker_;
+};
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_STREAM_REASSEMBLY_H_
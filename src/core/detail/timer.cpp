@@ -13,4 +13,43 @@
  *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
  *See the License for the specific language governing permissions and
  *limitations under the License.
- */
\ No newline at end of file
+ */
+
+#include "timer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace livekit {
+namespace core {
+
+void Timer::Start(std::function<void()> function, int delay_ms, bool repeat) {
+	if (delay_ms < 0) {
+		throw std::invalid_argument("Timer delay must not be negative");
+	}
+	Stop();
+	const std::chrono::milliseconds delay(delay_ms);
+	// An interval of 0 repeats every tick rather than spinning.
+	const auto period = repeat ? std::max(delay, std::chrono::milliseconds(1))
+	                           : std::chrono::milliseconds::zero();
+	const auto id = detail::TimerWheel::Shared().Schedule(delay, std::move(function), period);
+	detail::TimerWheel::TimerId replaced = 0;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		replaced = std::exchange(id_, id);
+	}
+	// Another thread restarted the timer at the same time; the later start wins.
+	detail::TimerWheel::Shared().Cancel(replaced);
+}
+
+void Timer::Stop() {
+	detail::TimerWheel::TimerId id = 0;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		id = std::exchange(id_, 0);
+	}
+	detail::TimerWheel::Shared().Cancel(id);
+}
+
+} // namespace core
+} // namespace livekit
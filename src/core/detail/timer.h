@@ -20,82 +20,38 @@
 #ifndef _LKC_CORE_DETAIL_TIMER_H_
 #define _LKC_CORE_DETAIL_TIMER_H_
 
-#include <chrono>
-#include <condition_variable>
-#include <memory>
+#include "timer_wheel.h"
+
+#include <functional>
 #include <mutex>
-#include <stdexcept>
-#include <thread>
 #include <utility>
 
 namespace livekit {
 namespace core {
 
-class Timer : public std::enable_shared_from_this<Timer> {
+// A restartable timeout or interval on the shared TimerWheel thread. Destroying the timer stops it.
+class Timer {
 public:
 	~Timer() { Stop(); }
 
 	template <typename Function> void SetTimeout(Function function, int delay_ms) {
-		Start(std::move(function), delay_ms, false);
+		Start(std::function<void()>(std::move(function)), delay_ms, false);
 	}
 
 	template <typename Function> void SetInterval(Function function, int interval_ms) {
-		Start(std::move(function), interval_ms, true);
+		Start(std::function<void()>(std::move(function)), interval_ms, true);
 	}
 
+	// Waits for a callback already running, unless called from it.
 	void Stop();
 
 private:
-	template <typename Function> void Start(Function function, int delay_ms, bool repeat) {
-		if (delay_ms < 0) {
-			throw std::invalid_argument("Timer delay must not be negative");
-		}
-		Stop();
-		{
-			std::lock_guard<std::mutex> guard(mutex_);
-			active_ = true;
-		}
-
-		auto self = shared_from_this();
-		worker_ = std::thread([self, function = std::move(function), delay_ms, repeat]() mutable {
-			std::unique_lock<std::mutex> lock(self->mutex_);
-			do {
-				if (self->wake_.wait_for(lock, std::chrono::milliseconds(delay_ms),
-				                         [self]() { return !self->active_; })) {
-					return;
-				}
-				if (!repeat) {
-					self->active_ = false;
-				}
-				lock.unlock();
-				function();
-				lock.lock();
-			} while (self->active_ && repeat);
-		});
-	}
+	void Start(std::function<void()> function, int delay_ms, bool repeat);
 
 	std::mutex mutex_;
-	std::condition_variable wake_;
-	bool active_ = false;
-	std::thread worker_;
+	detail::TimerWheel::TimerId id_ = 0;
 };
 
-inline void Timer::Stop() {
-	{
-		std::lock_guard<std::mutex> guard(mutex_);
-		active_ = false;
-	}
-	wake_.notify_all();
-	if (!worker_.joinable()) {
-		return;
-	}
-	if (worker_.get_id() == std::this_thread::get_id()) {
-		worker_.detach();
-	} else {
-		worker_.join();
-	}
-}
-
 } // namespace core
 } // namespace livekit
 
@@ -0,0 +1,328 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace livekit {
+namespace core {
+namespace detail {
+namespace {
+
+constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+} // namespace
+
+TimerWheel::TimerWheel() { heads_.fill(kNone); }
+
+TimerWheel::~TimerWheel() {
+	std::vector<Entry> entries;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		stopping_ = true;
+		entries.swap(entries_);
+	}
+	wake_.notify_all();
+	idle_.notify_all();
+	if (worker_.joinable()) {
+		worker_.join();
+	}
+}
+
+TimerWheel& TimerWheel::Shared() {
+	static TimerWheel* wheel = new TimerWheel();
+	return *wheel;
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(std::chrono::milliseconds delay, Callback callback,
+                                         std::chrono::milliseconds period) {
+	if (!callback) {
+		throw std::invalid_argument("Timer callback must not be empty");
+	}
+	if (delay < std::chrono::milliseconds::zero() || period < std::chrono::milliseconds::zero()) {
+		throw std::invalid_argument("Timer delay must not be negative");
+	}
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (stopping_) {
+		return 0;
+	}
+	uint32_t index = 0;
+	if (free_.empty()) {
+		index = static_cast<uint32_t>(entries_.size());
+		entries_.emplace_back();
+	} else {
+		index = free_.back();
+		free_.pop_back();
+	}
+	auto& entry = entries_[index];
+	entry.callback = std::move(callback);
+	// One tick past the current one, so the timer never fires before delay has passed.
+	entry.expiry = TickAt(Clock::now()) + static_cast<uint64_t>(delay.count()) + 1;
+	entry.period = static_cast<uint64_t>(period.count());
+	entry.cancelled = false;
+	Link(index);
+	++active_;
+	const TimerId id = (static_cast<uint64_t>(entry.generation) << 32) | (index + 1);
+	if (!worker_.joinable()) {
+		worker_ = std::thread([this] { Run(); });
+	}
+	const bool earlier = entry.expiry < wake_tick_;
+	lock.unlock();
+	if (earlier) {
+		wake_.notify_one();
+	}
+	return id;
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+	const auto index = static_cast<uint32_t>(id & 0xFFFF'FFFFu) - 1;
+	const auto generation = static_cast<uint32_t>(id >> 32);
+	Callback callback;
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (id == 0 || index >= entries_.size() || entries_[index].generation != generation) {
+		return false;
+	}
+	auto& entry = entries_[index];
+	switch (entry.state) {
+	case EntryState::Free:
+		return false;
+	case EntryState::Linked:
+		Unlink(index);
+		callback = Release(index);
+		lock.unlock();
+		return true;
+	case EntryState::Due:
+		if (entry.cancelled) {
+			return false;
+		}
+		entry.cancelled = true;
+		return true;
+	case EntryState::Running:
+		if (entry.cancelled) {
+			return false;
+		}
+		entry.cancelled = true;
+		if (worker_.get_id() != std::this_thread::get_id()) {
+			idle_.wait(lock, [&] {
+				return entries_.size() <= index || entries_[index].generation != generation;
+			});
+		}
+		return true;
+	}
+	return false;
+}
+
+TimerWheel::Stats TimerWheel::GetStats() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	Stats stats;
+	stats.active = active_;
+	stats.threads = worker_.joinable() ? 1 : 0;
+	stats.fired = fired_;
+	stats.cascaded = cascaded_;
+	return stats;
+}
+
+uint64_t TimerWheel::TickAt(Clock::time_point time) const {
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(time - origin_);
+	return static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count()));
+}
+
+void TimerWheel::Link(uint32_t index) {
+	auto& entry = entries_[index];
+	// Entries are placed by their distance from the wheel's position, which may trail the clock
+	// while the thread sleeps; Advance() catches up tick by tick.
+	uint64_t at = std::max(entry.expiry, now_tick_);
+	uint64_t delta = at - now_tick_;
+	constexpr uint64_t kSpan = uint64_t{1} << (kSlotBits * kLevels);
+	if (delta >= kSpan) {
+		// Parked in the top level; Advance() relinks it when that slot cascades.
+		delta = kSpan - 1;
+		at = now_tick_ + delta;
+	}
+	uint32_t level = 0;
+	while (delta >= (uint64_t{1} << (kSlotBits * (level + 1)))) {
+		++level;
+	}
+	const auto position = static_cast<uint32_t>((at >> (kSlotBits * level)) & (kSlots - 1));
+	const uint32_t slot = level * kSlots + position;
+	entry.slot = slot;
+	entry.prev = kNone;
+	entry.next = heads_[slot];
+	entry.state = EntryState::Linked;
+	if (entry.next != kNone) {
+		entries_[entry.next].prev = index;
+	}
+	heads_[slot] = index;
+	occupied_[level] |= uint64_t{1} << position;
+}
+
+void TimerWheel::Unlink(uint32_t index) {
+	auto& entry = entries_[index];
+	if (entry.prev != kNone) {
+		entries_[entry.prev].next = entry.next;
+	} else {
+		heads_[entry.slot] = entry.next;
+		if (entry.next == kNone) {
+			occupied_[entry.slot / kSlots] &= ~(uint64_t{1} << (entry.slot % kSlots));
+		}
+	}
+	if (entry.next != kNone) {
+		entries_[entry.next].prev = entry.prev;
+	}
+	entry.prev = kNone;
+	entry.next = kNone;
+	entry.slot = kNone;
+}
+
+TimerWheel::Callback TimerWheel::Release(uint32_t index) {
+	auto& entry = entries_[index];
+	auto callback = std::move(entry.callback);
+	entry.callback = nullptr;
+	entry.state = EntryState::Free;
+	++entry.generation;
+	free_.push_back(index);
+	--active_;
+	return callback;
+}
+
+void TimerWheel::Advance(uint64_t target) {
+	while (now_tick_ < target) {
+		if (occupied_[0] == 0) {
+			// Nothing at level 0: skip to the tick before the next level 1 boundary.
+			now_tick_ = std::min(target, now_tick_ | (kSlots - 1));
+			if (now_tick_ == target) {
+				break;
+			}
+		}
+		++now_tick_;
+		for (uint32_t level = 1; level < kLevels; ++level) {
+			const uint32_t shift = kSlotBits * level;
+			if ((now_tick_ & ((uint64_t{1} << shift) - 1)) != 0) {
+				break;
+			}
+			const auto position = static_cast<uint32_t>((now_tick_ >> shift) & (kSlots - 1));
+			for (auto index = heads_[level * kSlots + position]; index != kNone;) {
+				const auto next = entries_[index].next;
+				Unlink(index);
+				Link(index);
+				++cascaded_;
+				index = next;
+			}
+		}
+		const auto position = static_cast<uint32_t>(now_tick_ & (kSlots - 1));
+		for (auto index = heads_[position]; index != kNone;) {
+			const auto next = entries_[index].next;
+			Unlink(index);
+			if (entries_[index].expiry > now_tick_) {
+				Link(index);
+			} else {
+				entries_[index].state = EntryState::Due;
+				due_.push_back(index);
+			}
+			index = next;
+		}
+	}
+}
+
+uint64_t TimerWheel::NextTick() const {
+	uint64_t next = kNever;
+	for (uint32_t level = 0; level < kLevels; ++level) {
+		if (occupied_[level] == 0) {
+			continue;
+		}
+		const uint32_t shift = kSlotBits * level;
+		const uint64_t current = now_tick_ >> shift;
+		// Bit 0 becomes the slot after the current one, so the distance is one more than the
+		// number of trailing zeros; a full turn returns to the current slot.
+		const auto rotation = static_cast<int>((current + 1) & (kSlots - 1));
+		const auto distance =
+		    static_cast<uint64_t>(std::countr_zero(std::rotr(occupied_[level], rotation))) + 1;
+		next = std::min(next, (current + distance) << shift);
+	}
+	return next;
+}
+
+void TimerWheel::Run() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (!stopping_) {
+		Advance(TickAt(Clock::now()));
+		if (!due_.empty()) {
+			RunDue(lock);
+			continue;
+		}
+		wake_tick_ = NextTick();
+		if (wake_tick_ == kNever) {
+			wake_.wait(lock);
+		} else {
+			wake_.wait_until(lock, origin_ + std::chrono::milliseconds(wake_tick_));
+		}
+		wake_tick_ = 0;
+	}
+}
+
+void TimerWheel::RunDue(std::unique_lock<std::mutex>& lock) {
+	std::vector<uint32_t> due;
+	due.swap(due_);
+	for (const auto index : due) {
+		if (stopping_) {
+			return;
+		}
+		Callback callback;
+		if (entries_[index].cancelled) {
+			callback = Release(index);
+			lock.unlock();
+			callback = nullptr;
+			lock.lock();
+			continue;
+		}
+		entries_[index].state = EntryState::Running;
+		callback = std::move(entries_[index].callback);
+		++fired_;
+		lock.unlock();
+		callback();
+		lock.lock();
+		if (stopping_) {
+			return;
+		}
+		auto& entry = entries_[index];
+		if (entry.period != 0 && !entry.cancelled) {
+			// A late run does not cause a burst; the next one is a period after the last deadline,
+			// or the next tick when that has passed too.
+			entry.expiry = std::max(entry.expiry + entry.period, now_tick_ + 1);
+			entry.callback = std::move(callback);
+			Link(index);
+		} else {
+			callback = Release(index);
+			lock.unlock();
+			callback = nullptr;
+			lock.lock();
+		}
+		idle_.notify_all();
+	}
+	due.clear();
+	if (due_.empty()) {
+		due_.swap(due);
+	}
+}
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_DETAIL_TIMER_WHEEL_H_
+#define _LKC_CORE_DETAIL_TIMER_WHEEL_H_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace livekit {
+namespace core {
+namespace detail {
+
+// Runs timers on one thread from a hierarchical timing wheel with a 1 ms tick: four levels of 64
+// slots cover about 4.6 hours, and later deadlines wait in the top level until they come into
+// range. Timers are pooled entries linked into their slot, so scheduling and cancelling cost the
+// same however many timers are active, and the thread sleeps until the next occupied slot.
+class TimerWheel {
+public:
+	using Callback = std::function<void()>;
+	// 0 is never a valid id.
+	using TimerId = uint64_t;
+
+	struct Stats {
+		std::size_t active = 0;
+		// 1 once a timer has been scheduled; all timers share the thread.
+		std::size_t threads = 0;
+		uint64_t fired = 0;
+		uint64_t cascaded = 0;
+	};
+
+	TimerWheel();
+	// Drops the timers still scheduled and stops the thread.
+	~TimerWheel();
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	// The wheel behind Timer and Debouncer. Never destroyed, so timers may still be cancelled
+	// from static destructors.
+	static TimerWheel& Shared();
+
+	// Runs callback on the wheel thread once delay has passed, then every period when period is
+	// positive. Callbacks share the thread with every other timer and should return quickly.
+	TimerId Schedule(std::chrono::milliseconds delay, Callback callback,
+	                 std::chrono::milliseconds period = std::chrono::milliseconds::zero());
+	// Returns false when the timer already fired for the last time or was cancelled. A callback
+	// running on the wheel thread is waited for, unless Cancel() is called from a callback.
+	bool Cancel(TimerId id);
+	Stats GetStats() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr uint32_t kSlotBits = 6;
+	static constexpr uint32_t kSlots = 1u << kSlotBits;
+	static constexpr uint32_t kLevels = 4;
+	static constexpr uint32_t kNone = UINT32_MAX;
+
+	enum class EntryState : uint8_t { Free, Linked, Due, Running };
+
+	struct Entry {
+		Callback callback;
+		// Absolute ticks since origin_.
+		uint64_t expiry = 0;
+		uint64_t period = 0;
+		uint32_t generation = 0;
+		uint32_t prev = kNone;
+		uint32_t next = kNone;
+		uint32_t slot = kNone;
+		EntryState state = EntryState::Free;
+		bool cancelled = false;
+	};
+
+	uint64_t TickAt(Clock::time_point time) const;
+	void Link(uint32_t index);
+	void Unlink(uint32_t index);
+	// Frees the entry and hands back its callback, to be destroyed outside the lock.
+	Callback Release(uint32_t index);
+	// Moves the wheel to target, cascading higher levels and collecting expired entries in due_.
+	void Advance(uint64_t target);
+	// The first tick at which Advance() has work, or kNever.
+	uint64_t NextTick() const;
+	void Run();
+	void RunDue(std::unique_lock<std::mutex>& lock);
+
+	const Clock::time_point origin_ = Clock::now();
+	mutable std::mutex mutex_;
+	std::condition_variable wake_;
+	// Signalled when a callback returns.
+	std::condition_variable idle_;
+	std::vector<Entry> entries_;
+	std::vector<uint32_t> free_;
+	std::vector<uint32_t> due_;
+	std::array<uint32_t, kLevels * kSlots> heads_;
+	std::array<uint64_t, kLevels> occupied_{};
+	uint64_t now_tick_ = 0;
+	uint64_t wake_tick_ = 0;
+	std::size_t active_ = 0;
+	uint64_t fired_ = 0;
+	uint64_t cascaded_ = 0;
+	bool stopping_ = false;
+	std::thread worker_;
+};
+
+} // namespace detail
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_DETAIL_TIMER_WHEEL_H_
@@ -87,16 +87,6 @@ Preset OriginalPreset(uint32_t width, uint32_t height, bool screen_share,
 	return result;
 }
 
-VideoQuality QualityForRid(const std::string& rid) {
-	if (rid == "q") {
-		return VideoQuality::Low;
-	}
-	if (rid == "h") {
-		return VideoQuality::Medium;
-	}
-	return VideoQuality::High;
-}
-
 std::string NormalizeCodec(std::string codec) {
 	std::transform(codec.begin(), codec.end(), codec.begin(),
 	               [](unsigned char value) { return static_cast<char>(std::tolower(value)); });
@@ -109,6 +99,16 @@ std::string NormalizeCodec(std::string codec) {
 
 } // namespace
 
+VideoQuality QualityForRid(const std::string& rid) {
+	if (rid == "q") {
+		return VideoQuality::Low;
+	}
+	if (rid == "h") {
+		return VideoQuality::Medium;
+	}
+	return VideoQuality::High;
+}
+
 const char* VideoCodecName(VideoCodec codec) {
 	switch (codec) {
 	case VideoCodec::H264:
@@ -187,12 +187,8 @@ VideoEncodingPlan BuildVideoEncodingPlan(uint32_t width, uint32_t height, bool s
 	return result;
 }
 
-bool ApplySubscribedQualities(std::vector<webrtc::RtpEncodingParameters>& encodings,
-                              const SubscribedQualityUpdate& update,
-                              const std::string& published_codec) {
-	if (encodings.size() < 2) {
-		return false;
-	}
+std::optional<std::map<VideoQuality, bool>>
+SubscribedLayers(const SubscribedQualityUpdate& update, const std::string& published_codec) {
 	const std::vector<SubscribedQuality>* qualities = nullptr;
 	if (!update.codecs.empty()) {
 		const auto normalized_codec = NormalizeCodec(published_codec);
@@ -206,6 +202,18 @@ bool ApplySubscribedQualities(std::vector<webrtc::RtpEncodingParameters>& encodi
 		qualities = &update.qualities;
 	}
 	if (qualities == nullptr || qualities->empty()) {
+		return std::nullopt;
+	}
+	std::map<VideoQuality, bool> layers;
+	for (const auto& quality : *qualities) {
+		layers[quality.quality] = quality.enabled;
+	}
+	return layers;
+}
+
+bool ApplyLayerActivation(std::vector<webrtc::RtpEncodingParameters>& encodings,
+                          const std::map<VideoQuality, bool>& layers) {
+	if (encodings.size() < 2) {
 		return false;
 	}
 	bool changed = false;
@@ -213,17 +221,21 @@ bool ApplySubscribedQualities(std::vector<webrtc::RtpEncodingParameters>& encodi
 		if (encoding.rid != "q" && encoding.rid != "h" && encoding.rid != "f") {
 			continue;
 		}
-		const auto quality = QualityForRid(encoding.rid);
-		const auto subscribed =
-		    std::find_if(qualities->begin(), qualities->end(),
-		                 [quality](const auto& candidate) { return candidate.quality == quality; });
-		if (subscribed != qualities->end() && encoding.active != subscribed->enabled) {
-			encoding.active = subscribed->enabled;
+		const auto layer = layers.find(QualityForRid(encoding.rid));
+		if (layer != layers.end() && encoding.active != layer->second) {
+			encoding.active = layer->second;
 			changed = true;
 		}
 	}
 	return changed;
 }
 
+bool ApplySubscribedQualities(std::vector<webrtc::RtpEncodingParameters>& encodings,
+                              const SubscribedQualityUpdate& update,
+                              const std::string& published_codec) {
+	const auto layers = SubscribedLayers(update, published_codec);
+	return layers.has_value() && ApplyLayerActivation(encodings, *layers);
+}
+
 } // namespace core
 } // namespace livekit
@@ -10,6 +10,9 @@
 #include "livekit_models.pb.h"
 
 #include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace livekit {
@@ -20,9 +23,17 @@ struct VideoEncodingPlan {
 	std::vector<livekit::VideoLayer> layers;
 };
 
+// Maps a simulcast rid (q, h, f) to its layer; anything else is treated as the top layer.
+VideoQuality QualityForRid(const std::string& rid);
 const char* VideoCodecName(VideoCodec codec);
 VideoEncodingPlan BuildVideoEncodingPlan(uint32_t width, uint32_t height, bool screen_share,
                                          const TrackPublishOptions& options);
+// The layers requested for the published codec, or nullopt when the update has none for it.
+std::optional<std::map<VideoQuality, bool>>
+SubscribedLayers(const SubscribedQualityUpdate& update, const std::string& published_codec);
+// Sets the active flag of the listed simulcast layers; returns whether any encoding changed.
+bool ApplyLayerActivation(std::vector<webrtc::RtpEncodingParameters>& encodings,
+                          const std::map<VideoQuality, bool>& layers);
 bool ApplySubscribedQualities(std::vector<webrtc::RtpEncodingParameters>& encodings,
                               const SubscribedQualityUpdate& update,
                               const std::string& published_codec);
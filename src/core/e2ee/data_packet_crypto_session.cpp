@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "data_packet_crypto_session.h"
+
+#include <openssl/aead.h>
+#include <openssl/mem.h>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/crypto_random.h"
+#include "rtc_base/time_utils.h"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+namespace livekit {
+namespace core {
+namespace {
+
+const EVP_AEAD* AesGcmForKeySize(std::size_t key_size) {
+	switch (key_size) {
+	case 16:
+		return EVP_aead_aes_128_gcm();
+	case 32:
+		return EVP_aead_aes_256_gcm();
+	default:
+		return nullptr;
+	}
+}
+
+void WriteUInt32(std::uint32_t value, std::uint8_t* out) {
+	out[0] = static_cast<std::uint8_t>(value >> 24);
+	out[1] = static_cast<std::uint8_t>(value >> 16);
+	out[2] = static_cast<std::uint8_t>(value >> 8);
+	out[3] = static_cast<std::uint8_t>(value);
+}
+
+// The AEAD seals and opens in place only when output starts at input; any other overlap would
+// read bytes it has already overwritten.
+bool OverlapsPartially(const DataPacketCryptoSession::Packet& packet) {
+	return packet.output.data() != packet.input.data() &&
+	       packet.output.data() < packet.input.data() + packet.input.size() &&
+	       packet.input.data() < packet.output.data() + packet.output.size();
+}
+
+} // namespace
+
+struct DataPacketCryptoSession::Context {
+	~Context() { OPENSSL_cleanse(key.data(), key.size()); }
+
+	std::vector<std::uint8_t> key;
+	bssl::ScopedEVP_AEAD_CTX aead;
+};
+
+DataPacketCryptoSession::DataPacketCryptoSession(
+    webrtc::scoped_refptr<webrtc::KeyProvider> key_provider,
+    webrtc::scoped_refptr<webrtc::DataPacketCryptor> ratchet_cryptor)
+    : key_provider_(std::move(key_provider)), ratchet_cryptor_(std::move(ratchet_cryptor)) {}
+
+DataPacketCryptoSession::~DataPacketCryptoSession() = default;
+
+std::size_t DataPacketCryptoSession::Encrypt(const std::string& participant_identity,
+                                             std::size_t key_index, std::span<Packet> packets) {
+	for (auto& packet : packets) {
+		packet.size = 0;
+		packet.ok = false;
+	}
+	const auto key_ring_size = static_cast<std::size_t>(key_provider_->options().key_ring_size);
+	const auto handler = key_index < key_ring_size ? Handler(participant_identity) : nullptr;
+	const KeySet key_set = handler ? handler->GetKeySet(static_cast<int>(key_index)) : nullptr;
+	if (!key_set) {
+		return 0;
+	}
+	const auto timestamp = static_cast<std::uint32_t>(webrtc::TimeMillis());
+	std::lock_guard<std::mutex> guard(mutex_);
+	const auto* context = ContextFor(participant_identity, key_index, key_set->encryption_key);
+	if (context == nullptr) {
+		return 0;
+	}
+	std::size_t sealed = 0;
+	for (auto& packet : packets) {
+		if (packet.output.size() < packet.input.size() + kTagSize || OverlapsPartially(packet)) {
+			continue;
+		}
+		MakeIv(timestamp, packet.iv);
+		std::size_t length = 0;
+		if (EVP_AEAD_CTX_seal(context->aead.get(), packet.output.data(), &length,
+		                      packet.output.size(), packet.iv.data(), packet.iv.size(),
+		                      packet.input.data(), packet.input.size(), nullptr, 0)) {
+			packet.key_index = key_index;
+			packet.size = length;
+			packet.ok = true;
+			++sealed;
+		}
+	}
+	return sealed;
+}
+
+std::size_t DataPacketCryptoSession::Decrypt(const std::string& participant_identity,
+                                             std::span<Packet> packets) {
+	for (auto& packet : packets) {
+		packet.size = 0;
+		packet.ok = false;
+	}
+	const auto handler = Handler(participant_identity);
+	if (!handler) {
+		return 0;
+	}
+	const auto key_ring_size = static_cast<std::size_t>(key_provider_->options().key_ring_size);
+	// Packets of a batch nearly always share a key index, so the key set is looked up again only
+	// when it changes or a ratchet may have replaced it.
+	std::size_t cached_index = key_ring_size;
+	KeySet key_set;
+	std::size_t opened = 0;
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (auto& packet : packets) {
+		if (packet.key_index >= key_ring_size || packet.input.size() < kTagSize ||
+		    packet.output.size() < packet.input.size() - kTagSize || OverlapsPartially(packet)) {
+			continue;
+		}
+		if (packet.key_index != cached_index) {
+			key_set = handler->GetKeySet(static_cast<int>(packet.key_index));
+			cached_index = packet.key_index;
+		}
+		if (!key_set) {
+			continue;
+		}
+		// A failed open wipes its output, so an in-place packet keeps its ciphertext for the
+		// ratchet search below.
+		const bool in_place = packet.output.data() == packet.input.data() && !packet.input.empty();
+		if (in_place) {
+			ciphertext_.assign(packet.input.begin(), packet.input.end());
+		}
+		const auto* context =
+		    ContextFor(participant_identity, packet.key_index, key_set->encryption_key);
+		std::size_t length = 0;
+		if (context != nullptr &&
+		    EVP_AEAD_CTX_open(context->aead.get(), packet.output.data(), &length,
+		                      packet.output.size(), packet.iv.data(), packet.iv.size(),
+		                      packet.input.data(), packet.input.size(), nullptr, 0)) {
+			packet.size = length;
+			packet.ok = true;
+			++opened;
+			continue;
+		}
+		// The sender may have ratcheted; the cryptor searches the window and keeps what it finds.
+		// The search derives keys, so other batches are not held up by it.
+		auto encrypted = webrtc::make_ref_counted<webrtc::EncryptedPacket>(
+		    in_place ? std::move(ciphertext_)
+		             : std::vector<std::uint8_t>(packet.input.begin(), packet.input.end()),
+		    std::vector<std::uint8_t>(packet.iv.begin(), packet.iv.end()),
+		    static_cast<std::uint8_t>(packet.key_index));
+		lock.unlock();
+		auto result = ratchet_cryptor_->Decrypt(participant_identity, encrypted);
+		lock.lock();
+		cached_index = key_ring_size;
+		if (!result.ok() || result.value().size() > packet.output.size()) {
+			continue;
+		}
+		const auto& plaintext = result.value();
+		std::copy(plaintext.begin(), plaintext.end(), packet.output.begin());
+		packet.size = plaintext.size();
+		packet.ok = true;
+		++opened;
+	}
+	return opened;
+}
+
+webrtc::scoped_refptr<webrtc::ParticipantKeyHandler>
+DataPacketCryptoSession::Handler(const std::string& participant_identity) const {
+	return key_provider_->options().shared_key ? key_provider_->GetSharedKey(participant_identity)
+	                                           : key_provider_->GetKey(participant_identity);
+}
+
+const DataPacketCryptoSession::Context*
+DataPacketCryptoSession::ContextFor(const std::string& participant_identity, std::size_t key_index,
+                                    const std::vector<std::uint8_t>& key) {
+	// Every participant uses the same keys with a shared key, so they share contexts too.
+	const std::string_view owner =
+	    key_provider_->options().shared_key ? std::string_view{} : participant_identity;
+	auto found = contexts_.find(owner);
+	if (found == contexts_.end()) {
+		found = contexts_.try_emplace(std::string(owner)).first;
+	}
+	auto& contexts = found->second;
+	if (key_index >= contexts.size()) {
+		contexts.resize(key_index + 1);
+	}
+	auto& context = contexts[key_index];
+	if (context && context->key.size() == key.size() &&
+	    CRYPTO_memcmp(context->key.data(), key.data(), key.size()) == 0) {
+		return context.get();
+	}
+	// A new or ratcheted key.
+	context.reset();
+	const EVP_AEAD* aead = AesGcmForKeySize(key.size());
+	if (aead == nullptr) {
+		return nullptr;
+	}
+	auto fresh = std::make_unique<Context>();
+	fresh->key = key;
+	if (!EVP_AEAD_CTX_init(fresh->aead.get(), aead, key.data(), key.size(), kTagSize, nullptr)) {
+		return nullptr;
+	}
+	context = std::move(fresh);
+	return context.get();
+}
+
+// The layout DataPacketCryptor uses: a random word, the send time in milliseconds, and the time
+// less a per-session counter.
+void DataPacketCryptoSession::MakeIv(std::uint32_t timestamp,
+                                     std::array<std::uint8_t, kIvSize>& iv) {
+	if (send_count_ == 0) {
+		send_count_ = webrtc::CreateRandomNonZeroId() * 0xFFFFu;
+	}
+	WriteUInt32(webrtc::CreateRandomId(), iv.data());
+	WriteUInt32(timestamp, iv.data() + 4);
+	WriteUInt32(timestamp - (send_count_ % 0xFFFF), iv.data() + 8);
+	++send_count_;
+}
+
+} // namespace core
+} // namespace livekit
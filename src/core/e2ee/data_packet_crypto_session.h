@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2026 sunze
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_E2EE_DATA_PACKET_CRYPTO_SESSION_H_
+#define _LKC_CORE_E2EE_DATA_PACKET_CRYPTO_SESSION_H_
+
+#include "api/crypto/frame_crypto_transformer.h"
+#include "api/scoped_refptr.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace livekit {
+namespace core {
+
+// Encrypts and decrypts data channel payloads in the EncryptedPacket format of
+// webrtc::DataPacketCryptor, without its per-packet allocations. Each participant's key index
+// keeps an initialised AES-GCM context for as long as its key stays the same. Packets are sealed
+// and opened straight into buffers the caller provides, and a batch looks up the participant's
+// keys once.
+//
+// A packet that does not open with the current key is handed to the DataPacketCryptor, which
+// searches the ratchet window and installs the key it finds. The session is not locked during
+// that search.
+class DataPacketCryptoSession {
+public:
+	static constexpr std::size_t kIvSize = 12;
+	static constexpr std::size_t kTagSize = 16;
+
+	// One packet of a batch. Encrypt() reads input and writes output, iv and key_index. Decrypt()
+	// reads input, iv and key_index and writes output. output may start at input.data() but must not
+	// otherwise overlap input; such a packet fails. output must hold input.size() + kTagSize bytes
+	// when encrypting and input.size() - kTagSize when decrypting.
+	struct Packet {
+		std::span<const std::uint8_t> input;
+		std::span<std::uint8_t> output;
+		std::array<std::uint8_t, kIvSize> iv{};
+		std::size_t key_index = 0;
+		// Bytes written to output.
+		std::size_t size = 0;
+		bool ok = false;
+	};
+
+	DataPacketCryptoSession(webrtc::scoped_refptr<webrtc::KeyProvider> key_provider,
+	                        webrtc::scoped_refptr<webrtc::DataPacketCryptor> ratchet_cryptor);
+	~DataPacketCryptoSession();
+
+	DataPacketCryptoSession(const DataPacketCryptoSession&) = delete;
+	DataPacketCryptoSession& operator=(const DataPacketCryptoSession&) = delete;
+
+	// Both return how many packets succeeded; each packet's ok says which.
+	std::size_t Encrypt(const std::string& participant_identity, std::size_t key_index,
+	                    std::span<Packet> packets);
+	std::size_t Decrypt(const std::string& participant_identity, std::span<Packet> packets);
+
+private:
+	struct Context;
+	using KeySet = webrtc::scoped_refptr<webrtc::ParticipantKeyHandler::KeySet>;
+
+	webrtc::scoped_refptr<webrtc::ParticipantKeyHandler>
+	Handler(const std::string& participant_identity) const;
+	// Expects mutex_ to be held.
+	const Context* ContextFor(const std::string& participant_identity, std::size_t key_index,
+	                          const std::vector<std::uint8_t>& key);
+	void MakeIv(std::uint32_t timestamp, std::array<std::uint8_t, kIvSize>& iv);
+
+	webrtc::scoped_refptr<webrtc::KeyProvider> key_provider_;
+	webrtc::scoped_refptr<webrtc::DataPacketCryptor> ratchet_cryptor_;
+	std::mutex mutex_;
+	// By participant identity, empty with a shared key, then indexed by key index.
+	std::map<std::string, std::vector<std::unique_ptr<Context>>, std::less<>> contexts_;
+	// Reused copy of an in-place packet's ciphertext.
+	std::vector<std::uint8_t> ciphertext_;
+	std::uint32_t send_count_ = 0;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_E2EE_DATA_PACKET_CRYPTO_SESSION_H_
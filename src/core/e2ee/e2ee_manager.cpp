@@ -16,6 +16,8 @@
  */
 #include "livekit/core/e2ee/e2ee_manager.h"
 
+#include "../detail/crypto_worker_pool.h"
+#include "../detail/key_schedule.h"
 #include "e2ee_manager_internal.h"
 #include "key_provider_internal.h"
 
@@ -23,6 +25,7 @@
 #include "api/make_ref_counted.h"
 #include "rtc_base/thread.h"
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 #include <stdexcept>
@@ -129,6 +132,8 @@ public:
 		data_cryptor_ = webrtc::make_ref_counted<webrtc::DataPacketCryptor>(
 		    webrtc::FrameCryptorTransformer::Algorithm::kAesGcm,
 		    KeyProviderNativeAccess::Get(keys_));
+		data_session_ = std::make_unique<DataPacketCryptoSession>(
+		    KeyProviderNativeAccess::Get(keys_), data_cryptor_);
 		if (options.shared_key) {
 			auto result = keys_.SetSharedKey(std::move(*options.shared_key), 0);
 			options.shared_key.reset();
@@ -237,6 +242,9 @@ public:
 				shared_state_->cryptors[key].enabled = effective;
 			}
 		}
+		if (!enabled) {
+			ForgetE2eeCipherContexts();
+		}
 		{
 			std::lock_guard<std::mutex> guard(enabled_callback_mutex_);
 			callback = enabled_callback_;
@@ -306,39 +314,71 @@ public:
 		return data_key_index_;
 	}
 
-	std::optional<E2EEManagerNativeAccess::EncryptedData>
-	EncryptData(const std::string& participant_identity, const std::vector<std::uint8_t>& payload) {
+	std::size_t EncryptData(const std::string& participant_identity,
+	                        std::span<DataPacketCryptoSession::Packet> packets) {
 		std::size_t key_index = 0;
 		{
 			std::lock_guard<std::mutex> guard(shared_state_->mutex);
 			if (!shared_state_->enabled) {
-				return std::nullopt;
+				for (auto& packet : packets) {
+					packet.ok = false;
+				}
+				return 0;
 			}
 			key_index = data_key_index_;
 		}
-		auto result =
-		    data_cryptor_->Encrypt(participant_identity, static_cast<int>(key_index), payload);
-		if (!result.ok() || !result.value()) {
+		return data_session_->Encrypt(participant_identity, key_index, packets);
+	}
+
+	std::size_t DecryptData(const std::string& participant_identity,
+	                        std::span<DataPacketCryptoSession::Packet> packets) {
+		{
+			std::lock_guard<std::mutex> guard(shared_state_->mutex);
+			if (!shared_state_->enabled) {
+				for (auto& packet : packets) {
+					packet.ok = false;
+				}
+				return 0;
+			}
+		}
+		return data_session_->Decrypt(participant_identity, packets);
+	}
+
+	std::optional<E2EEManagerNativeAccess::EncryptedData>
+	EncryptData(const std::string& participant_identity, const std::vector<std::uint8_t>& payload) {
+		E2EEManagerNativeAccess::EncryptedData encrypted;
+		encrypted.payload.resize(payload.size() + DataPacketCryptoSession::kTagSize);
+		DataPacketCryptoSession::Packet packet;
+		packet.input = payload;
+		packet.output = encrypted.payload;
+		if (EncryptData(participant_identity, {&packet, 1}) != 1) {
 			return std::nullopt;
 		}
-		return E2EEManagerNativeAccess::EncryptedData{result.value()->data, result.value()->iv,
-		                                              result.value()->key_index};
+		encrypted.payload.resize(packet.size);
+		encrypted.iv.assign(packet.iv.begin(), packet.iv.end());
+		encrypted.key_index = packet.key_index;
+		return encrypted;
 	}
 
 	std::optional<std::vector<std::uint8_t>>
 	DecryptData(const std::string& participant_identity,
 	            const E2EEManagerNativeAccess::EncryptedData& encrypted) {
-		{
-			std::lock_guard<std::mutex> guard(shared_state_->mutex);
-			if (!shared_state_->enabled || encrypted.key_index >= keys_.Options().key_ring_size) {
-				return std::nullopt;
-			}
+		if (encrypted.iv.size() != DataPacketCryptoSession::kIvSize ||
+		    encrypted.payload.size() < DataPacketCryptoSession::kTagSize) {
+			return std::nullopt;
+		}
+		std::vector<std::uint8_t> plaintext(encrypted.payload.size() -
+		                                    DataPacketCryptoSession::kTagSize);
+		DataPacketCryptoSession::Packet packet;
+		packet.input = encrypted.payload;
+		packet.output = plaintext;
+		std::copy(encrypted.iv.begin(), encrypted.iv.end(), packet.iv.begin());
+		packet.key_index = encrypted.key_index;
+		if (DecryptData(participant_identity, {&packet, 1}) != 1) {
+			return std::nullopt;
 		}
-		auto packet = webrtc::make_ref_counted<webrtc::EncryptedPacket>(
-		    encrypted.payload, encrypted.iv, static_cast<std::uint8_t>(encrypted.key_index));
-		auto result = data_cryptor_->Decrypt(participant_identity, packet);
-		return result.ok() ? std::optional<std::vector<std::uint8_t>>(result.value())
-		                   : std::nullopt;
+		plaintext.resize(packet.size);
+		return plaintext;
 	}
 
 	std::size_t SetParticipantEnabled(const std::string& participant_identity, bool enabled) {
@@ -421,6 +461,7 @@ private:
 	std::shared_ptr<SharedState> shared_state_;
 	std::unique_ptr<webrtc::Thread> signaling_thread_;
 	webrtc::scoped_refptr<webrtc::DataPacketCryptor> data_cryptor_;
+	std::unique_ptr<DataPacketCryptoSession> data_session_;
 	std::size_t data_key_index_ = 0;
 	mutable std::mutex entries_mutex_;
 	std::map<CryptorKey, Entry> entries_;
@@ -467,6 +508,30 @@ void E2EEManager::SetStateCallback(EncryptionStateCallback callback) {
 	impl_->SetStateCallback(std::move(callback));
 }
 
+FrameCryptorPoolStats GetFrameCryptorPoolStats() {
+	const auto pool = detail::CryptoWorkerPool::Shared().GetStats();
+	FrameCryptorPoolStats stats;
+	stats.workers = pool.workers;
+	stats.threads = pool.threads;
+	stats.frames = pool.completed;
+	stats.queue_depth.assign(pool.queue_depth.begin(), pool.queue_depth.end());
+	stats.latency_us.assign(pool.latency_us.begin(), pool.latency_us.end());
+	stats.max_latency_us = pool.max_latency_us;
+	return stats;
+}
+
+E2eeRatchetStats GetE2eeRatchetStats() {
+	const auto schedule = detail::KeySchedule::Shared().GetStats();
+	E2eeRatchetStats stats;
+	stats.searches = schedule.searches;
+	stats.hits = schedule.hits;
+	stats.misses = schedule.misses;
+	stats.precomputed_steps = schedule.precomputed_steps;
+	stats.total_latency_us = schedule.total_latency_us;
+	stats.max_latency_us = schedule.max_latency_us;
+	return stats;
+}
+
 bool E2EEManagerNativeAccess::AttachSender(
     E2EEManager& manager, std::string track_id, std::string participant_identity, TrackKind kind,
     webrtc::scoped_refptr<webrtc::RtpSenderInterface> sender) {
@@ -505,5 +570,17 @@ E2EEManagerNativeAccess::DecryptData(E2EEManager& manager, const std::string& pa
 	return manager.impl_->DecryptData(participant_identity, encrypted);
 }
 
+std::size_t
+E2EEManagerNativeAccess::EncryptData(E2EEManager& manager, const std::string& participant_identity,
+                                     std::span<DataPacketCryptoSession::Packet> packets) {
+	return manager.impl_->EncryptData(participant_identity, packets);
+}
+
+std::size_t
+E2EEManagerNativeAccess::DecryptData(E2EEManager& manager, const std::string& participant_identity,
+                                     std::span<DataPacketCryptoSession::Packet> packets) {
+	return manager.impl_->DecryptData(participant_identity, packets);
+}
+
 } // namespace core
 } // namespace livekit
@@ -2,12 +2,15 @@
 
 #include "livekit/core/e2ee/e2ee_manager.h"
 
+#include "data_packet_crypto_session.h"
+
 #include "api/rtp_receiver_interface.h"
 #include "api/rtp_sender_interface.h"
 #include "api/scoped_refptr.h"
 
 #include <functional>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace livekit {
@@ -37,6 +40,12 @@ public:
 	static std::optional<std::vector<std::uint8_t>>
 	DecryptData(E2EEManager& manager, const std::string& participant_identity,
 	            const EncryptedData& encrypted);
+	// Batched forms that seal and open into the packets' own buffers. They return how many
+	// packets succeeded, and fail every packet while E2EE is disabled.
+	static std::size_t EncryptData(E2EEManager& manager, const std::string& participant_identity,
+	                               std::span<DataPacketCryptoSession::Packet> packets);
+	static std::size_t DecryptData(E2EEManager& manager, const std::string& participant_identity,
+	                               std::span<DataPacketCryptoSession::Packet> packets);
 };
 
 } // namespace core
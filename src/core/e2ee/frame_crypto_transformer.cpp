@@ -18,10 +18,20 @@
 
 #include <openssl/evp.h>
 #include <openssl/hkdf.h>
+#include <openssl/mem.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
+#include "../detail/crypto_worker_pool.h"
+#include "../detail/key_schedule.h"
+#include "key_provider_internal.h"
 #include "absl/types/variant.h"
 #include "api/array_view.h"
 #include "common_video/h264/h264_common.h"
@@ -220,75 +230,228 @@ int DerivePBKDF2KeyFromRawKey(const std::vector<uint8_t>& raw_key, const std::ve
 	return Success;
 }
 
-int AesGcmEncryptDecrypt(EncryptOrDecrypt mode, const std::vector<uint8_t> raw_key,
-                         const webrtc::ArrayView<uint8_t> data, unsigned int tag_length_bytes,
-                         webrtc::ArrayView<uint8_t> iv, webrtc::ArrayView<uint8_t> additional_data,
-                         const EVP_AEAD* aead_alg, std::vector<uint8_t>* buffer) {
-	bssl::ScopedEVP_AEAD_CTX ctx;
+constexpr size_t kGcmTagSize = 16;
 
-	if (!aead_alg) {
-		RTC_LOG(LS_ERROR) << "Invalid AES-GCM key size.";
-		return ErrorUnexpected;
+// Initialised AES-GCM contexts for the keys this thread used most recently, so each key schedule is
+// expanded once rather than on every frame. The key provider flushes every thread's cache when its
+// keys change or are cleared, and a flushed or evicted context has its key and schedule wiped.
+class AeadContextCache {
+public:
+	static AeadContextCache& ForThisThread() {
+		thread_local AeadContextCache cache;
+		return cache;
 	}
 
-	if (!EVP_AEAD_CTX_init(ctx.get(), aead_alg, raw_key.data(), raw_key.size(), tag_length_bytes,
-	                       nullptr)) {
-		RTC_LOG(LS_ERROR) << "Failed to initialize AES-GCM context.";
-		return OperationError;
+	static void FlushAll() {
+		auto& registry = Caches();
+		std::lock_guard<std::mutex> guard(registry.mutex);
+		for (auto* cache : registry.caches) {
+			std::lock_guard<std::mutex> cache_guard(cache->mutex_);
+			cache->entries_.clear();
+		}
 	}
 
-	size_t len;
-	int ok;
+	AeadContextCache() {
+		auto& registry = Caches();
+		std::lock_guard<std::mutex> guard(registry.mutex);
+		registry.caches.push_back(this);
+	}
 
-	if (mode == EncryptOrDecrypt::kDecrypt) {
-		if (data.size() < tag_length_bytes) {
-			RTC_LOG(LS_ERROR) << "Data too small for AES-GCM tag.";
-			return ErrorDataTooSmall;
+	~AeadContextCache() {
+		auto& registry = Caches();
+		std::lock_guard<std::mutex> guard(registry.mutex);
+		registry.caches.erase(std::remove(registry.caches.begin(), registry.caches.end(), this),
+		                      registry.caches.end());
+	}
+
+	AeadContextCache(const AeadContextCache&) = delete;
+	AeadContextCache& operator=(const AeadContextCache&) = delete;
+
+	// Runs op with the context for raw_key, or with nullptr when it cannot be initialised. The
+	// context is only valid inside op, since a flush from another thread may wipe it afterwards.
+	template <typename Op>
+	int With(const EVP_AEAD* aead, const std::vector<uint8_t>& raw_key, size_t tag_length_bytes,
+	         Op&& op) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (auto entry = entries_.begin(); entry != entries_.end(); ++entry) {
+			if ((*entry)->Matches(aead, raw_key, tag_length_bytes)) {
+				std::rotate(entries_.begin(), entry, entry + 1);
+				return op(entries_.front()->ctx.get());
+			}
+		}
+		auto entry = std::make_unique<Entry>(aead, raw_key, tag_length_bytes);
+		if (!EVP_AEAD_CTX_init(entry->ctx.get(), aead, raw_key.data(), raw_key.size(),
+		                       tag_length_bytes, nullptr)) {
+			return op(nullptr);
 		}
+		if (entries_.size() == kCapacity) {
+			entries_.pop_back();
+		}
+		entries_.insert(entries_.begin(), std::move(entry));
+		return op(entries_.front()->ctx.get());
+	}
 
-		buffer->resize(data.size() - tag_length_bytes);
+private:
+	// Enough for every key index of a few participants on one worker.
+	static constexpr size_t kCapacity = 16;
 
-		ok = EVP_AEAD_CTX_open(ctx.get(), buffer->data(), &len, buffer->size(), iv.data(),
-		                       iv.size(), data.data(), data.size(), additional_data.data(),
-		                       additional_data.size());
-	} else {
-		buffer->resize(data.size() + EVP_AEAD_max_overhead(aead_alg));
+	struct Registry {
+		std::mutex mutex;
+		std::vector<AeadContextCache*> caches;
+	};
 
-		ok = EVP_AEAD_CTX_seal(ctx.get(), buffer->data(), &len, buffer->size(), iv.data(),
-		                       iv.size(), data.data(), data.size(), additional_data.data(),
-		                       additional_data.size());
+	// Never destroyed, so thread exit after static destruction still finds it.
+	static Registry& Caches() {
+		static auto* registry = new Registry();
+		return *registry;
 	}
 
-	if (!ok) {
-		RTC_LOG(LS_WARNING) << "Failed to perform AES-GCM operation.";
-		return OperationError;
-	}
+	struct Entry {
+		Entry(const EVP_AEAD* aead, const std::vector<uint8_t>& raw_key, size_t tag_length_bytes)
+		    : aead(aead), key(raw_key), tag_length_bytes(tag_length_bytes) {}
+		~Entry() {
+			OPENSSL_cleanse(key.data(), key.size());
+			// AES-GCM keeps its expanded key inline in the context and cleanup does not clear it.
+			EVP_AEAD_CTX_cleanup(ctx.get());
+			OPENSSL_cleanse(ctx.get(), sizeof(EVP_AEAD_CTX));
+		}
 
-	buffer->resize(len);
+		bool Matches(const EVP_AEAD* other_aead, const std::vector<uint8_t>& raw_key,
+		             size_t other_tag_length) const {
+			return aead == other_aead && tag_length_bytes == other_tag_length &&
+			       key.size() == raw_key.size() &&
+			       CRYPTO_memcmp(key.data(), raw_key.data(), key.size()) == 0;
+		}
 
-	return Success;
+		const EVP_AEAD* aead;
+		std::vector<uint8_t> key;
+		size_t tag_length_bytes;
+		bssl::ScopedEVP_AEAD_CTX ctx;
+	};
+
+	std::mutex mutex_;
+	std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+// Seals or opens data into out, which may be data itself. out must hold data.size() plus the tag
+// when encrypting, and data.size() less the tag when decrypting.
+int AesGcmEncryptDecrypt(EncryptOrDecrypt mode, const std::vector<uint8_t>& raw_key,
+                         webrtc::ArrayView<const uint8_t> data, unsigned int tag_length_bytes,
+                         webrtc::ArrayView<const uint8_t> iv,
+                         webrtc::ArrayView<const uint8_t> additional_data,
+                         const EVP_AEAD* aead_alg, webrtc::ArrayView<uint8_t> out,
+                         size_t* out_length) {
+	if (!aead_alg) {
+		RTC_LOG(LS_ERROR) << "Invalid AES-GCM key size.";
+		return ErrorUnexpected;
+	}
+
+	if (mode == EncryptOrDecrypt::kDecrypt && data.size() < tag_length_bytes) {
+		RTC_LOG(LS_ERROR) << "Data too small for AES-GCM tag.";
+		return ErrorDataTooSmall;
+	}
+
+	return AeadContextCache::ForThisThread().With(
+	    aead_alg, raw_key, tag_length_bytes, [&](const EVP_AEAD_CTX* ctx) -> int {
+		    if (ctx == nullptr) {
+			    RTC_LOG(LS_ERROR) << "Failed to initialize AES-GCM context.";
+			    return OperationError;
+		    }
+		    int ok;
+		    if (mode == EncryptOrDecrypt::kDecrypt) {
+			    ok = EVP_AEAD_CTX_open(ctx, out.data(), out_length, out.size(), iv.data(),
+			                           iv.size(), data.data(), data.size(),
+			                           additional_data.data(), additional_data.size());
+		    } else {
+			    ok = EVP_AEAD_CTX_seal(ctx, out.data(), out_length, out.size(), iv.data(),
+			                           iv.size(), data.data(), data.size(),
+			                           additional_data.data(), additional_data.size());
+		    }
+		    if (!ok) {
+			    RTC_LOG(LS_WARNING) << "Failed to perform AES-GCM operation.";
+			    return OperationError;
+		    }
+		    return Success;
+	    });
 }
 
 int AesEncryptDecrypt(EncryptOrDecrypt mode, webrtc::FrameCryptorTransformer::Algorithm algorithm,
-                      const std::vector<uint8_t>& raw_key, webrtc::ArrayView<uint8_t> iv,
-                      webrtc::ArrayView<uint8_t> additional_data,
-                      const webrtc::ArrayView<uint8_t> data, std::vector<uint8_t>* buffer) {
+                      const std::vector<uint8_t>& raw_key, webrtc::ArrayView<const uint8_t> iv,
+                      webrtc::ArrayView<const uint8_t> additional_data,
+                      webrtc::ArrayView<const uint8_t> data, webrtc::ArrayView<uint8_t> out,
+                      size_t* out_length) {
 	switch (algorithm) {
 	case webrtc::FrameCryptorTransformer::Algorithm::kAesGcm: {
-		unsigned int tag_length_bits = 128;
 		const EVP_AEAD* cipher = GetAesGcmAlgorithmFromKeySize(raw_key.size());
 		if (!cipher) {
 			RTC_LOG(LS_ERROR) << "Invalid AES-GCM key size.";
 			return ErrorUnexpected;
 		}
-		return AesGcmEncryptDecrypt(mode, raw_key, data, tag_length_bits / 8, iv, additional_data,
-		                            cipher, buffer);
+		return AesGcmEncryptDecrypt(mode, raw_key, data, kGcmTagSize, iv, additional_data, cipher,
+		                            out, out_length);
 	}
 	default:
 		RTC_LOG(LS_ERROR) << "Unsupported algorithm.";
 		return ErrorUnexpected;
 	}
 }
+
+// The size AesEncryptDecrypt() needs for out.
+size_t AesOutputSize(EncryptOrDecrypt mode, size_t data_size) {
+	if (mode == EncryptOrDecrypt::kEncrypt) {
+		return data_size + kGcmTagSize;
+	}
+	return data_size < kGcmTagSize ? 0 : data_size - kGcmTagSize;
+}
+
+int AesEncryptDecrypt(EncryptOrDecrypt mode, webrtc::FrameCryptorTransformer::Algorithm algorithm,
+                      const std::vector<uint8_t>& raw_key, webrtc::ArrayView<const uint8_t> iv,
+                      webrtc::ArrayView<const uint8_t> additional_data,
+                      webrtc::ArrayView<const uint8_t> data, std::vector<uint8_t>* buffer) {
+	buffer->resize(AesOutputSize(mode, data.size()));
+	size_t length = 0;
+	const int result =
+	    AesEncryptDecrypt(mode, algorithm, raw_key, iv, additional_data, data, *buffer, &length);
+	buffer->resize(result == Success ? length : 0);
+	return result;
+}
+
+// Tries the precomputed ratchets of material, up to window of them, and returns through
+// new_material the one whose key opened the payload. Nothing is derived here: a step the key
+// schedule has not computed yet ends the search, and the frame is dropped instead of waiting on
+// PBKDF2.
+template <typename TryKey>
+livekit::core::detail::KeySchedule::RatchetOutcome
+SearchRatchetWindow(webrtc::KeyProvider* key_provider, const std::vector<uint8_t>& material,
+                    int window, TryKey&& try_key, std::vector<uint8_t>* new_material) {
+	using livekit::core::detail::KeySchedule;
+	auto& schedule = KeySchedule::Shared();
+	const auto owner = reinterpret_cast<uintptr_t>(key_provider);
+	const auto started = std::chrono::steady_clock::now();
+	auto outcome = KeySchedule::RatchetOutcome::Exhausted;
+	auto current = material;
+	for (int attempt = 1; attempt <= window; ++attempt) {
+		auto step = schedule.FindRatchet(owner, current);
+		if (!step) {
+			RTC_LOG(LS_INFO) << "ratchet step " << attempt << " of " << window
+			                 << " is not precomputed yet";
+			outcome = KeySchedule::RatchetOutcome::Miss;
+			break;
+		}
+		RTC_LOG(LS_INFO) << "ratcheting key attempt " << attempt << " of " << window;
+		if (try_key(step->key)) {
+			*new_material = std::move(step->material);
+			outcome = KeySchedule::RatchetOutcome::Hit;
+			break;
+		}
+		current = std::move(step->material);
+	}
+	OPENSSL_cleanse(current.data(), current.size());
+	schedule.RecordRatchet(outcome, std::chrono::duration_cast<std::chrono::microseconds>(
+	                                    std::chrono::steady_clock::now() - started));
+	return outcome;
+}
+
 namespace webrtc {
 
 int ParticipantKeyHandler::DoKeyDerivation(const std::vector<uint8_t>& key,
@@ -297,33 +460,43 @@ int ParticipantKeyHandler::DoKeyDerivation(const std::vector<uint8_t>& key,
                                            std::vector<uint8_t>& derived_key) {
 	RTC_DCHECK_GE(optional_length_bits, 8);
 	RTC_DCHECK_EQ(optional_length_bits % 8, 0);
+	// Every ratchet and key derivation passes through here, so the key schedule's background
+	// precomputation leaves its results where the frame path will look for them.
+	auto& schedule = livekit::core::detail::KeySchedule::Shared();
+	const auto owner = reinterpret_cast<uintptr_t>(&*key_provider_);
+	if (auto known = schedule.FindDerived(owner, key, salt, optional_length_bits)) {
+		derived_key = std::move(*known);
+		return Success;
+	}
+	int result = OperationError;
 	switch (key_provider_->options().key_derivation_algorithm) {
 	case KeyDerivationAlgorithm::kPBKDF2:
-		return DerivePBKDF2KeyFromRawKey(key, salt, optional_length_bits, derived_key);
+		result = DerivePBKDF2KeyFromRawKey(key, salt, optional_length_bits, derived_key);
+		break;
 	case KeyDerivationAlgorithm::kHKDF:
-		return DeriveHkdfSha256FromSecret(key, salt, optional_length_bits, derived_key);
-	default:
+		result = DeriveHkdfSha256FromSecret(key, salt, optional_length_bits, derived_key);
 		break;
+	default:
+		RTC_LOG(LS_ERROR) << "Invalid key derivation algorithm !";
+		return OperationError;
 	}
-
-	RTC_LOG(LS_ERROR) << "Invalid key derivation algorithm !";
-
-	return OperationError;
+	if (result == Success) {
+		schedule.StoreDerived(owner, key, salt, optional_length_bits, derived_key);
+	}
+	return result;
 }
 
 FrameCryptorTransformer::FrameCryptorTransformer(webrtc::Thread* signaling_thread,
                                                  const std::string participant_id, MediaType type,
                                                  Algorithm algorithm,
                                                  webrtc::scoped_refptr<KeyProvider> key_provider)
-    : signaling_thread_(signaling_thread), thread_(webrtc::Thread::Create()),
-      participant_id_(participant_id), type_(type), algorithm_(algorithm),
-      key_provider_(key_provider) {
+    : signaling_thread_(signaling_thread), participant_id_(participant_id), type_(type),
+      algorithm_(algorithm), key_provider_(key_provider) {
 	RTC_DCHECK(key_provider_ != nullptr);
-	thread_->SetName("FrameCryptorTransformer", this);
-	thread_->Start();
 }
 
-FrameCryptorTransformer::~FrameCryptorTransformer() { thread_->Stop(); }
+// Queued frames hold a reference, so nothing of this cryptor is left on the worker pool.
+FrameCryptorTransformer::~FrameCryptorTransformer() = default;
 
 void FrameCryptorTransformer::Transform(
     std::unique_ptr<webrtc::TransformableFrameInterface> frame) {
@@ -333,19 +506,20 @@ void FrameCryptorTransformer::Transform(
 		return;
 	}
 
-	// do encrypt or decrypt here...
+	// Every frame of this cryptor runs on one worker of the shared pool, in order. Keying by the
+	// cryptor rather than the SSRC also keeps the IV counters and error state single-threaded.
+	auto& pool = livekit::core::detail::CryptoWorkerPool::Shared();
+	const auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this));
 	switch (frame->GetDirection()) {
 	case webrtc::TransformableFrameInterface::Direction::kSender:
-		RTC_DCHECK(thread_ != nullptr);
-		thread_->PostTask([frame = std::move(frame),
-		                   self = webrtc::scoped_refptr<FrameCryptorTransformer>(this)]() mutable {
+		pool.Post(key, [frame = std::move(frame),
+		                self = webrtc::scoped_refptr<FrameCryptorTransformer>(this)]() mutable {
 			self->encryptFrame(std::move(frame));
 		});
 		break;
 	case webrtc::TransformableFrameInterface::Direction::kReceiver:
-		RTC_DCHECK(thread_ != nullptr);
-		thread_->PostTask([frame = std::move(frame),
-		                   self = webrtc::scoped_refptr<FrameCryptorTransformer>(this)]() mutable {
+		pool.Post(key, [frame = std::move(frame),
+		                self = webrtc::scoped_refptr<FrameCryptorTransformer>(this)]() mutable {
 			self->decryptFrame(std::move(frame));
 		});
 		break;
@@ -423,47 +597,46 @@ void FrameCryptorTransformer::encryptFrame(
 		return;
 	}
 
-	webrtc::Buffer frame_header(unencrypted_bytes);
-	for (size_t i = 0; i < unencrypted_bytes; i++) {
-		frame_header[i] = data_in[i];
-	}
-
-	webrtc::Buffer frame_trailer(2);
-	frame_trailer[0] = getIvSize();
-	frame_trailer[1] = static_cast<std::uint8_t>(key_index);
+	// The frame is laid out as header | payload, sealed in place into ciphertext and tag, then the
+	// IV and the trailer, in one buffer sized up front.
+	constexpr size_t kTrailerSize = 2;
+	const size_t iv_size = getIvSize();
+	const size_t payload_size = data_in.size() - unencrypted_bytes;
+	const size_t sealed_size = AesOutputSize(EncryptOrDecrypt::kEncrypt, payload_size);
+	webrtc::Buffer sealed(unencrypted_bytes + sealed_size + iv_size + kTrailerSize);
+	std::copy(data_in.begin(), data_in.end(), sealed.begin());
 	webrtc::Buffer iv = makeIv(frame->GetSsrc(), frame->GetTimestamp());
+	RTC_CHECK_EQ(iv.size(), iv_size);
+	webrtc::ArrayView<const uint8_t> frame_header(sealed.data(), unencrypted_bytes);
+	webrtc::ArrayView<uint8_t> payload(sealed.data() + unencrypted_bytes, payload_size);
+	webrtc::ArrayView<uint8_t> ciphertext(sealed.data() + unencrypted_bytes, sealed_size);
 
-	webrtc::Buffer payload(data_in.size() - unencrypted_bytes);
-	for (size_t i = unencrypted_bytes; i < data_in.size(); i++) {
-		payload[i - unencrypted_bytes] = data_in[i];
-	}
-
-	std::vector<uint8_t> buffer;
+	size_t ciphertext_size = 0;
 	if (AesEncryptDecrypt(EncryptOrDecrypt::kEncrypt, algorithm_, key_set->encryption_key, iv,
-	                      frame_header, payload, &buffer) == Success) {
-		webrtc::Buffer encrypted_payload(buffer.data(), buffer.size());
-		webrtc::Buffer data_without_header;
-		data_without_header.AppendData(encrypted_payload);
-		data_without_header.AppendData(iv);
-		data_without_header.AppendData(frame_trailer);
-
-		webrtc::Buffer data_out;
-		data_out.AppendData(frame_header);
+	                      frame_header, payload, ciphertext, &ciphertext_size) == Success) {
+		RTC_CHECK_EQ(ciphertext_size, sealed_size);
+		uint8_t* trailer = std::copy(iv.begin(), iv.end(), ciphertext.end());
+		trailer[0] = static_cast<uint8_t>(iv_size);
+		trailer[1] = static_cast<uint8_t>(key_index);
 
 		if (FrameIsH264(frame.get(), type_)) {
-			H264::WriteRbsp(data_without_header.data(), data_without_header.size(), &data_out);
+			webrtc::Buffer data_out;
+			data_out.EnsureCapacity(sealed.size() + sealed.size() / 64);
+			data_out.AppendData(frame_header);
+			H264::WriteRbsp(ciphertext.data(), sealed.size() - unencrypted_bytes, &data_out);
+			frame->SetData(data_out);
 #ifdef RTC_ENABLE_H265
 		} else if (FrameIsH265(frame.get(), type_)) {
-			H265::WriteRbsp(data_without_header.data(), data_without_header.size(), &data_out);
+			webrtc::Buffer data_out;
+			data_out.EnsureCapacity(sealed.size() + sealed.size() / 64);
+			data_out.AppendData(frame_header);
+			H265::WriteRbsp(ciphertext.data(), sealed.size() - unencrypted_bytes, &data_out);
+			frame->SetData(data_out);
 #endif // RTC_ENABLE_H265
 		} else {
-			data_out.AppendData(data_without_header);
-			RTC_CHECK_EQ(data_out.size(), frame_header.size() + encrypted_payload.size() +
-			                                  iv.size() + frame_trailer.size());
+			frame->SetData(sealed);
 		}
 
-		frame->SetData(data_out);
-
 		if (last_enc_error_ != FrameCryptionState::kOk) {
 			last_enc_error_ = FrameCryptionState::kOk;
 			onFrameCryptionStateChanged(last_enc_error_);
@@ -547,28 +720,23 @@ void FrameCryptorTransformer::decryptFrame(
 		return;
 	}
 
-	webrtc::Buffer frame_header(unencrypted_bytes);
-	for (size_t i = 0; i < unencrypted_bytes; i++) {
-		frame_header[i] = data_in[i];
-	}
-
-	webrtc::Buffer encrypted_buffer(data_in.size() - unencrypted_bytes);
-	for (size_t i = unencrypted_bytes; i < data_in.size(); i++) {
-		encrypted_buffer[i - unencrypted_bytes] = data_in[i];
-	}
-
+	// Read the frame where it is; only an escaped H.264/H.265 frame needs a copy.
+	webrtc::ArrayView<const uint8_t> frame_header = data_in.subview(0, unencrypted_bytes);
+	webrtc::ArrayView<const uint8_t> encrypted_buffer = data_in.subview(unencrypted_bytes);
+	webrtc::Buffer unescaped;
 	if (FrameIsH264(frame.get(), type_) &&
 	    NeedsRbspUnescaping(encrypted_buffer.data(), encrypted_buffer.size())) {
-		encrypted_buffer.SetData(H264::ParseRbsp(encrypted_buffer.data(), encrypted_buffer.size()));
+		unescaped.SetData(H264::ParseRbsp(encrypted_buffer.data(), encrypted_buffer.size()));
+		encrypted_buffer = unescaped;
 #ifdef RTC_ENABLE_H265
 	} else if (FrameIsH265(frame.get(), type_) &&
 	           NeedsRbspUnescaping(encrypted_buffer.data(), encrypted_buffer.size())) {
-		encrypted_buffer.SetData(H265::ParseRbsp(encrypted_buffer.data(), encrypted_buffer.size()));
+		unescaped.SetData(H265::ParseRbsp(encrypted_buffer.data(), encrypted_buffer.size()));
+		encrypted_buffer = unescaped;
 #endif // RTC_ENABLE_H265
 	}
 
 	constexpr size_t kTrailerSize = 2;
-	constexpr size_t kGcmTagSize = 16;
 	if (encrypted_buffer.size() < kTrailerSize) {
 		if (last_dec_error_ != FrameCryptionState::kDecryptionFailed) {
 			last_dec_error_ = FrameCryptionState::kDecryptionFailed;
@@ -603,76 +771,62 @@ void FrameCryptorTransformer::decryptFrame(
 	}
 	auto key_set = key_handler->GetKeySet(key_index);
 
-	webrtc::Buffer iv(ivLength);
-	for (size_t i = 0; i < ivLength; i++) {
-		iv[i] = encrypted_buffer[encrypted_buffer.size() - kTrailerSize - ivLength + i];
-	}
-
-	webrtc::Buffer encrypted_payload(encrypted_buffer.size() - ivLength - kTrailerSize);
-	for (size_t i = 0; i < encrypted_payload.size(); i++) {
-		encrypted_payload[i] = encrypted_buffer[i];
-	}
+	webrtc::ArrayView<const uint8_t> iv =
+	    encrypted_buffer.subview(encrypted_buffer.size() - kTrailerSize - ivLength, ivLength);
+	webrtc::ArrayView<const uint8_t> encrypted_payload =
+	    encrypted_buffer.subview(0, encrypted_buffer.size() - ivLength - kTrailerSize);
 
-	std::vector<uint8_t> buffer;
+	// The payload is opened straight into the frame's new data, after its header.
+	webrtc::Buffer data_out(unencrypted_bytes +
+	                        AesOutputSize(EncryptOrDecrypt::kDecrypt, encrypted_payload.size()));
+	std::copy(frame_header.begin(), frame_header.end(), data_out.begin());
+	webrtc::ArrayView<uint8_t> plaintext(data_out.data() + unencrypted_bytes,
+	                                     data_out.size() - unencrypted_bytes);
+	size_t plaintext_size = 0;
 
-	int ratchet_count = 0;
-	auto initialKeyMaterial = key_set->material;
 	bool decryption_success = false;
+	bool ratchet_pending = false;
 	if (AesEncryptDecrypt(EncryptOrDecrypt::kDecrypt, algorithm_, key_set->encryption_key, iv,
-	                      frame_header, encrypted_payload, &buffer) == Success) {
+	                      frame_header, encrypted_payload, plaintext, &plaintext_size) == Success) {
 		decryption_success = true;
 	} else {
 		RTC_LOG(LS_WARNING) << "FrameCryptorTransformer::decryptFrame() failed";
-		webrtc::scoped_refptr<ParticipantKeyHandler::KeySet> ratcheted_key_set;
-		auto currentKeyMaterial = key_set->material;
-		if (key_provider_->options().ratchet_window_size > 0) {
-			while (ratchet_count < key_provider_->options().ratchet_window_size) {
-				ratchet_count++;
-
-				RTC_LOG(LS_INFO) << "ratcheting key attempt " << ratchet_count << " of "
-				                 << key_provider_->options().ratchet_window_size;
-
-				auto new_material = key_handler->RatchetKeyMaterial(currentKeyMaterial);
-				ratcheted_key_set = key_handler->DeriveKeys(
-				    new_material, key_provider_->options().ratchet_salt, 128);
-				if (new_material.empty() || !ratcheted_key_set) {
-					break;
+		const int window = key_provider_->options().ratchet_window_size;
+		if (window > 0) {
+			std::vector<uint8_t> new_material;
+			const auto outcome = SearchRatchetWindow(
+			    key_provider_.get(), key_set->material, window,
+			    [&](const std::vector<uint8_t>& key) {
+				    return AesEncryptDecrypt(EncryptOrDecrypt::kDecrypt, algorithm_, key, iv,
+				                             frame_header, encrypted_payload, plaintext,
+				                             &plaintext_size) == Success;
+			    },
+			    &new_material);
+			if (outcome == livekit::core::detail::KeySchedule::RatchetOutcome::Hit) {
+				RTC_LOG(LS_INFO) << "FrameCryptorTransformer::decryptFrame() "
+				                    "ratcheted to key_index="
+				                 << static_cast<int>(key_index);
+				decryption_success = true;
+				// success, so we set the new key; its derivation was precomputed too
+				key_handler->SetKeyFromMaterial(new_material, key_index);
+				key_handler->SetHasValidKey();
+				if (last_dec_error_ != FrameCryptionState::kKeyRatcheted) {
+					last_dec_error_ = FrameCryptionState::kKeyRatcheted;
+					onFrameCryptionStateChanged(last_dec_error_);
 				}
-
-				if (AesEncryptDecrypt(EncryptOrDecrypt::kDecrypt, algorithm_,
-				                      ratcheted_key_set->encryption_key, iv, frame_header,
-				                      encrypted_payload, &buffer) == Success) {
-					RTC_LOG(LS_INFO) << "FrameCryptorTransformer::decryptFrame() "
-					                    "ratcheted to key_index="
-					                 << static_cast<int>(key_index);
-					decryption_success = true;
-					// success, so we set the new key
-					key_handler->SetKeyFromMaterial(new_material, key_index);
-					key_handler->SetHasValidKey();
-					if (last_dec_error_ != FrameCryptionState::kKeyRatcheted) {
-						last_dec_error_ = FrameCryptionState::kKeyRatcheted;
-						onFrameCryptionStateChanged(last_dec_error_);
-					}
-					break;
-				}
-				// for the next ratchet attempt
-				currentKeyMaterial = new_material;
-			}
-
-			/* Since the key it is first send and only afterwards actually used for
-			  encrypting, there were situations when the decrypting failed due to the
-			  fact that the received frame was not encrypted yet and ratcheting, of
-			  course, did not solve the problem. So if we fail RATCHET_WINDOW_SIZE
-			  times, we come back to the initial key.
-			 */
-			if (!decryption_success) {
-				key_handler->SetKeyFromMaterial(initialKeyMaterial, key_index);
+				// The material moved, so the window moves with it. A miss needs nothing queued:
+				// the window for the current material was queued when the key was set.
+				livekit::core::PrecomputeE2eeRatchetWindow(key_provider_, key_handler, key_index);
 			}
+			ratchet_pending =
+			    outcome == livekit::core::detail::KeySchedule::RatchetOutcome::Miss;
 		}
 	}
 
 	if (!decryption_success) {
-		if (key_handler->DecryptionFailure()) {
+		// A frame dropped while its ratchet is still being precomputed says nothing about the
+		// key, so it does not count towards the failure tolerance.
+		if (!ratchet_pending && key_handler->DecryptionFailure()) {
 			if (last_dec_error_ != FrameCryptionState::kDecryptionFailed) {
 				last_dec_error_ = FrameCryptionState::kDecryptionFailed;
 				onFrameCryptionStateChanged(last_dec_error_);
@@ -681,10 +835,7 @@ void FrameCryptorTransformer::decryptFrame(
 		return;
 	}
 
-	webrtc::Buffer payload(buffer.data(), buffer.size());
-	webrtc::Buffer data_out;
-	data_out.AppendData(frame_header);
-	data_out.AppendData(payload);
+	data_out.SetSize(unencrypted_bytes + plaintext_size);
 	frame->SetData(data_out);
 
 	if (last_dec_error_ != FrameCryptionState::kOk) {
@@ -763,8 +914,8 @@ DataPacketCryptor::Encrypt(const std::string participant_id, int key_index,
 	auto iv = makeIv(timestamp);                      // for data packets, ssrc is always 0
 
 	std::vector<uint8_t> buffer;
-	webrtc::Buffer payload(data.data(), data.size());
-	auto frame_header = webrtc::Buffer(0); // no frame header for data packets
+	webrtc::ArrayView<const uint8_t> payload(data);
+	webrtc::ArrayView<const uint8_t> frame_header; // no frame header for data packets
 	if (AesEncryptDecrypt(EncryptOrDecrypt::kEncrypt, algorithm_, key_set->encryption_key, iv,
 	                      frame_header, payload, &buffer) == Success) {
 		webrtc::scoped_refptr<EncryptedPacket> encryptedPacket =
@@ -798,12 +949,11 @@ DataPacketCryptor::Decrypt(const std::string participant_id,
 	}
 
 	std::vector<uint8_t> buffer;
-	webrtc::Buffer encrypted_payload(encryptedPacket->data.data(), encryptedPacket->data.size());
-	webrtc::Buffer iv(encryptedPacket->iv.data(), encryptedPacket->iv.size());
-	auto frame_header = webrtc::Buffer(0); // no frame header for data packets
+	webrtc::ArrayView<const uint8_t> encrypted_payload(encryptedPacket->data);
+	webrtc::ArrayView<const uint8_t> iv(encryptedPacket->iv);
+	webrtc::ArrayView<const uint8_t> frame_header; // no frame header for data packets
 
 	auto key_set = key_handler->GetKeySet(key_index);
-	auto initialKeyMaterial = key_set->material;
 	bool decryption_success = false;
 
 	if (AesEncryptDecrypt(EncryptOrDecrypt::kDecrypt, algorithm_, key_set->encryption_key, iv,
@@ -812,47 +962,26 @@ DataPacketCryptor::Decrypt(const std::string participant_id,
 	} else {
 		RTC_LOG(LS_WARNING) << "DataPacketCryptor::Decrypt() failed with key_index "
 		                    << static_cast<int>(key_index);
-		webrtc::scoped_refptr<ParticipantKeyHandler::KeySet> ratcheted_key_set;
-		auto currentKeyMaterial = key_set->material;
-		int ratchet_count = 0;
-		if (key_provider_->options().ratchet_window_size > 0) {
-			while (ratchet_count < key_provider_->options().ratchet_window_size) {
-				ratchet_count++;
-
-				RTC_LOG(LS_INFO) << "ratcheting key attempt " << ratchet_count << " of "
-				                 << key_provider_->options().ratchet_window_size;
-
-				auto new_material = key_handler->RatchetKeyMaterial(currentKeyMaterial);
-				ratcheted_key_set = key_handler->DeriveKeys(
-				    new_material, key_provider_->options().ratchet_salt, 128);
-				if (new_material.empty() || !ratcheted_key_set) {
-					break;
-				}
-
-				if (AesEncryptDecrypt(EncryptOrDecrypt::kDecrypt, algorithm_,
-				                      ratcheted_key_set->encryption_key, iv, frame_header,
-				                      encrypted_payload, &buffer) == Success) {
-					RTC_LOG(LS_INFO) << "DataPacketCryptor::Decrypt() successfully "
-					                    "ratcheted to key_index="
-					                 << static_cast<int>(key_index);
-					decryption_success = true;
-					// success, so we set the new key
-					key_handler->SetKeyFromMaterial(new_material, key_index);
-					key_handler->SetHasValidKey();
-					break;
-				}
-				// for the next ratchet attempt
-				currentKeyMaterial = new_material;
-			}
-
-			/* Since the key it is first send and only afterwards actually used for
-			  encrypting, there were situations when the decrypting failed due to the
-			  fact that the received frame was not encrypted yet and ratcheting, of
-			  course, did not solve the problem. So if we fail RATCHET_WINDOW_SIZE
-			  times, we come back to the initial key.
-			 */
-			if (!decryption_success) {
-				key_handler->SetKeyFromMaterial(initialKeyMaterial, key_index);
+		const int window = key_provider_->options().ratchet_window_size;
+		if (window > 0) {
+			std::vector<uint8_t> new_material;
+			const auto outcome = SearchRatchetWindow(
+			    key_provider_.get(), key_set->material, window,
+			    [&](const std::vector<uint8_t>& key) {
+				    return AesEncryptDecrypt(EncryptOrDecrypt::kDecrypt, algorithm_, key, iv,
+				                             frame_header, encrypted_payload,
+				                             &buffer) == Success;
+			    },
+			    &new_material);
+			if (outcome == livekit::core::detail::KeySchedule::RatchetOutcome::Hit) {
+				RTC_LOG(LS_INFO) << "DataPacketCryptor::Decrypt() successfully "
+				                    "ratcheted to key_index="
+				                 << static_cast<int>(key_index);
+				decryption_success = true;
+				// success, so we set the new key; its derivation was precomputed too
+				key_handler->SetKeyFromMaterial(new_material, key_index);
+				key_handler->SetHasValidKey();
+				livekit::core::PrecomputeE2eeRatchetWindow(key_provider_, key_handler, key_index);
 			}
 		}
 	}
@@ -881,3 +1010,11 @@ webrtc::Buffer DataPacketCryptor::makeIv(uint32_t timestamp) {
 }
 
 } // namespace webrtc
+
+namespace livekit {
+namespace core {
+
+void ForgetE2eeCipherContexts() { AeadContextCache::FlushAll(); }
+
+} // namespace core
+} // namespace livekit
@@ -9,12 +9,16 @@
 
 #include "key_provider_internal.h"
 
+#include "../detail/key_schedule.h"
+
 #include <openssl/crypto.h>
 
 #include "api/make_ref_counted.h"
 #include "rtc_base/synchronization/mutex.h"
 
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 
@@ -60,6 +64,10 @@ public:
 			entry.second->SetKey(key, key_index);
 		}
 		Cleanse(key);
+		ForgetE2eeCipherContexts();
+		// The clones hold the same material, so the shared handler's window serves them all.
+		PrecomputeE2eeRatchetWindow(webrtc::scoped_refptr<webrtc::KeyProvider>(this), shared_,
+		                            key_index);
 		return true;
 	}
 
@@ -93,6 +101,9 @@ public:
 		for (auto& entry : shared_clones_) {
 			entry.second->SetKey(key, key_index);
 		}
+		ForgetE2eeCipherContexts();
+		PrecomputeE2eeRatchetWindow(webrtc::scoped_refptr<webrtc::KeyProvider>(this), shared_,
+		                            key_index);
 		return key;
 	}
 
@@ -113,6 +124,9 @@ public:
 		}
 		handler->SetKey(key, key_index);
 		Cleanse(key);
+		ForgetE2eeCipherContexts();
+		PrecomputeE2eeRatchetWindow(webrtc::scoped_refptr<webrtc::KeyProvider>(this), handler,
+		                            key_index);
 		return true;
 	}
 
@@ -140,7 +154,13 @@ public:
 			handler = participant_keys_.emplace(participant_id, clone->second).first;
 			shared_clones_.erase(clone);
 		}
-		return handler->second->RatchetKey(key_index);
+		auto key = handler->second->RatchetKey(key_index);
+		if (!key.empty()) {
+			ForgetE2eeCipherContexts();
+			PrecomputeE2eeRatchetWindow(webrtc::scoped_refptr<webrtc::KeyProvider>(this),
+			                            handler->second, key_index);
+		}
+		return key;
 	}
 
 	const E2eeKey ExportKey(const std::string participant_id, int key_index) const override {
@@ -168,6 +188,7 @@ public:
 		shared_ = RebuildWithout(shared_, key_index);
 		CleanseMap(shared_clones_);
 		shared_clones_.clear();
+		ForgetE2eeCipherContexts();
 		return true;
 	}
 
@@ -181,6 +202,7 @@ public:
 			return false;
 		}
 		handler->second = RebuildWithout(handler->second, key_index);
+		ForgetE2eeCipherContexts();
 		return true;
 	}
 
@@ -188,17 +210,23 @@ public:
 		webrtc::MutexLock lock(&mutex_);
 		const bool explicit_removed = RemoveAndCleanse(participant_keys_, participant_id);
 		const bool clone_removed = RemoveAndCleanse(shared_clones_, participant_id);
+		if (explicit_removed || clone_removed) {
+			ForgetE2eeCipherContexts();
+		}
 		return explicit_removed || clone_removed;
 	}
 
 	void Clear() {
 		webrtc::MutexLock lock(&mutex_);
+		detail::KeySchedule::Shared().Forget(
+		    reinterpret_cast<uintptr_t>(static_cast<webrtc::KeyProvider*>(this)));
 		CleanseHandler(shared_);
 		shared_ = nullptr;
 		CleanseMap(participant_keys_);
 		CleanseMap(shared_clones_);
 		participant_keys_.clear();
 		shared_clones_.clear();
+		ForgetE2eeCipherContexts();
 	}
 
 private:
@@ -442,5 +470,37 @@ webrtc::scoped_refptr<webrtc::KeyProvider> KeyProviderNativeAccess::Get(KeyProvi
 	return provider.impl_->native;
 }
 
+void PrecomputeE2eeRatchetWindow(webrtc::scoped_refptr<webrtc::KeyProvider> provider,
+                                 webrtc::scoped_refptr<webrtc::ParticipantKeyHandler> handler,
+                                 int key_index) {
+	if (!provider || !handler) {
+		return;
+	}
+	const int window = provider->options().ratchet_window_size;
+	const auto key_set = handler->GetKeySet(key_index);
+	if (window <= 0 || !key_set) {
+		return;
+	}
+	// The job holds both references, so the handler's back pointer stays valid until it ends.
+	const auto owner = reinterpret_cast<uintptr_t>(provider.get());
+	using Ratchet = detail::KeySchedule::Ratchet;
+	detail::KeySchedule::Shared().Precompute(
+	    owner, key_set->material, static_cast<std::size_t>(window),
+	    [provider, handler](const E2eeKey& material) -> std::optional<Ratchet> {
+		    // Both derivations go through DoKeyDerivation, which also remembers them, so the
+		    // SetKeyFromMaterial() after a successful ratchet does not derive again.
+		    auto next = handler->RatchetKeyMaterial(material);
+		    if (next.empty()) {
+			    return std::nullopt;
+		    }
+		    auto ratcheted = handler->DeriveKeys(next, provider->options().ratchet_salt, 128);
+		    Cleanse(next);
+		    if (!ratcheted) {
+			    return std::nullopt;
+		    }
+		    return Ratchet{ratcheted->material, ratcheted->encryption_key};
+	    });
+}
+
 } // namespace core
 } // namespace livekit
@@ -13,5 +13,15 @@ public:
 	static webrtc::scoped_refptr<webrtc::KeyProvider> Get(KeyProvider& provider);
 };
 
+// Queues derivation of the ratchet window after handler's key at key_index on the key schedule's
+// thread, so decryption can ratchet without deriving keys. Only enqueues; safe under any lock.
+void PrecomputeE2eeRatchetWindow(webrtc::scoped_refptr<webrtc::KeyProvider> provider,
+                                 webrtc::scoped_refptr<webrtc::ParticipantKeyHandler> handler,
+                                 int key_index);
+
+// Wipes the AES-GCM contexts every thread cached for frame encryption. Called whenever keys are
+// replaced, ratcheted, removed or cleared, and when E2EE is disabled.
+void ForgetE2eeCipherContexts();
+
 } // namespace core
 } // namespace livekit
@@ -31,6 +31,7 @@ RoomOptions default_room_options() {
 	option.rtc_config.ice_transport_type = IceTransportsType::All;
 	option.sdk_options.sdk = "cpp";
 	option.sdk_options.sdk_version = "0.0.1";
+	option.video_frame_delivery = VideoFrameDelivery::Packed;
 	return option;
 }
 
@@ -19,6 +19,8 @@
 
 #include "../detail/converted_proto.h"
 #include "../detail/data_stream_compression.h"
+#include "../detail/file_reader.h"
+#include "../detail/file_stream_pipeline.h"
 #include "../detail/video_encoding.h"
 #include "../e2ee/e2ee_manager_internal.h"
 #include "../track/audio_source.h"
@@ -30,13 +32,15 @@
 #include "../track/video_track.h"
 
 #include "livekit/core/room_event_interface.h"
+#include "livekit/core/track/rtc_stats.h"
 #include "livekit_models.pb.h"
 #include "rtc_base/crypto_random.h"
+#include "rtc_base/logging.h"
 
 #include <algorithm>
 #include <chrono>
 #include <filesystem>
-#include <fstream>
+#include <future>
 #include <utility>
 
 namespace livekit {
@@ -87,6 +91,16 @@ namespace {
 
 constexpr std::size_t kMaximumDataStreamChunkSize = 15'000;
 constexpr uint64_t kMaximumCompressedDataStreamSize = 64ULL * 1024 * 1024;
+// Long enough to ride out a subscriber switching layers and back, short enough that an unwatched
+// layer stops costing encoder time quickly.
+constexpr std::chrono::milliseconds kDynacastPauseDelay{800};
+
+std::size_t SimulcastLayerCount(LocalTrackPublication* publication) {
+	auto* local_track = dynamic_cast<LocalTrack*>(publication->Track());
+	auto transceiver = local_track != nullptr ? local_track->Transceiver() : nullptr;
+	auto sender = transceiver != nullptr ? transceiver->sender() : nullptr;
+	return sender != nullptr ? sender->GetParameters().encodings.size() : 0;
+}
 
 int64_t CurrentTimestampMilliseconds() {
 	return std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -94,6 +108,20 @@ int64_t CurrentTimestampMilliseconds() {
 	    .count();
 }
 
+bool SameBatchingOptions(const DataBatchingOptions& lhs, const DataBatchingOptions& rhs) {
+	return lhs.window_ms == rhs.window_ms && lhs.max_batch_bytes == rhs.max_batch_bytes;
+}
+
+void AddBatchingStats(DataBatchingStats& total, const DataBatchingStats& stats) {
+	total.messages += stats.messages;
+	total.packets += stats.packets;
+	total.failed_packets += stats.failed_packets;
+	total.max_messages_per_packet =
+	    std::max(total.max_messages_per_packet, stats.max_messages_per_packet);
+	total.total_added_latency_us += stats.total_added_latency_us;
+	total.max_added_latency_us = std::max(total.max_added_latency_us, stats.max_added_latency_us);
+}
+
 template <typename Options>
 void PopulateStreamPacket(livekit::DataPacket& packet, const Options& options) {
 	for (const auto& identity : options.destination_identities) {
@@ -115,54 +143,28 @@ void PopulateStreamHeader(livekit::DataStream_Header& header, const std::string&
 	}
 }
 
-template <typename Options>
-bool SendStreamChunks(RtcEngine* engine, const std::string& stream_id, const uint8_t* data,
-                      std::size_t size, const Options& options, uint64_t& chunk_index) {
-	if (engine == nullptr || options.chunk_size == 0 ||
-	    options.chunk_size > kMaximumDataStreamChunkSize || (data == nullptr && size != 0)) {
-		return false;
-	}
-	for (std::size_t offset = 0; offset < size; offset += options.chunk_size) {
-		const auto count = std::min(options.chunk_size, size - offset);
-		livekit::DataPacket chunk_packet;
-		PopulateStreamPacket(chunk_packet, options);
-		auto* chunk = chunk_packet.mutable_stream_chunk();
-		chunk->set_stream_id(stream_id);
-		chunk->set_chunk_index(chunk_index++);
-		chunk->set_content(data + offset, count);
-		if (!engine->SendDataPacket(chunk_packet, true)) {
-			return false;
-		}
-	}
-	return true;
-}
-
 template <typename Options>
 bool SendStreamPayload(RtcEngine* engine, const std::string& stream_id, const uint8_t* data,
-                       std::size_t size, const Options& options) {
+                       std::size_t size, const Options& options,
+                       const DataStreamCompressionOptions& compression) {
 	if (options.compress && size > kMaximumCompressedDataStreamSize) {
 		return false;
 	}
-	std::vector<uint8_t> compressed;
-	if (options.compress) {
-		detail::DeflateRawStream deflater;
-		if (!deflater.IsValid()) {
-			return false;
-		}
-		for (std::size_t offset = 0; offset < size; offset += options.chunk_size) {
-			const auto count = std::min(options.chunk_size, size - offset);
-			if (!deflater.Write(data + offset, count, compressed)) {
-				return false;
-			}
-		}
-		if (!deflater.Finish(compressed)) {
-			return false;
-		}
-		data = compressed.data();
-		size = compressed.size();
-	}
+	// Compressed chunks go out as each deflate block finishes, not after the whole payload.
+	livekit::DataPacket chunk_packet;
+	PopulateStreamPacket(chunk_packet, options);
+	auto* chunk = chunk_packet.mutable_stream_chunk();
+	chunk->set_stream_id(stream_id);
 	uint64_t chunk_index = 0;
-	if (!SendStreamChunks(engine, stream_id, data, size, options, chunk_index)) {
+	const bool sent = detail::StreamFileChunks(
+	    data, size, options.chunk_size, options.compress, compression,
+	    [&](const uint8_t* content, std::size_t content_size) {
+		    chunk->set_chunk_index(chunk_index++);
+		    chunk->set_content(content, content_size);
+		    return engine->SendDataPacket(chunk_packet, true);
+	    },
+	    {});
+	if (!sent) {
 		return false;
 	}
 
@@ -206,11 +208,12 @@ public:
 	OutgoingStreamWriterBase(std::shared_ptr<OutgoingDataStreamState> state, DataStreamInfo info,
 	                         std::vector<std::string> destination_identities,
 	                         std::size_t chunk_size, int32_t version,
-	                         DataStreamProgressHandler progress, bool compress)
+	                         DataStreamProgressHandler progress, bool compress,
+	                         const DataStreamCompressionOptions& compression)
 	    : state_(std::move(state)), info_(std::move(info)),
 	      destination_identities_(std::move(destination_identities)), chunk_size_(chunk_size),
 	      version_(version), progress_(std::move(progress)),
-	      deflater_(compress ? std::make_unique<detail::DeflateRawStream>() : nullptr) {}
+	      deflater_(compress ? std::make_unique<detail::DeflateRawStream>(compression) : nullptr) {}
 
 	virtual ~OutgoingStreamWriterBase() { CancelInternal("writer destroyed before close"); }
 
@@ -362,10 +365,11 @@ private:
 class TextStreamWriter final : public TextStreamWriterInterface, private OutgoingStreamWriterBase {
 public:
 	TextStreamWriter(std::shared_ptr<OutgoingDataStreamState> state, TextStreamInfo info,
-	                 StreamTextOptions options)
-	    : OutgoingStreamWriterBase(
-	          std::move(state), info, std::move(options.destination_identities), options.chunk_size,
-	          options.version, std::move(options.on_progress), options.compress),
+	                 StreamTextOptions options, const DataStreamCompressionOptions& compression)
+	    : OutgoingStreamWriterBase(std::move(state), info,
+	                               std::move(options.destination_identities), options.chunk_size,
+	                               options.version, std::move(options.on_progress),
+	                               options.compress, compression),
 	      text_info_(std::move(info)) {}
 
 	TextStreamInfo Info() const override { return text_info_; }
@@ -383,10 +387,10 @@ private:
 class ByteStreamWriter final : public ByteStreamWriterInterface, private OutgoingStreamWriterBase {
 public:
 	ByteStreamWriter(std::shared_ptr<OutgoingDataStreamState> state, ByteStreamInfo info,
-	                 StreamBytesOptions options)
+	                 StreamBytesOptions options, const DataStreamCompressionOptions& compression)
 	    : OutgoingStreamWriterBase(std::move(state), info,
 	                               std::move(options.destination_identities), options.chunk_size, 0,
-	                               std::move(options.on_progress), options.compress),
+	                               std::move(options.on_progress), options.compress, compression),
 	      byte_info_(std::move(info)) {}
 
 	ByteStreamInfo Info() const override { return byte_info_; }
@@ -401,6 +405,86 @@ private:
 	ByteStreamInfo byte_info_;
 };
 
+// A file stream whose header has been sent. It holds no participant state, so SendFileAsync can
+// finish it on the file worker while the participant shuts down; sends then fail and the stream
+// ends.
+struct FileStream {
+	std::shared_ptr<OutgoingDataStreamState> state;
+	std::unique_ptr<detail::FileReader> file;
+	std::string stream_id;
+	FileSendOptions options;
+	DataStreamCompressionOptions compression;
+};
+
+std::unique_ptr<FileStream> OpenFileStream(std::shared_ptr<OutgoingDataStreamState> state,
+                                           const std::string& path, FileSendOptions options,
+                                           const DataStreamCompressionOptions& compression) {
+	if (!state || options.chunk_size == 0 || options.chunk_size > kMaximumDataStreamChunkSize) {
+		return nullptr;
+	}
+	auto file = detail::FileReader::Open(path);
+	if (!file || (options.compress && file->Size() > kMaximumCompressedDataStreamSize)) {
+		return nullptr;
+	}
+	auto stream = std::make_unique<FileStream>();
+	stream->state = std::move(state);
+	stream->file = std::move(file);
+	stream->stream_id = webrtc::CreateRandomUuid();
+
+	livekit::DataPacket header_packet;
+	PopulateStreamPacket(header_packet, options);
+	auto* header = header_packet.mutable_stream_header();
+	PopulateStreamHeader(*header, stream->stream_id, stream->file->Size(), options);
+	header->set_mime_type(options.mime_type);
+	header->mutable_byte_header()->set_name(std::filesystem::path(path).filename().string());
+	if (!stream->state->Send(header_packet)) {
+		return nullptr;
+	}
+	stream->options = std::move(options);
+	stream->compression = compression;
+	return stream;
+}
+
+bool RunFileStream(FileStream& stream) {
+	const auto& options = stream.options;
+	const uint64_t total_size = stream.file->Size();
+	// One packet carries every chunk; only the index and content change between sends.
+	livekit::DataPacket chunk_packet;
+	PopulateStreamPacket(chunk_packet, options);
+	auto* chunk = chunk_packet.mutable_stream_chunk();
+	chunk->set_stream_id(stream.stream_id);
+	uint64_t chunk_index = 0;
+	const auto& file = *stream.file;
+	const bool sent = detail::StreamFileChunks(
+	    [&](uint64_t offset, uint8_t* buffer, std::size_t size) {
+		    return file.ReadAt(offset, buffer, size);
+	    },
+	    total_size, options.chunk_size, options.compress, stream.compression,
+	    [&](const uint8_t* data, std::size_t size) {
+		    chunk->set_chunk_index(chunk_index++);
+		    chunk->set_content(data, size);
+		    return stream.state->Send(chunk_packet);
+	    },
+	    [&](uint64_t bytes_sent) {
+		    if (options.on_progress) {
+			    options.on_progress(bytes_sent, total_size);
+		    }
+	    });
+
+	livekit::DataPacket trailer_packet;
+	PopulateStreamPacket(trailer_packet, options);
+	auto* trailer = trailer_packet.mutable_stream_trailer();
+	trailer->set_stream_id(stream.stream_id);
+	if (!sent) {
+		trailer->set_reason("file stream failed");
+	}
+	const bool finished = stream.state->Send(trailer_packet) && sent;
+	if (options.on_complete) {
+		options.on_complete(stream.stream_id, finished);
+	}
+	return finished;
+}
+
 } // namespace
 
 LocalParticipant::LocalParticipant(std::string sid, std::string identity,
@@ -413,7 +497,31 @@ LocalParticipant::LocalParticipant(std::string sid, std::string identity,
 	is_local_participant_ = true;
 }
 
-LocalParticipant::~LocalParticipant() { outgoing_stream_state_->Invalidate(); }
+LocalParticipant::~LocalParticipant() {
+	// The batcher's flush thread sends through this participant; stop it first. The engine may
+	// already be disconnected, so whatever is still queued is dropped rather than sent.
+	std::shared_ptr<DataBatcher> batcher;
+	{
+		std::lock_guard<std::mutex> guard(data_batcher_mutex_);
+		batcher.swap(data_batcher_);
+	}
+	batcher.reset();
+	std::shared_ptr<DynacastController> dynacast;
+	{
+		std::lock_guard<std::mutex> guard(dynacast_mutex_);
+		dynacast.swap(dynacast_);
+	}
+	dynacast.reset();
+	outgoing_stream_state_->Invalidate();
+	// With sends invalidated, queued and running file streams fail their next chunk and end; wait
+	// for them so each still reports on_complete, then stop the worker.
+	std::promise<void> drained;
+	auto drained_future = drained.get_future();
+	if (file_stream_worker_.Post([&drained] { drained.set_value(); })) {
+		drained_future.wait();
+	}
+	file_stream_worker_.Stop();
+}
 
 void LocalParticipant::UpdateFromInfo(const livekit::ParticipantInfo& info) {
 	const auto owned_publications = TrackPublicationsSnapshot();
@@ -623,6 +731,9 @@ bool LocalParticipant::UnpublishTrack(LocalTrackInterface* track, bool stop_on_u
 	}
 
 	local_track->SetTransceiver(nullptr);
+	if (auto dynacast = Dynacast()) {
+		dynacast->Remove(local_track->Sid());
+	}
 	RemoveTrackPublication(local_track->Sid());
 	{
 		std::lock_guard<std::mutex> guard(local_track_subscriptions_mutex_);
@@ -677,22 +788,12 @@ void LocalParticipant::SubscribedQualityUpdate(core::SubscribedQualityUpdate upd
 		return;
 	}
 	local_publication->UpdateSubscribedQuality(update);
-	bool dynacast = false;
-	{
-		std::lock_guard<std::mutex> guard(room_options_mutex_);
-		dynacast = options_.dynacast;
-	}
-	if (dynacast) {
-		auto* local_track = dynamic_cast<LocalTrack*>(local_publication->Track());
-		auto transceiver = local_track != nullptr ? local_track->Transceiver() : nullptr;
-		auto sender = transceiver != nullptr ? transceiver->sender() : nullptr;
-		if (sender != nullptr) {
-			auto parameters = sender->GetParameters();
-			const auto options = local_publication->PublishOptions();
-			if (ApplySubscribedQualities(parameters.encodings, update,
-			                             VideoCodecName(options.video_codec))) {
-				sender->SetParameters(parameters);
-			}
+	auto dynacast = Dynacast();
+	if (dynacast && SimulcastLayerCount(local_publication) > 1) {
+		const auto options = local_publication->PublishOptions();
+		if (auto layers = SubscribedLayers(update, VideoCodecName(options.video_codec))) {
+			local_publication->AttachDynacast(dynacast);
+			dynacast->Update(update.track_sid, *layers);
 		}
 	}
 	if (auto* listener = event_listener_.load()) {
@@ -739,6 +840,10 @@ bool LocalParticipant::RepublishAllTracks() {
 }
 
 void LocalParticipant::DetachTrackTransceiversForReconnect() {
+	// Republished senders start with every layer active and new track sids.
+	if (auto dynacast = Dynacast()) {
+		dynacast->Clear();
+	}
 	for (const auto& [sid, publication] : TrackPublicationsSnapshot()) {
 		auto* local_publication = dynamic_cast<LocalTrackPublication*>(publication.get());
 		auto* local_track = local_publication != nullptr
@@ -794,8 +899,31 @@ void LocalParticipant::SetE2EEManager(E2EEManager* manager, EncryptionType encry
 }
 
 void LocalParticipant::UpdateRoomOptions(RoomOptions options) {
-	std::lock_guard<std::mutex> guard(room_options_mutex_);
-	options_ = std::move(options);
+	const auto batching = options.data_batching;
+	const bool dynacast_enabled = options.dynacast;
+	{
+		std::lock_guard<std::mutex> guard(room_options_mutex_);
+		options_ = std::move(options);
+	}
+	std::shared_ptr<DataBatcher> current;
+	{
+		std::lock_guard<std::mutex> guard(data_batcher_mutex_);
+		current = data_batcher_;
+	}
+	if (current && !SameBatchingOptions(current->Options(), batching)) {
+		RetireDataBatcher();
+	}
+	if (!dynacast_enabled) {
+		std::shared_ptr<DynacastController> dynacast;
+		{
+			std::lock_guard<std::mutex> guard(dynacast_mutex_);
+			dynacast.swap(dynacast_);
+		}
+		// Layers paused for dynacast would otherwise stay paused with nothing to resume them.
+		if (dynacast) {
+			dynacast->Reset();
+		}
+	}
 }
 
 bool LocalParticipant::SetMetadata(const std::string& metadata) {
@@ -814,6 +942,16 @@ bool LocalParticipant::PublishData(const std::vector<uint8_t>& data, DataPublish
 	if (engine_ == nullptr) {
 		return false;
 	}
+	if (options.coalesce && !options.reliable) {
+		if (auto batcher = CoalescingBatcher()) {
+			return batcher->Publish(options.topic, std::move(options.destination_identities),
+			                        data.data(), data.size());
+		}
+	}
+	if (options.topic == kDataBatchTopic) {
+		// Receivers would decode the payload as a coalesced batch.
+		return false;
+	}
 	livekit::DataPacket packet;
 	packet.set_kind(options.reliable ? livekit::DataPacket_Kind_RELIABLE
 	                                 : livekit::DataPacket_Kind_LOSSY);
@@ -829,6 +967,142 @@ bool LocalParticipant::PublishData(const std::vector<uint8_t>& data, DataPublish
 	return engine_->SendDataPacket(packet, options.reliable);
 }
 
+DataBatchingStats LocalParticipant::GetDataBatchingStats() const {
+	std::lock_guard<std::mutex> guard(data_batcher_mutex_);
+	auto stats = retired_batching_stats_;
+	if (data_batcher_) {
+		AddBatchingStats(stats, data_batcher_->Stats());
+	}
+	return stats;
+}
+
+void LocalParticipant::FlushCoalescedData() {
+	std::shared_ptr<DataBatcher> batcher;
+	{
+		std::lock_guard<std::mutex> guard(data_batcher_mutex_);
+		batcher = data_batcher_;
+	}
+	if (batcher) {
+		batcher->Flush();
+	}
+}
+
+void LocalParticipant::ResetDynacast() {
+	if (auto dynacast = Dynacast()) {
+		dynacast->Reset();
+	}
+}
+
+std::shared_ptr<DynacastController> LocalParticipant::Dynacast() {
+	{
+		std::lock_guard<std::mutex> guard(room_options_mutex_);
+		if (!options_.dynacast) {
+			return nullptr;
+		}
+	}
+	std::lock_guard<std::mutex> guard(dynacast_mutex_);
+	if (!dynacast_) {
+		dynacast_ = std::make_shared<DynacastController>(
+		    kDynacastPauseDelay,
+		    [this](const std::string& track_sid, const DynacastController::LayerMap& layers) {
+			    return ApplyDynacastLayers(track_sid, layers);
+		    },
+		    [this](const std::string& track_sid) { return SampleEncodeTime(track_sid); });
+	}
+	return dynacast_;
+}
+
+bool LocalParticipant::ApplyDynacastLayers(const std::string& track_sid,
+                                           const DynacastController::LayerMap& layers) {
+	auto publications = TrackPublicationsSnapshot();
+	auto publication = publications.find(track_sid);
+	if (publication == publications.end()) {
+		return false;
+	}
+	auto* local_track = dynamic_cast<LocalTrack*>(publication->second->Track());
+	auto transceiver = local_track != nullptr ? local_track->Transceiver() : nullptr;
+	auto sender = transceiver != nullptr ? transceiver->sender() : nullptr;
+	if (sender == nullptr) {
+		return false;
+	}
+	// All layers change in one SetParameters call so the encoder reconfigures once.
+	auto parameters = sender->GetParameters();
+	if (!ApplyLayerActivation(parameters.encodings, layers)) {
+		return true;
+	}
+	const auto result = sender->SetParameters(parameters);
+	if (!result.ok()) {
+		RTC_LOG(LS_WARNING) << "dynacast set parameters error: " << result.message();
+		return false;
+	}
+	return true;
+}
+
+std::map<VideoQuality, double> LocalParticipant::SampleEncodeTime(const std::string& track_sid) {
+	auto publications = TrackPublicationsSnapshot();
+	auto publication = publications.find(track_sid);
+	auto* track = publication != publications.end() ? publication->second->Track() : nullptr;
+	if (track == nullptr) {
+		return {};
+	}
+	std::map<VideoQuality, double> result;
+	for (const auto& stream : ParseRTCStatsReport(track->GetRTCStats()).streams) {
+		if (stream.direction == RTCStatsDirection::Send) {
+			result[QualityForRid(stream.rid)] = stream.total_encode_time_seconds;
+		}
+	}
+	return result;
+}
+
+DataStreamCompressionOptions LocalParticipant::DataStreamCompression() {
+	std::lock_guard<std::mutex> guard(room_options_mutex_);
+	return options_.data_stream_compression;
+}
+
+std::shared_ptr<DataBatcher> LocalParticipant::CoalescingBatcher() {
+	DataBatchingOptions options;
+	{
+		std::lock_guard<std::mutex> guard(room_options_mutex_);
+		options = options_.data_batching;
+	}
+	if (!DataBatcher::IsValidOptions(options)) {
+		return nullptr;
+	}
+	std::lock_guard<std::mutex> guard(data_batcher_mutex_);
+	if (!data_batcher_) {
+		data_batcher_ = std::make_shared<DataBatcher>(
+		    options, [this](const DataBatch& batch) { return SendDataBatch(batch); });
+	}
+	return data_batcher_;
+}
+
+bool LocalParticipant::SendDataBatch(const DataBatch& batch) {
+	livekit::DataPacket packet;
+	packet.set_kind(livekit::DataPacket_Kind_LOSSY);
+	for (const auto& identity : batch.destination_identities) {
+		packet.add_destination_identities(identity);
+	}
+	auto* user = packet.mutable_user();
+	user->set_participant_identity(Identity());
+	user->set_payload(EncodeDataBatchPacket(batch));
+	user->set_topic(std::string(kDataBatchTopic));
+	return engine_->SendDataPacket(packet, false);
+}
+
+void LocalParticipant::RetireDataBatcher() {
+	std::shared_ptr<DataBatcher> previous;
+	{
+		std::lock_guard<std::mutex> guard(data_batcher_mutex_);
+		previous.swap(data_batcher_);
+	}
+	if (!previous) {
+		return;
+	}
+	previous->Flush();
+	std::lock_guard<std::mutex> guard(data_batcher_mutex_);
+	AddBatchingStats(retired_batching_stats_, previous->Stats());
+}
+
 bool LocalParticipant::PublishDtmf(uint32_t code, std::string digit) {
 	if (engine_ == nullptr) {
 		return false;
@@ -934,7 +1208,7 @@ bool LocalParticipant::SendText(const std::string& text, TextSendOptions options
 		return false;
 	}
 	return SendStreamPayload(engine_, stream_id, reinterpret_cast<const uint8_t*>(text.data()),
-	                         text.size(), options);
+	                         text.size(), options, DataStreamCompression());
 }
 
 bool LocalParticipant::SendBytes(const std::vector<uint8_t>& data, ByteSendOptions options) {
@@ -953,83 +1227,30 @@ bool LocalParticipant::SendBytes(const std::vector<uint8_t>& data, ByteSendOptio
 	if (!engine_->SendDataPacket(header_packet, true)) {
 		return false;
 	}
-	return SendStreamPayload(engine_, stream_id, data.data(), data.size(), options);
+	return SendStreamPayload(engine_, stream_id, data.data(), data.size(), options,
+	                         DataStreamCompression());
 }
 
 bool LocalParticipant::SendFile(const std::string& path, FileSendOptions options) {
-	if (engine_ == nullptr || options.chunk_size == 0 ||
-	    options.chunk_size > kMaximumDataStreamChunkSize) {
-		return false;
-	}
-	std::ifstream input(path, std::ios::binary | std::ios::ate);
-	if (!input) {
-		return false;
-	}
-	const auto end = input.tellg();
-	if (end < 0) {
-		return false;
-	}
-	const auto file_size = static_cast<uint64_t>(end);
-	if (options.compress && file_size > kMaximumCompressedDataStreamSize) {
+	if (engine_ == nullptr) {
 		return false;
 	}
-	input.seekg(0, std::ios::beg);
-
-	const std::string stream_id = webrtc::CreateRandomUuid();
+	auto stream = OpenFileStream(outgoing_stream_state_, path, std::move(options),
+	                             DataStreamCompression());
+	return stream && RunFileStream(*stream);
+}
 
-	livekit::DataPacket header_packet;
-	PopulateStreamPacket(header_packet, options);
-	auto* header = header_packet.mutable_stream_header();
-	PopulateStreamHeader(*header, stream_id, file_size, options);
-	header->set_mime_type(options.mime_type);
-	header->mutable_byte_header()->set_name(std::filesystem::path(path).filename().string());
-	if (!engine_->SendDataPacket(header_packet, true)) {
+bool LocalParticipant::SendFileAsync(const std::string& path, FileSendOptions options) {
+	if (engine_ == nullptr) {
 		return false;
 	}
-
-	std::vector<uint8_t> buffer(options.chunk_size);
-	std::unique_ptr<detail::DeflateRawStream> deflater;
-	if (options.compress) {
-		deflater = std::make_unique<detail::DeflateRawStream>();
-		if (!deflater->IsValid()) {
-			return false;
-		}
-	}
-	uint64_t chunk_index = 0;
-	while (input) {
-		input.read(reinterpret_cast<char*>(buffer.data()),
-		           static_cast<std::streamsize>(buffer.size()));
-		const auto count = input.gcount();
-		if (count <= 0) {
-			break;
-		}
-		const uint8_t* payload = buffer.data();
-		std::size_t payload_size = static_cast<std::size_t>(count);
-		std::vector<uint8_t> compressed;
-		if (deflater) {
-			if (!deflater->Write(payload, payload_size, compressed)) {
-				return false;
-			}
-			payload = compressed.data();
-			payload_size = compressed.size();
-		}
-		if (!SendStreamChunks(engine_, stream_id, payload, payload_size, options, chunk_index)) {
-			return false;
-		}
-	}
-	if (deflater) {
-		std::vector<uint8_t> compressed;
-		if (!deflater->Finish(compressed) ||
-		    !SendStreamChunks(engine_, stream_id, compressed.data(), compressed.size(), options,
-		                      chunk_index)) {
-			return false;
-		}
+	std::shared_ptr<FileStream> stream = OpenFileStream(
+	    outgoing_stream_state_, path, std::move(options), DataStreamCompression());
+	if (!stream) {
+		return false;
 	}
-
-	livekit::DataPacket trailer_packet;
-	PopulateStreamPacket(trailer_packet, options);
-	trailer_packet.mutable_stream_trailer()->set_stream_id(stream_id);
-	return engine_->SendDataPacket(trailer_packet, true);
+	// One worker per participant sends queued files in call order, however many are queued.
+	return file_stream_worker_.Post([stream] { RunFileStream(*stream); });
 }
 
 std::unique_ptr<TextStreamWriterInterface> LocalParticipant::StreamText(StreamTextOptions options) {
@@ -1040,8 +1261,9 @@ std::unique_ptr<TextStreamWriterInterface> LocalParticipant::StreamText(StreamTe
 	     *options.total_size > kMaximumCompressedDataStreamSize)) {
 		return nullptr;
 	}
+	const auto compression = DataStreamCompression();
 	if (options.compress) {
-		detail::DeflateRawStream validation;
+		detail::DeflateRawStream validation(compression);
 		if (!validation.IsValid()) {
 			return nullptr;
 		}
@@ -1071,7 +1293,7 @@ std::unique_ptr<TextStreamWriterInterface> LocalParticipant::StreamText(StreamTe
 		return nullptr;
 	}
 	return std::make_unique<TextStreamWriter>(outgoing_stream_state_, std::move(info),
-	                                          std::move(options));
+	                                          std::move(options), compression);
 }
 
 std::unique_ptr<ByteStreamWriterInterface>
@@ -1082,8 +1304,9 @@ LocalParticipant::StreamBytes(StreamBytesOptions options) {
 	     *options.total_size > kMaximumCompressedDataStreamSize)) {
 		return nullptr;
 	}
+	const auto compression = DataStreamCompression();
 	if (options.compress) {
-		detail::DeflateRawStream validation;
+		detail::DeflateRawStream validation(compression);
 		if (!validation.IsValid()) {
 			return nullptr;
 		}
@@ -1105,7 +1328,7 @@ LocalParticipant::StreamBytes(StreamBytesOptions options) {
 		return nullptr;
 	}
 	return std::make_unique<ByteStreamWriter>(outgoing_stream_state_, std::move(info),
-	                                          std::move(options));
+	                                          std::move(options), compression);
 }
 
 } // namespace core
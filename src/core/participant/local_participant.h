@@ -20,7 +20,10 @@
 #ifndef _LKC_CORE_PARTICIPANT_LOCAL_PARTICIPANT_H_
 #define _LKC_CORE_PARTICIPANT_LOCAL_PARTICIPANT_H_
 
+#include "../detail/data_batcher.h"
+#include "../detail/dynacast.h"
 #include "../detail/rtc_engine.h"
+#include "../detail/stream_reassembly.h"
 #include "../track/local_track_publication.h"
 #include "livekit/core/option/option.h"
 #include "livekit/core/participant/local_participant_interface.h"
@@ -31,8 +34,10 @@
 #include "participant.h"
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 
 namespace livekit {
 namespace core {
@@ -68,6 +73,9 @@ public:
 	bool SetName(const std::string& name) override;
 	bool SetAttributes(const std::map<std::string, std::string>& attributes) override;
 	bool PublishData(const std::vector<uint8_t>& data, DataPublishOptions options) override;
+	DataBatchingStats GetDataBatchingStats() const override;
+	// Sends coalesced payloads that are still waiting for their batch window.
+	void FlushCoalescedData();
 	bool PublishDtmf(uint32_t code, std::string digit) override;
 	std::optional<ChatMessage> SendChatMessage(std::string message) override;
 	std::optional<ChatMessage> EditChatMessage(std::string message,
@@ -75,6 +83,7 @@ public:
 	bool SendText(const std::string& text, TextSendOptions options) override;
 	bool SendBytes(const std::vector<uint8_t>& data, ByteSendOptions options) override;
 	bool SendFile(const std::string& path, FileSendOptions options) override;
+	bool SendFileAsync(const std::string& path, FileSendOptions options) override;
 	std::unique_ptr<TextStreamWriterInterface> StreamText(StreamTextOptions options) override;
 	std::unique_ptr<ByteStreamWriterInterface> StreamBytes(StreamBytesOptions options) override;
 	RpcResult PerformRpc(const PerformRpcParams& params) override;
@@ -87,8 +96,21 @@ public:
 	void UpdateRoomOptions(RoomOptions options);
 	void LocalTrackSubscribed(const std::string& track_sid);
 	void SubscribedQualityUpdate(core::SubscribedQualityUpdate update);
+	// Reactivates every simulcast layer until the server sends fresh subscribed qualities.
+	void ResetDynacast();
 
 private:
+	DataStreamCompressionOptions DataStreamCompression();
+	std::shared_ptr<DataBatcher> CoalescingBatcher();
+	bool SendDataBatch(const DataBatch& batch);
+	// Sends what the current batcher holds and folds its counters into the retired totals.
+	void RetireDataBatcher();
+	// Returns the dynacast controller while dynacast is enabled, creating it on first use.
+	std::shared_ptr<DynacastController> Dynacast();
+	bool ApplyDynacastLayers(const std::string& track_sid,
+	                         const DynacastController::LayerMap& layers);
+	std::map<VideoQuality, double> SampleEncodeTime(const std::string& track_sid);
+
 	RtcEngine* engine_;
 	E2EEManager* e2ee_manager_ = nullptr;
 	std::mutex room_options_mutex_;
@@ -102,6 +124,14 @@ private:
 	std::mutex local_track_subscriptions_mutex_;
 	std::set<std::string> subscribed_local_track_sids_;
 	std::set<std::string> emitted_local_track_subscriptions_;
+	// Created on the first coalesced publish and retired when the batching options change.
+	mutable std::mutex data_batcher_mutex_;
+	std::shared_ptr<DataBatcher> data_batcher_;
+	DataBatchingStats retired_batching_stats_;
+	std::mutex dynacast_mutex_;
+	std::shared_ptr<DynacastController> dynacast_;
+	// Runs SendFileAsync streams one at a time.
+	detail::SerialTaskRunner file_stream_worker_;
 
 	// AudioSourceInterface* source_;
 };
@@ -212,6 +212,13 @@ Participant::TrackPublicationsSnapshot() {
 	return track_publications_;
 }
 
+std::shared_ptr<TrackPublicationInterface>
+Participant::FindTrackPublication(const std::string& track_sid) {
+	std::lock_guard<std::mutex> guard(track_publications_mutex_);
+	auto found = track_publications_.find(track_sid);
+	return found != track_publications_.end() ? found->second : nullptr;
+}
+
 void Participant::SetSpeakerInfo(float audio_level, bool is_speaking) {
 	std::lock_guard<std::mutex> guard(participant_mutex_);
 	audio_level_ = audio_level;
@@ -233,5 +240,15 @@ bool Participant::HasTrackSid(const std::string& track_sid) {
 	return false;
 }
 
+std::vector<std::string> Participant::TrackSids() {
+	std::lock_guard<std::mutex> guard(participant_mutex_);
+	std::vector<std::string> sids;
+	sids.reserve(info_.tracks_size());
+	for (const auto& track : info_.tracks()) {
+		sids.push_back(track.sid());
+	}
+	return sids;
+}
+
 } // namespace core
 } // namespace livekit
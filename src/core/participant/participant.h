@@ -26,6 +26,7 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace livekit {
 namespace core {
@@ -60,7 +61,10 @@ public:
 	void AddTrackPublication(std::shared_ptr<TrackPublicationInterface> publication);
 	void RemoveTrackPublication(std::string track_sid);
 	std::map<std::string, std::shared_ptr<TrackPublicationInterface>> TrackPublicationsSnapshot();
+	std::shared_ptr<TrackPublicationInterface> FindTrackPublication(const std::string& track_sid);
 	bool HasTrackSid(const std::string& track_sid);
+	// The track sids of the last ParticipantInfo, as HasTrackSid() sees them.
+	std::vector<std::string> TrackSids();
 	void SetSpeakerInfo(float audio_level, bool is_speaking);
 	void SetConnectionQuality(ConnectionQuality quality);
 
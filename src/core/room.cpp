@@ -18,6 +18,7 @@
 #include "room.h"
 #include "../capture/audio_capture_adapter.h"
 #include "detail/converted_proto.h"
+#include "detail/data_batcher.h"
 #include "detail/rtc_engine.h"
 #include "e2ee/e2ee_manager_internal.h"
 #include "track/audio_track.h"
@@ -30,6 +31,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <future>
 #include <limits>
 #include <set>
 #include <tuple>
@@ -54,6 +56,48 @@ bool DecodeInlineContent(const livekit::DataStream_Header& header, std::vector<u
 	       inflater.Finished();
 }
 
+// Checks one chunk of an incoming stream against its order and size limits, inflating it first
+// when the stream is compressed, and appends it to the buffered payload. content then points at
+// the chunk's payload bytes: the chunk itself, or the stream's inflate buffer.
+template <typename Incoming>
+bool AcceptStreamChunk(Incoming& incoming, const livekit::DataStream_Chunk& chunk,
+                       const uint8_t*& content, std::size_t& content_size) {
+	content = reinterpret_cast<const uint8_t*>(chunk.content().data());
+	content_size = chunk.content().size();
+	if (incoming.deferred) {
+		auto queued = incoming.queued_length.load();
+		while (!incoming.queued_length.compare_exchange_weak(
+		    queued, queued - std::min<uint64_t>(queued, content_size))) {
+		}
+	}
+	if (chunk.chunk_index() != incoming.next_chunk) {
+		return false;
+	}
+	if (incoming.inflater) {
+		const auto compressed_size = static_cast<uint64_t>(content_size);
+		incoming.inflated.clear();
+		if (compressed_size > kMaximumBufferedDataStreamSize - incoming.compressed_length ||
+		    !incoming.inflater->Write(content, content_size, incoming.inflated)) {
+			return false;
+		}
+		incoming.compressed_length += compressed_size;
+		content = incoming.inflated.data();
+		content_size = incoming.inflated.size();
+	}
+	const auto size = static_cast<uint64_t>(content_size);
+	if (size > std::numeric_limits<uint64_t>::max() - incoming.received_length ||
+	    (incoming.expected_length &&
+	     (incoming.received_length > *incoming.expected_length ||
+	      size > *incoming.expected_length - incoming.received_length)) ||
+	    (incoming.payload && (size > kMaximumBufferedDataStreamSize - incoming.payload->Size() ||
+	                          !incoming.payload->Append(content, content_size)))) {
+		return false;
+	}
+	incoming.received_length += size;
+	++incoming.next_chunk;
+	return true;
+}
+
 int64_t CurrentTimestampMilliseconds() {
 	return std::chrono::duration_cast<std::chrono::milliseconds>(
 	           std::chrono::system_clock::now().time_since_epoch())
@@ -68,6 +112,8 @@ static livekit::core::EngineOptions make_engine_config(livekit::core::RoomOption
 	engine_options.reconnect_policy = room_options.reconnect_policy != nullptr
 	                                      ? std::move(room_options.reconnect_policy)
 	                                      : livekit::core::CreateDefaultReconnectPolicy();
+	engine_options.peer_factory = std::move(room_options.peer_factory);
+	engine_options.audio_playout = room_options.audio_playout;
 	engine_options.rtc_config.ice_servers = room_options.rtc_config.ice_servers;
 	engine_options.rtc_config.continual_gathering_policy =
 	    room_options.rtc_config.continual_gathering_policy;
@@ -122,15 +168,22 @@ static livekit::core::DisconnectReason from_disconnect_reason(livekit::Disconnec
 
 namespace livekit {
 namespace core {
-Room::Room(RoomOptions options) : options_(options) {
+Room::Room(RoomOptions options)
+    : options_(options), options_share_peer_factory_(options.peer_factory != nullptr) {
 	rtc_engine_ = std::make_unique<RtcEngine>();
 	rtc_engine_->SetRoomObserver(this);
 	local_participant_ = std::make_unique<LocalParticipant>("", "", EncryptionType::None,
 	                                                        rtc_engine_.get(), options_);
 	ConfigureE2ee(options_.e2ee);
+	event_dispatcher_.Configure(options_.event_dispatch);
 }
 
 Room::~Room() {
+	stream_worker_.Stop();
+	{
+		std::lock_guard<std::mutex> guard(adaptive_stream_mutex_);
+		adaptive_stream_ = nullptr;
+	}
 	if (rtc_engine_) {
 		rtc_engine_->SetE2EEManager(nullptr, {});
 	}
@@ -139,6 +192,21 @@ Room::~Room() {
 		e2ee_manager_->SetStateCallback({});
 		E2EEManagerNativeAccess::DetachAll(*e2ee_manager_);
 	}
+	{
+		std::lock_guard<std::mutex> guard(track_consumers_mutex_);
+		for (const auto& weak : audio_mixers_) {
+			if (auto mixer = weak.lock()) {
+				mixer->DetachRoom();
+			}
+		}
+		audio_mixers_.clear();
+		for (const auto& weak : frame_streams_) {
+			if (auto stream = weak.lock()) {
+				stream->Close();
+			}
+		}
+		frame_streams_.clear();
+	}
 	std::map<std::string, std::shared_ptr<RemoteTrack>> detached_tracks;
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
@@ -150,6 +218,7 @@ Room::~Room() {
 		rtc_engine_->SetRoomObserver(nullptr);
 		rtc_engine_->Disconnect();
 	}
+	event_dispatcher_.Stop();
 }
 
 bool Room::RegisterRpcMethod(std::string method, RpcHandler handler) {
@@ -195,14 +264,27 @@ bool Room::Connect(std::string url, std::string token, RoomConnectOptions opts)
 	if (!state_.compare_exchange_strong(expected, RoomState::Connecting)) {
 		return false;
 	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnConnectionStateChanged(RoomState::Connecting);
-	}
+	event_dispatcher_.Configure(opts.event_dispatch);
+	PostEvent(EventCategory::Connection, [](RoomEventInterface& listener) {
+		listener.OnConnectionStateChanged(RoomState::Connecting);
+	});
 	disconnected_event_emitted_ = false;
 	full_reconnect_prepared_ = false;
 	disconnect_reason_ = DisconnectReason::Unknown;
 	options_ = opts;
+	options_share_peer_factory_ = opts.peer_factory != nullptr;
 	local_participant_->UpdateRoomOptions(opts);
+	{
+		std::lock_guard<std::mutex> guard(adaptive_stream_mutex_);
+		adaptive_stream_ =
+		    opts.adaptive_stream
+		        ? std::make_shared<AdaptiveStream>(
+		              std::chrono::milliseconds(100),
+		              [this](const std::string& track_sid, const VideoRenderState& state) {
+			              return ApplyVideoRenderState(track_sid, state);
+		              })
+		        : nullptr;
+	}
 
 	try {
 		ConfigureE2ee(opts.e2ee);
@@ -232,11 +314,41 @@ void Room::AddEventListener(RoomEventInterface* listener) {
 void Room::RemoveEventListener() {
 	local_participant_->SetEventListener(nullptr);
 	event_listener_.store(nullptr);
+	// A callback already running may still be using the old listener.
+	event_dispatcher_.WaitForRunningCallbacks();
+}
+
+void Room::PostEvent(EventCategory category, std::function<void(RoomEventInterface&)> notify,
+                     std::string coalesce_key, bool lossy) {
+	if (event_listener_.load() == nullptr) {
+		return;
+	}
+	event_dispatcher_.Post(
+	    category,
+	    [this, notify = std::move(notify)] {
+		    if (auto* listener = event_listener_.load()) {
+			    notify(*listener);
+		    }
+	    },
+	    std::move(coalesce_key), lossy);
 }
 
+EventDispatchStats Room::GetEventDispatchStats() const { return event_dispatcher_.Stats(); }
+
 bool Room::IsConnected() { return state_.load() == RoomState::Connected; }
 
+bool Room::SharesAudioDevice() const {
+	// Before the first connect, the options say which factory the room will use.
+	if (auto shared = rtc_engine_ ? rtc_engine_->SharesPeerFactory() : std::nullopt) {
+		return *shared;
+	}
+	return options_share_peer_factory_;
+}
+
 bool Room::SetAudioOutputDevice(std::string device_id) {
+	if (SharesAudioDevice()) {
+		return false;
+	}
 	auto audio_device = rtc_engine_ ? rtc_engine_->GetAudioDevice() : nullptr;
 	return audio_device && audio_device->SetPlayoutDeviceId(device_id);
 }
@@ -247,7 +359,7 @@ std::string Room::AudioOutputDevice() const {
 }
 
 bool Room::SetSpeakerVolume(float volume) {
-	if (!std::isfinite(volume) || volume < 0.0F || volume > 1.0F) {
+	if (!std::isfinite(volume) || volume < 0.0F || volume > 1.0F || SharesAudioDevice()) {
 		return false;
 	}
 	auto audio_device = rtc_engine_ ? rtc_engine_->GetAudioDevice() : nullptr;
@@ -264,6 +376,9 @@ float Room::SpeakerVolume() const {
 }
 
 bool Room::SetSpeakerMuted(bool muted) {
+	if (SharesAudioDevice()) {
+		return false;
+	}
 	auto audio_device = rtc_engine_ ? rtc_engine_->GetAudioDevice() : nullptr;
 	return audio_device && audio_device->SetSpeakerMute(muted) == 0;
 }
@@ -291,6 +406,39 @@ AudioPlaybackStats Room::GetAudioPlaybackStats() const {
 	return result;
 }
 
+std::shared_ptr<AudioMixerInterface> Room::CreateAudioMixer(AudioMixerOptions options) {
+	if (!RemoteAudioMixer::IsValidOptions(options)) {
+		return nullptr;
+	}
+	auto mixer = std::make_shared<RemoteAudioMixer>(options, [this](const std::string& track_sid) {
+		return ResolveRemoteAudioTrack(track_sid);
+	});
+	std::vector<RemoteAudioMixer::ResolvedTrack> existing;
+	if (options.include_all_tracks) {
+		std::lock_guard<std::mutex> guard(participants_mutex_);
+		for (const auto& [sid, track] : remote_tracks_) {
+			auto audio = std::dynamic_pointer_cast<RemoteAudioTrack>(track);
+			auto participant = FindRemoteParticipantForTrack(sid);
+			if (audio && participant) {
+				existing.push_back({participant->Sid(), std::move(audio)});
+			}
+		}
+	}
+	{
+		// Registered before attaching so a track subscribed meanwhile is not missed; AttachTrack()
+		// ignores duplicates.
+		std::lock_guard<std::mutex> guard(track_consumers_mutex_);
+		audio_mixers_.erase(std::remove_if(audio_mixers_.begin(), audio_mixers_.end(),
+		                                   [](const auto& weak) { return weak.expired(); }),
+		                    audio_mixers_.end());
+		audio_mixers_.push_back(mixer);
+	}
+	for (auto& resolved : existing) {
+		mixer->AttachTrack(resolved.participant_sid, std::move(resolved.track));
+	}
+	return mixer;
+}
+
 RoomInterface::RoomState Room::State() const { return state_.load(); }
 
 DisconnectReason Room::LastDisconnectReason() const { return disconnect_reason_.load(); }
@@ -321,6 +469,7 @@ bool Room::Disconnect() {
 		return false;
 	}
 	SetState(RoomState::Disconnecting);
+	local_participant_->FlushCoalescedData();
 	if (e2ee_manager_) {
 		E2EEManagerNativeAccess::DetachAll(*e2ee_manager_);
 	}
@@ -330,7 +479,10 @@ bool Room::Disconnect() {
 		std::lock_guard<std::mutex> guard(participants_mutex_);
 		detached_tracks.swap(remote_tracks_);
 		pending_media_tracks_.clear();
-		remote_participants_.clear();
+		remote_participants_.Clear();
+	}
+	for (const auto& [sid, track] : detached_tracks) {
+		DetachTrackConsumers(sid);
 	}
 	detached_tracks.clear();
 	rtc_engine_->Disconnect();
@@ -350,9 +502,9 @@ void Room::ConfigureE2ee(const std::optional<E2eeOptions>& options) {
 	if (options && options->encryption_type != EncryptionType::None) {
 		replacement = std::make_unique<E2EEManager>(*options);
 		replacement->SetStateCallback([this](const EncryptionStateEvent& event) {
-			if (auto* listener = event_listener_.load()) {
-				listener->OnEncryptionStateChanged(event);
-			}
+			PostEvent(EventCategory::Connection, [event](RoomEventInterface& listener) {
+				listener.OnEncryptionStateChanged(event);
+			});
 		});
 		E2EEManagerNativeAccess::SetEnabledCallback(*replacement, [this](bool enabled) {
 			local_participant_->SetE2EEManager(e2ee_manager_.get(), enabled ? EncryptionType::Gcm
@@ -455,21 +607,17 @@ std::vector<RemoteParticipantSnapshot> Room::GetRemoteParticipantSnapshots() con
 
 RemoteParticipantInterface* Room::GetRemoteParticipantBySid(std::string sid) {
 	std::lock_guard<std::mutex> guard(participants_mutex_);
-	auto participant = remote_participants_.find(sid);
-	if (participant != remote_participants_.end()) {
-		return participant->second.get();
-	}
-	return nullptr;
+	return remote_participants_.FindBySid(sid).get();
 }
 
 RemoteParticipantInterface* Room::GetRemoteParticipantByName(std::string name) {
 	std::lock_guard<std::mutex> guard(participants_mutex_);
-	for (auto& participant : this->remote_participants_) {
-		if (participant.second->Name() == name) {
-			return participant.second.get();
-		}
-	}
-	return nullptr;
+	return remote_participants_.FindByName(name).get();
+}
+
+RemoteParticipantInterface* Room::GetRemoteParticipantByIdentity(const std::string& identity) {
+	std::lock_guard<std::mutex> guard(participants_mutex_);
+	return remote_participants_.FindByIdentity(identity).get();
 }
 
 std::vector<ParticipantInterface*> Room::Participants() {
@@ -513,13 +661,14 @@ bool Room::SetLocalTrackMutedInternal(std::string track_sid, bool muted) {
 	if (auto* publication = dynamic_cast<TrackPublication*>(found->second.get())) {
 		publication->SetMuted(muted);
 	}
-	if (auto* listener = event_listener_.load()) {
+	PostEvent(EventCategory::Media, [this, publication = found->second,
+	                                 muted](RoomEventInterface& listener) {
 		if (muted) {
-			listener->OnTrackMuted(found->second.get(), local_participant_.get());
+			listener.OnTrackMuted(publication.get(), local_participant_.get());
 		} else {
-			listener->OnTrackUnmuted(found->second.get(), local_participant_.get());
+			listener.OnTrackUnmuted(publication.get(), local_participant_.get());
 		}
-	}
+	});
 	return true;
 }
 
@@ -531,16 +680,14 @@ bool Room::SetRemoteTrackSubscribedInternal(std::string participant_sid, std::st
 	std::shared_ptr<TrackPublicationInterface> publication;
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
-		auto participant = remote_participants_.find(participant_sid);
-		if (participant == remote_participants_.end()) {
+		auto participant = remote_participants_.FindBySid(participant_sid);
+		if (!participant) {
 			return false;
 		}
-		auto publications = participant->second->TrackPublicationsSnapshot();
-		auto found = publications.find(track_sid);
-		if (found == publications.end()) {
+		publication = participant->FindTrackPublication(track_sid);
+		if (!publication) {
 			return false;
 		}
-		publication = found->second;
 	}
 	auto* remote = dynamic_cast<RemoteTrackPublication*>(publication.get());
 	if (remote == nullptr || !remote->SetSubscribed(subscribed)) {
@@ -557,16 +704,14 @@ bool Room::UpdateRemoteTrackSettingsInternal(std::string participant_sid, std::s
 	std::shared_ptr<TrackPublicationInterface> publication;
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
-		auto participant = remote_participants_.find(participant_sid);
-		if (participant == remote_participants_.end()) {
+		auto participant = remote_participants_.FindBySid(participant_sid);
+		if (!participant) {
 			return false;
 		}
-		auto publications = participant->second->TrackPublicationsSnapshot();
-		auto found = publications.find(track_sid);
-		if (found == publications.end()) {
+		publication = participant->FindTrackPublication(track_sid);
+		if (!publication) {
 			return false;
 		}
-		publication = found->second;
 	}
 	auto* remote = dynamic_cast<RemoteTrackPublication*>(publication.get());
 	return remote != nullptr && remote->UpdateRemoteTrackSettings(settings);
@@ -585,9 +730,8 @@ bool Room::SendRemoteTrackSettings(const std::string& participant_sid, const std
 	}
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
-		auto participant = remote_participants_.find(participant_sid);
-		if (participant == remote_participants_.end() ||
-		    !participant->second->HasTrackSid(track_sid)) {
+		auto participant = remote_participants_.FindByTrackSid(track_sid);
+		if (!participant || participant->Sid() != participant_sid) {
 			return false;
 		}
 	}
@@ -601,21 +745,20 @@ void Room::RemoteSubscriptionStatusChanged(const std::string& participant_sid,
 	std::shared_ptr<TrackPublicationInterface> publication;
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
-		auto found_participant = remote_participants_.find(participant_sid);
-		if (found_participant == remote_participants_.end()) {
+		participant = remote_participants_.FindBySid(participant_sid);
+		if (!participant) {
 			return;
 		}
-		participant = found_participant->second;
-		auto publications = participant->TrackPublicationsSnapshot();
-		auto found_publication = publications.find(track_sid);
-		if (found_publication == publications.end()) {
+		publication = participant->FindTrackPublication(track_sid);
+		if (!publication) {
 			return;
 		}
-		publication = found_publication->second;
-	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnTrackSubscriptionStatusChanged(publication.get(), participant.get(), status);
 	}
+	PostEvent(EventCategory::Media,
+	          [publication, participant, status](RoomEventInterface& listener) {
+		          listener.OnTrackSubscriptionStatusChanged(publication.get(), participant.get(),
+		                                                    status);
+	          });
 }
 
 RemoteParticipant::PublicationHandlers
@@ -670,6 +813,15 @@ std::string Room::AccessTokenForReconnectForTesting() const {
 	return rtc_engine_ != nullptr ? rtc_engine_->AccessTokenForReconnect() : std::string{};
 }
 
+void Room::FlushEventsForTesting() {
+	std::promise<void> inflated;
+	auto done = inflated.get_future();
+	if (stream_worker_.Post([&inflated] { inflated.set_value(); })) {
+		done.wait();
+	}
+	event_dispatcher_.Flush();
+}
+
 std::vector<RemoteParticipantSnapshot> RoomInterface::GetRemoteParticipantSnapshots() const {
 	auto* room = dynamic_cast<const Room*>(this);
 	return room != nullptr ? room->GetRemoteParticipantSnapshots()
@@ -691,6 +843,9 @@ DisconnectReason RoomInterface::LastDisconnectReason() const {
 }
 
 RemoteParticipantInterface* RoomInterface::GetRemoteParticipantByIdentity(std::string identity) {
+	if (auto* room = dynamic_cast<Room*>(this)) {
+		return room->GetRemoteParticipantByIdentity(identity);
+	}
 	for (auto* participant : GetRemoteParticipants()) {
 		if (participant != nullptr && participant->Identity() == identity) {
 			return participant;
@@ -729,9 +884,8 @@ bool RoomInterface::UpdateRemoteTrackSettings(std::string participant_sid, std::
 void Room::ConnectedEvent(livekit::JoinResponse join_resp) {
 	SetState(RoomState::Connected);
 	local_participant_->ResendTrackSubscriptionPermissions();
-	if (auto* listener = event_listener_.load()) {
-		listener->OnConnected();
-	}
+	PostEvent(EventCategory::Connection,
+	          [](RoomEventInterface& listener) { listener.OnConnected(); });
 }
 
 void Room::ReconnectingEvent(bool full_reconnect) {
@@ -744,9 +898,8 @@ void Room::ReconnectingEvent(bool full_reconnect) {
 	if (!TransitionState(RoomState::Connected, RoomState::Reconnecting)) {
 		return;
 	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnReconnecting();
-	}
+	PostEvent(EventCategory::Connection,
+	          [](RoomEventInterface& listener) { listener.OnReconnecting(); });
 }
 
 void Room::SignalResumedEvent() {
@@ -769,13 +922,14 @@ void Room::SignalResumedEvent() {
 
 void Room::ResumedEvent() {
 	local_participant_->ResendTrackSubscriptionPermissions();
+	// Subscribed quality updates may have been lost while the signal connection was down.
+	local_participant_->ResetDynacast();
 	ResendRemoteTrackPreferences();
 	if (!TransitionState(RoomState::Reconnecting, RoomState::Connected)) {
 		return;
 	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnReconnected();
-	}
+	PostEvent(EventCategory::Connection,
+	          [](RoomEventInterface& listener) { listener.OnReconnected(); });
 }
 
 void Room::ReconnectedEvent(livekit::JoinResponse join_resp) {
@@ -788,9 +942,8 @@ void Room::ReconnectedEvent(livekit::JoinResponse join_resp) {
 	local_participant_->RepublishAllTracksAfterReconnect();
 	full_reconnect_prepared_ = false;
 	SetState(RoomState::Connected);
-	if (auto* listener = event_listener_.load()) {
-		listener->OnReconnected();
-	}
+	PostEvent(EventCategory::Connection,
+	          [](RoomEventInterface& listener) { listener.OnReconnected(); });
 }
 
 void Room::SignalDisconnectedEvent(livekit::DisconnectReason reason) {
@@ -798,9 +951,9 @@ void Room::SignalDisconnectedEvent(livekit::DisconnectReason reason) {
 	while (current != RoomState::Disconnecting && current != RoomState::Disconnected &&
 	       current != RoomState::Failed) {
 		if (state_.compare_exchange_weak(current, RoomState::Failed)) {
-			if (auto* listener = event_listener_.load()) {
-				listener->OnConnectionStateChanged(RoomState::Failed);
-			}
+			PostEvent(EventCategory::Connection, [](RoomEventInterface& listener) {
+				listener.OnConnectionStateChanged(RoomState::Failed);
+			});
 			break;
 		}
 	}
@@ -813,24 +966,26 @@ void Room::SignalDisconnectedEvent(livekit::DisconnectReason reason) {
 void Room::FailIncomingDataStreams(const std::string& reason) {
 	std::vector<std::pair<TextStreamHandler, TextStreamEvent>> text_events;
 	std::vector<std::pair<ByteStreamHandler, ByteStreamEvent>> byte_events;
+	std::map<std::string, std::shared_ptr<IncomingText>> texts;
+	std::map<std::string, std::shared_ptr<IncomingFile>> files;
 	{
 		std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
-		for (auto& [id, incoming] : incoming_texts_) {
-			if (incoming.handler) {
-				text_events.push_back(
-				    {incoming.handler,
-				     {incoming.info, DataStreamEventType::Failed, "", 0, reason}});
-			}
+		texts.swap(incoming_texts_);
+		files.swap(incoming_files_);
+	}
+	for (const auto& [id, incoming] : texts) {
+		if (incoming->handler) {
+			std::lock_guard<std::mutex> guard(incoming->mutex);
+			text_events.push_back(
+			    {incoming->handler, {incoming->info, DataStreamEventType::Failed, "", 0, reason}});
 		}
-		for (auto& [id, incoming] : incoming_files_) {
-			if (incoming.handler) {
-				byte_events.push_back(
-				    {incoming.handler,
-				     {incoming.info, DataStreamEventType::Failed, {}, 0, reason}});
-			}
+	}
+	for (const auto& [id, incoming] : files) {
+		if (incoming->handler) {
+			std::lock_guard<std::mutex> guard(incoming->mutex);
+			byte_events.push_back(
+			    {incoming->handler, {incoming->info, DataStreamEventType::Failed, {}, 0, reason}});
 		}
-		incoming_texts_.clear();
-		incoming_files_.clear();
 	}
 	{
 		std::lock_guard<std::mutex> guard(transcription_mutex_);
@@ -847,9 +1002,8 @@ void Room::FailIncomingDataStreams(const std::string& reason) {
 void Room::NotifyDisconnectedOnce(DisconnectReason reason) {
 	if (!disconnected_event_emitted_.exchange(true)) {
 		disconnect_reason_ = reason;
-		if (auto* listener = event_listener_.load()) {
-			listener->OnDisconnected(reason);
-		}
+		PostEvent(EventCategory::Connection,
+		          [reason](RoomEventInterface& listener) { listener.OnDisconnected(reason); });
 	}
 }
 
@@ -857,9 +1011,8 @@ bool Room::SetState(RoomState state) {
 	if (state_.exchange(state) == state) {
 		return false;
 	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnConnectionStateChanged(state);
-	}
+	PostEvent(EventCategory::Connection,
+	          [state](RoomEventInterface& listener) { listener.OnConnectionStateChanged(state); });
 	return true;
 }
 
@@ -867,9 +1020,8 @@ bool Room::TransitionState(RoomState expected, RoomState state) {
 	if (!state_.compare_exchange_strong(expected, state)) {
 		return false;
 	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnConnectionStateChanged(state);
-	}
+	PostEvent(EventCategory::Connection,
+	          [state](RoomEventInterface& listener) { listener.OnConnectionStateChanged(state); });
 	return true;
 }
 
@@ -922,14 +1074,20 @@ void Room::ApplyJoinResponse(const livekit::JoinResponse& join_response, bool re
 		}
 		detached_tracks.swap(remote_tracks_);
 		pending_media_tracks_.clear();
-		for (auto participant = remote_participants_.begin();
-		     participant != remote_participants_.end();) {
-			if (participant_sids.count(participant->first) == 0) {
-				participant = remote_participants_.erase(participant);
-			} else {
-				++participant;
+		std::vector<std::string> departed;
+		for (const auto& [sid, participant] : remote_participants_) {
+			if (participant_sids.count(sid) == 0) {
+				departed.push_back(sid);
 			}
 		}
+		for (const auto& sid : departed) {
+			remote_participants_.Erase(sid);
+		}
+	}
+	// The tracks come back with new subscriptions, so mixers and streams must let go of the old
+	// ones first.
+	for (const auto& [sid, track] : detached_tracks) {
+		DetachTrackConsumers(sid);
 	}
 	// A media track can wait for an in-flight frame callback while being destroyed. Those callbacks
 	// also take participants_mutex_, so release track ownership only after leaving the critical
@@ -951,26 +1109,22 @@ void Room::RemoteMuteChangedEvent(const std::string& sid, bool muted) {
 		if (!participant) {
 			return;
 		}
-		auto publications = participant->TrackPublicationsSnapshot();
-		auto found = publications.find(sid);
-		if (found == publications.end()) {
-			return;
-		}
-		publication = found->second;
-		if (publication->IsMuted() == muted) {
+		publication = participant->FindTrackPublication(sid);
+		if (!publication || publication->IsMuted() == muted) {
 			return;
 		}
 		if (auto* concrete = dynamic_cast<TrackPublication*>(publication.get())) {
 			concrete->SetMuted(muted);
 		}
 	}
-	if (auto* listener = event_listener_.load()) {
-		if (muted) {
-			listener->OnTrackMuted(publication.get(), participant.get());
-		} else {
-			listener->OnTrackUnmuted(publication.get(), participant.get());
-		}
-	}
+	PostEvent(EventCategory::Media,
+	          [publication, participant, muted](RoomEventInterface& listener) {
+		          if (muted) {
+			          listener.OnTrackMuted(publication.get(), participant.get());
+		          } else {
+			          listener.OnTrackUnmuted(publication.get(), participant.get());
+		          }
+	          });
 }
 
 void Room::LocalTrackUnpublishedEvent(const std::string& sid) {
@@ -991,9 +1145,9 @@ void Room::LocalTrackUnpublishedEvent(const std::string& sid) {
 		local_track->SetEnabled(false);
 	}
 	local_participant_->RemoveTrackPublication(sid);
-	if (auto* listener = event_listener_.load()) {
-		listener->OnLocalTrackUnpublished(publication.get(), local_participant_.get());
-	}
+	PostEvent(EventCategory::Media, [this, publication](RoomEventInterface& listener) {
+		listener.OnLocalTrackUnpublished(publication.get(), local_participant_.get());
+	});
 }
 
 void Room::SpeakersChangedEvent(const std::vector<livekit::SpeakerInfo>& updates) {
@@ -1006,10 +1160,9 @@ void Room::SpeakersChangedEvent(const std::vector<livekit::SpeakerInfo>& updates
 			if (update.sid() == local_participant_->Sid()) {
 				participant = local_participant_.get();
 			} else {
-				auto found = remote_participants_.find(update.sid());
-				if (found != remote_participants_.end()) {
-					retained_participants.push_back(found->second);
-					participant = found->second.get();
+				if (auto found = remote_participants_.FindBySid(update.sid())) {
+					participant = found.get();
+					retained_participants.push_back(std::move(found));
 				}
 			}
 			if (participant == nullptr) {
@@ -1032,9 +1185,15 @@ void Room::SpeakersChangedEvent(const std::vector<livekit::SpeakerInfo>& updates
 	          [](ParticipantInterface* left, ParticipantInterface* right) {
 		          return left->AudioLevel() > right->AudioLevel();
 	          });
-	if (auto* listener = event_listener_.load()) {
-		listener->OnActiveSpeakersChanged(active_speakers);
-	}
+	// A later speaker update replaces this one while it waits to be delivered, and a full queue
+	// may drop it.
+	PostEvent(
+	    EventCategory::Speakers,
+	    [active_speakers = std::move(active_speakers),
+	     retained_participants = std::move(retained_participants)](RoomEventInterface& listener) {
+		    listener.OnActiveSpeakersChanged(active_speakers);
+	    },
+	    "speakers", true);
 }
 
 void Room::RoomUpdateEvent(const livekit::Room& update) {
@@ -1046,13 +1205,17 @@ void Room::RoomUpdateEvent(const livekit::Room& update) {
 		recording_changed = room_info_.active_recording() != update.active_recording();
 		room_info_ = update;
 	}
-	if (auto* listener = event_listener_.load()) {
-		if (metadata_changed) {
-			listener->OnRoomMetadataChanged(update.metadata());
-		}
-		if (recording_changed) {
-			listener->OnRecordingStatusChanged(update.active_recording());
-		}
+	if (metadata_changed) {
+		PostEvent(EventCategory::Connection,
+		          [metadata = update.metadata()](RoomEventInterface& listener) {
+			          listener.OnRoomMetadataChanged(metadata);
+		          });
+	}
+	if (recording_changed) {
+		PostEvent(EventCategory::Connection,
+		          [recording = update.active_recording()](RoomEventInterface& listener) {
+			          listener.OnRecordingStatusChanged(recording);
+		          });
 	}
 }
 
@@ -1074,18 +1237,21 @@ void Room::ConnectionQualityEvent(const std::vector<livekit::ConnectionQualityIn
 				}
 				continue;
 			}
-			auto found = remote_participants_.find(update.participant_sid());
-			if (found != remote_participants_.end() &&
-			    found->second->GetConnectionQuality() != quality) {
-				found->second->SetConnectionQuality(quality);
-				events.push_back({quality, found->second.get(), found->second});
+			auto found = remote_participants_.FindBySid(update.participant_sid());
+			if (found && found->GetConnectionQuality() != quality) {
+				found->SetConnectionQuality(quality);
+				events.push_back({quality, found.get(), found});
 			}
 		}
 	}
-	if (auto* listener = event_listener_.load()) {
-		for (const auto& event : events) {
-			listener->OnConnectionQualityChanged(event.quality, event.participant);
-		}
+	for (auto& event : events) {
+		auto coalesce_key = "quality:" + event.participant->Sid();
+		PostEvent(
+		    EventCategory::Speakers,
+		    [event = std::move(event)](RoomEventInterface& listener) {
+			    listener.OnConnectionQualityChanged(event.quality, event.participant);
+		    },
+		    std::move(coalesce_key), true);
 	}
 }
 
@@ -1095,26 +1261,24 @@ void Room::SubscriptionPermissionUpdateEvent(const livekit::SubscriptionPermissi
 	bool changed = false;
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
-		auto found = remote_participants_.find(update.participant_sid());
-		if (found == remote_participants_.end()) {
+		participant = remote_participants_.FindBySid(update.participant_sid());
+		if (!participant) {
 			return;
 		}
-		participant = found->second;
-		auto publications = participant->TrackPublicationsSnapshot();
-		auto track = publications.find(update.track_sid());
-		if (track == publications.end()) {
+		publication = participant->FindTrackPublication(update.track_sid());
+		if (!publication) {
 			return;
 		}
-		publication = track->second;
 		if (auto* concrete = dynamic_cast<TrackPublication*>(publication.get())) {
 			changed = concrete->SetSubscriptionAllowed(update.allowed());
 		}
 	}
 	if (changed) {
-		if (auto* listener = event_listener_.load()) {
-			listener->OnTrackSubscriptionPermissionChanged(publication.get(), participant.get(),
-			                                               update.allowed());
-		}
+		PostEvent(EventCategory::Media, [publication, participant,
+		                                 allowed = update.allowed()](RoomEventInterface& listener) {
+			listener.OnTrackSubscriptionPermissionChanged(publication.get(), participant.get(),
+			                                              allowed);
+		});
 	}
 }
 
@@ -1127,22 +1291,21 @@ void Room::SubscriptionErrorEvent(const livekit::SubscriptionResponse& response)
 		if (!participant) {
 			return;
 		}
-		auto publications = participant->TrackPublicationsSnapshot();
-		auto found = publications.find(response.track_sid());
-		if (found == publications.end()) {
+		publication = participant->FindTrackPublication(response.track_sid());
+		if (!publication) {
 			return;
 		}
-		publication = found->second;
 		if (auto* concrete = dynamic_cast<TrackPublication*>(publication.get())) {
 			concrete->SetSubscriptionError(
 			    static_cast<SubscriptionError>(static_cast<int>(response.err())));
 		}
 	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnTrackSubscriptionFailed(
-		    response.track_sid(), participant.get(),
-		    static_cast<SubscriptionError>(static_cast<int>(response.err())));
-	}
+	PostEvent(EventCategory::Media,
+	          [track_sid = response.track_sid(), participant,
+	           error = static_cast<SubscriptionError>(static_cast<int>(response.err()))](
+	              RoomEventInterface& listener) {
+		          listener.OnTrackSubscriptionFailed(track_sid, participant.get(), error);
+	          });
 }
 
 void Room::MediaTrackEvent(webrtc::scoped_refptr<webrtc::MediaStreamTrackInterface> rtc_track,
@@ -1169,11 +1332,7 @@ void Room::MediaTrackEvent(webrtc::scoped_refptr<webrtc::MediaStreamTrackInterfa
 			return;
 		}
 		participant_sid = participant->Sid();
-		auto publications = participant->TrackPublicationsSnapshot();
-		auto found = publications.find(track_sid);
-		if (found != publications.end()) {
-			publication = found->second;
-		}
+		publication = participant->FindTrackPublication(track_sid);
 		const std::string track_name = publication != nullptr ? publication->Name() : track_sid;
 		if (rtc_track->kind() == webrtc::MediaStreamTrackInterface::kAudioKind) {
 			auto media =
@@ -1183,25 +1342,37 @@ void Room::MediaTrackEvent(webrtc::scoped_refptr<webrtc::MediaStreamTrackInterfa
 			    track_sid, track_name, std::move(media),
 			    [this, participant_sid, track_sid](const AudioFrame& frame) {
 				    NotifyAudioFrame(participant_sid, track_sid, frame);
-			    });
+			    },
+			    rtc_engine_ ? rtc_engine_->GetAudioDevice() : nullptr);
 			subscribed_track = std::move(remote);
 			remote_tracks_.emplace(track_sid, subscribed_track);
 		} else if (rtc_track->kind() == webrtc::MediaStreamTrackInterface::kVideoKind) {
 			auto media =
 			    std::make_unique<VideoTrack>(webrtc::scoped_refptr<webrtc::VideoTrackInterface>(
 			        static_cast<webrtc::VideoTrackInterface*>(rtc_track.get())));
-			auto remote = std::make_shared<RemoteVideoTrack>(
-			    track_sid, track_name, std::move(media),
-			    [this, participant_sid, track_sid](const VideoFrame& frame) {
-				    NotifyVideoFrame(participant_sid, track_sid, frame);
-			    });
+			std::shared_ptr<RemoteVideoTrack> remote;
+			if (options_.video_frame_delivery == VideoFrameDelivery::Buffer) {
+				remote = std::make_shared<RemoteVideoTrack>(
+				    track_sid, track_name, std::move(media),
+				    RemoteVideoTrack::BufferCallback(
+				        [this, participant_sid, track_sid](const VideoFrameBuffer& frame) {
+					        NotifyVideoFrameBuffer(participant_sid, track_sid, frame);
+				        }));
+			} else {
+				remote = std::make_shared<RemoteVideoTrack>(
+				    track_sid, track_name, std::move(media),
+				    RemoteVideoTrack::FrameCallback(
+				        [this, participant_sid, track_sid](const VideoFrame& frame) {
+					        NotifyVideoFrame(participant_sid, track_sid, frame);
+				        }));
+			}
 			subscribed_track = std::move(remote);
 			remote_tracks_.emplace(track_sid, subscribed_track);
 		}
 		if (subscribed_track) {
 			subscribed_track->SetStatsProvider(std::move(stats_provider));
 			subscribed_track->SetStreamState(TrackStreamState::Active);
-			if (found != publications.end()) {
+			if (publication) {
 				if (auto* remote = dynamic_cast<RemoteTrackPublication*>(publication.get())) {
 					previous_status = remote->SubscriptionStatus();
 					remote->SetTrackAttached(true);
@@ -1215,19 +1386,23 @@ void Room::MediaTrackEvent(webrtc::scoped_refptr<webrtc::MediaStreamTrackInterfa
 		}
 	}
 	if (subscribed_track) {
+		AttachTrackToAudioMixers(participant_sid, subscribed_track);
 		if (e2ee_manager_ && receiver && publication &&
 		    publication->Encryption() == EncryptionType::Gcm) {
 			E2EEManagerNativeAccess::AttachReceiver(*e2ee_manager_, track_sid,
 			                                        participant->Identity(),
 			                                        subscribed_track->Kind(), std::move(receiver));
 		}
-		if (auto* listener = event_listener_.load()) {
-			listener->OnTrackSubscribed(subscribed_track.get(), participant.get());
-			if (publication && current_status != previous_status) {
-				listener->OnTrackSubscriptionStatusChanged(publication.get(), participant.get(),
-				                                           current_status);
-			}
-		}
+		PostEvent(EventCategory::Media,
+		          [subscribed_track, publication, participant,
+		           status_changed = current_status != previous_status,
+		           current_status](RoomEventInterface& listener) {
+			          listener.OnTrackSubscribed(subscribed_track.get(), participant.get());
+			          if (publication && status_changed) {
+				          listener.OnTrackSubscriptionStatusChanged(
+				              publication.get(), participant.get(), current_status);
+			          }
+		          });
 	}
 }
 
@@ -1248,12 +1423,10 @@ void Room::MediaTrackRemovedEvent(const std::string& track_sid) {
 			return;
 		}
 		track = found_track->second;
-		auto publications = participant->TrackPublicationsSnapshot();
-		auto found_publication = publications.find(track_sid);
-		if (found_publication == publications.end()) {
+		publication = participant->FindTrackPublication(track_sid);
+		if (!publication) {
 			return;
 		}
-		publication = found_publication->second;
 		if (auto* remote = dynamic_cast<RemoteTrackPublication*>(publication.get())) {
 			previous_status = remote->SubscriptionStatus();
 			remote->SetTrackAttached(false);
@@ -1264,13 +1437,16 @@ void Room::MediaTrackRemovedEvent(const std::string& track_sid) {
 		}
 		remote_tracks_.erase(found_track);
 	}
-	if (auto* listener = event_listener_.load()) {
-		listener->OnTrackUnsubscribed(track.get(), publication.get(), participant.get());
-		if (current_status != previous_status) {
-			listener->OnTrackSubscriptionStatusChanged(publication.get(), participant.get(),
-			                                           current_status);
-		}
-	}
+	DetachTrackConsumers(track_sid);
+	PostEvent(EventCategory::Media,
+	          [track, publication, participant, status_changed = current_status != previous_status,
+	           current_status](RoomEventInterface& listener) {
+		          listener.OnTrackUnsubscribed(track.get(), publication.get(), participant.get());
+		          if (status_changed) {
+			          listener.OnTrackSubscriptionStatusChanged(publication.get(),
+			                                                    participant.get(), current_status);
+		          }
+	          });
 }
 
 void Room::StreamStateUpdateEvent(const std::vector<livekit::StreamStateInfo>& updates) {
@@ -1283,36 +1459,38 @@ void Room::StreamStateUpdateEvent(const std::vector<livekit::StreamStateInfo>& u
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
 		for (const auto& update : updates) {
-			auto participant = remote_participants_.find(update.participant_sid());
+			auto participant = remote_participants_.FindBySid(update.participant_sid());
 			auto track = remote_tracks_.find(update.track_sid());
-			if (participant == remote_participants_.end() || track == remote_tracks_.end()) {
+			if (!participant || track == remote_tracks_.end()) {
 				continue;
 			}
-			auto publications = participant->second->TrackPublicationsSnapshot();
-			auto publication = publications.find(update.track_sid());
-			if (publication == publications.end()) {
+			auto publication = participant->FindTrackPublication(update.track_sid());
+			if (!publication) {
 				continue;
 			}
 			const auto state = update.state() == livekit::StreamState::PAUSED
 			                       ? TrackStreamState::Paused
 			                       : TrackStreamState::Active;
 			if (track->second->SetStreamState(state)) {
-				events.push_back({publication->second, participant->second, state});
+				events.push_back({std::move(publication), std::move(participant), state});
 			}
 		}
 	}
-	if (auto* listener = event_listener_.load()) {
-		for (const auto& event : events) {
-			listener->OnTrackStreamStateChanged(event.publication.get(), event.participant.get(),
-			                                    event.state);
-		}
+	if (!events.empty()) {
+		PostEvent(EventCategory::Media,
+		          [events = std::move(events)](RoomEventInterface& listener) {
+			          for (const auto& event : events) {
+				          listener.OnTrackStreamStateChanged(event.publication.get(),
+				                                             event.participant.get(), event.state);
+			          }
+		          });
 	}
 }
 
 void Room::DataChannelBufferStatusEvent(const DataChannelBufferStatus& status) {
-	if (auto* listener = event_listener_.load()) {
-		listener->OnDataChannelBufferStatusChanged(status);
-	}
+	PostEvent(EventCategory::Data, [status](RoomEventInterface& listener) {
+		listener.OnDataChannelBufferStatusChanged(status);
+	});
 }
 
 void Room::LocalTrackSubscribedEvent(const std::string& track_sid) {
@@ -1339,26 +1517,48 @@ void Room::SubscribedQualityUpdateEvent(const livekit::SubscribedQualityUpdate&
 	local_participant_->SubscribedQualityUpdate(std::move(converted));
 }
 
-void Room::DataPacketEvent(const livekit::DataPacket& packet) {
+void Room::DataPacketEvent(livekit::DataPacket packet) {
 	if (packet.has_user()) {
+		const auto& user = packet.user();
 		DataReceivedEvent event;
-		event.payload.assign(packet.user().payload().begin(), packet.user().payload().end());
-		event.topic = packet.user().has_topic() ? packet.user().topic() : "";
+		event.topic = user.has_topic() ? user.topic() : "";
 		event.participant_identity = packet.participant_identity();
 		if (event.participant_identity.empty()) {
-			event.participant_identity = packet.user().participant_identity();
+			event.participant_identity = user.participant_identity();
 		}
 		event.reliable = packet.kind() != livekit::DataPacket_Kind_LOSSY;
-		if (auto* listener = event_listener_.load()) {
-			listener->OnDataReceived(event);
+		// Lossy packets may be dropped when the data queue is full.
+		const auto post = [this](DataReceivedEvent event) {
+			const bool lossy = !event.reliable;
+			PostEvent(
+			    EventCategory::Data,
+			    [event = std::move(event)](RoomEventInterface& listener) {
+				    listener.OnDataReceived(event);
+			    },
+			    {}, lossy);
+		};
+		std::string batch_topic;
+		std::vector<std::string_view> messages;
+		if (event.topic == kDataBatchTopic &&
+		    DecodeDataBatchPacket(user.payload(), batch_topic, messages)) {
+			// A coalesced packet: deliver each payload as if it had been published on its own.
+			// Anything else on the reserved topic is delivered unchanged.
+			event.topic = std::move(batch_topic);
+			for (const auto message : messages) {
+				event.payload.assign(message.begin(), message.end());
+				post(event);
+			}
+			return;
 		}
+		event.payload.assign(user.payload().begin(), user.payload().end());
+		post(std::move(event));
 		return;
 	}
 	if (packet.has_sip_dtmf()) {
-		if (auto* listener = event_listener_.load()) {
-			listener->OnSipDtmfReceived({packet.sip_dtmf().code(), packet.sip_dtmf().digit(),
-			                             packet.participant_identity()});
-		}
+		PostEvent(EventCategory::Data,
+		          [event = SipDtmfEvent{packet.sip_dtmf().code(), packet.sip_dtmf().digit(),
+		                                packet.participant_identity()}](
+		              RoomEventInterface& listener) { listener.OnSipDtmfReceived(event); });
 		return;
 	}
 	if (packet.has_chat_message()) {
@@ -1373,9 +1573,9 @@ void Room::DataPacketEvent(const livekit::DataPacket& packet) {
 		event.deleted = chat.deleted();
 		event.generated = chat.generated();
 		event.participant_identity = packet.participant_identity();
-		if (auto* listener = event_listener_.load()) {
-			listener->OnChatMessageReceived(event);
-		}
+		PostEvent(EventCategory::Data, [event = std::move(event)](RoomEventInterface& listener) {
+			listener.OnChatMessageReceived(event);
+		});
 		return;
 	}
 	if (packet.has_transcription()) {
@@ -1405,9 +1605,9 @@ void Room::DataPacketEvent(const livekit::DataPacket& packet) {
 				event.segments.push_back(std::move(segment));
 			}
 		}
-		if (auto* listener = event_listener_.load()) {
-			listener->OnTranscriptionReceived(event);
-		}
+		PostEvent(EventCategory::Data, [event = std::move(event)](RoomEventInterface& listener) {
+			listener.OnTranscriptionReceived(event);
+		});
 		return;
 	}
 	if (packet.has_metrics()) {
@@ -1465,9 +1665,9 @@ void Room::DataPacketEvent(const livekit::DataPacket& packet) {
 			metric.metadata = input.metadata();
 			event.events.push_back(std::move(metric));
 		}
-		if (auto* listener = event_listener_.load()) {
-			listener->OnMetricsReceived(event);
-		}
+		PostEvent(EventCategory::Data, [event = std::move(event)](RoomEventInterface& listener) {
+			listener.OnMetricsReceived(event);
+		});
 		return;
 	}
 	if (packet.has_stream_header() && packet.stream_header().has_text_header()) {
@@ -1475,82 +1675,80 @@ void Room::DataPacketEvent(const livekit::DataPacket& packet) {
 		if (header.stream_id().empty() || !IsSupportedCompression(header.compression())) {
 			return;
 		}
-		IncomingText incoming;
-		incoming.event.stream_id = header.stream_id();
-		incoming.event.topic = header.topic();
-		incoming.event.participant_identity = packet.participant_identity();
-		incoming.event.reply_to_stream_id = header.text_header().reply_to_stream_id();
-		incoming.event.attached_stream_ids.assign(
+		auto incoming = std::make_shared<IncomingText>();
+		incoming->event.stream_id = header.stream_id();
+		incoming->event.topic = header.topic();
+		incoming->event.participant_identity = packet.participant_identity();
+		incoming->event.reply_to_stream_id = header.text_header().reply_to_stream_id();
+		incoming->event.attached_stream_ids.assign(
 		    header.text_header().attached_stream_ids().begin(),
 		    header.text_header().attached_stream_ids().end());
-		incoming.event.attributes.insert(header.attributes().begin(), header.attributes().end());
-		incoming.event.timestamp = header.timestamp();
-		incoming.info.stream_id = incoming.event.stream_id;
-		incoming.info.mime_type = header.mime_type();
-		incoming.info.topic = incoming.event.topic;
-		incoming.info.participant_identity = incoming.event.participant_identity;
-		incoming.info.reply_to_stream_id = incoming.event.reply_to_stream_id;
-		incoming.info.attached_stream_ids = incoming.event.attached_stream_ids;
-		incoming.info.attributes = incoming.event.attributes;
-		incoming.info.timestamp = incoming.event.timestamp;
+		incoming->event.attributes.insert(header.attributes().begin(), header.attributes().end());
+		incoming->event.timestamp = header.timestamp();
+		incoming->info.stream_id = incoming->event.stream_id;
+		incoming->info.mime_type = header.mime_type();
+		incoming->info.topic = incoming->event.topic;
+		incoming->info.participant_identity = incoming->event.participant_identity;
+		incoming->info.reply_to_stream_id = incoming->event.reply_to_stream_id;
+		incoming->info.attached_stream_ids = incoming->event.attached_stream_ids;
+		incoming->info.attributes = incoming->event.attributes;
+		incoming->info.timestamp = incoming->event.timestamp;
 		{
 			std::lock_guard<std::mutex> guard(stream_handlers_mutex_);
 			auto handler = text_stream_handlers_.find(header.topic());
 			if (handler != text_stream_handlers_.end()) {
-				incoming.handler = handler->second;
+				incoming->handler = handler->second;
 			}
 		}
 		if (header.has_total_length()) {
-			incoming.expected_length = header.total_length();
-			incoming.info.total_size = header.total_length();
+			incoming->expected_length = header.total_length();
+			incoming->info.total_size = header.total_length();
 			if ((header.compression() == livekit::DataStream_CompressionType_DEFLATE_RAW &&
-			     *incoming.expected_length > kMaximumBufferedDataStreamSize) ||
-			    (!incoming.handler &&
-			     (*incoming.expected_length > std::numeric_limits<std::size_t>::max() ||
-			      *incoming.expected_length > kMaximumBufferedDataStreamSize))) {
+			     *incoming->expected_length > kMaximumBufferedDataStreamSize) ||
+			    (!incoming->handler &&
+			     (*incoming->expected_length > std::numeric_limits<std::size_t>::max() ||
+			      *incoming->expected_length > kMaximumBufferedDataStreamSize))) {
 				return;
 			}
-			if (!incoming.handler) {
-				try {
-					incoming.event.text.reserve(
-					    static_cast<std::size_t>(*incoming.expected_length));
-				} catch (const std::exception&) {
-					return;
-				}
-			}
 		}
 		if (header.compression() == livekit::DataStream_CompressionType_DEFLATE_RAW) {
-			incoming.inflater =
+			incoming->inflater =
 			    std::make_unique<detail::InflateRawStream>(kMaximumBufferedDataStreamSize);
-			if (!incoming.inflater->IsValid()) {
+			if (!incoming->inflater->IsValid()) {
 				return;
 			}
 		}
 		if (header.has_inline_content()) {
 			std::vector<uint8_t> content;
 			if (!DecodeInlineContent(header, content) ||
-			    (incoming.expected_length && content.size() != *incoming.expected_length)) {
+			    (incoming->expected_length && content.size() != *incoming->expected_length)) {
 				return;
 			}
-			if (incoming.handler) {
-				TextStreamEvent event{incoming.info, DataStreamEventType::Open};
-				incoming.handler(event);
+			if (incoming->handler) {
+				TextStreamEvent event{incoming->info, DataStreamEventType::Open};
+				incoming->handler(event);
 				event.type = DataStreamEventType::Chunk;
 				event.content.assign(content.begin(), content.end());
-				incoming.handler(event);
+				incoming->handler(event);
 				event.type = DataStreamEventType::Closed;
 				event.content.clear();
-				incoming.handler(event);
+				incoming->handler(event);
 			} else {
-				incoming.event.text.assign(content.begin(), content.end());
-				if (auto* listener = event_listener_.load()) {
-					listener->OnTextReceived(incoming.event);
-				}
+				incoming->event.text.assign(content.begin(), content.end());
+				PostEvent(EventCategory::Data, [event = std::move(incoming->event)](
+				                                   RoomEventInterface& listener) {
+					listener.OnTextReceived(event);
+				});
 			}
 			return;
 		}
-		auto handler = incoming.handler;
-		auto info = incoming.info;
+		if (!incoming->handler) {
+			incoming->payload =
+			    std::make_unique<detail::StreamPayload>(options_.data_stream_spill_threshold);
+		}
+		incoming->deferred = incoming->inflater != nullptr || incoming->payload != nullptr;
+		auto handler = incoming->handler;
+		auto info = incoming->info;
 		{
 			std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
 			incoming_files_.erase(header.stream_id());
@@ -1566,84 +1764,74 @@ void Room::DataPacketEvent(const livekit::DataPacket& packet) {
 		if (header.stream_id().empty() || !IsSupportedCompression(header.compression())) {
 			return;
 		}
-		IncomingFile incoming;
-		incoming.event.stream_id = header.stream_id();
-		incoming.event.name = header.byte_header().name();
-		incoming.event.mime_type = header.mime_type();
-		incoming.event.topic = header.topic();
-		incoming.event.participant_identity = packet.participant_identity();
-		incoming.event.attributes.insert(header.attributes().begin(), header.attributes().end());
-		incoming.event.timestamp = header.timestamp();
-		incoming.info.stream_id = incoming.event.stream_id;
-		incoming.info.mime_type = incoming.event.mime_type;
-		incoming.info.topic = incoming.event.topic;
-		incoming.info.participant_identity = incoming.event.participant_identity;
-		incoming.info.attributes = incoming.event.attributes;
-		incoming.info.timestamp = incoming.event.timestamp;
-		incoming.info.name = incoming.event.name;
+		auto incoming = std::make_shared<IncomingFile>();
+		incoming->event.stream_id = header.stream_id();
+		incoming->event.name = header.byte_header().name();
+		incoming->event.mime_type = header.mime_type();
+		incoming->event.topic = header.topic();
+		incoming->event.participant_identity = packet.participant_identity();
+		incoming->event.attributes.insert(header.attributes().begin(), header.attributes().end());
+		incoming->event.timestamp = header.timestamp();
+		incoming->info.stream_id = incoming->event.stream_id;
+		incoming->info.mime_type = incoming->event.mime_type;
+		incoming->info.topic = incoming->event.topic;
+		incoming->info.participant_identity = incoming->event.participant_identity;
+		incoming->info.attributes = incoming->event.attributes;
+		incoming->info.timestamp = incoming->event.timestamp;
+		incoming->info.name = incoming->event.name;
 		{
 			std::lock_guard<std::mutex> guard(stream_handlers_mutex_);
 			auto handler = byte_stream_handlers_.find(header.topic());
 			if (handler != byte_stream_handlers_.end()) {
-				incoming.handler = handler->second;
+				incoming->handler = handler->second;
 			}
 		}
 		if (header.has_total_length()) {
-			incoming.expected_length = header.total_length();
-			incoming.info.total_size = header.total_length();
+			incoming->expected_length = header.total_length();
+			incoming->info.total_size = header.total_length();
 			if ((header.compression() == livekit::DataStream_CompressionType_DEFLATE_RAW &&
-			     *incoming.expected_length > kMaximumBufferedDataStreamSize) ||
-			    (!incoming.handler &&
-			     (*incoming.expected_length > std::numeric_limits<std::size_t>::max() ||
-			      *incoming.expected_length > kMaximumBufferedDataStreamSize))) {
+			     *incoming->expected_length > kMaximumBufferedDataStreamSize) ||
+			    (!incoming->handler &&
+			     (*incoming->expected_length > std::numeric_limits<std::size_t>::max() ||
+			      *incoming->expected_length > kMaximumBufferedDataStreamSize))) {
 				return;
 			}
-			if (!incoming.handler) {
-				try {
-					incoming.event.data.reserve(
-					    static_cast<std::size_t>(*incoming.expected_length));
-				} catch (const std::exception&) {
-					return;
-				}
-			}
 		}
 		if (header.compression() == livekit::DataStream_CompressionType_DEFLATE_RAW) {
-			incoming.inflater =
+			incoming->inflater =
 			    std::make_unique<detail::InflateRawStream>(kMaximumBufferedDataStreamSize);
-			if (!incoming.inflater->IsValid()) {
+			if (!incoming->inflater->IsValid()) {
 				return;
 			}
 		}
 		if (header.has_inline_content()) {
 			std::vector<uint8_t> content;
 			if (!DecodeInlineContent(header, content) ||
-			    (incoming.expected_length && content.size() != *incoming.expected_length)) {
+			    (incoming->expected_length && content.size() != *incoming->expected_length)) {
 				return;
 			}
-			if (incoming.handler) {
-				ByteStreamEvent event{incoming.info, DataStreamEventType::Open};
-				incoming.handler(event);
+			if (incoming->handler) {
+				ByteStreamEvent event{incoming->info, DataStreamEventType::Open};
+				incoming->handler(event);
 				event.type = DataStreamEventType::Chunk;
 				event.content = content;
-				incoming.handler(event);
+				incoming->handler(event);
 				event.type = DataStreamEventType::Closed;
 				event.content.clear();
-				incoming.handler(event);
+				incoming->handler(event);
 			} else {
-				incoming.event.data = std::move(content);
-				if (auto* listener = event_listener_.load()) {
-					ByteReceivedEvent byte_event;
-					static_cast<FileReceivedEvent&>(byte_event) = incoming.event;
-					listener->OnByteReceived(byte_event);
-					if (!incoming.event.name.empty()) {
-						listener->OnFileReceived(incoming.event);
-					}
-				}
+				incoming->event.data = std::move(content);
+				PostByteReceivedEvent(std::move(incoming->event));
 			}
 			return;
 		}
-		auto handler = incoming.handler;
-		auto info = incoming.info;
+		if (!incoming->handler) {
+			incoming->payload =
+			    std::make_unique<detail::StreamPayload>(options_.data_stream_spill_threshold);
+		}
+		incoming->deferred = incoming->inflater != nullptr || incoming->payload != nullptr;
+		auto handler = incoming->handler;
+		auto info = incoming->info;
 		{
 			std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
 			incoming_texts_.erase(header.stream_id());
@@ -1655,209 +1843,408 @@ void Room::DataPacketEvent(const livekit::DataPacket& packet) {
 		return;
 	}
 	if (packet.has_stream_chunk()) {
-		const auto& chunk = packet.stream_chunk();
-		TextStreamHandler text_handler;
-		TextStreamEvent text_event;
-		ByteStreamHandler byte_handler;
-		ByteStreamEvent byte_event;
-		{
-			std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
-			auto text = incoming_texts_.find(chunk.stream_id());
-			if (text != incoming_texts_.end()) {
-				std::string content = chunk.content();
-				bool content_valid = true;
-				if (text->second.inflater) {
-					const auto compressed_size = static_cast<uint64_t>(chunk.content().size());
-					std::vector<uint8_t> decoded;
-					content_valid = compressed_size <= kMaximumBufferedDataStreamSize -
-					                                       text->second.compressed_length &&
-					                text->second.inflater->Write(
-					                    reinterpret_cast<const uint8_t*>(chunk.content().data()),
-					                    chunk.content().size(), decoded);
-					if (content_valid) {
-						text->second.compressed_length += compressed_size;
-						content.assign(decoded.begin(), decoded.end());
-					}
-				}
-				const auto content_size = static_cast<uint64_t>(content.size());
-				if (!content_valid || chunk.chunk_index() != text->second.next_chunk ||
-				    content_size >
-				        std::numeric_limits<uint64_t>::max() - text->second.received_length ||
-				    (text->second.expected_length &&
-				     (text->second.received_length > *text->second.expected_length ||
-				      content_size >
-				          *text->second.expected_length - text->second.received_length)) ||
-				    (!text->second.handler && content_size > kMaximumBufferedDataStreamSize -
-				                                                 text->second.event.text.size())) {
-					text_handler = text->second.handler;
-					text_event = {text->second.info, DataStreamEventType::Failed, "",
-					              chunk.chunk_index(), "invalid stream chunk"};
-					incoming_texts_.erase(text);
-				} else {
-					text->second.received_length += content_size;
-					++text->second.next_chunk;
-					if (text->second.handler) {
-						text_handler = text->second.handler;
-						text_event = {text->second.info, DataStreamEventType::Chunk,
-						              std::move(content), chunk.chunk_index(), ""};
-					} else {
-						text->second.event.text.append(content);
-					}
-				}
-			} else {
-				auto bytes = incoming_files_.find(chunk.stream_id());
-				if (bytes == incoming_files_.end()) {
-					return;
-				}
-				std::vector<uint8_t> content(chunk.content().begin(), chunk.content().end());
-				bool content_valid = true;
-				if (bytes->second.inflater) {
-					const auto compressed_size = static_cast<uint64_t>(chunk.content().size());
-					content.clear();
-					content_valid = compressed_size <= kMaximumBufferedDataStreamSize -
-					                                       bytes->second.compressed_length &&
-					                bytes->second.inflater->Write(
-					                    reinterpret_cast<const uint8_t*>(chunk.content().data()),
-					                    chunk.content().size(), content);
-					if (content_valid) {
-						bytes->second.compressed_length += compressed_size;
-					}
-				}
-				const auto content_size = static_cast<uint64_t>(content.size());
-				if (!content_valid || chunk.chunk_index() != bytes->second.next_chunk ||
-				    content_size >
-				        std::numeric_limits<uint64_t>::max() - bytes->second.received_length ||
-				    (bytes->second.expected_length &&
-				     (bytes->second.received_length > *bytes->second.expected_length ||
-				      content_size >
-				          *bytes->second.expected_length - bytes->second.received_length)) ||
-				    (!bytes->second.handler &&
-				     content_size >
-				         kMaximumBufferedDataStreamSize - bytes->second.event.data.size())) {
-					byte_handler = bytes->second.handler;
-					byte_event = {bytes->second.info,
-					              DataStreamEventType::Failed,
-					              {},
-					              chunk.chunk_index(),
-					              "invalid stream chunk"};
-					incoming_files_.erase(bytes);
-				} else {
-					bytes->second.received_length += content_size;
-					++bytes->second.next_chunk;
-					if (bytes->second.handler) {
-						byte_handler = bytes->second.handler;
-						byte_event.info = bytes->second.info;
-						byte_event.type = DataStreamEventType::Chunk;
-						byte_event.content = std::move(content);
-						byte_event.chunk_index = chunk.chunk_index();
-					} else {
-						bytes->second.event.data.insert(bytes->second.event.data.end(),
-						                                content.begin(), content.end());
-					}
-				}
-			}
-		}
-		if (text_handler) {
-			text_handler(text_event);
-		}
-		if (byte_handler) {
-			byte_handler(byte_event);
+		if (!DeferStreamPacket(packet.stream_chunk().stream_id(), packet)) {
+			HandleStreamChunk(packet.stream_chunk());
 		}
 		return;
 	}
 	if (packet.has_stream_trailer()) {
-		TextReceivedEvent text_event;
-		bool has_text_event = false;
-		FileReceivedEvent event;
-		bool has_byte_event = false;
-		TextStreamHandler text_handler;
-		TextStreamEvent text_stream_event;
-		ByteStreamHandler byte_handler;
-		ByteStreamEvent byte_stream_event;
+		if (!DeferStreamPacket(packet.stream_trailer().stream_id(), packet)) {
+			HandleStreamTrailer(packet.stream_trailer());
+		}
+	}
+}
+
+bool Room::DeferStreamPacket(const std::string& stream_id, livekit::DataPacket& packet) {
+	{
+		std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
+		std::atomic<uint64_t>* queued_length = nullptr;
+		if (auto text = incoming_texts_.find(stream_id);
+		    text != incoming_texts_.end() && text->second->deferred) {
+			queued_length = &text->second->queued_length;
+		} else if (auto file = incoming_files_.find(stream_id);
+		           file != incoming_files_.end() && file->second->deferred) {
+			queued_length = &file->second->queued_length;
+		}
+		if (queued_length == nullptr) {
+			return false;
+		}
+		if (packet.has_stream_chunk()) {
+			queued_length->fetch_add(packet.stream_chunk().content().size());
+		}
+	}
+	// Once the room is being destroyed the runner refuses tasks and the packet is dropped.
+	if (packet.has_stream_chunk()) {
+		stream_worker_.Post([this, chunk = std::move(*packet.mutable_stream_chunk())] {
+			HandleStreamChunk(chunk);
+		});
+	} else {
+		stream_worker_.Post([this, trailer = std::move(*packet.mutable_stream_trailer())] {
+			HandleStreamTrailer(trailer);
+		});
+	}
+	return true;
+}
+
+void Room::HandleStreamChunk(const livekit::DataStream_Chunk& chunk) {
+	std::shared_ptr<IncomingText> text;
+	std::shared_ptr<IncomingFile> file;
+	{
+		std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
+		if (auto found = incoming_texts_.find(chunk.stream_id()); found != incoming_texts_.end()) {
+			text = found->second;
+		} else if (auto bytes = incoming_files_.find(chunk.stream_id());
+		           bytes != incoming_files_.end()) {
+			file = bytes->second;
+		}
+	}
+	const uint8_t* content = nullptr;
+	std::size_t content_size = 0;
+	if (text) {
+		TextStreamEvent event;
+		bool accepted = false;
 		{
+			std::lock_guard<std::mutex> guard(text->mutex);
+			accepted = AcceptStreamChunk(*text, chunk, content, content_size);
+			if (!accepted) {
+				event = {text->info, DataStreamEventType::Failed, "", chunk.chunk_index(),
+				         "invalid stream chunk"};
+			} else if (text->handler) {
+				event = {text->info, DataStreamEventType::Chunk,
+				         std::string(reinterpret_cast<const char*>(content), content_size),
+				         chunk.chunk_index(), ""};
+			}
+		}
+		if (!accepted) {
 			std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
-			auto text = incoming_texts_.find(packet.stream_trailer().stream_id());
-			if (text != incoming_texts_.end()) {
-				const bool complete =
-				    packet.stream_trailer().reason().empty() &&
-				    (!text->second.inflater || text->second.inflater->Finished()) &&
-				    (!text->second.expected_length ||
-				     text->second.received_length == *text->second.expected_length);
-				for (const auto& [key, value] : packet.stream_trailer().attributes()) {
-					text->second.event.attributes[key] = value;
-					text->second.info.attributes[key] = value;
-				}
-				if (text->second.handler) {
-					text_handler = text->second.handler;
-					text_stream_event.info = text->second.info;
-					text_stream_event.type =
-					    complete ? DataStreamEventType::Closed : DataStreamEventType::Failed;
-					text_stream_event.reason = packet.stream_trailer().reason();
-					if (!complete && text_stream_event.reason.empty()) {
-						text_stream_event.reason = "incomplete stream";
-					}
-				} else if (complete) {
-					text_event = std::move(text->second.event);
-					has_text_event = true;
-				}
-				incoming_texts_.erase(text);
+			if (auto found = incoming_texts_.find(chunk.stream_id());
+			    found != incoming_texts_.end() && found->second == text) {
+				incoming_texts_.erase(found);
 			}
-			auto it = incoming_files_.find(packet.stream_trailer().stream_id());
-			if (it != incoming_files_.end()) {
-				const bool complete = packet.stream_trailer().reason().empty() &&
-				                      (!it->second.inflater || it->second.inflater->Finished()) &&
-				                      (!it->second.expected_length ||
-				                       it->second.received_length == *it->second.expected_length);
-				for (const auto& [key, value] : packet.stream_trailer().attributes()) {
-					it->second.event.attributes[key] = value;
-					it->second.info.attributes[key] = value;
-				}
-				if (it->second.handler) {
-					byte_handler = it->second.handler;
-					byte_stream_event.info = it->second.info;
-					byte_stream_event.type =
-					    complete ? DataStreamEventType::Closed : DataStreamEventType::Failed;
-					byte_stream_event.reason = packet.stream_trailer().reason();
-					if (!complete && byte_stream_event.reason.empty()) {
-						byte_stream_event.reason = "incomplete stream";
-					}
-				} else if (complete) {
-					event = std::move(it->second.event);
-					has_byte_event = true;
-				}
-				incoming_files_.erase(it);
+		}
+		if (text->handler) {
+			text->handler(event);
+		}
+	}
+	if (file) {
+		ByteStreamEvent event;
+		bool accepted = false;
+		{
+			std::lock_guard<std::mutex> guard(file->mutex);
+			accepted = AcceptStreamChunk(*file, chunk, content, content_size);
+			if (!accepted) {
+				event = {file->info, DataStreamEventType::Failed, {}, chunk.chunk_index(),
+				         "invalid stream chunk"};
+			} else if (file->handler) {
+				event.info = file->info;
+				event.type = DataStreamEventType::Chunk;
+				event.content.assign(content, content + content_size);
+				event.chunk_index = chunk.chunk_index();
 			}
 		}
-		if (text_handler) {
-			text_handler(text_stream_event);
+		if (!accepted) {
+			std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
+			if (auto found = incoming_files_.find(chunk.stream_id());
+			    found != incoming_files_.end() && found->second == file) {
+				incoming_files_.erase(found);
+			}
 		}
-		if (byte_handler) {
-			byte_handler(byte_stream_event);
+		if (file->handler) {
+			file->handler(event);
 		}
-		if (auto* listener = event_listener_.load()) {
-			if (has_text_event) {
-				listener->OnTextReceived(text_event);
+	}
+}
+
+void Room::HandleStreamTrailer(const livekit::DataStream_Trailer& trailer) {
+	// Taken out of the maps first; reading back a buffered payload then holds only the stream.
+	std::shared_ptr<IncomingText> text;
+	std::shared_ptr<IncomingFile> file;
+	{
+		std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
+		if (auto found = incoming_texts_.find(trailer.stream_id());
+		    found != incoming_texts_.end()) {
+			text = std::move(found->second);
+			incoming_texts_.erase(found);
+		}
+		if (auto found = incoming_files_.find(trailer.stream_id());
+		    found != incoming_files_.end()) {
+			file = std::move(found->second);
+			incoming_files_.erase(found);
+		}
+	}
+	TextReceivedEvent text_event;
+	bool has_text_event = false;
+	FileReceivedEvent event;
+	bool has_byte_event = false;
+	TextStreamEvent text_stream_event;
+	ByteStreamEvent byte_stream_event;
+	if (text) {
+		std::lock_guard<std::mutex> guard(text->mutex);
+		const bool complete =
+		    trailer.reason().empty() && (!text->inflater || text->inflater->Finished()) &&
+		    (!text->expected_length || text->received_length == *text->expected_length);
+		for (const auto& [key, value] : trailer.attributes()) {
+			text->event.attributes[key] = value;
+			text->info.attributes[key] = value;
+		}
+		if (text->handler) {
+			text_stream_event.info = text->info;
+			text_stream_event.type =
+			    complete ? DataStreamEventType::Closed : DataStreamEventType::Failed;
+			text_stream_event.reason = trailer.reason();
+			if (!complete && text_stream_event.reason.empty()) {
+				text_stream_event.reason = "incomplete stream";
 			}
-			if (has_byte_event) {
-				ByteReceivedEvent byte_event;
-				static_cast<FileReceivedEvent&>(byte_event) = event;
-				listener->OnByteReceived(byte_event);
-				if (!event.name.empty()) {
-					listener->OnFileReceived(event);
-				}
+		} else if (complete && text->payload->TakeText(text->event.text)) {
+			text_event = std::move(text->event);
+			has_text_event = true;
+		}
+	}
+	if (file) {
+		std::lock_guard<std::mutex> guard(file->mutex);
+		const bool complete =
+		    trailer.reason().empty() && (!file->inflater || file->inflater->Finished()) &&
+		    (!file->expected_length || file->received_length == *file->expected_length);
+		for (const auto& [key, value] : trailer.attributes()) {
+			file->event.attributes[key] = value;
+			file->info.attributes[key] = value;
+		}
+		if (file->handler) {
+			byte_stream_event.info = file->info;
+			byte_stream_event.type =
+			    complete ? DataStreamEventType::Closed : DataStreamEventType::Failed;
+			byte_stream_event.reason = trailer.reason();
+			if (!complete && byte_stream_event.reason.empty()) {
+				byte_stream_event.reason = "incomplete stream";
 			}
+		} else if (complete && file->payload->TakeBytes(file->event.data)) {
+			event = std::move(file->event);
+			has_byte_event = true;
 		}
 	}
+	if (text && text->handler) {
+		text->handler(text_stream_event);
+	}
+	if (file && file->handler) {
+		file->handler(byte_stream_event);
+	}
+	if (has_text_event) {
+		PostEvent(EventCategory::Data, [event = std::move(text_event)](
+		                                   RoomEventInterface& listener) {
+			listener.OnTextReceived(event);
+		});
+	}
+	if (has_byte_event) {
+		PostByteReceivedEvent(std::move(event));
+	}
+}
+
+void Room::PostByteReceivedEvent(FileReceivedEvent event) {
+	PostEvent(EventCategory::Data, [event = std::move(event)](RoomEventInterface& listener) {
+		ByteReceivedEvent byte_event;
+		static_cast<FileReceivedEvent&>(byte_event) = event;
+		listener.OnByteReceived(byte_event);
+		if (!event.name.empty()) {
+			listener.OnFileReceived(event);
+		}
+	});
+}
+
+std::vector<IncomingDataStreamStats> Room::IncomingDataStreams() const {
+	std::vector<std::shared_ptr<IncomingText>> texts;
+	std::vector<std::shared_ptr<IncomingFile>> files;
+	{
+		std::lock_guard<std::mutex> guard(incoming_streams_mutex_);
+		for (const auto& [id, incoming] : incoming_texts_) {
+			texts.push_back(incoming);
+		}
+		for (const auto& [id, incoming] : incoming_files_) {
+			files.push_back(incoming);
+		}
+	}
+	std::vector<IncomingDataStreamStats> result;
+	result.reserve(texts.size() + files.size());
+	const auto add = [&result](auto& incoming) {
+		std::lock_guard<std::mutex> guard(incoming.mutex);
+		IncomingDataStreamStats stats;
+		stats.stream_id = incoming.info.stream_id;
+		stats.topic = incoming.info.topic;
+		stats.participant_identity = incoming.info.participant_identity;
+		stats.compressed = incoming.inflater != nullptr;
+		stats.has_handler = static_cast<bool>(incoming.handler);
+		stats.received_bytes = incoming.received_length;
+		stats.compressed_bytes = incoming.compressed_length;
+		stats.queued_bytes = incoming.queued_length.load();
+		if (incoming.payload) {
+			stats.memory_bytes = incoming.payload->MemoryBytes();
+			stats.spilled_bytes = incoming.payload->SpilledBytes();
+		}
+		result.push_back(std::move(stats));
+	};
+	for (const auto& incoming : texts) {
+		add(*incoming);
+	}
+	for (const auto& incoming : files) {
+		add(*incoming);
+	}
+	return result;
 }
 
 std::shared_ptr<RemoteParticipant>
 Room::FindRemoteParticipantForTrack(const std::string& track_sid) {
-	for (auto& [sid, participant] : remote_participants_) {
-		if (participant->HasTrackSid(track_sid)) {
-			return participant;
+	return remote_participants_.FindByTrackSid(track_sid);
+}
+
+void Room::IndexRemoteParticipant(const std::shared_ptr<RemoteParticipant>& participant) {
+	remote_participants_.Upsert(participant->Sid(), participant,
+	                            {participant->Identity(), participant->Name(),
+	                             participant->TrackSids()});
+}
+
+std::shared_ptr<AudioStreamInterface> Room::CreateAudioStream(const std::string& track_sid,
+                                                             AudioStreamOptions options) {
+	if (!RemoteAudioStream::IsValidOptions(options)) {
+		return nullptr;
+	}
+	std::shared_ptr<RemoteAudioTrack> track;
+	{
+		std::lock_guard<std::mutex> guard(participants_mutex_);
+		auto found = remote_tracks_.find(track_sid);
+		if (found != remote_tracks_.end()) {
+			track = std::dynamic_pointer_cast<RemoteAudioTrack>(found->second);
 		}
 	}
-	return nullptr;
+	if (!track) {
+		return nullptr;
+	}
+	auto stream = std::make_shared<RemoteAudioStream>(std::move(track), options);
+	RegisterFrameStream(stream);
+	return stream;
+}
+
+std::shared_ptr<VideoStreamInterface> Room::CreateVideoStream(const std::string& track_sid,
+                                                             VideoStreamOptions options) {
+	if (!RemoteVideoStream::IsValidOptions(options)) {
+		return nullptr;
+	}
+	std::shared_ptr<RemoteVideoTrack> track;
+	{
+		std::lock_guard<std::mutex> guard(participants_mutex_);
+		auto found = remote_tracks_.find(track_sid);
+		if (found != remote_tracks_.end()) {
+			track = std::dynamic_pointer_cast<RemoteVideoTrack>(found->second);
+		}
+	}
+	if (!track) {
+		return nullptr;
+	}
+	auto stream = std::make_shared<RemoteVideoStream>(std::move(track), options);
+	RegisterFrameStream(stream);
+	return stream;
+}
+
+bool Room::SetRemoteVideoRenderState(const std::string& track_sid, VideoRenderState state) {
+	std::shared_ptr<AdaptiveStream> adaptive_stream;
+	{
+		std::lock_guard<std::mutex> guard(adaptive_stream_mutex_);
+		adaptive_stream = adaptive_stream_;
+	}
+	if (!adaptive_stream) {
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> guard(participants_mutex_);
+		auto found = remote_tracks_.find(track_sid);
+		if (found == remote_tracks_.end() ||
+		    std::dynamic_pointer_cast<RemoteVideoTrack>(found->second) == nullptr) {
+			return false;
+		}
+	}
+	adaptive_stream->Update(track_sid, state);
+	return true;
+}
+
+bool Room::ApplyVideoRenderState(const std::string& track_sid, const VideoRenderState& state) {
+	std::shared_ptr<TrackPublicationInterface> publication;
+	{
+		std::lock_guard<std::mutex> guard(participants_mutex_);
+		auto participant = FindRemoteParticipantForTrack(track_sid);
+		if (!participant) {
+			return false;
+		}
+		publication = participant->FindTrackPublication(track_sid);
+		if (!publication) {
+			return false;
+		}
+	}
+	auto* remote = dynamic_cast<RemoteTrackPublication*>(publication.get());
+	return remote != nullptr && remote->UpdateRemoteTrackSettings(AdaptRemoteTrackSettings(
+	                                remote->GetRemoteTrackSettings(), state));
+}
+
+RemoteAudioMixer::ResolvedTrack Room::ResolveRemoteAudioTrack(const std::string& track_sid) {
+	std::lock_guard<std::mutex> guard(participants_mutex_);
+	auto found = remote_tracks_.find(track_sid);
+	auto participant = FindRemoteParticipantForTrack(track_sid);
+	if (found == remote_tracks_.end() || !participant) {
+		return {};
+	}
+	return {participant->Sid(), std::dynamic_pointer_cast<RemoteAudioTrack>(found->second)};
+}
+
+void Room::AttachTrackToAudioMixers(const std::string& participant_sid,
+                                    const std::shared_ptr<RemoteTrack>& track) {
+	auto audio = std::dynamic_pointer_cast<RemoteAudioTrack>(track);
+	if (!audio) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(track_consumers_mutex_);
+	for (const auto& weak : audio_mixers_) {
+		auto mixer = weak.lock();
+		if (mixer && mixer->Options().include_all_tracks) {
+			mixer->AttachTrack(participant_sid, audio);
+		}
+	}
+}
+
+void Room::DetachTrackConsumers(const std::string& track_sid) {
+	{
+		std::lock_guard<std::mutex> guard(adaptive_stream_mutex_);
+		if (adaptive_stream_) {
+			adaptive_stream_->Remove(track_sid);
+		}
+	}
+	std::lock_guard<std::mutex> guard(track_consumers_mutex_);
+	for (const auto& weak : audio_mixers_) {
+		if (auto mixer = weak.lock()) {
+			mixer->RemoveTrack(track_sid);
+		}
+	}
+	for (const auto& weak : frame_streams_) {
+		auto stream = weak.lock();
+		if (stream && stream->TrackSid() == track_sid) {
+			stream->Close();
+		}
+	}
+}
+
+void Room::RegisterFrameStream(const std::shared_ptr<RemoteFrameStream>& stream) {
+	{
+		std::lock_guard<std::mutex> guard(track_consumers_mutex_);
+		frame_streams_.erase(std::remove_if(frame_streams_.begin(), frame_streams_.end(),
+		                                    [](const auto& weak) { return weak.expired(); }),
+		                     frame_streams_.end());
+		frame_streams_.push_back(stream);
+	}
+	// The track may have been unsubscribed between lookup and registration.
+	bool subscribed = false;
+	{
+		std::lock_guard<std::mutex> guard(participants_mutex_);
+		subscribed = remote_tracks_.count(stream->TrackSid()) != 0;
+	}
+	if (!subscribed) {
+		stream->Close();
+	}
 }
 
 void Room::NotifyAudioFrame(const std::string& participant_sid, const std::string& track_sid,
@@ -1866,12 +2253,11 @@ void Room::NotifyAudioFrame(const std::string& participant_sid, const std::strin
 	std::shared_ptr<RemoteTrack> track;
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
-		auto it = remote_participants_.find(participant_sid);
+		participant = remote_participants_.FindBySid(participant_sid);
 		auto track_it = remote_tracks_.find(track_sid);
-		if (it == remote_participants_.end() || track_it == remote_tracks_.end()) {
+		if (!participant || track_it == remote_tracks_.end()) {
 			return;
 		}
-		participant = it->second;
 		track = track_it->second;
 	}
 	if (auto* listener = event_listener_.load()) {
@@ -1885,12 +2271,11 @@ void Room::NotifyVideoFrame(const std::string& participant_sid, const std::strin
 	std::shared_ptr<RemoteTrack> track;
 	{
 		std::lock_guard<std::mutex> guard(participants_mutex_);
-		auto it = remote_participants_.find(participant_sid);
+		participant = remote_participants_.FindBySid(participant_sid);
 		auto track_it = remote_tracks_.find(track_sid);
-		if (it == remote_participants_.end() || track_it == remote_tracks_.end()) {
+		if (!participant || track_it == remote_tracks_.end()) {
 			return;
 		}
-		participant = it->second;
 		track = track_it->second;
 	}
 	if (auto* listener = event_listener_.load()) {
@@ -1898,6 +2283,24 @@ void Room::NotifyVideoFrame(const std::string& participant_sid, const std::strin
 	}
 }
 
+void Room::NotifyVideoFrameBuffer(const std::string& participant_sid, const std::string& track_sid,
+                                  const VideoFrameBuffer& frame) {
+	std::shared_ptr<RemoteParticipant> participant;
+	std::shared_ptr<RemoteTrack> track;
+	{
+		std::lock_guard<std::mutex> guard(participants_mutex_);
+		participant = remote_participants_.FindBySid(participant_sid);
+		auto track_it = remote_tracks_.find(track_sid);
+		if (!participant || track_it == remote_tracks_.end()) {
+			return;
+		}
+		track = track_it->second;
+	}
+	if (auto* listener = event_listener_.load()) {
+		listener->OnVideoFrameBuffer(track.get(), participant.get(), frame);
+	}
+}
+
 void Room::ApplyParticipantUpdates(const std::vector<livekit::ParticipantInfo>& updates,
                                    bool emit_events) {
 	struct PublicationEvent {
@@ -2011,10 +2414,10 @@ void Room::ApplyParticipantUpdates(const std::vector<livekit::ParticipantInfo>&
 				continue;
 			}
 
-			auto participant = remote_participants_.find(info.sid());
+			auto participant = remote_participants_.FindBySid(info.sid());
 			if (info.state() == livekit::ParticipantInfo_State_DISCONNECTED) {
-				if (participant != remote_participants_.end()) {
-					auto retained = participant->second;
+				if (participant) {
+					auto retained = participant;
 					for (const auto& [sid, publication] : retained->TrackPublicationsSnapshot()) {
 						auto track = remote_tracks_.find(sid);
 						if (track != remote_tracks_.end() && emit_events) {
@@ -2038,7 +2441,7 @@ void Room::ApplyParticipantUpdates(const std::vector<livekit::ParticipantInfo>&
 							unpublished.push_back({publication, retained});
 						}
 					}
-					remote_participants_.erase(participant);
+					remote_participants_.Erase(info.sid());
 					if (emit_events) {
 						disconnected.push_back(std::move(retained));
 					}
@@ -2046,10 +2449,10 @@ void Room::ApplyParticipantUpdates(const std::vector<livekit::ParticipantInfo>&
 				continue;
 			}
 
-			if (participant == remote_participants_.end()) {
+			if (!participant) {
 				auto added = std::make_shared<RemoteParticipant>(
 				    info, options_.auto_subscribe, CreateRemotePublicationHandlers(info.sid()));
-				remote_participants_.emplace(info.sid(), added);
+				IndexRemoteParticipant(added);
 				if (emit_events) {
 					connected.push_back(added);
 					for (const auto& [sid, publication] : added->TrackPublicationsSnapshot()) {
@@ -2059,7 +2462,7 @@ void Room::ApplyParticipantUpdates(const std::vector<livekit::ParticipantInfo>&
 				continue;
 			}
 
-			auto retained = participant->second;
+			auto retained = participant;
 			const auto old_metadata = retained->Metadata();
 			const auto old_name = retained->Name();
 			const auto old_attributes = retained->Attributes();
@@ -2070,6 +2473,7 @@ void Room::ApplyParticipantUpdates(const std::vector<livekit::ParticipantInfo>&
 				old_mutes[sid] = publication->IsMuted();
 			}
 			retained->UpdateFromInfo(info);
+			IndexRemoteParticipant(retained);
 			const auto new_publications = retained->TrackPublicationsSnapshot();
 			if (!emit_events) {
 				continue;
@@ -2136,48 +2540,61 @@ void Room::ApplyParticipantUpdates(const std::vector<livekit::ParticipantInfo>&
 			                                FrameCryptorDirection::Receiver);
 		}
 	}
+	for (const auto& track_id : removed_cryptors) {
+		DetachTrackConsumers(track_id);
+	}
 
-	if (auto* listener = event_listener_.load()) {
+	// One event for the whole update, so participants join before their tracks are published
+	// and leave after they are unpublished.
+	auto notify = [connected = std::move(connected), published = std::move(published),
+	               mute_changed = std::move(mute_changed), unsubscribed = std::move(unsubscribed),
+	               unpublished = std::move(unpublished),
+	               metadata_changed = std::move(metadata_changed),
+	               name_changed = std::move(name_changed),
+	               attributes_changed = std::move(attributes_changed),
+	               permissions_changed = std::move(permissions_changed),
+	               disconnected = std::move(disconnected)](RoomEventInterface& listener) {
 		for (const auto& participant : connected) {
-			listener->OnParticipantConnected(participant.get());
+			listener.OnParticipantConnected(participant.get());
 		}
 		for (const auto& event : published) {
-			listener->OnTrackPublished(event.publication.get(), event.participant.get());
+			listener.OnTrackPublished(event.publication.get(), event.participant.get());
 		}
 		for (const auto& event : mute_changed) {
 			if (event.muted) {
-				listener->OnTrackMuted(event.publication.get(), event.participant);
+				listener.OnTrackMuted(event.publication.get(), event.participant);
 			} else {
-				listener->OnTrackUnmuted(event.publication.get(), event.participant);
+				listener.OnTrackUnmuted(event.publication.get(), event.participant);
 			}
 		}
 		for (const auto& event : unsubscribed) {
-			listener->OnTrackUnsubscribed(event.track.get(), event.publication.get(),
-			                              event.participant.get());
+			listener.OnTrackUnsubscribed(event.track.get(), event.publication.get(),
+			                             event.participant.get());
 			if (event.status_changed) {
-				listener->OnTrackSubscriptionStatusChanged(event.publication.get(),
-				                                           event.participant.get(), event.status);
+				listener.OnTrackSubscriptionStatusChanged(event.publication.get(),
+				                                          event.participant.get(), event.status);
 			}
 		}
 		for (const auto& event : unpublished) {
-			listener->OnTrackUnpublished(event.publication.get(), event.participant.get());
+			listener.OnTrackUnpublished(event.publication.get(), event.participant.get());
 		}
 		for (const auto& event : metadata_changed) {
-			listener->OnParticipantMetadataChanged(event.value, event.participant);
+			listener.OnParticipantMetadataChanged(event.value, event.participant);
 		}
 		for (const auto& event : name_changed) {
-			listener->OnParticipantNameChanged(event.value, event.participant);
+			listener.OnParticipantNameChanged(event.value, event.participant);
 		}
 		for (const auto& event : attributes_changed) {
-			listener->OnParticipantAttributesChanged(event.changes, event.participant);
+			listener.OnParticipantAttributesChanged(event.changes, event.participant);
 		}
 		for (const auto& event : permissions_changed) {
-			listener->OnParticipantPermissionsChanged(event.previous, event.participant);
+			listener.OnParticipantPermissionsChanged(event.previous, event.participant);
 		}
 		for (const auto& participant : disconnected) {
-			listener->OnParticipantDisconnected(participant.get());
+			listener.OnParticipantDisconnected(participant.get());
 		}
-	}
+	};
+	PostEvent(EventCategory::Connection, std::move(notify));
 
 	for (auto& track : ready_tracks) {
 		MediaTrackEvent(std::move(track.track), std::move(track.receiver),
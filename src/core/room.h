@@ -22,10 +22,16 @@
 
 #include "livekit/core/room_interface.h"
 
+#include "detail/adaptive_stream.h"
 #include "detail/data_stream_compression.h"
+#include "detail/event_dispatcher.h"
+#include "detail/participant_registry.h"
+#include "detail/stream_reassembly.h"
 #include "livekit/core/e2ee/e2ee_manager.h"
 #include "participant/local_participant.h"
 #include "participant/remote_participant.h"
+#include "track/remote_audio_mixer.h"
+#include "track/remote_frame_stream.h"
 #include "track/remote_track.h"
 
 #include <atomic>
@@ -68,6 +74,7 @@ public:
 	std::vector<RemoteParticipantSnapshot> GetRemoteParticipantSnapshots() const;
 	virtual RemoteParticipantInterface* GetRemoteParticipantBySid(std::string sid) override;
 	virtual RemoteParticipantInterface* GetRemoteParticipantByName(std::string name) override;
+	RemoteParticipantInterface* GetRemoteParticipantByIdentity(const std::string& identity);
 	virtual std::vector<ParticipantInterface*> Participants() override;
 	virtual ParticipantInterface* GetParticipantBySid(std::string sid) override;
 	virtual ParticipantInterface* GetParticipantByName(std::string name) override;
@@ -76,6 +83,7 @@ public:
 	                                      bool subscribed);
 	bool UpdateRemoteTrackSettingsInternal(std::string participant_sid, std::string track_sid,
 	                                       const RemoteTrackSettings& settings);
+	bool SharesAudioDevice() const override;
 	bool SetAudioOutputDevice(std::string device_id) override;
 	std::string AudioOutputDevice() const override;
 	bool SetSpeakerVolume(float volume) override;
@@ -83,11 +91,22 @@ public:
 	bool SetSpeakerMuted(bool muted) override;
 	bool SpeakerMuted() const override;
 	AudioPlaybackStats GetAudioPlaybackStats() const override;
+	std::shared_ptr<AudioMixerInterface>
+	CreateAudioMixer(AudioMixerOptions options = {}) override;
+	std::shared_ptr<AudioStreamInterface>
+	CreateAudioStream(const std::string& track_sid, AudioStreamOptions options = {}) override;
+	std::shared_ptr<VideoStreamInterface>
+	CreateVideoStream(const std::string& track_sid, VideoStreamOptions options = {}) override;
 	E2EEManager* GetE2EEManager() override;
+	bool SetRemoteVideoRenderState(const std::string& track_sid, VideoRenderState state) override;
+	std::vector<IncomingDataStreamStats> IncomingDataStreams() const override;
+	EventDispatchStats GetEventDispatchStats() const override;
 	bool SimulateSignalDisconnectForTesting();
 	bool SimulateFullReconnectForTesting();
 	bool SimulateMediaFailureForTesting();
 	std::string AccessTokenForReconnectForTesting() const;
+	// Waits until the compressed stream chunks and listener events queued so far are delivered.
+	void FlushEventsForTesting();
 
 	/* Pure virtual methods inherited from RtcEngineListener */
 public:
@@ -98,7 +117,7 @@ public:
 	                     webrtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver,
 	                     std::function<std::string()> stats_provider) override;
 	void MediaTrackRemovedEvent(const std::string& track_sid) override;
-	void DataPacketEvent(const livekit::DataPacket& packet) override;
+	void DataPacketEvent(livekit::DataPacket packet) override;
 	void RemoteMuteChangedEvent(const std::string& sid, bool muted) override;
 	void LocalTrackUnpublishedEvent(const std::string& sid) override;
 	void SpeakersChangedEvent(const std::vector<livekit::SpeakerInfo>& updates) override;
@@ -123,11 +142,21 @@ private:
 	                             bool emit_events = true);
 	void ApplyJoinResponse(const livekit::JoinResponse& join_response, bool reconnecting);
 	std::shared_ptr<RemoteParticipant> FindRemoteParticipantForTrack(const std::string& track_sid);
+	// Adds the participant to remote_participants_ or refreshes its identity, name and track sids
+	// there. Call with participants_mutex_ held after every change to its info.
+	void IndexRemoteParticipant(const std::shared_ptr<RemoteParticipant>& participant);
 	void NotifyAudioFrame(const std::string& participant_sid, const std::string& track_sid,
 	                      const AudioFrame& frame);
 	void NotifyVideoFrame(const std::string& participant_sid, const std::string& track_sid,
 	                      const VideoFrame& frame);
+	void NotifyVideoFrameBuffer(const std::string& participant_sid, const std::string& track_sid,
+	                            const VideoFrameBuffer& frame);
 	void NotifyDisconnectedOnce(DisconnectReason reason);
+	RemoteAudioMixer::ResolvedTrack ResolveRemoteAudioTrack(const std::string& track_sid);
+	void AttachTrackToAudioMixers(const std::string& participant_sid,
+	                              const std::shared_ptr<RemoteTrack>& track);
+	void DetachTrackConsumers(const std::string& track_sid);
+	void RegisterFrameStream(const std::shared_ptr<RemoteFrameStream>& stream);
 	bool SetState(RoomState state);
 	bool TransitionState(RoomState expected, RoomState state);
 	bool SendRemoteTrackSubscribed(const std::string& participant_sid, const std::string& track_sid,
@@ -140,40 +169,69 @@ private:
 	RemoteParticipant::PublicationHandlers
 	CreateRemotePublicationHandlers(const std::string& participant_sid);
 	void ResendRemoteTrackPreferences();
+	bool ApplyVideoRenderState(const std::string& track_sid, const VideoRenderState& state);
 	void FailIncomingDataStreams(const std::string& reason);
+	// Moves a chunk or trailer of a deferred incoming stream to stream_worker_, keeping it behind
+	// the stream's earlier chunks. Returns false for streams handled inline.
+	bool DeferStreamPacket(const std::string& stream_id, livekit::DataPacket& packet);
+	void HandleStreamChunk(const livekit::DataStream_Chunk& chunk);
+	void HandleStreamTrailer(const livekit::DataStream_Trailer& trailer);
+	// Raises OnByteReceived, and OnFileReceived for named streams, for a completed byte stream.
+	void PostByteReceivedEvent(FileReceivedEvent event);
 	void ConfigureE2ee(const std::optional<E2eeOptions>& options);
+	// Hands a listener callback to event_dispatcher_. The listener is read when the event is
+	// delivered, so one removed in the meantime is not called.
+	void PostEvent(EventCategory category, std::function<void(RoomEventInterface&)> notify,
+	               std::string coalesce_key = {}, bool lossy = false);
 
+	// Shared between the maps and the thread working on the stream. mutex guards the reassembly
+	// state, so inflating and spilling never hold incoming_streams_mutex_; handler, inflater and
+	// deferred are fixed before the stream is added to a map.
 	struct IncomingFile {
+		std::mutex mutex;
 		FileReceivedEvent event;
 		ByteStreamInfo info;
 		ByteStreamHandler handler;
 		std::optional<uint64_t> expected_length;
 		uint64_t received_length = 0;
 		uint64_t compressed_length = 0;
+		std::atomic<uint64_t> queued_length{0};
 		uint64_t next_chunk = 0;
 		std::unique_ptr<detail::InflateRawStream> inflater;
+		std::vector<uint8_t> inflated;
+		// Set while no handler reads the stream; the payload waits here for the trailer.
+		std::unique_ptr<detail::StreamPayload> payload;
+		// Compressed or buffered: chunks and the trailer are handled on stream_worker_.
+		bool deferred = false;
 	};
 	struct IncomingText {
+		std::mutex mutex;
 		TextReceivedEvent event;
 		TextStreamInfo info;
 		TextStreamHandler handler;
 		std::optional<uint64_t> expected_length;
 		uint64_t received_length = 0;
 		uint64_t compressed_length = 0;
+		std::atomic<uint64_t> queued_length{0};
 		uint64_t next_chunk = 0;
 		std::unique_ptr<detail::InflateRawStream> inflater;
+		std::vector<uint8_t> inflated;
+		std::unique_ptr<detail::StreamPayload> payload;
+		bool deferred = false;
 	};
 
 	RoomOptions options_;
 	std::atomic<RoomState> state_{RoomState::Disconnected};
 	std::atomic<bool> disconnected_event_emitted_{false};
 	std::atomic<bool> full_reconnect_prepared_{false};
+	// Whether the options of the latest Connect() (or the constructor) carry a peer factory.
+	std::atomic<bool> options_share_peer_factory_{false};
 	std::atomic<DisconnectReason> disconnect_reason_{DisconnectReason::Unknown};
 	std::unique_ptr<RtcEngine> rtc_engine_ = nullptr;
 	std::unique_ptr<E2EEManager> e2ee_manager_ = nullptr;
 	std::unique_ptr<LocalParticipant> local_participant_ = nullptr;
 	mutable std::mutex participants_mutex_;
-	std::map<std::string, std::shared_ptr<RemoteParticipant>> remote_participants_;
+	detail::ParticipantRegistry<RemoteParticipant> remote_participants_;
 	std::map<std::string, std::shared_ptr<RemoteTrack>> remote_tracks_;
 	struct PendingMediaTrack {
 		webrtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track;
@@ -181,9 +239,21 @@ private:
 		std::function<std::string()> stats_provider;
 	};
 	std::map<std::string, PendingMediaTrack> pending_media_tracks_;
-	std::mutex incoming_streams_mutex_;
-	std::map<std::string, IncomingFile> incoming_files_;
-	std::map<std::string, IncomingText> incoming_texts_;
+	// Mixers and streams attached to remote tracks. Lock order: a mixer's own mutex may be held
+	// while resolving tracks under participants_mutex_, so consumers are only called after
+	// participants_mutex_ is released.
+	std::mutex track_consumers_mutex_;
+	std::vector<std::weak_ptr<RemoteAudioMixer>> audio_mixers_;
+	std::vector<std::weak_ptr<RemoteFrameStream>> frame_streams_;
+	// Replaced on each connect; null unless RoomOptions::adaptive_stream is set.
+	mutable std::mutex adaptive_stream_mutex_;
+	std::shared_ptr<AdaptiveStream> adaptive_stream_;
+	mutable std::mutex incoming_streams_mutex_;
+	std::map<std::string, std::shared_ptr<IncomingFile>> incoming_files_;
+	std::map<std::string, std::shared_ptr<IncomingText>> incoming_texts_;
+	// Inflates, spills and reads back deferred incoming streams off the data channel thread.
+	// Stopped first on destruction, since its tasks use the stream maps.
+	detail::SerialTaskRunner stream_worker_;
 	std::mutex transcription_mutex_;
 	std::map<std::string, int64_t> transcription_received_times_;
 	std::mutex stream_handlers_mutex_;
@@ -194,6 +264,9 @@ private:
 	livekit::Room room_info_;
 
 	std::atomic<RoomEventInterface*> event_listener_{nullptr};
+	// Delivers listener callbacks off the engine threads. Stopped last on destruction, after the
+	// engine can no longer raise events; events queued by then are still delivered.
+	detail::EventDispatcher event_dispatcher_;
 };
 
 } // namespace core
@@ -28,6 +28,14 @@
 namespace livekit {
 namespace core {
 
+namespace {
+
+// start sending silence when there is nothing on the queue for 10 frames
+// (100ms)
+constexpr int kSilenceFramesThreshold = 10;
+
+} // namespace
+
 inline webrtc::AudioOptions to_webrtc_audio_options(const AudioSourceOptions& options) {
 	webrtc::AudioOptions rtc_options{};
 	rtc_options.echo_cancellation = options.echo_cancellation;
@@ -67,6 +75,11 @@ AudioSource* AudioSource::Create(AudioSourceOptions options, uint32_t sample_rat
 	                       GetGlobalTaskQueueFactory());
 }
 
+AudioSourceQueueStats GetAudioSourceQueueStats(const AudioSourceInterface* source) {
+	const auto* audio_source = dynamic_cast<const AudioSource*>(source);
+	return audio_source != nullptr ? audio_source->Get()->queue_stats() : AudioSourceQueueStats{};
+}
+
 AudioSourceInterface* CreateAudioSource(AudioSourceOptions options, uint32_t sample_rate,
                                         uint32_t num_channels, uint32_t queue_size_ms) {
 	return AudioSource::Create(options, sample_rate, num_channels, queue_size_ms);
@@ -80,10 +93,7 @@ AudioSource::InternalSource::InternalSource(const webrtc::AudioOptions& options,
 	if (!queue_size_ms)
 		return; // no audio queue
 
-	// start sending silence when there is nothing on the queue for 10 frames
-	// (100ms)
-	const int silence_frames_threshold = 10;
-	missed_frames_ = silence_frames_threshold;
+	missed_frames_ = kSilenceFramesThreshold;
 
 	int samples10ms = sample_rate / 100 * num_channels;
 
@@ -91,7 +101,9 @@ AudioSource::InternalSource::InternalSource(const webrtc::AudioOptions& options,
 	queue_size_samples_ = queue_size_ms / 10 * samples10ms;
 	notify_threshold_samples_ = queue_size_samples_; // TODO: this is currently
 	                                                 // using x2 the queue size
-	buffer_.reserve(queue_size_samples_ + notify_threshold_samples_);
+	queue_ = std::make_unique<SpscRingBuffer<int16_t>>(queue_size_samples_ +
+	                                                   notify_threshold_samples_);
+	frame_buffer_.resize(samples10ms);
 
 	audio_queue_ = std::move(task_queue_factory->CreateTaskQueue(
 	    "AudioSourceCapture", webrtc::TaskQueueFactory::Priority::NORMAL));
@@ -99,23 +111,7 @@ AudioSource::InternalSource::InternalSource(const webrtc::AudioOptions& options,
 	audio_task_ = webrtc::RepeatingTaskHandle::Start(
 	    audio_queue_.get(),
 	    [this, samples10ms]() {
-		    webrtc::MutexLock lock(&mutex_);
-
-		    if (buffer_.size() >= samples10ms) {
-			    for (auto sink : sinks_)
-				    sink->OnData(buffer_.data(), sizeof(int16_t) * 8, sample_rate_, num_channels_,
-				                 samples10ms / num_channels_);
-
-			    buffer_.erase(buffer_.begin(), buffer_.begin() + samples10ms);
-		    } else {
-			    missed_frames_++;
-			    if (missed_frames_ >= silence_frames_threshold) {
-				    for (auto sink : sinks_)
-					    sink->OnData(silence_buffer_, sizeof(int16_t) * 8, sample_rate_,
-					                 num_channels_, samples10ms / num_channels_);
-			    }
-		    }
-
+		    DeliverQueuedFrame(samples10ms);
 		    return webrtc::TimeDelta::Millis(10);
 	    },
 	    webrtc::TaskQueueBase::DelayPrecision::kHigh);
@@ -126,29 +122,48 @@ AudioSource::InternalSource::~InternalSource() {
 	delete[] silence_buffer_;
 }
 
+void AudioSource::InternalSource::DeliverQueuedFrame(std::size_t samples10ms) {
+	queue_->DiscardUntil(clear_position_.load(std::memory_order_acquire));
+	// Dequeue before taking the sink lock; the producer never takes it.
+	const bool has_frame = queue_->Read(frame_buffer_.data(), samples10ms);
+	webrtc::MutexLock lock(&mutex_);
+	if (has_frame) {
+		missed_frames_ = 0;
+		for (auto sink : sinks_)
+			sink->OnData(frame_buffer_.data(), sizeof(int16_t) * 8, sample_rate_, num_channels_,
+			             samples10ms / num_channels_);
+		return;
+	}
+	underrun_frames_.fetch_add(1, std::memory_order_relaxed);
+	missed_frames_++;
+	if (missed_frames_ >= kSilenceFramesThreshold) {
+		for (auto sink : sinks_)
+			sink->OnData(silence_buffer_, sizeof(int16_t) * 8, sample_rate_, num_channels_,
+			             samples10ms / num_channels_);
+	}
+}
+
 bool AudioSource::InternalSource::capture_frame(void* data, uint32_t sample_rate,
                                                 uint32_t number_of_channels,
                                                 size_t number_of_frames) {
 	if (data == nullptr || sample_rate == 0 || number_of_channels == 0 || number_of_frames == 0) {
 		return false;
 	}
-	webrtc::MutexLock lock(&mutex_);
 	if (number_of_frames > std::numeric_limits<std::size_t>::max() / number_of_channels) {
 		return false;
 	}
 	const std::size_t total_samples = number_of_frames * number_of_channels;
 
-	if (queue_size_samples_) {
-		const std::size_t capacity = queue_size_samples_ + notify_threshold_samples_;
-		if (buffer_.size() > capacity || total_samples > capacity - buffer_.size()) {
+	if (queue_) {
+		// Producers only serialise among themselves; the delivery task never takes this lock.
+		webrtc::MutexLock producer_lock(&producer_mutex_);
+		if (!queue_->Write(static_cast<const int16_t*>(data), total_samples)) {
+			overrun_frames_.fetch_add(1, std::memory_order_relaxed);
 			return false;
 		}
-
-		int16_t* pcm_data = static_cast<int16_t*>(data);
-		buffer_.insert(buffer_.end(), pcm_data, pcm_data + total_samples);
-		missed_frames_ = 0;
 	} else {
 		// capture directly when the queue buffer is 0 (frame size must be 10ms)
+		webrtc::MutexLock lock(&mutex_);
 		for (auto sink : sinks_)
 			sink->OnData(data, sizeof(int16_t) * 8, sample_rate, number_of_channels,
 			             number_of_frames);
@@ -158,8 +173,23 @@ bool AudioSource::InternalSource::capture_frame(void* data, uint32_t sample_rate
 }
 
 void AudioSource::InternalSource::clear_buffer() {
-	webrtc::MutexLock lock(&mutex_);
-	buffer_.clear();
+	if (!queue_) {
+		return;
+	}
+	webrtc::MutexLock producer_lock(&producer_mutex_);
+	clear_position_.store(queue_->WritePosition(), std::memory_order_release);
+}
+
+AudioSourceQueueStats AudioSource::InternalSource::queue_stats() const {
+	AudioSourceQueueStats stats;
+	if (!queue_) {
+		return stats;
+	}
+	stats.underrun_frames = underrun_frames_.load(std::memory_order_relaxed);
+	stats.overrun_frames = overrun_frames_.load(std::memory_order_relaxed);
+	stats.queued_samples = static_cast<uint32_t>(queue_->Size());
+	stats.capacity_samples = static_cast<uint32_t>(queue_->Capacity());
+	return stats;
 }
 
 webrtc::MediaSourceInterface::SourceState AudioSource::InternalSource::state() const {
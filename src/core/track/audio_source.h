@@ -22,6 +22,8 @@
 
 #include "livekit/core/track/audio_source_interface.h"
 
+#include "../detail/spsc_ring_buffer.h"
+
 #include "api/audio/audio_frame.h"
 #include "api/audio_options.h"
 #include "api/task_queue/task_queue_base.h"
@@ -29,6 +31,10 @@
 #include "pc/local_audio_source.h"
 #include "rtc_base/task_utils/repeating_task.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 namespace livekit {
 namespace core {
 
@@ -51,20 +57,35 @@ public:
 
 		void set_options(const webrtc::AudioOptions& options);
 
+		// Safe from several threads. Concurrent producers take turns on the single-producer queue,
+		// and capture_frame() never blocks on the 10 ms delivery task.
 		bool capture_frame(void* audio_data, uint32_t sample_rate, uint32_t number_of_channels,
 		                   size_t number_of_frames);
 
+		// Asynchronous: the samples queued so far are dropped by the delivery task on its next
+		// tick. Samples captured after the call are kept.
 		void clear_buffer();
 
+		AudioSourceQueueStats queue_stats() const;
+
 	private:
+		void DeliverQueuedFrame(std::size_t samples10ms);
+
 		mutable webrtc::Mutex mutex_;
 		std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter> audio_queue_;
 		webrtc::RepeatingTaskHandle audio_task_;
 
 		std::vector<webrtc::AudioTrackSinkInterface*> sinks_ RTC_GUARDED_BY(mutex_);
-		std::vector<int16_t> buffer_ RTC_GUARDED_BY(mutex_);
-
-		int missed_frames_ RTC_GUARDED_BY(mutex_) = 0;
+		// Serialises producers on the single-producer queue.
+		webrtc::Mutex producer_mutex_;
+		std::unique_ptr<SpscRingBuffer<int16_t>> queue_;
+		// Only touched by the delivery task.
+		std::vector<int16_t> frame_buffer_;
+		int missed_frames_ = 0;
+		// Queue write position at the last clear_buffer(); the delivery task drops samples before it.
+		std::atomic<uint64_t> clear_position_{0};
+		std::atomic<uint64_t> underrun_frames_{0};
+		std::atomic<uint64_t> overrun_frames_{0};
 		int16_t* silence_buffer_ = nullptr;
 
 		int sample_rate_;
@@ -26,7 +26,7 @@ std::unique_ptr<capture::CameraCaptureAdapter>
 CameraVideoSource::CreateAdapter(const std::string& device_id) {
 	return std::make_unique<capture::CameraCaptureAdapter>(
 	    device_id, options_.width, options_.height, options_.frames_per_second,
-	    [this](const capture::CapturedVideoFrame& frame) { OnFrame(frame); });
+	    [this](const webrtc::VideoFrame& frame) { OnFrame(frame); });
 }
 
 bool CameraVideoSource::Start() {
@@ -63,15 +63,7 @@ bool CameraVideoSource::SwitchDevice(const std::string& device_id) {
 	return true;
 }
 
-void CameraVideoSource::OnFrame(const capture::CapturedVideoFrame& frame) {
-	VideoFrame video_frame;
-	video_frame.data = frame.i420;
-	video_frame.width = frame.width;
-	video_frame.height = frame.height;
-	video_frame.timestamp_us = frame.timestamp_us;
-	video_frame.rotation = static_cast<VideoRotation>(frame.rotation_degrees);
-	VideoSource::CaptureFrame(video_frame);
-}
+void CameraVideoSource::OnFrame(const webrtc::VideoFrame& frame) { CaptureRtcFrame(frame); }
 
 CameraVideoSourceInterface* CreateCameraVideoSource(CameraCaptureOptions options) {
 	if (options.width == 0 || options.height == 0 || options.frames_per_second == 0 ||
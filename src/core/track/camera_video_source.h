@@ -39,7 +39,7 @@ public:
 
 private:
 	std::unique_ptr<capture::CameraCaptureAdapter> CreateAdapter(const std::string& device_id);
-	void OnFrame(const capture::CapturedVideoFrame& frame);
+	void OnFrame(const webrtc::VideoFrame& frame);
 
 	mutable std::mutex mutex_;
 	CameraCaptureOptions options_;
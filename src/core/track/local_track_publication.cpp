@@ -45,5 +45,22 @@ std::optional<SubscribedQualityUpdate> LocalTrackPublication::LastSubscribedQual
 	return subscribed_quality_update_;
 }
 
+void LocalTrackPublication::AttachDynacast(std::weak_ptr<DynacastController> dynacast) {
+	std::lock_guard<std::mutex> guard(subscribed_quality_mutex_);
+	dynacast_ = std::move(dynacast);
+	dynacast_track_sid_ = Sid();
+}
+
+std::vector<DynacastLayerStats> LocalTrackPublication::DynacastLayers() const {
+	std::shared_ptr<DynacastController> dynacast;
+	std::string track_sid;
+	{
+		std::lock_guard<std::mutex> guard(subscribed_quality_mutex_);
+		dynacast = dynacast_.lock();
+		track_sid = dynacast_track_sid_;
+	}
+	return dynacast ? dynacast->Layers(track_sid) : std::vector<DynacastLayerStats>{};
+}
+
 } // namespace core
 } // namespace livekit
@@ -20,6 +20,7 @@
 #ifndef _LKC_CORE_TRACK_LOCAL_TRACK_PUBLICATION_H_
 #define _LKC_CORE_TRACK_LOCAL_TRACK_PUBLICATION_H_
 
+#include "../detail/dynacast.h"
 #include "livekit/core/option/option.h"
 #include "livekit/core/track/local_track_publication_interface.h"
 #include "local_track.h"
@@ -39,12 +40,16 @@ public:
 	TrackPublishOptions PublishOptions() const;
 	void UpdateSubscribedQuality(SubscribedQualityUpdate update);
 	std::optional<SubscribedQualityUpdate> LastSubscribedQualityUpdate() const override;
+	void AttachDynacast(std::weak_ptr<DynacastController> dynacast);
+	std::vector<DynacastLayerStats> DynacastLayers() const override;
 
 private:
 	mutable std::mutex option_mutex_;
 	TrackPublishOptions option_;
 	mutable std::mutex subscribed_quality_mutex_;
 	std::optional<SubscribedQualityUpdate> subscribed_quality_update_;
+	std::weak_ptr<DynacastController> dynacast_;
+	std::string dynacast_track_sid_;
 };
 
 } // namespace core
@@ -38,7 +38,13 @@ MicrophoneAudioSource::MicrophoneAudioSource(MicrophoneCaptureOptions options)
       processor_(processing_options_.echo_cancellation, processing_options_.auto_gain_control,
                  processing_options_.noise_suppression) {}
 
-MicrophoneAudioSource::~MicrophoneAudioSource() { Stop(); }
+MicrophoneAudioSource::~MicrophoneAudioSource() {
+	Stop();
+	std::lock_guard<std::mutex> guard(audio_device_mutex_);
+	if (audio_device_ != nullptr && echo_reference_ != nullptr) {
+		audio_device_->DetachEchoReference(echo_reference_);
+	}
+}
 
 bool MicrophoneAudioSource::CaptureFrame(void* audio_data, uint32_t sample_rate,
                                          uint32_t num_channels, uint32_t samples_per_channel) {
@@ -53,8 +59,6 @@ void MicrophoneAudioSource::Stop() {
 	}
 	std::lock_guard<std::mutex> guard(capture_buffer_mutex_);
 	capture_buffer_.clear();
-	render_processing_buffer_.clear();
-	last_render_sequence_ = 0;
 }
 
 bool MicrophoneAudioSource::IsCapturing() const { return capture_ && capture_->IsRunning(); }
@@ -70,8 +74,6 @@ bool MicrophoneAudioSource::SwitchDevice(const std::string& device_id) {
 	const bool switched = capture_->SwitchDevice(device_id);
 	std::lock_guard<std::mutex> guard(capture_buffer_mutex_);
 	capture_buffer_.clear();
-	render_processing_buffer_.clear();
-	last_render_sequence_ = 0;
 	return switched;
 }
 
@@ -107,12 +109,18 @@ AudioSourceOptions MicrophoneAudioSource::ProcessingOptions() const {
 
 MicrophoneAudioProcessingStats MicrophoneAudioSource::ProcessingStats() const {
 	const auto options = ProcessingOptions();
+	bool echo_reference_attached = false;
+	{
+		std::lock_guard<std::mutex> guard(audio_device_mutex_);
+		echo_reference_attached = echo_reference_ != nullptr;
+	}
 	return {capture_frames_processed_.load(),
 	        render_frames_processed_.load(),
 	        capture_processing_errors_.load(),
 	        render_processing_errors_.load(),
 	        frames_dropped_.load(),
-	        options.echo_cancellation};
+	        options.echo_cancellation,
+	        options.echo_cancellation && echo_reference_attached};
 }
 
 bool MicrophoneAudioSource::BindAudioDevice(webrtc::scoped_refptr<AudioDevice> audio_device) {
@@ -120,9 +128,10 @@ bool MicrophoneAudioSource::BindAudioDevice(webrtc::scoped_refptr<AudioDevice> a
 		return false;
 	}
 	std::lock_guard<std::mutex> guard(audio_device_mutex_);
-	if (audio_device_ != nullptr && audio_device_ != audio_device) {
-		return false;
+	if (audio_device_ != nullptr) {
+		return audio_device_ == audio_device;
 	}
+	echo_reference_ = audio_device->AttachEchoReference();
 	audio_device_ = std::move(audio_device);
 	return true;
 }
@@ -143,20 +152,19 @@ void MicrophoneAudioSource::OnAudioFrame(const std::int16_t* samples, std::uint3
 			std::copy_n(capture_buffer_.begin(), processed.size(), processed.begin());
 			capture_buffer_.erase(capture_buffer_.begin(),
 			                      capture_buffer_.begin() + processed.size());
-			std::uint32_t render_sample_rate = 0;
-			std::uint32_t render_channels = 0;
 			std::uint16_t playout_delay_ms = 0;
 			webrtc::scoped_refptr<AudioDevice> audio_device;
+			std::shared_ptr<AudioDevice::EchoReference> echo_reference;
 			{
 				std::lock_guard<std::mutex> audio_device_guard(audio_device_mutex_);
 				audio_device = audio_device_;
+				echo_reference = echo_reference_;
 			}
-			if (processing_options.echo_cancellation && audio_device != nullptr &&
-			    audio_device->ReadRenderData(last_render_sequence_, render_processing_buffer_,
-			                                 render_sample_rate, render_channels)) {
+			if (processing_options.echo_cancellation && echo_reference != nullptr &&
+			    echo_reference->Read(render_frame_)) {
 				audio_device->PlayoutDelay(&playout_delay_ms);
-				if (processor_.ProcessRender(render_processing_buffer_, render_sample_rate,
-				                             render_channels)) {
+				if (processor_.ProcessRender(render_frame_, AudioDevice::kRenderSampleRate,
+				                             AudioDevice::kRenderChannels)) {
 					render_frames_processed_.fetch_add(1);
 				} else {
 					render_processing_errors_.fetch_add(1);
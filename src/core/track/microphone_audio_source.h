@@ -19,6 +19,7 @@
 #include "../../capture/webrtc_audio_processor.h"
 #include "../detail/audio_device.h"
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <memory>
@@ -59,10 +60,11 @@ private:
 	capture::WebRtcAudioProcessor processor_;
 	std::mutex capture_buffer_mutex_;
 	std::vector<std::int16_t> capture_buffer_;
-	std::vector<std::int16_t> render_processing_buffer_;
-	uint64_t last_render_sequence_ = 0;
+	std::array<std::int16_t, AudioDevice::kRenderFrameSamples> render_frame_{};
 	mutable std::mutex audio_device_mutex_;
 	webrtc::scoped_refptr<AudioDevice> audio_device_;
+	// Attached at bind and detached on destruction; read only on the capture thread.
+	std::shared_ptr<AudioDevice::EchoReference> echo_reference_;
 	std::atomic_bool muted_{false};
 	std::atomic<float> volume_{1.0F};
 	std::atomic<uint64_t> capture_frames_processed_{0};
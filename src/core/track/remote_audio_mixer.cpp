@@ -0,0 +1,148 @@
+/**
+ *
+ * Copyright (c) 2024 sunze
+ *
+ *Licensed under the Apache License, Version 2.0 (the "License");
+ *you may not use this file except in compliance with the License.
+ *You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing, software
+ *distributed under the License is distributed on an "AS IS" BASIS,
+ *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *See the License for the specific language governing permissions and
+ *limitations under the License.
+ */
+
+#include "remote_audio_mixer.h"
+
+#include <cmath>
+
+namespace livekit {
+namespace core {
+namespace {
+
+class MixBusSink final : public AudioSinkWrapper {
+public:
+	MixBusSink(std::shared_ptr<AudioMixBus::Input> input, int sample_rate, size_t num_channels)
+	    : input_(std::move(input)), sample_rate_(sample_rate), num_channels_(num_channels) {}
+
+	void on_data(const void* audio_data, int bits_per_sample, int sample_rate,
+	             size_t number_of_channels, size_t number_of_frames) override {
+		// AudioSink has already remixed and resampled to the bus layout.
+		if (bits_per_sample != 16 || sample_rate != sample_rate_ ||
+		    number_of_channels != num_channels_) {
+			return;
+		}
+		input_->Write(static_cast<const int16_t*>(audio_data), number_of_frames);
+	}
+
+private:
+	std::shared_ptr<AudioMixBus::Input> input_;
+	const int sample_rate_;
+	const size_t num_channels_;
+};
+
+} // namespace
+
+RemoteAudioMixer::RemoteAudioMixer(AudioMixerOptions options, TrackResolver resolver)
+    : options_(options), bus_(options.sample_rate, options.num_channels, options.max_buffered_ms),
+      resolver_(std::move(resolver)) {}
+
+RemoteAudioMixer::~RemoteAudioMixer() {
+	std::lock_guard<std::mutex> guard(mutex_);
+	for (const auto& [sid, attachment] : attachments_) {
+		DetachSink(attachment);
+	}
+}
+
+bool RemoteAudioMixer::IsValidOptions(const AudioMixerOptions& options) {
+	return AudioMixBus::IsValidLayout(options.sample_rate, options.num_channels) &&
+	       options.max_buffered_ms > 0;
+}
+
+bool RemoteAudioMixer::AddTrack(const std::string& track_sid) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (!resolver_ || attachments_.count(track_sid) != 0) {
+		return false;
+	}
+	auto resolved = resolver_(track_sid);
+	if (!resolved.track) {
+		return false;
+	}
+	return AttachTrackLocked(resolved.participant_sid, std::move(resolved.track));
+}
+
+bool RemoteAudioMixer::RemoveTrack(const std::string& track_sid) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto it = attachments_.find(track_sid);
+	if (it == attachments_.end()) {
+		return false;
+	}
+	DetachSink(it->second);
+	attachments_.erase(it);
+	bus_.RemoveInput(track_sid);
+	return true;
+}
+
+bool RemoteAudioMixer::SetParticipantGain(const std::string& participant_sid, float gain) {
+	if (!std::isfinite(gain) || gain < 0.0F) {
+		return false;
+	}
+	bus_.SetGroupGain(participant_sid, gain);
+	return true;
+}
+
+bool RemoteAudioMixer::SetTrackTap(const std::string& track_sid, AudioMixerTap tap) {
+	return bus_.SetTap(track_sid, std::move(tap));
+}
+
+bool RemoteAudioMixer::Pull(AudioFrame& frame) { return bus_.Pull(frame); }
+
+AudioMixerStats RemoteAudioMixer::Stats() const { return bus_.Stats(); }
+
+bool RemoteAudioMixer::AttachTrack(const std::string& participant_sid,
+                                   std::shared_ptr<RemoteAudioTrack> track) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (!resolver_ || !track || attachments_.count(track->Sid()) != 0) {
+		return false;
+	}
+	return AttachTrackLocked(participant_sid, std::move(track));
+}
+
+void RemoteAudioMixer::DetachRoom() {
+	std::map<std::string, Attachment> detached;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		resolver_ = nullptr;
+		detached.swap(attachments_);
+	}
+	for (const auto& [sid, attachment] : detached) {
+		DetachSink(attachment);
+		bus_.RemoveInput(sid);
+	}
+}
+
+bool RemoteAudioMixer::AttachTrackLocked(const std::string& participant_sid,
+                                         std::shared_ptr<RemoteAudioTrack> track) {
+	const std::string track_sid = track->Sid();
+	auto input = bus_.AddInput(track_sid, participant_sid);
+	if (!input) {
+		return false;
+	}
+	auto sink = std::make_shared<AudioSink>(
+	    std::make_unique<MixBusSink>(std::move(input), static_cast<int>(options_.sample_rate),
+	                                 options_.num_channels),
+	    static_cast<int>(options_.sample_rate), static_cast<int>(options_.num_channels));
+	static_cast<AudioTrack*>(track->media_track())->add_sink(sink);
+	attachments_.emplace(track_sid, Attachment{std::move(track), std::move(sink)});
+	return true;
+}
+
+void RemoteAudioMixer::DetachSink(const Attachment& attachment) {
+	static_cast<AudioTrack*>(attachment.track->media_track())->remove_sink(attachment.sink);
+}
+
+} // namespace core
+} // namespace livekit
@@ -0,0 +1,88 @@
+/**
+ *
+ * Copyright (c) 2024 sunze
+ *
+ *Licensed under the Apache License, Version 2.0 (the "License");
+ *you may not use this file except in compliance with the License.
+ *You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing, software
+ *distributed under the License is distributed on an "AS IS" BASIS,
+ *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *See the License for the specific language governing permissions and
+ *limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_TRACK_REMOTE_AUDIO_MIXER_H_
+#define _LKC_CORE_TRACK_REMOTE_AUDIO_MIXER_H_
+
+#include "livekit/core/track/audio_mixer_interface.h"
+
+#include "../detail/audio_mix_bus.h"
+#include "audio_track.h"
+#include "remote_audio_track.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace livekit {
+namespace core {
+
+// Attaches one sink per remote audio track that resamples straight to the mixer layout and feeds an
+// AudioMixBus input, so tracks are resampled once and never copied into per-frame vectors.
+class RemoteAudioMixer final : public AudioMixerInterface {
+public:
+	struct ResolvedTrack {
+		std::string participant_sid;
+		std::shared_ptr<RemoteAudioTrack> track;
+	};
+	// Looks up a subscribed remote audio track by SID. Supplied by the owning room.
+	using TrackResolver = std::function<ResolvedTrack(const std::string& track_sid)>;
+
+	RemoteAudioMixer(AudioMixerOptions options, TrackResolver resolver);
+	~RemoteAudioMixer() override;
+
+	static bool IsValidOptions(const AudioMixerOptions& options);
+
+	AudioMixerOptions Options() const override { return options_; }
+	bool AddTrack(const std::string& track_sid) override;
+	bool RemoveTrack(const std::string& track_sid) override;
+	bool SetParticipantGain(const std::string& participant_sid, float gain) override;
+	bool SetTrackTap(const std::string& track_sid, AudioMixerTap tap) override;
+	bool Pull(AudioFrame& frame) override;
+	AudioMixerStats Stats() const override;
+
+	// Called by the room for tracks it already resolved.
+	bool AttachTrack(const std::string& participant_sid, std::shared_ptr<RemoteAudioTrack> track);
+	// Called when the room is destroyed: removes every sink and drops the tracks, and the mixer
+	// takes no tracks afterwards.
+	void DetachRoom();
+
+private:
+	struct Attachment {
+		std::shared_ptr<RemoteAudioTrack> track;
+		std::shared_ptr<AudioSink> sink;
+	};
+
+	bool AttachTrackLocked(const std::string& participant_sid,
+	                       std::shared_ptr<RemoteAudioTrack> track);
+	static void DetachSink(const Attachment& attachment);
+
+	const AudioMixerOptions options_;
+	AudioMixBus bus_;
+
+	std::mutex mutex_;
+	TrackResolver resolver_;
+	std::map<std::string, Attachment> attachments_;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_TRACK_REMOTE_AUDIO_MIXER_H_
@@ -46,10 +46,21 @@ private:
 } // namespace
 
 RemoteAudioTrack::RemoteAudioTrack(std::string sid, std::string name,
-                                   std::unique_ptr<AudioTrack> audio_track, FrameCallback callback)
-    : RemoteTrack(std::move(sid), std::move(name), TrackKind::Audio, std::move(audio_track)) {
+                                   std::unique_ptr<AudioTrack> audio_track, FrameCallback callback,
+                                   webrtc::scoped_refptr<AudioDevice> audio_device)
+    : RemoteTrack(std::move(sid), std::move(name), TrackKind::Audio, std::move(audio_track)),
+      audio_device_(std::move(audio_device)) {
 	sink_ = std::make_shared<AudioSink>(std::make_unique<FrameSink>(std::move(callback)), 48000, 1);
 	static_cast<AudioTrack*>(media_track())->add_sink(sink_);
+	if (audio_device_ != nullptr) {
+		audio_device_->AddRenderConsumer();
+	}
+}
+
+RemoteAudioTrack::~RemoteAudioTrack() {
+	if (audio_device_ != nullptr) {
+		audio_device_->RemoveRenderConsumer();
+	}
 }
 
 } // namespace core
@@ -20,6 +20,7 @@
 #ifndef _LKC_CORE_TRACK_REMOTE_AUDIO_TRACK_H_
 #define _LKC_CORE_TRACK_REMOTE_AUDIO_TRACK_H_
 
+#include "../detail/audio_device.h"
 #include "audio_track.h"
 #include "remote_track.h"
 
@@ -34,12 +35,15 @@ class RemoteAudioTrack : public RemoteTrack {
 public:
 	using FrameCallback = std::function<void(const AudioFrame&)>;
 
+	// The track counts as a render consumer of audio_device, when given, for its lifetime.
 	RemoteAudioTrack(std::string sid, std::string name, std::unique_ptr<AudioTrack> audio_track,
-	                 FrameCallback callback);
-	~RemoteAudioTrack() override = default;
+	                 FrameCallback callback,
+	                 webrtc::scoped_refptr<AudioDevice> audio_device = nullptr);
+	~RemoteAudioTrack() override;
 
 private:
 	std::shared_ptr<AudioSink> sink_;
+	webrtc::scoped_refptr<AudioDevice> audio_device_;
 };
 
 } // namespace core
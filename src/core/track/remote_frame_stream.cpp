@@ -0,0 +1,130 @@
+/**
+ *
+ * Copyright (c) 2024 sunze
+ *
+ *Licensed under the Apache License, Version 2.0 (the "License");
+ *you may not use this file except in compliance with the License.
+ *You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing, software
+ *distributed under the License is distributed on an "AS IS" BASIS,
+ *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *See the License for the specific language governing permissions and
+ *limitations under the License.
+ */
+
+#include "remote_frame_stream.h"
+
+namespace livekit {
+namespace core {
+namespace {
+
+class QueueSink final : public AudioSinkWrapper {
+public:
+	QueueSink(std::shared_ptr<RemoteAudioStream::Queue> queue, int sample_rate, size_t num_channels)
+	    : queue_(std::move(queue)), sample_rate_(sample_rate), num_channels_(num_channels) {}
+
+	void on_data(const void* audio_data, int bits_per_sample, int sample_rate,
+	             size_t number_of_channels, size_t number_of_frames) override {
+		// AudioSink has already remixed and resampled to the stream layout.
+		if (bits_per_sample != 16 || audio_data == nullptr || sample_rate != sample_rate_ ||
+		    number_of_channels != num_channels_) {
+			return;
+		}
+		const auto* samples = static_cast<const int16_t*>(audio_data);
+		queue_->Push([&](AudioFrame& frame) {
+			// Slots are reserved for 10 ms frames, so this copy does not allocate.
+			frame.data.assign(samples, samples + number_of_channels * number_of_frames);
+			frame.sample_rate = static_cast<uint32_t>(sample_rate);
+			frame.num_channels = static_cast<uint32_t>(number_of_channels);
+			frame.samples_per_channel = static_cast<uint32_t>(number_of_frames);
+		});
+	}
+
+private:
+	std::shared_ptr<RemoteAudioStream::Queue> queue_;
+	const int sample_rate_;
+	const size_t num_channels_;
+};
+
+} // namespace
+
+RemoteAudioStream::RemoteAudioStream(std::shared_ptr<RemoteAudioTrack> track,
+                                     const AudioStreamOptions& options)
+    : track_sid_(track->Sid()),
+      queue_(std::make_shared<Queue>(options.capacity_frames, options.overflow,
+                                     std::chrono::milliseconds(options.block_timeout_ms))),
+      track_(std::move(track)) {
+	const std::size_t frame_samples =
+	    static_cast<std::size_t>(options.sample_rate / 100) * options.num_channels;
+	queue_->PrepareSlots([frame_samples](AudioFrame& frame) { frame.data.reserve(frame_samples); });
+	sink_ = std::make_shared<AudioSink>(
+	    std::make_unique<QueueSink>(queue_, static_cast<int>(options.sample_rate),
+	                                options.num_channels),
+	    static_cast<int>(options.sample_rate), static_cast<int>(options.num_channels));
+	static_cast<AudioTrack*>(track_->media_track())->add_sink(sink_);
+}
+
+RemoteAudioStream::~RemoteAudioStream() { Close(); }
+
+bool RemoteAudioStream::IsValidOptions(const AudioStreamOptions& options) {
+	return options.sample_rate >= 8000 && options.sample_rate <= 192000 &&
+	       options.sample_rate % 100 == 0 &&
+	       (options.num_channels == 1 || options.num_channels == 2) && options.capacity_frames > 0;
+}
+
+bool RemoteAudioStream::Read(AudioFrame& frame, std::chrono::milliseconds timeout) {
+	return queue_->Read(frame, timeout);
+}
+
+void RemoteAudioStream::Close() {
+	queue_->Close();
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (track_) {
+		static_cast<AudioTrack*>(track_->media_track())->remove_sink(sink_);
+		track_.reset();
+		sink_.reset();
+	}
+}
+
+RemoteVideoStream::RemoteVideoStream(std::shared_ptr<RemoteVideoTrack> track,
+                                     const VideoStreamOptions& options)
+    : track_sid_(track->Sid()),
+      queue_(options.capacity_frames, options.overflow,
+             std::chrono::milliseconds(options.block_timeout_ms)),
+      track_(std::move(track)) {
+	static_cast<VideoTrack*>(track_->media_track())->AddSink(this);
+}
+
+RemoteVideoStream::~RemoteVideoStream() { Close(); }
+
+bool RemoteVideoStream::IsValidOptions(const VideoStreamOptions& options) {
+	return options.capacity_frames > 0;
+}
+
+bool RemoteVideoStream::Read(VideoFrameBuffer& frame, std::chrono::milliseconds timeout) {
+	return queue_.Read(frame, timeout);
+}
+
+void RemoteVideoStream::Close() {
+	queue_.Close();
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (track_) {
+		// Returns once any OnFrame() in flight has finished, so the queue outlives every callback.
+		static_cast<VideoTrack*>(track_->media_track())->RemoveSink(this);
+		track_.reset();
+	}
+}
+
+void RemoteVideoStream::OnFrame(const webrtc::VideoFrame& rtc_frame) {
+	VideoFrameBuffer wrapped;
+	if (!WrapVideoFrameBuffer(rtc_frame, wrapped)) {
+		return;
+	}
+	queue_.Push([&](VideoFrameBuffer& frame) { frame = std::move(wrapped); });
+}
+
+} // namespace core
+} // namespace livekit
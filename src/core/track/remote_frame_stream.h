@@ -0,0 +1,108 @@
+/**
+ *
+ * Copyright (c) 2024 sunze
+ *
+ *Licensed under the Apache License, Version 2.0 (the "License");
+ *you may not use this file except in compliance with the License.
+ *You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing, software
+ *distributed under the License is distributed on an "AS IS" BASIS,
+ *WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *See the License for the specific language governing permissions and
+ *limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _LKC_CORE_TRACK_REMOTE_FRAME_STREAM_H_
+#define _LKC_CORE_TRACK_REMOTE_FRAME_STREAM_H_
+
+#include "livekit/core/track/audio_stream_interface.h"
+#include "livekit/core/track/video_stream_interface.h"
+
+#include "../detail/frame_stream_queue.h"
+#include "audio_track.h"
+#include "remote_audio_track.h"
+#include "remote_video_track.h"
+
+#include <memory>
+#include <mutex>
+
+namespace livekit {
+namespace core {
+
+// What the room needs to close a stream when its track goes away.
+class RemoteFrameStream {
+public:
+	virtual ~RemoteFrameStream() = default;
+
+	virtual std::string TrackSid() const = 0;
+	virtual void Close() = 0;
+};
+
+class RemoteAudioStream final : public AudioStreamInterface, public RemoteFrameStream {
+public:
+	using Queue = FrameStreamQueue<AudioFrame>;
+
+	RemoteAudioStream(std::shared_ptr<RemoteAudioTrack> track, const AudioStreamOptions& options);
+	~RemoteAudioStream() override;
+
+	static bool IsValidOptions(const AudioStreamOptions& options);
+
+	std::string TrackSid() const override { return track_sid_; }
+	bool Read(AudioFrame& frame, std::chrono::milliseconds timeout) override;
+	int EventFd() const override { return queue_->Fd(); }
+	void* EventHandle() const override { return queue_->Handle(); }
+	void Close() override;
+	bool IsClosed() const override { return queue_->IsClosed(); }
+	FrameStreamStats Stats() const override { return queue_->Stats(); }
+
+private:
+	const std::string track_sid_;
+	// Shared with the sink so a callback racing Close() still has a queue to reject it.
+	std::shared_ptr<Queue> queue_;
+
+	std::mutex mutex_;
+	std::shared_ptr<RemoteAudioTrack> track_;
+	std::shared_ptr<AudioSink> sink_;
+};
+
+class RemoteVideoStream final : public VideoStreamInterface,
+                                public RemoteFrameStream,
+                                private webrtc::VideoSinkInterface<webrtc::VideoFrame> {
+public:
+	RemoteVideoStream(std::shared_ptr<RemoteVideoTrack> track, const VideoStreamOptions& options);
+	~RemoteVideoStream() override;
+
+	static bool IsValidOptions(const VideoStreamOptions& options);
+
+	std::string TrackSid() const override { return track_sid_; }
+	bool Read(VideoFrameBuffer& frame, std::chrono::milliseconds timeout) override;
+	int EventFd() const override { return queue_.Fd(); }
+	void* EventHandle() const override { return queue_.Handle(); }
+	void Close() override;
+	bool IsClosed() const override { return queue_.IsClosed(); }
+	FrameStreamStats Stats() const override { return queue_.Stats(); }
+
+private:
+	// Drops the decoder buffer reference as soon as a slot is read or discarded.
+	struct ReleaseBuffer {
+		void operator()(VideoFrameBuffer& frame) const noexcept { frame.buffer.reset(); }
+	};
+
+	void OnFrame(const webrtc::VideoFrame& frame) override;
+
+	const std::string track_sid_;
+	FrameStreamQueue<VideoFrameBuffer, ReleaseBuffer> queue_;
+
+	std::mutex mutex_;
+	std::shared_ptr<RemoteVideoTrack> track_;
+};
+
+} // namespace core
+} // namespace livekit
+
+#endif // _LKC_CORE_TRACK_REMOTE_FRAME_STREAM_H_
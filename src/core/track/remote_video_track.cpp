@@ -24,6 +24,40 @@
 namespace livekit {
 namespace core {
 
+namespace {
+
+// Holds a reference on the decoder's buffer so applications may keep the planes past OnFrame.
+class RtcI420Buffer final : public I420BufferInterface {
+public:
+	explicit RtcI420Buffer(webrtc::scoped_refptr<webrtc::I420BufferInterface> buffer)
+	    : buffer_(std::move(buffer)) {}
+
+	uint32_t Width() const override { return static_cast<uint32_t>(buffer_->width()); }
+	uint32_t Height() const override { return static_cast<uint32_t>(buffer_->height()); }
+	const uint8_t* DataY() const override { return buffer_->DataY(); }
+	const uint8_t* DataU() const override { return buffer_->DataU(); }
+	const uint8_t* DataV() const override { return buffer_->DataV(); }
+	int StrideY() const override { return buffer_->StrideY(); }
+	int StrideU() const override { return buffer_->StrideU(); }
+	int StrideV() const override { return buffer_->StrideV(); }
+
+private:
+	webrtc::scoped_refptr<webrtc::I420BufferInterface> buffer_;
+};
+
+} // namespace
+
+bool WrapVideoFrameBuffer(const webrtc::VideoFrame& rtc_frame, VideoFrameBuffer& frame) {
+	auto buffer = rtc_frame.video_frame_buffer()->ToI420();
+	if (!buffer) {
+		return false;
+	}
+	frame.buffer = std::make_shared<RtcI420Buffer>(std::move(buffer));
+	frame.timestamp_us = rtc_frame.timestamp_us();
+	frame.rotation = static_cast<VideoRotation>(rtc_frame.rotation());
+	return true;
+}
+
 RemoteVideoTrack::RemoteVideoTrack(std::string sid, std::string name,
                                    std::unique_ptr<VideoTrack> video_track, FrameCallback callback)
     : RemoteTrack(std::move(sid), std::move(name), TrackKind::Video, std::move(video_track)),
@@ -31,9 +65,29 @@ RemoteVideoTrack::RemoteVideoTrack(std::string sid, std::string name,
 	static_cast<VideoTrack*>(media_track())->AddSink(this);
 }
 
+RemoteVideoTrack::RemoteVideoTrack(std::string sid, std::string name,
+                                   std::unique_ptr<VideoTrack> video_track,
+                                   BufferCallback callback)
+    : RemoteTrack(std::move(sid), std::move(name), TrackKind::Video, std::move(video_track)),
+      buffer_callback_(std::move(callback)) {
+	static_cast<VideoTrack*>(media_track())->AddSink(this);
+}
+
 RemoteVideoTrack::~RemoteVideoTrack() { static_cast<VideoTrack*>(media_track())->RemoveSink(this); }
 
 void RemoteVideoTrack::OnFrame(const webrtc::VideoFrame& rtc_frame) {
+	// ToI420() returns the decoder's own buffer when it is already I420, so buffer delivery is
+	// copy-free for software decoders and converts once for native or NV12 buffers.
+	if (buffer_callback_) {
+		VideoFrameBuffer frame;
+		if (WrapVideoFrameBuffer(rtc_frame, frame)) {
+			buffer_callback_(frame);
+		}
+		return;
+	}
+	if (!callback_) {
+		return;
+	}
 	auto buffer = rtc_frame.video_frame_buffer()->ToI420();
 	if (!buffer) {
 		return;
@@ -30,19 +30,28 @@
 namespace livekit {
 namespace core {
 
+// Wraps the frame's I420 planes, converting once when the decoder produced another format. Returns
+// false when the buffer cannot be converted.
+bool WrapVideoFrameBuffer(const webrtc::VideoFrame& rtc_frame, VideoFrameBuffer& frame);
+
 class RemoteVideoTrack : public RemoteTrack,
                          private webrtc::VideoSinkInterface<webrtc::VideoFrame> {
 public:
 	using FrameCallback = std::function<void(const VideoFrame&)>;
+	using BufferCallback = std::function<void(const VideoFrameBuffer&)>;
 
 	RemoteVideoTrack(std::string sid, std::string name, std::unique_ptr<VideoTrack> video_track,
 	                 FrameCallback callback);
+	// Buffer delivery wraps the decoded I420 planes without copying them into a packed frame.
+	RemoteVideoTrack(std::string sid, std::string name, std::unique_ptr<VideoTrack> video_track,
+	                 BufferCallback callback);
 	~RemoteVideoTrack() override;
 
 private:
 	void OnFrame(const webrtc::VideoFrame& frame) override;
 
 	FrameCallback callback_;
+	BufferCallback buffer_callback_;
 };
 
 } // namespace core
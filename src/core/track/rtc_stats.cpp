@@ -184,6 +184,7 @@ RTCStatsSnapshot ParseRTCStatsReport(std::string_view report_json) noexcept {
 			stats.pli_count = UnsignedValue(object, "pliCount");
 			stats.nack_count = UnsignedValue(object, "nackCount");
 			stats.qp_sum = UnsignedValue(object, "qpSum");
+			stats.total_encode_time_seconds = DoubleValue(object, "totalEncodeTime").value_or(0.0);
 			stats.quality_limitation_reason = StringValue(object, "qualityLimitationReason");
 			stats.codec_implementation = StringValue(
 			    object, stats.direction == RTCStatsDirection::Send ? "encoderImplementation"
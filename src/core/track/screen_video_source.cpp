@@ -27,7 +27,7 @@ std::unique_ptr<capture::ScreenCaptureAdapter>
 ScreenVideoSource::CreateAdapter(const std::string& source_id) {
 	return std::make_unique<capture::ScreenCaptureAdapter>(
 	    source_id, options_.frames_per_second, options_.include_cursor,
-	    [this](const capture::CapturedVideoFrame& frame) { OnFrame(frame); });
+	    [this](const webrtc::VideoFrame& frame) { OnFrame(frame); });
 }
 
 bool ScreenVideoSource::Start() {
@@ -72,15 +72,7 @@ bool ScreenVideoSource::SwitchSource(const std::string& source_id) {
 	return true;
 }
 
-void ScreenVideoSource::OnFrame(const capture::CapturedVideoFrame& frame) {
-	VideoFrame video_frame;
-	video_frame.data = frame.i420;
-	video_frame.width = frame.width;
-	video_frame.height = frame.height;
-	video_frame.timestamp_us = frame.timestamp_us;
-	video_frame.rotation = static_cast<VideoRotation>(frame.rotation_degrees);
-	VideoSource::CaptureFrame(video_frame);
-}
+void ScreenVideoSource::OnFrame(const webrtc::VideoFrame& frame) { CaptureRtcFrame(frame); }
 
 std::vector<ScreenCaptureSourceInfo> EnumerateScreenCaptureSources() {
 	std::vector<ScreenCaptureSourceInfo> result;
@@ -30,7 +30,7 @@ public:
 
 private:
 	std::unique_ptr<capture::ScreenCaptureAdapter> CreateAdapter(const std::string& source_id);
-	void OnFrame(const capture::CapturedVideoFrame& frame);
+	void OnFrame(const webrtc::VideoFrame& frame);
 
 	mutable std::mutex mutex_;
 	ScreenCaptureOptions options_;
@@ -0,0 +1,162 @@
+#include "audio_dsp.h"
+#include "audio_gain.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace livekit::capture {
+namespace {
+
+// 10 ms of 48 kHz stereo, the unit WebRTC and the capture pipeline exchange.
+constexpr std::size_t kFrameSamples = 960;
+
+std::vector<std::int16_t> MakeSamples(std::uint32_t seed) {
+	std::vector<std::int16_t> samples(kFrameSamples);
+	for (auto& sample : samples) {
+		seed = seed * 1664525U + 1013904223U;
+		sample = static_cast<std::int16_t>(seed >> 16);
+	}
+	return samples;
+}
+
+// range(0) selects the ISA; unavailable ones are skipped so the suite runs on any CPU.
+const AudioDspKernels* KernelsOrSkip(benchmark::State& state) {
+	const auto* kernels = AudioDspKernelsFor(static_cast<AudioDspIsa>(state.range(0)));
+	if (kernels == nullptr) {
+		state.SkipWithError("instruction set not available");
+	}
+	return kernels;
+}
+
+void SetSampleCounters(benchmark::State& state, std::size_t samples) {
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+	                        static_cast<std::int64_t>(samples));
+}
+
+void BM_AudioScale(benchmark::State& state) {
+	const auto* kernels = KernelsOrSkip(state);
+	if (kernels == nullptr) {
+		return;
+	}
+	const auto input = MakeSamples(1);
+	std::vector<std::int16_t> output(kFrameSamples);
+	for (auto _ : state) {
+		kernels->scale(input.data(), output.data(), kFrameSamples, 0.7F);
+		benchmark::DoNotOptimize(output.data());
+	}
+	SetSampleCounters(state, kFrameSamples);
+}
+
+void BM_AudioMix(benchmark::State& state) {
+	const auto* kernels = KernelsOrSkip(state);
+	if (kernels == nullptr) {
+		return;
+	}
+	const auto streams = static_cast<std::size_t>(state.range(1));
+	std::vector<std::vector<std::int16_t>> inputs;
+	std::vector<const std::int16_t*> pointers;
+	for (std::size_t stream = 0; stream < streams; ++stream) {
+		inputs.push_back(MakeSamples(static_cast<std::uint32_t>(stream + 1)));
+		pointers.push_back(inputs.back().data());
+	}
+	std::vector<std::int16_t> output(kFrameSamples);
+	for (auto _ : state) {
+		kernels->mix(pointers.data(), pointers.size(), output.data(), kFrameSamples);
+		benchmark::DoNotOptimize(output.data());
+	}
+	SetSampleCounters(state, kFrameSamples * streams);
+}
+
+void BM_AudioFloatRoundTrip(benchmark::State& state) {
+	const auto* kernels = KernelsOrSkip(state);
+	if (kernels == nullptr) {
+		return;
+	}
+	const auto input = MakeSamples(1);
+	std::vector<float> floats(kFrameSamples);
+	std::vector<std::int16_t> output(kFrameSamples);
+	for (auto _ : state) {
+		kernels->to_float(input.data(), floats.data(), kFrameSamples);
+		kernels->from_float(floats.data(), output.data(), kFrameSamples);
+		benchmark::DoNotOptimize(output.data());
+	}
+	SetSampleCounters(state, kFrameSamples);
+}
+
+void BM_AudioStereoInterleave(benchmark::State& state) {
+	const auto* kernels = KernelsOrSkip(state);
+	if (kernels == nullptr) {
+		return;
+	}
+	const auto interleaved = MakeSamples(1);
+	std::vector<std::int16_t> left(kFrameSamples / 2);
+	std::vector<std::int16_t> right(kFrameSamples / 2);
+	const std::array<std::int16_t*, 2> planes{left.data(), right.data()};
+	const std::array<const std::int16_t*, 2> const_planes{left.data(), right.data()};
+	std::vector<std::int16_t> output(kFrameSamples);
+	for (auto _ : state) {
+		kernels->deinterleave(interleaved.data(), 2, kFrameSamples / 2, planes.data());
+		kernels->interleave(const_planes.data(), 2, kFrameSamples / 2, output.data());
+		benchmark::DoNotOptimize(output.data());
+	}
+	SetSampleCounters(state, kFrameSamples);
+}
+
+void BM_AudioLevel(benchmark::State& state) {
+	const auto* kernels = KernelsOrSkip(state);
+	if (kernels == nullptr) {
+		return;
+	}
+	const auto input = MakeSamples(1);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(kernels->level(input.data(), kFrameSamples));
+	}
+	SetSampleCounters(state, kFrameSamples);
+}
+
+// The public entry point used by AudioSource, including validation and kernel dispatch.
+void BM_ApplyAudioGain(benchmark::State& state) {
+	const auto input = MakeSamples(1);
+	std::vector<std::int16_t> output(kFrameSamples);
+	const auto gain = static_cast<float>(state.range(0)) / 100.0F;
+	for (auto _ : state) {
+		if (!ApplyAudioGain(input, output, gain)) {
+			state.SkipWithError("gain rejected");
+			return;
+		}
+		benchmark::DoNotOptimize(output.data());
+	}
+	SetSampleCounters(state, kFrameSamples);
+}
+
+void AudioDspIsas(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgName("isa");
+	for (const auto isa : {AudioDspIsa::Scalar, AudioDspIsa::Sse2, AudioDspIsa::Avx2,
+	                       AudioDspIsa::Neon}) {
+		benchmark->Arg(static_cast<std::int64_t>(isa));
+	}
+}
+
+void AudioMixIsas(benchmark::internal::Benchmark* benchmark) {
+	benchmark->ArgNames({"isa", "streams"});
+	for (const auto isa : {AudioDspIsa::Scalar, AudioDspIsa::Sse2, AudioDspIsa::Avx2,
+	                       AudioDspIsa::Neon}) {
+		for (const std::int64_t streams : {2, 8}) {
+			benchmark->Args({static_cast<std::int64_t>(isa), streams});
+		}
+	}
+}
+
+BENCHMARK(BM_AudioScale)->Apply(AudioDspIsas);
+BENCHMARK(BM_AudioMix)->Apply(AudioMixIsas);
+BENCHMARK(BM_AudioFloatRoundTrip)->Apply(AudioDspIsas);
+BENCHMARK(BM_AudioStereoInterleave)->Apply(AudioDspIsas);
+BENCHMARK(BM_AudioLevel)->Apply(AudioDspIsas);
+// Unity gain takes the copy path; an attenuating gain runs the scale kernel.
+BENCHMARK(BM_ApplyAudioGain)->ArgName("gain_percent")->Arg(100)->Arg(70);
+
+} // namespace
+} // namespace livekit::capture
@@ -0,0 +1,104 @@
+#include "data_packet_serializer.h"
+
+#include "api/data_channel_interface.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+livekit::DataPacket MakeUserPacket(std::size_t payload_size) {
+	livekit::DataPacket packet;
+	packet.set_kind(livekit::DataPacket_Kind_LOSSY);
+	packet.set_participant_identity("telemetry-publisher");
+	packet.add_destination_identities("dashboard");
+	auto* user = packet.mutable_user();
+	user->set_topic("telemetry");
+	user->set_payload(std::string(payload_size, '\x5a'));
+	return packet;
+}
+
+// copies counts full passes over the packet bytes: clones, serialisations and buffer copies.
+void SetPacketCounters(benchmark::State& state, std::size_t packet_bytes, int copies) {
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+	                        static_cast<std::int64_t>(packet_bytes));
+	state.counters["bytes_copied"] = static_cast<double>(packet_bytes) * copies;
+	state.counters["packets_per_second"] =
+	    benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// The previous send path: a clone of the caller's packet, a std::string serialisation and the
+// CopyOnWriteBuffer copy handed to the data channel.
+void BM_DataPacketSendCopying(benchmark::State& state) {
+	const auto packet = MakeUserPacket(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		livekit::DataPacket outbound(packet);
+		std::string serialized;
+		outbound.SerializeToString(&serialized);
+		webrtc::DataBuffer buffer(webrtc::CopyOnWriteBuffer(serialized.data(), serialized.size()),
+		                          true);
+		benchmark::DoNotOptimize(buffer.data.data());
+	}
+	SetPacketCounters(state, packet.ByteSizeLong(), 3);
+}
+
+// Serialisation straight into the channel's reused buffer.
+void BM_DataPacketSendPooled(benchmark::State& state) {
+	const auto packet = MakeUserPacket(static_cast<std::size_t>(state.range(0)));
+	webrtc::CopyOnWriteBuffer pooled;
+	for (auto _ : state) {
+		if (!SerializeToBuffer(packet, pooled)) {
+			state.SkipWithError("serialisation failed");
+			return;
+		}
+		webrtc::DataBuffer buffer(pooled, true);
+		benchmark::DoNotOptimize(buffer.data.data());
+	}
+	SetPacketCounters(state, packet.ByteSizeLong(), 1);
+}
+
+// The previous E2EE plaintext: the payload copied into an EncryptedPacketPayload, serialised to a
+// std::string and copied into the vector given to the cryptor. Encryption itself is not measured.
+void BM_DataPacketPlaintextCopying(benchmark::State& state) {
+	const auto packet = MakeUserPacket(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		livekit::EncryptedPacketPayload payload;
+		payload.mutable_user()->CopyFrom(packet.user());
+		std::string serialized;
+		payload.SerializeToString(&serialized);
+		const std::vector<std::uint8_t> plaintext(serialized.begin(), serialized.end());
+		benchmark::DoNotOptimize(plaintext.data());
+	}
+	SetPacketCounters(state, packet.user().ByteSizeLong(), 3);
+}
+
+// The payload message lent to an arena wrapper and serialised once into the cryptor's input.
+void BM_DataPacketPlaintextLent(benchmark::State& state) {
+	const auto packet = MakeUserPacket(static_cast<std::size_t>(state.range(0)));
+	std::vector<std::uint8_t> plaintext;
+	for (auto _ : state) {
+		if (!SerializeEncryptablePayload(packet, plaintext)) {
+			state.SkipWithError("serialisation failed");
+			return;
+		}
+		benchmark::DoNotOptimize(plaintext.data());
+	}
+	SetPacketCounters(state, packet.user().ByteSizeLong(), 1);
+}
+
+void PayloadSizes(benchmark::internal::Benchmark* benchmark) {
+	// Telemetry samples, chat-sized messages, full data stream chunks and oversized payloads.
+	benchmark->Arg(64)->Arg(1 << 10)->Arg(15000)->Arg(64 << 10)->Arg(1 << 20);
+}
+
+BENCHMARK(BM_DataPacketSendCopying)->Apply(PayloadSizes);
+BENCHMARK(BM_DataPacketSendPooled)->Apply(PayloadSizes);
+BENCHMARK(BM_DataPacketPlaintextCopying)->Apply(PayloadSizes);
+BENCHMARK(BM_DataPacketPlaintextLent)->Apply(PayloadSizes);
+
+} // namespace
+} // namespace livekit::core
@@ -0,0 +1,147 @@
+#include "data_stream_compression.h"
+#include "file_stream_pipeline.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+
+// Repetitive JSON-like text, roughly what applications push through text and file streams.
+std::vector<std::uint8_t> MakeStreamPayload(std::size_t size) {
+	constexpr std::string_view kRecord =
+	    R"({"participant":"telemetry-publisher","sequence":000000,"values":[0.25,0.5,0.75]})";
+	std::vector<std::uint8_t> payload(size);
+	std::uint32_t seed = 7;
+	for (std::size_t index = 0; index < size; ++index) {
+		payload[index] = static_cast<std::uint8_t>(kRecord[index % kRecord.size()]);
+		if (payload[index] == '0') {
+			seed = seed * 1664525U + 1013904223U;
+			payload[index] = static_cast<std::uint8_t>('0' + (seed >> 24) % 10);
+		}
+	}
+	return payload;
+}
+
+void SetStreamCounters(benchmark::State& state, std::size_t input_bytes,
+                       std::size_t compressed_bytes) {
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+	                        static_cast<std::int64_t>(input_bytes));
+	state.counters["compression_ratio"] =
+	    compressed_bytes == 0 ? 0.0 : static_cast<double>(input_bytes) / compressed_bytes;
+}
+
+std::vector<std::uint8_t> Deflate(const std::vector<std::uint8_t>& input) {
+	DeflateRawStream stream;
+	std::vector<std::uint8_t> output;
+	if (!stream.IsValid() || !stream.Write(input.data(), input.size(), output) ||
+	    !stream.Finish(output)) {
+		output.clear();
+	}
+	return output;
+}
+
+// One stream per payload, as SendFile and SendText do for each compressed stream.
+void BM_DeflateRawStream(benchmark::State& state) {
+	const auto input = MakeStreamPayload(static_cast<std::size_t>(state.range(0)));
+	std::size_t compressed_size = 0;
+	for (auto _ : state) {
+		const auto output = Deflate(input);
+		if (output.empty()) {
+			state.SkipWithError("deflate failed");
+			return;
+		}
+		compressed_size = output.size();
+		benchmark::DoNotOptimize(output.data());
+	}
+	SetStreamCounters(state, input.size(), compressed_size);
+}
+
+// The whole-payload path of SendText, SendBytes and SendFile against BM_DeflateRawStream; arg 1 is
+// the worker count. Real time, because the work runs on the workers.
+void BM_DeflateRawParallel(benchmark::State& state) {
+	const auto input = MakeStreamPayload(static_cast<std::size_t>(state.range(0)));
+	DataStreamCompressionOptions options;
+	options.threads = static_cast<std::uint32_t>(state.range(1));
+	std::size_t compressed_size = 0;
+	for (auto _ : state) {
+		compressed_size = 0;
+		const bool compressed = DeflateRawParallel(
+		    input.data(), input.size(), options,
+		    [&](const std::uint8_t* data, std::size_t size, std::uint64_t) {
+			    benchmark::DoNotOptimize(data);
+			    compressed_size += size;
+			    return true;
+		    });
+		if (!compressed) {
+			state.SkipWithError("deflate failed");
+			return;
+		}
+	}
+	SetStreamCounters(state, input.size(), compressed_size);
+}
+
+void BM_InflateRawStream(benchmark::State& state) {
+	const auto input = MakeStreamPayload(static_cast<std::size_t>(state.range(0)));
+	const auto compressed = Deflate(input);
+	if (compressed.empty()) {
+		state.SkipWithError("deflate failed");
+		return;
+	}
+	for (auto _ : state) {
+		InflateRawStream stream(input.size());
+		std::vector<std::uint8_t> output;
+		if (!stream.Write(compressed.data(), compressed.size(), output) || !stream.Finished()) {
+			state.SkipWithError("inflate failed");
+			return;
+		}
+		benchmark::DoNotOptimize(output.data());
+	}
+	SetStreamCounters(state, input.size(), compressed.size());
+}
+
+// The chunking stage of SendFile; arg 1 selects the pipelined deflate path. Real time, because
+// the deflate work runs on the workers.
+void BM_StreamFileChunks(benchmark::State& state) {
+	const auto input = MakeStreamPayload(static_cast<std::size_t>(state.range(0)));
+	const bool compress = state.range(1) != 0;
+	std::size_t sent_size = 0;
+	for (auto _ : state) {
+		sent_size = 0;
+		const bool sent = StreamFileChunks(
+		    input.data(), input.size(), 15'000, compress, {},
+		    [&](const std::uint8_t* data, std::size_t size) {
+			    benchmark::DoNotOptimize(data);
+			    sent_size += size;
+			    return true;
+		    },
+		    {});
+		if (!sent) {
+			state.SkipWithError("file stream failed");
+			return;
+		}
+	}
+	SetStreamCounters(state, input.size(), sent_size);
+}
+
+void StreamSizes(benchmark::internal::Benchmark* benchmark) {
+	benchmark->Arg(1 << 10)->Arg(64 << 10)->Arg(1 << 20);
+	benchmark->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_DeflateRawStream)->Apply(StreamSizes);
+BENCHMARK(BM_DeflateRawParallel)
+    ->ArgsProduct({{1 << 20, 16 << 20}, {1, 2, 4}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_InflateRawStream)->Apply(StreamSizes);
+BENCHMARK(BM_StreamFileChunks)
+    ->ArgsProduct({{1 << 20, 16 << 20}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+} // namespace livekit::core::detail
@@ -0,0 +1,139 @@
+#include "participant_registry.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+struct FakeParticipant {
+	std::string identity;
+	std::vector<std::string> track_sids;
+
+	bool HasTrackSid(const std::string& track_sid) const {
+		for (const auto& sid : track_sids) {
+			if (sid == track_sid) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+using Registry = detail::ParticipantRegistry<FakeParticipant>;
+using Baseline = std::map<std::string, std::shared_ptr<FakeParticipant>>;
+
+constexpr int kTracksPerParticipant = 2;
+
+// A room of the given size in both layouts; each participant publishes a microphone and a camera.
+void Populate(std::int64_t participants, Registry& registry, Baseline& baseline) {
+	for (std::int64_t index = 0; index < participants; ++index) {
+		const auto sid = "PA_" + std::to_string(index);
+		auto participant = std::make_shared<FakeParticipant>();
+		participant->identity = "user-" + std::to_string(index);
+		for (int track = 0; track < kTracksPerParticipant; ++track) {
+			participant->track_sids.push_back("TR_" + std::to_string(index) + "_" +
+			                                  std::to_string(track));
+		}
+		registry.Upsert(sid, participant,
+		                {participant->identity, participant->identity, participant->track_sids});
+		baseline.emplace(sid, participant);
+	}
+}
+
+// Track events (mute, subscription status, stream state) each name a track sid. The lookups use the
+// last participant's track, the worst case for a scan in sid order.
+void BM_FindByTrackSid(benchmark::State& state) {
+	Registry registry;
+	Baseline baseline;
+	Populate(state.range(0), registry, baseline);
+	const auto& tracks = baseline.rbegin()->second->track_sids;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(registry.FindByTrackSid(tracks.back()));
+	}
+	state.counters["participants"] = static_cast<double>(registry.size());
+}
+
+// The scan this replaced: every participant's publications were checked in turn.
+void BM_FindByTrackSidScan(benchmark::State& state) {
+	Registry registry;
+	Baseline baseline;
+	Populate(state.range(0), registry, baseline);
+	const auto& tracks = baseline.rbegin()->second->track_sids;
+	for (auto _ : state) {
+		std::shared_ptr<FakeParticipant> found;
+		for (const auto& [sid, participant] : baseline) {
+			if (participant->HasTrackSid(tracks.back())) {
+				found = participant;
+				break;
+			}
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.counters["participants"] = static_cast<double>(baseline.size());
+}
+
+void BM_FindByIdentity(benchmark::State& state) {
+	Registry registry;
+	Baseline baseline;
+	Populate(state.range(0), registry, baseline);
+	const auto identity = baseline.rbegin()->second->identity;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(registry.FindByIdentity(identity));
+	}
+	state.counters["participants"] = static_cast<double>(registry.size());
+}
+
+void BM_FindByIdentityScan(benchmark::State& state) {
+	Registry registry;
+	Baseline baseline;
+	Populate(state.range(0), registry, baseline);
+	const auto identity = baseline.rbegin()->second->identity;
+	for (auto _ : state) {
+		std::shared_ptr<FakeParticipant> found;
+		for (const auto& [sid, participant] : baseline) {
+			if (participant->identity == identity) {
+				found = participant;
+				break;
+			}
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.counters["participants"] = static_cast<double>(baseline.size());
+}
+
+// A participant update re-indexes the participant with its current tracks.
+void BM_Upsert(benchmark::State& state) {
+	Registry registry;
+	Baseline baseline;
+	Populate(state.range(0), registry, baseline);
+	const auto& [sid, participant] = *baseline.rbegin();
+	for (auto _ : state) {
+		registry.Upsert(sid, participant,
+		                {participant->identity, participant->identity, participant->track_sids});
+	}
+}
+
+BENCHMARK(BM_FindByTrackSid)->ArgName("participants")->Arg(10)->Arg(100)->Arg(1'000)->Arg(5'000);
+BENCHMARK(BM_FindByTrackSidScan)
+    ->ArgName("participants")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1'000)
+    ->Arg(5'000);
+BENCHMARK(BM_FindByIdentity)->ArgName("participants")->Arg(10)->Arg(100)->Arg(1'000)->Arg(5'000);
+BENCHMARK(BM_FindByIdentityScan)
+    ->ArgName("participants")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1'000)
+    ->Arg(5'000);
+BENCHMARK(BM_Upsert)->ArgName("participants")->Arg(10)->Arg(5'000);
+
+} // namespace
+} // namespace livekit::core
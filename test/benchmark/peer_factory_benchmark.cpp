@@ -0,0 +1,112 @@
+#include "peer_transport_factory.h"
+
+#include "api/peer_connection_interface.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+class IdlePeerConnectionObserver : public webrtc::PeerConnectionObserver {
+public:
+	void OnSignalingChange(webrtc::PeerConnectionInterface::SignalingState) override {}
+	void OnDataChannel(webrtc::scoped_refptr<webrtc::DataChannelInterface>) override {}
+	void OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState) override {}
+	void OnIceCandidate(const webrtc::IceCandidateInterface*) override {}
+};
+
+struct ProcessUsage {
+	std::int64_t threads = 0;
+	std::int64_t rss_kb = 0;
+};
+
+// Reads the Threads and VmRSS lines of /proc/self/status; both stay zero on other platforms.
+ProcessUsage ReadProcessUsage() {
+	ProcessUsage usage;
+	std::ifstream status("/proc/self/status");
+	std::string key;
+	while (status >> key) {
+		if (key == "Threads:") {
+			status >> usage.threads;
+		} else if (key == "VmRSS:") {
+			status >> usage.rss_kb;
+		}
+		status.ignore(256, '\n');
+	}
+	return usage;
+}
+
+// What a connected room holds: the publisher and subscriber peer connections on its factory.
+struct RoomPeers {
+	std::shared_ptr<PeerTransportFactory> factory;
+	std::vector<webrtc::scoped_refptr<webrtc::PeerConnectionInterface>> connections;
+};
+
+bool OpenRoomPeers(RoomPeers& room, IdlePeerConnectionObserver& observer) {
+	webrtc::PeerConnectionInterface::RTCConfiguration config;
+	config.sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
+	for (int index = 0; index < 2; ++index) {
+		webrtc::PeerConnectionDependencies dependencies(&observer);
+		auto result = room.factory->GetPeerConnectFactory()->CreatePeerConnectionOrError(
+		    config, std::move(dependencies));
+		if (!result.ok()) {
+			return false;
+		}
+		room.connections.push_back(result.MoveValue());
+	}
+	return true;
+}
+
+// range(0) is 1 when every room shares one factory, 0 when each room creates its own as before.
+// Reports the threads and resident memory each room adds once the first room is up.
+void BM_PeerFactoryRooms(benchmark::State& state) {
+	const bool shared = state.range(0) != 0;
+	const auto rooms = static_cast<std::size_t>(state.range(1));
+	IdlePeerConnectionObserver observer;
+	double threads_per_room = 0;
+	double rss_kb_per_room = 0;
+	for (auto _ : state) {
+		const auto shared_factory = shared ? PeerTransportFactory::Create() : nullptr;
+		std::vector<RoomPeers> open(rooms);
+		ProcessUsage first_room;
+		for (std::size_t index = 0; index < rooms; ++index) {
+			open[index].factory = shared ? shared_factory : PeerTransportFactory::Create();
+			if (!OpenRoomPeers(open[index], observer)) {
+				state.SkipWithError("peer connection creation failed");
+				return;
+			}
+			if (index == 0) {
+				first_room = ReadProcessUsage();
+			}
+		}
+		const auto all_rooms = ReadProcessUsage();
+		const auto added = static_cast<double>(rooms > 1 ? rooms - 1 : 1);
+		threads_per_room = static_cast<double>(all_rooms.threads - first_room.threads) / added;
+		rss_kb_per_room = static_cast<double>(all_rooms.rss_kb - first_room.rss_kb) / added;
+		for (auto& room : open) {
+			for (auto& connection : room.connections) {
+				connection->Close();
+			}
+		}
+	}
+	state.counters["threads_per_room"] = threads_per_room;
+	state.counters["rss_kb_per_room"] = rss_kb_per_room;
+}
+
+BENCHMARK(BM_PeerFactoryRooms)
+    ->ArgNames({"shared", "rooms"})
+    ->Args({0, 10})
+    ->Args({1, 10})
+    ->Args({0, 50})
+    ->Args({1, 50})
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace livekit::core
@@ -0,0 +1,57 @@
+#include "livekit/core/track/rtc_stats.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+namespace livekit::core {
+namespace {
+
+// An RTCStatsReport::ToJson payload for a peer connection carrying streams RTP streams. Each stream
+// references a codec and remote report, and the transport and candidate entries that a real report
+// contains are included so the parser has to skip them.
+std::string MakeStatsReport(std::int64_t streams) {
+	std::string report = "[";
+	report += R"({"id":"T01","type":"transport","bytesSent":123456,"bytesReceived":654321,)"
+	          R"("dtlsState":"connected","selectedCandidatePairId":"CP01"},)";
+	report += R"({"id":"CP01","type":"candidate-pair","state":"succeeded",)"
+	          R"("currentRoundTripTime":0.021,"availableOutgoingBitrate":2500000},)";
+	for (std::int64_t index = 0; index < streams; ++index) {
+		const auto id = std::to_string(index);
+		const bool video = index % 2 == 0;
+		report += R"({"id":"C)" + id + R"(","type":"codec","mimeType":")" +
+		          (video ? "video/VP8" : "audio/opus") + R"(","clockRate":90000},)";
+		report += R"({"id":"R)" + id +
+		          R"(","type":"remote-inbound-rtp","jitter":0.004,"roundTripTime":0.025},)";
+		report += R"({"id":"S)" + id + R"(","type":"outbound-rtp","kind":")" +
+		          (video ? "video" : "audio") + R"(","ssrc":)" + std::to_string(1000 + index) +
+		          R"(,"rid":"h","timestamp":1700000000000.5,"bytesSent":12000000,)"
+		          R"("packetsSent":120000,"frameWidth":1280,"frameHeight":720,)"
+		          R"("framesPerSecond":30,"framesSent":3000,"qpSum":40000,"codecId":"C)" +
+		          id + R"(","remoteId":"R)" + id +
+		          R"(","encoderImplementation":"libvpx","qualityLimitationReason":"none"},)";
+	}
+	report.back() = ']';
+	return report;
+}
+
+void BM_ParseRTCStatsReport(benchmark::State& state) {
+	const auto report = MakeStatsReport(state.range(0));
+	for (auto _ : state) {
+		auto snapshot = ParseRTCStatsReport(report);
+		if (snapshot.streams.size() != static_cast<std::size_t>(state.range(0))) {
+			state.SkipWithError("unexpected stream count");
+			return;
+		}
+		benchmark::DoNotOptimize(snapshot);
+	}
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+	                        static_cast<std::int64_t>(report.size()));
+}
+
+// A single track, a publisher with simulcast audio and video, and a large subscriber.
+BENCHMARK(BM_ParseRTCStatsReport)->ArgName("streams")->Arg(1)->Arg(4)->Arg(64);
+
+} // namespace
+} // namespace livekit::core
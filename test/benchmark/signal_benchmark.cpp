@@ -0,0 +1,106 @@
+#include "livekit_models.pb.h"
+#include "livekit_rtc.pb.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+namespace livekit::core {
+namespace {
+
+void FillParticipant(livekit::ParticipantInfo& participant, std::int64_t index) {
+	const auto id = std::to_string(index);
+	participant.set_sid("PA_" + id);
+	participant.set_identity("participant-" + id);
+	participant.set_name("Participant " + id);
+	participant.set_metadata(R"({"role":"speaker","avatar":"https://example.com/a.png"})");
+	participant.set_state(livekit::ParticipantInfo_State_ACTIVE);
+	participant.set_joined_at(1700000000 + index);
+	participant.set_version(static_cast<std::uint32_t>(index + 1));
+	(*participant.mutable_attributes())["team"] = "blue";
+
+	auto* audio = participant.add_tracks();
+	audio->set_sid("TR_A" + id);
+	audio->set_type(livekit::AUDIO);
+	audio->set_source(livekit::TrackSource::MICROPHONE);
+	audio->set_mime_type("audio/red");
+	audio->set_mid("0");
+
+	auto* video = participant.add_tracks();
+	video->set_sid("TR_V" + id);
+	video->set_type(livekit::VIDEO);
+	video->set_source(livekit::TrackSource::CAMERA);
+	video->set_width(1280);
+	video->set_height(720);
+	video->set_simulcast(true);
+	video->set_mime_type("video/VP8");
+	video->set_mid("1");
+	const std::uint32_t widths[] = {320, 640, 1280};
+	for (std::uint32_t layer = 0; layer < 3; ++layer) {
+		auto* video_layer = video->add_layers();
+		video_layer->set_quality(static_cast<livekit::VideoQuality>(layer));
+		video_layer->set_width(widths[layer]);
+		video_layer->set_height(widths[layer] * 9 / 16);
+		video_layer->set_bitrate(150000 << layer);
+		video_layer->set_ssrc(1000 + layer);
+	}
+}
+
+// The join response a client receives when it enters a room with other participants.
+std::string MakeJoinResponse(std::int64_t participants) {
+	livekit::SignalResponse response;
+	auto* join = response.mutable_join();
+	join->mutable_room()->set_sid("RM_benchmark");
+	join->mutable_room()->set_name("benchmark");
+	join->mutable_room()->set_num_participants(static_cast<std::uint32_t>(participants + 1));
+	FillParticipant(*join->mutable_participant(), participants);
+	for (std::int64_t index = 0; index < participants; ++index) {
+		FillParticipant(*join->add_other_participants(), index);
+	}
+	auto* ice = join->add_ice_servers();
+	ice->add_urls("turn:turn.example.com:443?transport=tcp");
+	ice->set_username("user");
+	ice->set_credential("credential");
+	join->set_server_version("1.8.0");
+	return response.SerializeAsString();
+}
+
+std::string MakeParticipantUpdate(std::int64_t participants) {
+	livekit::SignalResponse response;
+	auto* update = response.mutable_update();
+	for (std::int64_t index = 0; index < participants; ++index) {
+		FillParticipant(*update->add_participants(), index);
+	}
+	return response.SerializeAsString();
+}
+
+// Mirrors SignalClient's receive path: a fresh SignalResponse parsed from each WebSocket frame.
+void ParseSignalResponses(benchmark::State& state, const std::string& message) {
+	for (auto _ : state) {
+		livekit::SignalResponse response{};
+		if (!response.ParseFromArray(message.data(), static_cast<int>(message.size()))) {
+			state.SkipWithError("parse failed");
+			return;
+		}
+		benchmark::DoNotOptimize(response);
+	}
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+	                        static_cast<std::int64_t>(message.size()));
+	state.counters["messages_per_second"] =
+	    benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+void BM_SignalParseJoinResponse(benchmark::State& state) {
+	ParseSignalResponses(state, MakeJoinResponse(state.range(0)));
+}
+
+void BM_SignalParseParticipantUpdate(benchmark::State& state) {
+	ParseSignalResponses(state, MakeParticipantUpdate(state.range(0)));
+}
+
+BENCHMARK(BM_SignalParseJoinResponse)->ArgName("participants")->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_SignalParseParticipantUpdate)->ArgName("participants")->Arg(1)->Arg(10)->Arg(100);
+
+} // namespace
+} // namespace livekit::core
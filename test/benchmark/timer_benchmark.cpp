@@ -0,0 +1,58 @@
+#include "timer.h"
+#include "timer_wheel.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+using namespace std::chrono_literals;
+
+// Fills a wheel with long-running timers spread over several levels, as many rooms' ping timers
+// would, so each iteration schedules and cancels among them.
+void BM_TimerWheelScheduleCancel(benchmark::State& state) {
+	detail::TimerWheel wheel;
+	std::vector<detail::TimerWheel::TimerId> active;
+	for (std::int64_t index = 0; index < state.range(0); ++index) {
+		active.push_back(wheel.Schedule(std::chrono::milliseconds(60'000 + index * 97), [] {}));
+	}
+	for (auto _ : state) {
+		const auto id = wheel.Schedule(15s, [] {});
+		benchmark::DoNotOptimize(wheel.Cancel(id));
+	}
+	const auto stats = wheel.GetStats();
+	state.counters["active_timers"] = static_cast<double>(stats.active);
+	// The old Timer ran one thread per active timer.
+	state.counters["threads"] = static_cast<double>(stats.threads);
+	for (const auto id : active) {
+		wheel.Cancel(id);
+	}
+}
+
+// The ping timeout pattern: SignalClient restarts its timeout on every pong.
+void BM_TimerRestart(benchmark::State& state) {
+	std::vector<std::unique_ptr<Timer>> active;
+	for (std::int64_t index = 0; index < state.range(0); ++index) {
+		active.push_back(std::make_unique<Timer>());
+		active.back()->SetInterval([] {}, 60'000);
+	}
+	Timer timer;
+	for (auto _ : state) {
+		timer.SetTimeout([] {}, 15'000);
+	}
+	timer.Stop();
+	const auto stats = detail::TimerWheel::Shared().GetStats();
+	state.counters["active_timers"] = static_cast<double>(stats.active);
+	state.counters["threads"] = static_cast<double>(stats.threads);
+}
+
+BENCHMARK(BM_TimerWheelScheduleCancel)->ArgName("active")->Arg(0)->Arg(1'000)->Arg(100'000);
+BENCHMARK(BM_TimerRestart)->ArgName("active")->Arg(1'000);
+
+} // namespace
+} // namespace livekit::core
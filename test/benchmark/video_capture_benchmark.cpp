@@ -0,0 +1,162 @@
+#include "frame_queue.h"
+#include "video_frame_converter.h"
+
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "common_video/include/video_frame_buffer_pool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace livekit::capture {
+namespace {
+
+std::vector<std::uint8_t> MakePattern(std::size_t size) {
+	std::vector<std::uint8_t> frame(size);
+	for (std::size_t index = 0; index < frame.size(); ++index) {
+		frame[index] = static_cast<std::uint8_t>(index * 31U);
+	}
+	return frame;
+}
+
+std::vector<std::uint8_t> MakeBgraFrame(std::uint32_t width, std::uint32_t height) {
+	return MakePattern(static_cast<std::size_t>(width) * height * 4U);
+}
+
+// Full-frame writes per captured frame, including the colour conversion itself.
+void SetFrameCounters(benchmark::State& state, std::size_t frame_bytes, int frame_writes) {
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+	                        static_cast<std::int64_t>(frame_bytes));
+	state.counters["frame_writes"] = frame_writes;
+	state.counters["fps"] =
+	    benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// The conversion alone, into a reused packed I420 frame.
+void BM_ConvertBgraToI420(benchmark::State& state) {
+	const auto width = static_cast<std::uint32_t>(state.range(0));
+	const auto height = static_cast<std::uint32_t>(state.range(1));
+	const auto source = MakeBgraFrame(width, height);
+	CapturedVideoFrame converted;
+	for (auto _ : state) {
+		if (!ConvertBgraToI420(source.data(), width, height, width * 4U, 0, converted)) {
+			state.SkipWithError("conversion failed");
+			return;
+		}
+		benchmark::DoNotOptimize(converted.i420.data());
+	}
+	SetFrameCounters(state, source.size(), 1);
+}
+
+// The capture callback's cost: copying a frame into the triple-buffer pool while the worker
+// delivers to an empty handler. Frames the worker has not taken yet are replaced, as in capture.
+void BM_LatestVideoFrameQueuePush(benchmark::State& state) {
+	const auto width = static_cast<std::uint32_t>(state.range(0));
+	const auto height = static_cast<std::uint32_t>(state.range(1));
+	const auto source = MakeBgraFrame(width, height);
+	LatestVideoFrameQueue queue([](const OwnedVideoFrame& frame) {
+		benchmark::DoNotOptimize(frame.data.data());
+	});
+	if (!queue.Start()) {
+		state.SkipWithError("queue did not start");
+		return;
+	}
+	std::int64_t timestamp_us = 0;
+	for (auto _ : state) {
+		queue.Push(source.data(), width, height, width * 4U, timestamp_us);
+		timestamp_us += 33333;
+	}
+	queue.Stop();
+	const auto stats = queue.Stats();
+	SetFrameCounters(state, source.size(), 1);
+	state.counters["pool_misses"] = static_cast<double>(stats.pool_misses);
+	state.counters["dropped_frames"] = static_cast<double>(stats.dropped_frames);
+}
+
+// The previous pipeline: a freshly allocated queue copy, packed I420 conversion, the VideoFrame
+// vector copy in the capture source, and I420Buffer::Copy in VideoSource::InternalSource.
+void BM_CapturePipelinePacked(benchmark::State& state) {
+	const auto width = static_cast<std::uint32_t>(state.range(0));
+	const auto height = static_cast<std::uint32_t>(state.range(1));
+	const auto source = MakeBgraFrame(width, height);
+	CapturedVideoFrame converted;
+	for (auto _ : state) {
+		std::vector<std::uint8_t> queued(source.begin(), source.end());
+		if (!ConvertBgraToI420(queued.data(), width, height, width * 4U, 0, converted)) {
+			state.SkipWithError("conversion failed");
+			return;
+		}
+		std::vector<std::uint8_t> packed = converted.i420;
+		const int w = static_cast<int>(converted.width);
+		const int h = static_cast<int>(converted.height);
+		const std::size_t y_size = static_cast<std::size_t>(w) * h;
+		auto buffer = webrtc::I420Buffer::Copy(w, h, packed.data(), w, packed.data() + y_size,
+		                                       w / 2, packed.data() + y_size + y_size / 4, w / 2);
+		benchmark::DoNotOptimize(buffer);
+	}
+	SetFrameCounters(state, source.size(), 4);
+}
+
+// The fused pipeline: a recycled queue buffer converted straight into a pooled I420Buffer.
+void BM_CapturePipelinePooled(benchmark::State& state) {
+	const auto width = static_cast<std::uint32_t>(state.range(0));
+	const auto height = static_cast<std::uint32_t>(state.range(1));
+	const auto source = MakeBgraFrame(width, height);
+	std::vector<std::uint8_t> queued(source.size());
+	webrtc::VideoFrameBufferPool pool(false, 8);
+	for (auto _ : state) {
+		queued.assign(source.begin(), source.end());
+		auto buffer = ConvertBgraToPooledI420(queued.data(), width, height, width * 4U, pool);
+		if (!buffer) {
+			state.SkipWithError("conversion failed");
+			return;
+		}
+		auto frame = webrtc::VideoFrame::Builder().set_video_frame_buffer(buffer).build();
+		benchmark::DoNotOptimize(frame);
+	}
+	SetFrameCounters(state, source.size(), 2);
+}
+
+// Native camera formats pushed through the same pooled queue buffer: NV12 is copied into an
+// NV12Buffer unchanged, YUY2 takes one conversion to I420.
+template <CapturePixelFormat kFormat> void BM_CapturePipelineNative(benchmark::State& state) {
+	OwnedVideoFrame frame;
+	frame.format = kFormat;
+	frame.width = static_cast<std::uint32_t>(state.range(0));
+	frame.height = static_cast<std::uint32_t>(state.range(1));
+	frame.row_stride_bytes = kFormat == CapturePixelFormat::Yuy2 ? frame.width * 2U : frame.width;
+	const auto size =
+	    CaptureFrameSize(kFormat, frame.width, frame.height, frame.row_stride_bytes).value_or(0);
+	const auto source = MakePattern(size);
+	frame.data.resize(size);
+	webrtc::VideoFrameBufferPool pool(false, 8);
+	for (auto _ : state) {
+		std::copy_n(source.begin(), size, frame.data.begin());
+		auto buffer = ConvertToPooledBuffer(frame, pool);
+		if (!buffer) {
+			state.SkipWithError("conversion failed");
+			return;
+		}
+		auto rtc_frame = webrtc::VideoFrame::Builder().set_video_frame_buffer(buffer).build();
+		benchmark::DoNotOptimize(rtc_frame);
+	}
+	SetFrameCounters(state, size, 2);
+}
+
+void CaptureResolutions(benchmark::internal::Benchmark* benchmark) {
+	benchmark->Args({1280, 720})->Args({1920, 1080})->Args({3840, 2160});
+	benchmark->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_ConvertBgraToI420)->Apply(CaptureResolutions);
+BENCHMARK(BM_LatestVideoFrameQueuePush)->Apply(CaptureResolutions);
+BENCHMARK(BM_CapturePipelinePacked)->Apply(CaptureResolutions);
+BENCHMARK(BM_CapturePipelinePooled)->Apply(CaptureResolutions);
+BENCHMARK(BM_CapturePipelineNative<CapturePixelFormat::Nv12>)->Apply(CaptureResolutions);
+BENCHMARK(BM_CapturePipelineNative<CapturePixelFormat::Yuy2>)->Apply(CaptureResolutions);
+
+} // namespace
+} // namespace livekit::capture
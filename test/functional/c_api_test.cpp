@@ -298,6 +298,12 @@ TEST(CApiTest, RejectsMicrophoneOperationsForExternalAudioSource) {
 	          LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_audio_source_microphone_processing_stats(nullptr, &stats),
 	          LK_STATUS_INVALID_ARGUMENT);
+	lk_audio_source_queue_stats_t queue_stats;
+	lk_audio_source_queue_stats_init(&queue_stats);
+	EXPECT_EQ(lk_audio_source_queue_stats(source, &queue_stats), LK_STATUS_OK);
+	EXPECT_GT(queue_stats.capacity_samples, 0u);
+	EXPECT_EQ(lk_audio_source_queue_stats(nullptr, &queue_stats), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_audio_source_queue_stats(source, nullptr), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_audio_source_destroy(source), LK_STATUS_OK);
 
 	lk_microphone_capture_options_t options;
@@ -320,6 +326,7 @@ TEST(CApiTest, ValidatesArgumentsWithoutThrowingAcrossAbi) {
 	          LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_local_track_unpublish(nullptr, 1), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_local_track_rtc_stats(nullptr, nullptr, 0), 0u);
+	EXPECT_EQ(lk_local_track_dynacast_layers(nullptr, nullptr, 0), 0u);
 	EXPECT_EQ(lk_local_track_publish_screen_share_video(nullptr, nullptr, nullptr),
 	          LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_local_track_publish_screen_share_audio(nullptr, nullptr, nullptr),
@@ -327,6 +334,8 @@ TEST(CApiTest, ValidatesArgumentsWithoutThrowingAcrossAbi) {
 	EXPECT_EQ(lk_room_republish_all_tracks(nullptr), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_room_send_text(nullptr, nullptr, nullptr), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_room_send_bytes(nullptr, nullptr, 0, nullptr), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_send_file(nullptr, "file.bin", nullptr), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_send_file_async(nullptr, "file.bin", nullptr), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_room_stream_text(nullptr, nullptr, nullptr), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_text_stream_writer_write(nullptr, nullptr, 0), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_text_stream_writer_id(nullptr, nullptr, 0), 0u);
@@ -355,11 +364,33 @@ TEST(CApiTest, ValidatesArgumentsWithoutThrowingAcrossAbi) {
 	lk_audio_playback_stats_t playback_stats;
 	lk_audio_playback_stats_init(&playback_stats);
 	EXPECT_EQ(lk_room_audio_playback_stats(nullptr, &playback_stats), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_create_audio_mixer(nullptr, nullptr, nullptr), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_audio_mixer_pull(nullptr, nullptr, nullptr), LK_STATUS_INVALID_ARGUMENT);
+	lk_audio_mixer_destroy(nullptr);
+	EXPECT_EQ(lk_audio_stream_read(nullptr, 0, nullptr), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_audio_stream_fd(nullptr), -1);
+	EXPECT_EQ(lk_audio_stream_event_handle(nullptr), nullptr);
+	EXPECT_EQ(lk_video_stream_event_handle(nullptr), nullptr);
+	EXPECT_EQ(lk_video_stream_close(nullptr), LK_STATUS_INVALID_ARGUMENT);
+	lk_frame_stream_stats_t stream_stats;
+	lk_frame_stream_stats_init(&stream_stats);
+	EXPECT_EQ(lk_video_stream_stats(nullptr, &stream_stats), LK_STATUS_INVALID_ARGUMENT);
+	lk_audio_stream_destroy(nullptr);
+	lk_video_stream_destroy(nullptr);
 	EXPECT_EQ(lk_remote_participant_list_at(nullptr, 0, nullptr), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_remote_participant_snapshot_info(nullptr, nullptr), LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_remote_track_publication_snapshot_info(nullptr, nullptr),
 	          LK_STATUS_INVALID_ARGUMENT);
 	EXPECT_EQ(lk_remote_track_snapshot_info(nullptr, nullptr), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_video_frame_delivery(nullptr, LK_VIDEO_FRAME_DELIVERY_BUFFER),
+	          LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_video_frame_buffer_retain(nullptr), nullptr);
+	lk_video_frame_buffer_release(nullptr);
+	lk_video_frame_planes_t planes;
+	lk_video_frame_planes_init(&planes);
+	EXPECT_EQ(planes.struct_size, sizeof(planes));
+	EXPECT_EQ(lk_video_frame_buffer_planes(nullptr, &planes), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_video_frame_buffer_timestamp_us(nullptr), 0);
 }
 
 TEST(CApiTest, CreatesRoomAndCapturesLocalFrames) {
@@ -379,6 +410,99 @@ TEST(CApiTest, CreatesRoomAndCapturesLocalFrames) {
 	lk_audio_playback_stats_init(&playback_stats);
 	EXPECT_EQ(lk_room_audio_playback_stats(room, &playback_stats), LK_STATUS_OK);
 	EXPECT_EQ(playback_stats.queued_frames, 0u);
+	EXPECT_EQ(lk_room_set_video_frame_delivery(room, LK_VIDEO_FRAME_DELIVERY_BUFFER), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_video_frame_delivery(room, static_cast<lk_video_frame_delivery_t>(7)),
+	          LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_video_frame_delivery(room, LK_VIDEO_FRAME_DELIVERY_PACKED), LK_STATUS_OK);
+	lk_data_batching_options_t batching;
+	lk_data_batching_options_init(&batching);
+	EXPECT_EQ(batching.window_ms, 5u);
+	EXPECT_EQ(batching.max_batch_bytes, 1000u);
+	batching.window_ms = 0;
+	EXPECT_EQ(lk_room_set_data_batching(room, &batching), LK_STATUS_INVALID_ARGUMENT);
+	batching.window_ms = 2;
+	EXPECT_EQ(lk_room_set_data_batching(room, &batching), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_data_batching(room, nullptr), LK_STATUS_OK);
+	lk_data_batching_stats_t batching_stats;
+	lk_data_batching_stats_init(&batching_stats);
+	EXPECT_EQ(lk_room_data_batching_stats(room, &batching_stats), LK_STATUS_OK);
+	EXPECT_EQ(batching_stats.packets, 0u);
+	EXPECT_EQ(lk_room_data_batching_stats(nullptr, &batching_stats), LK_STATUS_INVALID_ARGUMENT);
+	lk_data_stream_compression_options_t compression;
+	lk_data_stream_compression_options_init(&compression);
+	EXPECT_EQ(compression.level, -1);
+	EXPECT_EQ(compression.threads, 0u);
+	compression.level = 10;
+	EXPECT_EQ(lk_room_set_data_stream_compression(room, &compression), LK_STATUS_INVALID_ARGUMENT);
+	compression.level = 1;
+	compression.strategy = static_cast<lk_data_stream_compression_strategy_t>(9);
+	EXPECT_EQ(lk_room_set_data_stream_compression(room, &compression), LK_STATUS_INVALID_ARGUMENT);
+	compression.strategy = LK_DATA_STREAM_COMPRESSION_STRATEGY_RLE;
+	compression.threads = 2;
+	EXPECT_EQ(lk_room_set_data_stream_compression(room, &compression), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_data_stream_compression(room, nullptr), LK_STATUS_OK);
+	lk_incoming_data_stream_t incoming_streams[2];
+	EXPECT_EQ(lk_room_incoming_data_streams(room, incoming_streams, 2), 0u);
+	EXPECT_EQ(lk_room_incoming_data_streams(nullptr, incoming_streams, 2), 0u);
+	lk_event_dispatch_options_t dispatch;
+	lk_event_dispatch_options_init(&dispatch);
+	EXPECT_EQ(dispatch.enabled, 1);
+	EXPECT_EQ(dispatch.connection.overflow, LK_EVENT_OVERFLOW_GROW);
+	EXPECT_EQ(dispatch.speakers.overflow, LK_EVENT_OVERFLOW_COALESCE);
+	EXPECT_EQ(dispatch.data.overflow, LK_EVENT_OVERFLOW_DROP_LOSSY);
+	dispatch.media.capacity = 0;
+	EXPECT_EQ(lk_room_set_event_dispatch(room, &dispatch), LK_STATUS_INVALID_ARGUMENT);
+	dispatch.media.capacity = 16;
+	dispatch.data.overflow = static_cast<lk_event_overflow_t>(7);
+	EXPECT_EQ(lk_room_set_event_dispatch(room, &dispatch), LK_STATUS_INVALID_ARGUMENT);
+	dispatch.data.overflow = LK_EVENT_OVERFLOW_GROW;
+	EXPECT_EQ(lk_room_set_event_dispatch(room, &dispatch), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_event_dispatch(room, nullptr), LK_STATUS_OK);
+	lk_event_dispatch_stats_t dispatch_stats;
+	lk_event_dispatch_stats_init(&dispatch_stats);
+	EXPECT_EQ(lk_room_event_dispatch_stats(room, &dispatch_stats), LK_STATUS_OK);
+	EXPECT_EQ(dispatch_stats.connection.depth, 0u);
+	EXPECT_EQ(lk_room_event_dispatch_stats(nullptr, &dispatch_stats), LK_STATUS_INVALID_ARGUMENT);
+	lk_peer_factory_t* peer_factory = nullptr;
+	ASSERT_EQ(lk_peer_factory_process(&peer_factory), LK_STATUS_OK) << lk_last_error();
+	ASSERT_NE(peer_factory, nullptr);
+	lk_peer_factory_stats_t factory_stats;
+	lk_peer_factory_stats_init(&factory_stats);
+	EXPECT_EQ(lk_peer_factory_stats(peer_factory, &factory_stats), LK_STATUS_OK);
+	EXPECT_EQ(factory_stats.rooms, 0u);
+	EXPECT_GE(factory_stats.threads, 3u);
+	EXPECT_EQ(lk_peer_factory_stats(nullptr, &factory_stats), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_peer_factory(room, peer_factory), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_audio_output_device(room, "default"), LK_STATUS_INVALID_STATE);
+	EXPECT_EQ(lk_room_set_speaker_volume(room, 0.5F), LK_STATUS_INVALID_STATE);
+	EXPECT_EQ(lk_room_set_speaker_muted(room, 1), LK_STATUS_INVALID_STATE);
+	EXPECT_EQ(lk_room_set_peer_factory(room, nullptr), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_peer_factory(nullptr, peer_factory), LK_STATUS_INVALID_ARGUMENT);
+	lk_peer_factory_destroy(peer_factory);
+	EXPECT_EQ(lk_room_set_audio_playout(room, LK_AUDIO_PLAYOUT_HEADLESS), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_audio_playout(room, static_cast<lk_audio_playout_t>(5)),
+	          LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_audio_playout(nullptr, LK_AUDIO_PLAYOUT_DEVICE),
+	          LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_audio_playout(room, LK_AUDIO_PLAYOUT_DEVICE), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_adaptive_stream(room, 1), LK_STATUS_OK);
+	EXPECT_EQ(lk_room_set_adaptive_stream(nullptr, 1), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_remote_video_render_state(room, "TR_missing", 320, 0, 1),
+	          LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_remote_video_render_state(room, "TR_missing", 320, 180, 1),
+	          LK_STATUS_OPERATION_FAILED);
+	EXPECT_EQ(lk_room_set_remote_video_render_state(room, nullptr, 320, 180, 1),
+	          LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_room_set_adaptive_stream(room, 0), LK_STATUS_OK);
+	EXPECT_EQ(lk_peer_factory_create_with_playout(LK_AUDIO_PLAYOUT_HEADLESS, nullptr),
+	          LK_STATUS_INVALID_ARGUMENT);
+	ASSERT_EQ(lk_peer_factory_create_with_playout(LK_AUDIO_PLAYOUT_HEADLESS, &peer_factory),
+	          LK_STATUS_OK)
+	    << lk_last_error();
+	ASSERT_NE(peer_factory, nullptr);
+	EXPECT_EQ(lk_peer_factory_stats(peer_factory, &factory_stats), LK_STATUS_OK);
+	EXPECT_EQ(factory_stats.rooms, 0u);
+	lk_peer_factory_destroy(peer_factory);
 	lk_remote_participant_list_t* participant_snapshot = nullptr;
 	ASSERT_EQ(lk_room_create_remote_participant_snapshot(room, &participant_snapshot),
 	          LK_STATUS_OK);
@@ -390,6 +514,52 @@ TEST(CApiTest, CreatesRoomAndCapturesLocalFrames) {
 	EXPECT_EQ(missing_participant, nullptr);
 	lk_remote_participant_list_destroy(participant_snapshot);
 
+	lk_audio_mixer_options_t mixer_options;
+	lk_audio_mixer_options_init(&mixer_options);
+	EXPECT_EQ(mixer_options.sample_rate, 48000u);
+	EXPECT_EQ(mixer_options.include_all_tracks, 1);
+	mixer_options.sample_rate = 44101;
+	lk_audio_mixer_t* mixer = nullptr;
+	EXPECT_EQ(lk_room_create_audio_mixer(room, &mixer_options, &mixer), LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(mixer, nullptr);
+	mixer_options.sample_rate = 16000;
+	mixer_options.num_channels = 2;
+	ASSERT_EQ(lk_room_create_audio_mixer(room, &mixer_options, &mixer), LK_STATUS_OK)
+	    << lk_last_error();
+	EXPECT_EQ(lk_audio_mixer_add_track(mixer, "TR_missing"), LK_STATUS_OPERATION_FAILED);
+	EXPECT_EQ(lk_audio_mixer_set_participant_gain(mixer, "PA_missing", -1.0F),
+	          LK_STATUS_INVALID_ARGUMENT);
+	EXPECT_EQ(lk_audio_mixer_set_participant_gain(mixer, "PA_missing", 0.5F), LK_STATUS_OK);
+	lk_audio_frame_t mixed{};
+	int has_audio = 1;
+	ASSERT_EQ(lk_audio_mixer_pull(mixer, &mixed, &has_audio), LK_STATUS_OK);
+	EXPECT_EQ(has_audio, 0);
+	EXPECT_EQ(mixed.sample_rate, 16000u);
+	EXPECT_EQ(mixed.samples_per_channel, 160u);
+	EXPECT_EQ(mixed.sample_count, 320u);
+	lk_audio_mixer_stats_t mixer_stats;
+	lk_audio_mixer_stats_init(&mixer_stats);
+	EXPECT_EQ(lk_audio_mixer_stats(mixer, &mixer_stats), LK_STATUS_OK);
+	EXPECT_EQ(mixer_stats.mixed_frames, 1u);
+	EXPECT_EQ(mixer_stats.track_count, 0u);
+	lk_audio_mixer_destroy(mixer);
+
+	lk_audio_stream_options_t audio_stream_options;
+	lk_audio_stream_options_init(&audio_stream_options);
+	EXPECT_EQ(audio_stream_options.capacity_frames, 50u);
+	EXPECT_EQ(audio_stream_options.overflow, LK_FRAME_STREAM_OVERFLOW_DROP_OLDEST);
+	lk_audio_stream_t* audio_stream = nullptr;
+	EXPECT_EQ(lk_room_create_audio_stream(room, "TR_missing", &audio_stream_options, &audio_stream),
+	          LK_STATUS_OPERATION_FAILED);
+	EXPECT_EQ(audio_stream, nullptr);
+	lk_video_stream_options_t video_stream_options;
+	lk_video_stream_options_init(&video_stream_options);
+	EXPECT_EQ(video_stream_options.overflow, LK_FRAME_STREAM_OVERFLOW_KEEP_LATEST);
+	video_stream_options.overflow = static_cast<lk_frame_stream_overflow_t>(9);
+	lk_video_stream_t* video_stream = nullptr;
+	EXPECT_EQ(lk_room_create_video_stream(room, "TR_missing", &video_stream_options, &video_stream),
+	          LK_STATUS_INVALID_ARGUMENT);
+
 	lk_room_callbacks_t callbacks;
 	lk_room_callbacks_init(&callbacks);
 	EXPECT_EQ(callbacks.on_reconnecting, nullptr);
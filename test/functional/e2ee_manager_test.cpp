@@ -3,6 +3,7 @@
 
 #include "e2ee_manager_internal.h"
 #include "key_provider_internal.h"
+#include "key_schedule.h"
 
 #include "api/crypto/frame_crypto_transformer.h"
 #include "api/make_ref_counted.h"
@@ -10,6 +11,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <optional>
@@ -216,9 +218,13 @@ TEST(E2EEManagerTest, DataCryptorAutomaticallyRatchetsWithinConfiguredWindow) {
 
 	auto encrypted = encryptor->Encrypt("alice", 0, plaintext);
 	ASSERT_TRUE(encrypted.ok());
+	// Decryption only tries ratchets already derived in the background.
+	detail::KeySchedule::Shared().WaitForIdle();
+	const auto hits = GetE2eeRatchetStats().hits;
 	auto decrypted = decryptor->Decrypt("alice", encrypted.value());
 	ASSERT_TRUE(decrypted.ok());
 	EXPECT_EQ(decrypted.value(), plaintext);
+	EXPECT_EQ(GetE2eeRatchetStats().hits, hits + 1);
 	auto receiver_handler = KeyProviderNativeAccess::Get(receiver)->GetSharedKey("alice");
 	ASSERT_NE(receiver_handler, nullptr);
 	ASSERT_NE(receiver_handler->GetKeySet(0), nullptr);
@@ -243,6 +249,84 @@ TEST(E2EEManagerTest, ManagerEncryptsDataUsingSelectedKeySlot) {
 	EXPECT_EQ(*decrypted, plaintext);
 }
 
+TEST(E2EEManagerTest, DataCryptoSessionBatchesInTheDataPacketCryptorFormat) {
+	KeyProvider keys;
+	ASSERT_TRUE(keys.SetSharedKey({3, 1, 4, 1, 5, 9}).Ok());
+	auto cryptor = webrtc::make_ref_counted<webrtc::DataPacketCryptor>(
+	    webrtc::FrameCryptorTransformer::Algorithm::kAesGcm, KeyProviderNativeAccess::Get(keys));
+	DataPacketCryptoSession session(KeyProviderNativeAccess::Get(keys), cryptor);
+	const std::vector<std::vector<std::uint8_t>> plaintexts{{1, 2, 3}, {}, {9, 8, 7, 6, 5}};
+	std::vector<std::vector<std::uint8_t>> buffers;
+	std::vector<DataPacketCryptoSession::Packet> packets(plaintexts.size());
+	for (const auto& plaintext : plaintexts) {
+		buffers.emplace_back(plaintext.size() + DataPacketCryptoSession::kTagSize);
+	}
+	for (std::size_t index = 0; index < packets.size(); ++index) {
+		packets[index].input = plaintexts[index];
+		packets[index].output = buffers[index];
+	}
+	ASSERT_EQ(session.Encrypt("alice", 0, packets), packets.size());
+	EXPECT_NE(packets[0].iv, packets[2].iv);
+
+	for (std::size_t index = 0; index < packets.size(); ++index) {
+		ASSERT_TRUE(packets[index].ok);
+		auto decrypted = cryptor->Decrypt(
+		    "alice", webrtc::make_ref_counted<webrtc::EncryptedPacket>(
+		                 std::vector<std::uint8_t>(buffers[index].begin(),
+		                                           buffers[index].begin() + packets[index].size),
+		                 std::vector<std::uint8_t>(packets[index].iv.begin(),
+		                                           packets[index].iv.end()),
+		                 static_cast<std::uint8_t>(packets[index].key_index)));
+		ASSERT_TRUE(decrypted.ok());
+		EXPECT_EQ(decrypted.value(), plaintexts[index]);
+	}
+
+	// And back, opening in place.
+	auto encrypted = cryptor->Encrypt("alice", 0, plaintexts[2]);
+	ASSERT_TRUE(encrypted.ok());
+	auto sealed = encrypted.value()->data;
+	DataPacketCryptoSession::Packet packet;
+	packet.input = sealed;
+	packet.output = sealed;
+	std::copy(encrypted.value()->iv.begin(), encrypted.value()->iv.end(), packet.iv.begin());
+	ASSERT_EQ(session.Decrypt("alice", {&packet, 1}), 1u);
+	EXPECT_EQ(std::vector<std::uint8_t>(sealed.begin(), sealed.begin() + packet.size),
+	          plaintexts[2]);
+}
+
+TEST(E2EEManagerTest, ManagerDecryptsBatchesPacketByPacket) {
+	E2EEManager manager;
+	ASSERT_TRUE(manager.Keys().SetSharedKey({2, 7, 1, 8}).Ok());
+	const std::vector<std::uint8_t> plaintext{11, 12, 13, 14};
+	std::vector<std::vector<std::uint8_t>> buffers(
+	    3, std::vector<std::uint8_t>(plaintext.size() + DataPacketCryptoSession::kTagSize));
+	std::vector<DataPacketCryptoSession::Packet> packets(buffers.size());
+	for (std::size_t index = 0; index < packets.size(); ++index) {
+		packets[index].input = plaintext;
+		packets[index].output = buffers[index];
+	}
+	ASSERT_EQ(E2EEManagerNativeAccess::EncryptData(manager, "alice", packets), 3u);
+
+	std::vector<std::vector<std::uint8_t>> opened(
+	    buffers.size(), std::vector<std::uint8_t>(plaintext.size()));
+	for (std::size_t index = 0; index < packets.size(); ++index) {
+		packets[index].input = buffers[index];
+		packets[index].output = opened[index];
+	}
+	// A tampered packet and one naming an empty key slot fail without failing the batch.
+	buffers[1][0] ^= 1;
+	packets[2].key_index = 5;
+	EXPECT_EQ(E2EEManagerNativeAccess::DecryptData(manager, "alice", packets), 1u);
+	EXPECT_TRUE(packets[0].ok);
+	EXPECT_EQ(opened[0], plaintext);
+	EXPECT_FALSE(packets[1].ok);
+	EXPECT_FALSE(packets[2].ok);
+
+	ASSERT_TRUE(manager.SetEnabled(false));
+	packets[2].key_index = 0;
+	EXPECT_EQ(E2EEManagerNativeAccess::DecryptData(manager, "alice", packets), 0u);
+}
+
 TEST(E2EEManagerTest, NativeEncodedAudioFrameRoundTripsWithSframeTrailer) {
 	KeyProvider provider;
 	ASSERT_TRUE(provider.SetSharedKey({0, 1, 2, 3, 4, 5, 6, 7}).Ok());
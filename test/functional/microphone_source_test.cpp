@@ -1,9 +1,17 @@
+#include "audio_source.h"
 #include "microphone_audio_source.h"
 
 #include "livekit/core/livekit_client.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace livekit::core {
 namespace {
 
@@ -31,11 +39,63 @@ TEST(MicrophoneSourceTest, ValidatesAndRetainsRuntimeVolume) {
 		EXPECT_FALSE(processing.noise_suppression);
 		const auto stats = source.ProcessingStats();
 		EXPECT_FALSE(stats.echo_cancellation_enabled);
+		EXPECT_FALSE(stats.echo_reference_attached);
 		EXPECT_EQ(stats.capture_processing_errors, 0u);
 		EXPECT_EQ(stats.render_processing_errors, 0u);
 	}
 	EXPECT_TRUE(Destroy());
 }
 
+class RecordingAudioSink final : public webrtc::AudioTrackSinkInterface {
+public:
+	void OnData(const void* audio_data, int, int, size_t, size_t number_of_frames) override {
+		const auto* samples = static_cast<const int16_t*>(audio_data);
+		std::lock_guard<std::mutex> guard(mutex_);
+		first_samples_.push_back(number_of_frames > 0 ? samples[0] : 0);
+		received_.notify_all();
+	}
+
+	bool WaitForSample(int16_t value, std::chrono::milliseconds timeout) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		return received_.wait_for(lock, timeout, [&] {
+			return std::find(first_samples_.begin(), first_samples_.end(), value) !=
+			       first_samples_.end();
+		});
+	}
+
+	std::vector<int16_t> FirstSamples() {
+		std::lock_guard<std::mutex> guard(mutex_);
+		return first_samples_;
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable received_;
+	std::vector<int16_t> first_samples_;
+};
+
+TEST(AudioSourceQueueTest, ClearDropsOnlyAudioCapturedBeforeIt) {
+	ASSERT_TRUE(Init());
+	{
+		std::unique_ptr<AudioSource> source(AudioSource::Create({}, 48000, 1, 200));
+		RecordingAudioSink sink;
+		source->Get()->AddSink(&sink);
+		const std::vector<int16_t> before(480, 1);
+		const std::vector<int16_t> after(480, 2);
+		for (int frame = 0; frame < 10; ++frame) {
+			ASSERT_TRUE(source->CaptureFrame(const_cast<int16_t*>(before.data()), 48000, 1, 480));
+		}
+		source->ClearBuffer();
+		ASSERT_TRUE(source->CaptureFrame(const_cast<int16_t*>(after.data()), 48000, 1, 480));
+
+		EXPECT_TRUE(sink.WaitForSample(2, std::chrono::seconds(2)));
+		// Only frames delivered before the clear was requested may predate it.
+		const auto samples = sink.FirstSamples();
+		EXPECT_LT(std::count(samples.begin(), samples.end(), int16_t{1}), 10);
+		source->Get()->RemoveSink(&sink);
+	}
+	EXPECT_TRUE(Destroy());
+}
+
 } // namespace
 } // namespace livekit::core
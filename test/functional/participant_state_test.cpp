@@ -6,10 +6,20 @@
 #include "../../src/core/track/track_publication.h"
 #include "data_stream_compression.h"
 
+#include "api/make_ref_counted.h"
+#include "api/media_stream_track.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
 #include "livekit_models.pb.h"
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
 namespace livekit::core {
 namespace {
 
@@ -204,6 +214,7 @@ TEST(RoomStateTest, ReportsRecordingChangesOnlyWhenStateTransitions) {
 	livekit::Room update;
 	update.set_metadata("room metadata");
 	room.RoomUpdateEvent(update);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.metadata_change_count, 1);
 	EXPECT_EQ(events.last_metadata, "room metadata");
 	EXPECT_TRUE(events.recording_states.empty());
@@ -211,20 +222,107 @@ TEST(RoomStateTest, ReportsRecordingChangesOnlyWhenStateTransitions) {
 
 	update.set_active_recording(true);
 	room.RoomUpdateEvent(update);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.recording_states.size(), 1u);
 	EXPECT_TRUE(events.recording_states[0]);
 	EXPECT_TRUE(room.IsRecording());
 
 	room.RoomUpdateEvent(update);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.recording_states.size(), 1u);
 	update.set_active_recording(false);
 	room.RoomUpdateEvent(update);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.recording_states.size(), 2u);
 	EXPECT_FALSE(events.recording_states[1]);
 	EXPECT_FALSE(room.IsRecording());
 	room.RemoveEventListener();
 }
 
+class DispatchedRoomEvents final : public RoomEventInterface {
+public:
+	void OnConnected() override {}
+	void OnRoomMetadataChanged(const std::string& metadata) override {
+		thread = std::this_thread::get_id();
+		delivered.set_value(metadata);
+	}
+
+	std::thread::id thread;
+	std::promise<std::string> delivered;
+};
+
+TEST(RoomStateTest, DeliversListenerEventsOnTheDispatchThread) {
+	Room room;
+	DispatchedRoomEvents events;
+	room.AddEventListener(&events);
+	auto delivered = events.delivered.get_future();
+	livekit::Room update;
+	update.set_metadata("dispatched metadata");
+	room.RoomUpdateEvent(update);
+	ASSERT_EQ(delivered.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+	EXPECT_EQ(delivered.get(), "dispatched metadata");
+	room.RemoveEventListener();
+	EXPECT_NE(events.thread, std::this_thread::get_id());
+	const auto stats = room.GetEventDispatchStats();
+	EXPECT_EQ(stats.connection.dispatched, 1u);
+	EXPECT_EQ(stats.connection.depth, 0u);
+}
+
+class BlockingParticipantEvents final : public RoomEventInterface {
+public:
+	void OnConnected() override {}
+	void OnRoomMetadataChanged(const std::string&) override {
+		entered.set_value();
+		released.wait();
+	}
+	void OnParticipantConnected(RemoteParticipantInterface* participant) override {
+		connected.push_back(participant->Identity());
+	}
+	void OnParticipantDisconnected(RemoteParticipantInterface* participant) override {
+		disconnected.push_back(participant->Identity());
+	}
+
+	std::promise<void> entered;
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	std::vector<std::string> connected;
+	std::vector<std::string> disconnected;
+};
+
+TEST(RoomStateTest, KeepsParticipantEventsWhenTheConnectionQueueIsFull) {
+	auto options = default_room_options();
+	options.event_dispatch.connection.capacity = 1;
+	Room room(options);
+	BlockingParticipantEvents events;
+	room.AddEventListener(&events);
+	livekit::Room update;
+	update.set_metadata("hold the dispatch thread");
+	room.RoomUpdateEvent(update);
+	ASSERT_EQ(events.entered.get_future().wait_for(std::chrono::seconds(2)),
+	          std::future_status::ready);
+
+	std::vector<std::string> identities;
+	for (int index = 0; index < 8; ++index) {
+		livekit::ParticipantInfo info;
+		info.set_sid("PA_" + std::to_string(index));
+		info.set_identity("participant-" + std::to_string(index));
+		room.ParticipantUpdateEvent({info});
+		identities.push_back(info.identity());
+		info.set_state(livekit::ParticipantInfo_State_DISCONNECTED);
+		room.ParticipantUpdateEvent({info});
+	}
+	EXPECT_EQ(room.GetEventDispatchStats().connection.depth, 16u);
+	events.release.set_value();
+	room.FlushEventsForTesting();
+
+	EXPECT_EQ(events.connected, identities);
+	EXPECT_EQ(events.disconnected, identities);
+	const auto stats = room.GetEventDispatchStats();
+	EXPECT_EQ(stats.connection.dropped, 0u);
+	EXPECT_EQ(stats.connection.max_depth, 16u);
+	room.RemoveEventListener();
+}
+
 class SubscriptionPermissionEvents final : public RoomEventInterface {
 public:
 	void OnConnected() override {}
@@ -270,6 +368,7 @@ TEST(ParticipantStateTest, ReportsCompleteParticipantPermissionChanges) {
 	info.mutable_permission()->set_can_publish_data(true);
 	info.mutable_permission()->add_can_publish_sources(livekit::TrackSource::MICROPHONE);
 	room.ParticipantUpdateEvent({info});
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.count, 0);
 	auto* participant = room.GetRemoteParticipantBySid("PA_permissions");
 	ASSERT_NE(participant, nullptr);
@@ -290,6 +389,7 @@ TEST(ParticipantStateTest, ReportsCompleteParticipantPermissionChanges) {
 	permission->set_can_subscribe_metrics(true);
 	permission->set_can_manage_agent_session(true);
 	room.ParticipantUpdateEvent({info});
+	room.FlushEventsForTesting();
 
 	EXPECT_EQ(events.count, 1);
 	EXPECT_EQ(events.participant_identity, "permissions-user");
@@ -308,6 +408,7 @@ TEST(ParticipantStateTest, ReportsCompleteParticipantPermissionChanges) {
 	EXPECT_TRUE(events.current.can_manage_agent_session);
 
 	room.ParticipantUpdateEvent({info});
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.count, 1);
 	room.RemoveEventListener();
 }
@@ -333,15 +434,18 @@ TEST(ParticipantStateTest, AppliesSubscriptionPermissionUpdates) {
 	denied.set_track_sid("TR_video");
 	denied.set_allowed(false);
 	room.SubscriptionPermissionUpdateEvent(denied);
+	room.FlushEventsForTesting();
 	EXPECT_FALSE(publication->IsSubscriptionAllowed());
 	EXPECT_EQ(events.count, 1);
 	EXPECT_EQ(events.track_sid, "TR_video");
 	EXPECT_FALSE(events.last_allowed);
 
 	room.SubscriptionPermissionUpdateEvent(denied);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.count, 1);
 	denied.set_allowed(true);
 	room.SubscriptionPermissionUpdateEvent(denied);
+	room.FlushEventsForTesting();
 	EXPECT_TRUE(publication->IsSubscriptionAllowed());
 	EXPECT_EQ(events.count, 2);
 	EXPECT_TRUE(events.last_allowed);
@@ -384,6 +488,7 @@ TEST(ParticipantStateTest, ReportsAndRetainsSubscriptionFailures) {
 	response.set_track_sid("TR_video");
 	response.set_err(livekit::SE_CODEC_UNSUPPORTED);
 	room.SubscriptionErrorEvent(response);
+	room.FlushEventsForTesting();
 
 	ASSERT_TRUE(publication->LastSubscriptionError().has_value());
 	EXPECT_EQ(*publication->LastSubscriptionError(), SubscriptionError::CodecUnsupported);
@@ -395,6 +500,7 @@ TEST(ParticipantStateTest, ReportsAndRetainsSubscriptionFailures) {
 	response.set_track_sid("TR_missing");
 	response.set_err(livekit::SE_TRACK_NOTFOUND);
 	room.SubscriptionErrorEvent(response);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.count, 1);
 	room.RemoveEventListener();
 }
@@ -568,11 +674,13 @@ TEST(RoomConnectionStateTest, TransitionsThroughSuccessfulReconnect) {
 	ConnectionEvents events;
 	room.AddEventListener(&events);
 	room.ConnectedEvent({});
+	room.FlushEventsForTesting();
 	ASSERT_EQ(room.State(), RoomInterface::RoomState::Connected);
 	ASSERT_EQ(events.states.size(), 1u);
 	EXPECT_EQ(events.states[0], RoomState::Connected);
 
 	room.ReconnectingEvent(false);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(room.State(), RoomInterface::RoomState::Reconnecting);
 	EXPECT_FALSE(room.IsConnected());
 	EXPECT_EQ(events.reconnecting_count, 1);
@@ -580,6 +688,7 @@ TEST(RoomConnectionStateTest, TransitionsThroughSuccessfulReconnect) {
 	EXPECT_EQ(events.states[1], RoomState::Reconnecting);
 
 	room.ResumedEvent();
+	room.FlushEventsForTesting();
 	EXPECT_EQ(room.State(), RoomInterface::RoomState::Connected);
 	EXPECT_TRUE(room.IsConnected());
 	EXPECT_EQ(events.reconnected_count, 1);
@@ -587,6 +696,7 @@ TEST(RoomConnectionStateTest, TransitionsThroughSuccessfulReconnect) {
 	EXPECT_EQ(events.states[2], RoomState::Connected);
 
 	EXPECT_TRUE(room.Disconnect());
+	room.FlushEventsForTesting();
 	EXPECT_EQ(room.LastDisconnectReason(), DisconnectReason::ClientInitiated);
 	ASSERT_EQ(events.states.size(), 5u);
 	EXPECT_EQ(events.states[3], RoomState::Disconnecting);
@@ -603,6 +713,7 @@ TEST(RoomConnectionStateTest, DoesNotDuplicateEventWhenResumeEscalatesToFullReco
 	room.ReconnectingEvent(false);
 	room.ReconnectingEvent(true);
 	room.ReconnectingEvent(true);
+	room.FlushEventsForTesting();
 
 	EXPECT_EQ(room.State(), RoomInterface::RoomState::Reconnecting);
 	EXPECT_EQ(events.reconnecting_count, 1);
@@ -610,6 +721,7 @@ TEST(RoomConnectionStateTest, DoesNotDuplicateEventWhenResumeEscalatesToFullReco
 	EXPECT_EQ(events.states[1], RoomState::Reconnecting);
 
 	room.ResumedEvent();
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.reconnected_count, 1);
 	room.RemoveEventListener();
 }
@@ -619,9 +731,11 @@ TEST(RoomConnectionStateTest, ReportsUnexpectedSignalCloseOnlyOnce) {
 	ConnectionEvents events;
 	room.AddEventListener(&events);
 	room.ConnectedEvent({});
+	room.FlushEventsForTesting();
 	ASSERT_EQ(room.State(), RoomInterface::RoomState::Connected);
 
 	room.SignalDisconnectedEvent(livekit::DisconnectReason::SIGNAL_CLOSE);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(room.State(), RoomInterface::RoomState::Failed);
 	EXPECT_FALSE(room.IsConnected());
 	EXPECT_EQ(events.disconnected_count, 1);
@@ -631,8 +745,10 @@ TEST(RoomConnectionStateTest, ReportsUnexpectedSignalCloseOnlyOnce) {
 	EXPECT_EQ(events.states[1], RoomState::Failed);
 
 	room.SignalDisconnectedEvent(livekit::DisconnectReason::SIGNAL_CLOSE);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.disconnected_count, 1);
 	EXPECT_TRUE(room.Disconnect());
+	room.FlushEventsForTesting();
 	EXPECT_EQ(room.State(), RoomInterface::RoomState::Disconnected);
 	EXPECT_EQ(events.disconnected_count, 1);
 	ASSERT_EQ(events.states.size(), 4u);
@@ -648,16 +764,195 @@ TEST(RoomConnectionStateTest, PreservesDetailedServerDisconnectReason) {
 	room.ConnectedEvent({});
 
 	room.SignalDisconnectedEvent(livekit::DisconnectReason::PARTICIPANT_REMOVED);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(room.State(), RoomInterface::RoomState::Failed);
 	EXPECT_EQ(room.LastDisconnectReason(), DisconnectReason::ParticipantRemoved);
 	EXPECT_EQ(events.disconnected_count, 1);
 	EXPECT_EQ(events.disconnect_reason, DisconnectReason::ParticipantRemoved);
 
 	EXPECT_TRUE(room.Disconnect());
+	room.FlushEventsForTesting();
 	EXPECT_EQ(room.LastDisconnectReason(), DisconnectReason::ParticipantRemoved);
 	room.RemoveEventListener();
 }
 
+class FakeAudioTrack : public webrtc::MediaStreamTrack<webrtc::AudioTrackInterface> {
+public:
+	explicit FakeAudioTrack(const std::string& id) : MediaStreamTrack(id) {}
+
+	std::string kind() const override { return kAudioKind; }
+	webrtc::AudioSourceInterface* GetSource() const override { return nullptr; }
+	void AddSink(webrtc::AudioTrackSinkInterface* sink) override {
+		std::lock_guard<std::mutex> guard(mutex_);
+		sinks_.insert(sink);
+	}
+	void RemoveSink(webrtc::AudioTrackSinkInterface* sink) override {
+		std::lock_guard<std::mutex> guard(mutex_);
+		sinks_.erase(sink);
+	}
+
+	size_t SinkCount() const {
+		std::lock_guard<std::mutex> guard(mutex_);
+		return sinks_.size();
+	}
+
+private:
+	mutable std::mutex mutex_;
+	std::set<webrtc::AudioTrackSinkInterface*> sinks_;
+};
+
+webrtc::scoped_refptr<FakeAudioTrack> SubscribeAudioTrack(Room& room, const std::string& sid) {
+	livekit::ParticipantInfo info;
+	info.set_sid("PA_remote");
+	info.set_identity("remote");
+	*info.add_tracks() = MakeTrack(sid, "microphone", livekit::TrackType::AUDIO,
+	                               livekit::TrackSource::MICROPHONE, false);
+	room.ParticipantUpdateEvent({info});
+	auto track = webrtc::make_ref_counted<FakeAudioTrack>(sid);
+	room.MediaTrackEvent(track, nullptr, {});
+	return track;
+}
+
+TEST(RemoteTrackConsumerTest, MixerReleasesTracksOnDisconnectAndTakesTheResubscription) {
+	auto mixer = std::shared_ptr<AudioMixerInterface>();
+	webrtc::scoped_refptr<FakeAudioTrack> resubscribed;
+	{
+		Room room;
+		mixer = room.CreateAudioMixer();
+		ASSERT_NE(mixer, nullptr);
+		room.ConnectedEvent({});
+		auto track = SubscribeAudioTrack(room, "TR_audio");
+		EXPECT_EQ(mixer->Stats().track_count, 1u);
+
+		ASSERT_TRUE(room.Disconnect());
+		EXPECT_EQ(mixer->Stats().track_count, 0u);
+		EXPECT_EQ(track->SinkCount(), 0u);
+
+		resubscribed = SubscribeAudioTrack(room, "TR_audio");
+		EXPECT_EQ(mixer->Stats().track_count, 1u);
+		EXPECT_GT(resubscribed->SinkCount(), 0u);
+	}
+	// The mixer outlives the room but must not keep its sink on the track.
+	EXPECT_EQ(mixer->Stats().track_count, 0u);
+	EXPECT_EQ(resubscribed->SinkCount(), 0u);
+}
+
+TEST(RemoteTrackConsumerTest, UnblocksFrameStreamReadersOnDisconnect) {
+	Room room;
+	room.ConnectedEvent({});
+	auto track = SubscribeAudioTrack(room, "TR_audio");
+	auto stream = room.CreateAudioStream("TR_audio");
+	ASSERT_NE(stream, nullptr);
+
+	auto read = std::async(std::launch::async, [&] {
+		AudioFrame frame;
+		return stream->Read(frame, kFrameStreamWaitForever);
+	});
+	ASSERT_TRUE(room.Disconnect());
+	ASSERT_EQ(read.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_FALSE(read.get());
+}
+
+class FakeVideoTrack : public webrtc::MediaStreamTrack<webrtc::VideoTrackInterface> {
+public:
+	explicit FakeVideoTrack(const std::string& id) : MediaStreamTrack(id) {}
+
+	std::string kind() const override { return kVideoKind; }
+	webrtc::VideoTrackSourceInterface* GetSource() const override { return nullptr; }
+	void AddOrUpdateSink(webrtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
+	                     const webrtc::VideoSinkWants&) override {
+		std::lock_guard<std::mutex> guard(mutex_);
+		sinks_.insert(sink);
+	}
+	void RemoveSink(webrtc::VideoSinkInterface<webrtc::VideoFrame>* sink) override {
+		std::lock_guard<std::mutex> guard(mutex_);
+		sinks_.erase(sink);
+	}
+
+	// Delivers frame the way a decoder does, on the calling thread.
+	void Deliver(const webrtc::VideoFrame& frame) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (auto* sink : sinks_) {
+			sink->OnFrame(frame);
+		}
+	}
+
+private:
+	std::mutex mutex_;
+	std::set<webrtc::VideoSinkInterface<webrtc::VideoFrame>*> sinks_;
+};
+
+class VideoBufferEvents final : public RoomEventInterface {
+public:
+	void OnConnected() override {}
+	void OnVideoFrame(RemoteTrackInterface*, RemoteParticipantInterface*,
+	                  const VideoFrame&) override {
+		++packed_frames;
+	}
+	void OnVideoFrameBuffer(RemoteTrackInterface* track, RemoteParticipantInterface* participant,
+	                        const VideoFrameBuffer& frame) override {
+		track_sid = track->Sid();
+		participant_identity = participant->Identity();
+		frames.push_back(frame);
+	}
+
+	int packed_frames = 0;
+	std::string track_sid;
+	std::string participant_identity;
+	std::vector<VideoFrameBuffer> frames;
+};
+
+TEST(RemoteTrackConsumerTest, DeliversDecodedPlanesWithoutCopying) {
+	auto options = default_room_options();
+	options.video_frame_delivery = VideoFrameDelivery::Buffer;
+	Room room(options);
+	VideoBufferEvents events;
+	room.AddEventListener(&events);
+	room.ConnectedEvent({});
+	livekit::ParticipantInfo info;
+	info.set_sid("PA_remote");
+	info.set_identity("remote");
+	*info.add_tracks() = MakeTrack("TR_video", "camera", livekit::TrackType::VIDEO,
+	                               livekit::TrackSource::CAMERA, false);
+	room.ParticipantUpdateEvent({info});
+	auto track = webrtc::make_ref_counted<FakeVideoTrack>("TR_video");
+	room.MediaTrackEvent(track, nullptr, {});
+
+	// Odd dimensions and padded strides, so the consumer must not assume packed planes.
+	auto decoded = webrtc::I420Buffer::Create(33, 17, 48, 24, 32);
+	webrtc::I420Buffer::SetBlack(decoded.get());
+	track->Deliver(webrtc::VideoFrame::Builder()
+	                   .set_video_frame_buffer(decoded)
+	                   .set_timestamp_us(123456)
+	                   .set_rotation(webrtc::kVideoRotation_90)
+	                   .build());
+
+	ASSERT_EQ(events.frames.size(), 1u);
+	EXPECT_EQ(events.packed_frames, 0);
+	EXPECT_EQ(events.track_sid, "TR_video");
+	EXPECT_EQ(events.participant_identity, "remote");
+	const auto& frame = events.frames.front();
+	ASSERT_NE(frame.buffer, nullptr);
+	EXPECT_EQ(frame.buffer->Width(), 33u);
+	EXPECT_EQ(frame.buffer->Height(), 17u);
+	EXPECT_EQ(frame.buffer->ChromaWidth(), 17u);
+	EXPECT_EQ(frame.buffer->ChromaHeight(), 9u);
+	EXPECT_EQ(frame.buffer->DataY(), decoded->DataY());
+	EXPECT_EQ(frame.buffer->DataU(), decoded->DataU());
+	EXPECT_EQ(frame.buffer->DataV(), decoded->DataV());
+	EXPECT_EQ(frame.buffer->StrideY(), 48);
+	EXPECT_EQ(frame.buffer->StrideU(), 24);
+	EXPECT_EQ(frame.buffer->StrideV(), 32);
+	EXPECT_EQ(frame.timestamp_us, 123456);
+	EXPECT_EQ(frame.rotation, VideoRotation::Rotation90);
+
+	// The consumer's copy keeps the decoder's planes alive once the decoder lets go of them.
+	decoded = nullptr;
+	room.RemoveEventListener();
+	EXPECT_EQ(frame.buffer->DataY()[0], 0);
+	EXPECT_EQ(frame.buffer->DataU()[frame.buffer->StrideU() * 8 + 16], 128);
+}
+
 class DataStreamEvents final : public RoomEventInterface {
 public:
 	void OnConnected() override {}
@@ -743,6 +1038,7 @@ TEST(DataStreamStateTest, ReassemblesTextAndByteStreams) {
 	room.DataPacketEvent(StreamChunk("text-1", 0, "hello "));
 	room.DataPacketEvent(StreamChunk("text-1", 1, "world"));
 	room.DataPacketEvent(StreamTrailer("text-1"));
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.texts.size(), 1u);
 	EXPECT_EQ(events.texts[0].text, "hello world");
 	EXPECT_EQ(events.texts[0].reply_to_stream_id, "parent");
@@ -757,6 +1053,7 @@ TEST(DataStreamStateTest, ReassemblesTextAndByteStreams) {
 	room.DataPacketEvent(bytes_header);
 	room.DataPacketEvent(StreamChunk("bytes-1", 0, "data"));
 	room.DataPacketEvent(StreamTrailer("bytes-1"));
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.bytes.size(), 1u);
 	EXPECT_EQ(events.bytes[0].data, std::vector<uint8_t>({'d', 'a', 't', 'a'}));
 	EXPECT_TRUE(events.files.empty());
@@ -768,6 +1065,7 @@ TEST(DataStreamStateTest, ReassemblesTextAndByteStreams) {
 	auto file_trailer = StreamTrailer("file-1");
 	(*file_trailer.mutable_stream_trailer()->mutable_attributes())["complete"] = "true";
 	room.DataPacketEvent(file_trailer);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.bytes.size(), 2u);
 	ASSERT_EQ(events.files.size(), 1u);
 	EXPECT_EQ(events.files[0].name, "test.bin");
@@ -776,6 +1074,35 @@ TEST(DataStreamStateTest, ReassemblesTextAndByteStreams) {
 	room.RemoveEventListener();
 }
 
+TEST(DataStreamStateTest, SpillsBufferedStreamsOffTheDataChannelThread) {
+	auto options = default_room_options();
+	options.data_stream_spill_threshold = 4;
+	Room room(options);
+	DataStreamEvents events;
+	room.AddEventListener(&events);
+
+	auto header = StreamHeader("spilled", 12);
+	header.mutable_stream_header()->mutable_byte_header()->set_name("spilled.bin");
+	room.DataPacketEvent(header);
+	room.DataPacketEvent(StreamChunk("spilled", 0, "abcd"));
+	room.DataPacketEvent(StreamChunk("spilled", 1, "efgh"));
+	room.DataPacketEvent(StreamChunk("spilled", 2, "ijkl"));
+	room.FlushEventsForTesting();
+	auto streams = room.IncomingDataStreams();
+	ASSERT_EQ(streams.size(), 1u);
+	EXPECT_EQ(streams[0].received_bytes, 12u);
+	EXPECT_EQ(streams[0].queued_bytes, 0u);
+	EXPECT_GT(streams[0].spilled_bytes, 0u);
+
+	room.DataPacketEvent(StreamTrailer("spilled"));
+	room.FlushEventsForTesting();
+	EXPECT_TRUE(room.IncomingDataStreams().empty());
+	ASSERT_EQ(events.files.size(), 1u);
+	EXPECT_EQ(std::string(events.files[0].data.begin(), events.files[0].data.end()),
+	          "abcdefghijkl");
+	room.RemoveEventListener();
+}
+
 TEST(DataStreamStateTest, HandlesInlineStreamsAndRejectsInvalidChunks) {
 	Room room;
 	DataStreamEvents events;
@@ -785,6 +1112,7 @@ TEST(DataStreamStateTest, HandlesInlineStreamsAndRejectsInvalidChunks) {
 	inline_text.mutable_stream_header()->mutable_text_header();
 	inline_text.mutable_stream_header()->set_inline_content("hello");
 	room.DataPacketEvent(inline_text);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.texts.size(), 1u);
 	EXPECT_EQ(events.texts[0].text, "hello");
 
@@ -793,6 +1121,7 @@ TEST(DataStreamStateTest, HandlesInlineStreamsAndRejectsInvalidChunks) {
 	room.DataPacketEvent(invalid);
 	room.DataPacketEvent(StreamChunk("invalid", 1, "bad"));
 	room.DataPacketEvent(StreamTrailer("invalid"));
+	room.FlushEventsForTesting();
 	EXPECT_TRUE(events.bytes.empty());
 	EXPECT_TRUE(events.files.empty());
 	room.RemoveEventListener();
@@ -818,6 +1147,7 @@ TEST(DataStreamStateTest, DecompressesRawDeflateStreamsAndRejectsInvalidPayloads
 	room.DataPacketEvent(StreamChunk("compressed-text", 0, compressed_text.substr(0, split)));
 	room.DataPacketEvent(StreamChunk("compressed-text", 1, compressed_text.substr(split)));
 	room.DataPacketEvent(StreamTrailer("compressed-text"));
+	room.FlushEventsForTesting();
 	ASSERT_GE(failed_events.size(), 4u);
 	std::string received_text;
 	for (const auto& event : failed_events) {
@@ -836,6 +1166,7 @@ TEST(DataStreamStateTest, DecompressesRawDeflateStreamsAndRejectsInvalidPayloads
 	    livekit::DataStream_CompressionType_DEFLATE_RAW);
 	inline_bytes.mutable_stream_header()->set_inline_content(DeflateRaw(bytes));
 	room.DataPacketEvent(inline_bytes);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.bytes.size(), 1u);
 	EXPECT_EQ(events.bytes[0].data, std::vector<uint8_t>(bytes.begin(), bytes.end()));
 
@@ -852,6 +1183,7 @@ TEST(DataStreamStateTest, DecompressesRawDeflateStreamsAndRejectsInvalidPayloads
 	js_header.mutable_stream_header()->set_inline_content(js_deflate_payload,
 	                                                      sizeof(js_deflate_payload));
 	room.DataPacketEvent(js_header);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.texts.size(), 1u);
 	EXPECT_EQ(events.texts[0].text, "LiveKit deflate interoperability");
 
@@ -864,6 +1196,7 @@ TEST(DataStreamStateTest, DecompressesRawDeflateStreamsAndRejectsInvalidPayloads
 	room.DataPacketEvent(invalid_header);
 	room.DataPacketEvent(StreamChunk("invalid-compressed", 0, "not deflate"));
 	room.DataPacketEvent(StreamTrailer("invalid-compressed"));
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.texts.size(), 1u);
 	ASSERT_GE(failed_events.size(), 2u);
 	EXPECT_EQ(failed_events.back().type, DataStreamEventType::Failed);
@@ -877,6 +1210,7 @@ TEST(DataStreamStateTest, DecompressesRawDeflateStreamsAndRejectsInvalidPayloads
 	room.DataPacketEvent(oversized);
 	room.DataPacketEvent(StreamChunk("oversized-compressed", 0, DeflateRaw("ignored")));
 	room.DataPacketEvent(StreamTrailer("oversized-compressed"));
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.bytes.size(), 1u);
 
 	detail::InflateRawStream limited_inflater(1024);
@@ -904,6 +1238,7 @@ TEST(DataStreamStateTest, DispatchesRegisteredTopicsIncrementallyWithoutLegacyBu
 	room.DataPacketEvent(StreamChunk("incremental-text", 0, "hello "));
 	room.DataPacketEvent(StreamChunk("incremental-text", 1, "world"));
 	room.DataPacketEvent(StreamTrailer("incremental-text"));
+	room.FlushEventsForTesting();
 	ASSERT_EQ(text_events.size(), 4u);
 	EXPECT_EQ(text_events[0].type, DataStreamEventType::Open);
 	EXPECT_EQ(text_events[0].info.participant_identity, "sender");
@@ -923,6 +1258,7 @@ TEST(DataStreamStateTest, DispatchesRegisteredTopicsIncrementallyWithoutLegacyBu
 	room.DataPacketEvent(bytes_header);
 	room.DataPacketEvent(StreamChunk("incremental-bytes", 0, "data"));
 	room.DataPacketEvent(FailedStreamTrailer("incremental-bytes", "sender cancelled"));
+	room.FlushEventsForTesting();
 	ASSERT_EQ(byte_events.size(), 3u);
 	EXPECT_EQ(byte_events[0].type, DataStreamEventType::Open);
 	EXPECT_EQ(byte_events[0].info.name, "payload.bin");
@@ -955,6 +1291,7 @@ TEST(DataStreamStateTest, ForwardsDataChannelBackpressureTransitions) {
 	DataStreamEvents events;
 	room.AddEventListener(&events);
 	room.DataChannelBufferStatusEvent({true, 4 * 1024 * 1024, 4 * 1024 * 1024, 1024 * 1024, true});
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.buffer_statuses.size(), 1u);
 	EXPECT_TRUE(events.buffer_statuses[0].reliable);
 	EXPECT_TRUE(events.buffer_statuses[0].backpressured);
@@ -971,6 +1308,7 @@ TEST(DataStreamStateTest, ForwardsSipDtmfPackets) {
 	packet.mutable_sip_dtmf()->set_code(11);
 	packet.mutable_sip_dtmf()->set_digit("#");
 	room.DataPacketEvent(packet);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.dtmf_events.size(), 1u);
 	EXPECT_EQ(events.dtmf_events[0].code, 11u);
 	EXPECT_EQ(events.dtmf_events[0].digit, "#");
@@ -991,6 +1329,7 @@ TEST(DataStreamStateTest, ForwardsStructuredChatMessages) {
 	chat->set_message("edited text");
 	chat->set_generated(true);
 	room.DataPacketEvent(packet);
+	room.FlushEventsForTesting();
 	ASSERT_EQ(events.chat_messages.size(), 1u);
 	EXPECT_EQ(events.chat_messages[0].id, "message-id");
 	EXPECT_EQ(events.chat_messages[0].timestamp, 1000);
@@ -1017,6 +1356,7 @@ TEST(DataStreamStateTest, TracksIncrementalTranscriptionSegments) {
 	partial_segment->set_start_time(100);
 	partial_segment->set_end_time(200);
 	room.DataPacketEvent(partial_packet);
+	room.FlushEventsForTesting();
 
 	ASSERT_EQ(events.transcriptions.size(), 1u);
 	ASSERT_EQ(events.transcriptions[0].segments.size(), 1u);
@@ -1044,6 +1384,7 @@ TEST(DataStreamStateTest, TracksIncrementalTranscriptionSegments) {
 	final_segment->set_end_time(250);
 	final_segment->set_final(true);
 	room.DataPacketEvent(final_packet);
+	room.FlushEventsForTesting();
 
 	ASSERT_EQ(events.transcriptions.size(), 2u);
 	ASSERT_EQ(events.transcriptions[1].segments.size(), 1u);
@@ -1088,6 +1429,7 @@ TEST(DataStreamStateTest, ForwardsStructuredMetricsBatches) {
 	metric_event->mutable_normalized_end_timestamp()->set_seconds(101);
 	metric_event->set_metadata("{\"reason\":\"test\"}");
 	room.DataPacketEvent(packet);
+	room.FlushEventsForTesting();
 
 	ASSERT_EQ(events.metrics.size(), 1u);
 	const auto& received = events.metrics[0];
@@ -1132,12 +1474,14 @@ TEST(LocalTrackStateTest, HandlesServerInitiatedUnpublishOnce) {
 	participant->AddTrackPublication(publication);
 
 	room.LocalTrackUnpublishedEvent("TR_local");
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.unpublished_count, 1);
 	EXPECT_EQ(events.track_sid, "TR_local");
 	EXPECT_TRUE(events.participant_is_local);
 	EXPECT_EQ(participant->GetTrackPublicationByName("camera"), nullptr);
 
 	room.LocalTrackUnpublishedEvent("TR_local");
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.unpublished_count, 1);
 	room.RemoveEventListener();
 }
@@ -1150,6 +1494,7 @@ TEST(LocalTrackStateTest, ForwardsFirstRemoteSubscriptionOnce) {
 	ASSERT_NE(participant, nullptr);
 
 	room.LocalTrackSubscribedEvent("TR_pending");
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.subscribed_count, 0);
 	livekit::TrackInfo info = MakeTrack("TR_local", "camera", livekit::TrackType::VIDEO,
 	                                    livekit::TrackSource::CAMERA, false);
@@ -1157,10 +1502,12 @@ TEST(LocalTrackStateTest, ForwardsFirstRemoteSubscriptionOnce) {
 	participant->AddTrackPublication(publication);
 
 	room.LocalTrackSubscribedEvent("TR_local");
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.subscribed_count, 1);
 	EXPECT_EQ(events.subscribed_track_sid, "TR_local");
 	EXPECT_TRUE(events.subscriber_event_is_local);
 	room.LocalTrackSubscribedEvent("TR_local");
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.subscribed_count, 1);
 	room.RemoveEventListener();
 }
@@ -1191,6 +1538,7 @@ TEST(LocalTrackStateTest, RetainsAndForwardsSubscribedQualityUpdates) {
 	high->set_quality(livekit::VideoQuality::HIGH);
 	high->set_enabled(true);
 	room.SubscribedQualityUpdateEvent(update);
+	room.FlushEventsForTesting();
 
 	EXPECT_EQ(events.quality_update_count, 1);
 	EXPECT_EQ(events.quality_track_sid, "TR_video");
@@ -1213,6 +1561,7 @@ TEST(LocalTrackStateTest, RetainsAndForwardsSubscribedQualityUpdates) {
 
 	update.set_track_sid("TR_unknown");
 	room.SubscribedQualityUpdateEvent(update);
+	room.FlushEventsForTesting();
 	EXPECT_EQ(events.quality_update_count, 1);
 	room.RemoveEventListener();
 }
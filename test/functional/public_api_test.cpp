@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -58,6 +59,49 @@ TEST(PublicApiTest, ProvidesConfigurableReconnectBounds) {
 	EXPECT_EQ(options.reconnect_policy->NextRetryDelay(context), std::chrono::milliseconds(300));
 }
 
+TEST(PublicApiTest, SharesProcessPeerFactoryWhileHeld) {
+	auto options = default_room_connect_options();
+	EXPECT_EQ(options.peer_factory, nullptr);
+
+	auto process = ProcessPeerFactory();
+	ASSERT_NE(process, nullptr);
+	EXPECT_EQ(ProcessPeerFactory(), process);
+	auto separate = CreatePeerFactory();
+	ASSERT_NE(separate, nullptr);
+	EXPECT_NE(separate, process);
+
+	const auto stats = process->GetStats();
+	EXPECT_EQ(stats.rooms, 0u);
+	EXPECT_GE(stats.threads, 3u);
+}
+
+TEST(PublicApiTest, RefusesPlayoutControlsOnSharedPeerFactory) {
+	EXPECT_FALSE(CreateRoomUnique()->SharesAudioDevice());
+
+	auto options = default_room_options();
+	options.peer_factory = CreatePeerFactory(AudioPlayout::Headless);
+	ASSERT_NE(options.peer_factory, nullptr);
+	auto room = CreateRoomUnique(options);
+	ASSERT_NE(room, nullptr);
+	EXPECT_TRUE(room->SharesAudioDevice());
+	EXPECT_FALSE(room->SetAudioOutputDevice("default"));
+	EXPECT_FALSE(room->SetSpeakerVolume(0.5F));
+	EXPECT_FALSE(room->SetSpeakerMuted(true));
+	EXPECT_FLOAT_EQ(room->SpeakerVolume(), 1.0F);
+	EXPECT_FALSE(room->SpeakerMuted());
+}
+
+TEST(PublicApiTest, CreatesHeadlessPeerFactory) {
+	auto options = default_room_connect_options();
+	EXPECT_EQ(options.audio_playout, AudioPlayout::Device);
+
+	auto headless = CreatePeerFactory(AudioPlayout::Headless);
+	ASSERT_NE(headless, nullptr);
+	const auto stats = headless->GetStats();
+	EXPECT_EQ(stats.rooms, 0u);
+	EXPECT_GE(stats.threads, 3u);
+}
+
 TEST(PublicApiTest, ExposesSemanticVersion) { EXPECT_EQ(Version(), "0.0.1"); }
 
 TEST(PublicApiTest, EnumeratesMediaDevicesWithoutChangingClientState) {
@@ -185,5 +229,44 @@ TEST(MediaSourceTest, AcceptsConsecutiveAudioFrames) {
 	EXPECT_TRUE(Destroy());
 }
 
+TEST(MediaSourceTest, ReportsAudioQueueOverruns) {
+	ASSERT_TRUE(Init());
+	auto source = CreateAudioSourceUnique({}, 48000, 1, 200);
+	ASSERT_NE(source, nullptr);
+	const auto initial = source->QueueStats();
+	// The queue holds twice the configured duration.
+	EXPECT_EQ(initial.capacity_samples, 19200u);
+	EXPECT_EQ(initial.overrun_frames, 0u);
+
+	std::vector<int16_t> samples(initial.capacity_samples + 1, 100);
+	EXPECT_FALSE(source->CaptureFrame(samples.data(), 48000, 1, initial.capacity_samples + 1));
+	EXPECT_TRUE(source->CaptureFrame(samples.data(), 48000, 1, 480));
+	const auto stats = source->QueueStats();
+	EXPECT_EQ(stats.overrun_frames, 1u);
+	EXPECT_LE(stats.queued_samples, 480u);
+	source.reset();
+	EXPECT_TRUE(Destroy());
+}
+
+TEST(MediaSourceTest, AcceptsAudioFramesFromConcurrentProducers) {
+	ASSERT_TRUE(Init());
+	// Large enough that neither producer overruns before the delivery task starts draining.
+	auto source = CreateAudioSourceUnique({}, 48000, 1, 1000);
+	ASSERT_NE(source, nullptr);
+	std::vector<int16_t> samples(480, 100);
+	auto produce = [&] {
+		for (int frame = 0; frame < 40; ++frame) {
+			EXPECT_TRUE(source->CaptureFrame(samples.data(), 48000, 1, 480));
+		}
+	};
+	std::thread first(produce);
+	std::thread second(produce);
+	first.join();
+	second.join();
+	EXPECT_EQ(source->QueueStats().overrun_frames, 0u);
+	source.reset();
+	EXPECT_TRUE(Destroy());
+}
+
 } // namespace
 } // namespace livekit::core
@@ -32,7 +32,7 @@ TEST(TrackStatsTest, NormalizesRtpStreamsAndReferencedStats) {
         {"id":"send","type":"outbound-rtp","kind":"video","rid":"h",
          "timestamp":1000,"bytesSent":12000,"packetsSent":120,"packetsLost":2,
          "frameWidth":1280,"frameHeight":720,"framesPerSecond":30,"framesSent":300,
-         "qpSum":400,"codecId":"codec","remoteId":"remote",
+         "qpSum":400,"totalEncodeTime":2.5,"codecId":"codec","remoteId":"remote",
          "encoderImplementation":"libvpx","qualityLimitationReason":"none"},
         {"id":"receive","type":"inbound-rtp","mediaType":"audio","timestamp":1000,
          "bytesReceived":5000,"packetsReceived":50,"packetsLost":-1,"jitter":0.003,
@@ -48,6 +48,7 @@ TEST(TrackStatsTest, NormalizesRtpStreamsAndReferencedStats) {
 	EXPECT_EQ(send.frame_width, 1280u);
 	EXPECT_EQ(send.codec_mime_type, "video/VP8");
 	EXPECT_EQ(send.codec_implementation, "libvpx");
+	EXPECT_DOUBLE_EQ(send.total_encode_time_seconds, 2.5);
 	ASSERT_TRUE(send.round_trip_time_seconds.has_value());
 	EXPECT_DOUBLE_EQ(*send.round_trip_time_seconds, 0.025);
 	ASSERT_TRUE(send.jitter_seconds.has_value());
@@ -118,6 +118,28 @@ TEST(VideoEncodingTest, NeverDisablesSingleEncodingOrMismatchedCodec) {
 	EXPECT_TRUE(simulcast[2].active);
 }
 
+TEST(VideoEncodingTest, SelectsLayersForPublishedCodecOnly) {
+	SubscribedQualityUpdate update;
+	update.qualities = {{VideoQuality::High, true}};
+	update.codecs = {{"video/H264", {{VideoQuality::High, false}}},
+	                 {"video/VP8", {{VideoQuality::Low, true}, {VideoQuality::High, false}}}};
+
+	const auto layers = SubscribedLayers(update, "VP8");
+	ASSERT_TRUE(layers.has_value());
+	EXPECT_EQ(layers->size(), 2u);
+	EXPECT_FALSE(layers->at(VideoQuality::High));
+	EXPECT_FALSE(SubscribedLayers(update, "AV1").has_value());
+
+	TrackPublishOptions options;
+	options.simulcast = true;
+	auto encodings = BuildVideoEncodingPlan(1280, 720, false, options).encodings;
+	EXPECT_TRUE(ApplyLayerActivation(encodings, *layers));
+	EXPECT_TRUE(encodings[0].active);
+	EXPECT_TRUE(encodings[1].active);
+	EXPECT_FALSE(encodings[2].active);
+	EXPECT_EQ(QualityForRid(encodings[2].rid), VideoQuality::High);
+}
+
 TEST(VideoEncodingTest, UsesSingleEncodingForSvcCodecsUntilSvcLayersAreSupported) {
 	for (const auto codec : {VideoCodec::VP9, VideoCodec::AV1}) {
 		TrackPublishOptions options;
@@ -1,5 +1,9 @@
 #include "video_frame_converter.h"
 
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "common_video/include/video_frame_buffer_pool.h"
+
 #include <gtest/gtest.h>
 
 #include <array>
@@ -30,5 +34,98 @@ TEST(VideoFrameConverterTest, RejectsInvalidBgraFrames) {
 	EXPECT_FALSE(ConvertBgraToI420(pixels.data(), 1, 1, 4, 0, frame));
 }
 
+TEST(VideoFrameConverterTest, ConvertsBgraFramesIntoPooledI420Buffers) {
+	const std::array<std::uint8_t, 24> pixels{
+	    0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255,
+	};
+	webrtc::VideoFrameBufferPool pool(false, 1);
+	auto buffer = ConvertBgraToPooledI420(pixels.data(), 3, 2, 12, pool);
+	ASSERT_NE(buffer, nullptr);
+	EXPECT_EQ(buffer->width(), 2);
+	EXPECT_EQ(buffer->height(), 2);
+	EXPECT_EQ(buffer->DataY()[0], 16U);
+	EXPECT_EQ(buffer->DataU()[0], 128U);
+	EXPECT_EQ(buffer->DataV()[0], 128U);
+
+	EXPECT_EQ(ConvertBgraToPooledI420(pixels.data(), 3, 2, 12, pool), nullptr);
+	const auto* recycled = buffer.get();
+	buffer = nullptr;
+	EXPECT_EQ(ConvertBgraToPooledI420(pixels.data(), 3, 2, 12, pool).get(), recycled);
+	EXPECT_EQ(ConvertBgraToPooledI420(nullptr, 2, 2, 8, pool), nullptr);
+}
+
+TEST(VideoFrameConverterTest, ConvertsNativeYuvFramesWithOneLibyuvPass) {
+	webrtc::VideoFrameBufferPool pool(false, 4);
+
+	OwnedVideoFrame i420;
+	i420.format = CapturePixelFormat::I420;
+	i420.width = 2;
+	i420.height = 2;
+	i420.row_stride_bytes = 2;
+	i420.data = {10, 20, 30, 40, 50, 60};
+	auto buffer = ConvertToPooledI420(i420, pool);
+	ASSERT_NE(buffer, nullptr);
+	EXPECT_EQ(buffer->DataY()[3], 40U);
+	EXPECT_EQ(buffer->DataU()[0], 50U);
+	EXPECT_EQ(buffer->DataV()[0], 60U);
+
+	OwnedVideoFrame nv12 = i420;
+	nv12.format = CapturePixelFormat::Nv12;
+	nv12.data = {10, 20, 30, 40, 50, 60};
+	buffer = ConvertToPooledI420(nv12, pool);
+	ASSERT_NE(buffer, nullptr);
+	EXPECT_EQ(buffer->DataU()[0], 50U);
+	EXPECT_EQ(buffer->DataV()[0], 60U);
+
+	OwnedVideoFrame yuy2 = i420;
+	yuy2.format = CapturePixelFormat::Yuy2;
+	yuy2.row_stride_bytes = 4;
+	yuy2.data = {10, 50, 20, 60, 30, 50, 40, 60};
+	buffer = ConvertToPooledI420(yuy2, pool);
+	ASSERT_NE(buffer, nullptr);
+	EXPECT_EQ(buffer->DataY()[0], 10U);
+	EXPECT_EQ(buffer->DataY()[3], 40U);
+	EXPECT_EQ(buffer->DataU()[0], 50U);
+	EXPECT_EQ(buffer->DataV()[0], 60U);
+
+	OwnedVideoFrame truncated = i420;
+	truncated.data.pop_back();
+	EXPECT_EQ(ConvertToPooledI420(truncated, pool), nullptr);
+	OwnedVideoFrame garbage = i420;
+	garbage.format = CapturePixelFormat::Mjpeg;
+	EXPECT_EQ(ConvertToPooledI420(garbage, pool), nullptr);
+}
+
+TEST(VideoFrameConverterTest, PassesNv12ThroughWithoutConversion) {
+	webrtc::VideoFrameBufferPool pool(false, 1);
+	OwnedVideoFrame frame;
+	frame.format = CapturePixelFormat::Nv12;
+	frame.width = 3;
+	frame.height = 2;
+	frame.row_stride_bytes = 4;
+	frame.data = {10, 20, 30, 0, 40, 50, 60, 0, 70, 80, 90, 0};
+	auto buffer = ConvertToPooledBuffer(frame, pool);
+	ASSERT_NE(buffer, nullptr);
+	ASSERT_EQ(buffer->type(), webrtc::VideoFrameBuffer::Type::kNV12);
+	const auto* nv12 = buffer->GetNV12();
+	EXPECT_EQ(nv12->width(), 2);
+	EXPECT_EQ(nv12->height(), 2);
+	EXPECT_EQ(nv12->DataY()[nv12->StrideY()], 40U);
+	EXPECT_EQ(nv12->DataUV()[0], 70U);
+	EXPECT_EQ(nv12->DataUV()[1], 80U);
+
+	frame.format = CapturePixelFormat::I420;
+	EXPECT_EQ(CopyToPooledNv12(frame, pool), nullptr);
+}
+
+TEST(VideoFrameConverterTest, MapsOnlyQuarterTurnRotations) {
+	EXPECT_EQ(ToVideoRotation(0), webrtc::kVideoRotation_0);
+	EXPECT_EQ(ToVideoRotation(90), webrtc::kVideoRotation_90);
+	EXPECT_EQ(ToVideoRotation(180), webrtc::kVideoRotation_180);
+	EXPECT_EQ(ToVideoRotation(270), webrtc::kVideoRotation_270);
+	EXPECT_FALSE(ToVideoRotation(45).has_value());
+	EXPECT_FALSE(ToVideoRotation(360).has_value());
+}
+
 } // namespace
 } // namespace livekit::capture
@@ -1450,6 +1450,7 @@ TEST(LiveKitServerTest, PublishesAndReceivesHardwareCapturedMedia) {
 	EXPECT_GT(screen_dimensions.height, 0u);
 	const auto microphone_processing = microphone_source->ProcessingStats();
 	EXPECT_TRUE(microphone_processing.echo_cancellation_enabled);
+	EXPECT_TRUE(microphone_processing.echo_reference_attached);
 	EXPECT_GE(microphone_processing.capture_frames_processed, 20u);
 	EXPECT_GE(microphone_processing.render_frames_processed, 20u);
 	EXPECT_EQ(microphone_processing.capture_processing_errors, 0u);
@@ -1701,6 +1702,61 @@ TEST(LiveKitServerTest, TransfersDataAndFileWithoutMediaTracks) {
 		                                file_payload);
 	    },
 	    std::chrono::seconds(10)));
+	EXPECT_TRUE(receiver->IncomingDataStreams().empty());
+
+	receiver->RemoveEventListener();
+	EXPECT_TRUE(sender->Disconnect());
+	EXPECT_TRUE(receiver->Disconnect());
+}
+
+TEST(LiveKitServerTest, SendsFileAsynchronouslyWithProgress) {
+	const char* url = std::getenv("LIVEKIT_URL");
+	const char* sender_token = std::getenv("LIVEKIT_TOKEN");
+	const char* receiver_token = std::getenv("LIVEKIT_TOKEN_2");
+	if (url == nullptr || sender_token == nullptr || receiver_token == nullptr || *url == '\0' ||
+	    *sender_token == '\0' || *receiver_token == '\0') {
+		GTEST_SKIP() << "Set LIVEKIT_URL, LIVEKIT_TOKEN, and LIVEKIT_TOKEN_2 to run the async file "
+		                "integration test";
+	}
+
+	ClientRuntime runtime;
+	ASSERT_TRUE(runtime.initialized());
+	MediaEvents events;
+	auto receiver = CreateRoomUnique();
+	auto sender = CreateRoomUnique();
+	receiver->AddEventListener(&events);
+	ASSERT_TRUE(receiver->Connect(url, receiver_token));
+	ASSERT_TRUE(sender->Connect(url, sender_token));
+	ASSERT_TRUE(WaitUntil([&] { return receiver->IsConnected() && sender->IsConnected(); },
+	                      std::chrono::seconds(10)));
+
+	// Several deflate blocks, so compression and sending overlap.
+	std::vector<uint8_t> file_payload(1024 * 1024);
+	for (std::size_t i = 0; i < file_payload.size(); ++i) {
+		file_payload[i] = static_cast<uint8_t>(i % 251);
+	}
+	TemporaryFile file(file_payload);
+	FileSendOptions file_options;
+	file_options.topic = "integration-file-async";
+	file_options.mime_type = "application/x-livekit-test";
+	file_options.compress = true;
+	file_options.destination_identities = {receiver->GetLocalParticipant()->Identity()};
+	std::atomic<uint64_t> file_progress{0};
+	std::atomic_bool file_sent{false};
+	file_options.on_progress = [&](uint64_t bytes_sent, std::optional<uint64_t>) {
+		file_progress.store(bytes_sent);
+	};
+	file_options.on_complete = [&](const std::string&, bool sent) { file_sent.store(sent); };
+	ASSERT_TRUE(sender->GetLocalParticipant()->SendFileAsync(file.path().string(), file_options));
+	ASSERT_TRUE(WaitUntil(
+	    [&] {
+		    return events.received_file(file.path().filename().string(),
+		                                "application/x-livekit-test", "integration-file-async",
+		                                file_payload);
+	    },
+	    std::chrono::seconds(10)));
+	ASSERT_TRUE(WaitUntil([&] { return file_sent.load(); }, std::chrono::seconds(10)));
+	EXPECT_EQ(file_progress.load(), file_payload.size());
 
 	receiver->RemoveEventListener();
 	EXPECT_TRUE(sender->Disconnect());
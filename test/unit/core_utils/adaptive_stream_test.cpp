@@ -0,0 +1,163 @@
+#include "adaptive_stream.h"
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+using namespace std::chrono_literals;
+
+class RecordingSender {
+public:
+	AdaptiveStream::SendFunction Function() {
+		return [this](const std::string& track_sid, const VideoRenderState& state) {
+			std::lock_guard<std::mutex> guard(mutex_);
+			sent_.emplace_back(track_sid, state);
+			cv_.notify_all();
+			return succeed_;
+		};
+	}
+
+	bool WaitFor(std::size_t count, std::chrono::milliseconds timeout) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		return cv_.wait_for(lock, timeout, [&] { return sent_.size() >= count; });
+	}
+
+	std::vector<std::pair<std::string, VideoRenderState>> Sent() {
+		std::lock_guard<std::mutex> guard(mutex_);
+		return sent_;
+	}
+
+	void SetSucceed(bool succeed) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		succeed_ = succeed;
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::vector<std::pair<std::string, VideoRenderState>> sent_;
+	bool succeed_ = true;
+};
+
+VideoRenderState Shown(uint32_t width, uint32_t height) { return {{width, height}, true}; }
+
+TEST(AdaptiveStreamTest, MapsRenderStateToTrackSettings) {
+	RemoteTrackSettings settings;
+	settings.video_fps = 15;
+	settings.priority = 2;
+	settings.video_quality = VideoQuality::Low;
+
+	const auto sized = AdaptRemoteTrackSettings(settings, Shown(320, 180));
+	EXPECT_TRUE(sized.enabled);
+	EXPECT_FALSE(sized.video_quality.has_value());
+	ASSERT_TRUE(sized.video_dimensions.has_value());
+	EXPECT_EQ(sized.video_dimensions->width, 320u);
+	EXPECT_EQ(sized.video_dimensions->height, 180u);
+	EXPECT_EQ(sized.video_fps, 15u);
+	EXPECT_EQ(sized.priority, 2u);
+
+	const auto unsized = AdaptRemoteTrackSettings(sized, Shown(0, 0));
+	EXPECT_TRUE(unsized.enabled);
+	EXPECT_FALSE(unsized.video_dimensions.has_value());
+	EXPECT_EQ(unsized.video_quality, VideoQuality::High);
+
+	const auto hidden = AdaptRemoteTrackSettings(sized, {{320, 180}, false});
+	EXPECT_FALSE(hidden.enabled);
+}
+
+TEST(AdaptiveStreamTest, SendsFirstChangeImmediately) {
+	RecordingSender sender;
+	AdaptiveStream stream(1s, sender.Function());
+	stream.Update("TR_1", Shown(640, 360));
+	const auto sent = sender.Sent();
+	ASSERT_EQ(sent.size(), 1u);
+	EXPECT_EQ(sent[0].first, "TR_1");
+	EXPECT_EQ(sent[0].second.dimensions.width, 640u);
+	ASSERT_TRUE(stream.State("TR_1").has_value());
+	EXPECT_FALSE(stream.State("TR_2").has_value());
+}
+
+TEST(AdaptiveStreamTest, CoalescesBurstIntoOneUpdatePerTrack) {
+	RecordingSender sender;
+	AdaptiveStream stream(30ms, sender.Function());
+	stream.Update("TR_1", Shown(640, 360));
+	for (uint32_t width = 100; width < 110; ++width) {
+		stream.Update("TR_1", Shown(width, 100));
+		stream.Update("TR_2", Shown(width * 2, 200));
+	}
+	ASSERT_TRUE(sender.WaitFor(3, 1s));
+	std::this_thread::sleep_for(60ms);
+	const auto sent = sender.Sent();
+	ASSERT_EQ(sent.size(), 3u);
+	EXPECT_EQ(sent[1].first, "TR_1");
+	EXPECT_EQ(sent[1].second.dimensions.width, 109u);
+	EXPECT_EQ(sent[2].first, "TR_2");
+	EXPECT_EQ(sent[2].second.dimensions.width, 218u);
+}
+
+TEST(AdaptiveStreamTest, SkipsStatesAlreadySent) {
+	RecordingSender sender;
+	AdaptiveStream stream(20ms, sender.Function());
+	stream.Update("TR_1", Shown(640, 360));
+	stream.Update("TR_1", Shown(320, 180));
+	stream.Update("TR_1", Shown(640, 360));
+	std::this_thread::sleep_for(60ms);
+	EXPECT_EQ(sender.Sent().size(), 1u);
+}
+
+TEST(AdaptiveStreamTest, RetriesStateAfterFailedSend) {
+	RecordingSender sender;
+	sender.SetSucceed(false);
+	AdaptiveStream stream(0ms, sender.Function());
+	stream.Update("TR_1", Shown(640, 360));
+	sender.SetSucceed(true);
+	stream.Update("TR_1", Shown(640, 360));
+	stream.Update("TR_1", Shown(640, 360));
+	EXPECT_EQ(sender.Sent().size(), 2u);
+}
+
+TEST(AdaptiveStreamTest, RemovedTracksAreNotSent) {
+	RecordingSender sender;
+	AdaptiveStream stream(20ms, sender.Function());
+	stream.Update("TR_1", Shown(640, 360));
+	stream.Update("TR_2", Shown(640, 360));
+	stream.Remove("TR_2");
+	std::this_thread::sleep_for(60ms);
+	EXPECT_EQ(sender.Sent().size(), 1u);
+	EXPECT_FALSE(stream.State("TR_2").has_value());
+}
+
+TEST(AdaptiveStreamTest, DeferredSendDoesNotHoldTheTimerWheel) {
+	std::promise<void> entered;
+	std::promise<void> release;
+	auto release_future = release.get_future().share();
+	int calls = 0;
+	AdaptiveStream stream(20ms, [&](const std::string&, const VideoRenderState&) {
+		if (++calls == 2) {
+			entered.set_value();
+			release_future.wait();
+		}
+		return true;
+	});
+	stream.Update("TR_1", Shown(640, 360));
+	stream.Update("TR_1", Shown(320, 180));
+	ASSERT_EQ(entered.get_future().wait_for(2s), std::future_status::ready);
+
+	// The deferred send is blocked off the wheel, so other timers still fire.
+	std::promise<void> fired;
+	detail::TimerWheel::Shared().Schedule(1ms, [&fired] { fired.set_value(); });
+	EXPECT_EQ(fired.get_future().wait_for(2s), std::future_status::ready);
+	release.set_value();
+}
+
+} // namespace
+} // namespace livekit::core
@@ -25,6 +25,29 @@ TEST(DebouncerTest, RejectsNegativeInterval) {
 	EXPECT_THROW((void)Debouncer::Create(-1ms), std::invalid_argument);
 }
 
+TEST(DebouncerTest, DefersCallToEndOfInterval) {
+	auto debouncer = Debouncer::Create(40ms);
+	ASSERT_TRUE(debouncer->lock());
+	const auto start = std::chrono::steady_clock::now();
+	std::promise<std::chrono::steady_clock::time_point> ran;
+	ASSERT_TRUE(debouncer->defer([&] { ran.set_value(std::chrono::steady_clock::now()); }));
+	EXPECT_FALSE(debouncer->defer([] {}));
+	auto result = ran.get_future();
+	ASSERT_EQ(result.wait_for(1s), std::future_status::ready);
+	EXPECT_GE(result.get() - start, 30ms);
+}
+
+TEST(DebouncerTest, CancelDropsDeferredCall) {
+	auto debouncer = Debouncer::Create(20ms);
+	ASSERT_TRUE(debouncer->lock());
+	std::atomic<int> calls{0};
+	ASSERT_TRUE(debouncer->defer([&] { ++calls; }));
+	debouncer->cancel();
+	EXPECT_FALSE(debouncer->defer([&] { ++calls; }));
+	std::this_thread::sleep_for(40ms);
+	EXPECT_EQ(calls.load(), 0);
+}
+
 TEST(TimerTest, FiresOneShotOnce) {
 	auto timer = std::make_shared<Timer>();
 	std::promise<void> fired;
@@ -71,6 +94,17 @@ TEST(TimerTest, IntervalStopsWithoutFurtherCallbacks) {
 	EXPECT_EQ(calls.load(), stopped_at);
 }
 
+TEST(TimerTest, RestartReplacesPendingTimeout) {
+	auto timer = std::make_shared<Timer>();
+	std::atomic<int> first{0};
+	std::promise<void> fired;
+	timer->SetTimeout([&]() { ++first; }, 30);
+	timer->SetTimeout([&]() { fired.set_value(); }, 10);
+	ASSERT_EQ(fired.get_future().wait_for(1s), std::future_status::ready);
+	std::this_thread::sleep_for(40ms);
+	EXPECT_EQ(first.load(), 0);
+}
+
 TEST(TimerTest, RejectsNegativeDelay) {
 	auto timer = std::make_shared<Timer>();
 	EXPECT_THROW(timer->SetTimeout([] {}, -1), std::invalid_argument);
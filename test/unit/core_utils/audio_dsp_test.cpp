@@ -0,0 +1,144 @@
+#include "audio_dsp.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace livekit::capture {
+namespace {
+
+// Odd lengths exercise both the vector bodies and the scalar tails.
+constexpr std::size_t kSampleCount = 1000 + 13;
+
+std::vector<std::int16_t> MakeSamples(std::uint32_t seed) {
+	std::vector<std::int16_t> samples(kSampleCount);
+	for (auto& sample : samples) {
+		seed = seed * 1664525U + 1013904223U;
+		sample = static_cast<std::int16_t>(seed >> 16);
+	}
+	samples[0] = std::numeric_limits<std::int16_t>::min();
+	samples[1] = std::numeric_limits<std::int16_t>::max();
+	return samples;
+}
+
+std::vector<const AudioDspKernels*> AvailableKernels() {
+	std::vector<const AudioDspKernels*> kernels;
+	for (const auto isa : {AudioDspIsa::Sse2, AudioDspIsa::Avx2, AudioDspIsa::Neon}) {
+		if (const auto* candidate = AudioDspKernelsFor(isa)) {
+			kernels.push_back(candidate);
+		}
+	}
+	return kernels;
+}
+
+TEST(AudioDspTest, SelectsSupportedKernels) {
+	EXPECT_EQ(ScalarAudioDspKernels().isa, AudioDspIsa::Scalar);
+	EXPECT_EQ(AudioDspKernelsFor(AudioDsp().isa), &AudioDsp());
+}
+
+TEST(AudioDspTest, ScalesAndMixesWithSaturation) {
+	std::array<std::int16_t, 4> samples{-32768, -3, 3, 32767};
+	ASSERT_TRUE(ScaleAudio(samples, samples, 2.0F));
+	EXPECT_EQ(samples, (std::array<std::int16_t, 4>{-32768, -6, 6, 32767}));
+	ASSERT_TRUE(ScaleAudio(samples, samples, 0.25F));
+	// Ties round to even.
+	EXPECT_EQ(samples, (std::array<std::int16_t, 4>{-8192, -2, 2, 8192}));
+
+	const std::array<std::int16_t, 3> first{30000, -30000, 100};
+	const std::array<std::int16_t, 3> second{30000, -30000, -50};
+	const std::array<std::int16_t, 3> third{-30000, 0, 1};
+	const std::array<const std::int16_t*, 3> inputs{first.data(), second.data(), third.data()};
+	std::array<std::int16_t, 3> mixed{};
+	ASSERT_TRUE(MixAudio(inputs, mixed));
+	// The sum is clipped once, not after every input.
+	EXPECT_EQ(mixed, (std::array<std::int16_t, 3>{30000, -32768, 51}));
+	EXPECT_FALSE(ScaleAudio(first, std::span<std::int16_t>(mixed).first(2), 1.0F));
+}
+
+TEST(AudioDspTest, ConvertsInterleavesAndMeasures) {
+	const std::array<std::int16_t, 3> samples{-32768, 0, 16384};
+	std::array<float, 3> floats{};
+	ASSERT_TRUE(ConvertAudioToFloat(samples, floats));
+	EXPECT_EQ(floats, (std::array<float, 3>{-1.0F, 0.0F, 0.5F}));
+	const std::array<float, 3> out_of_range{2.0F, -2.0F, 0.25F};
+	std::array<std::int16_t, 3> converted{};
+	ASSERT_TRUE(ConvertAudioFromFloat(out_of_range, converted));
+	EXPECT_EQ(converted, (std::array<std::int16_t, 3>{32767, -32768, 8192}));
+
+	const std::array<std::int16_t, 2> left{1, 3};
+	const std::array<std::int16_t, 2> right{2, 4};
+	const std::array<const std::int16_t*, 2> planes{left.data(), right.data()};
+	std::array<std::int16_t, 4> interleaved{};
+	ASSERT_TRUE(InterleaveAudio(planes, interleaved));
+	EXPECT_EQ(interleaved, (std::array<std::int16_t, 4>{1, 2, 3, 4}));
+	std::array<std::int16_t, 2> left_out{};
+	std::array<std::int16_t, 2> right_out{};
+	const std::array<std::int16_t*, 2> out_planes{left_out.data(), right_out.data()};
+	ASSERT_TRUE(DeinterleaveAudio(interleaved, out_planes));
+	EXPECT_EQ(left_out, left);
+	EXPECT_EQ(right_out, right);
+	const std::span<const std::int16_t> truncated(interleaved.data(), 3);
+	EXPECT_FALSE(DeinterleaveAudio(truncated, out_planes));
+
+	const auto level = MeasureAudioLevel(std::array<std::int16_t, 4>{-32768, 32767, 0, 0});
+	EXPECT_FLOAT_EQ(level.peak, 1.0F);
+	EXPECT_NEAR(level.rms, 0.7071F, 1e-4F);
+	EXPECT_EQ(MeasureAudioLevel({}).peak, 0.0F);
+}
+
+TEST(AudioDspTest, VectorKernelsMatchScalarReference) {
+	const auto& scalar = ScalarAudioDspKernels();
+	const auto first = MakeSamples(1);
+	const auto second = MakeSamples(2);
+	const std::array<const std::int16_t*, 2> inputs{first.data(), second.data()};
+	const auto planes_in = inputs;
+
+	for (const auto* kernels : AvailableKernels()) {
+		SCOPED_TRACE(static_cast<int>(kernels->isa));
+		std::vector<std::int16_t> expected(kSampleCount);
+		std::vector<std::int16_t> actual(kSampleCount);
+		for (const float gain : {0.0F, 0.37F, 1.0F, 3.5F}) {
+			scalar.scale(first.data(), expected.data(), kSampleCount, gain);
+			kernels->scale(first.data(), actual.data(), kSampleCount, gain);
+			EXPECT_EQ(actual, expected) << "gain " << gain;
+		}
+		scalar.mix(inputs.data(), inputs.size(), expected.data(), kSampleCount);
+		kernels->mix(inputs.data(), inputs.size(), actual.data(), kSampleCount);
+		EXPECT_EQ(actual, expected);
+
+		std::vector<float> expected_float(kSampleCount);
+		std::vector<float> actual_float(kSampleCount);
+		scalar.to_float(first.data(), expected_float.data(), kSampleCount);
+		kernels->to_float(first.data(), actual_float.data(), kSampleCount);
+		EXPECT_EQ(actual_float, expected_float);
+		for (auto& value : expected_float) {
+			value *= 1.7F;
+		}
+		scalar.from_float(expected_float.data(), expected.data(), kSampleCount);
+		kernels->from_float(expected_float.data(), actual.data(), kSampleCount);
+		EXPECT_EQ(actual, expected);
+
+		std::vector<std::int16_t> expected_interleaved(kSampleCount * 2);
+		std::vector<std::int16_t> actual_interleaved(kSampleCount * 2);
+		scalar.interleave(planes_in.data(), 2, kSampleCount, expected_interleaved.data());
+		kernels->interleave(planes_in.data(), 2, kSampleCount, actual_interleaved.data());
+		EXPECT_EQ(actual_interleaved, expected_interleaved);
+		std::vector<std::int16_t> left(kSampleCount);
+		std::vector<std::int16_t> right(kSampleCount);
+		const std::array<std::int16_t*, 2> planes_out{left.data(), right.data()};
+		kernels->deinterleave(actual_interleaved.data(), 2, kSampleCount, planes_out.data());
+		EXPECT_EQ(left, first);
+		EXPECT_EQ(right, second);
+
+		const auto expected_level = scalar.level(first.data(), kSampleCount);
+		const auto actual_level = kernels->level(first.data(), kSampleCount);
+		EXPECT_EQ(actual_level.peak, expected_level.peak);
+		EXPECT_EQ(actual_level.rms, expected_level.rms);
+	}
+}
+
+} // namespace
+} // namespace livekit::capture
@@ -0,0 +1,135 @@
+#include "audio_mix_bus.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+constexpr uint32_t kSampleRate = 16000;
+constexpr std::size_t kFrameSamples = kSampleRate / 100;
+
+std::vector<int16_t> Constant(int16_t value, std::size_t count = kFrameSamples) {
+	return std::vector<int16_t>(count, value);
+}
+
+TEST(AudioMixBusTest, MixesInputsWithParticipantGain) {
+	AudioMixBus bus(kSampleRate, 1, 100);
+	auto alice_mic = bus.AddInput("TR_a1", "PA_alice");
+	auto alice_screen = bus.AddInput("TR_a2", "PA_alice");
+	auto bob = bus.AddInput("TR_b1", "PA_bob");
+	ASSERT_NE(alice_mic, nullptr);
+	EXPECT_EQ(bus.AddInput("TR_a1", "PA_alice"), nullptr);
+
+	bus.SetGroupGain("PA_alice", 0.5F);
+	ASSERT_TRUE(alice_mic->Write(Constant(1000).data(), kFrameSamples));
+	ASSERT_TRUE(alice_screen->Write(Constant(200).data(), kFrameSamples));
+	ASSERT_TRUE(bob->Write(Constant(30000).data(), kFrameSamples));
+
+	AudioFrame frame;
+	ASSERT_TRUE(bus.Pull(frame));
+	EXPECT_EQ(frame.sample_rate, kSampleRate);
+	EXPECT_EQ(frame.num_channels, 1U);
+	EXPECT_EQ(frame.samples_per_channel, kFrameSamples);
+	// The sum saturates once: 500 + 100 + 30000 fits, and the gain only touched Alice's tracks.
+	EXPECT_EQ(frame.data, Constant(30600));
+
+	// Gains set before a track is added apply to it as well.
+	bus.SetGroupGain("PA_carol", 0.0F);
+	auto carol = bus.AddInput("TR_c1", "PA_carol");
+	ASSERT_TRUE(carol->Write(Constant(12345).data(), kFrameSamples));
+	EXPECT_FALSE(bus.Pull(frame));
+	EXPECT_EQ(frame.data, Constant(0));
+}
+
+TEST(AudioMixBusTest, TapsSeeEachTrackBeforeMixing) {
+	AudioMixBus bus(kSampleRate, 2, 100);
+	auto input = bus.AddInput("TR_a1", "PA_alice");
+	bus.SetGroupGain("PA_alice", 2.0F);
+	std::string tapped_participant;
+	std::vector<int16_t> tapped;
+	ASSERT_TRUE(bus.SetTap("TR_a1", [&](const std::string& participant_sid,
+	                                    const std::string& track_sid, const AudioFrame& frame) {
+		tapped_participant = participant_sid;
+		EXPECT_EQ(track_sid, "TR_a1");
+		EXPECT_EQ(frame.num_channels, 2U);
+		tapped = frame.data;
+	}));
+	EXPECT_FALSE(bus.SetTap("TR_missing", nullptr));
+
+	ASSERT_TRUE(input->Write(Constant(-100, kFrameSamples * 2).data(), kFrameSamples));
+	AudioFrame frame;
+	ASSERT_TRUE(bus.Pull(frame));
+	EXPECT_EQ(tapped_participant, "PA_alice");
+	EXPECT_EQ(tapped, Constant(-200, kFrameSamples * 2));
+	EXPECT_EQ(frame.data, tapped);
+}
+
+TEST(AudioMixBusTest, CountsUnderrunsAndOverruns) {
+	AudioMixBus bus(kSampleRate, 1, 20);
+	auto input = bus.AddInput("TR_a1", "PA_alice");
+	const auto samples = Constant(7);
+	// Half a frame is kept queued rather than mixed early.
+	ASSERT_TRUE(input->Write(samples.data(), kFrameSamples / 2));
+	AudioFrame frame;
+	EXPECT_FALSE(bus.Pull(frame));
+	ASSERT_TRUE(input->Write(samples.data(), kFrameSamples / 2));
+	EXPECT_TRUE(bus.Pull(frame));
+	EXPECT_EQ(frame.data, samples);
+
+	ASSERT_TRUE(input->Write(samples.data(), kFrameSamples));
+	ASSERT_TRUE(input->Write(samples.data(), kFrameSamples));
+	EXPECT_FALSE(input->Write(samples.data(), kFrameSamples));
+
+	auto stats = bus.Stats();
+	EXPECT_EQ(stats.track_count, 1U);
+	EXPECT_EQ(stats.mixed_frames, 2U);
+	EXPECT_EQ(stats.underrun_frames, 1U);
+	EXPECT_EQ(stats.overrun_frames, 1U);
+
+	// Counters survive removal; a producer still holding the input cannot reach the bus.
+	EXPECT_TRUE(bus.RemoveInput("TR_a1"));
+	EXPECT_FALSE(bus.RemoveInput("TR_a1"));
+	EXPECT_FALSE(bus.Pull(frame));
+	stats = bus.Stats();
+	EXPECT_EQ(stats.track_count, 0U);
+	EXPECT_EQ(stats.overrun_frames, 1U);
+}
+
+TEST(AudioMixBusTest, PullsWhileProducersWrite) {
+	AudioMixBus bus(kSampleRate, 1, 2000);
+	constexpr int kFrames = 200;
+	std::vector<std::shared_ptr<AudioMixBus::Input>> inputs;
+	for (int index = 0; index < 3; ++index) {
+		inputs.push_back(bus.AddInput("TR_" + std::to_string(index), "PA"));
+	}
+	std::vector<std::thread> producers;
+	for (auto& input : inputs) {
+		producers.emplace_back([input] {
+			const auto samples = Constant(1);
+			for (int frame = 0; frame < kFrames; ++frame) {
+				// The ring holds every frame, so writes never race Pull() into an overrun.
+				EXPECT_TRUE(input->Write(samples.data(), kFrameSamples));
+			}
+		});
+	}
+	// Each pull mixes whichever inputs have a full frame queued, so the mixed values add up to
+	// every frame written and each frame is uniform.
+	AudioFrame frame;
+	int mixed = 0;
+	while (mixed < kFrames * 3) {
+		bus.Pull(frame);
+		ASSERT_EQ(frame.data, Constant(frame.data.front()));
+		mixed += frame.data.front();
+	}
+	for (auto& producer : producers) {
+		producer.join();
+	}
+	EXPECT_EQ(mixed, kFrames * 3);
+}
+
+} // namespace
+} // namespace livekit::core
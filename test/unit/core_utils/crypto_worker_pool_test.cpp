@@ -0,0 +1,117 @@
+#include "crypto_worker_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+using namespace std::chrono_literals;
+
+TEST(CryptoWorkerPoolTest, KeepsOrderPerKey) {
+	constexpr int kKeys = 16;
+	constexpr int kTasksPerKey = 500;
+	std::vector<std::vector<int>> order(kKeys);
+	{
+		CryptoWorkerPool pool(4);
+		for (int task = 0; task < kTasksPerKey; ++task) {
+			for (int key = 0; key < kKeys; ++key) {
+				// Each key's tasks share a worker, so only that worker touches order[key].
+				pool.Post(static_cast<uint64_t>(key), [&order, key, task] {
+					order[key].push_back(task);
+				});
+			}
+		}
+	}
+	std::vector<int> expected(kTasksPerKey);
+	std::iota(expected.begin(), expected.end(), 0);
+	for (const auto& tasks : order) {
+		EXPECT_EQ(tasks, expected);
+	}
+}
+
+TEST(CryptoWorkerPoolTest, ThreadsAreBoundedByWorkersNotKeys) {
+	CryptoWorkerPool pool(3);
+	EXPECT_EQ(pool.GetStats().threads, 0u);
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+	std::atomic<int> remaining{1000};
+	std::promise<void> done;
+	for (int key = 0; key < 1000; ++key) {
+		// Spread like the addresses of heap-allocated cryptors.
+		pool.Post(static_cast<uint64_t>(0x7f0000001000ULL + key * 0x2a0ULL), [&] {
+			{
+				std::lock_guard<std::mutex> guard(mutex);
+				threads.insert(std::this_thread::get_id());
+			}
+			if (--remaining == 0) {
+				done.set_value();
+			}
+		});
+	}
+	ASSERT_EQ(done.get_future().wait_for(2s), std::future_status::ready);
+	EXPECT_EQ(threads.size(), 3u);
+	const auto stats = pool.GetStats();
+	EXPECT_EQ(stats.workers, 3u);
+	EXPECT_EQ(stats.threads, 3u);
+}
+
+TEST(CryptoWorkerPoolTest, RecordsQueueDepthAndLatency) {
+	CryptoWorkerPool pool(1);
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	pool.Post(1, [released] { released.wait(); });
+	std::this_thread::sleep_for(5ms);
+	for (int task = 0; task < 3; ++task) {
+		pool.Post(1, [] {});
+	}
+	std::this_thread::sleep_for(2ms);
+	release.set_value();
+	std::promise<void> done;
+	pool.Post(1, [&] { done.set_value(); });
+	ASSERT_EQ(done.get_future().wait_for(1s), std::future_status::ready);
+	std::this_thread::sleep_for(5ms);
+
+	const auto stats = pool.GetStats();
+	EXPECT_EQ(stats.completed, 5u);
+	uint64_t posted = 0;
+	for (const auto count : stats.queue_depth) {
+		posted += count;
+	}
+	EXPECT_EQ(posted, 5u);
+	// The three tasks queued behind the blocked one saw depths 0, 1 and 2.
+	EXPECT_GE(stats.queue_depth[0], 2u);
+	EXPECT_GE(stats.queue_depth[1], 1u);
+	EXPECT_GE(stats.queue_depth[2], 1u);
+	uint64_t measured = 0;
+	for (const auto count : stats.latency_us) {
+		measured += count;
+	}
+	EXPECT_EQ(measured, 5u);
+	EXPECT_GE(stats.max_latency_us, 5'000u);
+}
+
+TEST(CryptoWorkerPoolTest, TasksMayOwnMoveOnlyState) {
+	CryptoWorkerPool pool(2);
+	std::promise<int> result;
+	auto value = std::make_unique<int>(42);
+	pool.Post(7, [value = std::move(value), &result] { result.set_value(*value); });
+	auto future = result.get_future();
+	ASSERT_EQ(future.wait_for(1s), std::future_status::ready);
+	EXPECT_EQ(future.get(), 42);
+	EXPECT_THROW(pool.Post(7, CryptoWorkerPool::Task()), std::invalid_argument);
+	EXPECT_THROW(CryptoWorkerPool(0), std::invalid_argument);
+}
+
+} // namespace
+} // namespace livekit::core::detail
@@ -0,0 +1,212 @@
+#include "data_batcher.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+using namespace std::chrono_literals;
+
+class RecordingSender {
+public:
+	DataBatcher::SendFunction Function() {
+		return [this](const DataBatch& batch) {
+			std::lock_guard<std::mutex> guard(mutex_);
+			batches_.push_back(batch);
+			cv_.notify_all();
+			return succeed_;
+		};
+	}
+
+	bool WaitFor(std::size_t count, std::chrono::milliseconds timeout) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		return cv_.wait_for(lock, timeout, [&] { return batches_.size() >= count; });
+	}
+
+	std::vector<DataBatch> Batches() {
+		std::lock_guard<std::mutex> guard(mutex_);
+		return batches_;
+	}
+
+	void SetSucceed(bool succeed) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		succeed_ = succeed;
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::vector<DataBatch> batches_;
+	bool succeed_ = true;
+};
+
+bool Publish(DataBatcher& batcher, const std::string& topic, std::vector<std::string> destinations,
+             const std::string& payload) {
+	return batcher.Publish(topic, std::move(destinations),
+	                       reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+}
+
+std::vector<std::string> Decode(const DataBatch& batch) {
+	std::vector<std::string_view> views;
+	EXPECT_TRUE(DecodeDataBatch(batch.payload, views));
+	return {views.begin(), views.end()};
+}
+
+TEST(DataBatcherTest, WireFormatRoundTrips) {
+	std::vector<std::string_view> messages;
+	const std::string long_message(300, 'x');
+	std::string payload = "\x02hi";
+	payload += std::string("\xac\x02", 2) + long_message;
+	payload += std::string(1, '\0');
+	ASSERT_TRUE(DecodeDataBatch(payload, messages));
+	ASSERT_EQ(messages.size(), 3U);
+	EXPECT_EQ(messages[0], "hi");
+	EXPECT_EQ(messages[1], long_message);
+	EXPECT_EQ(messages[2], "");
+
+	// Truncated messages and runaway varints are rejected as a whole.
+	EXPECT_FALSE(DecodeDataBatch("\x02hi\x05zz", messages));
+	EXPECT_TRUE(messages.empty());
+	EXPECT_FALSE(DecodeDataBatch(std::string(11, '\xff'), messages));
+}
+
+TEST(DataBatcherTest, PacketCarriesTheApplicationTopic) {
+	DataBatch batch;
+	batch.topic = "state";
+	batch.payload = "\x02hi\x03you";
+	const auto packet = EncodeDataBatchPacket(batch);
+	EXPECT_EQ(packet, std::string("\x01\x05state") + "\x02hi\x03you");
+
+	std::string topic;
+	std::vector<std::string_view> messages;
+	ASSERT_TRUE(DecodeDataBatchPacket(packet, topic, messages));
+	EXPECT_EQ(topic, "state");
+	EXPECT_EQ(messages, (std::vector<std::string_view>{"hi", "you"}));
+
+	batch.topic.clear();
+	ASSERT_TRUE(DecodeDataBatchPacket(EncodeDataBatchPacket(batch), topic, messages));
+	EXPECT_EQ(topic, "");
+	EXPECT_EQ(messages.size(), 2U);
+
+	// Payloads another sender put on the reserved topic are not taken for batches.
+	EXPECT_FALSE(DecodeDataBatchPacket("", topic, messages));
+	EXPECT_FALSE(DecodeDataBatchPacket("{\"state\":1}", topic, messages));
+	EXPECT_FALSE(DecodeDataBatchPacket(std::string("\x01\x09state", 7), topic, messages));
+	EXPECT_FALSE(DecodeDataBatchPacket(std::string("\x01\x05state\x05zz", 9), topic, messages));
+	EXPECT_TRUE(messages.empty());
+}
+
+TEST(DataBatcherTest, CoalescesPerTopicAndDestinationSet) {
+	RecordingSender sender;
+	DataBatcher batcher({1000, 1000}, sender.Function());
+	EXPECT_TRUE(Publish(batcher, "state", {"b", "a"}, "one"));
+	EXPECT_TRUE(Publish(batcher, "state", {"a", "b", "a"}, "two"));
+	EXPECT_TRUE(Publish(batcher, "state", {}, "three"));
+	EXPECT_TRUE(Publish(batcher, "pose", {"a", "b"}, "four"));
+	EXPECT_TRUE(sender.Batches().empty());
+
+	ASSERT_TRUE(batcher.Flush());
+	auto batches = sender.Batches();
+	ASSERT_EQ(batches.size(), 3U);
+	bool saw_pair = false;
+	for (const auto& batch : batches) {
+		if (batch.topic == "state" && batch.destination_identities.size() == 2) {
+			saw_pair = true;
+			EXPECT_EQ(batch.destination_identities, (std::vector<std::string>{"a", "b"}));
+			EXPECT_EQ(batch.message_count, 2U);
+			EXPECT_EQ(Decode(batch), (std::vector<std::string>{"one", "two"}));
+		}
+	}
+	EXPECT_TRUE(saw_pair);
+
+	const auto stats = batcher.Stats();
+	EXPECT_EQ(stats.messages, 4U);
+	EXPECT_EQ(stats.packets, 3U);
+	EXPECT_EQ(stats.max_messages_per_packet, 2U);
+	EXPECT_GE(stats.max_added_latency_us, 0U);
+}
+
+TEST(DataBatcherTest, SendsWhenTheBudgetIsReached) {
+	RecordingSender sender;
+	// Each 4-byte payload takes 5 bytes, so two fit in the budget and the third starts a batch.
+	DataBatcher batcher({1000, 12}, sender.Function());
+	EXPECT_TRUE(Publish(batcher, "t", {}, "aaaa"));
+	EXPECT_TRUE(Publish(batcher, "t", {}, "bbbb"));
+	EXPECT_TRUE(sender.Batches().empty());
+	EXPECT_TRUE(Publish(batcher, "t", {}, "cccc"));
+	auto batches = sender.Batches();
+	ASSERT_EQ(batches.size(), 1U);
+	EXPECT_EQ(Decode(batches[0]), (std::vector<std::string>{"aaaa", "bbbb"}));
+
+	// A payload over the budget on its own goes out immediately, after what was queued before it.
+	EXPECT_TRUE(Publish(batcher, "t", {}, std::string(20, 'z')));
+	batches = sender.Batches();
+	ASSERT_EQ(batches.size(), 3U);
+	EXPECT_EQ(Decode(batches[1]), (std::vector<std::string>{"cccc"}));
+	EXPECT_EQ(Decode(batches[2]), (std::vector<std::string>{std::string(20, 'z')}));
+	EXPECT_EQ(batcher.Stats().packets, 3U);
+}
+
+TEST(DataBatcherTest, FlushesWhenTheWindowExpires) {
+	RecordingSender sender;
+	DataBatcher batcher({5, 1000}, sender.Function());
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_TRUE(Publish(batcher, "t", {}, "a"));
+	EXPECT_TRUE(Publish(batcher, "t", {}, "b"));
+	ASSERT_TRUE(sender.WaitFor(1, 2s));
+	EXPECT_GE(std::chrono::steady_clock::now() - start, 5ms);
+	EXPECT_EQ(Decode(sender.Batches()[0]), (std::vector<std::string>{"a", "b"}));
+
+	// The flush thread counts the batch only after send() returns.
+	auto stats = batcher.Stats();
+	for (const auto deadline = std::chrono::steady_clock::now() + 2s;
+	     stats.messages < 2U && std::chrono::steady_clock::now() < deadline;
+	     stats = batcher.Stats()) {
+		std::this_thread::sleep_for(1ms);
+	}
+	EXPECT_EQ(stats.messages, 2U);
+	EXPECT_GE(stats.max_added_latency_us, 5000U);
+	EXPECT_GE(stats.total_added_latency_us, stats.max_added_latency_us);
+}
+
+TEST(DataBatcherTest, CountsFailedSends) {
+	RecordingSender sender;
+	sender.SetSucceed(false);
+	DataBatcher batcher({1000, 1000}, sender.Function());
+	EXPECT_TRUE(Publish(batcher, "t", {}, "a"));
+	EXPECT_FALSE(batcher.Flush());
+	const auto stats = batcher.Stats();
+	EXPECT_EQ(stats.failed_packets, 1U);
+	EXPECT_EQ(stats.packets, 0U);
+	EXPECT_EQ(stats.messages, 0U);
+}
+
+TEST(DataBatcherTest, KeepsOrderAcrossPublishersAndTheFlushThread) {
+	RecordingSender sender;
+	DataBatcher batcher({1, 64}, sender.Function());
+	constexpr int kMessages = 500;
+	std::thread producer([&] {
+		for (int index = 0; index < kMessages; ++index) {
+			Publish(batcher, "t", {}, std::to_string(index));
+		}
+	});
+	producer.join();
+	batcher.Flush();
+
+	int expected = 0;
+	for (const auto& batch : sender.Batches()) {
+		for (const auto& message : Decode(batch)) {
+			ASSERT_EQ(message, std::to_string(expected));
+			++expected;
+		}
+	}
+	EXPECT_EQ(expected, kMessages);
+	EXPECT_EQ(batcher.Stats().messages, static_cast<uint64_t>(kMessages));
+}
+
+} // namespace
+} // namespace livekit::core
@@ -0,0 +1,240 @@
+#include "dynacast.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+using namespace std::chrono_literals;
+using LayerMap = DynacastController::LayerMap;
+
+class RecordingSender {
+public:
+	DynacastController::ApplyFunction Apply() {
+		return [this](const std::string& track_sid, const LayerMap& active) {
+			std::lock_guard<std::mutex> guard(mutex_);
+			applied_.emplace_back(track_sid, active);
+			cv_.notify_all();
+			return succeed_;
+		};
+	}
+
+	DynacastController::SampleFunction Sample() {
+		return [this](const std::string&) {
+			std::lock_guard<std::mutex> guard(mutex_);
+			return encode_seconds_;
+		};
+	}
+
+	bool WaitFor(std::size_t count, std::chrono::milliseconds timeout) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		return cv_.wait_for(lock, timeout, [&] { return applied_.size() >= count; });
+	}
+
+	std::vector<std::pair<std::string, LayerMap>> Applied() {
+		std::lock_guard<std::mutex> guard(mutex_);
+		return applied_;
+	}
+
+	void SetSucceed(bool succeed) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		succeed_ = succeed;
+	}
+
+	void SetEncodeSeconds(std::map<VideoQuality, double> encode_seconds) {
+		std::lock_guard<std::mutex> guard(mutex_);
+		encode_seconds_ = std::move(encode_seconds);
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::vector<std::pair<std::string, LayerMap>> applied_;
+	std::map<VideoQuality, double> encode_seconds_;
+	bool succeed_ = true;
+};
+
+const LayerMap kAllLayers = {
+    {VideoQuality::Low, true}, {VideoQuality::Medium, true}, {VideoQuality::High, true}};
+const LayerMap kLowOnly = {
+    {VideoQuality::Low, true}, {VideoQuality::Medium, false}, {VideoQuality::High, false}};
+
+TEST(DynacastTest, AppliesAllLayersOfATrackInOneCall) {
+	RecordingSender sender;
+	DynacastController dynacast(0ms, sender.Apply(), sender.Sample());
+	dynacast.Update("TR_1", kAllLayers);
+	EXPECT_TRUE(sender.Applied().empty());
+
+	dynacast.Update("TR_1", kLowOnly);
+	auto applied = sender.Applied();
+	ASSERT_EQ(applied.size(), 1u);
+	EXPECT_EQ(applied[0].first, "TR_1");
+	EXPECT_EQ(applied[0].second, kLowOnly);
+
+	const auto layers = dynacast.Layers("TR_1");
+	ASSERT_EQ(layers.size(), 3u);
+	EXPECT_TRUE(layers[0].active);
+	EXPECT_FALSE(layers[1].active);
+	EXPECT_FALSE(layers[2].active);
+	EXPECT_EQ(layers[2].pauses, 1u);
+	EXPECT_TRUE(dynacast.Layers("TR_2").empty());
+}
+
+TEST(DynacastTest, HoldsPausesAndCancelsThemOnQuickReenable) {
+	RecordingSender sender;
+	DynacastController dynacast(50ms, sender.Apply(), sender.Sample());
+	dynacast.Update("TR_1", kAllLayers);
+	dynacast.Update("TR_1", kLowOnly);
+	auto layers = dynacast.Layers("TR_1");
+	EXPECT_TRUE(layers[2].active);
+	EXPECT_TRUE(layers[2].pause_pending);
+
+	dynacast.Update("TR_1", kAllLayers);
+	std::this_thread::sleep_for(100ms);
+	EXPECT_TRUE(sender.Applied().empty());
+	layers = dynacast.Layers("TR_1");
+	EXPECT_TRUE(layers[2].active);
+	EXPECT_FALSE(layers[2].pause_pending);
+}
+
+TEST(DynacastTest, PausesAfterHoldAndActivatesImmediately) {
+	RecordingSender sender;
+	DynacastController dynacast(20ms, sender.Apply(), sender.Sample());
+	dynacast.Update("TR_1", kLowOnly);
+	ASSERT_TRUE(sender.WaitFor(1, 1s));
+	EXPECT_EQ(sender.Applied()[0].second, kLowOnly);
+
+	dynacast.Update("TR_1", kAllLayers);
+	auto applied = sender.Applied();
+	ASSERT_EQ(applied.size(), 2u);
+	EXPECT_EQ(applied[1].second, kAllLayers);
+	EXPECT_EQ(dynacast.Layers("TR_1")[1].pauses, 1u);
+}
+
+TEST(DynacastTest, EstimatesEncodeTimeSavedFromActiveRate) {
+	RecordingSender sender;
+	sender.SetEncodeSeconds({{VideoQuality::High, 0.0}});
+	DynacastController dynacast(0ms, sender.Apply(), sender.Sample());
+	dynacast.Update("TR_1", kAllLayers);
+	std::this_thread::sleep_for(40ms);
+	// Roughly a quarter of wall time spent encoding the top layer.
+	sender.SetEncodeSeconds({{VideoQuality::High, 0.01}});
+	dynacast.Update("TR_1", kLowOnly);
+	std::this_thread::sleep_for(40ms);
+	dynacast.Update("TR_1", kAllLayers);
+
+	const auto high = dynacast.Layers("TR_1")[2];
+	EXPECT_TRUE(high.active);
+	EXPECT_GE(high.paused_ms, 40u);
+	EXPECT_GT(high.encode_seconds_saved, 0.0);
+	EXPECT_LE(high.encode_seconds_saved, 0.25 * static_cast<double>(high.paused_ms + 1) / 1000.0);
+	// Without a baseline sample nothing is claimed as saved.
+	EXPECT_DOUBLE_EQ(dynacast.Layers("TR_1")[1].encode_seconds_saved, 0.0);
+}
+
+TEST(DynacastTest, KeepsStateWhenApplyFailsAndRetriesOnNextUpdate) {
+	RecordingSender sender;
+	sender.SetSucceed(false);
+	DynacastController dynacast(0ms, sender.Apply(), sender.Sample());
+	dynacast.Update("TR_1", kLowOnly);
+	EXPECT_EQ(sender.Applied().size(), 1u);
+	EXPECT_TRUE(dynacast.Layers("TR_1")[2].active);
+
+	sender.SetSucceed(true);
+	dynacast.Update("TR_1", kLowOnly);
+	EXPECT_EQ(sender.Applied().size(), 2u);
+	EXPECT_FALSE(dynacast.Layers("TR_1")[2].active);
+}
+
+TEST(DynacastTest, ResetActivatesEveryLayerAndDropsPendingPauses) {
+	RecordingSender sender;
+	DynacastController dynacast(0ms, sender.Apply(), sender.Sample());
+	dynacast.Update("TR_1", kLowOnly);
+	dynacast.Update("TR_2", kAllLayers);
+	dynacast.Reset();
+	const auto applied = sender.Applied();
+	ASSERT_EQ(applied.size(), 2u);
+	EXPECT_EQ(applied[1].first, "TR_1");
+	EXPECT_EQ(applied[1].second, kAllLayers);
+
+	dynacast.Remove("TR_1");
+	EXPECT_TRUE(dynacast.Layers("TR_1").empty());
+	dynacast.Clear();
+	EXPECT_TRUE(dynacast.Layers("TR_2").empty());
+}
+
+TEST(DynacastTest, SamplesStatsWithoutBlockingOtherTracks) {
+	RecordingSender sender;
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	std::promise<void> sampling;
+	DynacastController dynacast(0ms, sender.Apply(), [&](const std::string& track_sid) {
+		if (track_sid == "TR_1") {
+			sampling.set_value();
+			released.wait();
+		}
+		return std::map<VideoQuality, double>{};
+	});
+	std::thread slow([&] { dynacast.Update("TR_1", kLowOnly); });
+	sampling.get_future().wait();
+	// A stats call stuck on one track must not hold up the layers of another.
+	dynacast.Update("TR_2", kLowOnly);
+	ASSERT_EQ(sender.Applied().size(), 1u);
+	EXPECT_EQ(sender.Applied()[0].first, "TR_2");
+	release.set_value();
+	slow.join();
+	EXPECT_EQ(sender.Applied().size(), 2u);
+}
+
+TEST(DynacastTest, HoldsPausesOnOneSharedWheelTimer) {
+	RecordingSender sender;
+	const auto active_before = detail::TimerWheel::Shared().GetStats().active;
+	{
+		DynacastController dynacast(10s, sender.Apply(), sender.Sample());
+		dynacast.Update("TR_1", kAllLayers);
+		dynacast.Update("TR_2", kAllLayers);
+		dynacast.Update("TR_1", kLowOnly);
+		dynacast.Update("TR_2", kLowOnly);
+		EXPECT_EQ(detail::TimerWheel::Shared().GetStats().active, active_before + 1);
+	}
+	EXPECT_EQ(detail::TimerWheel::Shared().GetStats().active, active_before);
+	EXPECT_TRUE(sender.Applied().empty());
+}
+
+TEST(DynacastTest, BlockingApplyDoesNotHoldTheTimerWheel) {
+	std::promise<void> entered;
+	std::promise<void> release;
+	auto release_future = release.get_future().share();
+	std::atomic<int> calls{0};
+	DynacastController dynacast(
+	    20ms,
+	    [&](const std::string&, const LayerMap&) {
+		    if (calls++ == 0) {
+			    entered.set_value();
+			    release_future.wait();
+		    }
+		    return true;
+	    },
+	    {});
+	dynacast.Update("TR_1", kAllLayers);
+	dynacast.Update("TR_1", kLowOnly);
+	ASSERT_EQ(entered.get_future().wait_for(2s), std::future_status::ready);
+
+	// The pause is being applied off the wheel, so other timers still fire.
+	std::promise<void> fired;
+	detail::TimerWheel::Shared().Schedule(1ms, [&fired] { fired.set_value(); });
+	EXPECT_EQ(fired.get_future().wait_for(2s), std::future_status::ready);
+	release.set_value();
+}
+
+} // namespace
+} // namespace livekit::core
@@ -0,0 +1,245 @@
+#include "event_dispatcher.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+
+// Holds the dispatch thread inside a callback until Release(), so tests can fill the queues.
+class Gate {
+public:
+	std::function<void()> Hold() {
+		return [this] {
+			entered_.set_value();
+			released_.wait();
+		};
+	}
+	void WaitEntered() {
+		ASSERT_EQ(entered_future_.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+	}
+	void Release() { release_.set_value(); }
+
+private:
+	std::promise<void> entered_;
+	std::future<void> entered_future_ = entered_.get_future();
+	std::promise<void> release_;
+	std::shared_future<void> released_ = release_.get_future().share();
+};
+
+struct Recorder {
+	std::mutex mutex;
+	std::vector<std::string> events;
+
+	std::function<void()> Record(std::string name) {
+		return [this, name = std::move(name)] {
+			std::lock_guard<std::mutex> guard(mutex);
+			events.push_back(name);
+		};
+	}
+};
+
+void Drain(EventDispatcher& dispatcher) {
+	std::promise<void> done;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Speakers, [&done] { done.set_value(); }));
+	ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+}
+
+TEST(EventDispatcherTest, DeliversHigherPriorityCategoriesFirst) {
+	EventDispatcher dispatcher;
+	Recorder recorder;
+	Gate gate;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Data, gate.Hold()));
+	gate.WaitEntered();
+	dispatcher.Post(EventCategory::Speakers, recorder.Record("speakers"));
+	dispatcher.Post(EventCategory::Data, recorder.Record("data 1"));
+	dispatcher.Post(EventCategory::Media, recorder.Record("media"));
+	dispatcher.Post(EventCategory::Data, recorder.Record("data 2"));
+	dispatcher.Post(EventCategory::Connection, recorder.Record("connection"));
+	EXPECT_EQ(dispatcher.Stats().data.depth, 2u);
+	gate.Release();
+	Drain(dispatcher);
+	EXPECT_EQ(recorder.events, (std::vector<std::string>{"connection", "media", "data 1", "data 2",
+	                                                      "speakers"}));
+	const auto stats = dispatcher.Stats();
+	EXPECT_EQ(stats.data.dispatched, 3u);
+	EXPECT_EQ(stats.data.max_depth, 2u);
+	EXPECT_EQ(stats.data.depth, 0u);
+	EXPECT_GT(stats.connection.max_wait_us, 0u);
+}
+
+TEST(EventDispatcherTest, CoalescesUpdatesForTheSameSubject) {
+	EventDispatcher dispatcher;
+	Recorder recorder;
+	Gate gate;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Connection, gate.Hold()));
+	gate.WaitEntered();
+	dispatcher.Post(EventCategory::Speakers, recorder.Record("quality a 1"), "quality:a");
+	dispatcher.Post(EventCategory::Speakers, recorder.Record("speakers 1"), "speakers");
+	dispatcher.Post(EventCategory::Speakers, recorder.Record("quality b"), "quality:b");
+	dispatcher.Post(EventCategory::Speakers, recorder.Record("quality a 2"), "quality:a");
+	dispatcher.Post(EventCategory::Speakers, recorder.Record("speakers 2"), "speakers");
+	gate.Release();
+	Drain(dispatcher);
+	EXPECT_EQ(recorder.events,
+	          (std::vector<std::string>{"quality a 2", "speakers 2", "quality b"}));
+	EXPECT_EQ(dispatcher.Stats().speakers.coalesced, 2u);
+}
+
+TEST(EventDispatcherTest, DropsOldestLossyEventWhenDataQueueIsFull) {
+	EventDispatchOptions options;
+	options.data.capacity = 3;
+	EventDispatcher dispatcher(options);
+	Recorder recorder;
+	Gate gate;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Connection, gate.Hold()));
+	gate.WaitEntered();
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("lossy 1"), {}, true));
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("reliable 1")));
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("lossy 2"), {}, true));
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("lossy 3"), {}, true));
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("reliable 2")));
+	EXPECT_EQ(dispatcher.Stats().data.depth, 3u);
+	gate.Release();
+	Drain(dispatcher);
+	EXPECT_EQ(recorder.events,
+	          (std::vector<std::string>{"reliable 1", "lossy 3", "reliable 2"}));
+	EXPECT_EQ(dispatcher.Stats().data.dropped, 2u);
+}
+
+TEST(EventDispatcherTest, FullDataQueueKeepsReliableEventsAndDropsNewLossyOnes) {
+	EventDispatchOptions options;
+	options.data.capacity = 2;
+	EventDispatcher dispatcher(options);
+	Recorder recorder;
+	Gate gate;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Connection, gate.Hold()));
+	gate.WaitEntered();
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("reliable 1")));
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("reliable 2")));
+	EXPECT_FALSE(dispatcher.Post(EventCategory::Data, recorder.Record("lossy"), {}, true));
+	EXPECT_TRUE(dispatcher.Post(EventCategory::Data, recorder.Record("reliable 3")));
+	const auto stats = dispatcher.Stats();
+	EXPECT_EQ(stats.data.depth, 3u);
+	EXPECT_EQ(stats.data.dropped, 1u);
+	gate.Release();
+	Drain(dispatcher);
+	EXPECT_EQ(recorder.events,
+	          (std::vector<std::string>{"reliable 1", "reliable 2", "reliable 3"}));
+}
+
+TEST(EventDispatcherTest, FullQueueGrowsWithoutWaitingOrDropping) {
+	EventDispatchOptions options;
+	options.media.capacity = 2;
+	EventDispatcher dispatcher(options);
+	Recorder recorder;
+	Gate gate;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Connection, gate.Hold()));
+	gate.WaitEntered();
+	// The dispatch thread is held, so a producer that waited for room would never return.
+	for (int index = 0; index < 5; ++index) {
+		EXPECT_TRUE(dispatcher.Post(EventCategory::Media, recorder.Record(std::to_string(index)),
+		                            {}, true));
+	}
+	const auto stats = dispatcher.Stats();
+	EXPECT_EQ(stats.media.depth, 5u);
+	EXPECT_EQ(stats.media.max_depth, 5u);
+	EXPECT_EQ(stats.media.dropped, 0u);
+	gate.Release();
+	Drain(dispatcher);
+	EXPECT_EQ(recorder.events, (std::vector<std::string>{"0", "1", "2", "3", "4"}));
+}
+
+TEST(EventDispatcherTest, FullQueueNeverBlocksTheDispatchThread) {
+	EventDispatchOptions options;
+	options.connection.capacity = 1;
+	EventDispatcher dispatcher(options);
+	Recorder recorder;
+	std::promise<void> done;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Connection, [&] {
+		for (int index = 0; index < 3; ++index) {
+			dispatcher.Post(EventCategory::Connection, recorder.Record(std::to_string(index)));
+		}
+		done.set_value();
+	}));
+	ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+	Drain(dispatcher);
+	EXPECT_EQ(recorder.events, (std::vector<std::string>{"0", "1", "2"}));
+	EXPECT_EQ(dispatcher.Stats().connection.dropped, 0u);
+}
+
+TEST(EventDispatcherTest, FullSpeakersQueueDropsTheOldestUpdate) {
+	EventDispatchOptions options;
+	options.speakers.capacity = 2;
+	EventDispatcher dispatcher(options);
+	Recorder recorder;
+	Gate gate;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Connection, gate.Hold()));
+	gate.WaitEntered();
+	for (const auto* subject : {"a", "b", "c"}) {
+		EXPECT_TRUE(dispatcher.Post(EventCategory::Speakers, recorder.Record(subject),
+		                            std::string("quality:") + subject, true));
+	}
+	EXPECT_EQ(dispatcher.Stats().speakers.dropped, 1u);
+	gate.Release();
+	dispatcher.Flush();
+	EXPECT_EQ(recorder.events, (std::vector<std::string>{"b", "c"}));
+}
+
+TEST(EventDispatcherTest, DisabledDispatchRunsInline) {
+	EventDispatchOptions options;
+	options.enabled = false;
+	EventDispatcher dispatcher(options);
+	std::thread::id ran_on;
+	ASSERT_TRUE(dispatcher.Post(EventCategory::Data,
+	                            [&ran_on] { ran_on = std::this_thread::get_id(); }));
+	EXPECT_EQ(ran_on, std::this_thread::get_id());
+}
+
+TEST(EventDispatcherTest, StopDeliversQueuedEventsAndRejectsLaterOnes) {
+	Recorder recorder;
+	Gate gate;
+	auto dispatcher = std::make_unique<EventDispatcher>();
+	ASSERT_TRUE(dispatcher->Post(EventCategory::Connection, gate.Hold()));
+	gate.WaitEntered();
+	dispatcher->Post(EventCategory::Data, recorder.Record("queued"));
+	std::thread stopper([&] { dispatcher->Stop(); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	gate.Release();
+	stopper.join();
+	EXPECT_EQ(recorder.events, (std::vector<std::string>{"queued"}));
+	EXPECT_FALSE(dispatcher->Post(EventCategory::Data, recorder.Record("late")));
+}
+
+TEST(EventDispatcherTest, WaitsForRunningCallbackAndStopsFromCallback) {
+	auto dispatcher = std::make_unique<EventDispatcher>();
+	Gate gate;
+	ASSERT_TRUE(dispatcher->Post(EventCategory::Connection, gate.Hold()));
+	gate.WaitEntered();
+	auto waited = std::async(std::launch::async, [&] { dispatcher->WaitForRunningCallbacks(); });
+	EXPECT_EQ(waited.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+	gate.Release();
+	EXPECT_EQ(waited.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+
+	std::promise<void> posted;
+	std::promise<void> stopped;
+	ASSERT_TRUE(dispatcher->Post(EventCategory::Connection, [&] {
+		posted.get_future().wait();
+		dispatcher->WaitForRunningCallbacks();
+		dispatcher.reset();
+		stopped.set_value();
+	}));
+	posted.set_value();
+	EXPECT_EQ(stopped.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+}
+
+} // namespace
+} // namespace livekit::core::detail
@@ -0,0 +1,296 @@
+#include "data_stream_compression.h"
+#include "file_reader.h"
+#include "file_stream_pipeline.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+
+std::vector<uint8_t> Pattern(std::size_t size) {
+	std::vector<uint8_t> data(size);
+	for (std::size_t index = 0; index < size; ++index) {
+		data[index] = static_cast<uint8_t>((index * 31) ^ (index >> 7));
+	}
+	return data;
+}
+
+struct Collected {
+	std::vector<std::vector<uint8_t>> chunks;
+	std::vector<uint64_t> progress;
+
+	FileStreamChunkFunction Send() {
+		return [this](const uint8_t* data, std::size_t size) {
+			chunks.emplace_back(data, data + size);
+			return true;
+		};
+	}
+
+	FileStreamProgressFunction Progress() {
+		return [this](uint64_t consumed) { progress.push_back(consumed); };
+	}
+
+	std::vector<uint8_t> Joined() const {
+		std::vector<uint8_t> joined;
+		for (const auto& chunk : chunks) {
+			joined.insert(joined.end(), chunk.begin(), chunk.end());
+		}
+		return joined;
+	}
+};
+
+class TemporaryFile {
+public:
+	explicit TemporaryFile(const std::vector<uint8_t>& contents)
+	    : path_(std::filesystem::temp_directory_path() /
+	            ("lkc_file_reader_" + std::to_string(reinterpret_cast<uintptr_t>(this)))) {
+		std::ofstream output(path_, std::ios::binary);
+		output.write(reinterpret_cast<const char*>(contents.data()),
+		             static_cast<std::streamsize>(contents.size()));
+	}
+	~TemporaryFile() { std::filesystem::remove(path_); }
+
+	std::string Path() const { return path_.string(); }
+
+private:
+	std::filesystem::path path_;
+};
+
+TEST(FileStreamPipelineTest, SendsUncompressedChunksStraightFromInput) {
+	const auto data = Pattern(kFileStreamBlockSize + 40'000);
+	Collected collected;
+	ASSERT_TRUE(StreamFileChunks(data.data(), data.size(), 15'000, false, {}, collected.Send(),
+	                             collected.Progress()));
+	EXPECT_EQ(collected.Joined(), data);
+	for (std::size_t index = 0; index + 1 < collected.chunks.size(); ++index) {
+		EXPECT_EQ(collected.chunks[index].size(), 15'000u);
+	}
+	ASSERT_FALSE(collected.progress.empty());
+	EXPECT_EQ(collected.progress.back(), data.size());
+}
+
+TEST(FileStreamPipelineTest, CompressedChunksAreFullAndInflateToInput) {
+	const auto data = Pattern(3 * kParallelDeflateBlockSize + 1234);
+	DataStreamCompressionOptions compression;
+	compression.threads = 3;
+	Collected collected;
+	ASSERT_TRUE(StreamFileChunks(data.data(), data.size(), 4'000, true, compression,
+	                             collected.Send(), collected.Progress()));
+	for (std::size_t index = 0; index + 1 < collected.chunks.size(); ++index) {
+		EXPECT_EQ(collected.chunks[index].size(), 4'000u);
+	}
+	const auto compressed = collected.Joined();
+	InflateRawStream inflater(data.size());
+	std::vector<uint8_t> inflated;
+	ASSERT_TRUE(inflater.Write(compressed.data(), compressed.size(), inflated));
+	EXPECT_TRUE(inflater.Finished());
+	EXPECT_EQ(inflated, data);
+	ASSERT_EQ(collected.progress.size(), 4u);
+	EXPECT_EQ(collected.progress.back(), data.size());
+}
+
+TEST(FileStreamPipelineTest, StopsAtFirstRejectedChunk) {
+	const auto data = Pattern(8 * kFileStreamBlockSize);
+	for (const bool compress : {false, true}) {
+		std::size_t calls = 0;
+		const auto reject_third = [&](const uint8_t*, std::size_t) { return ++calls < 3; };
+		EXPECT_FALSE(
+		    StreamFileChunks(data.data(), data.size(), 1'000, compress, {}, reject_third, {}));
+		EXPECT_EQ(calls, 3u);
+	}
+}
+
+TEST(FileStreamPipelineTest, CompressesEmptyInputToValidStream) {
+	Collected collected;
+	ASSERT_TRUE(StreamFileChunks(nullptr, 0, 1'000, true, {}, collected.Send(), {}));
+	const auto compressed = collected.Joined();
+	InflateRawStream inflater(0);
+	std::vector<uint8_t> inflated;
+	ASSERT_TRUE(inflater.Write(compressed.data(), compressed.size(), inflated));
+	EXPECT_TRUE(inflater.Finished());
+	EXPECT_TRUE(inflated.empty());
+}
+
+std::vector<uint8_t> Inflate(const std::vector<uint8_t>& compressed, std::size_t size) {
+	InflateRawStream inflater(size);
+	std::vector<uint8_t> inflated;
+	if (!inflater.Write(compressed.data(), compressed.size(), inflated) || !inflater.Finished()) {
+		inflated.clear();
+	}
+	return inflated;
+}
+
+TEST(FileStreamPipelineTest, ParallelDeflateBlocksFormOneStream) {
+	const auto data = Pattern(5 * kParallelDeflateBlockSize + 777);
+	for (const uint32_t threads : {1U, 2U, 4U}) {
+		DataStreamCompressionOptions options;
+		options.threads = threads;
+		std::vector<uint8_t> compressed;
+		std::vector<uint64_t> input_ends;
+		ASSERT_TRUE(DeflateRawParallel(
+		    data.data(), data.size(), options,
+		    [&](const uint8_t* block, std::size_t size, uint64_t input_end) {
+			    compressed.insert(compressed.end(), block, block + size);
+			    input_ends.push_back(input_end);
+			    return true;
+		    }));
+		ASSERT_EQ(input_ends.size(), 6u);
+		for (std::size_t index = 0; index + 1 < input_ends.size(); ++index) {
+			EXPECT_EQ(input_ends[index], (index + 1) * kParallelDeflateBlockSize);
+		}
+		EXPECT_EQ(input_ends.back(), data.size());
+		EXPECT_LT(compressed.size(), data.size());
+		EXPECT_EQ(Inflate(compressed, data.size()), data) << threads << " threads";
+	}
+}
+
+TEST(FileStreamPipelineTest, ParallelDeflateHonoursLevelAndStrategy) {
+	const auto data = Pattern(3 * kParallelDeflateBlockSize);
+	const auto compress = [&](const DataStreamCompressionOptions& options) {
+		std::vector<uint8_t> compressed;
+		const bool compressed_all = DeflateRawParallel(
+		    data.data(), data.size(), options,
+		    [&](const uint8_t* block, std::size_t size, uint64_t) {
+			    compressed.insert(compressed.end(), block, block + size);
+			    return true;
+		    });
+		EXPECT_TRUE(compressed_all);
+		return compressed;
+	};
+	DataStreamCompressionOptions stored;
+	stored.level = 0;
+	stored.threads = 2;
+	const auto stored_output = compress(stored);
+	EXPECT_GT(stored_output.size(), data.size());
+	EXPECT_EQ(Inflate(stored_output, data.size()), data);
+
+	DataStreamCompressionOptions huffman;
+	huffman.strategy = DataStreamCompressionStrategy::HuffmanOnly;
+	huffman.threads = 2;
+	EXPECT_EQ(Inflate(compress(huffman), data.size()), data);
+
+	DataStreamCompressionOptions invalid;
+	invalid.level = 42;
+	invalid.threads = 2;
+	EXPECT_FALSE(DeflateRawParallel(data.data(), data.size(), invalid,
+	                                [](const uint8_t*, std::size_t, uint64_t) { return true; }));
+	EXPECT_FALSE(DeflateRawStream(invalid).IsValid());
+}
+
+TEST(FileStreamPipelineTest, ParallelDeflateStopsWhenBlockRejected) {
+	const auto data = Pattern(16 * kParallelDeflateBlockSize);
+	DataStreamCompressionOptions options;
+	options.threads = 4;
+	std::size_t blocks = 0;
+	EXPECT_FALSE(DeflateRawParallel(data.data(), data.size(), options,
+	                                [&](const uint8_t*, std::size_t, uint64_t) {
+		                                return ++blocks < 2;
+	                                }));
+	EXPECT_EQ(blocks, 2u);
+}
+
+TEST(FileStreamPipelineTest, ReadsFileContentsAtOffsets) {
+	const auto data = Pattern(70'000);
+	TemporaryFile file(data);
+	const auto reader = FileReader::Open(file.Path());
+	ASSERT_NE(reader, nullptr);
+	ASSERT_EQ(reader->Size(), data.size());
+	std::vector<uint8_t> middle(1'000);
+	ASSERT_TRUE(reader->ReadAt(30'000, middle.data(), middle.size()));
+	EXPECT_TRUE(std::equal(middle.begin(), middle.end(), data.begin() + 30'000));
+	EXPECT_FALSE(reader->ReadAt(data.size() - 10, middle.data(), middle.size()));
+
+	TemporaryFile empty({});
+	const auto empty_reader = FileReader::Open(empty.Path());
+	ASSERT_NE(empty_reader, nullptr);
+	EXPECT_EQ(empty_reader->Size(), 0u);
+	EXPECT_EQ(FileReader::Open(file.Path() + ".missing"), nullptr);
+}
+
+TEST(FileStreamPipelineTest, StreamsFileThroughReader) {
+	const auto data = Pattern(3 * kFileStreamBlockSize + 5'000);
+	TemporaryFile file(data);
+	const auto reader = FileReader::Open(file.Path());
+	ASSERT_NE(reader, nullptr);
+	const auto read = [&](uint64_t offset, uint8_t* buffer, std::size_t size) {
+		return reader->ReadAt(offset, buffer, size);
+	};
+	Collected collected;
+	ASSERT_TRUE(StreamFileChunks(read, reader->Size(), 15'000, false, {}, collected.Send(),
+	                             collected.Progress()));
+	EXPECT_EQ(collected.Joined(), data);
+	for (std::size_t index = 0; index + 1 < collected.chunks.size(); ++index) {
+		EXPECT_EQ(collected.chunks[index].size(), 15'000u);
+	}
+	EXPECT_EQ(collected.progress.back(), data.size());
+
+	Collected compressed;
+	ASSERT_TRUE(StreamFileChunks(read, reader->Size(), 4'000, true, {}, compressed.Send(), {}));
+	EXPECT_EQ(Inflate(compressed.Joined(), data.size()), data);
+}
+
+TEST(FileStreamPipelineTest, TruncatedFileFailsTheStream) {
+	const auto data = Pattern(4 * kFileStreamBlockSize);
+	TemporaryFile file(data);
+	const auto reader = FileReader::Open(file.Path());
+	ASSERT_NE(reader, nullptr);
+	const auto read = [&](uint64_t offset, uint8_t* buffer, std::size_t size) {
+		return reader->ReadAt(offset, buffer, size);
+	};
+	Collected collected;
+	const auto truncate_after_first = [&](const uint8_t* chunk, std::size_t size) {
+		if (collected.chunks.empty()) {
+			std::filesystem::resize_file(file.Path(), kFileStreamBlockSize / 2);
+		}
+		return collected.Send()(chunk, size);
+	};
+	EXPECT_FALSE(
+	    StreamFileChunks(read, reader->Size(), 16'000, false, {}, truncate_after_first, {}));
+	// The first block was read before the truncation; the second read comes up short.
+	EXPECT_EQ(collected.Joined().size(), kFileStreamBlockSize / 16'000 * 16'000);
+
+	// Compressed, the deflate worker whose block lies past the new end fails its read.
+	for (const uint32_t threads : {1U, 3U}) {
+		DataStreamCompressionOptions compression;
+		compression.threads = threads;
+		EXPECT_FALSE(StreamFileChunks(read, reader->Size(), 16'000, true, compression,
+		                              Collected().Send(), {}));
+	}
+}
+
+TEST(FileStreamPipelineTest, CompressedFileIsReadInBlocks) {
+	const auto data = Pattern(6 * kParallelDeflateBlockSize + 999);
+	TemporaryFile file(data);
+	const auto reader = FileReader::Open(file.Path());
+	ASSERT_NE(reader, nullptr);
+	for (const uint32_t threads : {1U, 3U}) {
+		std::mutex mutex;
+		std::size_t largest_read = 0;
+		const auto read = [&](uint64_t offset, uint8_t* buffer, std::size_t size) {
+			{
+				std::lock_guard<std::mutex> guard(mutex);
+				largest_read = std::max(largest_read, size);
+			}
+			return reader->ReadAt(offset, buffer, size);
+		};
+		DataStreamCompressionOptions compression;
+		compression.threads = threads;
+		Collected collected;
+		ASSERT_TRUE(StreamFileChunks(read, reader->Size(), 4'000, true, compression,
+		                             collected.Send(), collected.Progress()));
+		EXPECT_EQ(Inflate(collected.Joined(), data.size()), data) << threads << " threads";
+		EXPECT_EQ(collected.progress.back(), data.size());
+		// A block and at most the 32 KiB window before it, never the whole file.
+		EXPECT_LE(largest_read, kParallelDeflateBlockSize + 32 * 1024) << threads << " threads";
+	}
+}
+
+} // namespace
+} // namespace livekit::core::detail
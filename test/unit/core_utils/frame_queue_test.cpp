@@ -7,6 +7,7 @@
 #include <condition_variable>
 #include <cstdint>
 #include <mutex>
+#include <set>
 #include <vector>
 
 namespace livekit::capture {
@@ -20,7 +21,7 @@ TEST(FrameQueueTest, CopiesCallbackOwnedFrameData) {
 	std::vector<std::uint8_t> received;
 	std::uint16_t rotation_degrees = 0;
 	bool mirrored = false;
-	LatestVideoFrameQueue queue([&](const OwnedBgraFrame& frame) {
+	LatestVideoFrameQueue queue([&](const OwnedVideoFrame& frame) {
 		{
 			std::lock_guard<std::mutex> guard(mutex);
 			received = frame.data;
@@ -50,7 +51,7 @@ TEST(FrameQueueTest, KeepsOnlyNewestPendingFrame) {
 	std::vector<std::int64_t> timestamps;
 	bool first_entered = false;
 	bool may_finish_first = false;
-	LatestVideoFrameQueue queue([&](const OwnedBgraFrame& frame) {
+	LatestVideoFrameQueue queue([&](const OwnedVideoFrame& frame) {
 		std::unique_lock<std::mutex> lock(mutex);
 		timestamps.push_back(frame.timestamp_us);
 		if (timestamps.size() == 1) {
@@ -81,10 +82,94 @@ TEST(FrameQueueTest, KeepsOnlyNewestPendingFrame) {
 	}
 	queue.Stop();
 	EXPECT_EQ(timestamps, (std::vector<std::int64_t>{1, 3}));
+	EXPECT_EQ(queue.Stats().dropped_frames, 1u);
+}
+
+TEST(FrameQueueTest, RecyclesPooledBuffersAcrossFrames) {
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::set<const std::uint8_t*> buffers;
+	std::size_t delivered = 0;
+	LatestVideoFrameQueue queue([&](const OwnedVideoFrame& frame) {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			buffers.insert(frame.data.data());
+			++delivered;
+		}
+		condition.notify_all();
+	});
+	ASSERT_TRUE(queue.Start());
+	const auto push_and_wait = [&](std::uint32_t width, std::size_t frames) {
+		const std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * 2U * 4U, 1);
+		for (std::size_t index = 0; index < frames; ++index) {
+			std::unique_lock<std::mutex> lock(mutex);
+			const auto expected = delivered + 1;
+			lock.unlock();
+			ASSERT_TRUE(queue.Push(pixels.data(), width, 2, width * 4U, 1));
+			lock.lock();
+			ASSERT_TRUE(condition.wait_for(lock, 1s, [&] { return delivered == expected; }));
+		}
+	};
+	push_and_wait(2, 20);
+	const auto warm = queue.Stats();
+	EXPECT_GE(warm.pool_misses, 1u);
+	EXPECT_LE(warm.pool_misses, LatestVideoFrameQueue::kPoolSize);
+	EXPECT_EQ(warm.pool_hits + warm.pool_misses, 20u);
+	push_and_wait(8, 20);
+	push_and_wait(2, 20);
+	queue.Stop();
+
+	const auto stats = queue.Stats();
+	EXPECT_LE(stats.pool_misses, LatestVideoFrameQueue::kPoolSize * 2U);
+	EXPECT_EQ(stats.pool_hits + stats.pool_misses, 60u);
+	EXPECT_EQ(stats.dropped_frames, 0u);
+	EXPECT_EQ(stats.delivered_frames, 60u);
+	EXPECT_LE(buffers.size(), LatestVideoFrameQueue::kPoolSize * 2U);
+}
+
+TEST(FrameQueueTest, SizesNativeCaptureFormats) {
+	EXPECT_EQ(CaptureFrameSize(CapturePixelFormat::Bgra, 3, 2, 12), 24u);
+	EXPECT_EQ(CaptureFrameSize(CapturePixelFormat::Yuy2, 3, 2, 8), 16u);
+	EXPECT_EQ(CaptureFrameSize(CapturePixelFormat::I420, 4, 3, 4), 4u * 3u + 2u * 2u * 2u);
+	EXPECT_EQ(CaptureFrameSize(CapturePixelFormat::Nv12, 4, 3, 6), 6u * 3u + 6u * 2u);
+	EXPECT_EQ(CaptureFrameSize(CapturePixelFormat::Mjpeg, 640, 480, 0, 1234), 1234u);
+
+	EXPECT_FALSE(CaptureFrameSize(CapturePixelFormat::Bgra, 3, 2, 11).has_value());
+	EXPECT_FALSE(CaptureFrameSize(CapturePixelFormat::Yuy2, 3, 2, 7).has_value());
+	EXPECT_FALSE(CaptureFrameSize(CapturePixelFormat::I420, 4, 2, 3).has_value());
+	EXPECT_FALSE(CaptureFrameSize(CapturePixelFormat::Nv12, 0, 2, 4).has_value());
+	EXPECT_FALSE(CaptureFrameSize(CapturePixelFormat::Mjpeg, 640, 480, 0).has_value());
+}
+
+TEST(FrameQueueTest, CarriesNativeFormatsWithoutConversion) {
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::vector<std::uint8_t> received;
+	CapturePixelFormat format = CapturePixelFormat::Bgra;
+	LatestVideoFrameQueue queue([&](const OwnedVideoFrame& frame) {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			received = frame.data;
+			format = frame.format;
+		}
+		condition.notify_all();
+	});
+	ASSERT_TRUE(queue.Start());
+	// 2x2 NV12: four luma bytes followed by one interleaved UV row, plus trailing padding.
+	const std::array<std::uint8_t, 8> nv12{16, 32, 48, 64, 100, 200, 0xEE, 0xEE};
+	EXPECT_FALSE(queue.Push(CapturePixelFormat::Nv12, nv12.data(), 5, 2, 2, 2, 1));
+	ASSERT_TRUE(queue.Push(CapturePixelFormat::Nv12, nv12.data(), nv12.size(), 2, 2, 2, 1));
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		ASSERT_TRUE(condition.wait_for(lock, 1s, [&] { return !received.empty(); }));
+	}
+	queue.Stop();
+	EXPECT_EQ(format, CapturePixelFormat::Nv12);
+	EXPECT_EQ(received, (std::vector<std::uint8_t>{16, 32, 48, 64, 100, 200}));
 }
 
 TEST(FrameQueueTest, StopsDeterministicallyAndRejectsInvalidFrames) {
-	LatestVideoFrameQueue queue([](const OwnedBgraFrame&) {});
+	LatestVideoFrameQueue queue([](const OwnedVideoFrame&) {});
 	const std::array<std::uint8_t, 4> pixel{};
 	EXPECT_FALSE(queue.Push(pixel.data(), 1, 1, 4, 1));
 	ASSERT_TRUE(queue.Start());
@@ -0,0 +1,176 @@
+#include "frame_stream_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <poll.h>
+#endif
+
+namespace livekit::core {
+namespace {
+
+using namespace std::chrono_literals;
+
+using IntQueue = FrameStreamQueue<int>;
+
+bool PushValue(IntQueue& queue, int value) {
+	return queue.Push([value](int& slot) { slot = value; });
+}
+
+#if defined(_WIN32)
+bool IsSignaled(void* handle) {
+	return WaitForSingleObject(static_cast<HANDLE>(handle), 0) == WAIT_OBJECT_0;
+}
+#else
+bool IsReadable(int fd) {
+	pollfd descriptor{fd, POLLIN, 0};
+	return ::poll(&descriptor, 1, 0) == 1 && (descriptor.revents & POLLIN) != 0;
+}
+#endif
+
+TEST(FrameStreamQueueTest, DropOldestEvictsTheOldestFrame) {
+	IntQueue queue(2, FrameStreamOverflow::DropOldest, 0ms);
+	EXPECT_TRUE(PushValue(queue, 1));
+	EXPECT_TRUE(PushValue(queue, 2));
+	EXPECT_TRUE(PushValue(queue, 3));
+
+	int frame = 0;
+	ASSERT_TRUE(queue.Read(frame, 0ms));
+	EXPECT_EQ(frame, 2);
+	ASSERT_TRUE(queue.Read(frame, 0ms));
+	EXPECT_EQ(frame, 3);
+	EXPECT_FALSE(queue.Read(frame, 1ms));
+
+	const auto stats = queue.Stats();
+	EXPECT_EQ(stats.capacity_frames, 2U);
+	EXPECT_EQ(stats.queued_frames, 0U);
+	EXPECT_EQ(stats.pushed_frames, 3U);
+	EXPECT_EQ(stats.read_frames, 2U);
+	EXPECT_EQ(stats.dropped_frames, 1U);
+}
+
+TEST(FrameStreamQueueTest, KeepLatestReleasesEverythingQueued) {
+	FrameStreamQueue<std::shared_ptr<int>> queue(3, FrameStreamOverflow::KeepLatest, 0ms);
+	auto first = std::make_shared<int>(1);
+	for (int value = 0; value < 3; ++value) {
+		queue.Push([&](std::shared_ptr<int>& slot) { slot = first; });
+	}
+	queue.Push([](std::shared_ptr<int>& slot) { slot = std::make_shared<int>(4); });
+
+	std::shared_ptr<int> frame;
+	ASSERT_TRUE(queue.Read(frame, 0ms));
+	EXPECT_EQ(*frame, 4);
+	EXPECT_FALSE(queue.Read(frame, 0ms));
+	EXPECT_EQ(queue.Stats().dropped_frames, 3U);
+}
+
+TEST(FrameStreamQueueTest, RecyclesSlotsAfterReading) {
+	struct Release {
+		void operator()(std::shared_ptr<int>& slot) const noexcept { slot.reset(); }
+	};
+	FrameStreamQueue<std::shared_ptr<int>, Release> queue(2, FrameStreamOverflow::KeepLatest, 0ms);
+	auto first = std::make_shared<int>(1);
+	auto second = std::make_shared<int>(2);
+	queue.Push([&](std::shared_ptr<int>& slot) { slot = first; });
+	queue.Push([&](std::shared_ptr<int>& slot) { slot = second; });
+	queue.Push([](std::shared_ptr<int>& slot) { slot = std::make_shared<int>(3); });
+	// Dropped frames are released immediately.
+	EXPECT_EQ(first.use_count(), 1);
+	EXPECT_EQ(second.use_count(), 1);
+
+	auto reader = second;
+	ASSERT_TRUE(queue.Read(reader, 0ms));
+	EXPECT_EQ(*reader, 3);
+	// The reader's previous frame is not kept alive by the queue.
+	EXPECT_EQ(second.use_count(), 1);
+}
+
+TEST(FrameStreamQueueTest, BlockWaitsForSpaceThenDrops) {
+	IntQueue queue(1, FrameStreamOverflow::Block, 200ms);
+	ASSERT_TRUE(PushValue(queue, 1));
+	std::thread reader([&] {
+		std::this_thread::sleep_for(20ms);
+		int frame = 0;
+		EXPECT_TRUE(queue.Read(frame, 0ms));
+		EXPECT_EQ(frame, 1);
+	});
+	EXPECT_TRUE(PushValue(queue, 2));
+	reader.join();
+
+	IntQueue short_wait(1, FrameStreamOverflow::Block, 1ms);
+	ASSERT_TRUE(PushValue(short_wait, 1));
+	EXPECT_FALSE(PushValue(short_wait, 2));
+	EXPECT_EQ(short_wait.Stats().dropped_frames, 1U);
+}
+
+TEST(FrameStreamQueueTest, CloseWakesReadersAfterDraining) {
+	IntQueue queue(4, FrameStreamOverflow::DropOldest, 0ms);
+	ASSERT_TRUE(PushValue(queue, 7));
+	std::thread closer([&] {
+		std::this_thread::sleep_for(10ms);
+		queue.Close();
+	});
+	int frame = 0;
+	ASSERT_TRUE(queue.Read(frame, kFrameStreamWaitForever));
+	EXPECT_EQ(frame, 7);
+	EXPECT_FALSE(queue.Read(frame, kFrameStreamWaitForever));
+	closer.join();
+	EXPECT_TRUE(queue.IsClosed());
+	EXPECT_FALSE(PushValue(queue, 8));
+}
+
+#if !defined(_WIN32)
+TEST(FrameStreamQueueTest, DescriptorTracksQueuedFrames) {
+	IntQueue queue(2, FrameStreamOverflow::DropOldest, 0ms);
+	ASSERT_GE(queue.Fd(), 0);
+	EXPECT_FALSE(IsReadable(queue.Fd()));
+	PushValue(queue, 1);
+	PushValue(queue, 2);
+	PushValue(queue, 3);
+	EXPECT_TRUE(IsReadable(queue.Fd()));
+
+	int frame = 0;
+	ASSERT_TRUE(queue.Read(frame, 0ms));
+	EXPECT_TRUE(IsReadable(queue.Fd()));
+	ASSERT_TRUE(queue.Read(frame, 0ms));
+	EXPECT_FALSE(IsReadable(queue.Fd()));
+
+	// A closed stream stays readable so poll loops notice the close.
+	queue.Close();
+	EXPECT_TRUE(IsReadable(queue.Fd()));
+	EXPECT_FALSE(queue.Read(frame, 0ms));
+	EXPECT_TRUE(IsReadable(queue.Fd()));
+}
+
+TEST(FrameStreamQueueTest, HasNoEventHandleOffWindows) {
+	IntQueue queue(2, FrameStreamOverflow::DropOldest, 0ms);
+	EXPECT_EQ(queue.Handle(), nullptr);
+}
+#else
+TEST(FrameStreamQueueTest, EventHandleTracksQueuedFrames) {
+	IntQueue queue(2, FrameStreamOverflow::DropOldest, 0ms);
+	EXPECT_EQ(queue.Fd(), -1);
+	ASSERT_NE(queue.Handle(), nullptr);
+	EXPECT_FALSE(IsSignaled(queue.Handle()));
+	PushValue(queue, 1);
+	EXPECT_TRUE(IsSignaled(queue.Handle()));
+
+	int frame = 0;
+	ASSERT_TRUE(queue.Read(frame, 0ms));
+	EXPECT_FALSE(IsSignaled(queue.Handle()));
+
+	queue.Close();
+	EXPECT_TRUE(IsSignaled(queue.Handle()));
+}
+#endif
+
+} // namespace
+} // namespace livekit::core
@@ -0,0 +1,139 @@
+#include "key_schedule.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+using namespace std::chrono_literals;
+using Bytes = KeySchedule::Bytes;
+
+// A stand-in ratchet: the next material adds one to every byte, its key adds 100.
+KeySchedule::Step CountingStep(std::atomic<int>& calls) {
+	return [&calls](const Bytes& material) -> std::optional<KeySchedule::Ratchet> {
+		++calls;
+		KeySchedule::Ratchet ratchet{material, material};
+		for (auto& byte : ratchet.material) {
+			++byte;
+		}
+		for (auto& byte : ratchet.key) {
+			byte = static_cast<uint8_t>(byte + 100);
+		}
+		return ratchet;
+	};
+}
+
+TEST(KeyScheduleTest, PrecomputesTheRatchetWindow) {
+	KeySchedule schedule;
+	std::atomic<int> calls{0};
+	schedule.Precompute(1, {0}, 4, CountingStep(calls));
+	schedule.WaitForIdle();
+	EXPECT_EQ(calls, 4);
+
+	Bytes material{0};
+	for (uint8_t step = 1; step <= 4; ++step) {
+		const auto ratchet = schedule.FindRatchet(1, material);
+		ASSERT_TRUE(ratchet.has_value());
+		EXPECT_EQ(ratchet->material, Bytes{step});
+		EXPECT_EQ(ratchet->key, Bytes{static_cast<uint8_t>(step - 1 + 100)});
+		material = ratchet->material;
+	}
+	EXPECT_FALSE(schedule.FindRatchet(1, material).has_value());
+	// Another owner's keys are separate.
+	EXPECT_FALSE(schedule.FindRatchet(2, {0}).has_value());
+	EXPECT_EQ(schedule.GetStats().precomputed_steps, 4u);
+}
+
+TEST(KeyScheduleTest, ExtendingTheWindowReusesKnownSteps) {
+	KeySchedule schedule;
+	std::atomic<int> calls{0};
+	schedule.Precompute(1, {0}, 3, CountingStep(calls));
+	schedule.WaitForIdle();
+	// After ratcheting to step 2, the window from there shares two steps with the first.
+	schedule.Precompute(1, {2}, 3, CountingStep(calls));
+	schedule.Precompute(1, {0}, 3, CountingStep(calls));
+	schedule.WaitForIdle();
+	EXPECT_EQ(calls, 5);
+	EXPECT_TRUE(schedule.FindRatchet(1, {4}).has_value());
+}
+
+TEST(KeyScheduleTest, RemembersDerivedKeys) {
+	KeySchedule schedule;
+	const Bytes input{1, 2, 3};
+	const Bytes salt{'s'};
+	EXPECT_FALSE(schedule.FindDerived(1, input, salt, 128).has_value());
+	schedule.StoreDerived(1, input, salt, 128, {9, 9});
+	EXPECT_EQ(schedule.FindDerived(1, input, salt, 128), Bytes({9, 9}));
+	EXPECT_FALSE(schedule.FindDerived(1, input, salt, 256).has_value());
+	EXPECT_FALSE(schedule.FindDerived(1, input, Bytes{'t'}, 128).has_value());
+	EXPECT_FALSE(schedule.FindDerived(2, input, salt, 128).has_value());
+}
+
+TEST(KeyScheduleTest, EvictsLeastRecentlyUsed) {
+	KeySchedule schedule(2);
+	schedule.StoreDerived(1, {1}, {}, 128, {1});
+	schedule.StoreDerived(1, {2}, {}, 128, {2});
+	ASSERT_TRUE(schedule.FindDerived(1, {1}, {}, 128).has_value());
+	schedule.StoreDerived(1, {3}, {}, 128, {3});
+	EXPECT_TRUE(schedule.FindDerived(1, {1}, {}, 128).has_value());
+	EXPECT_FALSE(schedule.FindDerived(1, {2}, {}, 128).has_value());
+	EXPECT_TRUE(schedule.FindDerived(1, {3}, {}, 128).has_value());
+	EXPECT_EQ(schedule.GetStats().entries, 2u);
+	EXPECT_THROW(KeySchedule(0), std::invalid_argument);
+}
+
+TEST(KeyScheduleTest, ForgetDropsEntriesAndQueuedWork) {
+	KeySchedule schedule;
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	std::atomic<int> blocked_calls{0};
+	schedule.Precompute(1, {0}, 8, [&](const Bytes& material) {
+		++blocked_calls;
+		released.wait();
+		return std::optional<KeySchedule::Ratchet>(KeySchedule::Ratchet{{1}, material});
+	});
+	std::atomic<int> calls{0};
+	schedule.Precompute(2, {0}, 2, CountingStep(calls));
+	schedule.Precompute(1, {5}, 2, CountingStep(calls));
+	schedule.StoreDerived(1, {1}, {}, 128, {1});
+	schedule.StoreDerived(2, {1}, {}, 128, {2});
+	while (blocked_calls == 0) {
+		std::this_thread::sleep_for(1ms);
+	}
+
+	schedule.Forget(1);
+	release.set_value();
+	schedule.WaitForIdle();
+	// The running job stopped after its current step and stored nothing.
+	EXPECT_EQ(blocked_calls, 1);
+	EXPECT_FALSE(schedule.FindRatchet(1, {0}).has_value());
+	EXPECT_FALSE(schedule.FindRatchet(1, {5}).has_value());
+	EXPECT_FALSE(schedule.FindDerived(1, {1}, {}, 128).has_value());
+	EXPECT_TRUE(schedule.FindDerived(2, {1}, {}, 128).has_value());
+	EXPECT_EQ(calls, 2);
+	EXPECT_TRUE(schedule.FindRatchet(2, {0}).has_value());
+}
+
+TEST(KeyScheduleTest, RecordsRatchetOutcomes) {
+	KeySchedule schedule;
+	schedule.RecordRatchet(KeySchedule::RatchetOutcome::Hit, 40us);
+	schedule.RecordRatchet(KeySchedule::RatchetOutcome::Miss, 10us);
+	schedule.RecordRatchet(KeySchedule::RatchetOutcome::Exhausted, 70us);
+	const auto stats = schedule.GetStats();
+	EXPECT_EQ(stats.searches, 3u);
+	EXPECT_EQ(stats.hits, 1u);
+	EXPECT_EQ(stats.misses, 1u);
+	EXPECT_EQ(stats.total_latency_us, 120u);
+	EXPECT_EQ(stats.max_latency_us, 70u);
+}
+
+} // namespace
+} // namespace livekit::core::detail
@@ -0,0 +1,111 @@
+#include "participant_registry.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+
+struct FakeParticipant {
+	std::string sid;
+};
+
+using Registry = ParticipantRegistry<FakeParticipant>;
+
+std::shared_ptr<FakeParticipant> Make(const std::string& sid) {
+	return std::make_shared<FakeParticipant>(FakeParticipant{sid});
+}
+
+TEST(ParticipantRegistryTest, FindsParticipantsByEveryKey) {
+	Registry registry;
+	const auto alice = Make("PA_2");
+	const auto bob = Make("PA_1");
+	registry.Upsert(alice->sid, alice, {"alice", "Alice", {"TR_a1", "TR_a2"}});
+	registry.Upsert(bob->sid, bob, {"bob", "Bob", {"TR_b1"}});
+
+	EXPECT_EQ(registry.size(), 2u);
+	EXPECT_EQ(registry.FindBySid("PA_2"), alice);
+	EXPECT_EQ(registry.FindByIdentity("bob"), bob);
+	EXPECT_EQ(registry.FindByName("Alice"), alice);
+	EXPECT_EQ(registry.FindByTrackSid("TR_a2"), alice);
+	EXPECT_EQ(registry.FindByTrackSid("TR_b1"), bob);
+	EXPECT_EQ(registry.FindBySid("PA_3"), nullptr);
+	EXPECT_EQ(registry.FindByIdentity("carol"), nullptr);
+	EXPECT_EQ(registry.FindByTrackSid("TR_c1"), nullptr);
+
+	std::vector<std::string> order;
+	for (const auto& [sid, participant] : registry) {
+		order.push_back(sid);
+	}
+	EXPECT_EQ(order, (std::vector<std::string>{"PA_1", "PA_2"}));
+}
+
+TEST(ParticipantRegistryTest, UpsertReplacesStaleKeys) {
+	Registry registry;
+	const auto alice = Make("PA_1");
+	registry.Upsert(alice->sid, alice, {"alice", "Alice", {"TR_a1", "TR_a2"}});
+	registry.Upsert(alice->sid, alice, {"alice", "Alice Smith", {"TR_a2", "TR_a3"}});
+
+	EXPECT_EQ(registry.size(), 1u);
+	EXPECT_EQ(registry.FindByName("Alice"), nullptr);
+	EXPECT_EQ(registry.FindByName("Alice Smith"), alice);
+	EXPECT_EQ(registry.FindByTrackSid("TR_a1"), nullptr);
+	EXPECT_EQ(registry.FindByTrackSid("TR_a2"), alice);
+	EXPECT_EQ(registry.FindByTrackSid("TR_a3"), alice);
+}
+
+TEST(ParticipantRegistryTest, EraseAndClearDropEveryIndex) {
+	Registry registry;
+	const auto alice = Make("PA_1");
+	const auto bob = Make("PA_2");
+	registry.Upsert(alice->sid, alice, {"alice", "Alice", {"TR_a1"}});
+	registry.Upsert(bob->sid, bob, {"bob", "Bob", {"TR_b1"}});
+
+	EXPECT_TRUE(registry.Erase("PA_1"));
+	EXPECT_FALSE(registry.Erase("PA_1"));
+	EXPECT_EQ(registry.FindBySid("PA_1"), nullptr);
+	EXPECT_EQ(registry.FindByIdentity("alice"), nullptr);
+	EXPECT_EQ(registry.FindByName("Alice"), nullptr);
+	EXPECT_EQ(registry.FindByTrackSid("TR_a1"), nullptr);
+	EXPECT_EQ(registry.FindByTrackSid("TR_b1"), bob);
+
+	registry.Clear();
+	EXPECT_TRUE(registry.empty());
+	EXPECT_EQ(registry.FindByIdentity("bob"), nullptr);
+	EXPECT_EQ(registry.FindByTrackSid("TR_b1"), nullptr);
+}
+
+TEST(ParticipantRegistryTest, SharedKeysResolveToLowestSid) {
+	Registry registry;
+	const auto rejoined = Make("PA_9");
+	const auto previous = Make("PA_3");
+	registry.Upsert(rejoined->sid, rejoined, {"alice", "Guest", {}});
+	registry.Upsert(previous->sid, previous, {"alice", "Guest", {}});
+
+	EXPECT_EQ(registry.FindByIdentity("alice"), previous);
+	EXPECT_EQ(registry.FindByName("Guest"), previous);
+	registry.Erase("PA_3");
+	EXPECT_EQ(registry.FindByIdentity("alice"), rejoined);
+	EXPECT_EQ(registry.FindByName("Guest"), rejoined);
+}
+
+TEST(ParticipantRegistryTest, MovedTrackKeepsItsNewOwner) {
+	Registry registry;
+	const auto alice = Make("PA_1");
+	const auto bob = Make("PA_2");
+	registry.Upsert(alice->sid, alice, {"alice", "Alice", {"TR_1"}});
+	registry.Upsert(bob->sid, bob, {"bob", "Bob", {"TR_1"}});
+	EXPECT_EQ(registry.FindByTrackSid("TR_1"), bob);
+
+	// Alice's stale entry must not take the track back out of the index.
+	registry.Upsert(alice->sid, alice, {"alice", "Alice", {}});
+	EXPECT_EQ(registry.FindByTrackSid("TR_1"), bob);
+	registry.Erase("PA_1");
+	EXPECT_EQ(registry.FindByTrackSid("TR_1"), bob);
+}
+
+} // namespace
+} // namespace livekit::core::detail
@@ -0,0 +1,85 @@
+#include "spsc_ring_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace livekit::core {
+namespace {
+
+TEST(SpscRingBufferTest, WrapsAroundWithoutSplittingWrites) {
+	SpscRingBuffer<int16_t> ring(5);
+	const std::array<int16_t, 3> first{1, 2, 3};
+	const std::array<int16_t, 3> second{4, 5, 6};
+	ASSERT_TRUE(ring.Write(first.data(), first.size()));
+	EXPECT_FALSE(ring.Write(second.data(), second.size()));
+	EXPECT_EQ(ring.Size(), 3u);
+
+	std::array<int16_t, 3> out{};
+	EXPECT_FALSE(ring.Read(out.data(), 4));
+	ASSERT_TRUE(ring.Read(out.data(), 2));
+	EXPECT_EQ(out[0], 1);
+	EXPECT_EQ(out[1], 2);
+
+	// The second write now straddles the end of the storage.
+	ASSERT_TRUE(ring.Write(second.data(), second.size()));
+	EXPECT_EQ(ring.Size(), 4u);
+	ASSERT_TRUE(ring.Read(out.data(), 3));
+	EXPECT_EQ(out, (std::array<int16_t, 3>{3, 4, 5}));
+	EXPECT_EQ(ring.Discard(10), 1u);
+	EXPECT_EQ(ring.Size(), 0u);
+}
+
+TEST(SpscRingBufferTest, DiscardsOnlyElementsWrittenBeforeAPosition) {
+	SpscRingBuffer<int16_t> ring(8);
+	const std::array<int16_t, 3> before{1, 2, 3};
+	const std::array<int16_t, 2> after{4, 5};
+	ASSERT_TRUE(ring.Write(before.data(), before.size()));
+	const auto position = ring.WritePosition();
+	ASSERT_TRUE(ring.Write(after.data(), after.size()));
+
+	EXPECT_EQ(ring.DiscardUntil(position), 3u);
+	EXPECT_EQ(ring.DiscardUntil(position), 0u);
+	std::array<int16_t, 2> out{};
+	ASSERT_TRUE(ring.Read(out.data(), out.size()));
+	EXPECT_EQ(out, after);
+}
+
+TEST(SpscRingBufferTest, PreservesOrderAcrossProducerAndConsumerThreads) {
+	constexpr std::size_t kChunk = 7;
+	constexpr std::size_t kChunks = 20000;
+	SpscRingBuffer<uint32_t> ring(64);
+	std::thread producer([&] {
+		std::array<uint32_t, kChunk> chunk{};
+		uint32_t next = 0;
+		for (std::size_t index = 0; index < kChunks; ++index) {
+			for (auto& value : chunk) {
+				value = next++;
+			}
+			while (!ring.Write(chunk.data(), chunk.size())) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	std::array<uint32_t, kChunk> chunk{};
+	uint32_t expected = 0;
+	bool ordered = true;
+	for (std::size_t index = 0; index < kChunks; ++index) {
+		while (!ring.Read(chunk.data(), chunk.size())) {
+			std::this_thread::yield();
+		}
+		for (const auto value : chunk) {
+			ordered = ordered && value == expected++;
+		}
+	}
+	producer.join();
+	EXPECT_TRUE(ordered);
+	EXPECT_EQ(ring.Size(), 0u);
+}
+
+} // namespace
+} // namespace livekit::core
@@ -0,0 +1,111 @@
+#include "stream_reassembly.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+
+std::vector<uint8_t> Pattern(std::size_t size) {
+	std::vector<uint8_t> data(size);
+	for (std::size_t index = 0; index < size; ++index) {
+		data[index] = static_cast<uint8_t>(index * 7 + (index >> 11));
+	}
+	return data;
+}
+
+void AppendInChunks(StreamPayload& payload, const std::vector<uint8_t>& data, std::size_t chunk) {
+	for (std::size_t offset = 0; offset < data.size(); offset += chunk) {
+		ASSERT_TRUE(payload.Append(data.data() + offset, std::min(chunk, data.size() - offset)));
+	}
+}
+
+TEST(StreamReassemblyTest, KeepsSmallPayloadsInGrowingSegments) {
+	const auto data = Pattern(3 * kStreamPayloadSegmentSize + 99);
+	StreamPayload payload(0);
+	AppendInChunks(payload, data, 15'000);
+	EXPECT_EQ(payload.Size(), data.size());
+	EXPECT_EQ(payload.SpilledBytes(), 0u);
+	EXPECT_GE(payload.MemoryBytes(), data.size());
+	EXPECT_LT(payload.MemoryBytes(), data.size() + kStreamPayloadSegmentSize);
+
+	std::vector<uint8_t> output;
+	ASSERT_TRUE(payload.TakeBytes(output));
+	EXPECT_EQ(output, data);
+	EXPECT_EQ(payload.Size(), 0u);
+	EXPECT_EQ(payload.MemoryBytes(), 0u);
+}
+
+TEST(StreamReassemblyTest, ShortPayloadDoesNotAllocateFullSegment) {
+	StreamPayload payload(0);
+	const std::string text = "hello";
+	ASSERT_TRUE(payload.Append(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+	EXPECT_LT(payload.MemoryBytes(), kStreamPayloadSegmentSize);
+	std::string output;
+	ASSERT_TRUE(payload.TakeText(output));
+	EXPECT_EQ(output, text);
+}
+
+TEST(StreamReassemblyTest, SpillsPastThresholdAndReadsBack) {
+	const auto data = Pattern(1'000'000);
+	StreamPayload payload(200'000);
+	AppendInChunks(payload, data, 15'000);
+	EXPECT_EQ(payload.Size(), data.size());
+	EXPECT_EQ(payload.SpilledBytes(), data.size());
+	EXPECT_EQ(payload.MemoryBytes(), 0u);
+
+	std::vector<uint8_t> output;
+	ASSERT_TRUE(payload.TakeBytes(output));
+	EXPECT_EQ(output, data);
+	EXPECT_EQ(payload.SpilledBytes(), 0u);
+}
+
+TEST(StreamReassemblyTest, RunsTasksInOrderAndDropsQueuedOnStop) {
+	SerialTaskRunner runner;
+	std::vector<int> order;
+	std::promise<void> done;
+	for (int index = 0; index < 50; ++index) {
+		ASSERT_TRUE(runner.Post([&order, index] { order.push_back(index); }));
+	}
+	ASSERT_TRUE(runner.Post([&done] { done.set_value(); }));
+	ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+	ASSERT_EQ(order.size(), 50u);
+	for (int index = 0; index < 50; ++index) {
+		EXPECT_EQ(order[index], index);
+	}
+
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	std::atomic<int> ran{0};
+	ASSERT_TRUE(runner.Post([released, &ran] {
+		released.wait();
+		++ran;
+	}));
+	ASSERT_TRUE(runner.Post([&ran] { ++ran; }));
+	std::thread stopper([&runner] { runner.Stop(); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	release.set_value();
+	stopper.join();
+	EXPECT_LE(ran.load(), 1);
+	EXPECT_FALSE(runner.Post([] {}));
+}
+
+TEST(StreamReassemblyTest, StopFromTaskDoesNotJoinItself) {
+	auto runner = std::make_unique<SerialTaskRunner>();
+	std::promise<void> stopped;
+	ASSERT_TRUE(runner->Post([&] {
+		runner.reset();
+		stopped.set_value();
+	}));
+	EXPECT_EQ(stopped.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+}
+
+} // namespace
+} // namespace livekit::core::detail
@@ -0,0 +1,138 @@
+#include "timer_wheel.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace livekit::core::detail {
+namespace {
+using namespace std::chrono_literals;
+
+TEST(TimerWheelTest, FiresTimersInDeadlineOrder) {
+	TimerWheel wheel;
+	std::mutex mutex;
+	std::vector<int> order;
+	std::promise<void> done;
+	const auto record = [&](int value) {
+		return [&, value] {
+			std::lock_guard<std::mutex> guard(mutex);
+			order.push_back(value);
+			if (order.size() == 4) {
+				done.set_value();
+			}
+		};
+	};
+	const auto start = std::chrono::steady_clock::now();
+	// 90 ms and 150 ms start above level 0 and reach it by cascading.
+	wheel.Schedule(150ms, record(4));
+	wheel.Schedule(5ms, record(1));
+	wheel.Schedule(90ms, record(3));
+	wheel.Schedule(40ms, record(2));
+	ASSERT_EQ(done.get_future().wait_for(2s), std::future_status::ready);
+	EXPECT_GE(std::chrono::steady_clock::now() - start, 150ms);
+	EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4}));
+	// The last entry is released only after its callback returns.
+	auto stats = wheel.GetStats();
+	for (const auto deadline = std::chrono::steady_clock::now() + 2s;
+	     stats.active != 0 && std::chrono::steady_clock::now() < deadline;
+	     stats = wheel.GetStats()) {
+		std::this_thread::sleep_for(1ms);
+	}
+	EXPECT_EQ(stats.active, 0u);
+	EXPECT_EQ(stats.fired, 4u);
+	EXPECT_GT(stats.cascaded, 0u);
+}
+
+TEST(TimerWheelTest, CancelledTimerNeverFires) {
+	TimerWheel wheel;
+	std::atomic<int> calls{0};
+	const auto id = wheel.Schedule(20ms, [&] { ++calls; });
+	EXPECT_TRUE(wheel.Cancel(id));
+	EXPECT_FALSE(wheel.Cancel(id));
+	EXPECT_FALSE(wheel.Cancel(0));
+	std::this_thread::sleep_for(50ms);
+	EXPECT_EQ(calls.load(), 0);
+	EXPECT_EQ(wheel.GetStats().active, 0u);
+}
+
+TEST(TimerWheelTest, RepeatsUntilCancelled) {
+	TimerWheel wheel;
+	std::atomic<int> calls{0};
+	std::promise<void> fired_three_times;
+	const auto id = wheel.Schedule(
+	    5ms,
+	    [&] {
+		    if (++calls == 3) {
+			    fired_three_times.set_value();
+		    }
+	    },
+	    5ms);
+	ASSERT_EQ(fired_three_times.get_future().wait_for(1s), std::future_status::ready);
+	EXPECT_TRUE(wheel.Cancel(id));
+	const int stopped_at = calls.load();
+	std::this_thread::sleep_for(30ms);
+	EXPECT_EQ(calls.load(), stopped_at);
+}
+
+TEST(TimerWheelTest, CancelWaitsForRunningCallbackUnlessCalledFromIt) {
+	TimerWheel wheel;
+	std::promise<void> entered;
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	std::atomic<bool> finished{false};
+	const auto id = wheel.Schedule(0ms, [&] {
+		entered.set_value();
+		released.wait();
+		finished = true;
+	});
+	ASSERT_EQ(entered.get_future().wait_for(1s), std::future_status::ready);
+	auto cancelled = std::async(std::launch::async, [&] { return wheel.Cancel(id); });
+	EXPECT_EQ(cancelled.wait_for(20ms), std::future_status::timeout);
+	release.set_value();
+	EXPECT_TRUE(cancelled.get());
+	EXPECT_TRUE(finished.load());
+
+	std::promise<void> self_cancelled;
+	TimerWheel::TimerId self = 0;
+	std::mutex mutex;
+	std::unique_lock<std::mutex> hold(mutex);
+	self = wheel.Schedule(
+	    0ms,
+	    [&] {
+		    std::lock_guard<std::mutex> guard(mutex);
+		    EXPECT_TRUE(wheel.Cancel(self));
+		    self_cancelled.set_value();
+	    },
+	    1ms);
+	hold.unlock();
+	ASSERT_EQ(self_cancelled.get_future().wait_for(1s), std::future_status::ready);
+	EXPECT_FALSE(wheel.Cancel(self));
+}
+
+TEST(TimerWheelTest, ManyTimersShareOneThread) {
+	TimerWheel wheel;
+	EXPECT_EQ(wheel.GetStats().threads, 0u);
+	std::vector<TimerWheel::TimerId> ids;
+	for (int index = 0; index < 1000; ++index) {
+		ids.push_back(wheel.Schedule(std::chrono::milliseconds(1000 + index * 37), [] {}));
+	}
+	// Beyond the wheel's span; parked in the top level.
+	ids.push_back(wheel.Schedule(std::chrono::hours(24 * 30), [] {}));
+	auto stats = wheel.GetStats();
+	EXPECT_EQ(stats.active, 1001u);
+	EXPECT_EQ(stats.threads, 1u);
+	for (const auto id : ids) {
+		EXPECT_TRUE(wheel.Cancel(id));
+	}
+	stats = wheel.GetStats();
+	EXPECT_EQ(stats.active, 0u);
+	EXPECT_EQ(stats.fired, 0u);
+}
+
+} // namespace
+} // namespace livekit::core::detail